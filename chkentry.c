@@ -51,6 +51,10 @@
 #include <ctype.h>
 #include <fcntl.h>
 #include <locale.h>
+#include <signal.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/wait.h>
 
 /*
  * chkentry - check JSON files in an IOCCC submission
@@ -68,6 +72,18 @@
  * globals
  */
 static bool quiet = false;		    /* true ==> quiet mode */
+static bool winning_entry_mode = false;	    /* chkentry -w - true ==> -w used, do other checks */
+static int jobs = 0;			    /* chkentry -j - par_walk() threads, 0 ==> fts_walk() */
+static struct walk_set *wset_p = NULL;	    /* pointer to a walk set */
+static char const *context = NULL;	    /* string describing the context (tool and options) for debugging purposes */
+static char const **ignore_path = NULL;	    /* -I paths to ignore under each directory checked */
+static int ignore_count = 0;		    /* number of -I paths */
+static FILE *worker_res = NULL;		    /* chkentry -l worker: stream of results, NULL ==> not a worker */
+static char const *worker_dir = NULL;	    /* chkentry -l worker: directory being checked, NULL ==> none */
+static FILE *worker_report = NULL;	    /* chkentry -l worker: stream of what the checks of worker_dir report */
+static char *worker_report_buf = NULL;	    /* chkentry -l worker: buffer of worker_report */
+static size_t worker_report_len = 0;	    /* chkentry -l worker: length of worker_report_buf */
+static struct timespec worker_start;	    /* chkentry -l worker: when the check of worker_dir started */
 
 
 /*
@@ -76,7 +92,8 @@ static bool quiet = false;		    /* true ==> quiet mode */
  * Use the usage() function to print the usage_msg([0-9]?)+ strings.
  */
 static const char * const usage_msg =
-    "usage: %s [-h] [-v level] [-J level] [-V] [-q] [-b] [-I path] ... [-P] [-s] [-S] [-w] dir\n"
+    "usage: %s [-h] [-v level] [-J level] [-V] [-q] [-b] [-I path] ... [-P] [-s] [-S] [-w] [-j jobs] dir\n"
+    "       %s [options] -l [-n workers]\n"
     "\n"
     "\t-h\t\tprint help message and exit\n"
     "\t-v level\tset verbosity level (def level: %d)\n"
@@ -94,6 +111,10 @@ static const char * const usage_msg =
     "\t\t\t    NOTE: -S conflicts with -I path, -P, -s, and -w\n"
     "\t-w\t\tIOCCC judge use only: winning entry checks\n"
     "\t\t\t    NOTE: -w conflicts with -s\n"
+    "\t-j jobs\t\twalk dir with jobs threads reading directories, 0 ==> walk with fts(3) (def: 0)\n"
+    "\t-l\t\tline mode: read directories to check from stdin, one per line, and\n"
+    "\t\t\t    write a line of JSON with the result of each to stdout\n"
+    "\t-n workers\twith -l, check up to workers directories at once (def: 1)\n"
     "\n"
     "\tdir\tthe directory to be checked (entry directory if -w, submission directory otherwise)\n"
     "\n"
@@ -113,8 +134,15 @@ static const char * const usage_msg =
 /*
  * functions
  */
-static bool chk_json(FILE *err, char const *submission_dir, char const *filename, struct json_sem *sem);
 static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+static bool chk_dir(char const *submission_dir, FILE *report, char const **why);
+static bool json_file_readable(FILE *report, char const *submission_dir, char const *json_filename);
+static int serve_dirs(int workers);
+static void start_worker(struct chk_worker *worker, int w, int workers);
+static void run_worker(FILE *req, FILE *res) __attribute__((noreturn));
+static bool write_result(FILE *res, char const *dir, bool ok, char const *why, char const *report);
+static void worker_exit(void);
+static int stop_worker(struct chk_worker *wp);
 
 
 int
@@ -127,27 +155,16 @@ main(int argc, char *argv[])
     extern int optind;			/* argv index of the next arg */
     bool opt_error = false;		/* fchk_inval_opt() return */
     /**/
-    bool winning_entry_mode = false;    /* chkentry -w - true ==> -w used, do other checks */
     bool special_mode = false;          /* chkentry -s - special features for the judges :-) */
     bool submission_mode = false;       /* chkentry -S - also used by chksubmit(1) */
+    bool line_mode = false;		/* chkentry -l - read directories to check from stdin */
+    int workers = 1;			/* chkentry -n - -l worker processes */
+    bool workers_seen = false;		/* The -n workers was seen on the command line */
     /**/
-    struct walk_stat wstat;		/* walk_stat being processed */
-    struct walk_set *wset_p = NULL;	/* pointer to a walk set */
-    char const *context = NULL;		/* string describing the context (tool and options) for debugging purposes */
-    char const *json_filename = NULL;	/* name of JSON file under submission_dir to check */
-    bool json_ok = true;		/* true ==> no JSON errors found, false ==> some JSON errors found */
-    bool walk_ok = true;		/* true ==> no walk errors found, false ==> some walk errors found */
-    /**/
-    struct item *i_p;			/* pointer to an element in the dynamic array */
-    intmax_t len;			/* number of elements in the dynamic array */
-    /**/
-    bool cap_I_seen = false;		/* The -I path was seen on the command line */
-    bool skip_add_ret = false;		/* return from skip_add() */
-    /**/
-    int cd_ret = -1;			/* chdir(2) return */
+    char const *why = NULL;		/* why the directory could not be checked, NULL ==> it was checked */
+    bool walk_ok = true;		/* true ==> no walk or JSON errors found, false ==> some errors found */
     /**/
     int i;
-    intmax_t j;
 
     /* IOCCC requires use of C locale */
     set_ioccc_locale();
@@ -156,7 +173,7 @@ main(int argc, char *argv[])
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:J:VqbI:PwsS")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:J:VqbI:PwsSj:ln:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    usage(2, program, "");	/*ooo*/
@@ -199,7 +216,18 @@ main(int argc, char *argv[])
 	    msg("This is the option that goes \aBING!!!");
 	    exit(0); /*ooo*/
 	case 'I':
-	    cap_I_seen = true;
+	    /*
+	     * note the path to ignore under each directory checked
+	     */
+	    if (ignore_path == NULL) {
+		errno = 0;	/* pre-clear errno for errp() */
+		ignore_path = calloc((size_t)argc, sizeof(char const *));
+		if (ignore_path == NULL) {
+		    errp(46, __func__, "calloc of %d -I paths failed", argc);
+		    not_reached();
+		}
+	    }
+	    ignore_path[ignore_count++] = optarg;
 	    break;
         case 'P':		/* -P - ignore permissions of paths */
             ignore_permissions = true;
@@ -213,6 +241,26 @@ main(int argc, char *argv[])
         case 'S':
             submission_mode = true;
             break;
+	case 'j':		/* -j jobs - walk with par_walk() */
+	    errno = 0;		/* pre-clear errno for strtol() */
+	    jobs = (int) strtol(optarg, NULL, 0);
+	    if (errno != 0 || jobs < 0 || jobs > PAR_WALK_MAX_JOBS) {
+		usage(3, program, "invalid -j jobs"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'l':		/* -l - line mode */
+	    line_mode = true;
+	    break;
+	case 'n':		/* -n workers - -l worker processes */
+	    errno = 0;		/* pre-clear errno for strtol() */
+	    workers = (int) strtol(optarg, NULL, 0);
+	    if (errno != 0 || workers < 1 || workers > CHKENTRY_MAX_WORKERS) {
+		usage(3, program, "invalid -n workers"); /*ooo*/
+		not_reached();
+	    }
+	    workers_seen = true;
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -226,9 +274,25 @@ main(int argc, char *argv[])
 	    break;
 	}
     }
+    if (workers_seen && !line_mode) {
+	usage(3, program, "-n workers requires -l"); /*ooo*/
+	not_reached();
+    }
     submit_dir = argv[optind]; /* IMPORTANT! */
     switch (argc-optind) {
+    case 0:
+	if (line_mode) {
+	    /* with -l the directories are read from stdin */
+	    break;
+	}
+	usage(3, program, "wrong number of arguments");	/*ooo*/
+	not_reached();
+	break;
     case 1:
+	if (line_mode) {
+	    usage(3, program, "cannot give dir with the -l option"); /*ooo*/
+	    not_reached();
+	}
         /*
          * get absolute path of submission dir
          */
@@ -341,10 +405,89 @@ main(int argc, char *argv[])
 	    not_reached();
 	}
     }
-    dbg(DBG_LOW, "submission_dir: %s", submission_dir);
     dbg(DBG_LOW, "will use context: %s name: %s",
 		 context, (wset_p == NULL || wset_p->name == NULL) ? "((NULL))" : wset_p->name);
 
+    /*
+     * case: -l - check each directory read from stdin
+     */
+    if (line_mode) {
+	exit(serve_dirs(workers)); /*ooo*/
+	not_reached();
+    }
+    dbg(DBG_LOW, "submission_dir: %s", submission_dir);
+
+    /*
+     * check the directory
+     */
+    walk_ok = chk_dir(submission_dir, stderr, &why);
+    if (why != NULL) {
+	err(1, CHKENTRY_BASENAME, "%s: %s", why, submission_dir); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * free submission directory
+     */
+    if (submission_dir != NULL) {
+        free(submission_dir);
+        submission_dir = NULL;
+    }
+    if (ignore_path != NULL) {
+	free(ignore_path);
+	ignore_path = NULL;
+    }
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    if (!walk_ok) {
+	err(1, CHKENTRY_BASENAME, "check failed for: %s", submit_dir); /*ooo*/
+        not_reached();
+    }
+    exit(0); /*ooo*/
+}
+
+
+/*
+ * chk_dir - check a submission directory (or with -w, a winning entry directory)
+ *
+ * The directory is walked with the walk_set of the command line options, the
+ * walk and the permissions are checked and then the JSON files are checked.
+ *
+ * given:
+ *	submission_dir	    absolute path of the directory to check
+ *	report		    stream on which to report what failed the walk and JSON checks
+ *	why		    where to store why the directory could not be checked, NULL ==> it was checked
+ *
+ * returns:
+ *	true ==> all is OK
+ *	false ==> some check failed, or if *why != NULL, the directory could not be checked
+ *
+ * NOTE: This function changes the current directory to submission_dir.
+ *
+ * NOTE: This function does not return on NULL pointer.
+ */
+static bool
+chk_dir(char const *submission_dir, FILE *report, char const **why)
+{
+    struct walk_stat wstat;		/* walk_stat being processed */
+    char const *json_filename = NULL;	/* name of JSON file under submission_dir to check */
+    bool json_ok = true;		/* true ==> no JSON errors found, false ==> some JSON errors found */
+    bool walk_ok = true;		/* true ==> no walk errors found, false ==> some walk errors found */
+    bool skip_add_ret = false;		/* return from skip_add() */
+    int cd_ret = -1;			/* chdir(2) return */
+    int i;
+
+    /*
+     * firewall
+     */
+    if (submission_dir == NULL || report == NULL || why == NULL) {
+	err(47, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    *why = NULL;
+
     /*
      * init_walk_stat - initialize a walk_stat
      */
@@ -361,55 +504,29 @@ main(int argc, char *argv[])
     }
 
     /*
-     * if we had -I path, rescan the command line looking for and processing -I path options
+     * if we had -I path, ignore each path
      */
-    if (cap_I_seen) {
-
-	optind = 1;	/* reset getopt(3) processing */
-	while ((i = getopt(argc, argv, ":hv:J:VqI:PwsSb")) != -1) {
-	    switch (i) {
-	    case 'h':		/* -h - print help to stderr and exit 0 */
-	    case 'v':		/* -v verbosity */
-	    case 'J':		/* -J json_verbosity */
-	    case 'V':		/* -V - print version and exit */
-	    case 'q':
-	    case 'P':		/* -P - ignore permissions of paths */
-	    case 'w':
-	    case 's':
-	    case 'S':
-	    case 'b':
-		/* already processed, nothing to do now */
-		break;
-	    case 'I':
-		skip_add_ret = skip_add(&wstat, optarg);
-		if (skip_add_ret) {
-		    dbg(DBG_LOW, "context will ignore, when canonicalized: %s", optarg);
-		} else {
-		    dbg(DBG_MED, "path: %s is already marked for skipping", optarg);
-		}
-		break;
-	    case ':':   /* option requires an argument */
-	    case '?':   /* illegal option */
-	    default:    /* anything else but should not actually happen */
-		opt_error = fchk_inval_opt(stderr, program, i, optopt);
-		if (opt_error) {
-		    usage(3, program, ""); /*ooo*/
-		    not_reached();
-		} else {
-		    fwarn(stderr, __func__, "getopt() 2nd return: %c optopt: %c", (char)i, (char)optopt);
-		}
-		break;
-	    }
+    for (i = 0; i < ignore_count; ++i) {
+	skip_add_ret = skip_add(&wstat, ignore_path[i]);
+	if (skip_add_ret) {
+	    dbg(DBG_LOW, "context will ignore, when canonicalized: %s", ignore_path[i]);
+	} else {
+	    dbg(DBG_MED, "path: %s is already marked for skipping", ignore_path[i]);
 	}
     }
 
     /*
      * walk a file system tree, recording steps
      */
-    walk_ok = fts_walk(&wstat);
+    if (jobs > 0) {
+	walk_ok = par_walk(&wstat, jobs);
+    } else {
+	walk_ok = fts_walk(&wstat);
+    }
     if (walk_ok == false) {
-	err(1, CHKENTRY_BASENAME, "failed to scan: %s", submission_dir); /*ooo*/
-	not_reached();
+	*why = "failed to scan";
+	free_walk_stat(&wstat);
+	return false;
     }
 
     /*
@@ -421,9 +538,9 @@ main(int argc, char *argv[])
      * end walk and check if the walk was successful
      */
     if (winning_entry_mode) {
-	walk_ok = chk_walk(&wstat, stderr, ANY_COUNT, ANY_COUNT, NO_COUNT, NO_COUNT, true);
+	walk_ok = chk_walk(&wstat, report, ANY_COUNT, ANY_COUNT, NO_COUNT, NO_COUNT, true);
     } else {
-	walk_ok = chk_walk(&wstat, stderr, MAX_EXTRA_FILE_COUNT, MAX_EXTRA_DIR_COUNT, NO_COUNT, NO_COUNT, true);
+	walk_ok = chk_walk(&wstat, report, MAX_EXTRA_FILE_COUNT, MAX_EXTRA_DIR_COUNT, NO_COUNT, NO_COUNT, true);
     }
     if (walk_ok) {
 	dbg(DBG_LOW, "%s walk was successful for: %s", context, submission_dir);
@@ -434,102 +551,26 @@ main(int argc, char *argv[])
     /*
      * check permissions unless ignore_permissions
      */
-    if (!ignore_permissions) {
-
-	/*
-	 * scan files for permissions
-	 */
-	len = dyn_array_tell(wstat.file);
-	for (j=0; j < len; ++j) {
-
-	    /*
-	     * obtain file permission
-	     */
-	    i_p = dyn_array_value(wstat.file, struct item *, j);
-	    if (i_p == NULL) {
-		err(10, CHKENTRY_BASENAME, "wstat.file[%jd] is NULL\n", j); /*coo*/
-		not_reached();
-	    } else if (i_p->fts_path == NULL) {
-		err(11, CHKENTRY_BASENAME, "wstat.file[%jd].fts_path is NULL\n", j);
-		not_reached();
-	    } else if (i_p->fts_name == NULL) {
-		err(12, CHKENTRY_BASENAME, "wstat.file[%jd].fts_name is NULL\n", j);
-		not_reached();
-	    }
-
-	    /*
-	     * case: file ends in .sh in any case
-	     */
-	    if (i_p->fts_namelen >= LITLEN(".sh") &&
-		strcasecmp(i_p->fts_name + i_p->fts_namelen - LITLEN(".sh"), ".sh") == 0) {
-
-		/*
-		 * verify mode 0555
-		 */
-		if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0555) {
-		    dbg(DBG_LOW, "shell file: %s permission: %03o != %03o",
-				  i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0555);
-		    walk_ok = false;
-		}
-
-	    /*
-	     * case: file does NOT end in .sh
-	     */
-	    } else {
-
-		/*
-		 * verify mode 0444
-		 */
-		if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0444) {
-		    dbg(DBG_LOW, "non-shell file: %s permission: %03o != %03o",
-				  i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0444);
-		    walk_ok = false;
-		}
-	    }
-	}
-
-	/*
-	 * scan directories for permissions
-	 */
-	len = dyn_array_tell(wstat.dir);
-	for (j=0; j < len; ++j) {
-
-	    /*
-	     * obtain file permission
-	     */
-	    i_p = dyn_array_value(wstat.dir, struct item *, j);
-	    if (i_p == NULL) {
-		err(13, CHKENTRY_BASENAME, "wstat.dir[%jd] is NULL\n", j);
-		not_reached();
-	    } else if (i_p->fts_path == NULL) {
-		err(14, CHKENTRY_BASENAME, "wstat.dir[%jd].fts_path is NULL\n", j);
-		not_reached();
-	    }
-
-	    /*
-	     * verify mode 0755
-	     */
-	    if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0755) {
-		dbg(DBG_LOW, "directory: %s permission: %03o != %03o",
-			      i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0755);
-		walk_ok = false;
-	    }
-	}
+    if (!ignore_permissions && !chk_submit_perm(&wstat)) {
+	walk_ok = false;
     }
 
+    /*
+     * free the walk_stat
+     */
+    free_walk_stat(&wstat);
+
     /*
      * cd to the submission directory for any final JSON file verification
-     *
-     * At this time we no longer need to remain at the current directory,
-     * so the cd below is OK.
      */
-    errno = 0;	    /* pre-clear errno for errp() */
+    errno = 0;	    /* pre-clear errno for warnp() */
     cd_ret = chdir(submission_dir);
     if (cd_ret < 0) {
 
 	/* report failure to cd to submission_dir */
-        errp(1, CHKENTRY_BASENAME, "cannot cd: %s", submission_dir); /*ooo*/
-	not_reached();
+	warnp(__func__, "cannot cd: %s", submission_dir);
+	*why = "cannot cd";
+	return false;
 
     /*
      * case: verify .entry.json JSON file
@@ -542,7 +583,8 @@ main(int argc, char *argv[])
 	 * TODO: until we have a struct json_sem for .entry.json, we pass NULL
 	 */
 	json_filename = ".entry.json";
-	json_ok = chk_json(stderr, ".", json_filename, NULL);
+	json_ok = json_file_readable(report, submission_dir, json_filename) &&
+		  chk_json_file(report, ".", json_filename, NULL, NULL);
 	if (json_ok == false) {
 	    dbg(DBG_LOW, "invalid JSON file: %s/%s", submission_dir, json_filename);
 	    walk_ok = false;
@@ -557,7 +599,8 @@ main(int argc, char *argv[])
 	 * check .auth.json
 	 */
 	json_filename = ".auth.json";
-	json_ok = chk_json(stderr, ".", json_filename, sem_auth);
+	json_ok = json_file_readable(report, submission_dir, json_filename) &&
+		  chk_json_file(report, ".", json_filename, sem_auth, &sem_auth_hash);
 	if (json_ok == false) {
 	    dbg(DBG_LOW, "invalid JSON file: %s/%s", submission_dir, json_filename);
 	    walk_ok = false;
@@ -567,275 +610,723 @@ main(int argc, char *argv[])
 	 * check .info.json
 	 */
 	json_filename = ".info.json";
-	json_ok = chk_json(stderr, ".", json_filename, sem_info);
+	json_ok = json_file_readable(report, submission_dir, json_filename) &&
+		  chk_json_file(report, ".", json_filename, sem_info, &sem_info_hash);
 	if (json_ok == false) {
 	    dbg(DBG_LOW, "invalid JSON file: %s/%s", submission_dir, json_filename);
 	    walk_ok = false;
 	}
     }
-
-    /*
-     * free submission directory
-     */
-    if (submission_dir != NULL) {
-        free(submission_dir);
-        submission_dir = NULL;
-    }
-
-    /*
-     * free the walk_stat
-     */
-    free_walk_stat(&wstat);
-
-    /*
-     * All Done!!! All Done!!! -- Jessica Noll, Age 2
-     */
-    if (!walk_ok) {
-	err(1, CHKENTRY_BASENAME, "check failed for: %s", submit_dir); /*ooo*/
-        not_reached();
-    }
-    exit(0); /*ooo*/
+    return walk_ok;
 }
 
 
 /*
- * usage - print usage to stderr
+ * json_file_readable - determine if a JSON file of a directory can be checked
  *
- * Example:
- *      usage(3, program, "wrong number of arguments");
+ * chk_json_file() opens the file with open_dir_file(), which does not return
+ * if the file is missing or unreadable.  Such a file is a failed check of the
+ * directory, not an internal error, and with -l it must not end the worker.
  *
  * given:
- *	exitcode        value to exit with
- *	str		top level usage message
- *	prog		our program name
+ *	report		    stream on which to report a missing or unreadable file
+ *	submission_dir	    directory being checked, for the report
+ *	json_filename	    name of the JSON file in the current directory
  *
- * NOTE: We warn with extra newlines to help internal fault messages stand out.
- *       Normally one should NOT include newlines in warn messages.
+ * returns:
+ *	true ==> json_filename is a readable regular file,
+ *	false ==> it is not (reported on report)
  *
- * This function does not return.
+ * NOTE: This function does not return on NULL pointer.
  */
-static void
-usage(int exitcode, char const *prog, char const *str)
+static bool
+json_file_readable(FILE *report, char const *submission_dir, char const *json_filename)
 {
     /*
      * firewall
      */
-    if (prog == NULL) {
-	prog = CHKENTRY_BASENAME;
-	warn(__func__, "\nin usage(): prog was NULL, forcing it to be: %s\n", prog);
-    }
-    if (str == NULL) {
-	str = "((NULL str))";
-	warn(__func__, "\nin usage(): str was NULL, forcing it to be: %s\n", str);
+    if (report == NULL || submission_dir == NULL || json_filename == NULL) {
+	err(70, __func__, "called with NULL arg(s)"); /*ooo*/
+	not_reached();
     }
 
-    /*
-     * print the formatted usage stream
-     */
-    if (*str != '\0') {
-	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    if (!is_file(json_filename)) {
+	fwarn(report, __func__, "JSON file is missing or not a regular file: %s/%s", submission_dir, json_filename);
+	return false;
     }
-    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT,
-	    CHKENTRY_BASENAME, CHKENTRY_VERSION, MKIOCCCENTRY_REPO_VERSION, JPARSE_UTILS_VERSION,
-            JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
-    exit(exitcode); /*ooo*/
-    not_reached();
+    if (!is_read(json_filename)) {
+	fwarn(report, __func__, "JSON file is not readable: %s/%s", submission_dir, json_filename);
+	return false;
+    }
+    return true;
 }
 
 
 /*
- * chk_json - check a JSON file
+ * serve_dirs - check each directory read from stdin (chkentry -l)
+ *
+ * Each line read from stdin is the path of a directory to check.  For each,
+ * a line of JSON is written to stdout, in the order the directories were read:
+ *
+ *	{ "ok" : true, "dir" : "path", "error" : null, "seconds" : 0.001234, "report" : "" }
+ *
+ * where "error" is why the directory could not be checked (or null if it
+ * was checked) and "report" is what chk_walk() and chk_json_file() reported.
+ * Each result is written as soon as it and those before it are known, so a
+ * client may write a path and then wait for its result.
+ *
+ * The directories are checked by worker processes that are forked after the
+ * walk_set is compiled, so that it is compiled only once, however many
+ * directories are checked.  Each worker checks one directory at a time, so up
+ * to workers directories are checked at once.  Processes are used rather than
+ * threads as each check changes the current directory.  A worker that exits,
+ * say on an internal error, is replaced and the directory it was checking is
+ * reported as not checked.
  *
  * given:
- *	err		    stream on which to report errors
- *	submission_dir	    directory from which files are to be checked
- *	filename	    name of JSON file in submission_dir
- *	sem		    != NULL ==> pointer to a JSON semantic table
- *			    NULL => do not perform any semantic table checks
+ *	workers	    number of worker processes, 1 to CHKENTRY_MAX_WORKERS
  *
  * returns:
- *	true ==> all is OK
- *	false ==> something failed
+ *	0 ==> all directories passed all checks
+ *	1 ==> some directory failed some check or could not be checked
  *
- * The file, .auth.json, under the submission_dir will opened, checked for proper JSON
- * syntax, and finally JSON semantic analysis will be performed.
+ * This function does not return on error.
  */
-static bool
-chk_json(FILE *err, char const *submission_dir, char const *filename, struct json_sem *sem)
+static int
+serve_dirs(int workers)
 {
-    FILE *stream = NULL;				/* file stream for the JSON file or NULL */
-    struct json *tree = NULL;				/* JSON parse tree or NULL ==> not parsed or invalid JSON */
-    bool json_valid = false;				/* true ==> JSON is valid, false ==> JSON is invalid */
-    struct dyn_array *count_err = NULL;			/* JSON semantic count errors */
-    struct dyn_array *val_err = NULL;			/* JSON semantic validation errors */
-    intmax_t all_err_count = 0;				/* number of errors (count+validation+internal) from semantic check */
-    intmax_t count_err_count = 0;			/* semantic count error count */
-    intmax_t int_err_count = 0;				/* internal error count */
-    intmax_t val_err_count = 0;				/* semantic validation count */
-    struct json_sem_count_err *sem_count_err = NULL;    /* semantic count error to print */
-    struct json_sem_val_err *sem_val_err = NULL;        /* semantic validation error to print */
-    intmax_t c;						/* dynamic array index and ignored lists iterator */
+    struct chk_worker worker[CHKENTRY_MAX_WORKERS];	/* worker processes */
+    int order[CHKENTRY_MAX_WORKERS];	/* busy workers in the order they were given a directory */
+    int head = 0;			/* index in order of the worker whose result is next */
+    int queued = 0;			/* number of busy workers */
+    char *inbuf = NULL;			/* lines read from stdin but not yet given to a worker */
+    size_t inlen = 0;			/* number of bytes in inbuf */
+    size_t insize = 0;			/* allocated size of inbuf */
+    bool in_eof = false;		/* true ==> EOF on stdin */
+    char *line = NULL;			/* result line read from a worker */
+    char *nl;				/* newline in inbuf */
+    struct pollfd pfd[2];		/* stdin and the result of the next worker */
+    nfds_t npfd;			/* number of pfd in use */
+    bool all_ok = true;			/* true ==> every directory passed */
+    ssize_t len;			/* length read */
+    int status;				/* worker exit status */
+    int ret;				/* libc function return */
+    int w;
 
     /*
      * firewall
      */
-    if (err == NULL) {
-	fwarn(stderr, __func__, "err is NULL");
-	return false;
-    }
-    if (submission_dir == NULL) {
-	fwarn(err, __func__, "submission_dir is NULL");
-	return false;
-    }
-    if (filename == NULL) {
-	fwarn(err, __func__, "filename is NULL");
-	return false;
+    if (workers < 1 || workers > CHKENTRY_MAX_WORKERS) {
+	err(48, __func__, "workers: %d must be from 1 to %d", workers, CHKENTRY_MAX_WORKERS);
+	not_reached();
     }
 
     /*
-     * open the JSON file under submission_dir
+     * compile the walk_set once for all workers and directories
      */
-    stream = open_dir_file(submission_dir, filename);
-    if (stream == NULL) {
-	fwarn(err, __func__, "failed to open: %s", filename);
-	return false;
-    }
+    keep_walk_set(wset_p, context, true);
 
     /*
-     * parse the JSON file and check for valid JSON syntax
+     * a worker that exits is noticed by EOF on its result, not by SIGPIPE
      */
-    tree = parse_json_stream(stream, filename, &json_valid);
-    if (json_valid == false || tree == NULL) {
-	fwarn(err, __func__, "file contains invalid JSON: %s", filename);
-	return false;
-    }
+    (void) signal(SIGPIPE, SIG_IGN);
 
     /*
-     * perform JSON semantic checks if requested
+     * start the workers
      */
-    if (sem != NULL) {
+    memset(worker, 0, sizeof(worker));
+    for (w = 0; w < workers; ++w) {
+	start_worker(worker, w, workers);
+    }
 
-	/*
-	 * perform JSON semantic analysis on the .auth.json JSON parse tree
-	 */
-	all_err_count = json_sem_check(tree, JSON_DEFAULT_MAX_DEPTH, sem, &count_err, &val_err, NULL);
+    /*
+     * give directories to idle workers and write results in order until EOF and all are done
+     */
+    while (true) {
 
 	/*
-	 * firewall for semantic analysis
+	 * give each complete line read to an idle worker
 	 */
-	if (count_err == NULL) {
-
-	    /* report failure */
-	    fwarn(err, __func__, "left count_err as NULL for JSON file: %s", filename);
-
-	    /* free storage */
-	    if (val_err == NULL) {
-		free_count_err(val_err);
-		val_err = NULL;
+	for (w = 0; w < workers && inlen > 0; ++w) {
+	    if (worker[w].busy) {
+		continue;
+	    }
+	    nl = memchr(inbuf, '\n', inlen);
+	    if (nl == NULL) {
+		break;
 	    }
-	    if (tree == NULL) {
-		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
-		tree = NULL;
+	    *nl = '\0';
+	    if (*inbuf != '\0') {
+		errno = 0;	/* pre-clear errno for errp() */
+		worker[w].dir = strdup(inbuf);
+		if (worker[w].dir == NULL) {
+		    errp(49, __func__, "strdup of directory failed");
+		    not_reached();
+		}
+		dbg(DBG_MED, "worker %d pid %jd will check: %s", w, (intmax_t)worker[w].pid, worker[w].dir);
+		ret = fprintf(worker[w].req, "%s\n", worker[w].dir);
+		if (ret <= 0 || fflush(worker[w].req) != 0) {
+		    dbg(DBG_LOW, "worker %d pid %jd did not take: %s", w, (intmax_t)worker[w].pid, worker[w].dir);
+		}
+		worker[w].busy = true;
+		order[(head + queued) % workers] = w;
+		++queued;
 	    }
-	    return false;
+	    inlen -= (size_t)(nl + 1 - inbuf);
+	    memmove(inbuf, nl + 1, inlen);
+	    w = -1;	/* look again for an idle worker from the start */
 	}
-	if (val_err == NULL) {
 
-	    /* report failure */
-	    fwarn(err, __func__, "cleft val_err as NULL for JSON file: %s", filename);
-
-	    /* free storage */
-	    if (count_err != NULL) {
-		free_count_err(count_err);
-		count_err = NULL;
-	    }
-	    if (tree != NULL) {
-		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
-		tree = NULL;
+	/*
+	 * read stdin if a line could be given to a worker, and wait for the next result if any
+	 */
+	npfd = 0;
+	if (!in_eof && queued < workers && (inlen == 0 || memchr(inbuf, '\n', inlen) == NULL)) {
+	    pfd[npfd].fd = 0;
+	    pfd[npfd].events = POLLIN;
+	    pfd[npfd].revents = 0;
+	    ++npfd;
+	}
+	if (queued > 0) {
+	    pfd[npfd].fd = worker[order[head]].res_fd;
+	    pfd[npfd].events = POLLIN;
+	    pfd[npfd].revents = 0;
+	    ++npfd;
+	}
+	if (npfd == 0) {
+	    break;
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = poll(pfd, npfd, -1);
+	if (ret < 0) {
+	    if (errno == EINTR) {
+		continue;
 	    }
-	    return false;
+	    errp(50, __func__, "poll failed");
+	    not_reached();
 	}
 
 	/*
-	 * determine semantic error count
+	 * read what stdin has
 	 */
-	count_err_count = dyn_array_tell(count_err);
-	val_err_count = dyn_array_tell(val_err);
-	if (all_err_count < count_err_count + val_err_count) {
-
-	    /* report failure */
-	    fwarn(err, __func__, "all_err_count: %jd < count_err_count: %jd + val_err_count: %jd for JSON file: %s",
-		       all_err_count, count_err_count, val_err_count, filename);
-
-	    /* free storage */
-	    if (count_err != NULL) {
-		free_count_err(count_err);
-		count_err = NULL;
-	    }
-	    if (val_err != NULL) {
-		free_count_err(val_err);
-		val_err = NULL;
+	if (pfd[0].fd == 0 && pfd[0].revents != 0) {
+	    if (insize - inlen < BUFSIZ + 1) {
+		insize += BUFSIZ + 1;
+		errno = 0;	/* pre-clear errno for errp() */
+		inbuf = realloc(inbuf, insize);
+		if (inbuf == NULL) {
+		    errp(51, __func__, "realloc of %zu bytes failed", insize);
+		    not_reached();
+		}
 	    }
-	    if (tree != NULL) {
-		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
-		tree = NULL;
+	    errno = 0;		/* pre-clear errno for errp() */
+	    len = read(0, inbuf + inlen, insize - inlen - 1);
+	    if (len < 0) {
+		if (errno == EINTR || errno == EAGAIN) {
+		    continue;
+		}
+		errp(52, __func__, "error reading stdin");
+		not_reached();
+	    } else if (len == 0) {
+		in_eof = true;
+		/* a last line without a newline is still a line */
+		if (inlen > 0 && inbuf[inlen - 1] != '\n') {
+		    inbuf[inlen++] = '\n';
+		}
+	    } else {
+		inlen += (size_t)len;
 	    }
-	    return false;
+	    continue;
 	}
-	int_err_count = all_err_count - (count_err_count + val_err_count);
 
 	/*
-	 * report in details of the semantic analysis
+	 * write the result of the next worker
 	 */
-	if (all_err_count > 0) {
+	w = order[head];
+	len = readline(&line, worker[w].res);
+	if (len < 0) {
 
-	    /* report errors */
-	    fpr(err, __func__, "follows are errors for JSON file: %s\n", filename);
-	    for (c=0; c < count_err_count; ++c) {
-		sem_count_err = dyn_array_addr(count_err, struct json_sem_count_err, c);
-		fprint_count_err(err, "JSON semantic count error ", sem_count_err, "\n");
+	    /*
+	     * the worker exited before it wrote a result: report the directory as not checked
+	     */
+	    status = stop_worker(&worker[w]);
+	    warn(__func__, "worker %d exited with status %d while checking: %s", w, status, worker[w].dir);
+	    errno = 0;		/* pre-clear errno for errp() */
+	    ret = printf("{ \"ok\" : false, \"dir\" : ");
+	    if (ret <= 0 || !json_fprintf_str(stdout, worker[w].dir) ||
+		printf(", \"error\" : \"%s\", \"seconds\" : 0.0, \"report\" : \"\" }\n", CHKENTRY_EXITED) <= 0) {
+		errp(53, __func__, "error writing result for: %s", worker[w].dir);
+		not_reached();
 	    }
-	    for (c=0; c < val_err_count; ++c) {
-		sem_val_err = dyn_array_addr(val_err, struct json_sem_val_err, c);
-		fprint_val_err(err, "JSON semantic validation error ", sem_val_err, "\n");
+	    all_ok = false;
+	    start_worker(worker, w, workers);
+	} else {
+	    if (strncmp(line, CHKENTRY_RESULT_OK, LITLEN(CHKENTRY_RESULT_OK)) != 0) {
+		all_ok = false;
 	    }
-	    if (int_err_count > 0) {
-		fpr(err, __func__, "%s internal JSON semantic error(s) found: %ju\n", filename, int_err_count);
+	    errno = 0;		/* pre-clear errno for errp() */
+	    ret = printf("%s\n", line);
+	    if (ret <= 0) {
+		errp(54, __func__, "error writing result for: %s", worker[w].dir);
+		not_reached();
 	    }
-	    fpr(err, __func__, "%s total JSON semantic error(s) found: %ju\n", filename, all_err_count);
 
-	    /* free storage */
-	    if (count_err != NULL) {
-		free_count_err(count_err);
-		count_err = NULL;
-	    }
-	    if (val_err != NULL) {
-		free_count_err(val_err);
-		val_err = NULL;
+	    /*
+	     * a worker that wrote its result as it exited must be replaced
+	     */
+	    if (strstr(line, CHKENTRY_RESULT_EXITED) != NULL) {
+		status = stop_worker(&worker[w]);
+		warn(__func__, "worker %d exited with status %d while checking: %s", w, status, worker[w].dir);
+		start_worker(worker, w, workers);
 	    }
-	    if (tree != NULL) {
-		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
-		tree = NULL;
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = fflush(stdout);
+	if (ret != 0) {
+	    errp(55, __func__, "fflush of stdout failed");
+	    not_reached();
+	}
+	free(worker[w].dir);
+	worker[w].dir = NULL;
+	worker[w].busy = false;
+	head = (head + 1) % workers;
+	--queued;
+    }
+
+    /*
+     * stop the workers
+     */
+    for (w = 0; w < workers; ++w) {
+	status = stop_worker(&worker[w]);
+	if (status != 0) {
+	    warn(__func__, "worker %d exited with status: %d", w, status);
+	    all_ok = false;
+	}
+    }
+
+    /*
+     * free storage
+     */
+    if (inbuf != NULL) {
+	free(inbuf);
+	inbuf = NULL;
+    }
+    if (line != NULL) {
+	free(line);
+	line = NULL;
+    }
+    keep_walk_set(wset_p, context, false);
+    return all_ok ? 0 : 1;
+}
+
+
+/*
+ * start_worker - fork a worker process for serve_dirs()
+ *
+ * given:
+ *	worker	    array of workers
+ *	w	    index of the worker to start
+ *	workers	    number of workers in the array
+ *
+ * This function does not return on error.
+ */
+static void
+start_worker(struct chk_worker *worker, int w, int workers)
+{
+    int req[2];			/* pipe of directories to the worker */
+    int res[2];			/* pipe of results from the worker */
+    FILE *req_stream;		/* worker end of req */
+    FILE *res_stream;		/* worker end of res */
+    pid_t pid;			/* fork(2) return */
+    int ret;			/* libc function return */
+    int i;
+
+    /*
+     * firewall
+     */
+    if (worker == NULL || w < 0 || w >= workers) {
+	err(56, __func__, "called with NULL worker or bad worker index");
+	not_reached();
+    }
+
+    /*
+     * form the pipes
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = pipe(req);
+    if (ret < 0) {
+	errp(57, __func__, "pipe of directories to worker %d failed", w);
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = pipe(res);
+    if (ret < 0) {
+	errp(58, __func__, "pipe of results from worker %d failed", w);
+	not_reached();
+    }
+
+    /*
+     * fork the worker
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = fflush(stdout);
+    if (ret != 0) {
+	errp(59, __func__, "fflush of stdout failed");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    pid = fork();
+    if (pid < 0) {
+	errp(60, __func__, "fork of worker %d failed", w);
+	not_reached();
+    } else if (pid == 0) {
+
+	/*
+	 * case: worker - close the pipes of the other workers and check directories
+	 */
+	for (i = 0; i < workers; ++i) {
+	    if (i != w && worker[i].pid > 0) {
+		(void) fclose(worker[i].req);
+		(void) fclose(worker[i].res);
 	    }
-	    return false;
 	}
+	(void) close(req[1]);
+	(void) close(res[0]);
+	errno = 0;		/* pre-clear errno for errp() */
+	req_stream = fdopen(req[0], "r");
+	res_stream = fdopen(res[1], "w");
+	if (req_stream == NULL || res_stream == NULL) {
+	    errp(61, __func__, "fdopen of worker %d pipes failed", w);
+	    not_reached();
+	}
+	run_worker(req_stream, res_stream);
+	not_reached();
+    }
+
+    /*
+     * case: parent - keep the other ends of the pipes
+     */
+    (void) close(req[0]);
+    (void) close(res[1]);
+    errno = 0;			/* pre-clear errno for errp() */
+    worker[w].req = fdopen(req[1], "w");
+    worker[w].res = fdopen(res[0], "r");
+    if (worker[w].req == NULL || worker[w].res == NULL) {
+	errp(62, __func__, "fdopen of worker %d pipes failed", w);
+	not_reached();
+    }
+    worker[w].res_fd = res[0];
+    worker[w].pid = pid;
+    worker[w].busy = false;
+    dbg(DBG_MED, "started worker %d pid %jd", w, (intmax_t)pid);
+    return;
+}
+
+
+/*
+ * run_worker - check each directory read from req and write its result to res
+ *
+ * given:
+ *	req	    stream of directories to check, one per line
+ *	res	    stream on which to write a line of JSON for each directory
+ *
+ * What the checks of a directory report, including the messages that would
+ * go to stderr, is captured for the "report" of its result.  Should a check
+ * not return, say on an internal error, worker_exit() writes the result of
+ * the directory, with what was captured, before the worker exits.
+ *
+ * The worker exits 0 on EOF of req.
+ *
+ * This function does not return.
+ */
+static void
+run_worker(FILE *req, FILE *res)
+{
+    char *dir = NULL;		/* directory to check as read */
+    char *submission_dir;	/* absolute path of dir */
+    char const *why;		/* why the directory could not be checked, NULL ==> it was checked */
+    bool ok;			/* true ==> all checks passed */
+    int cwd;			/* directory to return to after each check */
+    int ret;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (req == NULL || res == NULL) {
+	err(63, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * note the current directory as each check changes it
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    cwd = open(".", O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if (cwd < 0) {
+	errp(64, __func__, "cannot open .");
+	not_reached();
+    }
+
+    /*
+     * write the result of a directory whose check does not return
+     */
+    worker_res = res;
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = atexit(worker_exit);
+    if (ret != 0) {
+	errp(71, __func__, "atexit of worker_exit failed"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * check each directory
+     */
+    while (readline(&dir, req) >= 0) {
+	(void) clock_gettime(CLOCK_MONOTONIC, &worker_start);
+	dbg(DBG_MED, "worker pid %jd checking: %s", (intmax_t)getpid(), dir);
 
 	/*
-	 * free storage
+	 * capture what the checks report, and what they would write to stderr
 	 */
-	if (count_err != NULL) {
-	    free_count_err(count_err);
-	    count_err = NULL;
+	errno = 0;		/* pre-clear errno for errp() */
+	worker_report = open_memstream(&worker_report_buf, &worker_report_len);
+	if (worker_report == NULL) {
+	    errp(65, __func__, "open_memstream failed");
+	    not_reached();
+	}
+	worker_dir = dir;
+	(void) set_dbg_thread_stream(worker_report);
+
+	/*
+	 * check the directory by its absolute path
+	 */
+	ok = false;
+	errno = 0;		/* pre-clear errno for warnp() */
+	submission_dir = realpath(dir, NULL);
+	if (submission_dir == NULL) {
+	    warnp(__func__, "cannot find directory: %s", dir);
+	    why = "cannot find directory";
+	} else {
+	    ok = chk_dir(submission_dir, worker_report, &why);
+	    free(submission_dir);
+	    submission_dir = NULL;
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = fchdir(cwd);
+	if (ret < 0) {
+	    errp(66, __func__, "cannot fchdir to the previous current directory");
+	    not_reached();
 	}
-	if (val_err != NULL) {
-	    free_count_err(val_err);
-	    val_err = NULL;
+	(void) set_dbg_thread_stream(NULL);
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = fclose(worker_report);
+	worker_report = NULL;
+	if (ret != 0) {
+	    errp(67, __func__, "fclose of report failed");
+	    not_reached();
+	}
+
+	/*
+	 * write the result
+	 */
+	worker_dir = NULL;
+	if (!write_result(res, dir, ok && why == NULL, why, worker_report_buf)) {
+	    errp(68, __func__, "error writing result for: %s", dir);
+	    not_reached();
 	}
+	free(worker_report_buf);
+	worker_report_buf = NULL;
+	worker_report_len = 0;
+    }
+
+    /*
+     * EOF - all done
+     */
+    if (dir != NULL) {
+	free(dir);
+	dir = NULL;
+    }
+    (void) close(cwd);
+    (void) fclose(req);
+    worker_res = NULL;
+    (void) fclose(res);
+    exit(0); /*ooo*/
+}
+
+
+/*
+ * write_result - write the line of JSON with the result of a directory
+ *
+ * given:
+ *	res	    stream on which to write the result
+ *	dir	    directory as read
+ *	ok	    true ==> all checks passed
+ *	why	    why the directory could not be checked, NULL ==> it was checked
+ *	report	    what the checks reported, NULL ==> nothing
+ *
+ * returns:
+ *	true ==> result written and flushed, false ==> write error
+ *
+ * NOTE: the seconds of the result are those since worker_start.
+ */
+static bool
+write_result(FILE *res, char const *dir, bool ok, char const *why, char const *report)
+{
+    struct timespec end;	/* when the check ended */
+    int ret;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (res == NULL || dir == NULL) {
+	err(72, __func__, "called with NULL arg(s)"); /*ooo*/
+	not_reached();
     }
-    if (tree != NULL) {
-	json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
-	tree = NULL;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    errno = 0;			/* pre-clear errno for caller */
+    ret = fprintf(res, "%s", ok ? CHKENTRY_RESULT_OK : CHKENTRY_RESULT_FAILED);
+    if (ret <= 0 ||
+	fprintf(res, ", \"dir\" : ") <= 0 || !json_fprintf_str(res, dir) ||
+	fprintf(res, ", \"error\" : ") <= 0 || !json_fprintf_str(res, why) ||
+	fprintf(res, ", \"seconds\" : %.6f, \"report\" : ",
+		     (double)(end.tv_sec - worker_start.tv_sec) + (double)(end.tv_nsec - worker_start.tv_nsec) / 1e9) <= 0 ||
+	!json_fprintf_str(res, report == NULL ? "" : report) || fprintf(res, " }\n") <= 0 || fflush(res) != 0) {
+	return false;
     }
-    dbg(DBG_LOW, "JSON file is OK: %s", filename);
     return true;
 }
+
+
+/*
+ * worker_exit - write the result of the directory a worker was checking when it exits
+ *
+ * A check that does not return, say on an internal error, exits the worker.
+ * The result of its directory is then written with the error CHKENTRY_EXITED
+ * and with what the check reported, including the error it exited on, so that
+ * serve_dirs() can report why and start a new worker.
+ *
+ * NOTE: This function is registered with atexit(3) by run_worker() and does
+ *	 nothing if the worker is not checking a directory.
+ */
+static void
+worker_exit(void)
+{
+    char const *dir;		/* directory being checked */
+
+    if (worker_res == NULL || worker_dir == NULL) {
+	return;
+    }
+    dir = worker_dir;
+    worker_dir = NULL;
+
+    /*
+     * stop capturing what the check reports
+     */
+    (void) set_dbg_thread_stream(NULL);
+    if (worker_report != NULL) {
+	(void) fclose(worker_report);
+	worker_report = NULL;
+    }
+
+    /*
+     * write the result
+     */
+    if (!write_result(worker_res, dir, false, CHKENTRY_EXITED, worker_report_buf)) {
+	warnp(__func__, "error writing result for: %s", dir);
+    }
+    return;
+}
+
+
+/*
+ * stop_worker - close the pipes of a worker and wait for it to exit
+ *
+ * given:
+ *	wp	    pointer to the worker
+ *
+ * returns:
+ *	exit status of the worker, or 128 + signal number if it was killed
+ */
+static int
+stop_worker(struct chk_worker *wp)
+{
+    int status = 0;		/* waitpid(2) status */
+    pid_t ret;			/* waitpid(2) return */
+
+    /*
+     * firewall
+     */
+    if (wp == NULL) {
+	err(69, __func__, "called with NULL wp");
+	not_reached();
+    }
+    if (wp->pid <= 0) {
+	return 0;
+    }
+
+    (void) fclose(wp->req);
+    wp->req = NULL;
+    (void) fclose(wp->res);
+    wp->res = NULL;
+    wp->res_fd = -1;
+    do {
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = waitpid(wp->pid, &status, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+	warnp(__func__, "waitpid of worker pid %jd failed", (intmax_t)wp->pid);
+	status = 0;
+    }
+    wp->pid = 0;
+    if (WIFSIGNALED(status)) {
+	return 128 + WTERMSIG(status);
+    }
+    return WEXITSTATUS(status);
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	str		top level usage message
+ *	prog		our program name
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = CHKENTRY_BASENAME;
+	warn(__func__, "\nin usage(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): str was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, prog, DBG_DEFAULT, JSON_DBG_DEFAULT,
+	    CHKENTRY_BASENAME, CHKENTRY_VERSION, MKIOCCCENTRY_REPO_VERSION, JPARSE_UTILS_VERSION,
+            JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
+
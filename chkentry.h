@@ -89,6 +89,31 @@
  */
 #define CHKENTRY_BASENAME "chkentry"
 
+/*
+ * chkentry -l limits and results
+ *
+ * Each result line starts with one of these, so that whether a directory
+ * passed is known without parsing the rest of the line.
+ */
+#define CHKENTRY_MAX_WORKERS (64)		/* most -n workers */
+#define CHKENTRY_RESULT_OK "{ \"ok\" : true"	/* start of the result of a directory that passed */
+#define CHKENTRY_RESULT_FAILED "{ \"ok\" : false" /* start of the result of a directory that failed */
+#define CHKENTRY_EXITED "worker exited"		/* error of a directory whose check exited the worker */
+#define CHKENTRY_RESULT_EXITED ", \"error\" : \"" CHKENTRY_EXITED "\""	/* in the result of such a directory */
+
+/*
+ * struct chk_worker - a chkentry -l worker process
+ */
+struct chk_worker
+{
+    pid_t pid;		/* process ID of the worker, 0 ==> not running */
+    FILE *req;		/* stream of directories to the worker */
+    FILE *res;		/* stream of results from the worker */
+    int res_fd;		/* file descriptor of res for poll(2) */
+    bool busy;		/* true ==> worker is checking dir */
+    char *dir;		/* directory the worker is checking as read, or NULL */
+};
+
 /*
  * externals
  */
@@ -127,6 +127,13 @@ bool usage_output_allowed = true;	/* false ==> disable usage messages */
 bool msg_warn_silent = false;		/* true ==> silence info & warnings if verbosity_level <= 0 */
 const char *const dbg_version = DBG_VERSION;	/* library version format: major.minor YYYY-MM-DD */
 
+/*
+ * per thread stream written instead of stderr, NULL ==> write stderr
+ *
+ * See set_dbg_thread_stream().
+ */
+static _Thread_local FILE *dbg_thread_stream = NULL;
+
 
 #if defined(DBG_TEST)
 #include <getopt.h>
@@ -214,6 +221,7 @@ fmsg_write(FILE *stream, char const *caller, char const *fmt, va_list ap)
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -227,6 +235,12 @@ fmsg_write(FILE *stream, char const *caller, char const *fmt, va_list ap)
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write message to stream
      */
@@ -256,6 +270,11 @@ fmsg_write(FILE *stream, char const *caller, char const *fmt, va_list ap)
 		      __func__, caller, fmt);
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -367,6 +386,7 @@ fdbg_write(FILE *stream, char const *caller, int level, char const *fmt, va_list
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -380,6 +400,12 @@ fdbg_write(FILE *stream, char const *caller, int level, char const *fmt, va_list
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write debug header
      */
@@ -420,6 +446,11 @@ fdbg_write(FILE *stream, char const *caller, int level, char const *fmt, va_list
 		      __func__, caller, level, fmt);
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -540,6 +571,7 @@ fwarn_write(FILE *stream, char const *caller, char const *name, char const *fmt,
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -553,6 +585,12 @@ fwarn_write(FILE *stream, char const *caller, char const *name, char const *fmt,
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write warning header to stream
      */
@@ -597,6 +635,11 @@ fwarn_write(FILE *stream, char const *caller, char const *name, char const *fmt,
 			       caller, __func__, caller, name, fmt, strerror(errno));
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -722,6 +765,7 @@ fwarnp_write(FILE *stream, char const *caller, char const *name, char const *fmt
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -735,6 +779,12 @@ fwarnp_write(FILE *stream, char const *caller, char const *name, char const *fmt
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write warning header to stream
      */
@@ -779,6 +829,11 @@ fwarnp_write(FILE *stream, char const *caller, char const *name, char const *fmt
 			       caller, __func__, caller, name, fmt, strerror(errno));
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -923,6 +978,7 @@ ferr_write(FILE *stream, int error_code, char const *caller,
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -936,6 +992,12 @@ ferr_write(FILE *stream, int error_code, char const *caller,
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write error diagnostic header to stream
      */
@@ -976,6 +1038,11 @@ ferr_write(FILE *stream, int error_code, char const *caller,
 			       __func__, caller, error_code, name, fmt);
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -1104,6 +1171,7 @@ ferrp_write(FILE *stream, int error_code, char const *caller,
 	}
 	stream = stderr;
     }
+    stream = dbg_stream(stream);
 
     /*
      * firewall - just return if given a NULL ptr
@@ -1117,6 +1185,12 @@ ferrp_write(FILE *stream, int error_code, char const *caller,
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write error diagnostic warning header to stream
      */
@@ -1157,6 +1231,11 @@ ferrp_write(FILE *stream, int error_code, char const *caller,
 		      __func__, caller, error_code, name, fmt);
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -1314,6 +1393,12 @@ fusage_write(FILE *stream, int error_code, char const *caller, char const *fmt,
      */
     saved_errno = errno;
 
+    /*
+     * lock stream so that the message is not interleaved with messages
+     * written by other threads
+     */
+    flockfile(stream);
+
     /*
      * write the usage message to stream
      */
@@ -1344,6 +1429,11 @@ fusage_write(FILE *stream, int error_code, char const *caller, char const *fmt,
 		      __func__, caller, error_code, fmt);
     }
 
+    /*
+     * unlock stream
+     */
+    funlockfile(stream);
+
     /*
      * restore previous errno value
      */
@@ -6264,6 +6354,58 @@ vfprintf_usage(int exitcode, FILE *stream, char const *fmt, va_list ap)
 }
 
 
+/*
+ * set_dbg_thread_stream - write messages of the calling thread to a stream instead of stderr
+ *
+ * Messages that the calling thread would write to stderr are written to
+ * stream instead, until this function is called again.  Other threads are
+ * not affected.  This lets a program that runs several jobs in threads
+ * collect the messages of each job, say with open_memstream(3), and then
+ * write them to stderr in the order of the jobs.
+ *
+ * given:
+ *	stream	    stream to write instead of stderr, NULL ==> write stderr again
+ *
+ * returns:
+ *	the previous stream of the calling thread, or NULL if it wrote stderr
+ *
+ * NOTE: The messages of functions that exit, such as err(), are also
+ *	 written to stream: a program that sets a stream should write what
+ *	 the stream holds to stderr before it exits, say with atexit(3).
+ */
+FILE *
+set_dbg_thread_stream(FILE *stream)
+{
+    FILE *prev = dbg_thread_stream;	/* previous stream of the calling thread */
+
+    dbg_thread_stream = stream;
+    return prev;
+}
+
+
+/*
+ * dbg_stream - return the stream on which to write a message
+ *
+ * given:
+ *	stream	    stream on which a message is to be written
+ *
+ * returns:
+ *	the stream of set_dbg_thread_stream() if stream is stderr and the
+ *	calling thread set one, else stream
+ *
+ * NOTE: Code outside this library that writes messages directly to
+ *	 stderr should write them on dbg_stream(stderr) instead.
+ */
+FILE *
+dbg_stream(FILE *stream)
+{
+    if (stream == stderr && dbg_thread_stream != NULL) {
+	return dbg_thread_stream;
+    }
+    return stream;
+}
+
+
 /*
  * parse_verbosity - parse -v optarg for our tools
  *
@@ -41,7 +41,7 @@
 /*
  * definitions
  */
-#define DBG_VERSION "3.2.1 2023-09-28"          /* format: major.minor YYYY-MM-DD */
+#define DBG_VERSION "3.2.3 2026-10-18"          /* format: major.minor YYYY-MM-DD */
 
 /*
  * dbg basename
@@ -240,6 +240,9 @@ extern void fprintf_usage(int exitcode, FILE *stream, const char *fmt, ...) \
 	__attribute__((format(printf, 3, 4)));		/* 3=format 4=params */
 extern void vfprintf_usage(int exitcode, FILE *stream, char const *fmt, va_list ap);
 
+extern FILE *set_dbg_thread_stream(FILE *stream);
+extern FILE *dbg_stream(FILE *stream);
+
 extern int parse_verbosity(char const *optarg);
 
 #endif				/* INCLUDE_DBG_H */
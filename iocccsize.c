@@ -8,17 +8,23 @@
  *
  * SYNOPSIS
  *
- *	usage: iocccsize [-h] [-i] [-v level] [-V] prog.c
+ *	usage: iocccsize [-h] [-i] [-v level] [-V] [-w] prog.c
  *	usage: iocccsize [-h] [-i] [-v level] [-V] < prog.c
+ *	usage: iocccsize [-h] [-i] [-v level] [-V] [-0] [-j jobs] [-f tsv|json] [file ...]
  *
  *	-i		ignored for backward compatibility
  *	-h		print usage message in stderr and exit 2
  *	-v level	set debug level (def: none)
  *	-V		print version and exit 3
+ *	-w		watch prog.c and print the counts again each time it changes
+ *	-0		also count the NUL-delimited list of files read from stdin
+ *	-j jobs		count jobs files at the same time (def: number of online CPUs)
+ *	-f format	write one row per file as tsv or json (def: tsv)
  *
  *	Exit codes:
  *		0   source code is within Rule 2a and Rule 2b limits
- *		1   source code larger than Rule 2a and/or Rule 2b limits
+ *		1   source code larger than Rule 2a and/or Rule 2b limits,
+ *		    or a file of a list cannot be read
  *		2   -h used and help printed
  *		3   -V used and version printed
  *		4   invalid command line
@@ -31,6 +37,15 @@
  *	If the debug level is > 0, then the Rule 2a, Rule 2b,
  *	and keyword count is written to stdout instead.
  *
+ *	With -w, the counts are written again each time prog.c changes,
+ *	until iocccsize is interrupted.  Only the part of prog.c from
+ *	just before the first changed byte is counted again.
+ *
+ *	Given more than one file, or any of -0, -j or -f, the files are
+ *	counted on a pool of threads and one row per file is written in
+ *	the order the files were given: the Rule 2b, Rule 2a and keyword
+ *	counts and the warnings, as tab separated values or as JSON.
+ *
  *	The entry's gross size in bytes must be less than equal to the
  *	RULE_2A_SIZE value as defined in soup/limit_ioccc.h.
  *
@@ -62,6 +77,13 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <locale.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif /* __linux__ */
 
 /*
  * For use in the https://github.com/ioccc-src/mkiocccentry repo
@@ -108,27 +130,78 @@
 #endif /* MKIOCCCENTRY_USE */
 
 
+#define WATCH_CHUNK	(4096)	/* -w bytes counted between rule_count_buf() checkpoints */
+#define WATCH_POLL	(1)	/* -w seconds between checks for a change without inotify */
+#define LIST_ALLOC	(64)	/* initial number of files of a list */
+
+/*
+ * -w watched file
+ */
+struct watch
+{
+	const char *path;		/* path of the watched file */
+	char *buf;			/* contents of the file when last counted */
+	size_t len;			/* length of buf */
+	struct rule_count_state *cp;	/* cp[k] is the state before byte k*WATCH_CHUNK */
+	size_t ncp;			/* number of checkpoints in cp */
+	size_t cp_alloc;		/* number of allocated checkpoints */
+	RuleCount count;		/* counts of the file when last counted */
+};
+
+/*
+ * a file of a list of files to count
+ */
+struct size_job
+{
+	char *path;			/* path of the file */
+	RuleCount count;		/* counts of the file */
+	bool unreadable;		/* true ==> the file cannot be opened or read */
+	bool done;			/* true ==> the file has been counted */
+};
+
+/*
+ * a list of files counted by a pool of threads
+ */
+struct size_pool
+{
+	struct size_job *job;		/* files in the order given */
+	size_t count;			/* number of files */
+	size_t alloc;			/* number of allocated files */
+	size_t next;			/* index of the next file to be taken by a thread */
+	pthread_mutex_t lock;		/* lock on next and the done flags */
+	pthread_cond_t done;		/* signaled when a file has been counted */
+};
+
 /*
  * usage message, split into strings that are small enough to be supported by C standards
  */
 static char usage0[] =
-"usage: iocccsize [-h] [-i] [-v level] [-q] [-V] prog.c\n"
+"usage: iocccsize [-h] [-i] [-v level] [-q] [-V] [-w] prog.c\n"
 "usage: iocccsize [-h] [-i] [-v level] [-q] [-V] < prog.c\n"
+"usage: iocccsize [-h] [-i] [-v level] [-q] [-V] [-0] [-j jobs] [-f tsv|json] [file ...]\n"
 "\n"
 "\t-i\t\tignored for backward compatibility\n"
 "\t-h\t\tprint usage message in stderr and exit\n"
 "\t-v level\tset debug level (def: none)\n"
 "\t-q\t\tquiet mode: silence msg(), warn(), warnp() if -v 0 (def: not msg_warn_silent)\n"
 "\t-V\t\tprint version and exit\n"
+"\t-w\t\twatch prog.c and print the counts again each time it changes\n"
+"\t-0\t\talso count the NUL-delimited list of files read from stdin\n"
+"\t-j jobs\t\tcount jobs files at the same time (def: number of online CPUs)\n"
+"\t-f format\twrite one row per file as tsv or json (def: tsv)\n"
 "\n";
 static char usage1[] =
 "\tBy default, the Rule 2b count is written to stdout.\n"
 "\tIf the debug level is > 0, then the Rule 2a, Rule 2b,\n"
 "\tand keyword count is written to stdout instead.\n"
 "\n"
+"\tGiven more than one file, or any of -0, -j or -f, one row per file\n"
+"\tis written, in the order given, with the Rule 2b, Rule 2a and\n"
+"\tkeyword counts and the warnings found.\n"
+"\n"
 "Exit codes:\n"
 "     0   source code is within Rule 2a and Rule 2b limits\n"
-"     1   source code larger than Rule 2a and/or Rule 2b limits\n"
+"     1   source code larger than Rule 2a and/or Rule 2b limits, or a file of a list cannot be read\n"
 "     2   -h used and help printed\n"
 "     3   -V used and version printed\n"
 "     4   invalid command line\n"
@@ -136,12 +209,656 @@ static char usage1[] =
 " >= 10   some internal error occurred\n";
 
 
+/*
+ * forward declarations
+ */
+static void watch(const char *path) __attribute__((noreturn));
+
+
+/*
+ * print_count - print the counts and warn about what rule_count() found
+ *
+ * By default, the Rule 2b count is printed.  If the debug level is > 0,
+ * then the Rule 2a, Rule 2b, and keyword count is printed instead.
+ *
+ * given:
+ *	count		rule_count() processing results
+ */
+static void
+print_count(RuleCount count)
+{
+	if (verbosity_level == 0) {
+		(void) printf("%zu\n", count.rule_2b_size);
+	} else {
+		(void) printf("%zu %zu %zu\n", count.rule_2b_size, count.rule_2a_size, count.keywords);
+	}
+
+	/*
+	 * issue warnings
+	 */
+        if (1 < verbosity_level && count.nul_warning) {
+		iocccsize_warnx("Warning: NUL character(s) found! Be careful you don't violate rule 13!");
+	}
+	if (count.trigraph_warning) {
+		iocccsize_warnx("Warning: unknown or invalid trigraph(s) found! Is that a bug in, or a feature of your code?");
+	}
+        if (1 < verbosity_level && 0 < count.wordbuf_warning) {
+		iocccsize_warnx("Warning: word buffer overflow! Is that a bug in, or a feature of your code?");
+	}
+	if (count.ungetc_warning) {
+		iocccsize_warnx("Warning: ungetc error: @SirWumpus goofed. The count on stdout may be invalid under rule 2!");
+	}
+	if (count.rule_2a_size > RULE_2A_SIZE) {
+		iocccsize_warnx("Warning: your source under Rule 2a: %zu exceeds Rule 2a limit: %d: Rule 2a violation!\n",
+			        count.rule_2a_size, RULE_2A_SIZE);
+	}
+	if (count.rule_2b_size > RULE_2B_SIZE) {
+		iocccsize_warnx("Warning: your source under Rule 2b: %zu exceeds Rule 2b limit: %d: Rule 2b violation!\n",
+				count.rule_2b_size, RULE_2B_SIZE);
+	}
+}
+
+
+/*
+ * read_file - read all of a file into memory
+ *
+ * given:
+ *	path		path of the file to read
+ *	plen		where to put the length of the file
+ *
+ * returns:
+ *	malloced contents of the file, or NULL ==> cannot open or read the file
+ */
+static char *
+read_file(const char *path, size_t *plen)
+{
+	FILE *fp;
+	char *buf = NULL, *newbuf;
+	size_t size = 0, len = 0, nread;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		return NULL;
+	}
+	do {
+		if (len == size) {
+			size = size == 0 ? 16 * WATCH_CHUNK : 2 * size;
+			newbuf = realloc(buf, size);
+			if (newbuf == NULL) {
+				iocccsize_errx(10, "realloc(%zu) failed", size); /*ooo*/
+				not_reached();
+			}
+			buf = newbuf;
+		}
+		nread = fread(buf + len, 1, size - len, fp);
+		len += nread;
+	} while (nread > 0);
+	if (ferror(fp)) {
+		free(buf);
+		(void) fclose(fp);
+		return NULL;
+	}
+	(void) fclose(fp);
+
+	*plen = len;
+	return buf;
+}
+
+
+/*
+ * watch_count - count the watched file from one of its checkpoints
+ *
+ * The counting state is saved at each WATCH_CHUNK boundary so that, when
+ * the file changes, counting can resume from the last checkpoint before
+ * the first changed byte.
+ *
+ * given:
+ *	w		watched file, with w->buf and w->len its new contents
+ *	from		number of the checkpoint to count from, < w->ncp
+ */
+static void
+watch_count(struct watch *w, size_t from)
+{
+	struct rule_count_state state;
+	struct rule_count_state *newcp;
+	size_t off, n;
+
+	state = w->cp[from];
+	w->ncp = from + 1;
+	off = from * WATCH_CHUNK;
+	iocccsize_dbg(1, "counting %s from offset %zu of %zu", w->path, off, w->len);
+
+	w->count = rule_count_buf(NULL, 0, &state);
+	for (; off < w->len; off += n) {
+		n = w->len - off < WATCH_CHUNK ? w->len - off : WATCH_CHUNK;
+		w->count = rule_count_buf(w->buf + off, n, &state);
+		if (n < WATCH_CHUNK) {
+			break;
+		}
+
+		/* save a checkpoint at the end of each whole chunk */
+		if (w->ncp == w->cp_alloc) {
+			newcp = realloc(w->cp, 2 * w->cp_alloc * sizeof (*w->cp));
+			if (newcp == NULL) {
+				iocccsize_errx(11, "realloc of %zu checkpoints failed", 2 * w->cp_alloc); /*ooo*/
+				not_reached();
+			}
+			w->cp = newcp;
+			w->cp_alloc *= 2;
+		}
+		w->cp[w->ncp++] = state;
+	}
+}
+
+
+/*
+ * watch_update - count the watched file again if it changed
+ *
+ * given:
+ *	w		watched file
+ *
+ * returns:
+ *	true ==> the file changed and was counted again,
+ *	false ==> the file is unchanged, or cannot be read just now
+ */
+static bool
+watch_update(struct watch *w)
+{
+	char *buf;
+	size_t len, d, from;
+
+	buf = read_file(w->path, &len);
+	if (buf == NULL) {
+		/* the file may be in the middle of being replaced */
+		iocccsize_dbg(1, "cannot read %s, waiting for the next change", w->path);
+		return false;
+	}
+
+	/* find the first changed byte */
+	for (d = 0; d < len && d < w->len && buf[d] == w->buf[d]; ++d) {
+		continue;
+	}
+	if (d == len && d == w->len) {
+		free(buf);
+		return false;
+	}
+	free(w->buf);
+	w->buf = buf;
+	w->len = len;
+
+	/* count from the last checkpoint before the first changed byte */
+	from = d / WATCH_CHUNK;
+	if (w->ncp <= from) {
+		from = w->ncp - 1;
+	}
+	watch_count(w, from);
+	return true;
+}
+
+
+/*
+ * watch - print the counts of a file each time it changes
+ *
+ * On Linux, inotify(7) tells us when the file, or a file that replaces
+ * it (as many editors do when saving), has been written.  Elsewhere, the
+ * file is checked every WATCH_POLL seconds.
+ *
+ * given:
+ *	path		path of the file to watch
+ *
+ * This function does not return.
+ */
+static void
+watch(const char *path)
+{
+	struct watch w;
+#if defined(__linux__)
+	char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	const struct inotify_event *event;
+	const char *base;
+	char *dir;
+	ssize_t nread;
+	size_t i;
+	bool changed;
+	int fd;
+#else /* __linux__ */
+	struct stat st;
+	struct stat last_st;
+#endif /* __linux__ */
+
+	(void) memset(&w, 0, sizeof (w));
+	w.path = path;
+	w.buf = read_file(path, &w.len);
+	if (w.buf == NULL) {
+		iocccsize_errx(6, "cannot read: %s", path); /*ooo*/
+		not_reached();
+	}
+	w.cp_alloc = w.len / WATCH_CHUNK + 1;
+	w.cp = malloc(w.cp_alloc * sizeof (*w.cp));
+	if (w.cp == NULL) {
+		iocccsize_errx(12, "malloc of %zu checkpoints failed", w.cp_alloc); /*ooo*/
+		not_reached();
+	}
+	rule_count_init(&w.cp[0]);
+	w.ncp = 1;
+	watch_count(&w, 0);
+	print_count(w.count);
+	(void) fflush(stdout);
+
+#if defined(__linux__)
+	/*
+	 * watch the directory of the file, as the file may be replaced
+	 */
+	base = strrchr(path, '/');
+	if (base == NULL) {
+		dir = strdup(".");
+		base = path;
+	} else {
+		dir = strdup(path);
+		if (dir != NULL) {
+			dir[base - path] = '\0';
+			if (base == path) {
+				(void) strcpy(dir, "/");
+			}
+		}
+		base++;
+	}
+	if (dir == NULL) {
+		iocccsize_errx(13, "strdup failed"); /*ooo*/
+		not_reached();
+	}
+	fd = inotify_init();
+	if (fd < 0 || inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		iocccsize_errx(14, "cannot watch directory: %s", dir); /*ooo*/
+		not_reached();
+	}
+	free(dir);
+
+	for (;;) {
+		nread = read(fd, events, sizeof (events));
+		if (nread < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			iocccsize_errx(15, "read of inotify events failed"); /*ooo*/
+			not_reached();
+		}
+		changed = false;
+		for (i = 0; i < (size_t) nread; i += sizeof (*event) + event->len) {
+			event = (const struct inotify_event *) (events + i);
+			if (0 < event->len && strcmp(event->name, base) == 0) {
+				changed = true;
+			}
+		}
+		if (changed && watch_update(&w)) {
+			print_count(w.count);
+			(void) fflush(stdout);
+		}
+	}
+#else /* __linux__ */
+	(void) memset(&last_st, 0, sizeof (last_st));
+	(void) stat(path, &last_st);
+	for (;;) {
+		(void) sleep(WATCH_POLL);
+		if (stat(path, &st) != 0) {
+			continue;
+		}
+		if (st.st_mtime == last_st.st_mtime && st.st_size == last_st.st_size && st.st_ino == last_st.st_ino) {
+			continue;
+		}
+		last_st = st;
+		if (watch_update(&w)) {
+			print_count(w.count);
+			(void) fflush(stdout);
+		}
+	}
+#endif /* __linux__ */
+}
+
+
+/*
+ * list_add - add a file to the end of a list of files to count
+ *
+ * given:
+ *	pool		list of files
+ *	path		path of the file, copied into the list
+ */
+static void
+list_add(struct size_pool *pool, const char *path)
+{
+	struct size_job *newjob;
+
+	if (pool->count == pool->alloc) {
+		pool->alloc = pool->alloc == 0 ? LIST_ALLOC : 2 * pool->alloc;
+		newjob = realloc(pool->job, pool->alloc * sizeof (*pool->job));
+		if (newjob == NULL) {
+			iocccsize_errx(16, "realloc of %zu files failed", pool->alloc); /*ooo*/
+			not_reached();
+		}
+		pool->job = newjob;
+	}
+	(void) memset(&pool->job[pool->count], 0, sizeof (*pool->job));
+	pool->job[pool->count].path = strdup(path);
+	if (pool->job[pool->count].path == NULL) {
+		iocccsize_errx(17, "strdup failed"); /*ooo*/
+		not_reached();
+	}
+	pool->count++;
+}
+
+
+/*
+ * list_read - add the NUL-delimited list of files on stdin to a list
+ *
+ * Empty names, as found after the last NUL of the list, are skipped.
+ *
+ * given:
+ *	pool		list of files
+ */
+static void
+list_read(struct size_pool *pool)
+{
+	char *path = NULL;
+	size_t size = 0;
+	ssize_t len;
+
+	while ((len = getdelim(&path, &size, '\0', stdin)) > 0) {
+		if (path[0] != '\0') {
+			list_add(pool, path);
+		}
+	}
+	if (ferror(stdin)) {
+		iocccsize_errx(18, "error reading the list of files on stdin"); /*ooo*/
+		not_reached();
+	}
+	free(path);
+}
+
+
+/*
+ * count_job - count a file of a list
+ *
+ * given:
+ *	job		file to count
+ */
+static void
+count_job(struct size_job *job)
+{
+	FILE *fp;
+
+	fp = fopen(job->path, "r");
+	if (fp == NULL) {
+		job->unreadable = true;
+		return;
+	}
+	job->count = rule_count(fp);
+	if (ferror(fp)) {
+		job->unreadable = true;
+	}
+	(void) fclose(fp);
+}
+
+
+/*
+ * size_worker - count files of a list until none are left
+ *
+ * Each thread takes the next file of the list that no other thread
+ * has taken, counts it, and marks it done so count_list() can write it.
+ *
+ * given:
+ *	arg		list of files (struct size_pool *)
+ *
+ * returns:
+ *	NULL
+ */
+static void *
+size_worker(void *arg)
+{
+	struct size_pool *pool = arg;
+	size_t j;
+
+	for (;;) {
+		(void) pthread_mutex_lock(&pool->lock);
+		if (pool->next >= pool->count) {
+			(void) pthread_mutex_unlock(&pool->lock);
+			break;
+		}
+		j = pool->next++;
+		(void) pthread_mutex_unlock(&pool->lock);
+
+		count_job(&pool->job[j]);
+
+		(void) pthread_mutex_lock(&pool->lock);
+		pool->job[j].done = true;
+		(void) pthread_cond_broadcast(&pool->done);
+		(void) pthread_mutex_unlock(&pool->lock);
+	}
+	return NULL;
+}
+
+
+/*
+ * print_tsv_path - write a path as a tab separated value
+ *
+ * Tab, newline, carriage return and backslash are written as
+ * \t, \n, \r and \\ so that each file has one row.
+ *
+ * given:
+ *	path		path to write
+ */
+static void
+print_tsv_path(const char *path)
+{
+	for (; *path != '\0'; path++) {
+		switch (*path) {
+		case '\t': (void) fputs("\\t", stdout); break;
+		case '\n': (void) fputs("\\n", stdout); break;
+		case '\r': (void) fputs("\\r", stdout); break;
+		case '\\': (void) fputs("\\\\", stdout); break;
+		default: (void) putchar(*path); break;
+		}
+	}
+}
+
+
+/*
+ * print_json_path - write a path as a JSON string
+ *
+ * given:
+ *	path		path to write
+ */
+static void
+print_json_path(const char *path)
+{
+	const unsigned char *p;
+
+	(void) putchar('"');
+	for (p = (const unsigned char *) path; *p != '\0'; p++) {
+		if (*p == '"' || *p == '\\') {
+			(void) printf("\\%c", *p);
+		} else if (*p < 0x20) {
+			(void) printf("\\u%04x", *p);
+		} else {
+			(void) putchar(*p);
+		}
+	}
+	(void) putchar('"');
+}
+
+
+/*
+ * print_row - write the counts of a file of a list
+ *
+ * A tsv row is the path, the Rule 2b, Rule 2a and keyword counts and a
+ * comma separated list of warnings (- if none), each separated by a tab.
+ * The counts of a file that cannot be read are - and its warning is
+ * unreadable.  A json row is an object with the same values.
+ *
+ * given:
+ *	job		counted file
+ *	json		true ==> write a json row, false ==> write a tsv row
+ *	first		true ==> first row of the list
+ */
+static void
+print_row(const struct size_job *job, bool json, bool first)
+{
+	const RuleCount *c = &job->count;
+	bool over_2a = !job->unreadable && RULE_2A_SIZE < c->rule_2a_size;
+	bool over_2b = !job->unreadable && RULE_2B_SIZE < c->rule_2b_size;
+	const char *sep = "";
+
+	if (json) {
+		(void) printf("%s\t\t{ \"path\" : ", first ? "" : ",\n");
+		print_json_path(job->path);
+		(void) printf(", \"unreadable\" : %s, \"rule_2b_size\" : %zu, \"rule_2a_size\" : %zu, \"keywords\" : %zu",
+			      job->unreadable ? "true" : "false", c->rule_2b_size, c->rule_2a_size, c->keywords);
+		(void) printf(", \"nul_warning\" : %s, \"trigraph_warning\" : %s, \"wordbuf_warning\" : %s",
+			      c->nul_warning ? "true" : "false", c->trigraph_warning ? "true" : "false",
+			      c->wordbuf_warning ? "true" : "false");
+		(void) printf(", \"rule_2a_violation\" : %s, \"rule_2b_violation\" : %s }",
+			      over_2a ? "true" : "false", over_2b ? "true" : "false");
+		return;
+	}
+
+	print_tsv_path(job->path);
+	if (job->unreadable) {
+		(void) printf("\t-\t-\t-\tunreadable\n");
+		return;
+	}
+	(void) printf("\t%zu\t%zu\t%zu\t", c->rule_2b_size, c->rule_2a_size, c->keywords);
+	if (c->nul_warning) {
+		(void) printf("%snul", sep);
+		sep = ",";
+	}
+	if (c->trigraph_warning) {
+		(void) printf("%strigraph", sep);
+		sep = ",";
+	}
+	if (c->wordbuf_warning) {
+		(void) printf("%swordbuf", sep);
+		sep = ",";
+	}
+	if (over_2a) {
+		(void) printf("%srule_2a", sep);
+		sep = ",";
+	}
+	if (over_2b) {
+		(void) printf("%srule_2b", sep);
+		sep = ",";
+	}
+	(void) printf("%s\n", *sep == '\0' ? "-" : "");
+}
+
+
+/*
+ * count_list - count a list of files on a pool of threads
+ *
+ * Each file is written, in the order of the list, as soon as it and
+ * the files before it have been counted, so that the output does not
+ * depend on the number of threads.
+ *
+ * given:
+ *	pool		list of files
+ *	jobs		number of files to count at the same time
+ *	json		true ==> write json, false ==> write tsv
+ *
+ * returns:
+ *	true ==> all files are readable and within the Rule 2a and Rule 2b limits
+ */
+static bool
+count_list(struct size_pool *pool, long jobs, bool json)
+{
+	pthread_t *worker = NULL;
+	size_t workers, j;
+	size_t over_limit = 0, unreadable = 0;
+	int ret;
+
+	workers = (size_t) jobs < pool->count ? (size_t) jobs : pool->count;
+	iocccsize_dbg(1, "counting %zu files with %zu threads", pool->count, workers);
+
+	if (json) {
+		(void) printf("{\n\t\"iocccsize_version\" : \"%s\",\n\t\"files\" : [\n", iocccsize_version);
+	} else {
+		(void) printf("path\trule_2b\trule_2a\tkeywords\twarnings\n");
+	}
+
+	if (1 < workers) {
+		if (pthread_mutex_init(&pool->lock, NULL) != 0 || pthread_cond_init(&pool->done, NULL) != 0) {
+			iocccsize_errx(19, "cannot initialize the thread pool lock"); /*ooo*/
+			not_reached();
+		}
+		worker = calloc(workers, sizeof (*worker));
+		if (worker == NULL) {
+			iocccsize_errx(20, "calloc of %zu threads failed", workers); /*ooo*/
+			not_reached();
+		}
+		for (j = 0; j < workers; ++j) {
+			ret = pthread_create(&worker[j], NULL, size_worker, pool);
+			if (ret != 0) {
+				iocccsize_errx(21, "pthread_create of thread %zu failed: %s", j, strerror(ret)); /*ooo*/
+				not_reached();
+			}
+		}
+	}
+
+	for (j = 0; j < pool->count; ++j) {
+		if (1 < workers) {
+			(void) pthread_mutex_lock(&pool->lock);
+			while (!pool->job[j].done) {
+				(void) pthread_cond_wait(&pool->done, &pool->lock);
+			}
+			(void) pthread_mutex_unlock(&pool->lock);
+		} else {
+			count_job(&pool->job[j]);
+		}
+		print_row(&pool->job[j], json, j == 0);
+		if (pool->job[j].unreadable) {
+			unreadable++;
+		} else if (RULE_2A_SIZE < pool->job[j].count.rule_2a_size ||
+			   RULE_2B_SIZE < pool->job[j].count.rule_2b_size) {
+			over_limit++;
+		}
+	}
+
+	if (1 < workers) {
+		for (j = 0; j < workers; ++j) {
+			ret = pthread_join(worker[j], NULL);
+			if (ret != 0) {
+				iocccsize_errx(22, "pthread_join of thread %zu failed: %s", j, strerror(ret)); /*ooo*/
+				not_reached();
+			}
+		}
+		free(worker);
+		(void) pthread_cond_destroy(&pool->done);
+		(void) pthread_mutex_destroy(&pool->lock);
+	}
+
+	if (json) {
+		(void) printf("%s\t],\n\t\"file_count\" : %zu,\n\t\"over_limit_count\" : %zu,\n\t\"unreadable_count\" : %zu\n}\n",
+			      pool->count == 0 ? "" : "\n", pool->count, over_limit, unreadable);
+	}
+	if (fflush(stdout) != 0 || ferror(stdout)) {
+		iocccsize_errx(23, "error writing to stdout"); /*ooo*/
+		not_reached();
+	}
+	iocccsize_dbg(1, "%zu files over the limits, %zu files unreadable", over_limit, unreadable);
+
+	return over_limit == 0 && unreadable == 0;
+}
+
+
 int
 main(int argc, char **argv)
 {
 	extern char *optarg;		/* option argument */
 	FILE *fp = stdin;		/* stream from which to determine sizes */
 	RuleCount count;		/* rule_count() processing results */
+	bool watch_mode = false;	/* true ==> -w, watch prog.c */
+	bool list_mode = false;		/* true ==> write one row per file of a list */
+	bool read_list = false;		/* true ==> -0, read a NUL-delimited list of files on stdin */
+	bool json = false;		/* true ==> -f json, false ==> -f tsv */
+	long jobs;			/* -j number of files to count at the same time */
+	struct size_pool pool;		/* list of files to count */
 	int ch;
 
 #if defined(MKIOCCCENTRY_USE)
@@ -149,7 +866,12 @@ main(int argc, char **argv)
 	set_ioccc_locale();
 #endif /* MKIOCCCENTRY_USE */
 
-	while ((ch = getopt(argc, argv, "6ihv:aV")) != -1) {
+	jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (jobs < 1) {
+		jobs = 1;
+	}
+
+	while ((ch = getopt(argc, argv, "6ihv:qaVw0j:f:")) != -1) {
 		switch (ch) {
 		case 'i': /* ignored for backward compatibility */
 			break;
@@ -167,6 +889,37 @@ main(int argc, char **argv)
 			msg_warn_silent = true;
 			break;
 
+		case 'w': /* watch prog.c and print counts each time it changes */
+			watch_mode = true;
+			break;
+
+		case '0': /* also count the NUL-delimited list of files on stdin */
+			read_list = true;
+			list_mode = true;
+			break;
+
+		case 'j': /* number of files to count at the same time */
+			errno = 0;
+			jobs = strtol(optarg, NULL, 0);
+			if (errno != 0 || jobs < 1) {
+			    iocccsize_errx(4, "invalid -j arg: %s", optarg); /*ooo*/
+			    not_reached();
+			}
+			list_mode = true;
+			break;
+
+		case 'f': /* format of the rows of a list */
+			if (strcmp(optarg, "json") == 0) {
+				json = true;
+			} else if (strcmp(optarg, "tsv") == 0) {
+				json = false;
+			} else {
+			    iocccsize_errx(4, "-f format must be tsv or json: %s", optarg); /*ooo*/
+			    not_reached();
+			}
+			list_mode = true;
+			break;
+
 		case 'V':
 			printf("%s\n", iocccsize_version);
 			exit(3); /*ooo*/
@@ -189,6 +942,34 @@ main(int argc, char **argv)
 		}
 	}
 
+	if (optind + 1 < argc) {
+		list_mode = true;
+	}
+	if (watch_mode) {
+		if (list_mode || optind + 1 != argc) {
+			/* -w needs a file to watch. */
+			fprintf(stderr, "%s%s", usage0, usage1);
+			exit(4); /*ooo*/
+			not_reached();
+		}
+		watch(argv[optind]);
+		not_reached();
+	}
+
+	if (list_mode) {
+		(void) memset(&pool, 0, sizeof (pool));
+		for (; optind < argc; optind++) {
+			list_add(&pool, argv[optind]);
+		}
+		if (read_list) {
+			list_read(&pool);
+		}
+		if (!count_list(&pool, jobs, json)) {
+			exit(1); /*ooo*/
+		}
+		exit(0); /*ooo*/
+	}
+
 	if (optind + 1 == argc) {
 		/* Redirect stdin to file path argument. */
 		errno = 0;
@@ -208,35 +989,7 @@ main(int argc, char **argv)
 
 	/* The Count - 1 Muha .. 2 Muhaha .. 3 Muhahaha ... */
 	count = rule_count(fp);
-	if (verbosity_level == 0) {
-		(void) printf("%zu\n", count.rule_2b_size);
-	} else {
-		(void) printf("%zu %zu %zu\n", count.rule_2b_size, count.rule_2a_size, count.keywords);
-	}
-
-	/*
-	 * issue warnings
-	 */
-        if (1 < verbosity_level && count.nul_warning) {
-		iocccsize_warnx("Warning: NUL character(s) found! Be careful you don't violate rule 13!");
-	}
-	if (count.trigraph_warning) {
-		iocccsize_warnx("Warning: unknown or invalid trigraph(s) found! Is that a bug in, or a feature of your code?");
-	}
-        if (1 < verbosity_level && 0 < count.wordbuf_warning) {
-		iocccsize_warnx("Warning: word buffer overflow! Is that a bug in, or a feature of your code?");
-	}
-	if (count.ungetc_warning) {
-		iocccsize_warnx("Warning: ungetc error: @SirWumpus goofed. The count on stdout may be invalid under rule 2!");
-	}
-	if (count.rule_2a_size > RULE_2A_SIZE) {
-		iocccsize_warnx("Warning: your source under Rule 2a: %zu exceeds Rule 2a limit: %d: Rule 2a violation!\n",
-			        count.rule_2a_size, RULE_2A_SIZE);
-	}
-	if (count.rule_2b_size > RULE_2B_SIZE) {
-		iocccsize_warnx("Warning: your source under Rule 2b: %zu exceeds Rule 2b limit: %d: Rule 2b violation!\n",
-				count.rule_2b_size, RULE_2B_SIZE);
-	}
+	print_count(count);
 
 	/*
 	 * All Done!!! All Done!!! -- Jessica Noll, Age 2
@@ -37,14 +37,35 @@ typedef struct
 	bool nul_warning;	/* true ==> found NUL */
 	bool trigraph_warning;	/* true ==> found an unknown Tri-Graph */
 	bool wordbuf_warning;	/* true ==> word buffer overflow detected */
-	bool ungetc_warning;	/* true ==> ungetc called too many times */
+	bool ungetc_warning;	/* true ==> ungetc called too many times (no longer set) */
 } RuleCount;
 
+/*
+ * rule_count_buf() counting state
+ *
+ * A copy of the state is a checkpoint: counting can be resumed from the copy.
+ */
+struct rule_count_state
+{
+	RuleCount counts;	/* counts of the data counted so far, except for pending */
+	size_t offset;		/* number of bytes given to rule_count_buf() so far */
+	int pending;		/* character waiting for the character after it, or EOF */
+	int trigraph;		/* trigraph lookahead state */
+	int quote;		/* quote character if within a string, or 0 */
+	int escape;		/* 1 ==> next character in a string is escaped */
+	int is_comment;		/* type of comment we are within, or 0 */
+	size_t wordi;		/* length of word */
+	char word[WORD_BUFFER_SIZE];	/* possible keyword being collected */
+};
+
 
 /*
  * external functions
  */
 extern RuleCount rule_count(FILE *fp_in);
+extern RuleCount rule_count_mem(const char *buf, size_t len);
+extern void rule_count_init(struct rule_count_state *state);
+extern RuleCount rule_count_buf(const char *buf, size_t len, struct rule_count_state *state);
 extern bool is_reserved(const char *string);
 
 /*
@@ -72,6 +72,11 @@
  */
 #include "json_sem.h"
 
+/*
+ * json_stream - streaming JSON event parser
+ */
+#include "json_stream.h"
+
 
 /*
  * definitions
@@ -107,6 +112,14 @@ extern int jparse_debug;
 struct json_extra
 {
     char const *filename;	/* filename being parsed ("-" means stdin) */
+
+    /* stream input - see parse_json_events() */
+    uintmax_t bytes;		/* number of bytes read from the stream */
+    size_t linenum;		/* line number of the next byte to read */
+    size_t byte_pos;		/* byte position within the current line */
+    size_t low_bytes;		/* number of low bytes ([\x01-\x08\x0e-\x1f]) read */
+    size_t nul_bytes;		/* number of NUL bytes read */
+    bool read_error;		/* true ==> error reading the stream */
 };
 
 /*
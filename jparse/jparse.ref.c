@@ -828,8 +828,29 @@ static const flex_int32_t yy_rule_can_match_eol[16] =
  */
 #include "jparse.h"
 
+/*
+ * mmap(2) of regular files - see map_json_stream()
+ */
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 extern int jparse_lex(JPARSE_STYPE *yylval_param, JPARSE_LTYPE *yylloc_param, yyscan_t scanner);
-static YY_BUFFER_STATE bs;
+
+/*
+ * stream input
+ *
+ * When the scanner reads from a stream instead of a block of memory (see
+ * parse_json_events()), flex refills its bounded buffer by calling YY_INPUT.
+ * Our jparse_input() reads the next chunk of the stream and scans it for
+ * byte values [\x00-\x08\x0e-\x1f] as it goes, as parse_json_stream() does
+ * for the entire block of data before parsing it.
+ *
+ * NOTE: YY_INPUT is not used when scanning a block of memory.
+ */
+static size_t jparse_input(struct json_extra *extra, FILE *stream, char *buf, size_t max_size);
+#define YY_INPUT(buf,result,max_size) \
+			{ (result) = (int) jparse_input(yyextra, yyin, (buf), (size_t)(max_size)); }
 
 /*
  * locations in the file / json block
@@ -877,7 +898,7 @@ static YY_BUFFER_STATE bs;
 				} \
 			    } \
 			}
-#line 826 "jparse.c"
+#line 847 "jparse.c"
 /*
  * Section 1 - Patterns (regular expressions) and actions.
  */
@@ -947,7 +968,7 @@ static YY_BUFFER_STATE bs;
  * JSON_COMMA		","
  */
 /* Actions. */
-#line 896 "jparse.c"
+#line 917 "jparse.c"
 
 #define INITIAL 0
 
@@ -1227,9 +1248,9 @@ YY_DECL
 		}
 
 	{
-#line 214 "./jparse.l"
+#line 235 "./jparse.l"
 
-#line 1178 "jparse.c"
+#line 1199 "jparse.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1300,7 +1321,7 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 215 "./jparse.l"
+#line 236 "./jparse.l"
 {
 			    /*
 			     * Whitespace excluding newlines
@@ -1325,7 +1346,7 @@ YY_RULE_SETUP
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
-#line 236 "./jparse.l"
+#line 257 "./jparse.l"
 {
                             /*
                              * on newline (JSON_NL) we need to reset the column
@@ -1336,7 +1357,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 244 "./jparse.l"
+#line 265 "./jparse.l"
 {
 			    /*
                              * string (JSON_STRING)
@@ -1346,7 +1367,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 251 "./jparse.l"
+#line 272 "./jparse.l"
 {
 			    /*
                              * number (JSON_NUMBER)
@@ -1356,7 +1377,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 258 "./jparse.l"
+#line 279 "./jparse.l"
 {
 			    /*
                              * null object (JSON_NULL)
@@ -1366,7 +1387,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 265 "./jparse.l"
+#line 286 "./jparse.l"
 {
 			    /*
                              * true (JSON_TRUE)
@@ -1376,7 +1397,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 271 "./jparse.l"
+#line 292 "./jparse.l"
 {
 			    /*
                              * false (JSON_FALSE)
@@ -1389,7 +1410,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 281 "./jparse.l"
+#line 302 "./jparse.l"
 {
 			    /*
                              * start of object - open brace i.e. "{" (JSON_OPEN_BRACE)
@@ -1399,7 +1420,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 287 "./jparse.l"
+#line 308 "./jparse.l"
 {
 			    /*
                              * end of object - close brace i.e. "}" (JSON_CLOSE_BRACE)
@@ -1409,7 +1430,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 294 "./jparse.l"
+#line 315 "./jparse.l"
 {
 			    /*
                              * start of array - open bracket i.e. "[" (JSON_OPEN_BRACKET)
@@ -1419,7 +1440,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 300 "./jparse.l"
+#line 321 "./jparse.l"
 {
 			    /*
                              * end of array - close bracket i.e. "]" (JSON_CLOSE_BRACKET)
@@ -1429,7 +1450,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 307 "./jparse.l"
+#line 328 "./jparse.l"
 {
 			    /*
                              * colon or 'equals' (JSON_COLON)
@@ -1439,7 +1460,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 314 "./jparse.l"
+#line 335 "./jparse.l"
 {
 			    /*
                              * comma: name/value pair separator (JSON_COMMA)
@@ -1449,7 +1470,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 321 "./jparse.l"
+#line 342 "./jparse.l"
 {
 			    /*
                              * invalid token: any other character (regexp ".")
@@ -1488,10 +1509,10 @@ YY_RULE_SETUP
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 357 "./jparse.l"
+#line 378 "./jparse.l"
 YY_FATAL_ERROR( "flex scanner jammed" );
 	YY_BREAK
-#line 1440 "jparse.c"
+#line 1461 "jparse.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2653,7 +2674,7 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 357 "./jparse.l"
+#line 378 "./jparse.l"
 
 
 /*
@@ -2666,6 +2687,11 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 static bool exists(char const *path);
 static bool is_file(char const *path);
 static bool is_read(char const *path);
+static void scan_low_bytes(char const *data, size_t len, size_t *linenum, size_t *byte_pos,
+			   size_t *low_bytes, size_t *nul_bytes);
+static struct json *parse_json_input(char *input, size_t len, char const *filename, bool *is_valid,
+				     bool *pborrowed);
+static char *map_json_stream(FILE *stream, size_t *plen, size_t *pmaplen);
 
 
 /*
@@ -2746,9 +2772,6 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
 {
     size_t linenum = 0;	    /* number of newline terminated lines we have processed */
     size_t byte_pos = 0;    /* byte position within the current line number */
-    bool nul_limit = false;	/* true ==> found too many NUL (\x00) bytes to report all */
-    bool low_limit = false;	/* true ==> found too many low ([\x01-\x08\x0e-\x1f]) bytes to report all */
-    size_t i = 0;
 
     /*
      * firewall
@@ -2780,13 +2803,54 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
      */
     ++linenum;
 
+    /*
+     * scan the data
+     */
+    scan_low_bytes(data, len, &linenum, &byte_pos, low_bytes, nul_bytes);
+
+    /*
+     * return the NUL detection status
+     */
+    if (*nul_bytes > 0 || *low_bytes > 0) {
+	return true;
+    }
+    return false;
+}
+
+
+/*
+ * scan_low_bytes - scan a block of data for certain low byte values
+ *
+ * This function does the scanning for low_byte_scan() and jparse_input().
+ * The line number, byte position and byte counts are carried over from
+ * one call to the next, so that a stream may be scanned a chunk at a time.
+ *
+ * given:
+ *
+ *	data	    - pointer to block of data to scan
+ *	len	    - length of data in bytes
+ *	linenum	    - pointer to the line number of the first byte of data
+ *	byte_pos    - pointer to the byte position within the line before data
+ *	low_bytes   - pointer to the number of low bytes (that aren't NUL) found so far
+ *	nul_bytes   - pointer to the number of NUL bytes found so far
+ *
+ * NOTE: Only the first MAX_NUL_BYTES_REPORTED NUL (\x00) bytes, and the first
+ *	 MAX_LOW_BYTES_REPORTED low ([\x01-\x08\x0e-\x1f]) bytes, are reported.
+ *	 See low_byte_scan() for details.
+ */
+static void
+scan_low_bytes(char const *data, size_t len, size_t *linenum, size_t *byte_pos,
+	       size_t *low_bytes, size_t *nul_bytes)
+{
+    size_t i = 0;
+
     /*
      * scan the data
      */
     for (i=0; i < len; ++i) {
 
 	/* count this byte within the line */
-	++byte_pos;
+	++(*byte_pos);
 
 	/*
 	 * process the current data byte
@@ -2802,15 +2866,14 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
 	     */
 	    if (*nul_bytes <= MAX_NUL_BYTES_REPORTED) {
 		werr(34, __func__, "invalid NUL (0) byte detected in line: %zu byte position: %zu",
-			 linenum, byte_pos);
+			 *linenum, *byte_pos);
 
 	    /*
 	     * case at or above the report limit
 	     */
-	    } else if (nul_limit == false) {
+	    } else if (*nul_bytes == MAX_NUL_BYTES_REPORTED+1) {
 		werr(35, __func__, "too many NUL ('\\0') bytes detected: "
 			 "additional NUL byte reports disabled");
-		nul_limit = true;	/* report reaching report limit only once */
 	    }
 	    break;
 
@@ -2852,23 +2915,22 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
 	     */
 	    if (*low_bytes <= MAX_LOW_BYTES_REPORTED) {
 		werr(36, __func__, "invalid LOW byte 0x%02x detected in line: %zu byte position: %zu",
-			 data[i], linenum, byte_pos);
+			 data[i], *linenum, *byte_pos);
 
 	    /*
 	     * case: at or above the report limit
 	     */
-	    } else if (low_limit == false) {
+	    } else if (*low_bytes == MAX_LOW_BYTES_REPORTED+1) {
 		werr(37, __func__, "too many LOW bytes ([\\x01-\\x08\\x0e-\\x1f] detected: "
 		         "additional low byte reports disabled");
-		low_limit = true;	/* report reaching report limit only once */
 	    }
 	    break;
 
 	case '\n':	/* \x0a - LF - Line Feed / Newline */
 
 	    /* count newline */
-	    ++linenum;
-	    byte_pos = 0;	/* reset byte position */
+	    ++(*linenum);
+	    *byte_pos = 0;	/* reset byte position */
 	    break;
 
 	default:	/* normal data byte */
@@ -2876,13 +2938,7 @@ low_byte_scan(char const *data, size_t len, size_t *low_bytes, size_t *nul_bytes
 	}
     }
 
-    /*
-     * return the NUL detection status
-     */
-    if (*nul_bytes > 0 || *low_bytes > 0) {
-	return true;
-    }
-    return false;
+    return;
 }
 
 
@@ -2919,9 +2975,9 @@ struct json *
 parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 {
     struct json *tree = NULL;		/* the JSON parse tree */
-    int ret = 0;			/* jparse_parse() return value */
-    yyscan_t scanner;			/* scanner instance: is a void * */
-    struct json_extra extra;
+    struct json_arena *arena = NULL;	/* JSON arena in use or NULL */
+    char *input = NULL;			/* copy of the JSON block that the JSON parse tree may keep */
+    bool borrowed = false;		/* true ==> JSON strings of the tree point into input */
 
     /*
      * firewall
@@ -2960,6 +3016,83 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
 	return tree;
     }
 
+    /*
+     * copy the blob into a buffer that the JSON parse tree may keep
+     *
+     * Rather than duplicate each JSON string that needs no decoding, the
+     * JSON parse tree points into this copy: see json_input_begin().  The
+     * scanner requires that the buffer end with two NUL bytes.  When a JSON
+     * arena is in use, the copy comes from (and is freed with) the arena.
+     */
+    arena = json_arena_current();
+    input = json_arena_alloc(arena, len+1+1);
+    memcpy(input, ptr, len);
+    input[len] = '\0';
+    input[len+1] = '\0';
+
+    /*
+     * scan and parse the copy
+     */
+    tree = parse_json_input(input, len, filename, is_valid, &borrowed);
+
+    /*
+     * the JSON parse tree keeps input if any of its JSON strings point into it
+     */
+    if (arena == NULL) {
+	if (borrowed && tree != NULL) {
+	    tree->input = input;
+	} else {
+	    free(input);
+	}
+	input = NULL;
+    }
+
+    /*
+     * return parse tree
+     */
+    return tree;
+}
+
+
+/*
+ * parse_json_input - scan and parse a JSON input buffer
+ *
+ * given:
+ *
+ *	input	    - writable JSON input buffer of len bytes followed by two NUL bytes
+ *	len	    - length of the JSON in input, not counting the two NUL bytes
+ *	filename    - filename, "-" for stdin or NULL to indicate it is a string
+ *	is_valid    - non-NULL pointer to boolean to set depending on JSON validity
+ *	pborrowed   - non-NULL pointer to boolean set to true if JSON strings of the
+ *		      JSON parse tree point into input, else false
+ *
+ * return:
+ *	pointer to a JSON parse tree, or NULL if the scanner could not be formed
+ *
+ * The scanner scans input in place (see yy_scan_buffer()), so it is not
+ * copied.  When *pborrowed is set to true, the caller must keep input for
+ * as long as the JSON parse tree is kept: parse_json() and
+ * parse_json_stream() give it to the top node of the tree.
+ *
+ * NOTE: the scanner writes into input as it scans, so input must be writable.
+ *
+ * NOTE: this function only warns on error.
+ */
+static struct json *
+parse_json_input(char *input, size_t len, char const *filename, bool *is_valid, bool *pborrowed)
+{
+    struct json *tree = NULL;		/* the JSON parse tree */
+    int ret = 0;			/* jparse_parse() return value */
+    yyscan_t scanner;			/* scanner instance: is a void * */
+    YY_BUFFER_STATE bs;			/* scanner buffer for input */
+    struct json_extra extra;		/* scanner extra data */
+    struct json_string_stats stats;	/* JSON string allocations saved */
+
+    /*
+     * nothing is borrowed unless the parse says so
+     */
+    *pborrowed = false;
+
     /*
      * initialise scanner
      */
@@ -2975,12 +3108,13 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
         *is_valid = false;
 	return NULL;
     }
+    memset(&extra, 0, sizeof(extra));
     extra.filename = filename;
 
     /*
      * scan the blob
      */
-    bs = yy_scan_bytes(ptr, (int)len, scanner);
+    bs = yy_scan_buffer(input, len+1+1, scanner);
     if (bs == NULL) {
 	/*
 	 * if unable to scan the bytes it indicates an internal error and
@@ -3017,28 +3151,42 @@ parse_json(char const *ptr, size_t len, char const *filename, bool *is_valid)
      * announce beginning of parse, if JSON debug level is high enough
      */
     if (json_dbg_allowed(JSON_DBG_VVHIGH)) {
-	fprstr(stderr, "*** BEGIN PARSE\n");
-	fprstr(stderr, "<\n");
-	(void) fprint_line_buf(stderr, ptr, len, 0, 0);
-	fprstr(stderr, "\n>\n");
+	fprstr(dbg_stream(stderr), "*** BEGIN PARSE\n");
+	fprstr(dbg_stream(stderr), "<\n");
+	(void) fprint_line_buf(dbg_stream(stderr), input, len, 0, 0);
+	fprstr(dbg_stream(stderr), "\n>\n");
     }
 
     /*
      * parse the blob, passing into the parser the node and scanner
      */
+    json_input_begin(input, len);
     ret = jparse_parse(&tree, scanner);
+    *pborrowed = json_input_end(&stats);
 
     /*
-     * free memory associated with bytes scanned by yy_scan_bytes()
+     * free the scanner buffer state
+     *
+     * NOTE: this does not free input as yy_scan_buffer() does not take it over.
      */
     yy_delete_buffer(bs, scanner);
     bs = NULL;
 
+    /*
+     * report the JSON string allocations saved, if JSON debug level is high enough
+     */
+    if (json_dbg_allowed(JSON_DBG_MED)) {
+	json_dbg(JSON_DBG_MED, __func__, "JSON strings: %ju shared: %ju borrowed: %ju "
+					 "allocations saved: %ju bytes saved: %ju",
+					 stats.strings, stats.shared, stats.borrowed,
+					 stats.allocs_saved, stats.bytes_saved);
+    }
+
     /*
      * announce end of parse, if JSON debug level is high enough
      */
     if (json_dbg_allowed(JSON_DBG_VVHIGH)) {
-	fprstr(stderr, "*** END PARSE\n");
+	fprstr(dbg_stream(stderr), "*** END PARSE\n");
     }
 
     /*
@@ -3172,6 +3320,11 @@ parse_json_str(char const *ptr, size_t len, bool *is_valid)
  * Given an open file stream, we will read in all data (until EOF) and
  * then parse that data as if it were JSON.
  *
+ * When the stream is a regular file that has not been read from, and no JSON
+ * arena is in use, the file is mapped into memory by map_json_stream() and
+ * scanned in place instead of being read and copied.  Pipes, terminals and
+ * the like are read by read_all().
+ *
  * given:
  *	stream      - open file stream containing JSON data
  *	filename    - name of file or NULL for stdin
@@ -3201,6 +3354,8 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     struct json *tree = NULL;		/* the JSON parse tree */
     char *data = NULL;			/* used to determine if there are NUL bytes in the file */
     size_t len = 0;			/* length of data read */
+    size_t maplen = 0;			/* if > 0, data was mapped by map_json_stream() with this length */
+    bool borrowed = false;		/* true ==> JSON strings of the tree point into data */
     bool low_byte_detected = false;	/* true ==> byte values [\x00-\x08\x0e-\x1f] detected in data */
     size_t nul_bytes = 0;		/* number of NUL bytes found */
     size_t low_bytes = 0;		/* number of low bytes that are not NUL found */
@@ -3270,9 +3425,12 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
     }
 
     /*
-     * read the entire file into memory
+     * map a regular file into memory, else read the entire stream into memory
      */
-    data = read_all(stream, &len);
+    data = map_json_stream(stream, &len, &maplen);
+    if (data == NULL) {
+	data = read_all(stream, &len);
+    }
     if (data == NULL) {
 
 	/*
@@ -3326,7 +3484,10 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
 	*is_valid = false;
 
 	/* free data */
-	if (data != NULL) {
+	if (maplen > 0) {
+	    (void) munmap(data, maplen);
+	    data = NULL;
+	} else if (data != NULL) {
 	    free(data);
 	    data = NULL;
 	}
@@ -3345,8 +3506,22 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
 
     /*
      * JSON parse the data from the file
+     *
+     * A mapped file is scanned in place and, if JSON strings of the tree
+     * point into it, kept by the top node of the tree until json_tree_free().
      */
-    tree = parse_json(data, len, filename, is_valid);
+    if (maplen > 0) {
+	tree = parse_json_input(data, len, filename, is_valid, &borrowed);
+	if (borrowed && tree != NULL) {
+	    tree->input = data;
+	    tree->input_mapped = maplen;
+	} else {
+	    (void) munmap(data, maplen);
+	}
+	data = NULL;
+    } else {
+	tree = parse_json(data, len, filename, is_valid);
+    }
 
     /* free data */
     if (data != NULL) {
@@ -3367,6 +3542,102 @@ parse_json_stream(FILE *stream, char const *filename, bool *is_valid)
 }
 
 
+/*
+ * map_json_stream - map a regular file stream into memory for the scanner
+ *
+ * The file is mapped private and writable (copy on write), as the scanner
+ * writes into the buffer that it scans, and followed by at least two NUL
+ * bytes as yy_scan_buffer() requires.  A page of anonymous memory is mapped
+ * beyond the file when the last page of the file has no room for them.
+ *
+ * given:
+ *	stream	    - open stream to map
+ *	plen	    - pointer to where to set the length of the file
+ *	pmaplen	    - pointer to where to set the length of the mapping
+ *
+ * return:
+ *	pointer to the mapped file, or NULL if the stream cannot be mapped
+ *
+ * NOTE: This function returns NULL, so that the stream may be read instead,
+ *	 if the stream is not a regular file, is empty, has been read from, if
+ *	 a JSON arena is in use, or if mmap(2) fails.
+ *
+ * NOTE: The caller must munmap(2) the returned pointer with *pmaplen bytes.
+ */
+static char *
+map_json_stream(FILE *stream, size_t *plen, size_t *pmaplen)
+{
+    struct stat buf;		/* stream status */
+    int fd = -1;		/* file descriptor of stream */
+    long pagesize = 0;		/* size of a page of memory */
+    size_t len = 0;		/* length of the file */
+    size_t maplen = 0;		/* length of the mapping: len + 2 NUL bytes rounded up to a page */
+    char *base = NULL;		/* mapping of maplen bytes */
+    void *file = NULL;		/* mapping of the file over the start of base */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL || plen == NULL || pmaplen == NULL) {
+	return NULL;
+    }
+    *plen = 0;
+    *pmaplen = 0;
+
+    /*
+     * the JSON parse tree of a JSON arena cannot keep a mapping
+     */
+    if (json_arena_current() != NULL) {
+	return NULL;
+    }
+
+    /*
+     * only map a non-empty regular file that has not been read from
+     */
+    fd = fileno(stream);
+    if (fd < 0 || fstat(fd, &buf) != 0 || !S_ISREG(buf.st_mode) || buf.st_size <= 0 ||
+	(uintmax_t)buf.st_size > (uintmax_t)SIZE_MAX - 2 || ftello(stream) != 0) {
+	return NULL;
+    }
+    len = (size_t)buf.st_size;
+    pagesize = sysconf(_SC_PAGESIZE);
+    if (pagesize <= 0) {
+	pagesize = 4096;
+    }
+    if (len > SIZE_MAX - 2 - (size_t)pagesize) {
+	return NULL;
+    }
+    maplen = (len + 2 + (size_t)pagesize - 1) / (size_t)pagesize * (size_t)pagesize;
+
+    /*
+     * map zeroed memory for the file and the NUL bytes after it, then map the file over it
+     *
+     * The bytes of the last page of the file beyond the end of the file are zero,
+     * as are those of any anonymous page after it.
+     */
+    base = mmap(NULL, maplen, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+	json_dbg(JSON_DBG_MED, __func__, "mmap of %zu anonymous bytes failed, will read stream", maplen);
+	return NULL;
+    }
+    file = mmap(base, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, fd, 0);
+    if (file == MAP_FAILED) {
+	json_dbg(JSON_DBG_MED, __func__, "mmap of %zu byte file failed, will read stream", len);
+	(void) munmap(base, maplen);
+	return NULL;
+    }
+    (void) madvise(base, len, MADV_SEQUENTIAL);
+
+    /*
+     * return the mapping
+     */
+    json_dbg(JSON_DBG_HIGH, __func__, "mapped %zu byte file into %zu bytes", len, maplen);
+    *plen = len;
+    *pmaplen = maplen;
+    return base;
+}
+
+
 /* NOTE: The following function is a static duplicate from from mkicccentry toolkit */
 /*
  * exists - if a path exists
@@ -3690,3 +3961,69 @@ parse_json_file(char const *filename, bool *is_valid)
     return tree;
 }
 
+
+/*
+ * jparse_input - read the next chunk of a stream for the scanner
+ *
+ * This function is called by YY_INPUT when the scanner reads from a stream.
+ * The bytes read are scanned for byte values [\x00-\x08\x0e-\x1f] as they
+ * are read: see low_byte_scan().  The counts are kept in the scanner extra
+ * data for the caller to check when the scan is done.
+ *
+ * given:
+ *
+ *	extra	    - scanner extra data, or NULL
+ *	stream	    - stream to read from
+ *	buf	    - buffer to read into
+ *	max_size    - maximum number of bytes to read into buf
+ *
+ * return:
+ *	number of bytes read, 0 ==> EOF or read error
+ *
+ * NOTE: On a read error, extra->read_error is set to true.
+ */
+static size_t
+jparse_input(struct json_extra *extra, FILE *stream, char *buf, size_t max_size)
+{
+    size_t len = 0;		/* number of bytes read */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL || buf == NULL || max_size <= 0) {
+	werr(62, __func__, "called with NULL stream, NULL buf or max_size <= 0");
+	if (extra != NULL) {
+	    extra->read_error = true;
+	}
+	return 0;
+    }
+
+    /*
+     * read the next chunk, retrying if interrupted
+     */
+    do {
+	clearerr(stream);	/* pre-clear ferror() status */
+	errno = 0;		/* pre-clear errno for werrp() */
+	len = fread(buf, 1, max_size, stream);
+    } while (len == 0 && ferror(stream) && errno == EINTR);
+    if (len == 0 && ferror(stream)) {
+	werrp(63, __func__, "error reading %s", (extra != NULL && extra->filename != NULL) ? extra->filename : "stream");
+	if (extra != NULL) {
+	    extra->read_error = true;
+	}
+	return 0;
+    }
+
+    /*
+     * scan the chunk for byte values in range of [\x00-\x08\x0e-\x1f]
+     */
+    if (extra != NULL && len > 0) {
+	if (extra->linenum == 0) {
+	    extra->linenum = 1;
+	}
+	extra->bytes += len;
+	scan_low_bytes(buf, len, &extra->linenum, &extra->byte_pos, &extra->low_bytes, &extra->nul_bytes);
+    }
+    return len;
+}
+
@@ -586,7 +586,7 @@ static const yytype_int16 yyrline[] =
 {
        0,   237,   237,   295,   326,   357,   388,   419,   454,   488,
      524,   555,   585,   619,   658,   694,   725,   755,   789,   827,
-     860,   902
+     860,   914
 };
 #endif
 
@@ -2221,6 +2221,18 @@ yyreduce:
 	/* action */
 	yyval = json_parse_string(jparse_get_text(scanner), (size_t)jparse_get_leng(scanner));
 
+	/*
+	 * a JSON string that cannot be decoded (say because of an invalid
+	 * \-escape) makes the JSON invalid: report it as a syntax error, as
+	 * parse_json_events() does, and stop parsing
+	 */
+	if (!VALID_JSON_NODE(&(yyval->item.string))) {
+	    yyerror(&(yylsp[0]), NULL, scanner, "syntax error");
+	    json_tree_free(yyval, JSON_DEFAULT_MAX_DEPTH);
+	    yyval = NULL;
+	    YYABORT;
+	}
+
 	/* post-action debugging */
 	if (json_dbg_allowed(JSON_DBG_HIGH)) {
 	    json_dbg(JSON_DBG_HIGH, __func__, "under json_string: returning $json_string type: %s",
@@ -2230,11 +2242,11 @@ yyreduce:
 					       "json_string: JSON_STRING");
 	}
     }
-#line 2180 "jparse.tab.c"
+#line 2192 "jparse.tab.c"
     break;
 
   case 21: /* json_number: JSON_NUMBER  */
-#line 903 "./jparse.y"
+#line 915 "./jparse.y"
     {
 	/*
 	 * $$ = $json_number
@@ -2266,11 +2278,11 @@ yyreduce:
 					       "json_number: JSON_NUMBER");
 	}
     }
-#line 2216 "jparse.tab.c"
+#line 2228 "jparse.tab.c"
     break;
 
 
-#line 2220 "jparse.tab.c"
+#line 2232 "jparse.tab.c"
 
         default: break;
       }
@@ -2477,7 +2489,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 937 "./jparse.y"
+#line 949 "./jparse.y"
 
 
 
@@ -2503,6 +2515,7 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
 {
     va_list ap;		/* variable argument list */
     int ret;		/* libc function return value */
+    FILE *stream;	/* stderr, or the stream of set_dbg_thread_stream() */
 
     /*
      * firewall
@@ -2519,35 +2532,44 @@ yyerror(JPARSE_LTYPE *yyltype, struct json **node, yyscan_t scanner, char const
 
     /*
      * generate an error message for the JSON parser and scanner
+     *
+     * NOTE: the message is written with several calls so we lock the stream
+     * while writing it so that messages from parsers running in other
+     * threads (see jparse -j) are not interleaved with this one.  It is
+     * written on dbg_stream(stderr) so that jparse -j can write the messages
+     * of each arg in the order of the args.
      */
-    vfpr(stderr, __func__, format, ap);
+    stream = dbg_stream(stderr);
+    flockfile(stream);
+    vfpr(stream, __func__, format, ap);
     if (node != NULL && *node != NULL) {
-	fprint(stderr, " node type %s", json_item_type_name(*node));
+	fprint(stream, " node type %s", json_item_type_name(*node));
     }
     if (yyltype != NULL) {
 	    if (yyltype->filename != NULL && *yyltype->filename != '\0') {
-		fprint(stderr, " in file %s", yyltype->filename);
+		fprint(stream, " in file %s", yyltype->filename);
 	    }
-	    fprint(stderr, " at line %d column %d: ", yyltype->first_line, yyltype->first_column);
+	    fprint(stream, " at line %d column %d: ", yyltype->first_line, yyltype->first_column);
     }
     if (jparse_get_text(scanner) != NULL && *jparse_get_text(scanner) != '\0') {
-	fprint(stderr, "%s\n", jparse_get_text(scanner));
+	fprint(stream, "%s\n", jparse_get_text(scanner));
     } else if (jparse_get_text(scanner) == NULL) {
-	fprstr(stderr, "text == NULL\n");
+	fprstr(stream, "text == NULL\n");
     } else {
-	fprstr(stderr, "empty text\n");
+	fprstr(stream, "empty text\n");
     }
+    funlockfile(stream);
 
     /*
-     * flush stderr
+     * flush the stream
      */
-    clearerr(stderr);           /* pre-clear ferror() status */
+    clearerr(stream);           /* pre-clear ferror() status */
     errno = 0;                  /* pre-clear errno for warnp() */
-    ret = fflush(stderr);
+    ret = fflush(stream);
     if (ret == EOF) {
-        if (ferror(stderr)) {
+        if (ferror(stream)) {
             warnp(__func__, "called from %s: error flushing stream", __func__);
-        } else if (feof(stderr)) {
+        } else if (feof(stream)) {
             warnp(__func__, "called from %s: EOF while flushing stream", __func__);
         } else {
             warnp(__func__, "called from %s: unexpected fflush error while flushing stream", __func__);
@@ -60,11 +60,19 @@
  */
 #define REQUIRED_ARGS (1)	/* number of required arguments on the command line */
 
+/*
+ * job of a worker thread whose diagnostics are being collected
+ *
+ * See write_worker_diag().
+ */
+static _Thread_local struct jparse_job *worker_job = NULL;	/* job being parsed, or NULL */
+static _Thread_local FILE *worker_diag = NULL;			/* stream collecting its diagnostics */
+
 /*
  * usage message
  */
 static const char * const usage_msg =
-    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] arg...\n"
+    "usage: %s [-h] [-v level] [-J level] [-q] [-V] [-s] [-S] [-j jobs] [-l] arg...\n"
     "\n"
     "\t-h\t\tprint help message and exit\n"
     "\t-v level\tset verbosity level (def level: %d)\n"
@@ -72,9 +80,14 @@ static const char * const usage_msg =
     "\t-q\t\tquiet mode: silence msg(), warn(), warnp() if -v 0 (def: loud :-) )\n"
     "\t-V\t\tprint version strings and exit\n"
     "\t-s\t\targ is a string (def: arg is a filename)\n"
+    "\t-S\t\tstreaming validate: scan JSON as it is read without forming a parse tree\n"
+    "\t-j jobs\t\tparse up to jobs args at the same time (def: 1, max: %d)\n"
+    "\t-l\t\tread the list of args from stdin, one per line (no args are given)\n"
     "\n"
     "\targ\t\tparse JSON for string (if -s), file (w/o -s), or stdin (if arg is -)\n"
     "\n"
+    "NOTE: results are reported in the order the args are given, even with -j.\n"
+    "\n"
     "Exit codes:\n"
     "    0\tJSON is valid\n"
     "    1\tJSON is invalid\n"
@@ -92,6 +105,11 @@ static const char * const usage_msg =
  * static functions
  */
 static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+static struct dyn_array *read_arg_list(FILE *stream);
+static void parse_job(struct jparse_job *job, bool string_flag_used, bool stream_flag_used);
+static bool report_job(char const *program, struct jparse_job const *job, bool string_flag_used, bool stream_flag_used);
+static void *jparse_worker(void *arg);
+static void write_worker_diag(void);
 
 
 int
@@ -100,12 +118,19 @@ main(int argc, char **argv)
     char const *program = NULL;	    /* our name */
     extern char *optarg;	    /* option argument */
     extern int optind;		    /* argv index of the next arg */
-    char *input = NULL;		    /* argument to process */
-    bool string_flag_used = false;  /* true ==> -S string was used */
-    bool valid_json = false;	    /* true ==> JSON parse was valid */
+    bool string_flag_used = false;  /* true ==> -s string was used */
+    bool stream_flag_used = false;  /* true ==> -S streaming validate was used */
+    bool list_flag_used = false;    /* true ==> -l read args from stdin was used */
+    intmax_t jobs = 1;		    /* -j jobs - number of worker threads */
+    struct dyn_array *list = NULL;  /* -l list of args read from stdin */
+    char **args = NULL;		    /* args to process */
+    struct jparse_pool pool;	    /* jobs and the state shared with the worker threads */
+    pthread_t *worker = NULL;	    /* worker threads */
+    size_t workers = 0;		    /* number of worker threads started */
     int exit_code = 0;              /* exit code depends on if any JSON is invalid */
-    struct json *tree = NULL;	    /* JSON parse tree or NULL */
     bool opt_error = false;		/* fchk_inval_opt() return */
+    size_t j;
+    int ret;
     int i;
 
     /*
@@ -117,7 +142,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:qVsJ:")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:qVsSJ:j:l")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 0 */
 	    usage(2, program, ""); /*ooo*/
@@ -157,6 +182,18 @@ main(int argc, char **argv)
 	case 's':
 	    string_flag_used = true;
 	    break;
+	case 'S':
+	    stream_flag_used = true;
+	    break;
+	case 'j':		/* -j jobs */
+	    if (!string_to_intmax(optarg, &jobs) || jobs <= 0 || jobs > JPARSE_MAX_JOBS) {
+		usage(3, program, "invalid -j jobs"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'l':
+	    list_flag_used = true;
+	    break;
 	case ':':   /* option requires an argument */
 	case '?':   /* illegal option */
 	default:    /* anything else but should not actually happen */
@@ -170,71 +207,162 @@ main(int argc, char **argv)
 	    break;
 	}
     }
-    if (argc - optind < REQUIRED_ARGS) {
+    if (list_flag_used) {
+	if (argc - optind != 0) {
+	    usage(3, program, "no args may be given with -l"); /*ooo*/
+	    not_reached();
+	}
+    } else if (argc - optind < REQUIRED_ARGS) {
 	usage(3, program, "wrong number of arguments"); /*ooo*/
 	not_reached();
     }
 
     /*
-     * case: process arguments on command line
+     * form the list of args to process
+     */
+    memset(&pool, 0, sizeof(pool));
+    if (list_flag_used) {
+	list = read_arg_list(stdin);
+	args = dyn_array_first(list, char *);
+	pool.count = (size_t)dyn_array_tell(list);
+    } else {
+	args = argv + optind;
+	pool.count = (size_t)(argc - optind);
+    }
+    pool.string_flag_used = string_flag_used;
+    pool.stream_flag_used = stream_flag_used;
+    if (pool.count > 0) {
+	errno = 0;		/* pre-clear errno for errp() */
+	pool.job = calloc(pool.count, sizeof(pool.job[0]));
+	if (pool.job == NULL) {
+	    errp(4, program, "cannot allocate %zu jobs", pool.count);
+	    not_reached();
+	}
+	for (j=0; j < pool.count; ++j) {
+	    pool.job[j].input = args[j];
+	}
+    }
+    workers = (size_t)jobs < pool.count ? (size_t)jobs : pool.count;
+
+    /*
+     * case: one worker - parse and report each arg in order
+     */
+    if (workers <= 1) {
+	for (j=0; j < pool.count; ++j) {
+	    parse_job(&pool.job[j], string_flag_used, stream_flag_used);
+	    if (!report_job(program, &pool.job[j], string_flag_used, stream_flag_used)) {
+		exit_code = 1;
+	    }
+	}
+
+    /*
+     * case: more than one worker - parse args in worker threads, report in order
      */
-    if (argc - optind > 0) {
+    } else {
+
 	/*
-	 * process each argument in order
+	 * select the JSON string scanner before the workers share it
 	 */
-	for (i=optind; i < argc; ++i) {
-	    /*
-	     * obtain argument string
-	     */
-	    input = argv[i];
-            /*
-             * case: process -s arg
-             */
-            if (string_flag_used == true) {
-
-                /* parse arg as a block of json input */
-                dbg(DBG_HIGH, "Calling parse_json_str(%s, %zu, &valid_json):",
-                              input, strlen(input));
-
-                tree = parse_json_str(input, strlen(input), &valid_json);
-                if (tree == NULL || !valid_json) {
-                    warn(program, "JSON parse tree is NULL for string: \"%s\"", input);
-                    exit_code = 1;
-                }
-                /*
-                 * free the JSON parse tree
-                 */
-                else {
-                    json_tree_free(tree, JSON_INFINITE_DEPTH);
-                    free(tree);
-                    tree = NULL;
-                }
-
-            /*
-             * case: process file arg
-             */
-            } else {
-
-                /* parse arg as a json filename */
-                dbg(DBG_HIGH, "Calling parse_json_file(\"%s\", &valid_json):", input);
-
-                tree = parse_json_file(input, &valid_json);
-                if (tree == NULL || !valid_json) {
-                    warn(program, "JSON parse tree is NULL for file: %s", input);
-                    exit_code = 1;
-                }
-                /*
-                 * free the JSON parse tree
-                 */
-                else {
-                    json_tree_free(tree, JSON_INFINITE_DEPTH);
-                    free(tree);
-                    tree = NULL;
-                }
-            }
-
-        }
+	(void) json_scan_current();
+
+	/*
+	 * should a worker exit, write the diagnostics of its job before it does
+	 */
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = atexit(write_worker_diag);
+	if (ret != 0) {
+	    errp(16, program, "atexit failed");
+	    not_reached();
+	}
+
+	/*
+	 * start the workers
+	 */
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = pthread_mutex_init(&pool.lock, NULL);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(5, program, "pthread_mutex_init failed");
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = pthread_cond_init(&pool.done, NULL);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(6, program, "pthread_cond_init failed");
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	worker = calloc(workers, sizeof(worker[0]));
+	if (worker == NULL) {
+	    errp(7, program, "cannot allocate %zu worker threads", workers);
+	    not_reached();
+	}
+	dbg(DBG_MED, "starting %zu worker threads for %zu args", workers, pool.count);
+	for (j=0; j < workers; ++j) {
+	    ret = pthread_create(&worker[j], NULL, jparse_worker, &pool);
+	    if (ret != 0) {
+		errno = ret;
+		errp(8, program, "pthread_create of worker %zu failed", j);
+		not_reached();
+	    }
+	}
+
+	/*
+	 * report each arg, in order, as soon as it has been parsed
+	 */
+	for (j=0; j < pool.count; ++j) {
+	    (void) pthread_mutex_lock(&pool.lock);
+	    while (!pool.job[j].done) {
+		(void) pthread_cond_wait(&pool.done, &pool.lock);
+	    }
+	    (void) pthread_mutex_unlock(&pool.lock);
+	    if (pool.job[j].diag != NULL) {
+		if (pool.job[j].diag_len > 0) {
+		    (void) fwrite(pool.job[j].diag, 1, pool.job[j].diag_len, stderr);
+		    (void) fflush(stderr);
+		}
+		free(pool.job[j].diag);
+		pool.job[j].diag = NULL;
+		pool.job[j].diag_len = 0;
+	    }
+	    if (!report_job(program, &pool.job[j], string_flag_used, stream_flag_used)) {
+		exit_code = 1;
+	    }
+	}
+
+	/*
+	 * wait for the workers to finish
+	 */
+	for (j=0; j < workers; ++j) {
+	    ret = pthread_join(worker[j], NULL);
+	    if (ret != 0) {
+		errno = ret;
+		errp(9, program, "pthread_join of worker %zu failed", j);
+		not_reached();
+	    }
+	}
+	free(worker);
+	worker = NULL;
+	(void) pthread_cond_destroy(&pool.done);
+	(void) pthread_mutex_destroy(&pool.lock);
+    }
+
+    /*
+     * free storage
+     */
+    if (pool.job != NULL) {
+	free(pool.job);
+	pool.job = NULL;
     }
+    if (list != NULL) {
+	for (j=0; j < pool.count; ++j) {
+	    free(dyn_array_value(list, char *, j));
+	}
+	dyn_array_free(list);
+	list = NULL;
+    }
+
     /*
      * firewall - JSON parser must have returned a valid JSON parse tree
      */
@@ -251,6 +379,322 @@ main(int argc, char **argv)
 }
 
 
+/*
+ * read_arg_list - read the -l list of args, one per line
+ *
+ * given:
+ *	stream	    open stream to read the list from
+ *
+ * returns:
+ *	dynamic array of malloced args (char *), in the order read
+ *
+ * NOTE: the newline at the end of each line is removed and empty lines
+ *	 are ignored.
+ *
+ * NOTE: this function does not return on error.
+ */
+static struct dyn_array *
+read_arg_list(FILE *stream)
+{
+    struct dyn_array *list = NULL;	/* list of args */
+    char *line = NULL;			/* line read from stream */
+    size_t linecap = 0;			/* allocated size of line */
+    ssize_t len = 0;			/* length of line read */
+    char *arg = NULL;			/* malloced copy of line */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(10, __func__, "NULL stream");
+	not_reached();
+    }
+
+    /*
+     * read each line as an arg
+     */
+    list = dyn_array_create(sizeof(char *), JPARSE_LIST_CHUNK, JPARSE_LIST_CHUNK, true);
+    clearerr(stream);			/* pre-clear ferror() status */
+    errno = 0;				/* pre-clear errno for errp() */
+    while ((len = getline(&line, &linecap, stream)) >= 0) {
+	if (len > 0 && line[len-1] == '\n') {
+	    line[--len] = '\0';
+	}
+	if (len == 0) {
+	    continue;
+	}
+	errno = 0;			/* pre-clear errno for errp() */
+	arg = strdup(line);
+	if (arg == NULL) {
+	    errp(11, __func__, "strdup of arg failed");
+	    not_reached();
+	}
+	(void) dyn_array_append_value(list, &arg);
+	errno = 0;			/* pre-clear errno for errp() */
+    }
+    if (ferror(stream)) {
+	errp(12, __func__, "error reading the list of args");
+	not_reached();
+    }
+    if (line != NULL) {
+	free(line);
+	line = NULL;
+    }
+    dbg(DBG_MED, "read %ju args from the list", (uintmax_t)dyn_array_tell(list));
+    return list;
+}
+
+
+/*
+ * parse_job - parse the arg of a job and record the result
+ *
+ * given:
+ *	job		    the job to parse
+ *	string_flag_used    true ==> arg is a string, false ==> arg is a filename
+ *	stream_flag_used    true ==> validate arg without forming a JSON parse tree
+ *
+ * NOTE: This function prints nothing other than parser diagnostics and
+ *	 debug messages: the result is reported by report_job().  Thus
+ *	 different jobs may be parsed by different threads at the same time.
+ *
+ * NOTE: this function does not return on error.
+ */
+static void
+parse_job(struct jparse_job *job, bool string_flag_used, bool stream_flag_used)
+{
+    char *input = NULL;		    /* argument to process */
+    FILE *stream = NULL;	    /* stream to validate with -S */
+    bool valid_json = false;	    /* true ==> JSON parse was valid */
+    struct json *tree = NULL;	    /* JSON parse tree or NULL */
+
+    /*
+     * firewall
+     */
+    if (job == NULL || job->input == NULL) {
+	err(13, __func__, "NULL job or job input");
+	not_reached();
+    }
+    input = job->input;
+
+    /*
+     * case: process arg with -S, without forming a JSON parse tree
+     */
+    if (stream_flag_used == true) {
+
+	/*
+	 * open a stream for the string or file
+	 */
+	errno = 0;		/* pre-clear errno for warnp() */
+	if (string_flag_used == true) {
+	    stream = fmemopen(input, strlen(input), "r");
+	} else if (strcmp(input, "-") == 0) {
+	    stream = stdin;
+	} else {
+	    stream = fopen(input, "r");
+	}
+	if (stream == NULL) {
+	    job->open_err = true;
+	    job->open_errno = errno;
+	    job->valid = false;
+	    return;
+	}
+
+	/* validate arg as a stream of JSON events */
+	dbg(DBG_HIGH, "Calling parse_json_events(stream, \"%s\", NULL, NULL, &valid_json):",
+		      string_flag_used ? "" : input);
+
+	(void) parse_json_events(stream, string_flag_used ? "" : input, NULL, NULL, &valid_json);
+	stream = NULL;
+	job->valid = valid_json;
+
+    /*
+     * case: process -s arg
+     */
+    } else if (string_flag_used == true) {
+
+	/* parse arg as a block of json input */
+	dbg(DBG_HIGH, "Calling parse_json_str(%s, %zu, &valid_json):",
+		      input, strlen(input));
+
+	tree = parse_json_str(input, strlen(input), &valid_json);
+	job->valid = (tree != NULL && valid_json);
+
+    /*
+     * case: process file arg
+     */
+    } else {
+
+	/* parse arg as a json filename */
+	dbg(DBG_HIGH, "Calling parse_json_file(\"%s\", &valid_json):", input);
+
+	tree = parse_json_file(input, &valid_json);
+	job->valid = (tree != NULL && valid_json);
+    }
+
+    /*
+     * free the JSON parse tree
+     */
+    if (tree != NULL) {
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+	free(tree);
+	tree = NULL;
+    }
+    return;
+}
+
+
+/*
+ * report_job - report the result of a parsed job
+ *
+ * given:
+ *	program		    our program name
+ *	job		    the parsed job to report
+ *	string_flag_used    true ==> arg is a string, false ==> arg is a filename
+ *	stream_flag_used    true ==> arg was validated without forming a JSON parse tree
+ *
+ * returns:
+ *	true ==> JSON of the job is valid, false ==> JSON is invalid
+ *
+ * NOTE: this function does not return on error.
+ */
+static bool
+report_job(char const *program, struct jparse_job const *job, bool string_flag_used, bool stream_flag_used)
+{
+    /*
+     * firewall
+     */
+    if (program == NULL || job == NULL || job->input == NULL) {
+	err(14, __func__, "NULL program, job or job input");
+	not_reached();
+    }
+
+    /*
+     * report an invalid job
+     */
+    if (job->open_err) {
+	errno = job->open_errno;	/* restore errno for warnp() */
+	warnp(program, "cannot open %s: %s", string_flag_used ? "string" : "file", job->input);
+    } else if (!job->valid) {
+	if (stream_flag_used == true) {
+	    warn(program, "JSON is invalid for %s: %s", string_flag_used ? "string" : "file", job->input);
+	} else if (string_flag_used == true) {
+	    warn(program, "JSON parse tree is NULL for string: \"%s\"", job->input);
+	} else {
+	    warn(program, "JSON parse tree is NULL for file: %s", job->input);
+	}
+    }
+    return job->valid;
+}
+
+
+/*
+ * jparse_worker - parse jobs of a pool until there are none left
+ *
+ * given:
+ *	arg	pointer to the struct jparse_pool
+ *
+ * returns:
+ *	NULL
+ *
+ * Each worker takes the next job of the pool that no other worker has
+ * taken, parses it and marks it done, so that main() can report it.  The
+ * diagnostics of the job are collected in the job, so that main() writes
+ * them in the order of the jobs, not in the order the jobs were parsed.
+ *
+ * NOTE: this function does not return on error.
+ */
+static void *
+jparse_worker(void *arg)
+{
+    struct jparse_pool *pool = arg;	/* jobs and the state shared with main() */
+    FILE *diag = NULL;			/* stream collecting the diagnostics of the job */
+    size_t j;				/* index of job taken */
+    int ret;				/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (pool == NULL) {
+	err(15, __func__, "NULL pool");
+	not_reached();
+    }
+
+    /*
+     * parse jobs until there are none left
+     */
+    for (;;) {
+
+	/*
+	 * take the next job
+	 */
+	(void) pthread_mutex_lock(&pool->lock);
+	if (pool->next >= pool->count) {
+	    (void) pthread_mutex_unlock(&pool->lock);
+	    break;
+	}
+	j = pool->next++;
+	(void) pthread_mutex_unlock(&pool->lock);
+
+	/*
+	 * parse the job, collecting its diagnostics for main() to write in order
+	 */
+	errno = 0;		/* pre-clear errno for errp() */
+	diag = open_memstream(&pool->job[j].diag, &pool->job[j].diag_len);
+	if (diag == NULL) {
+	    errp(17, __func__, "open_memstream for the diagnostics of job %zu failed", j);
+	    not_reached();
+	}
+	worker_job = &pool->job[j];
+	worker_diag = diag;
+	(void) set_dbg_thread_stream(diag);
+	parse_job(&pool->job[j], pool->string_flag_used, pool->stream_flag_used);
+	(void) set_dbg_thread_stream(NULL);
+	worker_diag = NULL;
+	worker_job = NULL;
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = fclose(diag);
+	if (ret != 0) {
+	    errp(18, __func__, "fclose of the diagnostics of job %zu failed", j);
+	    not_reached();
+	}
+	diag = NULL;
+
+	/*
+	 * tell main() the job is done
+	 */
+	(void) pthread_mutex_lock(&pool->lock);
+	pool->job[j].done = true;
+	(void) pthread_cond_broadcast(&pool->done);
+	(void) pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+
+/*
+ * write_worker_diag - write the diagnostics collected for the job of a worker
+ *
+ * This function is registered with atexit(3) so that, should a worker thread
+ * exit (say on an internal error), what was collected for its job, including
+ * the message of the error, is written to stderr and not lost.  Called in any
+ * other thread, or when no job is being parsed, it does nothing.
+ */
+static void
+write_worker_diag(void)
+{
+    if (worker_diag == NULL || worker_job == NULL) {
+	return;
+    }
+    (void) set_dbg_thread_stream(NULL);
+    (void) fflush(worker_diag);
+    if (worker_job->diag != NULL && worker_job->diag_len > 0) {
+	(void) fwrite(worker_job->diag, 1, worker_job->diag_len, stderr);
+	(void) fflush(stderr);
+    }
+    return;
+}
+
+
 /*
  * usage - print usage to stderr
  *
@@ -290,7 +734,7 @@ usage(int exitcode, char const *prog, char const *str)
 	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
     }
     fprintf_usage(exitcode, stderr, usage_msg, prog,
-		  DBG_DEFAULT, JSON_DBG_DEFAULT, JPARSE_BASENAME, JPARSE_TOOL_VERSION, JPARSE_UTILS_VERSION, JPARSE_UTF8_VERSION,
+		  DBG_DEFAULT, JSON_DBG_DEFAULT, JPARSE_MAX_JOBS, JPARSE_BASENAME, JPARSE_TOOL_VERSION, JPARSE_UTILS_VERSION, JPARSE_UTF8_VERSION,
                   JPARSE_LIBRARY_VERSION);
     exit(exitcode); /*ooo*/
     not_reached();
@@ -80,7 +80,48 @@
 /*
  * jparse tool basename
  */
+#include <pthread.h>
+
+
 #define JPARSE_BASENAME "jparse"
 
+#define JPARSE_MAX_JOBS (1024)	/* maximum number of -j worker threads */
+#define JPARSE_LIST_CHUNK (1024) /* allocation chunk for the -l list of args */
+
+
+/*
+ * struct jparse_job - an arg to parse and the result of parsing it
+ *
+ * A job is parsed by a worker thread (or by main() when there is only one
+ * worker) and reported by main() in the order given on the command line.
+ * A worker thread prints nothing: the parser diagnostics of the job are
+ * collected in diag and written by main() when it reports the job.
+ */
+struct jparse_job
+{
+    char *input;		/* string or filename to parse */
+    bool done;			/* true ==> job has been parsed */
+    bool valid;			/* true ==> JSON is valid */
+    bool open_err;		/* true ==> -S arg could not be opened */
+    int open_errno;		/* errno when -S arg could not be opened */
+    char *diag;			/* diagnostics of a job parsed by a worker thread, or NULL */
+    size_t diag_len;		/* length of diag */
+};
+
+
+/*
+ * struct jparse_pool - a set of jobs parsed by a pool of worker threads
+ */
+struct jparse_pool
+{
+    struct jparse_job *job;	/* jobs in the order given */
+    size_t count;		/* number of jobs */
+    size_t next;		/* index of the next job to be taken by a worker */
+    bool string_flag_used;	/* true ==> -s: each job is a string */
+    bool stream_flag_used;	/* true ==> -S: validate each job without forming a parse tree */
+    pthread_mutex_t lock;	/* lock on next and the done flags */
+    pthread_cond_t done;	/* signaled when a job is done */
+};
+
 
 #endif /* INCLUDE_JPARSE_MAIN_H */
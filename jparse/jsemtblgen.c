@@ -268,6 +268,7 @@ static int sem_cmp(void const *a, void const *b);
 static char *alloc_c_funct_name(char const *prefix, char const *str);
 static bool append_unique_str(struct dyn_array *tbl, char *str);
 static void print_sem_c_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
+static void print_sem_hash_src(struct dyn_array *tbl, char *tbl_name);
 static void print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
 static Word *find_member(Word *table, const char *string);
 static bool test_reserved(const char *string);
@@ -1217,6 +1218,130 @@ print_sem_c_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name)
     prstr("  { 0,\tJTYPE_UNSET,\t0,\t0,\t0,\t-1,\t0,\tNULL,\tNULL,\tNULL }\n");
     prstr("};\n");
 
+    /*
+     * print the perfect hash of the semantic table
+     */
+    print_sem_hash_src(tbl, tbl_name);
+
+    return;
+}
+
+
+/*
+ * print_sem_hash_src - print the perfect hash of a sorted semantic table as .c src
+ *
+ * The hash is formed by json_sem_hash_build() from the semantic table as it
+ * was printed by print_sem_c_src(), so that json_sem_check_hash() can find
+ * semantic table entries without searching the table.
+ *
+ * given:
+ *	tbl		dynamic array of sorted semantic table entries
+ *	tbl_name	name of the semantic table
+ *
+ * NOTE: This function does not return if given NULL pointers or on error.
+ */
+static void
+print_sem_hash_src(struct dyn_array *tbl, char *tbl_name)
+{
+    struct json_sem *sem = NULL;	/* semantic table as printed */
+    struct json_sem *p = NULL;		/* current semantic table entry */
+    struct json_sem_hash *hash = NULL;	/* perfect hash of the printed semantic table */
+    struct json_sem_slot *slot = NULL;	/* current hash slot */
+    intmax_t len = 0;			/* number of semantic table entries */
+    intmax_t i;
+
+    /*
+     * firewall
+     */
+    if (tbl == NULL) {
+	err(34, __func__, "tbl is NULL");
+	not_reached();
+    }
+    if (tbl_name == NULL) {
+	err(35, __func__, "tbl_name is NULL");
+	not_reached();
+    }
+
+    /*
+     * form the semantic table with names as they were printed
+     */
+    len = dyn_array_tell(tbl);
+    errno = 0;		/* pre-clear errno for errp() */
+    sem = calloc((size_t)len + 1, sizeof(*sem));
+    if (sem == NULL) {
+	errp(36, __func__, "calloc of %jd semantic table entries failed", len + 1);
+	not_reached();
+    }
+    for (i=0; i < len; ++i) {
+	p = dyn_array_addr(tbl, struct json_sem, i);
+	sem[i].depth = p->depth;
+	sem[i].type = p->type;
+	sem[i].name_len = p->name_len;
+	if (p->name != NULL) {
+	    sem[i].name = alloc_c_funct_name(NULL, p->name);
+	    if (sem[i].name == NULL) {
+		err(37, __func__, "alloc_c_funct_name failed for semantic table entry: %jd", i);
+		not_reached();
+	    }
+	}
+    }
+    sem[len].type = JTYPE_UNSET;
+
+    /*
+     * form the perfect hash of the semantic table
+     */
+    hash = json_sem_hash_build(sem);
+    if (hash == NULL) {
+	err(38, __func__, "json_sem_hash_build failed");
+	not_reached();
+    }
+
+    /*
+     * print the bucket displacements
+     */
+    print("\nstatic unsigned int %s_disp[%u] = {", tbl_name, hash->nbuckets);
+    for (i=0; i < (intmax_t)hash->nbuckets; ++i) {
+	print("%s%u,", (i % 16 == 0) ? "\n  " : " ", hash->disp[i]);
+    }
+    prstr("\n};\n");
+
+    /*
+     * print the hash slots
+     */
+    print("\nstatic struct json_sem_slot %s_slot[%u] = {\n", tbl_name, hash->nslots);
+    prstr("/* depth    type        name_len  name    first  unnamed */\n");
+    for (i=0; i < (intmax_t)hash->nslots; ++i) {
+	slot = &hash->slot[i];
+	print("  { %u,\t%s,\t%zu,", slot->depth, json_type_name(slot->type), slot->name_len);
+	if (slot->name != NULL) {
+	    print("\t\"%s\",", slot->name);
+	} else {
+	    prstr("\tNULL,");
+	}
+	print("\t%d,\t%d },\n", slot->first, slot->unnamed);
+    }
+    prstr("};\n");
+
+    /*
+     * print the hash
+     */
+    print("\nstruct json_sem_hash %s_hash = {\n", tbl_name);
+    print("  %d, %u, %u, %s_disp, %s_slot, false\n", hash->len, hash->nbuckets, hash->nslots, tbl_name, tbl_name);
+    prstr("};\n");
+
+    /*
+     * free storage
+     */
+    json_sem_hash_free(hash);
+    hash = NULL;
+    for (i=0; i < len; ++i) {
+	if (sem[i].name != NULL) {
+	    free((void *)sem[i].name);
+	    sem[i].name = NULL;
+	}
+    }
+    free(sem);
+    sem = NULL;
     return;
 }
 
@@ -1458,8 +1583,9 @@ print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name)
     dyn_array_free(unique_tbl);
 
     /*
-     * print semantic table trailer
+     * print semantic table hash and trailer
      */
+    print("\nextern struct json_sem_hash %s_hash;\n", tbl_name);
     print("\n#endif /* %s_LEN */\n", cap_tbl_name);
 
     return;
@@ -103,7 +103,7 @@
 /*
  * official jsemtblgen version
  */
-#define JSEMTBLGEN_VERSION "2.0.4 2026-06-13"		/* format: major.minor YYYY-MM-DD */
+#define JSEMTBLGEN_VERSION "2.0.5 2026-10-18"		/* format: major.minor YYYY-MM-DD */
 
 /*
  * jsemtblgen tool basename
@@ -118,6 +118,7 @@ static void gen_sem_tbl(struct json *tree, unsigned int max_depth, ...);
 static void vupdate_tbl(struct json *node, unsigned int depth, va_list ap);
 static int sem_cmp(void const *a, void const *b);
 static void print_sem_c_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
+static void print_sem_hash_src(struct dyn_array *tbl, char *tbl_name);
 static void print_sem_h_src(struct dyn_array *tbl, char *tbl_name, char *cap_tbl_name);
 
 
@@ -0,0 +1,470 @@
+/*
+ * json_arena - JSON parse tree arena allocator
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * json_arena - JSON parse tree arena allocator
+ */
+#include "json_arena.h"
+
+/*
+ * json_util - general JSON parser utility support functions
+ */
+#include "json_util.h"
+
+
+/*
+ * static variables
+ *
+ * NOTE: the arena in use is per thread: json_arena_use() in one thread does
+ *	 not change where JSON parse tree nodes of other threads are allocated.
+ */
+static _Thread_local struct json_arena *cur_arena = NULL;	/* arena for new JSON parse tree nodes, NULL ==> use calloc(3) */
+
+
+/*
+ * static functions
+ */
+static struct json_arena_block *json_arena_new_block(struct json_arena *arena, size_t size);
+
+
+/*
+ * json_arena_create - create a JSON parse tree arena
+ *
+ * given:
+ *	block_size	size of the first arena block, 0 ==> JSON_ARENA_BLOCK_SIZE
+ *
+ * returns:
+ *	allocated and initialized JSON arena
+ *
+ * NOTE: No blocks are allocated until the first json_arena_alloc() call.
+ *
+ * NOTE: This function will not return on error.
+ */
+struct json_arena *
+json_arena_create(size_t block_size)
+{
+    struct json_arena *arena = NULL;	/* allocated arena to return */
+
+    /*
+     * use the default block size if none given
+     */
+    if (block_size == 0) {
+	block_size = JSON_ARENA_BLOCK_SIZE;
+    }
+
+    /*
+     * allocate the arena
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    arena = calloc(1, sizeof(*arena));
+    if (arena == NULL) {
+	errp(10, __func__, "calloc error allocating %zu bytes", sizeof(*arena));
+	not_reached();
+    }
+
+    /*
+     * initialize the arena
+     */
+    arena->head = NULL;
+    arena->block_size = block_size;
+    arena->first_block_size = block_size;
+    arena->blocks = 0;
+    arena->allocs = 0;
+    arena->used = 0;
+    arena->reserved = 0;
+    arena->arrays = dyn_array_create(sizeof(struct dyn_array *), JSON_ARENA_ARRAYS_CHUNK, JSON_ARENA_ARRAYS_CHUNK, true);
+    if (arena->arrays == NULL) {
+	err(11, __func__, "dyn_array_create() returned NULL");
+	not_reached();
+    }
+    json_dbg(JSON_DBG_HIGH, __func__, "created JSON arena with block size: %zu", block_size);
+    return arena;
+}
+
+
+/*
+ * json_arena_new_block - add a new block to an arena
+ *
+ * The new block is at least size bytes and at least arena->block_size
+ * bytes long.  The arena->block_size doubles for the next block, up to
+ * JSON_ARENA_MAX_BLOCK_SIZE.
+ *
+ * given:
+ *	arena	    JSON arena
+ *	size	    minimum number of bytes needed
+ *
+ * returns:
+ *	new block, which is now the arena head block
+ *
+ * NOTE: This function will not return on error.
+ */
+static struct json_arena_block *
+json_arena_new_block(struct json_arena *arena, size_t size)
+{
+    struct json_arena_block *block = NULL;	/* new block */
+    size_t block_size = 0;			/* size of data[] in the new block */
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	err(12, __func__, "arena is NULL");
+	not_reached();
+    }
+
+    /*
+     * determine the block size
+     */
+    block_size = arena->block_size;
+    if (block_size < size) {
+	block_size = size;
+    }
+    if (arena->block_size < JSON_ARENA_MAX_BLOCK_SIZE) {
+	arena->block_size *= 2;
+    }
+
+    /*
+     * allocate the block
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    block = malloc(sizeof(*block) + block_size);
+    if (block == NULL) {
+	errp(13, __func__, "malloc error allocating %zu bytes", sizeof(*block) + block_size);
+	not_reached();
+    }
+    block->size = block_size;
+    block->used = 0;
+
+    /*
+     * link the block as the arena head
+     */
+    block->next = arena->head;
+    arena->head = block;
+    ++arena->blocks;
+    arena->reserved += block_size;
+    return block;
+}
+
+
+/*
+ * json_arena_alloc - allocate zeroized storage from an arena
+ *
+ * given:
+ *	arena	    JSON arena, NULL ==> use calloc(3)
+ *	size	    number of bytes to allocate
+ *
+ * returns:
+ *	pointer to size zeroized bytes, suitably aligned for any object
+ *
+ * NOTE: Storage allocated from an arena must NOT be passed to free(3).
+ *	 It is freed by json_arena_reset() or json_arena_free().
+ *
+ * NOTE: This function will not return on error.
+ * NOTE: This function will not return NULL.
+ */
+void *
+json_arena_alloc(struct json_arena *arena, size_t size)
+{
+    struct json_arena_block *block = NULL;	/* block to allocate from */
+    void *ret = NULL;				/* allocated storage to return */
+
+    /*
+     * case: no arena, use calloc
+     */
+    if (arena == NULL) {
+	errno = 0;			/* pre-clear errno for errp() */
+	ret = calloc(1, size);
+	if (ret == NULL) {
+	    errp(14, __func__, "calloc error allocating %zu bytes", size);
+	    not_reached();
+	}
+	return ret;
+    }
+
+    /*
+     * round up the size to keep the next allocation aligned
+     */
+    if (size == 0) {
+	size = 1;
+    }
+    size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+
+    /*
+     * add a block if the head block is too full
+     */
+    block = arena->head;
+    if (block == NULL || block->size - block->used < size) {
+	block = json_arena_new_block(arena, size);
+    }
+
+    /*
+     * allocate from the head block
+     */
+    ret = (char *)block->data + block->used;
+    block->used += size;
+    ++arena->allocs;
+    arena->used += size;
+    memset(ret, 0, size);
+    return ret;
+}
+
+
+/*
+ * json_arena_strndup - copy bytes into a NUL terminated arena string
+ *
+ * given:
+ *	arena	    JSON arena, NULL ==> use calloc(3)
+ *	ptr	    bytes to copy
+ *	len	    number of bytes to copy
+ *
+ * returns:
+ *	allocated copy of the len bytes of ptr, followed by two NUL bytes
+ *
+ * NOTE: Like the strings of JSON parse tree nodes formed without an arena,
+ *	 the copy is followed by 2 NUL bytes.
+ *
+ * NOTE: This function will not return on error.
+ * NOTE: This function will not return NULL.
+ */
+char *
+json_arena_strndup(struct json_arena *arena, char const *ptr, size_t len)
+{
+    char *ret = NULL;		/* allocated string to return */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	err(15, __func__, "ptr is NULL");
+	not_reached();
+    }
+
+    /*
+     * allocate and copy
+     */
+    ret = json_arena_alloc(arena, len+1+1);
+    memcpy(ret, ptr, len);
+    ret[len] = '\0';	/* paranoia */
+    ret[len+1] = '\0';	/* paranoia */
+    return ret;
+}
+
+
+/*
+ * json_arena_own_array - have an arena free a dynamic array when it is reset
+ *
+ * given:
+ *	arena	    JSON arena
+ *	array	    dynamic array to free in json_arena_reset()
+ *
+ * NOTE: This function does nothing if arena or array is NULL.
+ */
+void
+json_arena_own_array(struct json_arena *arena, struct dyn_array *array)
+{
+    /*
+     * firewall
+     */
+    if (arena == NULL || array == NULL) {
+	return;
+    }
+
+    /*
+     * note the dynamic array
+     */
+    (void) dyn_array_append_value(arena->arrays, &array);
+    return;
+}
+
+
+/*
+ * json_arena_reset - free everything allocated from an arena
+ *
+ * All JSON parse trees formed while the arena was in use are freed, and
+ * any pointer to them becomes invalid.  The first block of the arena is
+ * kept so that the arena may be used again without calling malloc(3).
+ *
+ * given:
+ *	arena	    JSON arena
+ *
+ * NOTE: This function does nothing if arena is NULL.
+ */
+void
+json_arena_reset(struct json_arena *arena)
+{
+    struct json_arena_block *block = NULL;	/* block being freed */
+    struct json_arena_block *next = NULL;	/* next block to free */
+    struct dyn_array *array = NULL;		/* arena owned dynamic array */
+    intmax_t len = 0;				/* number of arena owned dynamic arrays */
+    intmax_t i;
+
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	return;
+    }
+
+    /*
+     * free the dynamic arrays owned by the arena
+     */
+    len = dyn_array_tell(arena->arrays);
+    for (i=0; i < len; ++i) {
+	array = dyn_array_value(arena->arrays, struct dyn_array *, i);
+	if (array != NULL) {
+	    dyn_array_free(array);
+	}
+    }
+    dyn_array_clear(arena->arrays);
+
+    /*
+     * free all but the first block
+     */
+    for (block = arena->head; block != NULL && block->next != NULL; block = next) {
+	next = block->next;
+	arena->reserved -= block->size;
+	--arena->blocks;
+	free(block);
+    }
+    arena->head = block;
+    if (block != NULL) {
+	block->used = 0;
+    }
+
+    /*
+     * restart the block size growth
+     */
+    arena->block_size = arena->first_block_size;
+    if (block != NULL && arena->block_size < JSON_ARENA_MAX_BLOCK_SIZE) {
+	arena->block_size *= 2;
+    }
+    arena->allocs = 0;
+    arena->used = 0;
+    return;
+}
+
+
+/*
+ * json_arena_free - free an arena and everything allocated from it
+ *
+ * given:
+ *	arena	    JSON arena
+ *
+ * NOTE: If arena is in use (see json_arena_use()) then the use of an
+ *	 arena is stopped.
+ *
+ * NOTE: This function does nothing if arena is NULL.
+ */
+void
+json_arena_free(struct json_arena *arena)
+{
+    /*
+     * firewall
+     */
+    if (arena == NULL) {
+	return;
+    }
+
+    /*
+     * stop using the arena
+     */
+    if (cur_arena == arena) {
+	cur_arena = NULL;
+    }
+
+    /*
+     * free the arena contents, then the remaining block
+     */
+    json_arena_reset(arena);
+    if (arena->head != NULL) {
+	free(arena->head);
+	arena->head = NULL;
+    }
+    if (arena->arrays != NULL) {
+	dyn_array_free(arena->arrays);
+	arena->arrays = NULL;
+    }
+    free(arena);
+    return;
+}
+
+
+/*
+ * json_arena_use - select the arena for new JSON parse tree nodes
+ *
+ * While an arena is in use, parse_json(), parse_json_stream() and the
+ * other functions that form JSON parse tree nodes allocate them (and their
+ * strings) from the arena.
+ *
+ * given:
+ *	arena	    JSON arena to use, NULL ==> stop using an arena
+ *
+ * returns:
+ *	the arena previously in use, or NULL
+ *
+ * NOTE: this only selects the arena for the calling thread.  An arena
+ *	 itself is not locked, so it must not be used by two threads at once.
+ */
+struct json_arena *
+json_arena_use(struct json_arena *arena)
+{
+    struct json_arena *prev = cur_arena;	/* arena previously in use */
+
+    cur_arena = arena;
+    return prev;
+}
+
+
+/*
+ * json_arena_current - return the arena in use for new JSON parse tree nodes
+ *
+ * returns:
+ *	the arena in use, or NULL ==> JSON parse tree nodes are allocated by calloc(3)
+ */
+struct json_arena *
+json_arena_current(void)
+{
+    return cur_arena;
+}
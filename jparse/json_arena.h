@@ -0,0 +1,142 @@
+/*
+ * json_arena - JSON parse tree arena allocator
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_ARENA_H)
+#    define  INCLUDE_JSON_ARENA_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#if defined(INTERNAL_INCLUDE)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#elif defined(INTERNAL_INCLUDE_2)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#else
+  #include <c_bool.h>
+  #include <c_compat.h>
+  #include <dbg.h>
+#endif
+
+/*
+ * dyn_array - dynamic array facility
+ */
+#if defined(INTERNAL_INCLUDE)
+  #include "../dyn_array/dyn_array.h"
+#elif defined(INTERNAL_INCLUDE_2)
+#include "../dyn_array/dyn_array.h"
+#else
+  #include <dyn_array.h>
+#endif
+
+
+/*
+ * definitions
+ */
+#define JSON_ARENA_BLOCK_SIZE (64*1024)		/* default size of the first arena block */
+#define JSON_ARENA_MAX_BLOCK_SIZE (16*1024*1024)	/* arena blocks do not grow beyond this size */
+#define JSON_ARENA_ARRAYS_CHUNK (64)		/* dyn_array allocation chunk for arena owned dynamic arrays */
+
+
+/*
+ * struct json_arena_block - a block of memory from which arena allocations are made
+ *
+ * The data[] array holds the allocations.  It is declared as max_align_t so that
+ * data[] starts suitably aligned for any object.
+ */
+struct json_arena_block
+{
+    struct json_arena_block *next;	/* previously allocated block, NULL ==> first block */
+    size_t size;			/* size in bytes of data[] */
+    size_t used;			/* bytes of data[] handed out */
+    max_align_t data[];			/* arena allocations */
+};
+
+
+/*
+ * struct json_arena - a JSON parse tree arena
+ *
+ * When a JSON arena is in use (see json_arena_use()), the nodes and strings
+ * of the JSON parse trees formed are allocated from large blocks owned by the
+ * arena instead of individually by calloc(3).  Such parse trees are freed all
+ * at once by json_arena_reset() or json_arena_free(), instead of walking the
+ * parse tree with json_tree_free().
+ *
+ * The dynamic arrays of JSON objects, arrays and elements are not allocated
+ * from the arena blocks because they grow as the parse tree is formed.
+ * Instead the arena keeps track of them and frees them when it is reset.
+ */
+struct json_arena
+{
+    struct json_arena_block *head;	/* most recently allocated block, NULL ==> no blocks */
+    size_t block_size;			/* size of the next block to allocate */
+    size_t first_block_size;		/* size of the first block (restored on reset) */
+
+    uintmax_t blocks;			/* number of blocks currently owned by the arena */
+    uintmax_t allocs;			/* number of allocations since the last reset */
+    uintmax_t used;			/* bytes handed out since the last reset */
+    uintmax_t reserved;			/* bytes in blocks owned by the arena */
+
+    struct dyn_array *arrays;		/* dynamic arrays (struct dyn_array *) to free on reset */
+};
+
+
+/*
+ * external function declarations
+ */
+extern struct json_arena *json_arena_create(size_t block_size);
+extern void *json_arena_alloc(struct json_arena *arena, size_t size);
+extern char *json_arena_strndup(struct json_arena *arena, char const *ptr, size_t len);
+extern void json_arena_own_array(struct json_arena *arena, struct dyn_array *array);
+extern void json_arena_reset(struct json_arena *arena);
+extern void json_arena_free(struct json_arena *arena);
+extern struct json_arena *json_arena_use(struct json_arena *arena);
+extern struct json_arena *json_arena_current(void);
+
+
+#endif /* INCLUDE_JSON_ARENA_H */
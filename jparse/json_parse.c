@@ -69,14 +69,34 @@
 #include "json_util.h"
 
 /* for json string decoding */
-static char *decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen);
+static char *decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen, struct json_arena *arena);
+static char *json_decode_arena(char const *ptr, size_t len, bool quote, size_t *retlen, struct json_arena *arena);
 /* for json number strings */
 static bool json_process_decimal(struct json_number *item, char const *str, size_t len);
 static bool json_process_floating(struct json_number *item, char const *str, size_t len);
+static void json_number_process(struct json_number *item);
 /* for convert JSON encoded string to C string */
+static bool json_string_plain(char const *ptr, size_t len);
 static void posix_safe_chk(char const *str, size_t len, bool *slash, bool *posix_safe, bool *first_alphanum, bool *upper);
 
 
+/*
+ * global variables
+ */
+bool json_number_eager = false;	/* true ==> convert JSON numbers when parsed, false ==> on first access */
+
+
+/*
+ * static variables
+ *
+ * NOTE: these are per thread so that different threads may parse different
+ *	 JSON documents at the same time (see jparse -j).
+ */
+static _Thread_local char *input_start = NULL;	/* JSON input that JSON strings may point into, or NULL */
+static _Thread_local char *input_beyond = NULL;	/* beyond the end of the JSON input */
+static _Thread_local struct json_string_stats string_stats;	/* JSON string allocations saved since json_input_begin() */
+
+
 /*
  * byte2asciistr - a trivial way to map an 8-bit byte into string of ASCII characters
  *
@@ -1333,15 +1353,16 @@ chkbyte2asciistr(void)
  *	len	    length of block
  *	mlen	    length of decoded bytes to allocate
  *	retlen	    address of where to store allocated length, if retlen != NULL
+ *	arena	    JSON arena to allocate from, NULL ==> use calloc(3)
  *
  * returns:
  *	allocated JSON decoding of a block, or NULL ==> error
  *	NOTE: retlen, if non-NULL, is set to 0 on error
  *
- * NOTE: this function is used by json_decode().
+ * NOTE: this function is used by json_decode_arena().
  */
 static char *
-decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
+decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen, struct json_arena *arena)
 {
     char *ret = NULL;	    /* allocated encoding string or NULL */
     char *beyond = NULL;    /* beyond the end of the allocated encoding string */
@@ -1355,6 +1376,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
     int32_t surrogate = 0;
     char *utf8 = NULL;
     int scanned = 0;
+    size_t run = 0;	    /* bytes that decode to themselves */
 
     /*
      * firewall
@@ -1371,7 +1393,11 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
     /*
      * allocated decoded string
      */
-    ret = calloc(mlen + 1 + 1, sizeof(*ret));
+    if (arena != NULL) {
+	ret = json_arena_alloc(arena, mlen + 1 + 1);
+    } else {
+	ret = calloc(mlen + 1 + 1, sizeof(*ret));
+    }
     if (ret == NULL) {
 	/* error - clear allocated length */
 	if (retlen != NULL) {
@@ -1401,7 +1427,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 	    if (retlen != NULL) {
 		*retlen = 0;
 	    }
-	    if (ret != NULL) {
+	    if (ret != NULL && arena == NULL) {
 		free(ret);
 		ret = NULL;
 	    }
@@ -1410,6 +1436,35 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 	    return NULL;
 	}
 
+	/*
+	 * copy the run of bytes that decode to themselves
+	 */
+	run = json_scan_special(ptr + i, len - i);
+	if (run > 0) {
+	    /* paranoia */
+	    if (run > (size_t)(beyond - p)) {
+		/* error - clear allocated length and buffer */
+		if (retlen != NULL) {
+		    *retlen = 0;
+		}
+		if (ret != NULL && arena == NULL) {
+		    free(ret);
+		    ret = NULL;
+		}
+
+		warn(__func__, "run of %zu bytes goes beyond end of decoded string", run);
+		return NULL;
+	    }
+	    memcpy(p, ptr + i, run);
+	    p += run;
+	    /*
+	     * run - 1 because the for() loop increments i and utf8 by 1
+	     */
+	    i += run - 1;
+	    utf8 += run - 1;
+	    continue;
+	}
+
 	/*
 	 * examine the current character
 	 */
@@ -1487,7 +1542,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 		    if (retlen != NULL) {
 			*retlen = 0;
 		    }
-		    if (ret != NULL) {
+		    if (ret != NULL && arena == NULL) {
 			free(ret);
 			ret = NULL;
 		    }
@@ -1508,7 +1563,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 		    if (retlen != NULL) {
 			*retlen = 0;
 		    }
-		    if (ret != NULL) {
+		    if (ret != NULL && arena == NULL) {
 			free(ret);
 			ret = NULL;
 		    }
@@ -1527,7 +1582,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 			if (retlen != NULL) {
 			    *retlen = 0;
 			}
-			if (ret != NULL) {
+			if (ret != NULL && arena == NULL) {
 			    free(ret);
 			    ret = NULL;
 			}
@@ -1558,7 +1613,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 			if (retlen != NULL) {
 			    *retlen = 0;
 			}
-			if (ret != NULL) {
+			if (ret != NULL && arena == NULL) {
 			    free(ret);
 			    ret = NULL;
 			}
@@ -1573,7 +1628,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 			if (retlen != NULL) {
 			    *retlen = 0;
 			}
-			if (ret != NULL) {
+			if (ret != NULL && arena == NULL) {
 			    free(ret);
 			    ret = NULL;
 			}
@@ -1601,7 +1656,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 		    if (retlen != NULL) {
 			*retlen = 0;
 		    }
-		    if (ret != NULL) {
+		    if (ret != NULL && arena == NULL) {
 			free(ret);
 			ret = NULL;
 		    }
@@ -1618,7 +1673,7 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
 		if (retlen != NULL) {
 		    *retlen = 0;
 		}
-		if (ret != NULL) {
+		if (ret != NULL && arena == NULL) {
 		    free(ret);
 		    ret = NULL;
 		}
@@ -1668,6 +1723,30 @@ decode_json_string(char const *ptr, size_t len, size_t mlen, size_t *retlen)
  */
 char *
 json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
+{
+    return json_decode_arena(ptr, len, quote, retlen, NULL);
+}
+
+
+/*
+ * json_decode_arena - return the decoding of a JSON encoded block of memory
+ *
+ * This function is json_decode() with the decoded string allocated
+ * from a JSON arena.
+ *
+ * given:
+ *	ptr	    start of memory block to decode
+ *	len	    length of block to decode in bytes
+ *	quote       true ==> require surrounding double quotes ("s)
+ *	retlen	    address of where to store allocated length, if retlen != NULL
+ *	arena	    JSON arena to allocate from, NULL ==> use calloc(3)
+ *
+ * returns:
+ *	allocated JSON decoding of a block, or NULL ==> error
+ *	NOTE: retlen, if non-NULL, is set to 0 on error
+ */
+static char *
+json_decode_arena(char const *ptr, size_t len, bool quote, size_t *retlen, struct json_arena *arena)
 {
     char *ret = NULL;	    /* allocated encoding string or NULL */
     size_t mlen = 0;	    /* length of allocated encoded string */
@@ -1679,6 +1758,7 @@ json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
     int scanned = 0;	    /* for sscanf() */
     size_t i;
     size_t bytes = 0;	    /* for utf8len() */
+    size_t run = 0;	    /* bytes that decode to themselves */
 
     /*
      * firewall
@@ -1720,6 +1800,16 @@ json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
      */
     for (i=0; i < len; ++i) {
 
+	/*
+	 * count the run of bytes that decode to themselves
+	 */
+	run = json_scan_special(ptr + i, len - i);
+	mlen += run;
+	i += run;
+	if (i >= len) {
+	    break;
+	}
+
 	/*
 	 * examine the current character
 	 */
@@ -1827,7 +1917,7 @@ json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
 		} else if (scanned == 1 || (scanned == 2 && surrogate_pair_to_codepoint((int32_t)xa, (int32_t)xb) < 0)) {
 		    surrogate = xa;
 		    bytes = utf8len(ptr + i, surrogate);
-		    if (bytes <= 0) {
+		    if (bytes == 0 || bytes == (size_t)-1) { /* utf8len() returns (size_t)-1 on error */
 			if (retlen != NULL) {
 			    *retlen = 0;
 			}
@@ -1857,7 +1947,7 @@ json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
 		     * try counting the bytes needed.
 		     */
 		    bytes = utf8len(NULL, surrogate);
-		    if (bytes <= 0) {
+		    if (bytes == 0 || bytes == (size_t)-1) { /* utf8len() returns (size_t)-1 on error */
 			if (retlen != NULL) {
 			    *retlen = 0;
 			}
@@ -1900,7 +1990,7 @@ json_decode(char const *ptr, size_t len, bool quote, size_t *retlen)
    /*
      * decode JSON string
      */
-    ret = decode_json_string(ptr, (uintmax_t)len, (uintmax_t)mlen, retlen);
+    ret = decode_json_string(ptr, (uintmax_t)len, (uintmax_t)mlen, retlen, arena);
 
     /*
      * return result, if not NULL
@@ -2002,13 +2092,16 @@ json_decode_str(char const *str, bool quote, size_t *retlen)
  *	string	    - the text that triggered the action
  *	len	    - length of the string to convert (important for NUL bytes)
  *
- * Returns a pointer to a struct json with the converted string.
+ * Returns a pointer to a struct json with the converted string, or with a
+ * JSON string that was not converted if the string cannot be decoded (say
+ * because of an invalid \-escape): the parser then reports the JSON as
+ * invalid.
  *
  * NOTE: The len is important for strings that have NUL bytes: without it we
  * would rely on strlen() which would mean that the first NUL byte would be the
  * end of the string. If len <= 0 this function uses strlen() on the string.
  *
- * NOTE: This function does not return if passed a NULL string or if conversion fails.
+ * NOTE: This function does not return if passed a NULL string.
  */
 struct json *
 json_parse_string(char const *string, size_t len)
@@ -2035,7 +2128,7 @@ json_parse_string(char const *string, size_t len)
     str = json_conv_string(string, len, true);
     /* paranoia - these tests should never result in an error */
     if (str == NULL) {
-        err(221, __func__, "converting JSON string returned NULL: <%s>", string);
+        err(221, __func__, "converting JSON string returned NULL: <%.*s>", (int)len, string);
         not_reached();
     } else if (str->type != JTYPE_STRING) {
         err(222, __func__, "expected JTYPE_STRING, found type: %s", json_item_type_name(str));
@@ -2043,8 +2136,7 @@ json_parse_string(char const *string, size_t len)
     }
     item = &(str->item.string);
     if (!VALID_JSON_NODE(item)) {
-	err(223, __func__, "couldn't parse string: <%s>", string);
-	not_reached();
+	json_dbg(JSON_DBG_MED, __func__, "couldn't parse string: <%.*s>", (int)len, string);
     }
     return str;
 }
@@ -2200,7 +2292,7 @@ struct json *
 json_parse_number(char const *string)
 {
     struct json *number = NULL;
-    struct json_number *item = NULL;
+    struct json_num *item = NULL;
 
     /*
      * firewall
@@ -2346,6 +2438,9 @@ json_parse_member(struct json *name, struct json *value)
  * returns:
  *	pointer to an initialized the JSON parse tree item
  *
+ * NOTE: When a JSON arena is in use (see json_arena_use()), the item is
+ *	 allocated from that arena and must not be freed by free(3).
+ *
  * NOTE: This function will not return on calloc error.
  * NOTE: This function will not return NULL.
  */
@@ -2353,6 +2448,7 @@ struct json *
 json_alloc(enum item_type type)
 {
     struct json *ret = NULL;		    /* JSON parser tree node to return */
+    struct json_arena *arena = NULL;	    /* JSON arena in use or NULL */
 
     /*
      * inspect the struct json type for unknown types
@@ -2375,12 +2471,19 @@ json_alloc(enum item_type type)
 
     /*
      * allocate the JSON parse tree item
+     *
+     * When a JSON arena is in use, the item comes from the arena.
      */
-    errno = 0;			/* pre-clear errno for errp() */
-    ret = calloc(1, sizeof(*ret));
-    if (ret == NULL) {
-	errp(11, __func__, "calloc #0 error allocating %zu bytes", sizeof(*ret));
-	not_reached();
+    arena = json_arena_current();
+    if (arena != NULL) {
+	ret = json_arena_alloc(arena, sizeof(*ret));
+    } else {
+	errno = 0;			/* pre-clear errno for errp() */
+	ret = calloc(1, sizeof(*ret));
+	if (ret == NULL) {
+	    errp(11, __func__, "calloc #0 error allocating %zu bytes", sizeof(*ret));
+	    not_reached();
+	}
     }
 
     /*
@@ -2388,6 +2491,9 @@ json_alloc(enum item_type type)
      */
     ret->type = type;
     ret->parent = NULL;
+    ret->arena = arena;
+    ret->input = NULL;
+    ret->input_mapped = 0;
 
     /*
      * paranoia - explicitly elements in the "struct json_foo" structure
@@ -2422,11 +2528,13 @@ json_alloc(enum item_type type)
 	break;
     case JTYPE_NUMBER:
 	{
-	    struct json_number *item = &(ret->item.number);
+	    struct json_num *item = &(ret->item.number);
 
 	    item->parsed = false;
 	    item->converted = false;
 	    item->as_str = NULL;
+	    item->first = NULL;
+	    item->conv = NULL;
 	};
 	break;
     case JTYPE_STRING:
@@ -2477,6 +2585,7 @@ json_alloc(enum item_type type)
 	    item->converted = false;
 	    item->set = NULL;
 	    item->s = NULL;
+	    item->index = NULL;
 	};
 	break;
     case JTYPE_ARRAY:
@@ -3176,7 +3285,117 @@ json_process_floating(struct json_number *item, char const *str, size_t len)
 
 
 /*
- * json_conv_number - convert JSON number string to C numeric value
+ * json_number_process - convert a JSON number string into C numeric values
+ *
+ * Given a struct json_number with as_str, first, number_len and the
+ * is_floating, is_e_notation and is_integer booleans already set, we
+ * attempt to convert the JSON number string into the various C numeric
+ * values, setting the parsed and converted booleans accordingly.
+ *
+ * given:
+ *	item	pointer to a JSON number structure (struct json_number*)
+ *
+ * NOTE: This function does nothing if item is NULL or item->first is NULL.
+ */
+static void
+json_number_process(struct json_number *item)
+{
+    bool success = false;		    /* true ==> processing was successful */
+
+    /*
+     * firewall
+     */
+    if (item == NULL) {
+	warn(__func__, "called with NULL item");
+	return;
+    }
+    if (item->first == NULL || item->number_len <= 0) {
+	return;
+    }
+
+    /*
+     * case: JSON number is a floating point number
+     */
+    if (item->is_floating) {
+
+	/* process JSON number as floating point number */
+	success = json_process_floating(item, item->first, item->number_len);
+	if (success == false) {
+
+	    /*
+	     * this JSON number is not a true floating point value
+	     */
+	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as floating point number failed: <%s>",
+				   item->as_str);
+
+	} else {
+
+	    /*
+	     * this JSON number is a converted floating point value
+	     */
+	    item->converted = true;
+	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON floating point number: <%s>", item->as_str);
+	}
+	item->parsed = true;	/* floating point number has been parsed, regardless of conversion status */
+    }
+
+    /*
+     * case: JSON number is an e-notation number
+     */
+    if (item->is_e_notation) {
+
+	/* process JSON number as floating point or e-notation number */
+	success = json_process_floating(item, item->first, item->number_len);
+	if (success == false) {
+
+	    /*
+	     * this JSON number is not a true e_notation value
+	     */
+	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as e-notation number failed: <%s>", item->as_str);
+
+	} else {
+
+	    /*
+	     * this JSON number is a converted e_notation value
+	     */
+	    item->converted = true;
+	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON e-notation number: <%s>", item->as_str);
+	}
+	item->parsed = true;	/* e-notation number has been parsed, regardless of conversion status */
+    }
+
+    /*
+     * case: JSON number is a base 10 integer in ASCII
+     */
+    if (item->is_integer) {
+
+	/*
+	 * process JSON number as a base 10 integer in ASCII
+	 */
+	success = json_process_decimal(item, item->first, item->number_len);
+	if (success == false) {
+
+	    /*
+	     * this JSON number is not a true integer value
+	     */
+	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as base 10 integer in ASCII processing failed: <%s>", item->as_str);
+
+	} else {
+
+	    /*
+	     * this JSON number is a converted integer value
+	     */
+	    item->converted = true;
+	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON integer: <%s>", item->as_str);
+	}
+	item->parsed = true;	/* 10 integer has been parsed, regardless of conversion status */
+    }
+    return;
+}
+
+
+/*
+ * json_conv_number - form a JSON number parse tree node from a JSON number string
  *
  * A JSON number string is of the form:
  *
@@ -3194,6 +3413,12 @@ json_process_floating(struct json_number *item, char const *str, size_t len)
  *
  *      [Ee][-+]?[0-9]+
  *
+ * The JSON number string is copied and its form (integer, floating point,
+ * e-notation) is determined.  Unless json_number_eager == true, the JSON
+ * number string is NOT converted into C numeric values here: that is deferred
+ * until json_number_conv() (or one of the json_number_xxx() accessors) is
+ * called on the returned node.
+ *
  * given:
  *	ptr	pointer to buffer containing a JSON number
  *	len	length, starting at ptr, of the JSON number string
@@ -3203,21 +3428,12 @@ json_process_floating(struct json_number *item, char const *str, size_t len)
  *
  * NOTE: This function will not return on calloc error.
  * NOTE: This function will not return NULL.
- * NOTE: although we use the term ASCII, isascii() is not used because it was
- * removed from POSIX. Instead we cast the arg to the ctype.h functions/macros
- * (the is*() ones) to an unsigned char because the standard states that,
- * although the arg is an int, it is undefined if it is not representable as an
- * unsigned char or EOF.
  */
 struct json *
 json_conv_number(char const *ptr, size_t len)
 {
     struct json *ret = NULL;		    /* JSON parser tree node to return */
-    struct json_number *item = NULL;	    /* JSON number item inside JSON parser tree node */
-    bool decimal = false;		    /* true ==> ptr points to a base 10 integer in ASCII */
-    bool e_notation = false;		    /* true ==> ptr points to e notation in ASCII */
-    bool floating_notation = false;	    /* true ==> ptr points to floating point notation in ASCII */
-    bool success = false;		    /* true ==> processing was successful */
+    struct json_num *item = NULL;	    /* JSON number item inside JSON parser tree node */
 
     /*
      * allocate an initialized JSON parse tree item
@@ -3234,42 +3450,14 @@ json_conv_number(char const *ptr, size_t len)
     item = &(ret->item.number);
     item->parsed = false;
     item->converted = false;
-    item->as_str = NULL;
-    item->first = NULL;
-    item->is_negative = false;
     item->is_floating = false;
     item->is_e_notation = false;
-    /* integer values */
     item->is_integer = false;
-    item->int8_sized = false;
-    item->uint8_sized = false;
-    item->int16_sized = false;
-    item->uint16_sized = false;
-    item->int32_sized = false;
-    item->uint32_sized = false;
-    item->int64_sized = false;
-    item->uint64_sized = false;
-    item->int_sized = false;
-    item->uint_sized = false;
-    item->long_sized = false;
-    item->ulong_sized = false;
-    item->longlong_sized = false;
-    item->ulonglong_sized = false;
-    item->ssize_sized = false;
-    item->size_sized = false;
-    item->off_sized = false;
-    item->maxint_sized = false;
-    item->umaxint_sized = false;
-    /* floating point values */
-    item->float_sized = false;
-    item->as_float = 0.0f;
-    item->as_float_int = false;
-    item->double_sized = false;
-    item->as_double = 0.0;
-    item->as_double_int = false;
-    item->longdouble_sized = false;
-    item->as_longdouble = 0.0L;
-    item->as_longdouble_int = false;
+    item->as_str = NULL;
+    item->first = NULL;
+    item->as_str_len = 0;
+    item->number_len = 0;
+    item->conv = NULL;
 
     /*
      * firewall
@@ -3292,7 +3480,11 @@ json_conv_number(char const *ptr, size_t len)
      * duplicate the JSON integer string
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    if (ret->arena != NULL) {
+	item->as_str = json_arena_alloc(ret->arena, len+1+1);
+    } else {
+	item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    }
     if (item->as_str == NULL) {
 	errp(13, __func__, "calloc #1 error allocating %zu bytes", (len+1+1));
 	not_reached();
@@ -3324,158 +3516,920 @@ json_conv_number(char const *ptr, size_t len)
     /*
      * attempt to determine the type of JSON number we have been given
      */
-    floating_notation = is_floating_notation(item->first, item->number_len);
-    item->is_floating = floating_notation;
-    /**/
-    e_notation = is_e_notation(item->first, item->number_len);
-    item->is_e_notation = e_notation;
-    /**/
-    decimal = is_decimal(item->first, item->number_len);
-    item->is_integer = decimal;
+    item->is_floating = is_floating_notation(item->first, item->number_len);
+    item->is_e_notation = is_e_notation(item->first, item->number_len);
+    item->is_integer = is_decimal(item->first, item->number_len);
 
     /*
-     * case: JSON number is a floating point number
+     * a JSON number of a known form has been parsed, regardless of conversion status
      */
-    if (floating_notation) {
-
-	/* process JSON number as floating point number */
-	success = json_process_floating(item, item->first, item->number_len);
-	if (success == false) {
-
-	    /*
-	     * this JSON number is not a true floating point value
-	     */
-	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as floating point number failed: <%s>",
-				   item->as_str);
-
-	} else {
-
-	    /*
-	     * this JSON number is a converted floating point value
-	     */
-	    item->converted = true;
-	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON floating point number of type %s: <%s>",
-				     json_item_type_name(ret), item->as_str);
-	}
-	item->parsed = true;	/* floating point number has been parsed, regardless of conversion status */
+    if (item->is_floating || item->is_e_notation || item->is_integer) {
+	item->parsed = true;
     }
 
     /*
-     * case: JSON number is an e-notation number
+     * convert now if eager conversion was requested
      */
-    if (e_notation) {
-
-	/* process JSON number as floating point or e-notation number */
-	success = json_process_floating(item, item->first, item->number_len);
-	if (success == false) {
-
-	    /*
-	     * this JSON number is not a true e_notation value
-	     */
-	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as e-notation number failed: <%s>", item->as_str);
-
-	} else {
-
-	    /*
-	     * this JSON number is a converted e_notation value
-	     */
-	    item->converted = true;
-	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON e-notation number of type %s: <%s>",
-				     json_item_type_name(ret), item->as_str);
-	}
-	item->parsed = true;	/* e-notation number has been parsed, regardless of conversion status */
+    if (json_number_eager == true) {
+	(void) json_number_conv(ret);
     }
 
     /*
-     * case: JSON number is a base 10 integer in ASCII
+     * return the JSON parse tree item
      */
-    if (decimal) {
-
-	/*
-	 * process JSON number as a base 10 integer in ASCII
-	 */
-	success = json_process_decimal(item, item->first, item->number_len);
-	if (success == false) {
+    return ret;
+}
 
-	    /*
-	     * this JSON number is not a true integer value
-	     */
-	    json_dbg(JSON_DBG_HIGH, __func__, "JSON number as base 10 integer in ASCII processing failed: <%s>", item->as_str);
 
-	} else {
+/*
+ * json_conv_number_str - convert JSON number string to C numeric value
+ *
+ * This is a simplified interface for json_conv_number().  See that function for
+ * details.
+ *
+ * given:
+ *	str	JSON number in the from of a NUL terminated C-style string
+ *	retlen	address of where to store length of str, if retlen != NULL
+ *
+ * returns:
+ *	allocated JSON parser tree node converted JSON integer
+ *
+ * NOTE: retlen, if non-NULL, is set to 0 on error
+ *
+ * NOTE: This function will not return on calloc error.
+ * NOTE: This function will not return NULL.
+ */
+struct json *
+json_conv_number_str(char const *str, size_t *retlen)
+{
+    struct json *ret = NULL;	    /* JSON parser tree node to return */
+    size_t len = 0;		    /* length of string to encode */
+
+    /*
+     * firewall
+     *
+     * NOTE: We will let the json_conv_number() handle the arg firewall
+     */
+    if (str == NULL) {
+	warn(__func__, "called with NULL str");
+    } else {
+	len = strlen(str);
+    }
+
+    /*
+     * convert to json_conv_number() call
+     */
+    ret = json_conv_number(str, len);
+    if (ret == NULL) {
+	err(14, __func__, "json_conv_number() returned NULL");
+	not_reached();
+    }
+
+    /*
+     * save length if allowed
+     */
+    if (retlen != NULL) {
+	*retlen = len;
+    }
+
+    /*
+     * return the JSON parse tree item
+     */
+    return ret;
+}
+
+
+/*
+ * json_number_conv - return the C numeric conversions of a JSON number node
+ *
+ * The first time this function is called on a JTYPE_NUMBER node (unless the
+ * node was formed while json_number_eager == true), the JSON number string
+ * is converted into the various C numeric values of a struct json_number.
+ * The result is kept in the node so later calls just return it.
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *
+ * returns:
+ *	pointer to the struct json_number conversions of the node,
+ *	or NULL ==> node is NULL or node is not a JTYPE_NUMBER
+ *
+ * NOTE: The returned struct json_number may have parsed == false or
+ *	 converted == false: the caller must check before using values.
+ *
+ * NOTE: This function will not return on calloc error.
+ */
+struct json_number *
+json_number_conv(struct json *node)
+{
+    struct json_num *num = NULL;	/* JSON number parse tree node item */
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    /*
+     * firewall
+     */
+    if (node == NULL || node->type != JTYPE_NUMBER) {
+	return NULL;
+    }
+    num = &(node->item.number);
+
+    /*
+     * case: already converted
+     */
+    if (num->conv != NULL) {
+	return num->conv;
+    }
+
+    /*
+     * allocate the conversion structure
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    if (node->arena != NULL) {
+	item = json_arena_alloc(node->arena, sizeof(*item));
+    } else {
+	item = calloc(1, sizeof(*item));
+    }
+    if (item == NULL) {
+	errp(250, __func__, "calloc error allocating %zu bytes", sizeof(*item)); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * initialize the conversion structure from the JSON number node
+     *
+     * NOTE: as_str and first are pointer copies: only num->as_str is freed.
+     */
+    item->parsed = false;
+    item->converted = false;
+    item->as_str = num->as_str;
+    item->first = num->first;
+    item->as_str_len = num->as_str_len;
+    item->number_len = num->number_len;
+    item->is_negative = false;
+    item->is_floating = num->is_floating;
+    item->is_e_notation = num->is_e_notation;
+    item->is_integer = num->is_integer;
+    /* integer values */
+    item->int8_sized = false;
+    item->uint8_sized = false;
+    item->int16_sized = false;
+    item->uint16_sized = false;
+    item->int32_sized = false;
+    item->uint32_sized = false;
+    item->int64_sized = false;
+    item->uint64_sized = false;
+    item->int_sized = false;
+    item->uint_sized = false;
+    item->long_sized = false;
+    item->ulong_sized = false;
+    item->longlong_sized = false;
+    item->ulonglong_sized = false;
+    item->ssize_sized = false;
+    item->size_sized = false;
+    item->off_sized = false;
+    item->maxint_sized = false;
+    item->umaxint_sized = false;
+    /* floating point values */
+    item->float_sized = false;
+    item->as_float = 0.0f;
+    item->as_float_int = false;
+    item->double_sized = false;
+    item->as_double = 0.0;
+    item->as_double_int = false;
+    item->longdouble_sized = false;
+    item->as_longdouble = 0.0L;
+    item->as_longdouble_int = false;
+
+    /*
+     * convert the JSON number string
+     */
+    json_number_process(item);
+
+    /*
+     * record the conversion in the JSON number node
+     */
+    num->conv = item;
+    num->converted = item->converted;
+    json_dbg(JSON_DBG_VVHIGH, __func__, "converted JSON number: <%s>: %s",
+				       strnull(num->as_str), booltostr(num->converted));
+    return item;
+}
+
+
+/*
+ * json_number_int8 - obtain a JSON number as an int8_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the int8_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an int8_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an int8_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_int8(struct json *node, int8_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->int8_sized == false) {
+	return false;
+    }
+    *ret = item->as_int8;
+    return true;
+}
+
+
+/*
+ * json_number_uint8 - obtain a JSON number as an uint8_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the uint8_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an uint8_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an uint8_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_uint8(struct json *node, uint8_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->uint8_sized == false) {
+	return false;
+    }
+    *ret = item->as_uint8;
+    return true;
+}
+
+
+/*
+ * json_number_int16 - obtain a JSON number as an int16_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the int16_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an int16_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an int16_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_int16(struct json *node, int16_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->int16_sized == false) {
+	return false;
+    }
+    *ret = item->as_int16;
+    return true;
+}
+
+
+/*
+ * json_number_uint16 - obtain a JSON number as an uint16_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the uint16_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an uint16_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an uint16_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_uint16(struct json *node, uint16_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->uint16_sized == false) {
+	return false;
+    }
+    *ret = item->as_uint16;
+    return true;
+}
+
+
+/*
+ * json_number_int32 - obtain a JSON number as an int32_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the int32_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an int32_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an int32_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_int32(struct json *node, int32_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->int32_sized == false) {
+	return false;
+    }
+    *ret = item->as_int32;
+    return true;
+}
+
+
+/*
+ * json_number_uint32 - obtain a JSON number as an uint32_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the uint32_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an uint32_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an uint32_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_uint32(struct json *node, uint32_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->uint32_sized == false) {
+	return false;
+    }
+    *ret = item->as_uint32;
+    return true;
+}
+
+
+/*
+ * json_number_int64 - obtain a JSON number as an int64_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the int64_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an int64_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an int64_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_int64(struct json *node, int64_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->int64_sized == false) {
+	return false;
+    }
+    *ret = item->as_int64;
+    return true;
+}
+
+
+/*
+ * json_number_uint64 - obtain a JSON number as an uint64_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the uint64_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an uint64_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an uint64_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_uint64(struct json *node, uint64_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->uint64_sized == false) {
+	return false;
+    }
+    *ret = item->as_uint64;
+    return true;
+}
+
+
+/*
+ * json_number_int - obtain a JSON number as an int
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the int value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an int
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an int
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_int(struct json *node, int *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->int_sized == false) {
+	return false;
+    }
+    *ret = item->as_int;
+    return true;
+}
+
+
+/*
+ * json_number_uint - obtain a JSON number as an unsigned int
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the unsigned int value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an unsigned int
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an unsigned int
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_uint(struct json *node, unsigned int *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->uint_sized == false) {
+	return false;
+    }
+    *ret = item->as_uint;
+    return true;
+}
+
+
+/*
+ * json_number_long - obtain a JSON number as a long
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the long value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a long
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a long
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_long(struct json *node, long *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->long_sized == false) {
+	return false;
+    }
+    *ret = item->as_long;
+    return true;
+}
+
+
+/*
+ * json_number_ulong - obtain a JSON number as an unsigned long
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the unsigned long value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an unsigned long
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an unsigned long
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_ulong(struct json *node, unsigned long *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->ulong_sized == false) {
+	return false;
+    }
+    *ret = item->as_ulong;
+    return true;
+}
+
+
+/*
+ * json_number_longlong - obtain a JSON number as a long long
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the long long value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a long long
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a long long
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_longlong(struct json *node, long long *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->longlong_sized == false) {
+	return false;
+    }
+    *ret = item->as_longlong;
+    return true;
+}
+
+
+/*
+ * json_number_ulonglong - obtain a JSON number as an unsigned long long
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the unsigned long long value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an unsigned long long
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an unsigned long long
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_ulonglong(struct json *node, unsigned long long *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->ulonglong_sized == false) {
+	return false;
+    }
+    *ret = item->as_ulonglong;
+    return true;
+}
+
+
+/*
+ * json_number_ssize - obtain a JSON number as a ssize_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the ssize_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a ssize_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a ssize_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_ssize(struct json *node, ssize_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
 
-	    /*
-	     * this JSON number is a converted integer value
-	     */
-	    item->converted = true;
-	    json_dbg(JSON_DBG_VHIGH, __func__, "converted JSON integer of type %s: <%s>",
-				     json_item_type_name(ret), item->as_str);
-	}
-	item->parsed = true;	/* 10 integer has been parsed, regardless of conversion status */
+    if (ret == NULL) {
+	return false;
     }
+    item = json_number_conv(node);
+    if (item == NULL || item->ssize_sized == false) {
+	return false;
+    }
+    *ret = item->as_ssize;
+    return true;
+}
 
-    /*
-     * return the JSON parse tree item
-     */
-    return ret;
+
+/*
+ * json_number_size - obtain a JSON number as a size_t
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the size_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a size_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a size_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_size(struct json *node, size_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->size_sized == false) {
+	return false;
+    }
+    *ret = item->as_size;
+    return true;
 }
 
 
 /*
- * json_conv_number_str - convert JSON number string to C numeric value
+ * json_number_off - obtain a JSON number as an off_t
  *
- * This is a simplified interface for json_conv_number().  See that function for
- * details.
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the off_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an off_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an off_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_off(struct json *node, off_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->off_sized == false) {
+	return false;
+    }
+    *ret = item->as_off;
+    return true;
+}
+
+
+/*
+ * json_number_maxint - obtain a JSON number as an intmax_t
  *
  * given:
- *	str	JSON number in the from of a NUL terminated C-style string
- *	retlen	address of where to store length of str, if retlen != NULL
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the intmax_t value
  *
  * returns:
- *	allocated JSON parser tree node converted JSON integer
+ *	true ==> *ret set to the JSON number as an intmax_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an intmax_t
  *
- * NOTE: retlen, if non-NULL, is set to 0 on error
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_maxint(struct json *node, intmax_t *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->maxint_sized == false) {
+	return false;
+    }
+    *ret = item->as_maxint;
+    return true;
+}
+
+
+/*
+ * json_number_umaxint - obtain a JSON number as an uintmax_t
  *
- * NOTE: This function will not return on calloc error.
- * NOTE: This function will not return NULL.
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the uintmax_t value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as an uintmax_t
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be an uintmax_t
+ *
+ * NOTE: This function will convert the JSON number string on first use.
  */
-struct json *
-json_conv_number_str(char const *str, size_t *retlen)
+bool
+json_number_umaxint(struct json *node, uintmax_t *ret)
 {
-    struct json *ret = NULL;	    /* JSON parser tree node to return */
-    size_t len = 0;		    /* length of string to encode */
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
 
-    /*
-     * firewall
-     *
-     * NOTE: We will let the json_conv_number() handle the arg firewall
-     */
-    if (str == NULL) {
-	warn(__func__, "called with NULL str");
-    } else {
-	len = strlen(str);
+    if (ret == NULL) {
+	return false;
     }
+    item = json_number_conv(node);
+    if (item == NULL || item->umaxint_sized == false) {
+	return false;
+    }
+    *ret = item->as_umaxint;
+    return true;
+}
+
+
+/*
+ * json_number_float - obtain a JSON number as a float
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the float value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a float
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a float
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_float(struct json *node, float *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
 
-    /*
-     * convert to json_conv_number() call
-     */
-    ret = json_conv_number(str, len);
     if (ret == NULL) {
-	err(14, __func__, "json_conv_number() returned NULL");
-	not_reached();
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->float_sized == false) {
+	return false;
+    }
+    *ret = item->as_float;
+    return true;
+}
+
+
+/*
+ * json_number_double - obtain a JSON number as a double
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the double value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a double
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a double
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_double(struct json *node, double *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->double_sized == false) {
+	return false;
+    }
+    *ret = item->as_double;
+    return true;
+}
+
+
+/*
+ * json_number_longdouble - obtain a JSON number as a long double
+ *
+ * given:
+ *	node	pointer to a JTYPE_NUMBER JSON parse tree node
+ *	ret	address of where to store the long double value
+ *
+ * returns:
+ *	true ==> *ret set to the JSON number as a long double
+ *	false ==> NULL arg, node is not a JTYPE_NUMBER, or JSON number cannot be a long double
+ *
+ * NOTE: This function will convert the JSON number string on first use.
+ */
+bool
+json_number_longdouble(struct json *node, long double *ret)
+{
+    struct json_number *item = NULL;	/* C numeric conversions of the JSON number */
+
+    if (ret == NULL) {
+	return false;
+    }
+    item = json_number_conv(node);
+    if (item == NULL || item->longdouble_sized == false) {
+	return false;
     }
+    *ret = item->as_longdouble;
+    return true;
+}
+
+
+/*
+ * json_string_plain - determine if a JSON encoded string needs no decoding
+ *
+ * A JSON encoded string without a \-escape, and without any of the
+ * characters that json_decode() rejects because they should have been
+ * escaped, decodes to itself.
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *
+ * returns:
+ *	true ==> decoding ptr would return the same bytes
+ *	false ==> ptr needs decoding, or is invalid, or ptr is NULL
+ */
+static bool
+json_string_plain(char const *ptr, size_t len)
+{
+    size_t i;
 
     /*
-     * save length if allowed
+     * firewall
      */
-    if (retlen != NULL) {
-	*retlen = len;
+    if (ptr == NULL) {
+	return false;
     }
 
     /*
-     * return the JSON parse tree item
+     * look for a character that json_decode() would act on
      */
-    return ret;
+    for (i=0; i < len; ++i) {
+
+	/*
+	 * skip over bytes that decode to themselves
+	 */
+	i += json_scan_special(ptr + i, len - i);
+	if (i >= len) {
+	    break;
+	}
+
+	switch (ptr[i]) {
+	case '\\':  /*fallthrough*/
+	case '\b':  /*fallthrough*/
+	case '\t':  /*fallthrough*/
+	case '\n':  /*fallthrough*/
+	case '\f':  /*fallthrough*/
+	case '\r':  /*fallthrough*/
+	case '"':
+	    return false;
+	default:
+	    break;
+	}
+    }
+    return true;
 }
 
 
@@ -3506,6 +4460,7 @@ static void
 posix_safe_chk(char const *str, size_t len, bool *slash, bool *posix_safe, bool *first_alphanum, bool *upper)
 {
     bool found_unsafe = false;		/* true ==> found non-ASCII or non-POSIX portable safe plus +/ */
+    struct json_scan_posix pos;		/* where the bytes of interest were first found */
     size_t i;
 
     /*
@@ -3567,42 +4522,38 @@ posix_safe_chk(char const *str, size_t len, bool *slash, bool *posix_safe, bool
     /*
      * examine second character through the last character
      */
-    for (i=1; i < len; ++i) {
-
-	/*
-	 * test character
-	 */
+    json_scan_posix(str + 1, len - 1, &pos);
 
-	    /*
-	     * case: / check
-	     */
-	    if (str[i] == '/') {
-		if (*slash == false) {
-		    dbg(DBG_VVVHIGH, "posix_safe_chk(): found first / at str[%zu]: 0x%02x",
-				     i, (unsigned int)str[i]);
-		}
-		*slash = true;
+    /*
+     * case: / check
+     */
+    if (pos.slash < len - 1) {
+	i = pos.slash + 1;
+	if (*slash == false) {
+	    dbg(DBG_VVVHIGH, "posix_safe_chk(): found first / at str[%zu]: 0x%02x",
+			     i, (unsigned int)str[i]);
+	}
+	*slash = true;
+    }
 
-	    /*
-	     * case: character is alphanumeric
-	     */
-	    } else if (isalnum((unsigned char)str[i])) {
-		if (*upper == false && isupper((unsigned char)str[i])) {
-		    dbg(DBG_VVVHIGH, "posix_safe_chk(): found first UPPER CASE at str[%zu]: 0x%02x",
-				     i, (unsigned int)str[i]);
-		    *upper = true;
-		}
+    /*
+     * case: character is UPPER CASE alphanumeric
+     */
+    if (pos.upper < len - 1 && *upper == false) {
+	i = pos.upper + 1;
+	dbg(DBG_VVVHIGH, "posix_safe_chk(): found first UPPER CASE at str[%zu]: 0x%02x",
+			 i, (unsigned int)str[i]);
+	*upper = true;
+    }
 
-	    /*
-	     * case: is not POSIX portable safe plus +
-	     */
-	    } else if (str[i] != '.' && str[i] != '_' && str[i] != '+' && str[i] != '-') {
-		if (found_unsafe == false) {
-		    dbg(DBG_VVVHIGH, "posix_safe_chk(): str[%zu] found first non-POSIX portable safe plus +/: 0x%02x",
-				     i, (unsigned int)str[i]);
-		}
-		found_unsafe = true;
-	    }
+    /*
+     * case: is not POSIX portable safe plus +
+     */
+    if (pos.unsafe < len - 1) {
+	i = pos.unsafe + 1;
+	dbg(DBG_VVVHIGH, "posix_safe_chk(): str[%zu] found first non-POSIX portable safe plus +/: 0x%02x",
+			 i, (unsigned int)str[i]);
+	found_unsafe = true;
     }
 
     /*
@@ -3653,6 +4604,7 @@ json_conv_string(char const *ptr, size_t len, bool quote)
 {
     struct json *ret = NULL;		    /* JSON parser tree node to return */
     struct json_string *item = NULL;	    /* JSON string item inside JSON parser tree node */
+    char *borrowed = NULL;		    /* JSON input of a borrowed string that could not be decoded */
 
     /*
      * allocate an initialized JSON parse tree item
@@ -3673,6 +4625,7 @@ json_conv_string(char const *ptr, size_t len, bool quote)
     item->parsed = false;
     item->quote = false;
     item->same = false;
+    item->borrowed = false;
     item->slash = false;
     item->posix_safe = false;
     item->first_alphanum = false;
@@ -3717,28 +4670,95 @@ json_conv_string(char const *ptr, size_t len, bool quote)
 	len -= 2;
     }
 
+    ++string_stats.strings;
+
     /*
-     * duplicate the JSON string
+     * case: the JSON string is within the JSON input that the JSON parse tree
+     *	     will keep: point into the JSON input instead of duplicating it
+     *
+     * The closing '"' is replaced by a NUL byte so that as_str is NUL
+     * terminated.  This is safe because the JSON input is our own copy (see
+     * parse_json()) and the scanner does not look at the text of a token
+     * again once the token has been matched.  Should the string not decode,
+     * the closing '"' is put back (see below) as the diagnostics of the
+     * invalid JSON print the token.
      */
-    errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
-    if (item->as_str == NULL) {
-	errp(17, __func__, "calloc #1 error allocating %zu bytes", (len+1+1));
-	not_reached();
+    if (item->quote == true && input_start != NULL &&
+	ptr-1 >= input_start && ptr+len+1 <= input_beyond) {
+	item->as_str = (char *)ptr;
+	item->as_str[len] = '\0';	/* was the closing '"' */
+	item->borrowed = true;
+	++string_stats.borrowed;
+	++string_stats.allocs_saved;
+	string_stats.bytes_saved += len+1+1;
+
+    /*
+     * case: duplicate the JSON string
+     */
+    } else {
+	errno = 0;			/* pre-clear errno for errp() */
+	if (ret->arena != NULL) {
+	    item->as_str = json_arena_alloc(ret->arena, len+1+1);
+	} else {
+	    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+	}
+	if (item->as_str == NULL) {
+	    errp(17, __func__, "calloc #1 error allocating %zu bytes", (len+1+1));
+	    not_reached();
+	}
+	strncpy(item->as_str, ptr, len);
+	item->as_str[len] = '\0';	/* paranoia */
+	item->as_str[len+1] = '\0';	/* paranoia */
     }
-    strncpy(item->as_str, ptr, len);
-    item->as_str[len] = '\0';	/* paranoia */
-    item->as_str[len+1] = '\0';	/* paranoia */
 
     /*
-     * decode the JSON encoded string
+     * case: no JSON decoding is required - the decoded string is as_str
      */
-    /* decode the entire string */
-    item->str = json_decode(item->as_str, len, quote, &(item->str_len));
-    if (item->str == NULL) {
-	warn(__func__, "quote === %s: JSON string decode failed for: <%s>",
-		       booltostr(quote), item->as_str);
-	return ret;
+    if (json_string_plain(item->as_str, len)) {
+	item->str = item->as_str;
+	item->str_len = len;
+	++string_stats.shared;
+	++string_stats.allocs_saved;
+	string_stats.bytes_saved += len+1+1;
+
+    /*
+     * case: decode the JSON encoded string
+     */
+    } else {
+	/* decode the entire string */
+	item->str = json_decode_arena(item->as_str, len, quote, &(item->str_len), ret->arena);
+	if (item->str == NULL) {
+	    warn(__func__, "quote === %s: JSON string decode failed for: <%s>",
+			   booltostr(quote), item->as_str);
+
+	    /*
+	     * give a borrowed string its own copy, and the JSON input back its
+	     * closing '"', so that the diagnostics of the invalid JSON show the
+	     * whole token
+	     */
+	    if (item->borrowed == true) {
+		borrowed = item->as_str;
+		errno = 0;			/* pre-clear errno for errp() */
+		if (ret->arena != NULL) {
+		    item->as_str = json_arena_alloc(ret->arena, len+1+1);
+		} else {
+		    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+		}
+		if (item->as_str == NULL) {
+		    errp(251, __func__, "calloc #2 error allocating %zu bytes", (len+1+1)); /*ooo*/
+		    not_reached();
+		}
+		memcpy(item->as_str, borrowed, len);
+		item->as_str[len] = '\0';	/* paranoia */
+		item->as_str[len+1] = '\0';	/* paranoia */
+		borrowed[len] = '"';		/* was replaced by a NUL byte above */
+		item->borrowed = false;
+		--string_stats.borrowed;
+		--string_stats.allocs_saved;
+		string_stats.bytes_saved -= len+1+1;
+	    }
+	    return ret;
+	}
     }
     item->parsed = true;	/* JSON parsed successful */
     item->converted = true;	/* JSON decoding successful */
@@ -3826,6 +4846,59 @@ json_conv_string_str(char const *str, size_t *retlen, bool quote)
 }
 
 
+/*
+ * json_input_begin - note the JSON input that JSON strings may point into
+ *
+ * While the parser scans a JSON input buffer that the JSON parse tree will
+ * keep, json_conv_string() points the as_str of a JSON string that lies
+ * within the buffer into it, instead of duplicating it.  This also resets
+ * the JSON string allocation counters.
+ *
+ * given:
+ *	input	JSON input buffer that the JSON parse tree will keep, or NULL
+ *	len	length of input in bytes
+ *
+ * NOTE: the closing '"' of each such JSON string in input is replaced by a
+ *	 NUL byte, so input must be writable and must not be used for anything
+ *	 else once the JSON parse tree is formed.
+ *
+ * NOTE: parse_json() calls this function: there is no need to call it
+ *	 directly unless using the scanner and parser in some other way.
+ */
+void
+json_input_begin(char *input, size_t len)
+{
+    input_start = input;
+    input_beyond = input != NULL ? input + len : NULL;
+    memset(&string_stats, 0, sizeof(string_stats));
+    return;
+}
+
+
+/*
+ * json_input_end - stop JSON strings from pointing into the JSON input
+ *
+ * given:
+ *	stats	if non-NULL, set to the JSON string allocations saved since
+ *		json_input_begin() was called
+ *
+ * returns:
+ *	true ==> one or more JSON strings point into the JSON input and so
+ *		 the input must be kept as long as the JSON parse tree is
+ *	false ==> no JSON string points into the JSON input
+ */
+bool
+json_input_end(struct json_string_stats *stats)
+{
+    input_start = NULL;
+    input_beyond = NULL;
+    if (stats != NULL) {
+	*stats = string_stats;
+    }
+    return string_stats.borrowed > 0;
+}
+
+
 /*
  * json_conv_bool - convert JSON boolean to C bool
  *
@@ -3888,7 +4961,11 @@ json_conv_bool(char const *ptr, size_t len)
      * duplicate the JSON encoded string
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    if (ret->arena != NULL) {
+	item->as_str = json_arena_alloc(ret->arena, len+1+1);
+    } else {
+	item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    }
     if (item->as_str == NULL) {
 	errp(20, __func__, "calloc #1 error allocating %zu bytes", (len+1+1));
 	not_reached();
@@ -4043,7 +5120,11 @@ json_conv_null(char const *ptr, size_t len)
      * duplicate the JSON string
      */
     errno = 0;			/* pre-clear errno for errp() */
-    item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    if (ret->arena != NULL) {
+	item->as_str = json_arena_alloc(ret->arena, len+1+1);
+    } else {
+	item->as_str = calloc(len+1+1, sizeof(*(item->as_str)));
+    }
     if (item->as_str == NULL) {
 	errp(23, __func__, "calloc #1 error allocating %zu bytes", (len+1+1));
 	not_reached();
@@ -4309,6 +5390,7 @@ json_create_object(void)
     item->len = 0;
     item->set = NULL;
     item->s = NULL;
+    item->index = NULL;
 
     /*
      * create a dynamic array to store JSON objects
@@ -4318,6 +5400,7 @@ json_create_object(void)
 	errp(29, __func__, "dyn_array_create() returned NULL");
 	not_reached();
     }
+    json_arena_own_array(ret->arena, item->s);	/* arena, if any, frees item->s when reset */
 
     /*
      * initialize accounting for the object
@@ -4401,6 +5484,11 @@ json_object_add_member(struct json *node, struct json *member)
      */
     member->parent = node;
 
+    /*
+     * any member name index no longer indexes every member
+     */
+    json_object_index_free(node);
+
     /*
      * append member
      */
@@ -4471,6 +5559,7 @@ json_create_elements(void)
 	errp(36, __func__, "dyn_array_create() returned NULL");
 	not_reached();
     }
+    json_arena_own_array(ret->arena, item->s);	/* arena, if any, frees item->s when reset */
 
     /*
      * initialize accounting for the array
@@ -4636,6 +5725,7 @@ json_create_array(void)
 	errp(44, __func__, "dyn_array_create() returned NULL");
 	not_reached();
     }
+    json_arena_own_array(ret->arena, item->s);	/* arena, if any, frees item->s when reset */
 
     /*
      * initialize accounting for the array
@@ -52,6 +52,16 @@
  */
 #include "json_utf8.h"
 
+/*
+ * json_arena - JSON parse tree arena allocator
+ */
+#include "json_arena.h"
+
+/*
+ * json_scan - fast scanning of JSON string bytes
+ */
+#include "json_scan.h"
+
 /*
  * dbg - info, debug, warning, error, and usage message facility
  */
@@ -104,7 +114,14 @@ struct byte2asciistr
 
 
 /*
- * parsed JSON number
+ * converted JSON number
+ *
+ * This structure holds every C numeric form of a JSON number.  It is NOT
+ * stored inside the JSON parse tree node (see struct json_num below) as
+ * that would make every struct json as large as this structure.  Instead
+ * it is allocated by json_number_conv() when the numeric value of a
+ * JTYPE_NUMBER node is first needed (or when the node is formed if
+ * json_number_eager == true).
  *
  * When parsed == false, then all other fields in this structure might be invalid.
  * So you must check the boolean of parsed and only use values if parsed == true.
@@ -247,6 +264,44 @@ struct json_number
 };
 
 
+/*
+ * parsed JSON number - the JTYPE_NUMBER JSON parse tree node
+ *
+ * When parsed == false, then all other fields in this structure might be invalid.
+ * So you must check the boolean of parsed and only use values if parsed == true.
+ *
+ * This compact node keeps only the JSON number string and what can be
+ * determined from its form.  Conversion of the JSON number string into
+ * C numeric values is deferred until one of the json_number_conv() or
+ * json_number_xxx() accessor functions is first called on the node.
+ * Until then, conv == NULL and converted == false.
+ *
+ * If json_number_eager == true when the node is formed, then the
+ * conversion is performed at that time, as was done in the past.
+ *
+ * The as_str, first, as_str_len and number_len have the same meaning as
+ * in struct json_number.  The conv->as_str and conv->first are pointer
+ * copies of as_str and first: only as_str is freed.
+ */
+struct json_num
+{
+    bool parsed;		/* true ==> able to parse correctly */
+    bool converted;		/* true ==> conv != NULL and JSON number string converted to some form of C value */
+
+    bool is_floating;		/* true ==> as_str had a '.' in it such as 1.234, false ==> no '.' found */
+    bool is_e_notation;		/* true ==> e notation used such as 1e10, false ==> no e notation found */
+    bool is_integer;		/* true ==> as_str is a base 10 integer */
+
+    char *as_str;		/* allocated copy of the original allocated JSON number, NUL terminated */
+    char *first;		/* first whitespace character */
+
+    size_t as_str_len;		/* length of as_str */
+    size_t number_len;		/* length of JSON number, w/o leading or trailing whitespace and NUL bytes */
+
+    struct json_number *conv;	/* allocated C numeric conversions, NULL ==> not yet converted */
+};
+
+
 /*
  * parsed JSON string
  *
@@ -274,6 +329,7 @@ struct json_string
 
     char *as_str;		/* allocated non-decoded JSON string, NUL terminated (perhaps sans JSON '"'s) */
     char *str;			/* allocated decoded JSON string, NUL terminated */
+				/* NOTE: str == as_str when JSON decoding was not required */
 
     size_t as_str_len;		/* length of as_str, not including final NUL */
     size_t str_len;		/* length of str, not including final NUL */
@@ -281,6 +337,7 @@ struct json_string
     bool quote;			/* The original JSON string included surrounding '"'s */
 
     bool same;			/* true => as_str same as str, JSON decoding not required */
+    bool borrowed;		/* true ==> as_str points into the JSON input of the tree, not allocated */
 
     bool slash;			/* true ==> / was found after decoding */
     bool posix_safe;		/* true ==> all chars are POSIX portable safe plus + and maybe / after decoding */
@@ -379,6 +436,26 @@ struct json_member
 };
 
 
+/*
+ * JSON object member name index
+ *
+ * An open addressing hash of the decoded names of the JSON members of a JSON
+ * object.  It is formed by json_object_index() the first time a member of the
+ * object is looked up by name, and is owned by the JSON object.  Only the first
+ * JSON member with a given name is indexed.
+ *
+ * The slot array follows the struct in the same allocation.
+ */
+struct json_object_index
+{
+    intmax_t len;		/* number of JSON members when indexed, != object len ==> stale index */
+    intmax_t bad;		/* set[] index of first member that is not a valid JTYPE_MEMBER, len ==> none */
+    bool nul_name;		/* true ==> a decoded member name contains a NUL byte */
+    size_t mask;		/* number of slots - 1 (the number of slots is a power of 2) */
+    intmax_t *slot;		/* set[] index of the member in each slot, -1 ==> empty slot */
+};
+
+
 /*
  * JSON object
  *
@@ -403,6 +480,7 @@ struct json_object
     struct json **set;		/* set of JSON members belonging to the object */
 
     struct dyn_array *s;	/* dynamic array managed storage for the JSON object */
+    struct json_object_index *index;	/* member name index or NULL ==> not formed */
 };
 
 
@@ -468,7 +546,7 @@ struct json_elements
  */
 enum item_type {
     JTYPE_UNSET	    = 0,    /* JSON item has not been set - must be the value 0 */
-    JTYPE_NUMBER,	    /* JSON item is a number - see struct json_number */
+    JTYPE_NUMBER,	    /* JSON item is a number - see struct json_num */
     JTYPE_STRING,	    /* JSON item is a string - see struct json_string */
     JTYPE_BOOL,		    /* JSON item is a boolean - see struct json_boolean */
     JTYPE_NULL,		    /* JSON item is a null - see struct json_null */
@@ -487,7 +565,7 @@ struct json
 {
     enum item_type type;		/* union item specifier */
     union json_union {
-	struct json_number number;	/* JTYPE_NUMBER - value is number (integer or floating point) */
+	struct json_num number;		/* JTYPE_NUMBER - value is number (integer or floating point) */
 	struct json_string string;	/* JTYPE_STRING - value is a string */
 	struct json_boolean boolean;	/* JTYPE_BOOL - value is a JSON boolean */
 	struct json_null null;		/* JTYPE_NULL - value is a JSON null value */
@@ -501,12 +579,39 @@ struct json
      * JSON parse tree links
      */
     struct json *parent;	/* parent node in the JSON parse tree, or NULL if tree root or unlinked */
+
+    /*
+     * JSON parse tree storage
+     */
+    struct json_arena *arena;	/* arena that owns this node and its strings, NULL ==> calloc(3) allocated */
+    char *input;		/* JSON input that strings of the tree point into, NULL ==> none */
+				/* NOTE: only set in the top node of a tree not in an arena */
+    size_t input_mapped;	/* if > 0, input was mmap(2)ed with this length, 0 ==> malloc(3)ed */
+};
+
+
+/*
+ * struct json_string_stats - JSON string allocations saved
+ *
+ * A JSON string that needs no decoding shares one allocation for both its
+ * as_str and str.  While the parser scans a JSON input buffer that the JSON
+ * parse tree will keep (see json_input_begin()), as_str points into that
+ * buffer instead of being allocated.
+ */
+struct json_string_stats
+{
+    uintmax_t strings;		/* JSON strings converted */
+    uintmax_t shared;		/* JSON strings where str is as_str as no decoding was required */
+    uintmax_t borrowed;		/* JSON strings where as_str points into the JSON input */
+    uintmax_t allocs_saved;	/* allocations not made */
+    uintmax_t bytes_saved;	/* bytes not allocated */
 };
 
 
 /*
  * global variables
  */
+extern bool json_number_eager;	/* true ==> convert JSON numbers when parsed, false ==> on first access */
 
 /*
  * external data structures
@@ -542,7 +647,32 @@ extern struct json *json_parse_member(struct json *name, struct json *value);
 extern struct json *json_alloc(enum item_type type);
 extern struct json *json_conv_number(char const *ptr, size_t len);
 extern struct json *json_conv_number_str(char const *str, size_t *retlen);
+extern struct json_number *json_number_conv(struct json *node);
+extern bool json_number_int8(struct json *node, int8_t *ret);
+extern bool json_number_uint8(struct json *node, uint8_t *ret);
+extern bool json_number_int16(struct json *node, int16_t *ret);
+extern bool json_number_uint16(struct json *node, uint16_t *ret);
+extern bool json_number_int32(struct json *node, int32_t *ret);
+extern bool json_number_uint32(struct json *node, uint32_t *ret);
+extern bool json_number_int64(struct json *node, int64_t *ret);
+extern bool json_number_uint64(struct json *node, uint64_t *ret);
+extern bool json_number_int(struct json *node, int *ret);
+extern bool json_number_uint(struct json *node, unsigned int *ret);
+extern bool json_number_long(struct json *node, long *ret);
+extern bool json_number_ulong(struct json *node, unsigned long *ret);
+extern bool json_number_longlong(struct json *node, long long *ret);
+extern bool json_number_ulonglong(struct json *node, unsigned long long *ret);
+extern bool json_number_ssize(struct json *node, ssize_t *ret);
+extern bool json_number_size(struct json *node, size_t *ret);
+extern bool json_number_off(struct json *node, off_t *ret);
+extern bool json_number_maxint(struct json *node, intmax_t *ret);
+extern bool json_number_umaxint(struct json *node, uintmax_t *ret);
+extern bool json_number_float(struct json *node, float *ret);
+extern bool json_number_double(struct json *node, double *ret);
+extern bool json_number_longdouble(struct json *node, long double *ret);
 extern struct json *json_conv_string(char const *ptr, size_t len, bool quote);
+extern void json_input_begin(char *input, size_t len);
+extern bool json_input_end(struct json_string_stats *stats);
 extern struct json *json_conv_string_str(char const *str, size_t *retlen, bool quote);
 extern struct json *json_conv_bool(char const *ptr, size_t len);
 extern struct json *json_conv_bool_str(char const *str, size_t *retlen);
@@ -0,0 +1,636 @@
+/*
+ * json_scan - fast scanning of JSON string bytes
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/*
+ * json_scan - fast scanning of JSON string bytes
+ */
+#include "json_scan.h"
+
+/*
+ * json_util - general JSON parser utility support functions
+ */
+#include "json_util.h"
+
+#if defined(JSON_SCAN_X86)
+#include <immintrin.h>
+#endif
+
+
+/*
+ * static variables
+ */
+static enum json_scan_impl scan_impl = JSON_SCAN_AUTO;	/* scanner in use, JSON_SCAN_AUTO ==> not yet selected */
+static size_t (*scan_special)(char const *ptr, size_t len) = NULL;	/* json_scan_special() scanner */
+static void (*scan_posix)(char const *str, size_t len, struct json_scan_posix *pos) = NULL; /* json_scan_posix() scanner */
+
+
+/*
+ * static functions
+ */
+static size_t scan_special_scalar(char const *ptr, size_t len);
+static void scan_posix_bytes(char const *str, size_t start, size_t end, size_t len, struct json_scan_posix *pos);
+static void scan_posix_scalar(char const *str, size_t len, struct json_scan_posix *pos);
+#if defined(JSON_SCAN_X86)
+static size_t scan_special_sse2(char const *ptr, size_t len);
+static void scan_posix_sse2(char const *str, size_t len, struct json_scan_posix *pos);
+static size_t scan_special_avx2(char const *ptr, size_t len);
+static void scan_posix_avx2(char const *str, size_t len, struct json_scan_posix *pos);
+#endif
+
+
+/*
+ * json_scan_available - determine if a JSON string scanner can be used
+ *
+ * given:
+ *	impl	JSON string scanner implementation
+ *
+ * returns:
+ *	true ==> impl can be used on this CPU
+ *	false ==> impl was not compiled in, or the CPU does not support it
+ *
+ * NOTE: JSON_SCAN_AUTO and JSON_SCAN_SCALAR are always available.
+ */
+bool
+json_scan_available(enum json_scan_impl impl)
+{
+    switch (impl) {
+    case JSON_SCAN_AUTO:	/*fallthrough*/
+    case JSON_SCAN_SCALAR:
+	return true;
+#if defined(JSON_SCAN_X86)
+    case JSON_SCAN_SSE2:
+	return __builtin_cpu_supports("sse2") ? true : false;
+    case JSON_SCAN_AVX2:
+	return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+    default:
+	break;
+    }
+    return false;
+}
+
+
+/*
+ * json_scan_select - select the JSON string scanner to use
+ *
+ * By default the first call to json_scan_special() or json_scan_posix()
+ * selects the fastest scanner that the CPU supports.  This function allows
+ * a particular scanner to be used instead, such as to compare the results
+ * of the SIMD scanners against the scalar scanner.
+ *
+ * given:
+ *	impl	JSON string scanner implementation, JSON_SCAN_AUTO ==> fastest available
+ *
+ * returns:
+ *	JSON string scanner now in use
+ *
+ * NOTE: if impl is not available, a warning is issued and the fastest
+ *	 available scanner is used instead.
+ *
+ * NOTE: the scanner in use is shared by all threads: a program that parses
+ *	 JSON in more than one thread must select the scanner (or call
+ *	 json_scan_current()) before it starts those threads.
+ */
+enum json_scan_impl
+json_scan_select(enum json_scan_impl impl)
+{
+    /*
+     * firewall
+     */
+    if (!json_scan_available(impl)) {
+	warn(__func__, "JSON scanner %s is not available, selecting the fastest available scanner",
+		       json_scan_name(impl));
+	impl = JSON_SCAN_AUTO;
+    }
+
+    /*
+     * select the fastest available scanner if asked
+     */
+    if (impl == JSON_SCAN_AUTO) {
+	if (json_scan_available(JSON_SCAN_AVX2)) {
+	    impl = JSON_SCAN_AVX2;
+	} else if (json_scan_available(JSON_SCAN_SSE2)) {
+	    impl = JSON_SCAN_SSE2;
+	} else {
+	    impl = JSON_SCAN_SCALAR;
+	}
+    }
+
+    /*
+     * use the scanner
+     */
+    switch (impl) {
+#if defined(JSON_SCAN_X86)
+    case JSON_SCAN_SSE2:
+	scan_special = scan_special_sse2;
+	scan_posix = scan_posix_sse2;
+	break;
+    case JSON_SCAN_AVX2:
+	scan_special = scan_special_avx2;
+	scan_posix = scan_posix_avx2;
+	break;
+#endif
+    default:
+	impl = JSON_SCAN_SCALAR;
+	scan_special = scan_special_scalar;
+	scan_posix = scan_posix_scalar;
+	break;
+    }
+    scan_impl = impl;
+    json_dbg(JSON_DBG_HIGH, __func__, "using JSON scanner: %s", json_scan_name(impl));
+    return impl;
+}
+
+
+/*
+ * json_scan_current - return the JSON string scanner in use
+ *
+ * returns:
+ *	JSON string scanner in use
+ *
+ * NOTE: if no scanner has been selected yet, the fastest available
+ *	 scanner is selected.
+ */
+enum json_scan_impl
+json_scan_current(void)
+{
+    if (scan_impl == JSON_SCAN_AUTO) {
+	(void) json_scan_select(JSON_SCAN_AUTO);
+    }
+    return scan_impl;
+}
+
+
+/*
+ * json_scan_name - return the name of a JSON string scanner
+ *
+ * given:
+ *	impl	JSON string scanner implementation
+ *
+ * returns:
+ *	constant string naming impl
+ */
+char const *
+json_scan_name(enum json_scan_impl impl)
+{
+    switch (impl) {
+    case JSON_SCAN_AUTO:
+	return "auto";
+    case JSON_SCAN_SCALAR:
+	return "scalar";
+    case JSON_SCAN_SSE2:
+	return "sse2";
+    case JSON_SCAN_AVX2:
+	return "avx2";
+    default:
+	break;
+    }
+    return "unknown";
+}
+
+
+/*
+ * json_scan_special - find the first byte of a JSON string that needs attention
+ *
+ * The bytes that need attention when decoding or checking a JSON string
+ * are '"', '\\' and the ASCII control bytes [\x00-\x1f].  All other bytes,
+ * including those with the high bit set, decode to themselves.
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *
+ * returns:
+ *	index of the first '"', '\\' or [\x00-\x1f] byte in ptr,
+ *	or len if there is no such byte (or ptr is NULL)
+ */
+size_t
+json_scan_special(char const *ptr, size_t len)
+{
+    /*
+     * firewall
+     */
+    if (ptr == NULL) {
+	return len;
+    }
+
+    if (scan_special == NULL) {
+	(void) json_scan_select(JSON_SCAN_AUTO);
+    }
+    return scan_special(ptr, len);
+}
+
+
+/*
+ * json_scan_posix - find the bytes of a string that posix_safe_chk() tests
+ *
+ * Each member of pos is set to the index of the first byte in str of its
+ * kind, or to len if str has no such byte.  A byte with the high bit set is
+ * classified with isalnum(3) and isupper(3), as posix_safe_chk() does.
+ *
+ * given:
+ *	str	string to scan
+ *	len	length of str in bytes
+ *	pos	pointer to where to store the indices found
+ *
+ * NOTE: This function does not return when given a NULL pointer.
+ */
+void
+json_scan_posix(char const *str, size_t len, struct json_scan_posix *pos)
+{
+    /*
+     * firewall
+     */
+    if (str == NULL || pos == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    if (scan_posix == NULL) {
+	(void) json_scan_select(JSON_SCAN_AUTO);
+    }
+    scan_posix(str, len, pos);
+}
+
+
+/*
+ * scan_special_scalar - json_scan_special() one byte at a time
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *
+ * returns:
+ *	index of the first '"', '\\' or [\x00-\x1f] byte in ptr, or len
+ */
+static size_t
+scan_special_scalar(char const *ptr, size_t len)
+{
+    unsigned char c;	/* byte to examine */
+    size_t i;
+
+    for (i=0; i < len; ++i) {
+	c = (unsigned char)ptr[i];
+	if (c == '"' || c == '\\' || c < 0x20) {
+	    break;
+	}
+    }
+    return i;
+}
+
+
+/*
+ * scan_posix_bytes - classify part of a string one byte at a time
+ *
+ * given:
+ *	str	string to scan
+ *	start	index of the first byte to classify
+ *	end	index beyond the last byte to classify
+ *	len	length of str in bytes
+ *	pos	indices found so far, a member == len ==> not yet found
+ */
+static void
+scan_posix_bytes(char const *str, size_t start, size_t end, size_t len, struct json_scan_posix *pos)
+{
+    unsigned char c;	/* byte to classify */
+    size_t i;
+
+    for (i=start; i < end; ++i) {
+	c = (unsigned char)str[i];
+	if (c == '/') {
+	    if (pos->slash == len) {
+		pos->slash = i;
+	    }
+	} else if (isalnum(c)) {
+	    if (pos->upper == len && isupper(c)) {
+		pos->upper = i;
+	    }
+	} else if (c != '.' && c != '_' && c != '+' && c != '-') {
+	    if (pos->unsafe == len) {
+		pos->unsafe = i;
+	    }
+	}
+    }
+    return;
+}
+
+
+/*
+ * scan_posix_scalar - json_scan_posix() one byte at a time
+ *
+ * given:
+ *	str	string to scan
+ *	len	length of str in bytes
+ *	pos	pointer to where to store the indices found
+ */
+static void
+scan_posix_scalar(char const *str, size_t len, struct json_scan_posix *pos)
+{
+    pos->slash = len;
+    pos->upper = len;
+    pos->unsafe = len;
+    scan_posix_bytes(str, 0, len, len, pos);
+    return;
+}
+
+
+#if defined(JSON_SCAN_X86)
+
+/*
+ * The SSE2 and AVX2 scanners below compare 16 or 32 bytes at a time,
+ * turn the comparison into a bit mask with one bit per byte, and use the
+ * lowest set bit to find the first byte of interest.  Bytes beyond the last
+ * whole 16 or 32 byte chunk are scanned one at a time so that we never read
+ * beyond the end of the string.
+ *
+ * An unsigned byte range test lo <= b <= lo+n is done as min(b-lo, n) == b-lo.
+ */
+
+/*
+ * scan_special_sse2 - json_scan_special() 16 bytes at a time
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *
+ * returns:
+ *	index of the first '"', '\\' or [\x00-\x1f] byte in ptr, or len
+ */
+__attribute__((target("sse2")))
+static size_t
+scan_special_sse2(char const *ptr, size_t len)
+{
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const backslash = _mm_set1_epi8('\\');
+    __m128i const ctrl = _mm_set1_epi8(0x1f);
+    __m128i b;		/* 16 bytes of ptr */
+    __m128i m;		/* 0xff ==> byte needs attention */
+    unsigned int mask;	/* 1 bit ==> byte needs attention */
+    size_t i;
+
+    for (i=0; i + 16 <= len; i += 16) {
+	b = _mm_loadu_si128((__m128i const *)(ptr + i));
+	m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(b, quote), _mm_cmpeq_epi8(b, backslash)),
+			 _mm_cmpeq_epi8(_mm_min_epu8(b, ctrl), b));
+	mask = (unsigned int)_mm_movemask_epi8(m);
+	if (mask != 0) {
+	    return i + (size_t)__builtin_ctz(mask);
+	}
+    }
+    return i + scan_special_scalar(ptr + i, len - i);
+}
+
+
+/*
+ * scan_posix_sse2 - json_scan_posix() 16 bytes at a time
+ *
+ * A 16 byte chunk with a byte that has the high bit set is classified one
+ * byte at a time because isalnum(3) and isupper(3) depend on the locale.
+ *
+ * given:
+ *	str	string to scan
+ *	len	length of str in bytes
+ *	pos	pointer to where to store the indices found
+ */
+__attribute__((target("sse2")))
+static void
+scan_posix_sse2(char const *str, size_t len, struct json_scan_posix *pos)
+{
+    __m128i b;		/* 16 bytes of str */
+    __m128i t;		/* b minus the start of a byte range */
+    __m128i up;		/* 0xff ==> UPPER case byte */
+    __m128i safe;	/* 0xff ==> POSIX portable safe plus +/ byte */
+    __m128i slash;	/* 0xff ==> / byte */
+    unsigned int mask;	/* 1 bit per byte */
+    size_t i;
+
+    pos->slash = len;
+    pos->upper = len;
+    pos->unsafe = len;
+    for (i=0; i + 16 <= len; i += 16) {
+
+	/*
+	 * stop once everything has been found
+	 */
+	if (pos->slash < len && pos->upper < len && pos->unsafe < len) {
+	    return;
+	}
+
+	b = _mm_loadu_si128((__m128i const *)(str + i));
+
+	/*
+	 * let the locale classify bytes with the high bit set
+	 */
+	if (_mm_movemask_epi8(b) != 0) {
+	    scan_posix_bytes(str, i, i + 16, len, pos);
+	    continue;
+	}
+
+	/*
+	 * classify ASCII bytes
+	 */
+	t = _mm_sub_epi8(b, _mm_set1_epi8('A'));
+	up = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('Z'-'A')), t);
+	t = _mm_sub_epi8(b, _mm_set1_epi8('a'));
+	safe = _mm_or_si128(up, _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('z'-'a')), t));
+	t = _mm_sub_epi8(b, _mm_set1_epi8('0'));
+	safe = _mm_or_si128(safe, _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8('9'-'0')), t));
+	slash = _mm_cmpeq_epi8(b, _mm_set1_epi8('/'));
+	safe = _mm_or_si128(safe, slash);
+	safe = _mm_or_si128(safe, _mm_cmpeq_epi8(b, _mm_set1_epi8('.')));
+	safe = _mm_or_si128(safe, _mm_cmpeq_epi8(b, _mm_set1_epi8('_')));
+	safe = _mm_or_si128(safe, _mm_cmpeq_epi8(b, _mm_set1_epi8('+')));
+	safe = _mm_or_si128(safe, _mm_cmpeq_epi8(b, _mm_set1_epi8('-')));
+
+	/*
+	 * record the first of each kind found
+	 */
+	if (pos->slash == len) {
+	    mask = (unsigned int)_mm_movemask_epi8(slash);
+	    if (mask != 0) {
+		pos->slash = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+	if (pos->upper == len) {
+	    mask = (unsigned int)_mm_movemask_epi8(up);
+	    if (mask != 0) {
+		pos->upper = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+	if (pos->unsafe == len) {
+	    mask = (unsigned int)_mm_movemask_epi8(safe) ^ 0xffffU;
+	    if (mask != 0) {
+		pos->unsafe = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+    }
+    scan_posix_bytes(str, i, len, len, pos);
+    return;
+}
+
+
+/*
+ * scan_special_avx2 - json_scan_special() 32 bytes at a time
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *
+ * returns:
+ *	index of the first '"', '\\' or [\x00-\x1f] byte in ptr, or len
+ */
+__attribute__((target("avx2")))
+static size_t
+scan_special_avx2(char const *ptr, size_t len)
+{
+    __m256i const quote = _mm256_set1_epi8('"');
+    __m256i const backslash = _mm256_set1_epi8('\\');
+    __m256i const ctrl = _mm256_set1_epi8(0x1f);
+    __m256i b;		/* 32 bytes of ptr */
+    __m256i m;		/* 0xff ==> byte needs attention */
+    unsigned int mask;	/* 1 bit ==> byte needs attention */
+    size_t i;
+
+    for (i=0; i + 32 <= len; i += 32) {
+	b = _mm256_loadu_si256((__m256i const *)(ptr + i));
+	m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(b, quote), _mm256_cmpeq_epi8(b, backslash)),
+			    _mm256_cmpeq_epi8(_mm256_min_epu8(b, ctrl), b));
+	mask = (unsigned int)_mm256_movemask_epi8(m);
+	if (mask != 0) {
+	    return i + (size_t)__builtin_ctz(mask);
+	}
+    }
+    return i + scan_special_scalar(ptr + i, len - i);
+}
+
+
+/*
+ * scan_posix_avx2 - json_scan_posix() 32 bytes at a time
+ *
+ * A 32 byte chunk with a byte that has the high bit set is classified one
+ * byte at a time because isalnum(3) and isupper(3) depend on the locale.
+ *
+ * given:
+ *	str	string to scan
+ *	len	length of str in bytes
+ *	pos	pointer to where to store the indices found
+ */
+__attribute__((target("avx2")))
+static void
+scan_posix_avx2(char const *str, size_t len, struct json_scan_posix *pos)
+{
+    __m256i b;		/* 32 bytes of str */
+    __m256i t;		/* b minus the start of a byte range */
+    __m256i up;		/* 0xff ==> UPPER case byte */
+    __m256i safe;	/* 0xff ==> POSIX portable safe plus +/ byte */
+    __m256i slash;	/* 0xff ==> / byte */
+    unsigned int mask;	/* 1 bit per byte */
+    size_t i;
+
+    pos->slash = len;
+    pos->upper = len;
+    pos->unsafe = len;
+    for (i=0; i + 32 <= len; i += 32) {
+
+	/*
+	 * stop once everything has been found
+	 */
+	if (pos->slash < len && pos->upper < len && pos->unsafe < len) {
+	    return;
+	}
+
+	b = _mm256_loadu_si256((__m256i const *)(str + i));
+
+	/*
+	 * let the locale classify bytes with the high bit set
+	 */
+	if (_mm256_movemask_epi8(b) != 0) {
+	    scan_posix_bytes(str, i, i + 32, len, pos);
+	    continue;
+	}
+
+	/*
+	 * classify ASCII bytes
+	 */
+	t = _mm256_sub_epi8(b, _mm256_set1_epi8('A'));
+	up = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8('Z'-'A')), t);
+	t = _mm256_sub_epi8(b, _mm256_set1_epi8('a'));
+	safe = _mm256_or_si256(up, _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8('z'-'a')), t));
+	t = _mm256_sub_epi8(b, _mm256_set1_epi8('0'));
+	safe = _mm256_or_si256(safe, _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8('9'-'0')), t));
+	slash = _mm256_cmpeq_epi8(b, _mm256_set1_epi8('/'));
+	safe = _mm256_or_si256(safe, slash);
+	safe = _mm256_or_si256(safe, _mm256_cmpeq_epi8(b, _mm256_set1_epi8('.')));
+	safe = _mm256_or_si256(safe, _mm256_cmpeq_epi8(b, _mm256_set1_epi8('_')));
+	safe = _mm256_or_si256(safe, _mm256_cmpeq_epi8(b, _mm256_set1_epi8('+')));
+	safe = _mm256_or_si256(safe, _mm256_cmpeq_epi8(b, _mm256_set1_epi8('-')));
+
+	/*
+	 * record the first of each kind found
+	 */
+	if (pos->slash == len) {
+	    mask = (unsigned int)_mm256_movemask_epi8(slash);
+	    if (mask != 0) {
+		pos->slash = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+	if (pos->upper == len) {
+	    mask = (unsigned int)_mm256_movemask_epi8(up);
+	    if (mask != 0) {
+		pos->upper = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+	if (pos->unsafe == len) {
+	    mask = ~(unsigned int)_mm256_movemask_epi8(safe);
+	    if (mask != 0) {
+		pos->unsafe = i + (size_t)__builtin_ctz(mask);
+	    }
+	}
+    }
+    scan_posix_bytes(str, i, len, len, pos);
+    return;
+}
+
+#endif /* JSON_SCAN_X86 */
@@ -0,0 +1,120 @@
+/*
+ * json_scan - fast scanning of JSON string bytes
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_SCAN_H)
+#    define  INCLUDE_JSON_SCAN_H
+
+
+#include <stddef.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#if defined(INTERNAL_INCLUDE)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#elif defined(INTERNAL_INCLUDE_2)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#else
+  #include <c_bool.h>
+  #include <c_compat.h>
+  #include <dbg.h>
+#endif
+
+
+/*
+ * definitions
+ */
+
+/*
+ * JSON_SCAN_X86 - defined when the x86 SSE2 and AVX2 scanners may be compiled
+ *
+ * The SSE2 and AVX2 scanners are compiled with per-function target attributes,
+ * so they do not need special compiler flags.  Whether they are used depends on
+ * what the CPU supports at runtime.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_SCAN_X86
+#endif
+
+
+/*
+ * enum json_scan_impl - JSON string scanner implementations
+ */
+enum json_scan_impl
+{
+    JSON_SCAN_AUTO = 0,		/* select the fastest implementation that the CPU supports */
+    JSON_SCAN_SCALAR,		/* portable byte at a time scanner */
+    JSON_SCAN_SSE2,		/* x86 SSE2 scanner: 16 bytes at a time */
+    JSON_SCAN_AVX2,		/* x86 AVX2 scanner: 32 bytes at a time */
+};
+#define JSON_SCAN_IMPL_COUNT (JSON_SCAN_AVX2+1)	/* number of enum json_scan_impl values */
+
+
+/*
+ * struct json_scan_posix - where posix_safe_chk() related bytes were first found
+ *
+ * Each member is the index of the first such byte, or the length of the
+ * string scanned if there is no such byte.
+ */
+struct json_scan_posix
+{
+    size_t slash;		/* first / */
+    size_t upper;		/* first UPPER case character */
+    size_t unsafe;		/* first character that is not POSIX portable safe plus +/ */
+};
+
+
+/*
+ * external function declarations
+ */
+extern bool json_scan_available(enum json_scan_impl impl);
+extern enum json_scan_impl json_scan_select(enum json_scan_impl impl);
+extern enum json_scan_impl json_scan_current(void);
+extern char const *json_scan_name(enum json_scan_impl impl);
+extern size_t json_scan_special(char const *ptr, size_t len);
+extern void json_scan_posix(char const *str, size_t len, struct json_scan_posix *pos);
+
+
+#endif /* INCLUDE_JSON_SCAN_H */
@@ -46,6 +46,7 @@
 
 
 #include <limits.h>
+#include <string.h>
 
 /*
  * json_sem - JSON semantics support
@@ -108,7 +109,11 @@ static struct json_sem_val_err sem_val_err_NULL =
 /*
  * static functions
  */
-static void sem_walk(struct json *node, unsigned int depth, va_list ap);
+static int sem_slot_cmp(void const *a, void const *b);
+static bool sem_slot_same_key(struct json_sem_slot const *a, struct json_sem_slot const *b);
+static struct json_sem_slot const *sem_hash_slot(struct json_sem_hash const *hash, unsigned int depth,
+						 enum item_type type, char const *name);
+static void sem_walk(struct json *node, unsigned int depth, void *ctx);
 
 
 /*
@@ -414,9 +419,9 @@ sem_node_valid(struct json const *node, unsigned int depth, struct json_sem *sem
 	return false;
 	break;
 
-    case JTYPE_NUMBER:  /* JSON item is number - see struct json_number */
+    case JTYPE_NUMBER:  /* JSON item is number - see struct json_num */
 	{
-	    struct json_number const *item = &(node->item.number);
+	    struct json_num const *item = &(node->item.number);
 
 	    /* converted check */
 	    if (!VALID_JSON_NODE(item)) {
@@ -1282,7 +1287,7 @@ sem_member_value_unsigned(struct json const *node, unsigned int depth, struct js
 	}
 	return NULL;
     }
-    unum = &(value->item.number);
+    unum = json_number_conv(value);
     if (!VALID_JSON_NODE(unum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(67, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
@@ -1360,7 +1365,7 @@ sem_member_value_int(struct json const *node, unsigned int depth, struct json_se
 	}
 	return NULL;
     }
-    inum = &(value->item.number);
+    inum = json_number_conv(value);
     if (!VALID_JSON_NODE(inum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(70, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
@@ -1437,7 +1442,7 @@ sem_member_value_size_t(struct json const *node, unsigned int depth, struct json
 	}
 	return NULL;
     }
-    snum = &(value->item.number);
+    snum = json_number_conv(value);
     if (!VALID_JSON_NODE(snum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(73, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
@@ -1515,7 +1520,7 @@ sem_member_value_time_t(struct json const *node, unsigned int depth, struct json
 	}
 	return NULL;
     }
-    inum = &(value->item.number);
+    inum = json_number_conv(value);
     if (!VALID_JSON_NODE(inum)) {
 	if (val_err != NULL) {
 	    *val_err = werr_sem_val(76, node, depth, sem, name, "node value JTYPE_NUMBER converted is false");
@@ -1680,6 +1685,7 @@ sem_object_find_name(struct json const *node, unsigned int depth, struct json_se
 		     char const *memname)
 {
     struct json_object const *item = NULL;	/* JSON member */
+    struct json_object_index const *index = NULL;	/* JSON object member name index or NULL */
     bool valid = false;				/* true ==> JSON node is converted and valid JTYPE */
     intmax_t i;
 
@@ -1734,6 +1740,29 @@ sem_object_find_name(struct json const *node, unsigned int depth, struct json_se
 	return NULL;
     }
 
+    /*
+     * look for the named member via the JSON object member name index
+     *
+     * NOTE: When a member before the named member (or any member, when there is
+     *	     no such named member) is not a valid JTYPE_MEMBER, or when a member name
+     *	     contains a NUL byte, we search the JSON member array below so that the
+     *	     same JSON semantic validation error is reported.
+     */
+    i = json_object_find((struct json *)node, memname, strlen(memname));
+    index = item->index;
+    if (i >= -1 && index != NULL && index->nul_name == false) {
+	if (i >= 0 && i < index->bad) {
+	    /* found match */
+	    return item->set[i];
+	} else if (i == -1 && index->bad == item->len) {
+	    /* no such member */
+	    if (val_err != NULL) {
+		*val_err = werr_sem_val(91, node, depth, sem, name, "JTYPE_OBJECT has no member named: <%s>", memname);
+	    }
+	    return NULL;
+	}
+    }
+
     /*
      * search the JSON member array for the named member
      */
@@ -2022,69 +2051,666 @@ json_sem_find(struct json *node, unsigned int depth, struct json_sem *sem)
 }
 
 
+/*
+ * json_sem_hash_key - hash a (depth, type, name) JSON semantic table key
+ *
+ * This is a FNV-1a hash of the key, perturbed by seed, followed by the
+ * final avalanche of MurmurHash3 so that every bit of the result depends
+ * on every bit of the key.
+ *
+ * given:
+ *	depth		JSON parse tree node depth
+ *	type		type of JSON node
+ *	name		JTYPE_MEMBER name or NULL
+ *	name_len	length of name (not including final NUL), ignored if name is NULL
+ *	seed		which hash to form (0 ==> bucket hash, > 0 ==> slot hash)
+ *
+ * returns:
+ *	32 bit hash of the key
+ */
+uint32_t
+json_sem_hash_key(unsigned int depth, enum item_type type, char const *name, size_t name_len, unsigned int seed)
+{
+    uint32_t h = 2166136261U ^ ((uint32_t)seed * 0x9e3779b9U);	/* FNV-1a offset basis perturbed by seed */
+    size_t i;
+
+    /*
+     * hash depth and type
+     */
+    for (i=0; i < sizeof(uint32_t); ++i) {
+	h ^= ((uint32_t)depth >> (i*8)) & 0xff;
+	h *= 16777619U;
+    }
+    h ^= (uint32_t)type & 0xff;
+    h *= 16777619U;
+
+    /*
+     * hash name, if any
+     */
+    if (name != NULL) {
+	for (i=0; i < name_len; ++i) {
+	    h ^= (uint8_t)name[i];
+	    h *= 16777619U;
+	}
+    }
+
+    /*
+     * final avalanche
+     */
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+
+/*
+ * sem_slot_cmp - compare JSON semantic table hash slots for qsort()
+ *
+ * Slots are sorted by depth, type and name (NULL names first), and then
+ * by the first JSON semantic table entry that they match.
+ *
+ * given:
+ *	a	pointer to first struct json_sem_slot to compare
+ *	b	pointer to second struct json_sem_slot to compare
+ *
+ * returns:
+ *	< 0	a < b
+ *	== 0	a == b
+ *	> 0	a > b
+ */
+static int
+sem_slot_cmp(void const *a, void const *b)
+{
+    struct json_sem_slot const *pa = (struct json_sem_slot const *)a;
+    struct json_sem_slot const *pb = (struct json_sem_slot const *)b;
+    int cmp;
+
+    if (pa->depth != pb->depth) {
+	return pa->depth < pb->depth ? -1 : 1;
+    }
+    if (pa->type != pb->type) {
+	return pa->type < pb->type ? -1 : 1;
+    }
+    if (pa->name == NULL || pb->name == NULL) {
+	if (pa->name != pb->name) {
+	    return pa->name == NULL ? -1 : 1;
+	}
+    } else {
+	cmp = strcmp(pa->name, pb->name);
+	if (cmp != 0) {
+	    return cmp;
+	}
+    }
+    return (pa->first > pb->first) - (pa->first < pb->first);
+}
+
+
+/*
+ * sem_slot_same_key - determine if two JSON semantic table hash slots have the same key
+ *
+ * given:
+ *	a	pointer to first slot
+ *	b	pointer to second slot
+ *
+ * returns:
+ *	true ==> same (depth, type, name) key
+ *	false ==> different keys
+ */
+static bool
+sem_slot_same_key(struct json_sem_slot const *a, struct json_sem_slot const *b)
+{
+    if (a->depth != b->depth || a->type != b->type) {
+	return false;
+    }
+    if (a->name == NULL || b->name == NULL) {
+	return a->name == b->name;
+    }
+    return a->name_len == b->name_len && strcmp(a->name, b->name) == 0;
+}
+
+
+/*
+ * sem_hash_slot - find the slot of a key in a JSON semantic table hash
+ *
+ * given:
+ *	hash	JSON semantic table hash
+ *	depth	JSON parse tree node depth
+ *	type	type of JSON node
+ *	name	JTYPE_MEMBER name or NULL ==> (depth, type) slot
+ *
+ * returns:
+ *	slot of the key, or NULL ==> key is not in the JSON semantic table
+ */
+static struct json_sem_slot const *
+sem_hash_slot(struct json_sem_hash const *hash, unsigned int depth, enum item_type type, char const *name)
+{
+    struct json_sem_slot const *slot = NULL;	/* slot where key must be if it is in the hash */
+    size_t name_len = 0;			/* length of name */
+    unsigned int bucket;			/* bucket of key */
+
+    if (name != NULL) {
+	name_len = strlen(name);
+    }
+    bucket = json_sem_hash_key(depth, type, name, name_len, 0) % hash->nbuckets;
+    slot = &hash->slot[json_sem_hash_key(depth, type, name, name_len, hash->disp[bucket] + 1) & (hash->nslots - 1)];
+    if (slot->type != type || slot->depth != depth) {
+	return NULL;
+    }
+    if (name == NULL || slot->name == NULL) {
+	return name == slot->name ? slot : NULL;
+    }
+    if (slot->name_len != name_len || strcmp(name, slot->name) != 0) {
+	return NULL;
+    }
+    return slot;
+}
+
+
+/*
+ * json_sem_hash_build - form a perfect hash of a JSON semantic table
+ *
+ * There is a (depth, type) key for each (depth, type) in the JSON semantic
+ * table, and a (depth, JTYPE_MEMBER, name) key for each named JTYPE_MEMBER.
+ * The slot of each key records the first JSON semantic table entry that
+ * json_sem_find() would match, so that json_sem_find_hash() returns the same
+ * index that json_sem_find() does.
+ *
+ * The keys are hashed into buckets of about 2 keys each.  Starting with the
+ * largest bucket, each bucket is given the smallest displacement that puts
+ * all of its keys into free slots.  If some bucket cannot be placed, the
+ * number of slots is doubled and we start over.
+ *
+ * given:
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *
+ * returns:
+ *	allocated JSON semantic table hash, or NULL ==> error
+ *
+ * NOTE: The names in the slots point to the names in the JSON semantic table.
+ *
+ * NOTE: Use json_sem_hash_free() to free the returned hash.
+ */
+struct json_sem_hash *
+json_sem_hash_build(struct json_sem *sem)
+{
+    struct json_sem_hash *hash = NULL;		/* JSON semantic table hash to return */
+    struct json_sem_slot *keys = NULL;		/* distinct keys of the JSON semantic table */
+    unsigned int *bucket = NULL;		/* bucket of each key */
+    unsigned int *order = NULL;			/* keys ordered by bucket, largest bucket first */
+    unsigned int *bucket_len = NULL;		/* number of keys in each bucket */
+    unsigned int *place = NULL;			/* slot of each key of the bucket being placed */
+    unsigned int *len_start = NULL;		/* start in order[] of the buckets of each length */
+    unsigned int max_len = 0;			/* number of keys in the largest bucket */
+    size_t nkeys = 0;				/* number of distinct keys */
+    unsigned int nslots = 0;			/* number of slots */
+    unsigned int nbuckets = 0;			/* number of buckets */
+    unsigned int disp = 0;			/* displacement being tried */
+    unsigned int start;				/* first key in order[] of the bucket being placed */
+    unsigned int end;				/* beyond the last key in order[] of the bucket being placed */
+    bool placed = false;			/* true ==> bucket was placed */
+    int len = 0;				/* number of JSON semantic table entries */
+    size_t i;
+    size_t j;
+    size_t k;
+
+    /*
+     * firewall
+     */
+    if (sem == NULL) {
+	warn(__func__, "sem is NULL");
+	return NULL;
+    }
+
+    /*
+     * collect a (depth, type) key for each entry, and a (depth, type, name) key for each named member
+     */
+    for (len=0; sem[len].type != JTYPE_UNSET; ++len) {
+	if (len == INT_MAX) {
+	    warn(__func__, "JSON semantic table is too large to hash");
+	    return NULL;
+	}
+    }
+    keys = calloc((size_t)len * 2 + 1, sizeof(*keys));
+    if (keys == NULL) {
+	warn(__func__, "calloc of %d keys failed", len * 2 + 1);
+	return NULL;
+    }
+    for (i=0; i < (size_t)len; ++i) {
+	keys[nkeys].depth = sem[i].depth;
+	keys[nkeys].type = sem[i].type;
+	keys[nkeys].name = NULL;
+	keys[nkeys].name_len = 0;
+	keys[nkeys].first = (int)i;
+	keys[nkeys].unnamed = (sem[i].name_len == 0) ? (int)i : -1;
+	++nkeys;
+	if (sem[i].type == JTYPE_MEMBER && sem[i].name_len > 0 && sem[i].name != NULL) {
+	    keys[nkeys].depth = sem[i].depth;
+	    keys[nkeys].type = sem[i].type;
+	    keys[nkeys].name = sem[i].name;
+	    keys[nkeys].name_len = strlen(sem[i].name);
+	    keys[nkeys].first = (int)i;
+	    keys[nkeys].unnamed = -1;
+	    ++nkeys;
+	}
+    }
+
+    /*
+     * merge duplicate keys, keeping the first match and the first unnamed match
+     */
+    if (nkeys > 0) {
+	qsort(keys, nkeys, sizeof(*keys), sem_slot_cmp);
+	for (i=1, j=0; i < nkeys; ++i) {
+	    if (sem_slot_same_key(&keys[j], &keys[i])) {
+		if (keys[j].unnamed < 0) {
+		    keys[j].unnamed = keys[i].unnamed;
+		}
+	    } else {
+		keys[++j] = keys[i];
+	    }
+	}
+	nkeys = j + 1;
+    }
+
+    /*
+     * allocate the JSON semantic table hash
+     */
+    nbuckets = (unsigned int)(nkeys / 2) + 1;
+    for (nslots = 1; nslots < nkeys + nkeys/4 + 1; nslots <<= 1) {
+	;
+    }
+    hash = calloc(1, sizeof(*hash));
+    bucket = calloc(nkeys + 1, sizeof(*bucket));
+    order = calloc(nkeys + 1, sizeof(*order));
+    bucket_len = calloc(nbuckets, sizeof(*bucket_len));
+    place = calloc(nkeys + 1, sizeof(*place));
+    if (hash == NULL || bucket == NULL || order == NULL || bucket_len == NULL || place == NULL) {
+	warn(__func__, "calloc of JSON semantic table hash for %zu keys failed", nkeys);
+	free(keys);
+	free(hash);
+	free(bucket);
+	free(order);
+	free(bucket_len);
+	free(place);
+	return NULL;
+    }
+    hash->len = len;
+    hash->nbuckets = nbuckets;
+    hash->allocated = true;
+
+    /*
+     * order the keys by bucket, largest bucket first
+     */
+    for (i=0; i < nkeys; ++i) {
+	bucket[i] = json_sem_hash_key(keys[i].depth, keys[i].type, keys[i].name, keys[i].name_len, 0) % nbuckets;
+	++bucket_len[bucket[i]];
+    }
+    /* count buckets by their length, and then find where each length starts in order[] */
+    for (i=0; i < nbuckets; ++i) {
+	if (bucket_len[i] > max_len) {
+	    max_len = bucket_len[i];
+	}
+    }
+    len_start = calloc((size_t)max_len + 2, sizeof(*len_start));
+    if (len_start == NULL) {
+	warn(__func__, "calloc of %u bucket lengths failed", max_len + 2);
+	free(keys);
+	free(bucket);
+	free(order);
+	free(bucket_len);
+	free(place);
+	json_sem_hash_free(hash);
+	return NULL;
+    }
+    for (i=0; i < nbuckets; ++i) {
+	len_start[bucket_len[i]] += bucket_len[i];
+    }
+    for (i=max_len, k=0; i > 0; --i) {
+	j = len_start[i];
+	len_start[i] = (unsigned int)k;
+	k += j;
+    }
+    /* where each bucket starts in order[], the lower bucket first among buckets of the same length */
+    for (i=0; i < nbuckets; ++i) {
+	if (bucket_len[i] > 0) {
+	    place[i] = len_start[bucket_len[i]];
+	    len_start[bucket_len[i]] += bucket_len[i];
+	}
+    }
+    /* the keys of each bucket in key order */
+    for (i=0; i < nkeys; ++i) {
+	order[place[bucket[i]]++] = (unsigned int)i;
+    }
+    free(len_start);
+    len_start = NULL;
+
+    /*
+     * place each bucket, forming more slots until they all fit
+     */
+    do {
+	free(hash->disp);
+	free(hash->slot);
+	hash->nslots = nslots;
+	hash->disp = calloc(nbuckets, sizeof(*(hash->disp)));
+	hash->slot = calloc(nslots, sizeof(*(hash->slot)));
+	if (hash->disp == NULL || hash->slot == NULL) {
+	    warn(__func__, "calloc of JSON semantic table hash of %u slots failed", nslots);
+	    free(keys);
+	    free(bucket);
+	    free(order);
+	    free(bucket_len);
+	    free(place);
+	    json_sem_hash_free(hash);
+	    return NULL;
+	}
+	for (i=0; i < nslots; ++i) {
+	    hash->slot[i].type = JTYPE_UNSET;
+	    hash->slot[i].first = -1;
+	    hash->slot[i].unnamed = -1;
+	}
+
+	placed = true;
+	for (start=0; placed && start < nkeys; start = end) {
+	    for (end=start+1; end < nkeys && bucket[order[end]] == bucket[order[start]]; ++end) {
+		;
+	    }
+
+	    /*
+	     * find the smallest displacement that puts every key of the bucket in a free slot
+	     */
+	    placed = false;
+	    for (disp=0; !placed && disp < JSON_SEM_HASH_MAX_DISP; ++disp) {
+		placed = true;
+		for (k=start; placed && k < end; ++k) {
+		    struct json_sem_slot const *key = &keys[order[k]];	/* key to place */
+
+		    place[k-start] = json_sem_hash_key(key->depth, key->type, key->name, key->name_len,
+						       disp + 1) & (nslots - 1);
+		    if (hash->slot[place[k-start]].type != JTYPE_UNSET) {
+			placed = false;
+		    }
+		    for (j=start; placed && j < k; ++j) {
+			if (place[j-start] == place[k-start]) {
+			    placed = false;
+			}
+		    }
+		}
+		if (placed) {
+		    hash->disp[bucket[order[start]]] = disp;
+		    for (k=start; k < end; ++k) {
+			hash->slot[place[k-start]] = keys[order[k]];
+		    }
+		}
+	    }
+	}
+	if (!placed) {
+	    nslots <<= 1;
+	}
+    } while (!placed);
+
+    /*
+     * free storage
+     */
+    free(keys);
+    free(bucket);
+    free(order);
+    free(bucket_len);
+    free(place);
+
+    json_dbg(JSON_DBG_HIGH, __func__, "hashed %d JSON semantic table entries: %zu keys in %u slots",
+	     len, nkeys, nslots);
+    return hash;
+}
+
+
+/*
+ * json_sem_hash_ok - determine if a JSON semantic table hash is for a JSON semantic table
+ *
+ * A JSON semantic table hash printed by jsemtblgen is only correct for
+ * the JSON semantic table printed with it.  Here we check that every entry
+ * of the JSON semantic table is found in the hash, and that each slot of the
+ * hash matches the JSON semantic table entries that it refers to.
+ *
+ * given:
+ *	sem	pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	hash	JSON semantic table hash
+ *
+ * returns:
+ *	true ==> hash may be used to search sem
+ *	false ==> hash is not for sem, or NULL args
+ */
+bool
+json_sem_hash_ok(struct json_sem *sem, struct json_sem_hash const *hash)
+{
+    struct json_sem_slot const *slot = NULL;	/* slot of an entry */
+    int len = 0;				/* number of JSON semantic table entries */
+    unsigned int i;
+
+    /*
+     * firewall
+     */
+    if (sem == NULL || hash == NULL || hash->disp == NULL || hash->slot == NULL ||
+	hash->nbuckets == 0 || hash->nslots == 0 || (hash->nslots & (hash->nslots - 1)) != 0) {
+	return false;
+    }
+
+    /*
+     * every entry must be found in the hash
+     */
+    for (len=0; sem[len].type != JTYPE_UNSET; ++len) {
+	if (len >= hash->len) {
+	    return false;
+	}
+	slot = sem_hash_slot(hash, sem[len].depth, sem[len].type, NULL);
+	if (slot == NULL) {
+	    return false;
+	}
+	if (sem[len].type == JTYPE_MEMBER && sem[len].name_len > 0 && sem[len].name != NULL &&
+	    sem_hash_slot(hash, sem[len].depth, sem[len].type, sem[len].name) == NULL) {
+	    return false;
+	}
+    }
+    if (len != hash->len) {
+	return false;
+    }
+
+    /*
+     * every slot must match the entries it refers to
+     */
+    for (i=0; i < hash->nslots; ++i) {
+	slot = &hash->slot[i];
+	if (slot->type == JTYPE_UNSET) {
+	    continue;
+	}
+	if (slot->first < 0 || slot->first >= len ||
+	    sem[slot->first].depth != slot->depth || sem[slot->first].type != slot->type) {
+	    return false;
+	}
+	if (slot->name != NULL &&
+	    (sem[slot->first].name == NULL || strcmp(sem[slot->first].name, slot->name) != 0)) {
+	    return false;
+	}
+	if (slot->unnamed >= 0 &&
+	    (slot->unnamed >= len || sem[slot->unnamed].depth != slot->depth ||
+	     sem[slot->unnamed].type != slot->type || sem[slot->unnamed].name_len != 0)) {
+	    return false;
+	}
+    }
+    return true;
+}
+
+
+/*
+ * json_sem_hash_free - free a JSON semantic table hash
+ *
+ * given:
+ *	hash	JSON semantic table hash from json_sem_hash_build(), or NULL
+ *
+ * NOTE: A JSON semantic table hash that was not allocated by
+ *	 json_sem_hash_build(), such as one printed by jsemtblgen,
+ *	 is not freed.
+ */
+void
+json_sem_hash_free(struct json_sem_hash *hash)
+{
+    /*
+     * firewall
+     */
+    if (hash == NULL || hash->allocated == false) {
+	return;
+    }
+
+    /*
+     * free the hash
+     */
+    if (hash->disp != NULL) {
+	free(hash->disp);
+	hash->disp = NULL;
+    }
+    if (hash->slot != NULL) {
+	free(hash->slot);
+	hash->slot = NULL;
+    }
+    free(hash);
+    return;
+}
+
+
+/*
+ * json_sem_find_hash - given JSON node, find first match in JSON semantic table via its hash
+ *
+ * This function returns the same index as json_sem_find(), but finds it with
+ * at most two hash lookups instead of searching the JSON semantic table.
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	depth		depth of node in the JSON parse tree (0 ==> tree root)
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	hash		hash of sem, or NULL ==> search sem via json_sem_find()
+ *
+ * returns:
+ *	>=0 ==> index into JSON semantic table for first match
+ *	-1  ==> no JSON semantic table match found
+ *	< -1 ==> invalid JSON node, or NULL ptr, or internal error
+ */
+int
+json_sem_find_hash(struct json *node, unsigned int depth, struct json_sem *sem, struct json_sem_hash const *hash)
+{
+    struct json_sem_slot const *slot = NULL;	/* (depth, type) slot */
+    struct json_sem_slot const *named = NULL;	/* (depth, JTYPE_MEMBER, name) slot */
+    bool test = false;		/* JSON node test result */
+    char *name = NULL;		/* name of JTYPE_MEMBER node or NULL */
+    enum item_type type;	/* type of JSON node */
+    int ret = -1;		/* index of first match or -1 */
+
+    /*
+     * without a hash, search the JSON semantic table
+     */
+    if (hash == NULL) {
+	return json_sem_find(node, depth, sem);
+    }
+
+    /*
+     * firewall - args
+     */
+    if (node == NULL) {
+	warn(__func__, "node is NULL");
+	return -2;
+    }
+    if (sem == NULL) {
+	warn(__func__, "sem is NULL");
+	return -3;
+    }
+
+    /*
+     * obtain information about the JSON node
+     */
+    type = node->type;
+    if (type == JTYPE_MEMBER) {
+        /* sem_member_name_decoded_str() call checks args via sem_chk_null_args() */
+	/* sem_member_name_decoded_str() also calls sem_node_valid() */
+	/* determine name of JTYPE_MEMBER or return NULL */
+	name = sem_member_name_decoded_str(node, depth, sem, __func__, NULL);
+    } else {
+	test = sem_node_valid(node, depth, sem, __func__, NULL);
+	if (test == false) {
+	    warn(__func__, "JSON node is invalid");
+	    return -4;
+	}
+    }
+
+    /*
+     * case: non-JTYPE_MEMBER or JTYPE_MEMBER w/o name: first (depth, type) match
+     */
+    slot = sem_hash_slot(hash, depth, type, NULL);
+    if (type != JTYPE_MEMBER || name == NULL) {
+	return (slot != NULL) ? slot->first : -1;
+    }
+
+    /*
+     * case: JTYPE_MEMBER - first of the name match and the first entry w/o a name
+     */
+    named = sem_hash_slot(hash, depth, type, name);
+    if (named != NULL) {
+	ret = named->first;
+    }
+    if (slot != NULL && slot->unnamed >= 0 && (ret < 0 || slot->unnamed < ret)) {
+	ret = slot->unnamed;
+    }
+    return ret;
+}
+
+
 /*
  * sem_walk - JSON parse tree semantic tree check walk
  *
  * given:
  *	node	pointer to a JSON parser tree node to free
  *	depth	current tree depth (0 ==> top of tree)
- *	ap	variable argument list, required ap args:
- *
- *		sem		JSON semantic table (ends with a JTYPE_UNSET JSON type)
- *		count_err	dynamic array of JSON semantic count errors
- *		val_err		dynamic array of JSON semantic validation errors
+ *	ctx	pointer to a struct json_sem_walk of the JSON semantic table,
+ *		its hash, and the dynamic arrays of errors
  *
  * NOTE: This function does nothing if node == NULL.
  *
  * NOTE: This function does nothing if the node type is invalid.
  */
 static void
-sem_walk(struct json *node, unsigned int depth, va_list ap)
+sem_walk(struct json *node, unsigned int depth, void *ctx)
 {
-    va_list ap2;			/* copy of va_list ap */
+    struct json_sem_walk *walk = (struct json_sem_walk *)ctx;	/* semantic check walk state */
     struct json_sem *sem = NULL;	/* JSON semantic table (ends with a JTYPE_UNSET JSON type) */
     struct dyn_array *count_err = NULL;	/* dynamic array of JSON semantic count errors */
     struct dyn_array *val_err = NULL;	/* dynamic array of JSON semantic validation errors */
+    struct json_sem_hash const *hash = NULL;	/* hash of sem or NULL */
     bool test = false;			/* validation test result */
     struct json_sem_val_err *error = NULL;/* pointer to semantic validation error */
     struct json_sem_count_err count;	/* semantic count error */
     int index = -1;			/* semantic array index match or -1 ==> no march or < -1 ==> error */
 
     /*
-     * firewall - nothing to do for a NULL node
+     * firewall - nothing to do for a NULL node or walk state
      */
-    if (node == NULL) {
+    if (node == NULL || walk == NULL) {
 	return;
     }
 
     /*
-     * duplicate va_list ap
-     */
-    va_copy(ap2, ap);
-
-    /*
-     * obtain the stream, json_dbg_used, and json_dbg args
+     * obtain the semantic table, the error arrays and the hash
      */
-    sem = va_arg(ap2, struct json_sem *);
-    if (sem == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
-	return;
-    }
-    count_err = va_arg(ap2, struct dyn_array *);
-    if (count_err == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
-	return;
-    }
-    val_err = va_arg(ap2, struct dyn_array *);
-    if (val_err == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
+    sem = walk->sem;
+    count_err = walk->count_err;
+    val_err = walk->val_err;
+    if (sem == NULL || count_err == NULL || val_err == NULL) {
 	return;
     }
+    hash = walk->hash;
 
     /*
      * search for node match in the semantic table
      */
-    index = json_sem_find(node, depth, sem);
+    index = json_sem_find_hash(node, depth, sem, hash);
 
     /*
      * process search result
@@ -2201,11 +2827,6 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 	/* save semantic count error */
 	dyn_array_append_value(count_err, &count);
     }
-
-    /*
-     * stdarg variable argument list cleanup
-     */
-    va_end(ap2);
     return;
 }
 
@@ -2264,9 +2885,52 @@ sem_walk(struct json *node, unsigned int depth, va_list ap)
 uintmax_t
 json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
 	       struct dyn_array **pcount_err, struct dyn_array **pval_err, void *data)
+{
+    return json_sem_check_hash(node, max_depth, sem, NULL, pcount_err, pval_err, data);
+}
+
+
+/*
+ * json_sem_check_hash - check a JSON parse tree against a hashed JSON semantic table
+ *
+ * This function is the same as json_sem_check() except that JSON semantic
+ * table entries are found via a perfect hash of the table, such as the one
+ * that jsemtblgen prints along with the table, instead of a search of the
+ * table for each node of the JSON parse tree.
+ *
+ * given:
+ *	node		pointer to a JSON parse tree
+ *	max_depth	maximum tree depth to descend, or 0 ==> infinite depth
+ *			    NOTE: Use JSON_INFINITE_DEPTH for infinite depth
+ *			    NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	sem		pointer to a JSON semantic table (ends with a JTYPE_UNSET JSON type)
+ *	hash		hash of sem, or NULL ==> form a hash of sem for this check
+ *			    NOTE: If hash does not match sem, a hash of sem is formed instead.
+ *	pcount_err	pointer to dynamic array of JSON semantic count errors,
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *	pval_err	pointer to dynamic array of JSON semantic validation errors
+ *			    NOTE: If *pcount_err == NULL, the dynamic array will be created,
+ *				  If *pcount_err != NULL, the existing dynamic array will be used.
+ *      data            a void * of extra data in case one needs it (corresponds
+ *                      with the data variable in the struct json_sem).
+ *
+ * return:
+ *	0 ==> JSON parse tree is semantically consistent with the JSON semantic table,
+ *	> 0  ==> number of errors (count+validation+internal) found
+ *
+ * NOTE: If a hash of sem cannot be formed, the JSON semantic table is searched
+ *	 for each node of the JSON parse tree as json_sem_check() once did.
+ */
+uintmax_t
+json_sem_check_hash(struct json *node, unsigned int max_depth, struct json_sem *sem,
+		    struct json_sem_hash const *hash,
+		    struct dyn_array **pcount_err, struct dyn_array **pval_err, void *data)
 {
     struct dyn_array *count_err = NULL;		/* JSON semantic count errors */
     struct dyn_array *val_err = NULL;		/* JSON semantic validation errors */
+    struct json_sem_hash *formed = NULL;	/* hash of sem formed for this check or NULL */
+    struct json_sem_walk walk;			/* semantic check walk state */
     uintmax_t errors = 0;			/* number of errors (count+validation+internal) */
 
     /*
@@ -2343,10 +3007,28 @@ json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
      */
     sem->data = data;
 
+    /*
+     * use a hash of the JSON semantic table, forming one if needed
+     */
+    if (hash != NULL && json_sem_hash_ok(sem, hash) == false) {
+	warn(__func__, "hash does not match the JSON semantic table, forming a new hash");
+	hash = NULL;
+    }
+    if (hash == NULL) {
+	formed = json_sem_hash_build(sem);
+	hash = formed;		/* if NULL, sem_walk() will search the JSON semantic table */
+    }
+
     /*
      * perform a semantic scan of the JSON parse tree
      */
-    json_tree_walk(node, max_depth, 0, true, sem_walk, sem, count_err, val_err);
+    walk.sem = sem;
+    walk.count_err = count_err;
+    walk.val_err = val_err;
+    walk.hash = hash;
+    json_walk(node, max_depth, 0, NULL, sem_walk, &walk);
+    json_sem_hash_free(formed);
+    formed = NULL;
 
     /*
      * check semantic table counts
@@ -2480,7 +3162,8 @@ fprint_count_err(FILE *stream, char const *prefix, struct json_sem_count_err *se
 	warn(__func__, "stream is NULL");
 	return;
     }
-    if (fd_is_ready(__func__, true, fileno(stream)) == false) {
+    /* a memory stream, such as one of open_memstream(3), has no file descriptor to check */
+    if (fileno(stream) >= 0 && fd_is_ready(__func__, true, fileno(stream)) == false) {
 	warn(__func__, "stream is is not an open FILE *stream");
 	return;
     }
@@ -2625,7 +3308,8 @@ fprint_val_err(FILE *stream, char const *prefix, struct json_sem_val_err *sem_va
 	warn(__func__, "stream is NULL");
 	return;
     }
-    if (fd_is_ready(__func__, true, fileno(stream)) == false) {
+    /* a memory stream, such as one of open_memstream(3), has no file descriptor to check */
+    if (fileno(stream) >= 0 && fd_is_ready(__func__, true, fileno(stream)) == false) {
 	warn(__func__, "stream is is not an open FILE *stream");
 	return;
     }
@@ -141,6 +141,62 @@ struct json_sem
 };
 
 
+/*
+ * JSON semantic table hash slot
+ *
+ * A slot is either a (depth, type) slot, with a NULL name, or a
+ * (depth, JTYPE_MEMBER, name) slot.
+ */
+struct json_sem_slot
+{
+    unsigned int depth;		/* JSON parse tree node depth */
+    enum item_type type;	/* type of JSON node, JTYPE_UNSET ==> empty slot */
+    size_t name_len;		/* length of name (not including final NUL) or 0 */
+    char const *name;		/* JTYPE_MEMBER name or NULL ==> (depth, type) slot */
+    int first;			/* index of first JSON semantic table entry that matches */
+    int unnamed;		/* (depth, type) slot: index of first entry w/o a name, or -1 */
+};
+
+/*
+ * JSON semantic table hash
+ *
+ * A perfect hash of the (depth, type, name) of the entries of a JSON semantic
+ * table, so that json_sem_find_hash() finds the JSON semantic table entry
+ * that matches a JSON node without searching the JSON semantic table.
+ *
+ * A key is first hashed into one of nbuckets buckets.  The displacement of
+ * that bucket selects the hash that places the key in one of nslots slots.
+ * The displacements are chosen so that no two keys share a slot.
+ *
+ * jsemtblgen prints a JSON semantic table hash along with the JSON semantic
+ * table.  Otherwise json_sem_hash_build() forms one.
+ */
+struct json_sem_hash
+{
+    int len;			/* number of JSON semantic table entries hashed */
+    unsigned int nbuckets;	/* number of displacement buckets */
+    unsigned int nslots;	/* number of slots, a power of 2 */
+    unsigned int *disp;		/* displacement of each bucket */
+    struct json_sem_slot *slot;	/* slots */
+    bool allocated;		/* true ==> allocated by json_sem_hash_build() */
+};
+#define JSON_SEM_HASH_MAX_DISP (1U<<20)	/* largest displacement tried before more slots are used */
+
+
+/*
+ * json_sem_walk - state of a semantic check walk of a JSON parse tree
+ *
+ * json_sem_check_hash() passes this to sem_walk() via json_walk().
+ */
+struct json_sem_walk
+{
+    struct json_sem *sem;		/* JSON semantic table (ends with a JTYPE_UNSET JSON type) */
+    struct dyn_array *count_err;	/* dynamic array of JSON semantic count errors */
+    struct dyn_array *val_err;		/* dynamic array of JSON semantic validation errors */
+    struct json_sem_hash const *hash;	/* hash of sem, or NULL ==> search sem via json_sem_find() */
+};
+
+
 /*
  * str_or_null - report if a JSON JTYPE_MEMBER value is a valid JSON_STRING or a valid JSON_NULL
  *
@@ -198,7 +254,17 @@ extern struct json *sem_object_find_name(struct json const *node, unsigned int d
 				         char const *memname);
 extern void json_sem_zero_count(struct json_sem *sem);
 extern int json_sem_find(struct json *node, unsigned int depth, struct json_sem *sem);
+extern uint32_t json_sem_hash_key(unsigned int depth, enum item_type type, char const *name, size_t name_len,
+				  unsigned int seed);
+extern struct json_sem_hash *json_sem_hash_build(struct json_sem *sem);
+extern bool json_sem_hash_ok(struct json_sem *sem, struct json_sem_hash const *hash);
+extern void json_sem_hash_free(struct json_sem_hash *hash);
+extern int json_sem_find_hash(struct json *node, unsigned int depth, struct json_sem *sem,
+			      struct json_sem_hash const *hash);
 extern void json_sem_count_chk(struct json_sem *sem, struct dyn_array *count_err);
+extern uintmax_t json_sem_check_hash(struct json *node, unsigned int max_depth, struct json_sem *sem,
+				     struct json_sem_hash const *hash, struct dyn_array **pcount_err,
+				     struct dyn_array **pval_err, void *data);
 extern uintmax_t json_sem_check(struct json *node, unsigned int max_depth, struct json_sem *sem,
 				struct dyn_array **pcount_err, struct dyn_array **pval_err, void *data);
 extern void free_count_err(struct dyn_array *count_err);
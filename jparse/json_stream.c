@@ -0,0 +1,490 @@
+/*
+ * json_stream - JSON streaming event parser
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * jparse - JSON parser
+ */
+#include "jparse.h"
+
+/*
+ * jparse.lex.h - generated by flex
+ *
+ * NOTE: as with jparse.y, we cannot #include "jparse.lex.h" in jparse.h so we
+ *	 do it here instead.
+ */
+#include "jparse.lex.h"
+
+
+/*
+ * definitions
+ */
+#define JSON_EVENTS_STACK_CHUNK (64)	/* allocate this many open object or array frames at a time */
+
+
+/*
+ * parse states
+ */
+enum json_events_state {
+    JSON_EVENTS_VALUE	= 0,	/* expecting a JSON value */
+    JSON_EVENTS_VALUE_OR_CLOSE,	/* expecting a JSON value or ] just after [ */
+    JSON_EVENTS_NAME,		/* expecting a member name after , in an object */
+    JSON_EVENTS_NAME_OR_CLOSE,	/* expecting a member name or } just after { */
+    JSON_EVENTS_COLON,		/* expecting : after a member name */
+    JSON_EVENTS_COMMA_OR_CLOSE,	/* expecting , or the close of the current object or array */
+    JSON_EVENTS_END,		/* expecting EOF after the top level JSON value */
+};
+
+/*
+ * struct json_events_frame - an open JSON object or array
+ */
+struct json_events_frame
+{
+    enum item_type type;	/* JTYPE_OBJECT or JTYPE_ARRAY */
+    uintmax_t len;		/* number of members or values so far */
+};
+
+
+/*
+ * static functions
+ */
+static bool json_events_string_ok(char const *text, size_t len);
+
+
+/*
+ * parse_json_events - parse a JSON stream, calling event functions as we go
+ *
+ * The stream is scanned with the same scanner as parse_json_stream(), but
+ * rather than reading the entire stream into memory, the scanner refills its
+ * bounded buffer from the stream as it is needed (see YY_INPUT in jparse.l).
+ * Instead of using the bison parser to form a JSON parse tree, we check the
+ * JSON grammar with a small state machine and an explicit stack of open
+ * objects and arrays, calling the functions in events as we go.  Memory use
+ * depends on the nesting depth of the JSON, not on the size of the stream.
+ *
+ * As with parse_json_stream(), byte values in the class [\x00-\x08\x0e-\x1f]
+ * make the JSON invalid.  Because we do not read the entire stream first,
+ * such bytes are reported when they are read, which may be after some events
+ * have been called.
+ *
+ * given:
+ *
+ *	stream	    - open file stream containing a JSON document
+ *	filename    - name of file or NULL for stdin
+ *	events	    - functions to call as the JSON is scanned, or NULL
+ *	ctx	    - pointer passed to the event functions
+ *	is_valid    - non-NULL pointer to boolean to set depending on JSON validity
+ *
+ * returns:
+ *	true ==> the entire stream was scanned
+ *	false ==> an event function returned false, stopping the scan
+ *
+ * NOTE: *is_valid is set to true only if the entire stream was scanned and it
+ *	 is a valid JSON document.  If an event function stops the scan, then
+ *	 *is_valid is true only if the JSON up to that point was valid.
+ *
+ * NOTE: this function only warns on error, except for NULL is_valid, in which
+ *	 case it is an error.
+ *
+ * NOTE: the stream is closed (unless it is stdin) via clearerr_or_fclose().
+ *
+ * NOTE: a NULL events, or a NULL function in events, is ignored.  Thus
+ *	 calling this function with a NULL events simply validates the JSON.
+ */
+bool
+parse_json_events(FILE *stream, char const *filename, struct json_events const *events, void *ctx,
+		  bool *is_valid)
+{
+    struct json_extra extra;		/* scanner extra data */
+    yyscan_t scanner;			/* scanner instance: is a void * */
+    YY_BUFFER_STATE buf = NULL;		/* scanner stream buffer */
+    JPARSE_STYPE lval = NULL;		/* semantic value: not used by the scanner */
+    JPARSE_LTYPE lloc;			/* token location */
+    struct dyn_array *stack = NULL;	/* open objects and arrays */
+    struct json_events_frame frame;	/* current open object or array */
+    struct json_events_frame *top = NULL;	/* innermost open object or array or NULL */
+    enum json_events_state state = JSON_EVENTS_VALUE;	/* what we expect next */
+    unsigned int depth = 0;		/* current depth */
+    char const *text = NULL;		/* token text */
+    size_t len = 0;			/* token length */
+    bool valid = true;			/* true ==> JSON is valid so far */
+    bool stopped = false;		/* true ==> an event function stopped the scan */
+    bool done = false;			/* true ==> stop scanning */
+    bool close = false;			/* true ==> token closes the innermost object or array */
+    int token = 0;			/* token returned by the scanner */
+    int ret = 0;			/* libc function return value */
+
+    /*
+     * firewall
+     */
+    if (is_valid == NULL) {
+	err(10, __func__, "is_valid == NULL");
+	not_reached();
+    }
+    *is_valid = false;
+    if (filename == NULL) {
+	json_dbg(JSON_DBG_HIGH, __func__, "filename is NULL, forcing it to be \"-\" for stdin");
+	filename = "-";
+	stream = stdin;
+    } else if (!strcmp(filename, "-") && stream == NULL) {
+	stream = stdin;
+    }
+    if (stream == NULL) {
+	werr(11, __func__, "stream is NULL");
+	return true;
+    }
+    /* a memory stream (see fmemopen(3)) has no file descriptor to check */
+    if (stream != stdin && fileno(stream) >= 0 && fd_is_ready(__func__, false, fileno(stream)) == false) {
+	werr(12, __func__, "stream is not open");
+	return true;
+    }
+
+    /*
+     * initialise scanner
+     */
+    memset(&extra, 0, sizeof(extra));
+    extra.filename = filename;
+    extra.linenum = 1;
+    errno = 0;		/* pre-clear errno for werrp() */
+    ret = jparse_lex_init_extra(&extra, &scanner);
+    if (ret != 0) {
+	werrp(13, __func__, "jparse_lex_init_extra failed");
+	clearerr_or_fclose(stream);
+	return true;
+    }
+    jparse_set_in(stream, scanner);
+    buf = jparse__create_buffer(stream, YY_BUF_SIZE, scanner);
+    if (buf == NULL) {
+	werr(14, __func__, "unable to create scanner buffer");
+	jparse_lex_destroy(scanner);
+	clearerr_or_fclose(stream);
+	return true;
+    }
+    jparse__switch_to_buffer(buf, scanner);
+
+    /*
+     * For why we set the column to 0 but the line to 1 see the comments with
+     * the YY_USER_ACTION macro in jparse.l.
+     */
+    jparse_set_column(0, scanner);
+    jparse_set_lineno(1, scanner);
+    memset(&lloc, 0, sizeof(lloc));
+
+    /*
+     * create the stack of open objects and arrays
+     */
+    stack = dyn_array_create(sizeof(struct json_events_frame), JSON_EVENTS_STACK_CHUNK, JSON_EVENTS_STACK_CHUNK, true);
+
+    /*
+     * scan tokens until EOF, an error or an event function stops us
+     */
+    while (!done) {
+
+	token = jparse_lex(&lval, &lloc, scanner);
+	text = jparse_get_text(scanner);
+	len = (size_t)jparse_get_leng(scanner);
+	depth = (unsigned int)dyn_array_tell(stack);
+	top = depth > 0 ? dyn_array_addr(stack, struct json_events_frame, depth-1) : NULL;
+
+	switch (state) {
+
+	/*
+	 * a JSON value, or the close of an empty array
+	 */
+	case JSON_EVENTS_VALUE_OR_CLOSE:
+	    if (token == JSON_CLOSE_BRACKET) {
+		close = true;
+		break;
+	    }
+	    /*FALLTHRU*/
+	case JSON_EVENTS_VALUE:
+	    switch (token) {
+	    case JSON_OPEN_BRACE:
+		if (events != NULL && events->start_object != NULL) {
+		    stopped = !events->start_object(ctx, depth);
+		}
+		frame.type = JTYPE_OBJECT;
+		frame.len = 0;
+		(void) dyn_array_push(stack, frame);
+		state = JSON_EVENTS_NAME_OR_CLOSE;
+		break;
+	    case JSON_OPEN_BRACKET:
+		if (events != NULL && events->start_array != NULL) {
+		    stopped = !events->start_array(ctx, depth);
+		}
+		frame.type = JTYPE_ARRAY;
+		frame.len = 0;
+		(void) dyn_array_push(stack, frame);
+		state = JSON_EVENTS_VALUE_OR_CLOSE;
+		break;
+	    case JSON_STRING:
+		if (!json_events_string_ok(text, len)) {
+		    valid = false;
+		    break;
+		}
+		/*FALLTHRU*/
+	    case JSON_NUMBER:
+	    case JSON_TRUE:
+	    case JSON_FALSE:
+	    case JSON_NULL:
+		if (events != NULL && events->value != NULL) {
+		    stopped = !events->value(ctx, depth,
+					     token == JSON_STRING ? JTYPE_STRING :
+					     token == JSON_NUMBER ? JTYPE_NUMBER :
+					     token == JSON_NULL ? JTYPE_NULL : JTYPE_BOOL,
+					     text, len);
+		}
+		if (top == NULL) {
+		    state = JSON_EVENTS_END;
+		} else {
+		    ++top->len;
+		    state = JSON_EVENTS_COMMA_OR_CLOSE;
+		}
+		break;
+	    default:
+		valid = false;
+		break;
+	    }
+	    break;
+
+	/*
+	 * a member name, or the close of an empty object
+	 */
+	case JSON_EVENTS_NAME_OR_CLOSE:
+	    if (token == JSON_CLOSE_BRACE) {
+		close = true;
+		break;
+	    }
+	    /*FALLTHRU*/
+	case JSON_EVENTS_NAME:
+	    if (token == JSON_STRING && !json_events_string_ok(text, len)) {
+		valid = false;
+	    } else if (token == JSON_STRING) {
+		if (events != NULL && events->member_name != NULL) {
+		    stopped = !events->member_name(ctx, depth, text, len);
+		}
+		state = JSON_EVENTS_COLON;
+	    } else {
+		valid = false;
+	    }
+	    break;
+
+	/*
+	 * the : between a member name and its value
+	 */
+	case JSON_EVENTS_COLON:
+	    if (token == JSON_COLON) {
+		state = JSON_EVENTS_VALUE;
+	    } else {
+		valid = false;
+	    }
+	    break;
+
+	/*
+	 * a , or the close of the current object or array
+	 */
+	case JSON_EVENTS_COMMA_OR_CLOSE:
+	    if (top == NULL) {
+		valid = false;
+	    } else if (token == JSON_COMMA) {
+		state = (top->type == JTYPE_OBJECT) ? JSON_EVENTS_NAME : JSON_EVENTS_VALUE;
+	    } else if ((top->type == JTYPE_OBJECT && token == JSON_CLOSE_BRACE) ||
+		       (top->type == JTYPE_ARRAY && token == JSON_CLOSE_BRACKET)) {
+		close = true;
+	    } else {
+		valid = false;
+	    }
+	    break;
+
+	/*
+	 * EOF after the top level JSON value
+	 */
+	case JSON_EVENTS_END:
+	    if (token == JPARSE_EOF) {
+		done = true;
+	    } else {
+		valid = false;
+	    }
+	    break;
+
+	default:
+	    werr(15, __func__, "unknown parse state: %d", (int)state);
+	    valid = false;
+	    break;
+	}
+
+	/*
+	 * close the innermost object or array
+	 */
+	if (close) {
+	    close = false;
+	    (void) dyn_array_pop(stack, &frame);
+	    --depth;
+	    if (events != NULL) {
+		if (frame.type == JTYPE_OBJECT && events->end_object != NULL) {
+		    stopped = !events->end_object(ctx, depth, frame.len);
+		} else if (frame.type == JTYPE_ARRAY && events->end_array != NULL) {
+		    stopped = !events->end_array(ctx, depth, frame.len);
+		}
+	    }
+	    if (depth == 0) {
+		state = JSON_EVENTS_END;
+	    } else {
+		++dyn_array_addr(stack, struct json_events_frame, depth-1)->len;
+		state = JSON_EVENTS_COMMA_OR_CLOSE;
+	    }
+	}
+
+	/*
+	 * report a syntax error as the bison parser would
+	 */
+	if (!valid) {
+	    jparse_error(&lloc, NULL, scanner, "syntax error");
+	    done = true;
+	} else if (extra.read_error) {
+	    valid = false;
+	    done = true;
+	} else if (stopped) {
+	    json_dbg(JSON_DBG_MED, __func__, "event function stopped the scan at line %d", lloc.first_line);
+	    done = true;
+	}
+    }
+
+    /*
+     * report byte values in range of [\x00-\x08\x0e-\x1f] read so far
+     */
+    if (extra.low_bytes > 0 && extra.nul_bytes > 0) {
+	werr(16, __func__, "%zu low byte%s and %zu NUL byte%s detected: data block is NOT valid JSON",
+		extra.low_bytes, extra.low_bytes > 1 ? "s":"",
+		extra.nul_bytes, extra.nul_bytes > 1 ? "s":"");
+	valid = false;
+    } else if (extra.low_bytes > 0) {
+	werr(17, __func__, "%zu low byte%s detected: data block is NOT valid JSON",
+		extra.low_bytes, extra.low_bytes > 1 ? "s":"");
+	valid = false;
+    } else if (extra.nul_bytes > 0) {
+	werr(18, __func__, "%zu NUL byte%s detected: data block is NOT valid JSON",
+		extra.nul_bytes, extra.nul_bytes > 1 ? "s":"");
+	valid = false;
+    }
+    if (json_dbg_allowed(JSON_DBG_LOW)) {
+	json_dbg(JSON_DBG_LOW, __func__, "%s JSON after %ju byte%s", valid ? "valid" : "invalid",
+		 extra.bytes, extra.bytes == 1 ? "" : "s");
+    }
+    *is_valid = valid;
+
+    /*
+     * cleanup
+     */
+    jparse__delete_buffer(buf, scanner);
+    buf = NULL;
+    jparse_lex_destroy(scanner);
+    dyn_array_free(stack);
+    stack = NULL;
+    clearerr_or_fclose(stream);
+
+    return !stopped;
+}
+
+
+/*
+ * json_events_string_ok - determine if a JSON string token can be decoded
+ *
+ * The bison parser forms a JSON string node for each JSON string, which
+ * fails if the string cannot be decoded.  So that parse_json_events() agrees
+ * with parse_json_stream() as to what is valid JSON, we decode a JSON string
+ * that has a \-escape or a byte with the high bit set, and then discard the
+ * result.  A string without such bytes is always valid.
+ *
+ * given:
+ *	text	    JSON string token, including the enclosing double quotes
+ *	len	    length of text in bytes
+ *
+ * returns:
+ *	true ==> JSON string can be decoded
+ *	false ==> JSON string is invalid or text is NULL
+ */
+static bool
+json_events_string_ok(char const *text, size_t len)
+{
+    char *str = NULL;		/* decoded JSON string */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (text == NULL || len < 2) {
+	return false;
+    }
+
+    /*
+     * look for bytes that need decoding
+     */
+    for (i = 1; i < len-1; ++i) {
+	if (text[i] == '\\' || (text[i] & 0x80) != 0) {
+	    break;
+	}
+    }
+    if (i >= len-1) {
+	return true;
+    }
+
+    /*
+     * decode the string without the enclosing double quotes
+     */
+    str = json_decode(text+1, len-2, false, NULL);
+    if (str == NULL) {
+	return false;
+    }
+    free(str);
+    str = NULL;
+    return true;
+}
@@ -0,0 +1,112 @@
+/*
+ * json_stream - JSON streaming event parser
+ *
+ * "Because specs w/o version numbers are forced to commit to their original design flaws." :-)
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSON_STREAM_H)
+#    define  INCLUDE_JSON_STREAM_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#if defined(INTERNAL_INCLUDE)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#elif defined(INTERNAL_INCLUDE_2)
+  #include "../dbg/c_bool.h"
+  #include "../dbg/c_compat.h"
+  #include "../dbg/dbg.h"
+#else
+  #include <c_bool.h>
+  #include <c_compat.h>
+  #include <dbg.h>
+#endif
+
+/*
+ * json_parse - JSON parser support code
+ */
+#include "json_parse.h"
+
+
+/*
+ * struct json_events - callbacks for the JSON streaming event parser
+ *
+ * parse_json_events() calls these functions, in document order, as the
+ * JSON is scanned.  No JSON parse tree is formed.
+ *
+ * Each callback is given the ctx pointer that was given to parse_json_events()
+ * and the depth of the item: the top level JSON value is at depth 0, and the
+ * members of an object, as well as the values of an array, are at one more
+ * than the depth of the object or array.  The name and value of a member are
+ * at the same depth.
+ *
+ * The text given to member_name() and value() is the text as found in the
+ * JSON: a JSON string is still JSON encoded and includes the enclosing
+ * double quotes.  Use json_decode() to decode it.  The text is only valid
+ * during the callback: copy it if it is needed later.
+ *
+ * Any callback may be NULL.  A callback returns true to continue, or false
+ * to stop the parse.
+ */
+struct json_events
+{
+    bool (*start_object)(void *ctx, unsigned int depth);		/* { */
+    bool (*end_object)(void *ctx, unsigned int depth, uintmax_t len);	/* } after len members */
+    bool (*start_array)(void *ctx, unsigned int depth);		/* [ */
+    bool (*end_array)(void *ctx, unsigned int depth, uintmax_t len);	/* ] after len values */
+    bool (*member_name)(void *ctx, unsigned int depth,
+			char const *name, size_t len);			/* JSON string before a : */
+    bool (*value)(void *ctx, unsigned int depth, enum item_type type,
+		  char const *text, size_t len);			/* number, string, true, false or null */
+};
+
+
+/*
+ * external function declarations
+ */
+extern bool parse_json_events(FILE *stream, char const *filename, struct json_events const *events, void *ctx,
+			      bool *is_valid);
+
+
+#endif /* INCLUDE_JSON_STREAM_H */
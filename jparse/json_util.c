@@ -48,6 +48,7 @@
 #include <ctype.h>
 #include <unistd.h> /* for chdir(2) */
 #include <fcntl.h>  /* for open(2) */
+#include <sys/mman.h> /* for munmap(2) */
 
 /*
  * json_parse - JSON parser support code
@@ -118,6 +119,14 @@ static void fprmember(FILE *stream, struct json_member *item);
 static void fprobject(FILE *stream, struct json_object *item);
 static void fprarray(FILE *stream, struct json_array *item);
 static void fprelements(FILE *stream, struct json_elements *item);
+static void json_free_node(struct json *node, unsigned int depth, void *ctx);
+static void json_fprint_node(struct json *node, unsigned int depth, FILE *stream, int json_dbg_lvl);
+static void json_print_node(struct json *node, unsigned int depth, void *ctx);
+static bool json_walk_known(struct json const *node);
+static bool json_walk_child(struct json_walk_frame *frame, struct json **pchild);
+static void json_walk_vcallback(struct json *node, unsigned int depth, void *ctx);
+static bool object_member_indexable(struct json const *node);
+static size_t object_name_hash(char const *name, size_t len);
 
 
 /*
@@ -294,6 +303,7 @@ json_vdbg(int json_dbg_lvl, char const *name, char const *fmt, va_list ap)
     int saved_errno = 0;	/* errno at function start */
     bool allowed = false;	/* assume debug message not allowed */
     int ret;			/* libc function return code */
+    FILE *stream;		/* stderr, or the stream of set_dbg_thread_stream() */
 
     /*
      * determine if JSON debug messages are allowed
@@ -323,26 +333,27 @@ json_vdbg(int json_dbg_lvl, char const *name, char const *fmt, va_list ap)
     /*
      * print the debug message
      */
+    stream = dbg_stream(stderr);
     errno = 0;
-    ret = fprintf(stderr, "in %s(): JSON debug[%d]: ", name, json_dbg_lvl);
-    if (chk_stdio_printf_err(stderr, ret)) {
+    ret = fprintf(stream, "in %s(): JSON debug[%d]: ", name, json_dbg_lvl);
+    if (chk_stdio_printf_err(stream, ret)) {
 	warn(__func__, "fprintf returned errno: %d: (%s)", errno, strerror(errno));
     }
 
     errno = 0;
-    ret = vfprintf(stderr, fmt, ap);
-    if (chk_stdio_printf_err(stderr, ret)) {
+    ret = vfprintf(stream, fmt, ap);
+    if (chk_stdio_printf_err(stream, ret)) {
 	warn(__func__, "vfprintf returned errno: %d: (%s)", errno, strerror(errno));
     }
 
     errno = 0;
-    ret = fputc('\n', stderr);
+    ret = fputc('\n', stream);
     if (ret != '\n') {
 	warn(__func__, "fputc returned errno: %d: (%s)", errno, strerror(errno));
     }
 
     errno = 0;
-    ret = fflush(stderr);
+    ret = fflush(stream);
     if (ret < 0) {
 	warn(__func__, "fflush returned errno: %d: (%s)", errno, strerror(errno));
     }
@@ -966,7 +977,7 @@ json_get_type_str(struct json *node, bool encoded)
     switch (node->type) {
 	case JTYPE_NUMBER:
 	    {
-		struct json_number *item = &(node->item.number);
+		struct json_num *item = &(node->item.number);
 		if (item != NULL && VALID_JSON_NODE(item)) {
 		    str = item->as_str;
 		}
@@ -1170,6 +1181,31 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	return;
     }
 
+    /*
+     * case: arena node - the internals are freed by json_arena_reset()
+     */
+    if (node->arena != NULL) {
+	node->type = JTYPE_UNSET;
+	node->parent = NULL;
+	return;
+    }
+
+    /*
+     * free the JSON input that JSON strings of the tree point into
+     *
+     * NOTE: the JSON strings are freed first when the entire tree is freed
+     *	     by json_tree_free() as it frees the top node last.
+     */
+    if (node->input != NULL) {
+	if (node->input_mapped > 0) {
+	    (void) munmap(node->input, node->input_mapped);
+	    node->input_mapped = 0;
+	} else {
+	    free(node->input);
+	}
+	node->input = NULL;
+    }
+
     /*
      * free internals based in node type
      */
@@ -1181,18 +1217,24 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	/* nothing internal to zeroize */
 	break;
 
-    case JTYPE_NUMBER:	/* JSON item is number - see struct json_number */
+    case JTYPE_NUMBER:	/* JSON item is number - see struct json_num */
 	{
-	    struct json_number *item = &(node->item.number);
+	    struct json_num *item = &(node->item.number);
 
 	    /* free internal storage */
+	    if (item->conv != NULL) {
+		/* conv->as_str and conv->first are just copies of item->as_str and item->first */
+		memset(item->conv, 0, sizeof(struct json_number));
+		free(item->conv);
+		item->conv = NULL;
+	    }
 	    if (item->as_str != NULL) {
 		free(item->as_str);
 		item->as_str = NULL;
 	    }
 
 	    /* zeroize internal item storage */
-	    memset(item, 0, sizeof(struct json_number));
+	    memset(item, 0, sizeof(struct json_num));
 	    item->converted = false;
 	    item->parsed = false;
 	}
@@ -1203,14 +1245,20 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	    struct json_string *item = &(node->item.string);
 
 	    /* free internal storage */
-	    if (item->as_str != NULL) {
-		free(item->as_str);
-		item->as_str = NULL;
-	    }
 	    if (item->str != NULL) {
-		free(item->str);
+		/* str is as_str when no JSON decoding was required */
+		if (item->str != item->as_str) {
+		    free(item->str);
+		}
 		item->str = NULL;
 	    }
+	    if (item->as_str != NULL) {
+		/* a borrowed as_str points into the JSON input of the tree */
+		if (!item->borrowed) {
+		    free(item->as_str);
+		}
+		item->as_str = NULL;
+	    }
 
 	    /* zeroize internal item storage */
 	    memset(item, 0, sizeof(struct json_string));
@@ -1273,6 +1321,7 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 	    struct json_object *item = &(node->item.object);
 
 	    /* free internal storage */
+	    json_object_index_free(node);
 	    if (item->s != NULL) {
 		dyn_array_free(item->s);
 		item->s = NULL;
@@ -1343,8 +1392,9 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 /*
  * json_tree_free - free storage of a JSON parse tree
  *
- * This function uses the json_tree_walk() interface to walk
- * the JSON parse tree and free all nodes under a given node.
+ * This function uses the json_walk() interface to walk the JSON parse
+ * tree and free all nodes under a given node.  Because json_walk() keeps
+ * its own stack, deeply nested trees do not exhaust the C stack.
  *
  * given:
  *	node	    pointer to a JSON parser tree node to free
@@ -1352,8 +1402,14 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
  *			NOTE: Use JSON_INFINITE_DEPTH for infinite depth.
  *			NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
  *
- * NOTE: This function will free the internals of a JSON parser tree node.
- *	 It is up to the caller to free the top level struct json if needed.
+ * NOTE: This function will free the internals of a JSON parser tree node,
+ *	 and the nodes below it.  It is up to the caller to free the top level
+ *	 struct json if needed.
+ *
+ * NOTE: Nodes allocated from a JSON arena (see json_arena_use()) are not
+ *	 individually freed: use json_arena_reset() or json_arena_free() to
+ *	 free the entire JSON parse tree at once.  In particular, the caller
+ *	 must NOT free(3) the top level struct json of such a tree.
  *
  * NOTE: If the pointer to allocated storage == NULL,
  *	 this function does nothing.
@@ -1365,8 +1421,6 @@ vjson_free(struct json *node, unsigned int depth, va_list ap)
 void
 json_tree_free(struct json *node, unsigned int max_depth, ...)
 {
-    va_list ap;		/* variable argument list */
-
     /*
      * firewall - nothing to do for a NULL node
      */
@@ -1375,19 +1429,55 @@ json_tree_free(struct json *node, unsigned int max_depth, ...)
     }
 
     /*
-     * stdarg variable argument list setup
+     * free the JSON parse tree, nodes below a node before the node itself
      */
-    va_start(ap, max_depth);
+    json_walk(node, max_depth, 0, NULL, json_free_node, NULL);
+    return;
+}
+
+
+/*
+ * json_free_node - free a JSON parse tree node for json_tree_free()
+ *
+ * This function frees the internals of a JSON parse tree node.  When the
+ * node is below the top of the tree, the node itself is also freed.
+ *
+ * given:
+ *	node	pointer to a JSON parser tree node to free
+ *	depth	current tree depth (0 ==> top of tree)
+ *	ctx	unused json_walk() context
+ *
+ * NOTE: Because json_tree_free() calls this function after json_walk()
+ *	 has walked the nodes below this node, they have already been freed.
+ *
+ * NOTE: This function does nothing if node == NULL.
+ */
+static void
+json_free_node(struct json *node, unsigned int depth, void *ctx)
+{
+    bool arena_node = false;	/* true ==> node was allocated from a JSON arena */
+
+    UNUSED_ARG(ctx);
 
     /*
-     * free the JSON parse tree
+     * firewall - nothing to do for a NULL node
      */
-    vjson_tree_walk(node, max_depth, 0, true, vjson_free, ap);
+    if (node == NULL) {
+	return;
+    }
+    arena_node = (node->arena != NULL);
 
     /*
-     * stdarg variable argument list cleanup
+     * free the node internals
      */
-    va_end(ap);
+    json_free(node, depth);
+
+    /*
+     * free the node unless it is the top of the tree or in an arena
+     */
+    if (depth > 0 && !arena_node) {
+	free(node);
+    }
     return;
 }
 
@@ -2090,7 +2180,6 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
 {
     FILE *stream = NULL;	/* stream to print on */
     int json_dbg_lvl = JSON_DBG_DEFAULT;	/* JSON debug level */
-    char const *tname = NULL;	/* name of the node type */
     va_list ap2;		/* copy of va_list ap */
 
     /*
@@ -2109,11 +2198,47 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
      * obtain the stream and json_dbg_lvl args
      */
     stream = va_arg(ap2, FILE *);
-    if (stream == NULL) {
-	va_end(ap2); /* stdarg variable argument list cleanup */
+    json_dbg_lvl = va_arg(ap2, int);
+
+    /*
+     * stdarg variable argument list cleanup
+     */
+    va_end(ap2);
+
+    /*
+     * print the node
+     */
+    json_fprint_node(node, depth, stream, json_dbg_lvl);
+    return;
+}
+
+
+/*
+ * json_fprint_node - print a line about a JSON parse tree node
+ *
+ * This function does the work of vjson_fprint() and json_tree_print().
+ *
+ * given:
+ *	node	    pointer to a JSON parser tree node to print
+ *	depth	    current tree depth (0 ==> top of tree)
+ *	stream	    stream to print on
+ *	json_dbg_lvl   print message if JSON_DBG_FORCED
+ *		       OR if <= json_verbosity_level
+ *
+ * NOTE: This function does nothing if node == NULL or stream == NULL.
+ */
+static void
+json_fprint_node(struct json *node, unsigned int depth, FILE *stream, int json_dbg_lvl)
+{
+    char const *tname = NULL;	/* name of the node type */
+    struct json_number *number = NULL;	/* converted JSON number if node is a JTYPE_NUMBER */
+
+    /*
+     * firewall - nothing to do for a NULL node or stream
+     */
+    if (node == NULL || stream == NULL) {
 	return;
     }
-    json_dbg_lvl = va_arg(ap2, int);
 
     /*
      * check if JSON debug output is allowed
@@ -2121,10 +2246,19 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
     if (!dbg_output_allowed || (json_dbg_lvl != JSON_DBG_FORCED &&
         json_dbg_lvl > json_verbosity_level)) {
 	/* tree output disabled by json_verbosity_level */
-	va_end(ap2); /* stdarg variable argument list cleanup */
 	return;
     }
 
+    /*
+     * convert a JSON number, if not already done, so we can print its details
+     *
+     * NOTE: this is done before the debug header is printed as the conversion
+     *	     may print JSON debug messages of its own.
+     */
+    if (node->type == JTYPE_NUMBER) {
+	number = json_number_conv(node);
+    }
+
     /*
      * print debug header
      */
@@ -2140,7 +2274,6 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
     tname = json_item_type_name(node);
     if (tname == NULL) {
 	warn(__func__, "json_item_type_name returned NULL");
-	va_end(ap2); /* stdarg variable argument list cleanup */
 	return;
     }
     fprint(stream, "lvl: %u\ttype: %s", depth, tname);
@@ -2154,9 +2287,14 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
 	fprint(stream, "\tWarning: JTYPE_UNSET: %s", json_type_name(node->type));
 	break;
 
-    case JTYPE_NUMBER:	/* JSON item is number - see struct json_number */
+    case JTYPE_NUMBER:	/* JSON item is number - see struct json_num */
 	{
-	    struct json_number *item = &(node->item.number);
+	    struct json_number *item = number;	/* converted above */
+
+	    if (item == NULL) {
+		fprint(stream, "\tWarning: JTYPE_NUMBER: %s: no conversion", json_type_name(node->type));
+		break;
+	    }
 
 	    /*
 	     * case: converted number
@@ -2245,10 +2383,24 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
      */
     fprstr(stream, "\n");
 
-    /*
-     * stdarg variable argument list cleanup
-     */
-    va_end(ap2);
+    return;
+}
+
+
+/*
+ * json_print_node - print a line about a JSON parse tree node for json_tree_print()
+ *
+ * given:
+ *	node	    pointer to a JSON parser tree node to print
+ *	depth	    current tree depth (0 ==> top of tree)
+ *	ctx	    pointer to the struct json_print_ctx of the stream and JSON debug level
+ */
+static void
+json_print_node(struct json *node, unsigned int depth, void *ctx)
+{
+    struct json_print_ctx *print = (struct json_print_ctx *)ctx;	/* stream and JSON debug level */
+
+    json_fprint_node(node, depth, print->stream, print->json_dbg_lvl);
     return;
 }
 
@@ -2256,7 +2408,7 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
 /*
  * json_tree_print - print lines for an entire JSON parse tree.
  *
- * This function uses the json_tree_walk() interface to walk
+ * This function uses the json_walk() interface to walk
  * the JSON parse tree and print lines about all tree nodes.
  *
  * If dbg_output_allowed == false, this function will not print.
@@ -2293,13 +2445,14 @@ vjson_fprint(struct json *node, unsigned int depth, va_list ap)
  *
  * NOTE: This function does nothing if the node type is invalid.
  *
- * NOTE: this function is a wrapper to vjson_tree_walk() with the callback
- * vjson_fprint().
+ * NOTE: this function is a wrapper to json_walk() that prints each node
+ * as vjson_fprint() does.
  */
 void
 json_tree_print(struct json *node, unsigned int max_depth, ...)
 {
     va_list ap;		/* variable argument list */
+    struct json_print_ctx print;	/* stream and JSON debug level */
 
     /*
      * firewall - nothing to do for a NULL node
@@ -2309,19 +2462,28 @@ json_tree_print(struct json *node, unsigned int max_depth, ...)
     }
 
     /*
-     * stdarg variable argument list setup
+     * obtain the stream and json_dbg_lvl args
      */
     va_start(ap, max_depth);
+    print.stream = va_arg(ap, FILE *);
+    print.json_dbg_lvl = va_arg(ap, int);
+    va_end(ap); /* stdarg variable argument list cleanup */
+    if (print.stream == NULL) {
+	return;
+    }
 
     /*
-     * print the JSON parse tree
+     * nothing to walk if JSON debug output is not allowed
      */
-    vjson_tree_walk(node, max_depth, 0, true, vjson_fprint, ap);
+    if (!dbg_output_allowed || (print.json_dbg_lvl != JSON_DBG_FORCED &&
+	print.json_dbg_lvl > json_verbosity_level)) {
+	return;
+    }
 
     /*
-     * stdarg variable argument list cleanup
+     * print the JSON parse tree
      */
-    va_end(ap);
+    json_walk(node, max_depth, 0, NULL, json_print_node, &print);
     return;
 }
 
@@ -2410,6 +2572,264 @@ json_dbg_tree_print(int json_dbg_lvl, char const *name, struct json *tree, unsig
 }
 
 
+/*
+ * json_walk_known - determine if a JSON parse tree node has a known type
+ *
+ * given:
+ *	node	    JSON parse tree node
+ *
+ * returns:
+ *	true ==> node type is a known JSON type
+ *	false ==> node type is unknown
+ */
+static bool
+json_walk_known(struct json const *node)
+{
+    switch (node->type) {
+    case JTYPE_UNSET:
+    case JTYPE_NUMBER:
+    case JTYPE_STRING:
+    case JTYPE_BOOL:
+    case JTYPE_NULL:
+    case JTYPE_MEMBER:
+    case JTYPE_OBJECT:
+    case JTYPE_ARRAY:
+    case JTYPE_ELEMENTS:
+	return true;
+    default:
+	return false;
+    }
+}
+
+
+/*
+ * json_walk_child - return the next child of a JSON parse tree node to walk
+ *
+ * given:
+ *	frame	    walk stack frame of the JSON parse tree node
+ *	pchild	    where to store the child, which may be NULL
+ *
+ * returns:
+ *	true ==> *pchild is the next child of the node, and frame->next was advanced
+ *	false ==> the node has no more children
+ */
+static bool
+json_walk_child(struct json_walk_frame *frame, struct json **pchild)
+{
+    struct json *node = frame->node;	/* JSON parse tree node */
+    struct json **set = NULL;		/* children of node */
+    intmax_t len = 0;			/* number of children of node */
+
+    /*
+     * find the children of the node
+     */
+    switch (node->type) {
+    case JTYPE_MEMBER:	/* JSON item is a member: name (left branch) then value (right branch) */
+	if (frame->next == 0) {
+	    ++frame->next;
+	    *pchild = node->item.member.name;
+	    return true;
+	} else if (frame->next == 1) {
+	    ++frame->next;
+	    *pchild = node->item.member.value;
+	    return true;
+	}
+	return false;
+
+    case JTYPE_OBJECT:	/* JSON item is a { members } */
+	set = node->item.object.set;
+	len = node->item.object.len;
+	break;
+
+    case JTYPE_ARRAY:	/* JSON item is a [ elements ] */
+	set = node->item.array.set;
+	len = node->item.array.len;
+	break;
+
+    case JTYPE_ELEMENTS:	/* JSON items is zero or more JSON values */
+	set = node->item.elements.set;
+	len = node->item.elements.len;
+	break;
+
+    default:		/* terminal JSON tree leaf node */
+	return false;
+    }
+
+    /*
+     * return the next child in order
+     */
+    if (set == NULL || frame->next >= len) {
+	return false;
+    }
+    *pchild = set[frame->next++];
+    return true;
+}
+
+
+/*
+ * json_walk - walk a JSON parse tree calling functions before and after each node
+ *
+ * Walk a JSON parse tree, depth-first, calling pre() on a node before the
+ * nodes below it are walked (pre-order, NLR), and post() on a node after the
+ * nodes below it are walked (post-order, LRN).  See:
+ *
+ *	https://en.wikipedia.org/wiki/Tree_traversal#Depth-first_search
+ *
+ * Unlike vjson_tree_walk(), which it replaces, this function does not recurse:
+ * nodes between the top of the tree and the node being walked are kept on a
+ * dynamic array stack, so that the depth of a JSON parse tree is limited only
+ * by memory.  The functions are passed a pointer to a context of the caller's
+ * choosing instead of a va_list.
+ *
+ * Example use - count the nodes of a JSON parse tree
+ *
+ *	static void
+ *	count_node(struct json *node, unsigned int depth, void *ctx)
+ *	{
+ *	    ++*(uintmax_t *)ctx;
+ *	}
+ *	...
+ *	uintmax_t count = 0;
+ *	json_walk(tree, JSON_INFINITE_DEPTH, 0, count_node, NULL, &count);
+ *
+ * given:
+ *	node	    pointer to a JSON parse tree
+ *	max_depth   maximum tree depth to descend, or 0 ==> infinite depth
+ *			NOTE: Use JSON_INFINITE_DEPTH for infinite depth
+ *			NOTE: Consider use of JSON_DEFAULT_MAX_DEPTH for good default.
+ *	depth	    tree depth of node (0 ==> top of tree)
+ *	pre	    function to call on a node before the nodes below it, or NULL
+ *	post	    function to call on a node after the nodes below it, or NULL
+ *	ctx	    context passed to pre() and post(), may be NULL
+ *
+ * If the tree depth of a node > max_depth, then pre() and post() are NOT called
+ * on the node, and the walk does NOT descend any further below the node.
+ *
+ * NOTE: post() may free the node it is given, as the walk never returns to it.
+ *
+ * NOTE: This function warns but does not do anything if node is NULL,
+ *	 or if both pre and post are NULL.
+ */
+void
+json_walk(struct json *node, unsigned int max_depth, unsigned int depth,
+	  void (*pre)(struct json *, unsigned int, void *),
+	  void (*post)(struct json *, unsigned int, void *), void *ctx)
+{
+    struct dyn_array *stack = NULL;	/* stack of nodes being walked */
+    struct json_walk_frame frame;	/* walk stack frame */
+    struct json_walk_frame *top = NULL;	/* walk stack frame at the top of the stack */
+    struct json *child = NULL;		/* next child of the node at the top of the stack */
+    intmax_t len = 0;			/* number of walk stack frames */
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	warn(__func__, "node is NULL");
+	return;
+    }
+    if (pre == NULL && post == NULL) {
+	warn(__func__, "pre and post are NULL");
+	return;
+    }
+
+    /*
+     * do nothing if we are too deep
+     */
+    if (max_depth != JSON_INFINITE_DEPTH && depth > max_depth) {
+	warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", depth, max_depth);
+	return;
+    }
+
+    if (json_walk_known(node) == false) {
+	warn(__func__, "node type is unknown: %d", node->type);
+	return;
+    }
+
+    /*
+     * start the walk stack with the top node
+     */
+    stack = dyn_array_create(sizeof(struct json_walk_frame), JSON_CHUNK, JSON_CHUNK, false);
+    if (stack == NULL) {
+	warn(__func__, "dyn_array_create() returned NULL");
+	return;
+    }
+    frame.node = node;
+    frame.depth = depth;
+    frame.next = 0;
+    (void) dyn_array_append_value(stack, &frame);
+    if (pre != NULL) {
+	(*pre)(node, depth, ctx);
+    }
+
+    /*
+     * walk until the stack is empty
+     */
+    while ((len = dyn_array_tell(stack)) > 0) {
+	top = dyn_array_addr(stack, struct json_walk_frame, len-1);
+
+	/*
+	 * case: all nodes below the node at the top of the stack have been walked
+	 */
+	if (json_walk_child(top, &child) == false) {
+	    frame = *top;
+	    (void) dyn_array_pop(stack, NULL);
+	    if (post != NULL) {
+		(*post)(frame.node, frame.depth, ctx);
+	    }
+	    continue;
+	}
+
+	/*
+	 * case: descend to the next child
+	 */
+	if (child == NULL) {
+	    warn(__func__, "node is NULL");
+	    continue;
+	}
+	if (max_depth != JSON_INFINITE_DEPTH && top->depth+1 > max_depth) {
+	    warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", top->depth+1, max_depth);
+	    continue;
+	}
+	if (json_walk_known(child) == false) {
+	    warn(__func__, "node type is unknown: %d", child->type);
+	    continue;
+	}
+	frame.node = child;
+	frame.depth = top->depth+1;
+	frame.next = 0;
+	(void) dyn_array_append_value(stack, &frame);
+	if (pre != NULL) {
+	    (*pre)(child, frame.depth, ctx);
+	}
+    }
+
+    /*
+     * free the walk stack
+     */
+    dyn_array_free(stack);
+    return;
+}
+
+
+/*
+ * json_walk_vcallback - call a va_list form function on a JSON parse tree node for json_walk()
+ *
+ * given:
+ *	node	    JSON parse tree node
+ *	depth	    tree depth of node (0 ==> top of tree)
+ *	ctx	    pointer to the struct json_walk_va of the function and its va_list
+ */
+static void
+json_walk_vcallback(struct json *node, unsigned int depth, void *ctx)
+{
+    struct json_walk_va *va = (struct json_walk_va *)ctx;	/* va_list form function and its args */
+
+    (*(va->vcallback))(node, depth, va->ap);
+    return;
+}
+
+
 /*
  * json_tree_walk - walk a JSON parse tree calling a function on each node
  *
@@ -2520,13 +2940,15 @@ json_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bo
  * In this case it will NOT operate on the node, or will be descend and further
  * into the tree.
  *
+ * NOTE: This function is a wrapper to json_walk(), so it does not recurse.
+ *
  * NOTE: This function warns but does not do anything if an arg is NULL.
  */
 void
 vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 		void (*vcallback)(struct json *, unsigned int, va_list), va_list ap)
 {
-    int i;
+    struct json_walk_va va;	/* va_list form function and its args */
 
     /*
      * firewall
@@ -2541,137 +2963,321 @@ vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, b
     }
 
     /*
-     * do nothing if we are too deep
+     * walk the tree, calling vcallback before or after the nodes below each node
      */
-    if (max_depth != JSON_INFINITE_DEPTH && depth > max_depth) {
-	warn(__func__, "tree walk descent stopped, tree depth: %u > max_depth: %u", depth, max_depth);
-	return;
+    va.vcallback = vcallback;
+    va_copy(va.ap, ap);
+    if (post_order == true) {
+	json_walk(node, max_depth, depth, NULL, json_walk_vcallback, &va);
+    } else {
+	json_walk(node, max_depth, depth, json_walk_vcallback, NULL, &va);
     }
+    va_end(va.ap); /* stdarg variable argument list cleanup */
+    return;
+}
+
+
+/*
+ * object_member_indexable - determine if a JSON object member may be indexed by name
+ *
+ * given:
+ *	node	JSON parse tree node of a JSON object member
+ *
+ * returns:
+ *	true ==> node is a converted JTYPE_MEMBER with a converted JTYPE_STRING name
+ *	false ==> node may not be indexed by name
+ */
+static bool
+object_member_indexable(struct json const *node)
+{
+    struct json_member const *item = NULL;	/* JSON member */
+    struct json_string const *name = NULL;	/* JSON member name */
 
     /*
-     * walk based on type of node
+     * firewall
      */
-    switch (node->type) {
+    if (node == NULL || node->type != JTYPE_MEMBER) {
+	return false;
+    }
 
-    case JTYPE_UNSET:	/* JSON item has not been set - must be the value 0 */
-    case JTYPE_NUMBER:	/* JSON item is number - see struct json_number */
-    case JTYPE_STRING:	/* JSON item is a string - see struct json_string */
-    case JTYPE_BOOL:	/* JSON item is a boolean - see struct json_boolean */
-    case JTYPE_NULL:	/* JSON item is a null - see struct json_null */
+    /*
+     * check the JSON member
+     */
+    item = &(node->item.member);
+    if (!CONVERTED_PARSED_JSON_NODE(item) || item->name_as_str == NULL || item->name_str == NULL ||
+	item->name == NULL || item->value == NULL || item->name->type != JTYPE_STRING) {
+	return false;
+    }
 
-	/* case: terminal JSON tree leaf node */
-	/* perform function operation on this terminal parse tree node */
-	(*vcallback)(node, depth, ap);
-	break;
+    /*
+     * check the JSON member name
+     */
+    name = &(item->name->item.string);
+    if (!CONVERTED_PARSED_JSON_NODE(name) || name->as_str == NULL || name->str == NULL) {
+	return false;
+    }
+    return true;
+}
 
-    case JTYPE_MEMBER:	/* JSON item is a member */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
 
-	/* descend the tree */
-	{
-	    struct json_member *item = &(node->item.member);
+/*
+ * object_name_hash - hash a decoded JSON member name
+ *
+ * given:
+ *	name	decoded JSON member name
+ *	len	length of name in bytes
+ *
+ * returns:
+ *	FNV-1a hash of name
+ */
+static size_t
+object_name_hash(char const *name, size_t len)
+{
+    uint64_t h = 14695981039346656037ULL;	/* FNV-1a 64 bit offset basis */
+    size_t i;
 
-	    /* perform function operation on JSON member name (left branch) node */
-	    vjson_tree_walk(item->name, max_depth, depth+1, post_order, vcallback, ap);
+    for (i=0; i < len; ++i) {
+	h ^= (uint8_t)name[i];
+	h *= 1099511628211ULL;
+    }
+    return (size_t)(h ^ (h >> 32));
+}
 
-	    /* perform function operation on JSON member value (right branch) node */
-	    vjson_tree_walk(item->value, max_depth, depth+1, post_order, vcallback, ap);
-	}
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
-	}
-	break;
+/*
+ * json_object_index - return the member name index of a JSON object, forming it if needed
+ *
+ * The index is formed the first time it is needed, and again if members were
+ * added to the JSON object since it was formed.  Members that are not valid
+ * JTYPE_MEMBER nodes are not indexed.
+ *
+ * given:
+ *	node	JSON parse tree node of type JTYPE_OBJECT
+ *
+ * returns:
+ *	member name index of the JSON object,
+ *	    or NULL ==> node is not a converted JTYPE_OBJECT, or out of memory
+ *
+ * NOTE: The index is owned by the JSON object: it is freed along with the
+ *	 JSON object, or when the JSON arena the JSON object is in is reset.
+ *
+ * NOTE: Because the index is formed by the first lookup, two threads must not
+ *	 look up members of the same JSON object by name at the same time unless
+ *	 the index was already formed.
+ */
+struct json_object_index *
+json_object_index(struct json *node)
+{
+    struct json_object *item = NULL;		/* JSON object */
+    struct json_object_index *index = NULL;	/* member name index */
+    struct json_string const *name = NULL;	/* decoded name of member being indexed */
+    size_t nslots = 8;				/* number of slots, a power of 2 */
+    size_t size = 0;				/* size of the index and its slots */
+    size_t h;					/* slot being probed */
+    intmax_t j;					/* set[] index of member in slot being probed */
+    intmax_t i;
 
-    case JTYPE_OBJECT:	/* JSON item is a { members } */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
+    /*
+     * firewall
+     */
+    if (node == NULL || node->type != JTYPE_OBJECT) {
+	return NULL;
+    }
+    item = &(node->item.object);
+    if (!CONVERTED_PARSED_JSON_NODE(item) || item->len < 0 || (item->len > 0 && item->set == NULL)) {
+	return NULL;
+    }
 
-	/* descend the tree */
-	{
-	    struct json_object *item = &(node->item.object);
+    /*
+     * case: index is current
+     */
+    if (item->index != NULL && item->index->len == item->len) {
+	return item->index;
+    }
+    json_object_index_free(node);
 
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
-	    }
+    /*
+     * allocate at least twice as many slots as members
+     */
+    while (nslots / 2 < (size_t)item->len) {
+	if (nslots > (SIZE_MAX - sizeof(*index)) / sizeof(intmax_t) / 2) {
+	    warn(__func__, "JSON object has too many members to index: %jd", item->len);
+	    return NULL;
 	}
+	nslots <<= 1;
+    }
+    size = sizeof(*index) + nslots * sizeof(intmax_t);
+    if (node->arena != NULL) {
+	index = json_arena_alloc(node->arena, size);
+    } else {
+	index = calloc(1, size);
+    }
+    if (index == NULL) {
+	warn(__func__, "cannot allocate index for JSON object of %jd members", item->len);
+	return NULL;
+    }
+    index->len = item->len;
+    index->bad = item->len;
+    index->nul_name = false;
+    index->mask = nslots - 1;
+    index->slot = (intmax_t *)(index + 1);
+    for (h=0; h < nslots; ++h) {
+	index->slot[h] = -1;
+    }
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
+    /*
+     * index the first member with each name
+     */
+    for (i=0; i < item->len; ++i) {
+	if (!object_member_indexable(item->set[i])) {
+	    if (index->bad == item->len) {
+		index->bad = i;
+	    }
+	    continue;
 	}
-	break;
-
-    case JTYPE_ARRAY:	/* JSON item is a [ elements ] */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
+	name = &(item->set[i]->item.member.name->item.string);
+	if (memchr(name->str, '\0', name->str_len) != NULL) {
+	    index->nul_name = true;
 	}
+	for (h = object_name_hash(name->str, name->str_len) & index->mask; index->slot[h] >= 0; h = (h+1) & index->mask) {
+	    struct json_string const *other = NULL;	/* name of member in slot */
 
-	/* descend the tree */
-	{
-	    struct json_array *item = &(node->item.array);
-
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
+	    j = index->slot[h];
+	    other = &(item->set[j]->item.member.name->item.string);
+	    if (other->str_len == name->str_len && memcmp(other->str, name->str, name->str_len) == 0) {
+		break;	/* not the first member with this name */
 	    }
 	}
-
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
+	if (index->slot[h] < 0) {
+	    index->slot[h] = i;
 	}
-	break;
+    }
 
-    case JTYPE_ELEMENTS:	/* JSON items is zero or more JSON values */
-	/* case: pre-order (NLR) */
-	if (post_order == false) {
-	    (*vcallback)(node, depth, ap);
-	}
+    /*
+     * the JSON object owns the index
+     */
+    item->index = index;
+    return index;
+}
 
-	/* descend the tree */
-	{
-	    struct json_elements *item = &(node->item.elements);
 
-	    /* perform function operation on each object member in order */
-	    if (item->set != NULL) {
-		for (i=0; i < item->len; ++i) {
-		    vjson_tree_walk(item->set[i], max_depth, depth+1, post_order, vcallback, ap);
-		}
-	    }
-	}
+/*
+ * json_object_index_free - free the member name index of a JSON object
+ *
+ * given:
+ *	node	JSON parse tree node of type JTYPE_OBJECT
+ *
+ * NOTE: This function does nothing if node is NULL, is not a JTYPE_OBJECT,
+ *	 or has no member name index.
+ *
+ * NOTE: An index in a JSON arena is freed by json_arena_reset().
+ */
+void
+json_object_index_free(struct json *node)
+{
+    struct json_object *item = NULL;		/* JSON object */
 
-	/* finally perform function operation on the parent node */
-	/* case: post-order (LRN) */
-	if (post_order == true) {
-	    (*vcallback)(node, depth, ap);
-	}
-	break;
+    /*
+     * firewall
+     */
+    if (node == NULL || node->type != JTYPE_OBJECT) {
+	return;
+    }
+    item = &(node->item.object);
+    if (item->index == NULL) {
+	return;
+    }
 
-    default:
-	warn(__func__, "node type is unknown: %d", node->type);
-	/* nothing we can traverse */
-	break;
+    /*
+     * free the index unless it is in a JSON arena
+     */
+    if (node->arena == NULL) {
+	free(item->index);
     }
+    item->index = NULL;
     return;
 }
 
 
+/*
+ * json_object_find - find the first member of a JSON object with a given name
+ *
+ * given:
+ *	node	JSON parse tree node of type JTYPE_OBJECT
+ *	name	decoded member name to find
+ *	len	length of name in bytes
+ *
+ * returns:
+ *	>= 0 ==> set[] index of first JTYPE_MEMBER with the given name
+ *	-1 ==> no JTYPE_MEMBER with the given name
+ *	< -1 ==> NULL name, or node is not a converted JTYPE_OBJECT, or out of memory
+ *
+ * NOTE: The member name index of the JSON object is formed if needed.
+ */
+intmax_t
+json_object_find(struct json *node, char const *name, size_t len)
+{
+    struct json_object_index *index = NULL;	/* member name index */
+    struct json **set = NULL;			/* JSON object members */
+    struct json_string const *other = NULL;	/* name of member in slot */
+    size_t h;					/* slot being probed */
+    intmax_t j;					/* set[] index of member in slot being probed */
+
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	return -2;
+    }
+    index = json_object_index(node);
+    if (index == NULL) {
+	return -3;
+    }
+
+    /*
+     * probe the index
+     */
+    set = node->item.object.set;
+    for (h = object_name_hash(name, len) & index->mask; index->slot[h] >= 0; h = (h+1) & index->mask) {
+	j = index->slot[h];
+	other = &(set[j]->item.member.name->item.string);
+	if (other->str_len == len && memcmp(other->str, name, len) == 0) {
+	    return j;
+	}
+    }
+    return -1;
+}
+
+
+/*
+ * json_object_get - return the first member of a JSON object with a given name
+ *
+ * Unlike searching set[] of the JSON object, this takes about the same time
+ * no matter how many members the JSON object has.
+ *
+ * given:
+ *	node	JSON parse tree node of type JTYPE_OBJECT
+ *	name	decoded member name to find
+ *	len	length of name in bytes
+ *
+ * returns:
+ *	JTYPE_MEMBER with the given name, or NULL ==> no such member or error
+ *
+ * NOTE: The value of the member is node->item.member.value of the returned node.
+ */
+struct json *
+json_object_get(struct json *node, char const *name, size_t len)
+{
+    intmax_t i;		/* set[] index of member */
+
+    i = json_object_find(node, name, len);
+    if (i < 0) {
+	return NULL;
+    }
+    return node->item.object.set[i];
+}
+
+
 /*
  * json_util_parse_number_range	- parse a number ranges
  *
@@ -168,6 +168,38 @@ struct json_util_number
 /* End WARNING from above */
 
 
+/*
+ * JSON parse tree walk stack frame
+ *
+ * json_walk() keeps one of these on its stack for each node between the
+ * top of the tree and the node being walked.
+ */
+struct json_walk_frame
+{
+    struct json *node;		/* JSON parse tree node */
+    unsigned int depth;		/* depth of node in the JSON parse tree */
+    intmax_t next;		/* index of the next child of node to walk */
+};
+
+/*
+ * va_list form function and its args for json_tree_walk() and vjson_tree_walk()
+ */
+struct json_walk_va
+{
+    void (*vcallback)(struct json *, unsigned int, va_list);	/* function to call on each node */
+    va_list ap;			/* variable argument list for vcallback */
+};
+
+/*
+ * stream and JSON debug level for json_tree_print()
+ */
+struct json_print_ctx
+{
+    FILE *stream;		/* stream to print on */
+    int json_dbg_lvl;		/* print if JSON_DBG_FORCED OR if <= json_verbosity_level */
+};
+
+
 /*
  * global variables
  */
@@ -204,10 +236,17 @@ extern void vjson_fprint(struct json *node, unsigned int depth, va_list ap);
 extern void json_tree_print(struct json *node, unsigned int max_depth, ...);
 extern void json_dbg_tree_print(int json_dbg_lvl, char const *name, struct json *tree, unsigned int max_depth);
 extern void json_tree_free(struct json *node, unsigned int max_depth, ...);
+extern void json_walk(struct json *node, unsigned int max_depth, unsigned int depth,
+		      void (*pre)(struct json *, unsigned int, void *),
+		      void (*post)(struct json *, unsigned int, void *), void *ctx);
 extern void json_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 			   void (*vcallback)(struct json *, unsigned int, va_list), ...);
 extern void vjson_tree_walk(struct json *node, unsigned int max_depth, unsigned int depth, bool post_order,
 			    void (*vcallback)(struct json *, unsigned int, va_list), va_list ap);
+extern struct json_object_index *json_object_index(struct json *node);
+extern void json_object_index_free(struct json *node);
+extern intmax_t json_object_find(struct json *node, char const *name, size_t len);
+extern struct json *json_object_get(struct json *node, char const *name, size_t len);
 
 /* WARNING: the below functions are VERY subject to change, if they are not deleted */
 bool json_util_parse_number_range(const char *option, char *optarg, bool allow_negative, struct json_util_number *number);
@@ -0,0 +1,618 @@
+/*
+ * jarena_bench - compare JSON parse tree allocation by node and by arena
+ *
+ * This tool parses a corpus of JSON files many times, once with each
+ * JSON parse tree node allocated by calloc(3) and freed by json_tree_free(),
+ * and once with the JSON parse trees allocated from a JSON arena and freed
+ * by json_arena_reset().  Each method is run in its own child process so
+ * that the peak resident set size of each method may be compared.
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <locale.h>
+#include <dirent.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/*
+ * jarena_bench - compare JSON parse tree allocation by node and by arena
+ */
+#include "jarena_bench.h"
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (1)	/* number of required arguments on the command line */
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] [-r repeat] [-m mode] path ...\n"
+    "\n"
+    "\t-h\t\tprint help message and exit\n"
+    "\t-v level\tset verbosity level (def level: %d)\n"
+    "\t-J level\tset JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tprint version strings and exit\n"
+    "\t-r repeat\tparse the corpus repeat times (def: %d)\n"
+    "\t-m mode\t\tnode ==> calloc each node, arena ==> use a JSON arena, both ==> both (def: both)\n"
+    "\n"
+    "\tpath\t\tJSON file, or directory of *.json files, to add to the corpus\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tall is OK\n"
+    "\t1\t\ta corpus file is not valid JSON\n"
+    "\t2\t\t-h and help string printed or -V and version strings printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "%s version: %s\n"
+    "jparse utils version: %s\n"
+    "jparse UTF-8 version: %s\n"
+    "jparse library version: %s";
+
+
+/*
+ * static variables
+ */
+static struct dyn_array *corpus = NULL;		/* corpus of JSON files (struct jarena_file) */
+static uintmax_t corpus_bytes = 0;		/* total bytes in the corpus */
+
+
+/*
+ * forward declarations
+ */
+static void add_file(char const *path);
+static void add_path(char const *path);
+static int cmp_file(const void *a, const void *b);
+static int run_bench(char const *program, bool use_arena, intmax_t repeat);
+static void bench(bool use_arena, intmax_t repeat) __attribute__((noreturn));
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;	/* our name */
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    int arg_count = 0;		/* number of args to process */
+    intmax_t repeat = JARENA_BENCH_REPEAT;	/* number of times to parse the corpus */
+    bool node_mode = true;	/* true ==> benchmark calloc(3) allocated nodes */
+    bool arena_mode = true;	/* true ==> benchmark JSON arena allocated nodes */
+    bool opt_error = false;	/* fchk_inval_opt() return */
+    int exit_code = 0;		/* our exit code */
+    int i;
+
+    /*
+     * use default locale based on LANG
+     */
+    (void) setlocale(LC_ALL, "");
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:Vr:m:")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    /*
+	     * parse verbosity
+	     */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    /*
+	     * parse JSON verbosity
+	     */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version strings and exit */
+	    print("jarena_bench version %s\n", JARENA_BENCH_VERSION);
+	    print("jparse utils version: %s\n", JPARSE_UTILS_VERSION);
+	    print("jparse UTF-8 version: %s\n", JPARSE_UTF8_VERSION);
+	    print("jparse library version: %s\n", JPARSE_LIBRARY_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'r':		/* -r repeat */
+	    if (!string_to_intmax(optarg, &repeat) || repeat <= 0) {
+		usage(3, program, "invalid -r repeat"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'm':		/* -m mode */
+	    if (strcmp(optarg, "node") == 0) {
+		node_mode = true;
+		arena_mode = false;
+	    } else if (strcmp(optarg, "arena") == 0) {
+		node_mode = false;
+		arena_mode = true;
+	    } else if (strcmp(optarg, "both") == 0) {
+		node_mode = true;
+		arena_mode = true;
+	    } else {
+		usage(3, program, "invalid -m mode"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    opt_error = fchk_inval_opt(stderr, program, i, optopt);
+	    if (opt_error) {
+		usage(3, program, ""); /*ooo*/
+		not_reached();
+	    } else {
+		fwarn(stderr, __func__, "getopt() return: %c optopt: %c", (char)i, (char)optopt);
+	    }
+	    break;
+	}
+    }
+    arg_count = argc - optind;
+    if (arg_count < REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * read the corpus into memory
+     */
+    corpus = dyn_array_create(sizeof(struct jarena_file), JSON_CHUNK, JSON_CHUNK, true);
+    if (corpus == NULL) {
+	err(10, __func__, "dyn_array_create() returned NULL");
+	not_reached();
+    }
+    for (i = optind; i < argc; ++i) {
+	add_path(argv[i]);
+    }
+    if (dyn_array_tell(corpus) <= 0) {
+	err(3, __func__, "no JSON files found"); /*ooo*/
+	not_reached();
+    }
+    dyn_array_qsort(corpus, cmp_file);
+    dbg(DBG_LOW, "corpus: %jd files, %ju bytes, repeated %jd times",
+		 dyn_array_tell(corpus), corpus_bytes, repeat);
+
+    /*
+     * run each benchmark in its own child process
+     */
+    if (node_mode && run_bench(program, false, repeat) != 0) {
+	exit_code = 1;
+    }
+    if (arena_mode && run_bench(program, true, repeat) != 0) {
+	exit_code = 1;
+    }
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(exit_code); /*ooo*/
+}
+
+
+/*
+ * add_file - read a JSON file into the corpus
+ *
+ * given:
+ *	path	path of the JSON file
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+add_file(char const *path)
+{
+    struct jarena_file file;	/* JSON file to add */
+    FILE *stream = NULL;	/* open JSON file */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	err(11, __func__, "path is NULL");
+	not_reached();
+    }
+
+    /*
+     * read the JSON file
+     */
+    memset(&file, 0, sizeof(file));
+    errno = 0;			/* pre-clear errno for errp() */
+    stream = fopen(path, "r");
+    if (stream == NULL) {
+	errp(12, __func__, "cannot open: %s", path);
+	not_reached();
+    }
+    file.data = read_all(stream, &file.len);
+    if (file.data == NULL) {
+	err(13, __func__, "read_all() failed for: %s", path);
+	not_reached();
+    }
+    clearerr_or_fclose(stream);
+    errno = 0;			/* pre-clear errno for errp() */
+    file.name = strdup(path);
+    if (file.name == NULL) {
+	errp(14, __func__, "strdup(%s) failed", path);
+	not_reached();
+    }
+
+    /*
+     * add the JSON file to the corpus
+     */
+    (void) dyn_array_append_value(corpus, &file);
+    corpus_bytes += file.len;
+    dbg(DBG_MED, "added %zu bytes from: %s", file.len, path);
+    return;
+}
+
+
+/*
+ * add_path - add a JSON file, or the *.json files of a directory, to the corpus
+ *
+ * given:
+ *	path	path of a JSON file, or a directory
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+add_path(char const *path)
+{
+    struct stat buf;		/* path status */
+    DIR *dir = NULL;		/* open directory */
+    struct dirent *ent = NULL;	/* directory entry */
+    char *file = NULL;		/* path of a JSON file in the directory */
+    size_t len = 0;		/* length of a directory entry name */
+    size_t file_len = 0;	/* length of the allocated file path */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	err(15, __func__, "path is NULL");
+	not_reached();
+    }
+
+    /*
+     * case: not a directory - add the file
+     */
+    memset(&buf, 0, sizeof(buf));
+    errno = 0;			/* pre-clear errno for errp() */
+    if (stat(path, &buf) != 0) {
+	errp(16, __func__, "cannot stat: %s", path);
+	not_reached();
+    }
+    if (!S_ISDIR(buf.st_mode)) {
+	add_file(path);
+	return;
+    }
+
+    /*
+     * add the *.json files of the directory
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    dir = opendir(path);
+    if (dir == NULL) {
+	errp(17, __func__, "cannot open directory: %s", path);
+	not_reached();
+    }
+    while ((ent = readdir(dir)) != NULL) {
+	len = strlen(ent->d_name);
+	if (len <= LITLEN(".json") || strcmp(ent->d_name + len - LITLEN(".json"), ".json") != 0) {
+	    continue;
+	}
+	file_len = strlen(path) + 1 + len + 1;
+	errno = 0;		/* pre-clear errno for errp() */
+	file = calloc(file_len, sizeof(*file));
+	if (file == NULL) {
+	    errp(18, __func__, "calloc of %zu bytes failed", file_len);
+	    not_reached();
+	}
+	(void) snprintf(file, file_len, "%s/%s", path, ent->d_name);
+	add_file(file);
+	free(file);
+	file = NULL;
+    }
+    (void) closedir(dir);
+    return;
+}
+
+
+/*
+ * cmp_file - compare corpus files by name for dyn_array_qsort()
+ *
+ * given:
+ *	a	pointer to a struct jarena_file
+ *	b	pointer to a struct jarena_file
+ *
+ * returns:
+ *	strcmp() of the file names
+ */
+static int
+cmp_file(const void *a, const void *b)
+{
+    struct jarena_file const *fa = a;	/* first file */
+    struct jarena_file const *fb = b;	/* second file */
+
+    return strcmp(fa->name, fb->name);
+}
+
+
+/*
+ * run_bench - run a benchmark in a child process
+ *
+ * given:
+ *	program		our name
+ *	use_arena	true ==> use a JSON arena, false ==> calloc(3) each node
+ *	repeat		number of times to parse the corpus
+ *
+ * returns:
+ *	exit status of the child process
+ *
+ * NOTE: This function does not return on error.
+ */
+static int
+run_bench(char const *program, bool use_arena, intmax_t repeat)
+{
+    pid_t pid = 0;		/* child process id */
+    int status = 0;		/* child wait status */
+
+    /*
+     * flush before forking so that buffered output is not written twice
+     */
+    fflush(stdout);
+    fflush(stderr);
+
+    /*
+     * fork the child
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    pid = fork();
+    if (pid < 0) {
+	errp(19, __func__, "fork failed");
+	not_reached();
+    } else if (pid == 0) {
+	bench(use_arena, repeat);
+	not_reached();
+    }
+
+    /*
+     * wait for the child
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    if (waitpid(pid, &status, 0) != pid) {
+	errp(20, __func__, "waitpid failed");
+	not_reached();
+    }
+    if (!WIFEXITED(status)) {
+	warn(program, "%s benchmark child did not exit normally", use_arena ? "arena" : "node");
+	return 1;
+    }
+    return WEXITSTATUS(status);
+}
+
+
+/*
+ * bench - parse the corpus repeat times and report time and peak RSS
+ *
+ * given:
+ *	use_arena	true ==> use a JSON arena, false ==> calloc(3) each node
+ *	repeat		number of times to parse the corpus
+ *
+ * All of the JSON parse trees, repeat times the corpus, are kept until
+ * every parse is done.  They are then freed: by json_tree_free() for each
+ * tree, or by a single json_arena_reset() when use_arena.
+ *
+ * NOTE: This function does not return.
+ */
+static void
+bench(bool use_arena, intmax_t repeat)
+{
+    struct json_arena *arena = NULL;	/* JSON arena, if use_arena */
+    struct json **trees = NULL;		/* JSON parse trees of all passes */
+    struct jarena_file *file = NULL;	/* corpus file */
+    struct timespec start;		/* parse start time */
+    struct timespec middle;		/* parse end time and free start time */
+    struct timespec end;		/* free end time */
+    struct rusage usage;		/* resource usage of this process */
+    intmax_t files = 0;			/* number of files in the corpus */
+    size_t count = 0;			/* number of JSON parse trees */
+    uintmax_t invalid = 0;		/* number of invalid parses */
+    uintmax_t blocks = 0;		/* arena blocks when all trees are formed */
+    uintmax_t reserved = 0;		/* arena bytes when all trees are formed */
+    bool valid = false;			/* true ==> JSON was valid */
+    double parse_secs = 0.0;		/* seconds spent parsing */
+    double free_secs = 0.0;		/* seconds spent freeing */
+    size_t n = 0;
+    intmax_t r;
+    intmax_t i;
+
+    /*
+     * setup
+     */
+    files = dyn_array_tell(corpus);
+    count = (size_t)files * (size_t)repeat;
+    errno = 0;			/* pre-clear errno for errp() */
+    trees = calloc(count, sizeof(*trees));
+    if (trees == NULL) {
+	errp(21, __func__, "calloc of %zu trees failed", count);
+	not_reached();
+    }
+    if (use_arena) {
+	arena = json_arena_create(0);
+	(void) json_arena_use(arena);
+    }
+
+    /*
+     * parse the corpus repeat times
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    for (r = 0, n = 0; r < repeat; ++r) {
+	for (i = 0; i < files; ++i, ++n) {
+	    file = dyn_array_addr(corpus, struct jarena_file, i);
+	    trees[n] = parse_json(file->data, file->len, file->name, &valid);
+	    if (trees[n] == NULL || !valid) {
+		if (r == 0) {
+		    warn(__func__, "invalid JSON: %s", file->name);
+		}
+		++invalid;
+	    }
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &middle);
+    if (use_arena) {
+	blocks = arena->blocks;
+	reserved = arena->reserved;
+    }
+
+    /*
+     * free all of the JSON parse trees
+     */
+    if (use_arena) {
+	json_arena_reset(arena);
+    } else {
+	for (n = 0; n < count; ++n) {
+	    if (trees[n] != NULL) {
+		json_tree_free(trees[n], JSON_INFINITE_DEPTH);
+		free(trees[n]);
+		trees[n] = NULL;
+	    }
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    parse_secs = (double)(middle.tv_sec - start.tv_sec) + (double)(middle.tv_nsec - start.tv_nsec) / 1e9;
+    free_secs = (double)(end.tv_sec - middle.tv_sec) + (double)(end.tv_nsec - middle.tv_nsec) / 1e9;
+
+    /*
+     * report
+     *
+     * NOTE: ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+     */
+    memset(&usage, 0, sizeof(usage));
+    (void) getrusage(RUSAGE_SELF, &usage);
+    print("%-5s trees: %zu bytes: %ju parse: %.3f sec (%.2f MB/s) free: %.6f sec maxrss: %ld",
+	  use_arena ? "arena" : "node", count, corpus_bytes * (uintmax_t)repeat, parse_secs,
+	  parse_secs > 0.0 ? (double)corpus_bytes * (double)repeat / parse_secs / 1e6 : 0.0,
+	  free_secs, usage.ru_maxrss);
+    if (use_arena) {
+	print(" arena blocks: %ju reserved: %ju", blocks, reserved);
+    }
+    print("%s", "\n");
+
+    /*
+     * cleanup
+     */
+    if (use_arena) {
+	json_arena_free(arena);
+	arena = NULL;
+    }
+    free(trees);
+    trees = NULL;
+    exit(invalid > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = JARENA_BENCH_BASENAME;
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT, JARENA_BENCH_REPEAT,
+	    JARENA_BENCH_BASENAME, JARENA_BENCH_VERSION, JPARSE_UTILS_VERSION, JPARSE_UTF8_VERSION,
+	    JPARSE_LIBRARY_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
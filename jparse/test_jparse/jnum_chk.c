@@ -115,6 +115,8 @@ main(int argc, char *argv[])
     bool strict = false;	/* true ==> strict testing for all struct integer element */
     struct json *node = NULL;	/* allocated JSON parser tree node */
     struct json_number *item = NULL;	/* JSON parser tree node for a JSON number */
+    struct json *eager_node = NULL;	/* allocated JSON parser tree node converted eagerly */
+    struct json_number *eager_item = NULL;	/* eager conversion of a JSON number */
     size_t len = 0;		/* length of str */
     int arg_count = 0;		/* number of args to process */
     bool opt_error = false;	/* fchk_inval_opt() return */
@@ -192,12 +194,18 @@ main(int argc, char *argv[])
 
     /*
      * process each test case
+     *
+     * Each test string is converted twice: once with the default lazy JSON
+     * number conversion (deferred until json_number_conv() is called) and
+     * once with eager conversion (json_number_eager == true).  Both must
+     * match the test suite, and each other.
      */
     for (testnum=0; testnum < test_count; ++testnum) {
 
 	/*
-	 * convert the test string
+	 * convert the test string with lazy conversion
 	 */
+	json_number_eager = false;
 	node = json_conv_number_str(test_set[testnum], &len);
 	if (node == NULL) {
 	    warn(__func__, "json_conv_number_str(\"%s\", &%zu) returned NULL",
@@ -210,10 +218,18 @@ main(int argc, char *argv[])
                     json_type_name(JTYPE_NUMBER));
 	    not_reached();
 	}
-	item = &(node->item.number);
+	if (node->item.number.conv != NULL) {
+	    warn(__func__, "test %zu: lazy JSON number was converted before first access", testnum);
+	    error = true;
+	}
+	item = json_number_conv(node);
+	if (item == NULL) {
+	    err(11, program, "json_number_conv() for test %zu returned NULL", testnum);
+	    not_reached();
+	}
 
 	/*
-	 * compare conversion with test case
+	 * compare lazy conversion with test case
 	 */
 	test = chk_test(testnum, item, &test_result[testnum], len, strict);
 	if (test == false) {
@@ -223,13 +239,70 @@ main(int argc, char *argv[])
 	}
 
 	/*
-	 * free converted node
+	 * compare the accessor functions with the lazy conversion
+	 */
+	test = chk_access(testnum, node, item);
+	if (test == false) {
+	    warn(__func__, "test: chk_access(%zu, node, item) failed", testnum);
+	    error = true;
+	}
+
+	/*
+	 * convert the test string with eager conversion
+	 */
+	json_number_eager = true;
+	eager_node = json_conv_number_str(test_set[testnum], &len);
+	json_number_eager = false;
+	if (eager_node == NULL) {
+	    warn(__func__, "eager json_conv_number_str(\"%s\", &%zu) returned NULL",
+			   test_set[testnum], len);
+	    error = true;
+	    break;
+	}
+	if (eager_node->type != JTYPE_NUMBER) {
+	    err(12, program, "eager node->type for test %zu: %s != %s", testnum, json_type_name(eager_node->type),
+                    json_type_name(JTYPE_NUMBER));
+	    not_reached();
+	}
+	eager_item = eager_node->item.number.conv;
+	if (eager_item == NULL) {
+	    warn(__func__, "test %zu: eager JSON number was not converted when formed", testnum);
+	    error = true;
+	} else {
+
+	    /*
+	     * compare eager conversion with test case
+	     */
+	    test = chk_test(testnum, eager_item, &test_result[testnum], len, strict);
+	    if (test == false) {
+		warn(__func__, "test: eager chk_test(%zu, eager_item, &test_result[%zu], %zu, %s) failed",
+			       testnum, testnum, len, (strict ? "true" : "false"));
+		error = true;
+	    }
+
+	    /*
+	     * compare eager conversion with lazy conversion
+	     */
+	    test = chk_test(testnum, eager_item, item, len, true);
+	    if (test == false) {
+		warn(__func__, "test: lazy and eager conversions of test %zu differ", testnum);
+		error = true;
+	    }
+	}
+
+	/*
+	 * free converted nodes
 	 */
 	json_free(node, 0);
 	if (node != NULL) {
 	    free(node);
 	    node = NULL;
 	}
+	json_free(eager_node, 0);
+	if (eager_node != NULL) {
+	    free(eager_node);
+	    eager_node = NULL;
+	}
     }
 
     /*
@@ -290,31 +363,31 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
     /*
      * test parsed boolean
      */
-    if (test_result[testnum].parsed != item->parsed) {
+    if (test->parsed != item->parsed) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].parsed: %d != item.parsed: %d",
-		       testnum, test_result[testnum].parsed, item->parsed);
+		       testnum, test->parsed, item->parsed);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "test_result[%zu].parsed: %d == item.parsed: %d",
-			testnum, test_result[testnum].parsed, item->parsed);
+			testnum, test->parsed, item->parsed);
     }
 
     /*
      * test converted boolean
      */
-    if (test_result[testnum].converted != item->converted) {
+    if (test->converted != item->converted) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].converted: %d != item.converted: %d",
-		       testnum, test_result[testnum].converted, item->converted);
+		       testnum, test->converted, item->converted);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "test_result[%zu].converted: %d == item.converted: %d",
-			testnum, test_result[testnum].converted, item->converted);
+			testnum, test->converted, item->converted);
     }
 
     /*
      * test NULL strings
      */
-    if (test_result[testnum].as_str == NULL) {
+    if (test->as_str == NULL) {
 	if (item->as_str != NULL) {
 	    dbg(DBG_VHIGH, "ERROR: test_result[%zu].as_str == NULL && item->as_str != NULL", testnum);
 	    test_error = true;
@@ -336,49 +409,49 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
     /*
      * test string lengths
      */
-    if (test_result[testnum].as_str_len != item->as_str_len) {
+    if (test->as_str_len != item->as_str_len) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].as_str_len: %zu != item->as_str_len: %zu",
-		       testnum, test_result[testnum].as_str_len, item->as_str_len);
+		       testnum, test->as_str_len, item->as_str_len);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "OK: test_result[%zu].as_str_len: %zu == item->as_str_len: %zu",
-		        testnum, test_result[testnum].as_str_len, item->as_str_len);
+		        testnum, test->as_str_len, item->as_str_len);
     }
-    if (test_result[testnum].number_len != item->number_len) {
+    if (test->number_len != item->number_len) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].number_len: %zu != item->number_len: %zu",
-		       testnum, test_result[testnum].number_len, item->number_len);
+		       testnum, test->number_len, item->number_len);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "OK: test_result[%zu].number_len: %zu == item->number_len: %zu",
-		        testnum, test_result[testnum].number_len, item->number_len);
+		        testnum, test->number_len, item->number_len);
     }
 
     /*
      * test: other top level booleans
      */
-    if (test_result[testnum].is_negative != item->is_negative) {
+    if (test->is_negative != item->is_negative) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].is_negative: %d != item.is_negative: %d",
-		       testnum, test_result[testnum].is_negative, item->is_negative);
+		       testnum, test->is_negative, item->is_negative);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "OK: test_result[%zu].is_negative: %d == item.is_negative: %d",
-			testnum, test_result[testnum].is_negative, item->is_negative);
+			testnum, test->is_negative, item->is_negative);
     }
-    if (test_result[testnum].is_floating != item->is_floating) {
+    if (test->is_floating != item->is_floating) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].is_floating: %d != item.is_floating: %d",
-		       testnum, test_result[testnum].is_floating, item->is_floating);
+		       testnum, test->is_floating, item->is_floating);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "OK: test_result[%zu].is_floating: %d == item.is_floating: %d",
-			testnum, test_result[testnum].is_floating, item->is_floating);
+			testnum, test->is_floating, item->is_floating);
     }
-    if (test_result[testnum].is_e_notation != item->is_e_notation) {
+    if (test->is_e_notation != item->is_e_notation) {
 	dbg(DBG_VHIGH, "ERROR: test_result[%zu].is_e_notation: %d != item.is_e_notation: %d",
-		       testnum, test_result[testnum].is_e_notation, item->is_e_notation);
+		       testnum, test->is_e_notation, item->is_e_notation);
 	test_error = true;
     } else {
 	dbg(DBG_VVHIGH, "OK: test_result[%zu].is_e_notation: %d == item.is_e_notation: %d",
-			testnum, test_result[testnum].is_e_notation, item->is_e_notation);
+			testnum, test->is_e_notation, item->is_e_notation);
     }
 
     /*
@@ -387,43 +460,43 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
 
     /* test: int8_t */
     check_val(&test_error, "int8", testnum,
-			   test_result[testnum].int8_sized, item->int8_sized,
-			   test_result[testnum].as_int8, item->as_int8);
+			   test->int8_sized, item->int8_sized,
+			   test->as_int8, item->as_int8);
 
     /* test: uint8_t */
     check_uval(&test_error, "uint8", testnum,
-			    test_result[testnum].uint8_sized, item->uint8_sized,
-			    test_result[testnum].as_uint8, item->as_uint8);
+			    test->uint8_sized, item->uint8_sized,
+			    test->as_uint8, item->as_uint8);
 
     /* test: int16_t */
     check_val(&test_error, "int16", testnum,
-			   test_result[testnum].int16_sized, item->int16_sized,
-			   test_result[testnum].as_int16, item->as_int16);
+			   test->int16_sized, item->int16_sized,
+			   test->as_int16, item->as_int16);
 
     /* test: uint16_t */
     check_uval(&test_error, "uint16", testnum,
-			    test_result[testnum].uint16_sized, item->uint16_sized,
-			    test_result[testnum].as_uint16, item->as_uint16);
+			    test->uint16_sized, item->uint16_sized,
+			    test->as_uint16, item->as_uint16);
 
     /* test: int32_t */
     check_val(&test_error, "int32", testnum,
-			   test_result[testnum].int32_sized, item->int32_sized,
-			   test_result[testnum].as_int32, item->as_int32);
+			   test->int32_sized, item->int32_sized,
+			   test->as_int32, item->as_int32);
 
     /* test: uint32_t */
     check_uval(&test_error, "uint32", testnum,
-			    test_result[testnum].uint32_sized, item->uint32_sized,
-			    test_result[testnum].as_uint32, item->as_uint32);
+			    test->uint32_sized, item->uint32_sized,
+			    test->as_uint32, item->as_uint32);
 
     /* test: int64_t */
     check_val(&test_error, "int64", testnum,
-			   test_result[testnum].int64_sized, item->int64_sized,
-			   test_result[testnum].as_int64, item->as_int64);
+			   test->int64_sized, item->int64_sized,
+			   test->as_int64, item->as_int64);
 
     /* test: uint64_t */
     check_uval(&test_error, "uint64", testnum,
-			    test_result[testnum].uint64_sized, item->uint64_sized,
-			    test_result[testnum].as_uint64, item->as_uint64);
+			    test->uint64_sized, item->uint64_sized,
+			    test->as_uint64, item->as_uint64);
 
     /*
      * tests for strict mode only of integers
@@ -432,48 +505,48 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
 
 	/* test: int */
 	check_val(&test_error, "int", testnum,
-			       test_result[testnum].int_sized, item->int_sized,
-			       test_result[testnum].as_int, item->as_int);
+			       test->int_sized, item->int_sized,
+			       test->as_int, item->as_int);
 
 	/* test: unsigned int */
 	check_uval(&test_error, "uint", testnum,
-				test_result[testnum].uint_sized, item->uint_sized,
-				test_result[testnum].as_uint, item->as_uint);
+				test->uint_sized, item->uint_sized,
+				test->as_uint, item->as_uint);
 
 	/* test: long */
 	check_val(&test_error, "long", testnum,
-			       test_result[testnum].long_sized, item->long_sized,
-			       test_result[testnum].as_long, item->as_long);
+			       test->long_sized, item->long_sized,
+			       test->as_long, item->as_long);
 
 	/* test: unsigned long */
 	check_uval(&test_error, "ulong", testnum,
-				test_result[testnum].ulong_sized, item->ulong_sized,
-				test_result[testnum].as_ulong, item->as_ulong);
+				test->ulong_sized, item->ulong_sized,
+				test->as_ulong, item->as_ulong);
 
 	/* test: long long */
 	check_val(&test_error, "longlong", testnum,
-			       test_result[testnum].longlong_sized, item->longlong_sized,
-			       test_result[testnum].as_longlong, item->as_longlong);
+			       test->longlong_sized, item->longlong_sized,
+			       test->as_longlong, item->as_longlong);
 
 	/* test: unsigned long long */
 	check_uval(&test_error, "ulonglong", testnum,
-				test_result[testnum].ulonglong_sized, item->ulonglong_sized,
-				test_result[testnum].as_ulonglong, item->as_ulonglong);
+				test->ulonglong_sized, item->ulonglong_sized,
+				test->as_ulonglong, item->as_ulonglong);
 
 	/* test: ssize_t */
 	check_val(&test_error, "ssize", testnum,
-			       test_result[testnum].ssize_sized, item->ssize_sized,
-			       test_result[testnum].as_ssize, item->as_ssize);
+			       test->ssize_sized, item->ssize_sized,
+			       test->as_ssize, item->as_ssize);
 
 	/* test: size_t */
 	check_uval(&test_error, "size", testnum,
-				test_result[testnum].size_sized, item->size_sized,
-				test_result[testnum].as_size, item->as_size);
+				test->size_sized, item->size_sized,
+				test->as_size, item->as_size);
 
 	/* test: off_t */
 	check_val(&test_error, "off", testnum,
-			       test_result[testnum].off_sized, item->off_sized,
-			       test_result[testnum].as_off, item->as_off);
+			       test->off_sized, item->off_sized,
+			       test->as_off, item->as_off);
     }
 
     /*
@@ -482,13 +555,13 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
 
     /* test: intmax_t */
     check_val(&test_error, "intmax", testnum,
-			   test_result[testnum].maxint_sized, item->maxint_sized,
-			   test_result[testnum].as_maxint, item->as_maxint);
+			   test->maxint_sized, item->maxint_sized,
+			   test->as_maxint, item->as_maxint);
 
     /* test: uintmax_t */
     check_uval(&test_error, "uintmax", testnum,
-			    test_result[testnum].umaxint_sized, item->umaxint_sized,
-			    test_result[testnum].as_umaxint, item->as_umaxint);
+			    test->umaxint_sized, item->umaxint_sized,
+			    test->as_umaxint, item->as_umaxint);
 
     /*
      * perform tests for both strict and non-strict testing of floating point
@@ -496,21 +569,21 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
 
     /* test: float */
     check_fval(&test_error, "float", testnum,
-			    test_result[testnum].float_sized, item->float_sized,
-			    (double)test_result[testnum].as_float, (double)item->as_float,
-			    test_result[testnum].as_float_int, item->as_float_int, strict);
+			    test->float_sized, item->float_sized,
+			    (double)test->as_float, (double)item->as_float,
+			    test->as_float_int, item->as_float_int, strict);
 
     /* test: double */
     check_fval(&test_error, "double", testnum,
-			    test_result[testnum].double_sized, item->double_sized,
-			    test_result[testnum].as_double, item->as_double,
-			    test_result[testnum].as_double_int, item->as_double_int, strict);
+			    test->double_sized, item->double_sized,
+			    test->as_double, item->as_double,
+			    test->as_double_int, item->as_double_int, strict);
 
     /* test: long double */
     check_fval(&test_error, "longdouble", testnum,
-			    test_result[testnum].longdouble_sized, item->longdouble_sized,
-			    test_result[testnum].as_longdouble, item->as_longdouble,
-			    test_result[testnum].as_longdouble_int, item->as_longdouble_int, strict);
+			    test->longdouble_sized, item->longdouble_sized,
+			    test->as_longdouble, item->as_longdouble,
+			    test->as_longdouble_int, item->as_longdouble_int, strict);
 
     /*
      * if this test failed, return false
@@ -524,6 +597,96 @@ chk_test(size_t testnum, struct json_number *item, struct json_number *test, siz
 }
 
 
+/*
+ * chk_access - check that the json_number_xxx() accessors agree with a conversion
+ *
+ * given:
+ *	testnum - test number being checked
+ *	node	- pointer to JTYPE_NUMBER struct json
+ *	item	- pointer to struct json_number conversion of node
+ *
+ * returns:
+ *	true ==> each accessor agrees with item
+ *	false ==> some accessor disagrees, or NULL pointer given
+ */
+static bool
+chk_access(size_t testnum, struct json *node, struct json_number *item)
+{
+    bool test_error = false;	/* true ==> check failed */
+    int8_t i8 = 0;		/* json_number_int8() value */
+    uint8_t u8 = 0;		/* json_number_uint8() value */
+    int32_t i32 = 0;		/* json_number_int32() value */
+    uint64_t u64 = 0;		/* json_number_uint64() value */
+    intmax_t imax = 0;		/* json_number_maxint() value */
+    uintmax_t umax = 0;		/* json_number_umaxint() value */
+    double d = 0.0;		/* json_number_double() value */
+    long double ld = 0.0L;	/* json_number_longdouble() value */
+
+    /*
+     * firewall
+     */
+    if (node == NULL) {
+	warn(__func__, "node is NULL");
+	return false;
+    }
+    if (item == NULL) {
+	warn(__func__, "item is NULL");
+	return false;
+    }
+
+    /*
+     * each accessor must succeed exactly when the type was sized, with the same value
+     */
+    if (json_number_int8(node, &i8) != item->int8_sized || (item->int8_sized && i8 != item->as_int8)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_int8() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_uint8(node, &u8) != item->uint8_sized || (item->uint8_sized && u8 != item->as_uint8)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_uint8() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_int32(node, &i32) != item->int32_sized || (item->int32_sized && i32 != item->as_int32)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_int32() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_uint64(node, &u64) != item->uint64_sized || (item->uint64_sized && u64 != item->as_uint64)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_uint64() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_maxint(node, &imax) != item->maxint_sized || (item->maxint_sized && imax != item->as_maxint)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_maxint() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_umaxint(node, &umax) != item->umaxint_sized || (item->umaxint_sized && umax != item->as_umaxint)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_umaxint() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_double(node, &d) != item->double_sized || (item->double_sized && d != item->as_double)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_double() disagrees with conversion", testnum);
+	test_error = true;
+    }
+    if (json_number_longdouble(node, &ld) != item->longdouble_sized || (item->longdouble_sized && ld != item->as_longdouble)) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_longdouble() disagrees with conversion", testnum);
+	test_error = true;
+    }
+
+    /*
+     * accessors must not reconvert
+     */
+    if (json_number_conv(node) != item) {
+	dbg(DBG_VHIGH, "ERROR: test %zu: json_number_conv() did not return the existing conversion", testnum);
+	test_error = true;
+    }
+
+    if (test_error == true) {
+	dbg(DBG_MED, "ERROR: test %zu accessor check failed", testnum);
+	return false;
+    }
+    dbg(DBG_HIGH, "OK: test %zu accessor check passed", testnum);
+    return true;
+}
+
+
 /*
  * check_val - test an aspect of conversion into struct json_number for signed integer
  *
@@ -87,7 +87,7 @@
 /*
  * official jnum_chk version
  */
-#define JNUM_CHK_VERSION "2.0.2 2025-10-02"      /* format: major.minor YYYY-MM-DD */
+#define JNUM_CHK_VERSION "2.0.3 2026-10-18"      /* format: major.minor YYYY-MM-DD */
 
 
 /*
@@ -118,6 +118,7 @@ extern struct json_number test_result[];	/* struct integer conversions of test s
  */
 #if !defined(JNUM_TEST)
 static bool chk_test(size_t testnum, struct json_number *item, struct json_number *test, size_t len, bool strict);
+static bool chk_access(size_t testnum, struct json *node, struct json_number *item);
 static void check_val(bool *testp, char const *type, size_t testnum, bool size_a, bool size_b, intmax_t val_a, intmax_t val_b);
 static void check_uval(bool *testp, char const *type, size_t testnum, bool size_a, bool size_b, uintmax_t val_a, uintmax_t val_b);
 static void check_fval(bool *testp, char const *type, size_t testnum, bool size_a, bool size_b,
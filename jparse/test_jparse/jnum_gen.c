@@ -355,7 +355,7 @@ main(int argc, char *argv[])
 		    json_type_name(JTYPE_NUMBER));
 	    not_reached();
 	}
-	fpr_number(stdout, &node->item.number);
+	fpr_number(stdout, json_number_conv(node));
 
 	/*
 	 * print end of json_number structure
@@ -0,0 +1,469 @@
+/*
+ * jobject_bench - compare JSON object member lookup by search and by index
+ *
+ * This tool forms a JSON object with many members, parses it, and looks up
+ * members by name: by searching the members of the JSON object one at a time,
+ * by json_object_get(), and by sem_object_find_name().  The results of each
+ * lookup are checked against each other, so this tool is also a test of the
+ * JSON object member name index.
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <locale.h>
+#include <time.h>
+
+/*
+ * jobject_bench - compare JSON object member lookup by search and by index
+ */
+#include "jobject_bench.h"
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
+#define NAME_SIZE (32)		/* size of a member name buffer */
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] [-a] [-n members] [-s searches]\n"
+    "\n"
+    "\t-h\t\tprint help message and exit\n"
+    "\t-v level\tset verbosity level (def level: %d)\n"
+    "\t-J level\tset JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tprint version strings and exit\n"
+    "\t-a\t\tparse the JSON object into a JSON arena (def: calloc each node)\n"
+    "\t-n members\tnumber of JSON object members (def: %d)\n"
+    "\t-s searches\tnumber of members to look up by searching the JSON object (def: %d)\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tall is OK\n"
+    "\t1\t\ta member lookup returned the wrong member\n"
+    "\t2\t\t-h and help string printed or -V and version strings printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "%s version: %s\n"
+    "jparse utils version: %s\n"
+    "jparse UTF-8 version: %s\n"
+    "jparse library version: %s";
+
+
+/*
+ * forward declarations
+ */
+static char *form_object(intmax_t members, size_t *plen);
+static intmax_t search_member(struct json *node, char const *name);
+static double elapsed(struct timespec const *start, struct timespec const *end);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;	/* our name */
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    int arg_count = 0;		/* number of args to process */
+    intmax_t members = JOBJECT_BENCH_MEMBERS;	/* number of JSON object members */
+    intmax_t searches = JOBJECT_BENCH_SEARCHES;	/* number of members to look up by searching */
+    bool opt_error = false;	/* fchk_inval_opt() return */
+    struct json_arena *arena = NULL;	/* JSON arena if -a */
+    bool use_arena = false;	/* true ==> -a, parse into a JSON arena */
+    char *data = NULL;		/* JSON document of a JSON object */
+    size_t len = 0;		/* length of data */
+    struct json *tree = NULL;	/* JSON parse tree of data */
+    struct json_object *item = NULL;	/* JSON object of tree */
+    struct json_sem sem[2];	/* empty JSON semantic table for sem_object_find_name() */
+    struct json *member = NULL;	/* JSON member found */
+    bool valid = false;		/* true ==> data is valid JSON */
+    char name[NAME_SIZE+1];	/* name of member to look up */
+    struct timespec start;	/* start of a timed lookup */
+    struct timespec middle;	/* end of JSON object member name index formation */
+    struct timespec end;	/* end of a timed lookup */
+    intmax_t wrong = 0;		/* number of lookups that returned the wrong member */
+    intmax_t found = 0;		/* set[] index of member found */
+    intmax_t j;
+    int i;
+
+    /*
+     * use default locale based on LANG
+     */
+    (void) setlocale(LC_ALL, "");
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:Van:s:")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    /*
+	     * parse verbosity
+	     */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    /*
+	     * parse JSON verbosity
+	     */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version strings and exit */
+	    print("jobject_bench version %s\n", JOBJECT_BENCH_VERSION);
+	    print("jparse utils version: %s\n", JPARSE_UTILS_VERSION);
+	    print("jparse UTF-8 version: %s\n", JPARSE_UTF8_VERSION);
+	    print("jparse library version: %s\n", JPARSE_LIBRARY_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'a':		/* -a - parse into a JSON arena */
+	    use_arena = true;
+	    break;
+	case 'n':		/* -n members */
+	    if (!string_to_intmax(optarg, &members) || members <= 0) {
+		usage(3, program, "invalid -n members"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 's':		/* -s searches */
+	    if (!string_to_intmax(optarg, &searches) || searches < 0) {
+		usage(3, program, "invalid -s searches"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    opt_error = fchk_inval_opt(stderr, program, i, optopt);
+	    if (opt_error) {
+		usage(3, program, ""); /*ooo*/
+		not_reached();
+	    } else {
+		fwarn(stderr, __func__, "getopt() return: %c optopt: %c", (char)i, (char)optopt);
+	    }
+	    break;
+	}
+    }
+    arg_count = argc - optind;
+    if (arg_count != REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+    if (searches > members) {
+	searches = members;
+    }
+
+    /*
+     * form and parse a JSON object with members named m0, m1, ... and a final duplicate m0
+     */
+    data = form_object(members, &len);
+    if (use_arena) {
+	arena = json_arena_create(0);
+	(void) json_arena_use(arena);
+    }
+    tree = parse_json(data, len, NULL, &valid);
+    if (tree == NULL || valid == false || tree->type != JTYPE_OBJECT) {
+	err(10, __func__, "parse of JSON object of %jd members failed", members);
+	not_reached();
+    }
+    item = &(tree->item.object);
+    if (item->len != members + 1) {
+	err(11, __func__, "JSON object has %jd members, expected %jd", item->len, members + 1);
+	not_reached();
+    }
+    dbg(DBG_LOW, "JSON object: %jd members, %zu bytes", item->len, len);
+
+    /*
+     * look up members by searching the JSON object
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    for (j=0; j < searches; ++j) {
+	intmax_t want = j * members / searches;	/* set[] index of member to look up */
+
+	(void) snprintf(name, sizeof(name), "m%jd", want);
+	found = search_member(tree, name);
+	if (found != want) {
+	    warn(__func__, "search for %s found set[%jd], expected set[%jd]", name, found, want);
+	    ++wrong;
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    if (searches > 0) {
+	print("search: %jd lookups: %.3f usec/lookup\n",
+	      searches, elapsed(&start, &end) * 1000000.0 / (double)searches);
+    }
+
+    /*
+     * look up every member by json_object_get()
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    member = json_object_get(tree, "m0", strlen("m0"));
+    (void) clock_gettime(CLOCK_MONOTONIC, &middle);
+    if (member != item->set[0]) {
+	warn(__func__, "json_object_get() of duplicate name m0 did not return the first m0");
+	++wrong;
+    }
+    for (j=0; j < members; ++j) {
+	(void) snprintf(name, sizeof(name), "m%jd", j);
+	member = json_object_get(tree, name, strlen(name));
+	if (member != item->set[j]) {
+	    warn(__func__, "json_object_get() of %s did not return set[%jd]", name, j);
+	    ++wrong;
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    if (json_object_get(tree, "m", strlen("m")) != NULL || json_object_get(tree, "m0", 1) != NULL) {
+	warn(__func__, "json_object_get() found a member that does not exist");
+	++wrong;
+    }
+    print("index:  %jd lookups: %.3f usec/lookup, index formed in %.3f msec\n",
+	  members, elapsed(&middle, &end) * 1000000.0 / (double)members, elapsed(&start, &middle) * 1000.0);
+
+    /*
+     * look up every member by sem_object_find_name()
+     */
+    memset(sem, 0, sizeof(sem));
+    sem[0].type = JTYPE_OBJECT;
+    sem[1].type = JTYPE_UNSET;
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    for (j=0; j < members; ++j) {
+	(void) snprintf(name, sizeof(name), "m%jd", j);
+	member = sem_object_find_name(tree, 0, sem, __func__, NULL, name);
+	if (member != item->set[j]) {
+	    warn(__func__, "sem_object_find_name() of %s did not return set[%jd]", name, j);
+	    ++wrong;
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("sem:    %jd lookups: %.3f usec/lookup\n",
+	  members, elapsed(&start, &end) * 1000000.0 / (double)members);
+
+    /*
+     * cleanup
+     */
+    if (use_arena) {
+	(void) json_arena_use(NULL);
+	json_arena_free(arena);
+	arena = NULL;
+    } else {
+	json_tree_free(tree, JSON_INFINITE_DEPTH);
+    }
+    tree = NULL;
+    free(data);
+    data = NULL;
+    if (wrong > 0) {
+	warn(__func__, "%jd lookups returned the wrong member", wrong);
+    }
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(wrong > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * form_object - form a JSON document of a JSON object of many members
+ *
+ * The members are named m0, m1, ..., and their values are their positions.
+ * A final member named m0, with a value of -1, is added so that there is a
+ * duplicate name.
+ *
+ * given:
+ *	members	    number of uniquely named members
+ *	plen	    where to store the length of the JSON document
+ *
+ * returns:
+ *	allocated JSON document
+ *
+ * NOTE: This function does not return on error.
+ */
+static char *
+form_object(intmax_t members, size_t *plen)
+{
+    char *data = NULL;		/* JSON document to return */
+    size_t size = 0;		/* allocated size of data */
+    size_t len = 0;		/* length of data */
+    intmax_t j;
+
+    /*
+     * firewall
+     */
+    if (plen == NULL) {
+	err(12, __func__, "plen is NULL");
+	not_reached();
+    }
+
+    /*
+     * allocate room for the JSON document
+     */
+    size = (size_t)members * (2*NAME_SIZE) + 2*NAME_SIZE;
+    errno = 0;			/* pre-clear errno for errp() */
+    data = malloc(size);
+    if (data == NULL) {
+	errp(13, __func__, "malloc of %zu bytes failed", size);
+	not_reached();
+    }
+
+    /*
+     * form the JSON object
+     */
+    data[len++] = '{';
+    for (j=0; j < members; ++j) {
+	len += (size_t)snprintf(data + len, size - len, "\"m%jd\":%jd,", j, j);
+    }
+    len += (size_t)snprintf(data + len, size - len, "\"m0\":-1}\n");
+    *plen = len;
+    return data;
+}
+
+
+/*
+ * search_member - search a JSON object for the first member with a given name
+ *
+ * given:
+ *	node	JSON parse tree node of type JTYPE_OBJECT
+ *	name	decoded member name to find
+ *
+ * returns:
+ *	set[] index of the first member with the given name, or -1 ==> not found
+ */
+static intmax_t
+search_member(struct json *node, char const *name)
+{
+    struct json_object *item = &(node->item.object);	/* JSON object */
+    struct json *s = NULL;				/* JSON object member */
+    intmax_t i;
+
+    for (i=0; i < item->len; ++i) {
+	s = item->set[i];
+	if (s != NULL && s->type == JTYPE_MEMBER && s->item.member.name != NULL &&
+	    s->item.member.name->item.string.str != NULL &&
+	    strcmp(name, s->item.member.name->item.string.str) == 0) {
+	    return i;
+	}
+    }
+    return -1;
+}
+
+
+/*
+ * elapsed - return the number of seconds between two times
+ *
+ * given:
+ *	start	start time
+ *	end	end time
+ *
+ * returns:
+ *	seconds from start to end
+ */
+static double
+elapsed(struct timespec const *start, struct timespec const *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1000000000.0;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = JOBJECT_BENCH_BASENAME;
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT, JOBJECT_BENCH_MEMBERS,
+	    JOBJECT_BENCH_SEARCHES, JOBJECT_BENCH_BASENAME, JOBJECT_BENCH_VERSION, JPARSE_UTILS_VERSION,
+	    JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
@@ -93,7 +93,7 @@
 #
 # setup
 #
-export JPARSE_TEST_VERSION="2.0.0 2025-02-28"	    # version format: major.minor YYYY-MM-DD */
+export JPARSE_TEST_VERSION="2.0.1 2026-10-18"	    # version format: major.minor YYYY-MM-DD */
 export CHK_TEST_FILE="./test_jparse/json_teststr.txt"
 export CHK_INVALID_TEST_FILE="./test_jparse/json_teststr_fail.txt"
 export JPARSE="./jparse"
@@ -569,7 +569,7 @@ run_location_err_test()
 # run_file_test - run a single jparse test on a file
 #
 # usage:
-#	run_file_test jparse dbg_level json_dbg_level quiet_mode json_doc_file pass|fail
+#	run_file_test jparse dbg_level json_dbg_level quiet_mode json_doc_file pass|fail [-S]
 #
 #	jparse			path to the jparse program
 #	dbg_level		internal test debugging level to use as in: jparse -v dbg_level
@@ -577,13 +577,14 @@ run_location_err_test()
 #	quiet_mode		quiet mode to use in: jparse -q
 #	json_doc_file		JSON document as a string to give to jparse
 #	pass|fail		string saying if jparse must return valid json or invalid json
+#	-S			use jparse -S streaming validate mode (def: form a JSON parse tree)
 #
 run_file_test()
 {
     # parse args
     #
-    if [[ $# -ne 6 ]]; then
-	echo "$0: ERROR: expected 6 args to run_file_test, found $#" 1>&2
+    if [[ $# -ne 6 && $# -ne 7 ]]; then
+	echo "$0: ERROR: expected 6 or 7 args to run_file_test, found $#" 1>&2
 	exit 10
     fi
     declare jparse="$1"
@@ -592,6 +593,7 @@ run_file_test()
     declare quiet_mode="$4"
     declare json_doc_file="$5"
     declare pass_fail="$6"
+    declare stream_mode="${7:-}"
 
     if [[ "$pass_fail" != "pass" && "$pass_fail" != "fail" ]]; then
 	echo "$0: ERROR: in run_file_test: pass_fail neither 'pass' nor 'fail'" 1>&2
@@ -607,20 +609,25 @@ run_file_test()
 	echo "$0: debug[9]: in run_file_test: quiet_mode: $quiet_mode" 1>&2
 	echo "$0: debug[9]: in run_file_test: json_doc_file: $json_doc_file" 1>&2
 	echo "$0: debug[9]: in run_file_test: pass_fail: $pass_fail" 1>&2
+	echo "$0: debug[9]: in run_file_test: stream_mode: $stream_mode" 1>&2
+    fi
+    if [[ -n $stream_mode && $stream_mode != "-S" ]]; then
+	echo "$0: ERROR: in run_file_test: stream_mode not '-S'" 1>&2
+	exit 10
     fi
 
     if [[ -z $quiet_mode ]]; then
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level $stream_mode -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -- "$json_doc_file" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level $stream_mode -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" -v "$dbg_level" -J "$json_dbg_level" ${stream_mode:+"$stream_mode"} -- "$json_doc_file" >> "${LOGFILE}" 2>&1
     else
 	if [[ $V_FLAG -ge 3 ]]; then
-	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
+	    echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q $stream_mode -- $json_doc_file >> ${LOGFILE} 2>&1" 1>&2
 	fi
-	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
-	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -q -- "$json_doc_file" >> "${LOGFILE}" 2>&1
+	echo "$0: debug[3]: about to run test that must $pass_fail: $jparse -v $dbg_level -J $json_dbg_level -q $stream_mode -- $json_doc_file >> ${LOGFILE} 2>&1" >> "${LOGFILE}"
+	"$jparse" -v "$dbg_level" -J "$json_dbg_level" -q ${stream_mode:+"$stream_mode"} -- "$json_doc_file" >> "${LOGFILE}" 2>&1
     fi
     status="$?"
 
@@ -937,9 +944,10 @@ if [[ -n "$D_FLAG" ]]; then
 	echo "$0: debug[3]: about to run jparse tests that must PASS: JSON files" 1>&2 >> "${LOGFILE}"
     fi
 
-    # run tests that must PASS
+    # run tests that must PASS, both with a JSON parse tree and with jparse -S
     while read -r file; do
 	run_file_test "$JPARSE" "$DBG_LEVEL" "$JSON_DBG_LEVEL" "$Q_FLAG" "$file" pass
+	run_file_test "$JPARSE" "$DBG_LEVEL" "$JSON_DBG_LEVEL" "$Q_FLAG" "$file" pass -S
     done < <(find "$JSON_GOOD_TREE" -type f -name '*.json' -print)
 
 
@@ -950,6 +958,7 @@ if [[ -n "$D_FLAG" ]]; then
     fi
     while read -r file; do
 	run_file_test "$JPARSE" "$DBG_LEVEL" "$JSON_DBG_LEVEL" "$Q_FLAG" "$file" fail
+	run_file_test "$JPARSE" "$DBG_LEVEL" "$JSON_DBG_LEVEL" "$Q_FLAG" "$file" fail -S
     done < <(find "$JSON_BAD_TREE" -type f -name '*.json' -print)
 
     # run tests that must FAIL with correct error locations, if -L not used
@@ -0,0 +1,844 @@
+/*
+ * jscan_chk - check the SIMD JSON string scanners against the scalar scanner
+ *
+ * This tool parses a corpus of JSON files many times, once with each
+ * JSON parse tree node allocated by calloc(3) and freed by json_tree_free(),
+ * and once with the JSON parse trees allocated from a JSON arena and freed
+ * by json_arena_reset().  Each method is run in its own child process so
+ * that the peak resident set size of each method may be compared.
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <locale.h>
+#include <time.h>
+
+/*
+ * jscan_chk - check the SIMD JSON string scanners against the scalar scanner
+ */
+#include "jscan_chk.h"
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] [-n count] [-b] [-r repeat] [file ...]\n"
+    "\n"
+    "\t-h\t\tprint help message and exit\n"
+    "\t-v level\tset verbosity level (def level: %d)\n"
+    "\t-J level\tset JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tprint version strings and exit\n"
+    "\t-n count\tcheck count random strings (def: %d)\n"
+    "\t-b\t\tbenchmark each available scanner after checking\n"
+    "\t-r repeat\tscan the %d byte benchmark string repeat times (def: %d)\n"
+    "\n"
+    "\tfile\t\tfile whose lines, and the JSON strings in them, are checked\n"
+    "\t\t\t    NOTE: such as test_jparse/json_teststr.txt\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tall is OK\n"
+    "\t1\t\ta SIMD scanner differs from the scalar scanner\n"
+    "\t2\t\t-h and help string printed or -V and version strings printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "%s version: %s\n"
+    "jparse utils version: %s\n"
+    "jparse UTF-8 version: %s\n"
+    "jparse library version: %s";
+
+
+/*
+ * static variables
+ */
+static uintmax_t checks = 0;		/* number of strings checked */
+static uintmax_t mismatches = 0;	/* number of differences found */
+static uint64_t rand_state = JSCAN_CHK_SEED;	/* state of the random string generator */
+
+/*
+ * bytes that the scanners treat specially, and their neighbours
+ */
+static unsigned char const interesting[] = {
+    '"', '\\', 0x00, 0x01, '\b', '\t', '\n', '\f', '\r', 0x1f, ' ', '!', '#',
+    '/', '.', '-', '+', '_', ',', '0', '9', ':', '@', 'A', 'Z', '[', '`', 'a',
+    'z', '{', 0x7f, 0x80, 0xc3, 0xa9, 0xff
+};
+
+/*
+ * JSON encoded pieces from which random strings are formed
+ */
+static char const * const pieces[] = {
+    "a", "Z", "0", "/", ".", "_", "+", "-", " ", "~", "\"", "\\", "\t", "\x01",
+    "\\n", "\\t", "\\\"", "\\\\", "\\/", "\\u00e9", "\\u20ac", "\\ud83d\\ude00",
+    "\\x", "\\u12", "\xc3\xa9", "\xe2\x82\xac", "\xff", "curds and whey ",
+    "POSIX_safe-name+1.txt", "/some/path/name"
+};
+
+
+/*
+ * forward declarations
+ */
+static uint64_t next_rand(void);
+static void check_scan(char const *ptr, size_t len, bool every_offset, char const *what);
+static void check_decode(char const *ptr, size_t len, char const *what);
+static void check_line(char const *line, size_t len, char const *what);
+static void check_file(char const *path);
+static void check_placed(void);
+static void check_random(intmax_t count);
+static void check_short_u(void);
+static double bench_secs(struct timespec const *start);
+static void bench(intmax_t repeat);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;	/* our name */
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    int arg_count = 0;		/* number of args to process */
+    intmax_t count = JSCAN_CHK_RANDOM;	/* number of random strings to check */
+    intmax_t repeat = JSCAN_CHK_REPEAT;	/* number of times to scan the benchmark string */
+    bool benchmark = false;	/* true ==> -b, benchmark the scanners */
+    bool opt_error = false;	/* fchk_inval_opt() return */
+    int impl;			/* JSON string scanner */
+    int i;
+
+    /*
+     * use default locale based on LANG
+     */
+    (void) setlocale(LC_ALL, "");
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:Vn:br:")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    /*
+	     * parse verbosity
+	     */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    /*
+	     * parse JSON verbosity
+	     */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version strings and exit */
+	    print("jscan_chk version %s\n", JSCAN_CHK_VERSION);
+	    print("jparse utils version: %s\n", JPARSE_UTILS_VERSION);
+	    print("jparse UTF-8 version: %s\n", JPARSE_UTF8_VERSION);
+	    print("jparse library version: %s\n", JPARSE_LIBRARY_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'n':		/* -n count */
+	    if (!string_to_intmax(optarg, &count) || count < 0) {
+		usage(3, program, "invalid -n count"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'b':		/* -b - benchmark the scanners */
+	    benchmark = true;
+	    break;
+	case 'r':		/* -r repeat */
+	    if (!string_to_intmax(optarg, &repeat) || repeat <= 0) {
+		usage(3, program, "invalid -r repeat"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    opt_error = fchk_inval_opt(stderr, program, i, optopt);
+	    if (opt_error) {
+		usage(3, program, ""); /*ooo*/
+		not_reached();
+	    } else {
+		fwarn(stderr, __func__, "getopt() return: %c optopt: %c", (char)i, (char)optopt);
+	    }
+	    break;
+	}
+    }
+    arg_count = argc - optind;
+    if (arg_count < REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * the strings checked are often invalid JSON: do not warn about them
+     */
+    msg_warn_silent = true;
+
+    /*
+     * report which scanners will be checked
+     */
+    for (impl = JSON_SCAN_SCALAR; impl < JSON_SCAN_IMPL_COUNT; ++impl) {
+	dbg(DBG_LOW, "JSON scanner %s: %s", json_scan_name((enum json_scan_impl)impl),
+		     json_scan_available((enum json_scan_impl)impl) ? "checked" : "not available");
+    }
+
+    /*
+     * check the SIMD scanners against the scalar scanner
+     */
+    for (i = optind; i < argc; ++i) {
+	check_file(argv[i]);
+    }
+    check_placed();
+    check_random(count);
+    check_short_u();
+    if (mismatches > 0) {
+	fprint(stderr, "%s: %ju of %ju checks differ from the scalar scanner\n", program, mismatches, checks);
+    } else {
+	dbg(DBG_LOW, "all %ju checks agree with the scalar scanner", checks);
+    }
+
+    /*
+     * benchmark if requested
+     */
+    if (benchmark) {
+	bench(repeat);
+    }
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(mismatches > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * next_rand - return the next value of a xorshift random number generator
+ *
+ * The generator is seeded with a constant so that every run checks the
+ * same strings.
+ *
+ * returns:
+ *	next 64 bit pseudo-random value
+ */
+static uint64_t
+next_rand(void)
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+
+/*
+ * check_scan - check json_scan_special() and json_scan_posix()
+ *
+ * given:
+ *	ptr		bytes to scan
+ *	len		length of ptr in bytes
+ *	every_offset	true ==> scan from each offset of ptr, false ==> only from the start
+ *	what		description of ptr for messages
+ *
+ * NOTE: This function does not return on NULL args.
+ */
+static void
+check_scan(char const *ptr, size_t len, bool every_offset, char const *what)
+{
+    struct json_scan_posix ref_pos;	/* json_scan_posix() by the scalar scanner */
+    struct json_scan_posix pos;		/* json_scan_posix() by a SIMD scanner */
+    size_t ref_special;			/* json_scan_special() by the scalar scanner */
+    size_t special;			/* json_scan_special() by a SIMD scanner */
+    size_t off;				/* offset into ptr to scan from */
+    int impl;				/* JSON string scanner */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL || what == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * scanning from each offset moves the end of ptr across the SIMD chunks
+     */
+    for (off = 0; off <= len; ++off) {
+	(void) json_scan_select(JSON_SCAN_SCALAR);
+	ref_special = json_scan_special(ptr + off, len - off);
+	json_scan_posix(ptr + off, len - off, &ref_pos);
+
+	for (impl = JSON_SCAN_SCALAR+1; impl < JSON_SCAN_IMPL_COUNT; ++impl) {
+	    if (!json_scan_available((enum json_scan_impl)impl)) {
+		continue;
+	    }
+	    (void) json_scan_select((enum json_scan_impl)impl);
+	    ++checks;
+	    special = json_scan_special(ptr + off, len - off);
+	    json_scan_posix(ptr + off, len - off, &pos);
+	    if (special != ref_special) {
+		++mismatches;
+		fwarn(stderr, __func__, "%s: offset %zu length %zu: %s json_scan_special: %zu != scalar: %zu",
+			      what, off, len - off, json_scan_name((enum json_scan_impl)impl), special, ref_special);
+	    }
+	    if (pos.slash != ref_pos.slash || pos.upper != ref_pos.upper || pos.unsafe != ref_pos.unsafe) {
+		++mismatches;
+		fwarn(stderr, __func__, "%s: offset %zu length %zu: %s json_scan_posix: "
+			      "slash: %zu upper: %zu unsafe: %zu != scalar: slash: %zu upper: %zu unsafe: %zu",
+			      what, off, len - off, json_scan_name((enum json_scan_impl)impl),
+			      pos.slash, pos.upper, pos.unsafe, ref_pos.slash, ref_pos.upper, ref_pos.unsafe);
+	    }
+	}
+	if (!every_offset) {
+	    break;
+	}
+    }
+    (void) json_scan_select(JSON_SCAN_AUTO);
+    return;
+}
+
+
+/*
+ * check_decode - check json_decode() and json_conv_string() of a JSON string
+ *
+ * given:
+ *	ptr	JSON encoded string, without the surrounding '"'s
+ *	len	length of ptr in bytes
+ *	what	description of ptr for messages
+ *
+ * NOTE: This function does not return on NULL args.
+ */
+static void
+check_decode(char const *ptr, size_t len, char const *what)
+{
+    char *ref_str = NULL;		/* json_decode() by the scalar scanner */
+    char *str = NULL;			/* json_decode() by a SIMD scanner */
+    size_t ref_len = 0;			/* length of ref_str */
+    size_t str_len = 0;			/* length of str */
+    struct json *ref_node = NULL;	/* json_conv_string() by the scalar scanner */
+    struct json *node = NULL;		/* json_conv_string() by a SIMD scanner */
+    struct json_string *ref_item = NULL;    /* JSON string in ref_node */
+    struct json_string *item = NULL;	/* JSON string in node */
+    int impl;				/* JSON string scanner */
+
+    /*
+     * firewall
+     */
+    if (ptr == NULL || what == NULL) {
+	err(11, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * decode with the scalar scanner
+     */
+    (void) json_scan_select(JSON_SCAN_SCALAR);
+    ref_str = json_decode(ptr, len, false, &ref_len);
+    ref_node = json_conv_string(ptr, len, false);
+    ref_item = &(ref_node->item.string);
+
+    /*
+     * decode with each SIMD scanner
+     */
+    for (impl = JSON_SCAN_SCALAR+1; impl < JSON_SCAN_IMPL_COUNT; ++impl) {
+	if (!json_scan_available((enum json_scan_impl)impl)) {
+	    continue;
+	}
+	(void) json_scan_select((enum json_scan_impl)impl);
+	++checks;
+
+	str = json_decode(ptr, len, false, &str_len);
+	if ((str == NULL) != (ref_str == NULL) ||
+	    (str != NULL && (str_len != ref_len || memcmp(str, ref_str, str_len) != 0))) {
+	    ++mismatches;
+	    fwarn(stderr, __func__, "%s: %s json_decode() differs: %s length %zu != scalar: %s length %zu",
+			  what, json_scan_name((enum json_scan_impl)impl),
+			  str == NULL ? "NULL" : "decoded", str_len,
+			  ref_str == NULL ? "NULL" : "decoded", ref_len);
+	}
+	if (str != NULL) {
+	    free(str);
+	    str = NULL;
+	}
+
+	node = json_conv_string(ptr, len, false);
+	item = &(node->item.string);
+	if (item->converted != ref_item->converted ||
+	    (item->converted &&
+	     (item->str_len != ref_item->str_len || memcmp(item->str, ref_item->str, item->str_len) != 0 ||
+	      item->slash != ref_item->slash || item->posix_safe != ref_item->posix_safe ||
+	      item->first_alphanum != ref_item->first_alphanum || item->upper != ref_item->upper))) {
+	    ++mismatches;
+	    fwarn(stderr, __func__, "%s: %s json_conv_string() differs: converted: %s slash: %s posix_safe: %s "
+			  "first_alphanum: %s upper: %s != scalar: converted: %s slash: %s posix_safe: %s "
+			  "first_alphanum: %s upper: %s",
+			  what, json_scan_name((enum json_scan_impl)impl),
+			  booltostr(item->converted), booltostr(item->slash), booltostr(item->posix_safe),
+			  booltostr(item->first_alphanum), booltostr(item->upper),
+			  booltostr(ref_item->converted), booltostr(ref_item->slash), booltostr(ref_item->posix_safe),
+			  booltostr(ref_item->first_alphanum), booltostr(ref_item->upper));
+	}
+	json_free(node, 0);
+	free(node);
+	node = NULL;
+    }
+
+    /*
+     * cleanup
+     */
+    if (ref_str != NULL) {
+	free(ref_str);
+	ref_str = NULL;
+    }
+    json_free(ref_node, 0);
+    free(ref_node);
+    ref_node = NULL;
+    (void) json_scan_select(JSON_SCAN_AUTO);
+    return;
+}
+
+
+/*
+ * check_line - check a line, and each JSON string in it
+ *
+ * given:
+ *	line	line to check, without the newline
+ *	len	length of line in bytes
+ *	what	description of line for messages
+ *
+ * NOTE: This function does not return on NULL args.
+ */
+static void
+check_line(char const *line, size_t len, char const *what)
+{
+    size_t start;		/* index of the opening '"' of a JSON string */
+    size_t end;			/* index of the closing '"' of a JSON string */
+
+    /*
+     * firewall
+     */
+    if (line == NULL || what == NULL) {
+	err(12, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * check the entire line
+     */
+    check_scan(line, len, true, what);
+    check_decode(line, len, what);
+
+    /*
+     * check the contents of each "..." in the line
+     */
+    for (start = 0; start < len; start = end + 1) {
+	while (start < len && line[start] != '"') {
+	    ++start;
+	}
+	if (start >= len) {
+	    break;
+	}
+	for (end = start + 1; end < len && line[end] != '"'; ++end) {
+	    if (line[end] == '\\' && end + 1 < len) {
+		++end;
+	    }
+	}
+	if (end >= len) {
+	    break;
+	}
+	check_scan(line + start + 1, end - start - 1, true, what);
+	check_decode(line + start + 1, end - start - 1, what);
+    }
+    return;
+}
+
+
+/*
+ * check_file - check each line of a file
+ *
+ * given:
+ *	path	path of the file to check
+ *
+ * NOTE: This function does not return on error.
+ */
+static void
+check_file(char const *path)
+{
+    FILE *stream = NULL;	/* open file */
+    char *data = NULL;		/* contents of the file */
+    size_t len = 0;		/* length of data in bytes */
+    size_t start;		/* start of the current line */
+    size_t end;			/* newline at the end of the current line, or len */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	err(13, __func__, "path is NULL");
+	not_reached();
+    }
+
+    /*
+     * read the file
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    stream = fopen(path, "r");
+    if (stream == NULL) {
+	errp(14, __func__, "cannot open: %s", path);
+	not_reached();
+    }
+    data = read_all(stream, &len);
+    if (data == NULL) {
+	err(15, __func__, "read_all() failed for: %s", path);
+	not_reached();
+    }
+    clearerr_or_fclose(stream);
+
+    /*
+     * check each line, and then the entire file
+     */
+    for (start = 0; start < len; start = end + 1) {
+	for (end = start; end < len && data[end] != '\n'; ++end) {
+	    ;
+	}
+	check_line(data + start, end - start, path);
+    }
+    check_scan(data, len, true, path);
+    dbg(DBG_MED, "checked %zu bytes of: %s", len, path);
+
+    free(data);
+    data = NULL;
+    return;
+}
+
+
+/*
+ * check_placed - check strings with an interesting byte at each position
+ *
+ * For each length up to JSCAN_CHK_MAX_PLACE_LEN, and each interesting byte,
+ * the byte is placed at each position of strings of both lower and UPPER
+ * case letters.  This moves each interesting byte through every position of
+ * the SIMD chunks, and through the bytes that are scanned one at a time.
+ */
+static void
+check_placed(void)
+{
+    static char const fills[] = "aA";	/* bytes that fill the rest of the string */
+    char buf[JSCAN_CHK_MAX_PLACE_LEN+1];	/* string to check */
+    size_t len;			/* length of the string */
+    size_t place;		/* where the interesting byte is placed */
+    size_t b;			/* index into interesting[] */
+    size_t f;			/* index into fills[] */
+
+    for (len = 0; len <= JSCAN_CHK_MAX_PLACE_LEN; ++len) {
+	for (f = 0; f < sizeof(fills) - 1; ++f) {
+	    memset(buf, fills[f], sizeof(buf));
+	    check_scan(buf, len, true, "filled string");
+	    check_decode(buf, len, "filled string");
+	    for (b = 0; b < sizeof(interesting); ++b) {
+		for (place = 0; place < len; ++place) {
+		    buf[place] = (char)interesting[b];
+		    check_scan(buf, len, false, "placed byte string");
+		    check_decode(buf, len, "placed byte string");
+		    buf[place] = fills[f];
+		}
+	    }
+	}
+    }
+    dbg(DBG_MED, "checked strings with placed bytes up to length %d", JSCAN_CHK_MAX_PLACE_LEN);
+    return;
+}
+
+
+/*
+ * check_random - check random strings formed from JSON encoded pieces
+ *
+ * given:
+ *	count	number of random strings to check
+ */
+static void
+check_random(intmax_t count)
+{
+    char buf[JSCAN_CHK_MAX_RANDOM_LEN+1];	/* random string */
+    char const *piece = NULL;	/* piece to add to the string */
+    size_t piece_len = 0;	/* length of piece */
+    size_t target = 0;		/* length to form */
+    size_t len = 0;		/* length of the string formed */
+    intmax_t n;
+
+    for (n = 0; n < count; ++n) {
+	target = (size_t)(next_rand() % JSCAN_CHK_MAX_RANDOM_LEN);
+	for (len = 0; len < target; len += piece_len) {
+	    piece = pieces[next_rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+	    piece_len = strlen(piece);
+	    if (len + piece_len > target) {
+		break;
+	    }
+	    memcpy(buf + len, piece, piece_len);
+	}
+	buf[len] = '\0';
+	check_scan(buf, len, true, "random string");
+	check_decode(buf, len, "random string");
+    }
+    dbg(DBG_MED, "checked %jd random strings", count);
+    return;
+}
+
+
+/*
+ * check_short_u - check that json_decode() rejects \u without 4 hex digits
+ *
+ * json_decode() used to count such a \u as (size_t)-1 bytes, so that it
+ * allocated one byte less than it then decoded.  check_random() forms such
+ * strings too, but only a memory checker notices the overflow, so here the
+ * decode must fail outright.
+ */
+static void
+check_short_u(void)
+{
+    static char const * const shorts[] = {
+	"\\u12/\x01.", "\\u1/..", "\\u123.....", "a\\u12 \\u00e9", "\\u12/\x01.\\ud83d\\ude00"
+    };
+    char *str = NULL;		/* json_decode() of a string */
+    size_t str_len = 0;		/* length of str */
+    size_t s;			/* index into shorts[] */
+    int impl;			/* JSON string scanner */
+
+    for (impl = JSON_SCAN_SCALAR; impl < JSON_SCAN_IMPL_COUNT; ++impl) {
+	if (!json_scan_available((enum json_scan_impl)impl)) {
+	    continue;
+	}
+	(void) json_scan_select((enum json_scan_impl)impl);
+	for (s = 0; s < sizeof(shorts) / sizeof(shorts[0]); ++s) {
+	    ++checks;
+	    str = json_decode(shorts[s], strlen(shorts[s]), false, &str_len);
+	    if (str != NULL) {
+		++mismatches;
+		fwarn(stderr, __func__, "%s json_decode() of short \\u string %zu was not rejected",
+			      json_scan_name((enum json_scan_impl)impl), s);
+		free(str);
+		str = NULL;
+	    }
+	}
+    }
+    (void) json_scan_select(JSON_SCAN_AUTO);
+    dbg(DBG_MED, "checked %zu short \\u strings", sizeof(shorts) / sizeof(shorts[0]));
+    return;
+}
+
+
+/*
+ * bench_secs - return the seconds since a start time
+ *
+ * given:
+ *	start	start time from clock_gettime(CLOCK_MONOTONIC)
+ *
+ * returns:
+ *	seconds since start
+ */
+static double
+bench_secs(struct timespec const *start)
+{
+    struct timespec now;	/* current time */
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/*
+ * bench - benchmark each available scanner
+ *
+ * A JSCAN_CHK_BENCH_LEN byte string of plain text with a \-escape in every
+ * few hundred bytes is scanned, decoded, and checked for POSIX safe bytes,
+ * repeat times by each scanner.  The scanning rate of each is printed.
+ *
+ * given:
+ *	repeat	number of times to scan the benchmark string
+ */
+static void
+bench(intmax_t repeat)
+{
+    static char const text[] = "The quick brown fox jumps over the lazy dog while the IOCCC judges "
+			       "read yet another entry that abuses the C preprocessor in ways that "
+			       "nobody thought were possible, and then some more text to make a "
+			       "long run of bytes that need no decoding at all\\n";
+    char *buf = NULL;		/* benchmark string */
+    char *str = NULL;		/* decoded benchmark string */
+    struct json_scan_posix pos;	/* json_scan_posix() result */
+    struct timespec start;	/* start time */
+    double special_secs;	/* seconds to scan for special bytes */
+    double decode_secs;		/* seconds to decode */
+    double posix_secs;		/* seconds to check for POSIX safe bytes */
+    double mib;			/* MiB scanned */
+    size_t len;			/* bytes of buf filled */
+    size_t off;			/* offset into buf */
+    uintmax_t sum = 0;		/* keeps the scans from being optimized away */
+    intmax_t n;
+    int impl;			/* JSON string scanner */
+
+    /*
+     * form the benchmark string
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    buf = malloc(JSCAN_CHK_BENCH_LEN + 1);
+    if (buf == NULL) {
+	errp(16, __func__, "malloc of %d bytes failed", JSCAN_CHK_BENCH_LEN + 1);
+	not_reached();
+    }
+    for (len = 0; len + sizeof(text) - 1 <= JSCAN_CHK_BENCH_LEN; len += sizeof(text) - 1) {
+	memcpy(buf + len, text, sizeof(text) - 1);
+    }
+    buf[len] = '\0';
+    mib = (double)len * (double)repeat / (1024.0 * 1024.0);
+
+    /*
+     * benchmark each scanner
+     */
+    print("%-8s %14s %14s %14s\n", "scanner", "scan MiB/s", "decode MiB/s", "posix MiB/s");
+    for (impl = JSON_SCAN_SCALAR; impl < JSON_SCAN_IMPL_COUNT; ++impl) {
+	if (!json_scan_available((enum json_scan_impl)impl)) {
+	    continue;
+	}
+	(void) json_scan_select((enum json_scan_impl)impl);
+
+	(void) clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < repeat; ++n) {
+	    for (off = 0; off < len; off += json_scan_special(buf + off, len - off) + 1) {
+		++sum;
+	    }
+	}
+	special_secs = bench_secs(&start);
+
+	(void) clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < repeat; ++n) {
+	    str = json_decode(buf, len, false, NULL);
+	    if (str == NULL) {
+		err(17, __func__, "json_decode() of the benchmark string failed");
+		not_reached();
+	    }
+	    sum += (uintmax_t)str[0];
+	    free(str);
+	    str = NULL;
+	}
+	decode_secs = bench_secs(&start);
+
+	(void) clock_gettime(CLOCK_MONOTONIC, &start);
+	for (n = 0; n < repeat; ++n) {
+	    json_scan_posix(buf, len, &pos);
+	    sum += pos.unsafe;
+	}
+	posix_secs = bench_secs(&start);
+
+	print("%-8s %14.1f %14.1f %14.1f\n", json_scan_name((enum json_scan_impl)impl),
+	      mib / special_secs, mib / decode_secs, mib / posix_secs);
+    }
+    dbg(DBG_HIGH, "benchmark sum: %ju", sum);
+    (void) json_scan_select(JSON_SCAN_AUTO);
+
+    free(buf);
+    buf = NULL;
+    return;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *	 Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = JSCAN_CHK_BASENAME;
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT, JSCAN_CHK_RANDOM,
+	    JSCAN_CHK_BENCH_LEN, JSCAN_CHK_REPEAT, JSCAN_CHK_BASENAME, JSCAN_CHK_VERSION,
+	    JPARSE_UTILS_VERSION, JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
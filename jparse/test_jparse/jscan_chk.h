@@ -0,0 +1,97 @@
+/*
+ * jscan_chk - check the SIMD JSON string scanners against the scalar scanner
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_JSCAN_CHK_H)
+#    define  INCLUDE_JSCAN_CHK_H
+
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#if defined(INTERNAL_INCLUDE)
+#include "../../dbg/dbg.h"
+#elif defined(INTERNAL_INCLUDE_2)
+#include "../dbg/dbg.h"
+#else
+#include <dbg.h>
+#endif
+
+
+/*
+ * util - common utility functions for the JSON parser
+ */
+#include "../util.h"
+
+/*
+ * jparse - JSON parser
+ */
+#include "../jparse.h"
+
+/*
+ * version - JSON parser API and tool version
+ */
+#include "../version.h"
+
+/*
+ * json_utf8.h - JSON UTF-8 decoder
+ */
+#include "../json_utf8.h"
+
+/*
+ * official jscan_chk version
+ */
+#define JSCAN_CHK_VERSION "1.0.1 2026-10-18"	/* format: major.minor YYYY-MM-DD */
+
+/*
+ * jscan_chk tool basename
+ */
+#define JSCAN_CHK_BASENAME "jscan_chk"
+
+/*
+ * definitions
+ */
+#define JSCAN_CHK_RANDOM (10000)	/* default number of random strings to check */
+#define JSCAN_CHK_MAX_RANDOM_LEN (200)	/* maximum length of a random string */
+#define JSCAN_CHK_MAX_PLACE_LEN (100)	/* maximum length of a string with one placed byte */
+#define JSCAN_CHK_SEED (0x1e0cccULL)	/* seed of the random string generator */
+#define JSCAN_CHK_BENCH_LEN (1024*1024)	/* length of the benchmark string */
+#define JSCAN_CHK_REPEAT (100)		/* default number of times to scan the benchmark string */
+
+
+#endif /* INCLUDE_JSCAN_CHK_H */
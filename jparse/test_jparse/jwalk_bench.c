@@ -0,0 +1,509 @@
+/*
+ * jwalk_bench - time walks of a deeply nested JSON parse tree
+ *
+ * This tool forms a JSON parse tree of deeply nested JSON arrays and times
+ * json_walk(), json_tree_walk(), json_tree_print(), json_sem_check() and
+ * json_tree_free() on it.  As these functions walk the tree with their own
+ * stack instead of by recursion, a very deep tree must not crash them.  The
+ * number of nodes each walk visits is checked, so this tool is also a test
+ * of the JSON parse tree walker.
+ *
+ * Copyright (c) 2022-2026 by Cody Boone Ferguson and Landon Curt Noll. All
+ * rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE OR JSON.
+ *
+ * This JSON parser, library and tools were co-developed in 2022-2026 by Cody Boone
+ * Ferguson and Landon Curt Noll:
+ *
+ *  @xexyl
+ *	https://xexyl.net		Cody Boone Ferguson
+ *	https://ioccc.xexyl.net
+ * and:
+ *	chongo (Landon Curt Noll, http://www.isthe.com/chongo/index.html) /\oo/\
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * "Share and Enjoy!"
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <locale.h>
+#include <time.h>
+#include <limits.h>
+
+/*
+ * jwalk_bench - time walks of a deeply nested JSON parse tree
+ */
+#include "jwalk_bench.h"
+
+/*
+ * definitions
+ */
+#define REQUIRED_ARGS (0)	/* number of required arguments on the command line */
+
+
+/*
+ * usage message
+ *
+ * Use the usage() function to print the usage_msg([0-9]?)+ strings.
+ */
+static const char * const usage_msg =
+    "usage: %s [-h] [-v level] [-J level] [-V] [-n depth]\n"
+    "\n"
+    "\t-h\t\tprint help message and exit\n"
+    "\t-v level\tset verbosity level (def level: %d)\n"
+    "\t-J level\tset JSON verbosity level (def level: %d)\n"
+    "\t-V\t\tprint version strings and exit\n"
+    "\t-n depth\tdepth of nested JSON arrays (def: %d)\n"
+    "\n"
+    "Exit codes:\n"
+    "\t0\t\tall is OK\n"
+    "\t1\t\ta walk did not visit every node, or the semantic check found an error\n"
+    "\t2\t\t-h and help string printed or -V and version strings printed\n"
+    "\t3\t\tcommand line error\n"
+    "\t>=10\t\tinternal error\n"
+    "\n"
+    "%s version: %s\n"
+    "jparse utils version: %s\n"
+    "jparse UTF-8 version: %s\n"
+    "jparse library version: %s";
+
+
+/*
+ * forward declarations
+ */
+static struct json *form_nested(intmax_t depth);
+static struct json_sem *form_sem(intmax_t depth);
+static void count_pre(struct json *node, unsigned int depth, void *ctx);
+static void count_post(struct json *node, unsigned int depth, void *ctx);
+static void vcount_node(struct json *node, unsigned int depth, va_list ap);
+static double elapsed(struct timespec const *start, struct timespec const *end);
+static void usage(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+/*
+ * node counts of a json_walk()
+ */
+struct count
+{
+    intmax_t pre;		/* nodes visited before the nodes below them */
+    intmax_t post;		/* nodes visited after the nodes below them */
+    unsigned int max_depth;	/* deepest node visited */
+};
+
+
+int
+main(int argc, char *argv[])
+{
+    char const *program = NULL;	/* our name */
+    extern char *optarg;	/* option argument */
+    extern int optind;		/* argv index of the next arg */
+    int arg_count = 0;		/* number of args to process */
+    intmax_t depth = JWALK_BENCH_DEPTH;	/* depth of nested JSON arrays */
+    bool opt_error = false;	/* fchk_inval_opt() return */
+    struct json *tree = NULL;	/* JSON parse tree of nested JSON arrays */
+    struct json_sem *sem = NULL;	/* JSON semantic table of the nested JSON arrays */
+    struct dyn_array *count_err = NULL;	/* JSON semantic count errors */
+    struct dyn_array *val_err = NULL;	/* JSON semantic validation errors */
+    uintmax_t sem_errors = 0;	/* JSON semantic errors */
+    struct count count;		/* json_walk() node counts */
+    intmax_t vcount = 0;	/* json_tree_walk() node count */
+    FILE *devnull = NULL;	/* /dev/null stream for json_tree_print() */
+    struct timespec start;	/* start of a timed walk */
+    struct timespec end;	/* end of a timed walk */
+    intmax_t wrong = 0;		/* number of walks that went wrong */
+    int i;
+
+    /*
+     * use default locale based on LANG
+     */
+    (void) setlocale(LC_ALL, "");
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:J:Vn:")) != -1) {
+	switch (i) {
+	case 'h':		/* -h - print help to stderr and exit 0 */
+	    usage(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':		/* -v verbosity */
+	    /*
+	     * parse verbosity
+	     */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'J':		/* -J json_verbosity */
+	    /*
+	     * parse JSON verbosity
+	     */
+	    json_verbosity_level = parse_verbosity(optarg);
+	    if (json_verbosity_level < 0) {
+		usage(3, program, "invalid -J json_verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':		/* -V - print version strings and exit */
+	    print("jwalk_bench version %s\n", JWALK_BENCH_VERSION);
+	    print("jparse utils version: %s\n", JPARSE_UTILS_VERSION);
+	    print("jparse UTF-8 version: %s\n", JPARSE_UTF8_VERSION);
+	    print("jparse library version: %s\n", JPARSE_LIBRARY_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'n':		/* -n depth */
+	    if (!string_to_intmax(optarg, &depth) || depth <= 0 || depth > (intmax_t)UINT_MAX) {
+		usage(3, program, "invalid -n depth"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':   /* option requires an argument */
+	case '?':   /* illegal option */
+	default:    /* anything else but should not actually happen */
+	    opt_error = fchk_inval_opt(stderr, program, i, optopt);
+	    if (opt_error) {
+		usage(3, program, ""); /*ooo*/
+		not_reached();
+	    } else {
+		fwarn(stderr, __func__, "getopt() return: %c optopt: %c", (char)i, (char)optopt);
+	    }
+	    break;
+	}
+    }
+    arg_count = argc - optind;
+    if (arg_count != REQUIRED_ARGS) {
+	usage(3, program, "wrong number of arguments"); /*ooo*/
+	not_reached();
+    }
+
+    /*
+     * form the nested JSON arrays
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    tree = form_nested(depth);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("form:      %jd nested arrays: %.3f msec\n", depth, elapsed(&start, &end) * 1000.0);
+
+    /*
+     * count nodes with json_walk()
+     */
+    memset(&count, 0, sizeof(count));
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    json_walk(tree, JSON_INFINITE_DEPTH, 0, count_pre, count_post, &count);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("json_walk: %jd nodes: %.3f msec\n", count.pre, elapsed(&start, &end) * 1000.0);
+    if (count.pre != depth || count.post != depth || count.max_depth != (unsigned int)(depth-1)) {
+	warn(__func__, "json_walk() visited %jd/%jd nodes to depth %u, expected %jd nodes to depth %jd",
+		       count.pre, count.post, count.max_depth, depth, depth-1);
+	++wrong;
+    }
+
+    /*
+     * count nodes with json_tree_walk()
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    json_tree_walk(tree, JSON_INFINITE_DEPTH, 0, true, vcount_node, &vcount);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("tree_walk: %jd nodes: %.3f msec\n", vcount, elapsed(&start, &end) * 1000.0);
+    if (vcount != depth) {
+	warn(__func__, "json_tree_walk() visited %jd nodes, expected %jd", vcount, depth);
+	++wrong;
+    }
+
+    /*
+     * print the tree to /dev/null
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    devnull = fopen("/dev/null", "w");
+    if (devnull == NULL) {
+	errp(10, __func__, "cannot open /dev/null");
+	not_reached();
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    json_tree_print(tree, JSON_INFINITE_DEPTH, devnull, JSON_DBG_FORCED);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("print:     %jd nodes: %.3f msec\n", depth, elapsed(&start, &end) * 1000.0);
+    (void) fclose(devnull);
+    devnull = NULL;
+
+    /*
+     * semantic check the tree
+     */
+    sem = form_sem(depth);
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    sem_errors = json_sem_check(tree, JSON_INFINITE_DEPTH, sem, &count_err, &val_err, NULL);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("sem_check: %jd nodes: %.3f msec\n", depth, elapsed(&start, &end) * 1000.0);
+    if (sem_errors > 0) {
+	warn(__func__, "json_sem_check() found %ju errors", sem_errors);
+	++wrong;
+    }
+    free_count_err(count_err);
+    count_err = NULL;
+    free_val_err(val_err);
+    val_err = NULL;
+    free(sem);
+    sem = NULL;
+
+    /*
+     * free the tree
+     */
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    json_tree_free(tree, JSON_INFINITE_DEPTH);
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    print("free:      %jd nodes: %.3f msec\n", depth, elapsed(&start, &end) * 1000.0);
+    free(tree);
+    tree = NULL;
+    if (wrong > 0) {
+	warn(__func__, "%jd walks went wrong", wrong);
+    }
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(wrong > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * form_nested - form a JSON parse tree of nested empty JSON arrays
+ *
+ * The JSON parse tree is that of [[[ ... ]]] with depth JSON arrays.  It is
+ * formed directly rather than parsed, as the parser limits nesting.
+ *
+ * given:
+ *	depth	    number of nested JSON arrays
+ *
+ * returns:
+ *	JSON parse tree of the outermost JSON array
+ *
+ * NOTE: This function does not return on error.
+ */
+static struct json *
+form_nested(intmax_t depth)
+{
+    struct json *node = NULL;		/* JSON array formed */
+    struct json *elements = NULL;	/* JSON elements of the next JSON array out */
+    intmax_t j;
+
+    /*
+     * form the innermost JSON array and then each JSON array around it
+     */
+    node = json_parse_array(json_create_elements());
+    for (j=1; j < depth; ++j) {
+	elements = json_create_elements();
+	if (json_elements_add_value(elements, node) == NULL) {
+	    err(11, __func__, "json_elements_add_value() failed at depth %jd", depth-j);
+	    not_reached();
+	}
+	node = json_parse_array(elements);
+    }
+    return node;
+}
+
+
+/*
+ * form_sem - form a JSON semantic table of nested JSON arrays
+ *
+ * given:
+ *	depth	    number of nested JSON arrays
+ *
+ * returns:
+ *	allocated JSON semantic table with a JTYPE_ARRAY entry for each depth
+ *
+ * NOTE: This function does not return on error.
+ */
+static struct json_sem *
+form_sem(intmax_t depth)
+{
+    struct json_sem *sem = NULL;	/* JSON semantic table to return */
+    intmax_t j;
+
+    /*
+     * allocate the JSON semantic table, including its JTYPE_UNSET end
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    sem = calloc((size_t)depth + 1, sizeof(*sem));
+    if (sem == NULL) {
+	errp(12, __func__, "calloc of %jd JSON semantic table entries failed", depth + 1);
+	not_reached();
+    }
+
+    /*
+     * one JSON array at each depth
+     */
+    for (j=0; j < depth; ++j) {
+	sem[j].depth = (unsigned int)j;
+	sem[j].type = JTYPE_ARRAY;
+	sem[j].min = 1;
+	sem[j].max = 1;
+	sem[j].sem_index = (int)j;
+    }
+    sem[depth].type = JTYPE_UNSET;
+    sem[depth].sem_index = -1;
+    return sem;
+}
+
+
+/*
+ * count_pre - count a JSON parse tree node before the nodes below it
+ *
+ * given:
+ *	node	JSON parse tree node
+ *	depth	tree depth of node (0 ==> top of tree)
+ *	ctx	pointer to struct count
+ */
+static void
+count_pre(struct json *node, unsigned int depth, void *ctx)
+{
+    struct count *count = (struct count *)ctx;	/* node counts */
+
+    UNUSED_ARG(node);
+    ++count->pre;
+    if (depth > count->max_depth) {
+	count->max_depth = depth;
+    }
+    return;
+}
+
+
+/*
+ * count_post - count a JSON parse tree node after the nodes below it
+ *
+ * given:
+ *	node	JSON parse tree node
+ *	depth	tree depth of node (0 ==> top of tree)
+ *	ctx	pointer to struct count
+ */
+static void
+count_post(struct json *node, unsigned int depth, void *ctx)
+{
+    struct count *count = (struct count *)ctx;	/* node counts */
+
+    UNUSED_ARG(node);
+    UNUSED_ARG(depth);
+    ++count->post;
+    return;
+}
+
+
+/*
+ * vcount_node - count a JSON parse tree node for json_tree_walk()
+ *
+ * given:
+ *	node	JSON parse tree node
+ *	depth	tree depth of node (0 ==> top of tree)
+ *	ap	variable argument list, required ap args:
+ *
+ *		pcount	    pointer to intmax_t node count
+ */
+static void
+vcount_node(struct json *node, unsigned int depth, va_list ap)
+{
+    va_list ap2;		/* copy of va_list ap */
+    intmax_t *pcount = NULL;	/* node count */
+
+    UNUSED_ARG(node);
+    UNUSED_ARG(depth);
+    va_copy(ap2, ap);
+    pcount = va_arg(ap2, intmax_t *);
+    va_end(ap2); /* stdarg variable argument list cleanup */
+    if (pcount != NULL) {
+	++(*pcount);
+    }
+    return;
+}
+
+
+/*
+ * elapsed - return the number of seconds between two times
+ *
+ * given:
+ *	start	start time
+ *	end	end time
+ *
+ * returns:
+ *	seconds from start to end
+ */
+static double
+elapsed(struct timespec const *start, struct timespec const *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1000000000.0;
+}
+
+
+/*
+ * usage - print usage to stderr
+ *
+ * Example:
+ *      usage(3, program, "wrong number of arguments");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * NOTE: We warn with extra newlines to help internal fault messages stand out.
+ *       Normally one should NOT include newlines in warn messages.
+ *
+ * This function does not return.
+ */
+static void
+usage(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (prog == NULL) {
+	prog = JWALK_BENCH_BASENAME;
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", prog);
+    }
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage(): program was NULL, forcing it to be: %s\n", str);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, JSON_DBG_DEFAULT, JWALK_BENCH_DEPTH,
+	    JWALK_BENCH_BASENAME, JWALK_BENCH_VERSION, JPARSE_UTILS_VERSION,
+	    JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
@@ -39,7 +39,7 @@
 
 # setup
 #
-export RUN_JPARSE_TESTS_VERSION="2.0.1 2025-09-01"
+export RUN_JPARSE_TESTS_VERSION="2.0.7 2026-10-18"
 export USAGE="usage: $0 [-h] [-V] [-v level] [-D dbg_level] [-J json_level] [-j jparse] [-p pr_jparse_test] [-c jnum_chk] [-Z topdir]
 
     -h			print help and exit
@@ -72,6 +72,9 @@ export TOPDIR=
 export JPARSE="./jparse"
 export PR_JPARSE_TEST="./test_jparse/pr_jparse_test"
 export JNUM_CHK="./test_jparse/jnum_chk"
+export JSCAN_CHK="./test_jparse/jscan_chk"
+export JOBJECT_BENCH="./test_jparse/jobject_bench"
+export JWALK_BENCH="./test_jparse/jwalk_bench"
 
 
 # parse args
@@ -254,6 +257,45 @@ elif [[ ! -x "$JNUM_CHK" ]]; then
     EXIT_CODE="5"
 fi
 
+# jscan_chk
+#
+if [[ ! -e "$JSCAN_CHK" ]]; then
+    echo "$0: ERROR: $JSCAN_CHK file not found" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -f "$JSCAN_CHK" ]]; then
+    echo "$0: ERROR: $JSCAN_CHK is not a regular file" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -x "$JSCAN_CHK" ]]; then
+    echo "$0: ERROR: $JSCAN_CHK is not executable" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+fi
+
+# jobject_bench
+#
+if [[ ! -e "$JOBJECT_BENCH" ]]; then
+    echo "$0: ERROR: $JOBJECT_BENCH file not found" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -f "$JOBJECT_BENCH" ]]; then
+    echo "$0: ERROR: $JOBJECT_BENCH is not a regular file" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -x "$JOBJECT_BENCH" ]]; then
+    echo "$0: ERROR: $JOBJECT_BENCH is not executable" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+fi
+
+# jwalk_bench
+#
+if [[ ! -e "$JWALK_BENCH" ]]; then
+    echo "$0: ERROR: $JWALK_BENCH file not found" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -f "$JWALK_BENCH" ]]; then
+    echo "$0: ERROR: $JWALK_BENCH is not a regular file" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+elif [[ ! -x "$JWALK_BENCH" ]]; then
+    echo "$0: ERROR: $JWALK_BENCH is not executable" | tee -a -- "$LOGFILE"
+    EXIT_CODE="5"
+fi
+
 
 # test_jparse/jparse_test.sh
 # #
@@ -419,6 +461,145 @@ else
 fi
 
 
+# jscan_chk
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: $JSCAN_CHK -J $J_FLAG -v $V_FLAG test_jparse/json_teststr.txt test_jparse/json_teststr_fail.txt" | tee -a -- "$LOGFILE"
+"$JSCAN_CHK" -J "${J_FLAG}" -v "$V_FLAG" test_jparse/json_teststr.txt test_jparse/json_teststr_fail.txt 2>&1 | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: $JSCAN_CHK non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JSCAN_CHK non-zero exit code: $status"
+    EXIT_CODE="28"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo "FAILED: $JSCAN_CHK -J ${J_FLAG} -v $V_FLAG test_jparse/json_teststr.txt test_jparse/json_teststr_fail.txt" | tee -a -- "$LOGFILE"
+else
+    echo "PASSED: $JSCAN_CHK -J ${J_FLAG} -v $V_FLAG test_jparse/json_teststr.txt test_jparse/json_teststr_fail.txt" | tee -a -- "$LOGFILE"
+fi
+
+
+# jobject_bench
+#
+for A_FLAG in "" "-a"; do
+    echo | tee -a -- "$LOGFILE"
+    echo "RUNNING: $JOBJECT_BENCH -J $J_FLAG -v $V_FLAG $A_FLAG -n 10000 -s 100" | tee -a -- "$LOGFILE"
+    # shellcheck disable=SC2086
+    "$JOBJECT_BENCH" -J "${J_FLAG}" -v "$V_FLAG" $A_FLAG -n 10000 -s 100 2>&1 | tee -a -- "$LOGFILE"
+    status="${PIPESTATUS[0]}"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: $JOBJECT_BENCH non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+	FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JOBJECT_BENCH $A_FLAG non-zero exit code: $status"
+	EXIT_CODE="29"
+	echo | tee -a -- "$LOGFILE"
+	echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+	echo "FAILED: $JOBJECT_BENCH -J ${J_FLAG} -v $V_FLAG $A_FLAG -n 10000 -s 100" | tee -a -- "$LOGFILE"
+    else
+	echo "PASSED: $JOBJECT_BENCH -J ${J_FLAG} -v $V_FLAG $A_FLAG -n 10000 -s 100" | tee -a -- "$LOGFILE"
+    fi
+done
+
+
+# jwalk_bench
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: $JWALK_BENCH -J $J_FLAG -v $V_FLAG -n 100000" | tee -a -- "$LOGFILE"
+"$JWALK_BENCH" -J "${J_FLAG}" -v "$V_FLAG" -n 100000 2>&1 | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: $JWALK_BENCH non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JWALK_BENCH non-zero exit code: $status"
+    EXIT_CODE="30"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo "FAILED: $JWALK_BENCH -J ${J_FLAG} -v $V_FLAG -n 100000" | tee -a -- "$LOGFILE"
+else
+    echo "PASSED: $JWALK_BENCH -J ${J_FLAG} -v $V_FLAG -n 100000" | tee -a -- "$LOGFILE"
+fi
+
+
+# jparse -j - parse the good JSON files with a pool of worker threads
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: $JPARSE -J $J_FLAG -v $V_FLAG -j 4 test_jparse/test_JSON/good/*.json" | tee -a -- "$LOGFILE"
+"$JPARSE" -J "${J_FLAG}" -v "$V_FLAG" -j 4 test_jparse/test_JSON/good/*.json 2>&1 | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: $JPARSE -j 4 non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JPARSE -j 4 non-zero exit code: $status"
+    EXIT_CODE="31"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo "FAILED: $JPARSE -J ${J_FLAG} -v $V_FLAG -j 4 test_jparse/test_JSON/good/*.json" | tee -a -- "$LOGFILE"
+else
+    echo "PASSED: $JPARSE -J ${J_FLAG} -v $V_FLAG -j 4 test_jparse/test_JSON/good/*.json" | tee -a -- "$LOGFILE"
+fi
+
+
+# jparse -j - the diagnostics of a mix of good, bad and missing files must be
+# the same, in the same order, with a pool of worker threads as without one
+#
+# NOTE: -v 0 and -J 0 are used as the debug messages of the pool itself differ.
+#
+MIXED_ARGS=()
+while read -r arg; do
+    MIXED_ARGS+=("$arg")
+done < <(paste -d '\n' <(find test_jparse/test_JSON/good -name '*.json' -print | LC_ALL=C sort | head -n 25) \
+			<(find test_jparse/test_JSON/bad -name '*.json' -print | LC_ALL=C sort | head -n 25))
+MIXED_ARGS+=("test_jparse/test_JSON/no_such_file.json" "${MIXED_ARGS[@]}")
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: $JPARSE -J 0 -v 0 -j 4 on ${#MIXED_ARGS[@]} good, bad and missing files, comparing stderr with -j 1" | tee -a -- "$LOGFILE"
+J1_STDERR=$("$JPARSE" -J 0 -v 0 -j 1 -- "${MIXED_ARGS[@]}" 2>&1 >/dev/null)
+J1_STATUS="$?"
+J4_STDERR=$("$JPARSE" -J 0 -v 0 -j 4 -- "${MIXED_ARGS[@]}" 2>&1 >/dev/null)
+J4_STATUS="$?"
+if [[ $J1_STATUS -ne 1 || $J4_STATUS -ne 1 || "$J1_STDERR" != "$J4_STDERR" ]]; then
+    echo "$0: ERROR: $JPARSE -j 1 exit code: $J1_STATUS and -j 4 exit code: $J4_STATUS != 1 or their stderr differs" 1>&2 | tee -a -- "$LOGFILE"
+    diff <(echo "$J1_STDERR") <(echo "$J4_STDERR") 2>&1 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JPARSE -j 4 stderr differs from -j 1"
+    EXIT_CODE="32"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo "FAILED: $JPARSE -J 0 -v 0 -j 4 stderr on good, bad and missing files is the same as with -j 1" | tee -a -- "$LOGFILE"
+else
+    echo "PASSED: $JPARSE -J 0 -v 0 -j 4 stderr on good, bad and missing files is the same as with -j 1" | tee -a -- "$LOGFILE"
+fi
+
+# jparse -l -j - a JSON string with an invalid \-escape must make its file
+# invalid, and not end the batch: the other files must still be checked
+#
+BATCH_ARGS=("test_jparse/test_JSON/good/200.json"
+	    "test_jparse/test_JSON/bad/n_string_escape_x.json"
+	    "test_jparse/test_JSON/good/12345678-1234-4321-abcd-1234567890ab-2-auth.json"
+	    "test_jparse/test_JSON/bad/n_string_1_surrogate_then_escape_u1.json"
+	    "test_jparse/test_JSON/good/12345678-1234-4321-abcd-1234567890ab-2-info.json"
+	    "test_jparse/test_JSON/bad/n_array_double_comma.json")
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: $JPARSE -J 0 -v 0 -l -j 2 on ${#BATCH_ARGS[@]} files with invalid \\-escapes, comparing stderr with the args" | tee -a -- "$LOGFILE"
+BATCH_STDERR=$(printf '%s\n' "${BATCH_ARGS[@]}" | "$JPARSE" -J 0 -v 0 -l -j 2 2>&1 >/dev/null)
+BATCH_STATUS="$?"
+ARGS_STDERR=$("$JPARSE" -J 0 -v 0 -j 1 -- "${BATCH_ARGS[@]}" 2>&1 >/dev/null)
+ARGS_STATUS="$?"
+BATCH_ERRORS=$(grep -c '^syntax error in file test_jparse/test_JSON/bad/' <<< "$BATCH_STDERR")
+if [[ $BATCH_STATUS -ne 1 || $ARGS_STATUS -ne 1 || $BATCH_ERRORS -ne 3 || "$BATCH_STDERR" != "$ARGS_STDERR" ]]; then
+    echo "$0: ERROR: $JPARSE -l -j 2 exit code: $BATCH_STATUS and -j 1 exit code: $ARGS_STATUS != 1," \
+	 "or $BATCH_ERRORS syntax errors != 3, or their stderr differs" 1>&2 | tee -a -- "$LOGFILE"
+    diff <(echo "$ARGS_STDERR") <(echo "$BATCH_STDERR") 2>&1 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    $JPARSE -l -j 2 did not check every file of a batch with invalid \\-escapes"
+    EXIT_CODE="33"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo "FAILED: $JPARSE -J 0 -v 0 -l -j 2 checks every file of a batch with invalid \\-escapes" | tee -a -- "$LOGFILE"
+else
+    echo "PASSED: $JPARSE -J 0 -v 0 -l -j 2 checks every file of a batch with invalid \\-escapes" | tee -a -- "$LOGFILE"
+fi
+
 # report overall status
 #
 if [[ $EXIT_CODE -ne 0 ]]; then
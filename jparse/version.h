@@ -55,17 +55,17 @@
  *
  * NOTE: this should match the latest Release string in CHANGES.md
  */
-#define JPARSE_REPO_VERSION "2.5.10 2026-06-13"		/* format: major.minor YYYY-MM-DD */
+#define JPARSE_REPO_VERSION "2.6.15 2026-10-18"		/* format: major.minor YYYY-MM-DD */
 
 /*
  * official jparse version
  */
-#define JPARSE_TOOL_VERSION "2.0.3 2025-10-02"		/* format: major.minor YYYY-MM-DD */
+#define JPARSE_TOOL_VERSION "2.0.6 2026-10-18"		/* format: major.minor YYYY-MM-DD */
 
 /*
  * official JSON parser version
  */
-#define JPARSE_LIBRARY_VERSION "2.4.4 2026-06-13"	/* library version format: major.minor YYYY-MM-DD */
+#define JPARSE_LIBRARY_VERSION "2.5.15 2026-10-18"	/* library version format: major.minor YYYY-MM-DD */
 
 /*
  * official utility functions (util.c) version
@@ -136,11 +136,17 @@ static const char * const usage_msg0 =
     "\t-Y\t\tforce answer yes even when using -i answers (use with EXTREME CAUTION!)";
 static const char * const usage_msg1 =
     "\t-t tar\t\tpath to tar(1) that supports the -J (xz) option (def: %s)\n"
-    "\t-l ls\t\tpath to ls(1) (def: %s)\n"
+    "\t-l ls\t\tignored: the submission directory is listed without running ls(1)\n"
     "\t-T txzchk\tpath to txzchk(1) (def: %s)\n"
     "\t-e\t\tentertainment mode (for txzchk)\n"
     "\t-f feathers\tdefine how many feathers is feathery (for -e)\n"
-    "\t-F fnamchk\tpath to fnamchk(1) (used by txzchk) (def: %s)";
+    "\t-F fnamchk\tignored: the tarball filename is checked without running fnamchk(1)\n"
+    "\t-p\t\tcheck in-process and form the tarball instead of running chksubmit(1),\n"
+    "\t\t\t    tar(1) and txzchk(1)\n"
+    "\t\t\t    NOTE: -p also reports the time taken by each stage of forming the tarball\n"
+    "\t-j jobs\t\twith -p, compress the tarball with jobs threads (def: number of CPUs)\n"
+    "\t\t\t    NOTE: the tarball is the same for any number of jobs\n"
+    "\t-L listing\twrite a JSON listing of the submission directory to listing";
 static const char * const usage_msg2 =
     "\t-C chksubmit\tpath to chksubmit(1) (def: %s)\n"
     "\t-m make\t\tpath to GNU compatible make(1) (def: %s)";
@@ -220,6 +226,11 @@ static int answersfd = -1;              /* -i answers fd */
 static struct stat answers_st;
 static long answer_seed = NO_SEED;	/* if != 0 ==> srandom argument used to seed generation of answers */
 static FILE *manifest = NULL;           /* manifest file */
+static bool in_process = false;		/* true ==> -p: check in-process, do not run chksubmit, tar and txzchk */
+static unsigned int xz_jobs = 0;	/* -j: threads to compress the tarball with, 0 ==> number of CPUs */
+static char const *listing = NULL;	/* -L: where to write a JSON listing of the submission directory, NULL ==> none */
+static struct stage_time stage_time[MAX_STAGES];	/* time taken by each stage of forming the tarball */
+static int stage_count = 0;		/* number of stage_time[] recorded */
 
 
 /*
@@ -241,7 +252,7 @@ static void check_submission_dir(struct walk_stat *wstat, char const *context, s
 				 char *submit_path, char const *make, RuleCount *size, struct walk_stat *wstat2);
 static void usage(int exitcode, char const *program, char const *str) __attribute__((noreturn));
 static void mkiocccentry_sanity_chks(struct info *infop, char const *workdir, char *tar,
-				     char *ls, char *txzchk, char *fnamchk, char *chksubmit,
+				     char *txzchk, char *chksubmit,
                                      char *make, char *rm);
 static char *prompt(char const *str, size_t *lenp);
 static char *get_contest_id(bool *testp, char const *uuidf, char *uuidstr);
@@ -258,13 +269,16 @@ static char *get_title(struct info *infop);
 static char *get_abstract(struct info *infop);
 static bool noprompt_yes_or_no(void);
 static int get_author_info(struct author **author_set_p);
-static void verify_submission_dir(char const *submission_dir, char const *ls);
+static void verify_submission_dir(char const *submission_dir, struct walk_stat *swstat);
 static void write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop,
-			     char const *submission_dir, char const *chksubmit);
+			     char const *submission_dir, char const *chksubmit, struct walk_stat *swstat);
 static void form_auth(struct auth *authp, struct info *infop, int author_count, struct author *authorp);
 static void form_info(struct info *infop);
 static void form_tarball(char const *workdir, char const *submission_dir, char const *tarball_path, char const *tar,
-			 char const *ls, char const *txzchk, char const *fnamchk, bool test_mode);
+			 char const *txzchk, bool test_mode, struct walk_stat *swstat);
+static double stage_start(void);
+static void stage_end(char const *name, double start);
+static void show_stage_times(void);
 static void remind_user(char const *workdir, char const *submission_dir, char const *tar, char const *tarball_path,
 			bool test_mode, unsigned int submit_slot);
 static void show_registration_url(void);
@@ -293,9 +307,7 @@ main(int argc, char *argv[])
     char *topdir_file = NULL;                   /* to test for topdir/{Makefile,prog.c,remarks.md} */
     char *tar = TAR_PATH_0;			/* path to tar executable that supports the -J (xz) option */
     char *rm = RM_PATH_0;                       /* path to rm tool */
-    char *ls = LS_PATH_0;			/* path to ls executable */
     char *txzchk = TXZCHK_PATH_0;		/* path to txzchk executable */
-    char *fnamchk = FNAMCHK_PATH_0;		/* path to fnamchk executable */
     char *chksubmit = CHKSUBMIT_PATH_0;		/* path to chksubmit executable */
     char *make = MAKE_PATH_0;                   /* path to make(1) executable */
     char *answers = NULL;			/* path to the answers file (recording input given on stdin) */
@@ -316,16 +328,16 @@ main(int argc, char *argv[])
     bool force_delete = false;                  /* true ==> force delete workdir/slot directory if it exists */
     RuleCount size;				/* rule_count() processing results */
     bool found_tar = false;                     /* for find_utils */
-    bool found_ls = false;                      /* for find_utils */
     bool found_txzchk = false;                  /* for find_utils */
-    bool found_fnamchk = false;                 /* for find_utils */
     bool found_make = false;                    /* for find_utils */
     bool found_rm = false;                      /* for find_utils */
     bool found_chksubmit = false;               /* for find_utils */
     bool opt_error = false;			/* fchk_inval_opt() return */
+    intmax_t jobs = 0;				/* -j jobs */
     /**/
     struct walk_stat wstat;			/* walk_stat being processed */
     struct walk_stat wstat2;                    /* will be initialised in submission directory */
+    struct walk_stat wstat3;			/* -p submission directory as walked by the chkentry -S checks */
     struct walk_set *wset_p = NULL;		/* pointer to a walk set */
     char const *context = NULL;			/* string describing context (tool & options) for debugging purposes */
     bool skip_add_ret = false;			/* return from skip_add() */
@@ -377,7 +389,7 @@ main(int argc, char *argv[])
      */
     input_stream = stdin;	/* default to reading from standard in */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:J:qVt:l:a:i:A:WT:ef:F:C:yYds:m:I:u:U:xr:M:X:")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:J:qVt:l:a:i:A:WT:ef:F:C:yYds:m:I:u:U:xr:M:X:pj:L:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 2 */
 	    usage(2, program, ""); /*ooo*/
@@ -420,8 +432,21 @@ main(int argc, char *argv[])
 	case 't':		/* -t /path/to/tar */
 	    tar = optarg;
 	    break;
-	case 'l':		/* -l /path/to/ls */
-	    ls = optarg;
+	case 'l': /* -l ls - ignored: we list the submission directory ourselves */
+	    dbg(DBG_LOW, "ignoring -l %s: the submission directory is listed without running ls", optarg);
+	    break;
+	case 'L':		/* -L listing - write a JSON listing of the submission directory */
+	    listing = optarg;
+	    break;
+	case 'p':		/* -p - check in-process and report the time of each stage */
+	    in_process = true;
+	    break;
+	case 'j':		/* -j jobs - threads to compress the tarball with */
+	    if (!string_to_intmax(optarg, &jobs) || jobs <= 0 || jobs > XZ_ENC_MAX_THREADS) {
+		usage(3, program, "invalid -j jobs"); /*ooo*/
+		not_reached();
+	    }
+	    xz_jobs = (unsigned int)jobs;
 	    break;
 	case 'A':		/* -A answers overwrite answers file */
 	    answers = optarg;
@@ -465,8 +490,8 @@ main(int argc, char *argv[])
 		not_reached();
 	    }
             break;
-	case 'F':
-	    fnamchk = optarg;
+	case 'F': /* -F fnamchk - ignored: we check the tarball filename ourselves */
+	    dbg(DBG_LOW, "ignoring -F %s: the tarball filename is checked without running fnamchk", optarg);
 	    break;
 	case 'C':
 	    chksubmit = optarg;
@@ -869,6 +894,7 @@ main(int argc, char *argv[])
      */
     memset(&wstat, 0, sizeof(wstat));
     memset(&wstat2, 0, sizeof(wstat2)); /* this will be initialised in a later function */
+    memset(&wstat3, 0, sizeof(wstat3)); /* with -p this will be initialised by write_json_files() */
     wset_p = &walk_mkiocccentry;
     context = "mkiocccentry";
     init_walk_stat(&wstat,
@@ -883,7 +909,7 @@ main(int argc, char *argv[])
      */
     if (cap_I || cap_X) {
         optind = 1;
-        while ((i = getopt(argc, argv, ":hv:J:qVt:l:a:i:A:WT:ef:F:C:yYds:m:I:u:U:xr:M:X:")) != -1) {
+        while ((i = getopt(argc, argv, ":hv:J:qVt:l:a:i:A:WT:ef:F:C:yYds:m:I:u:U:xr:M:X:pj:L:")) != -1) {
             switch (i) {
             case 'I': /* ignore a path */
                 skip_add_ret = skip_add(&wstat, optarg);
@@ -902,7 +928,8 @@ main(int argc, char *argv[])
             case 'q':
             case 'V':		/* -V - print version and exit 2 */
             case 't':		/* -t /path/to/tar */
-            case 'l':		/* -l /path/to/ls */
+            case 'l':		/* -l ls (ignored) */
+            case 'L':		/* -L listing */
             case 'A':		/* -A answers overwrite answers file */
             case 'a':		/* -a record_answers */
             case 'i':		/* -i input_recorded_answers */
@@ -923,6 +950,8 @@ main(int argc, char *argv[])
             case 'x':
             case 'r':
             case 'M':
+            case 'p':
+            case 'j':
             case ':':   /* option requires an argument */
             case '?':   /* illegal option */
             default:    /* anything else but should not actually happen */
@@ -934,8 +963,8 @@ main(int argc, char *argv[])
     /*
      * find utilities we need.
      */
-    find_utils(&found_tar, &tar, &found_ls, &ls, &found_txzchk, &txzchk,
-            &found_fnamchk, &fnamchk, NULL, NULL, &found_chksubmit,
+    find_utils(&found_tar, &tar, NULL, NULL, &found_txzchk, &txzchk,
+            NULL, NULL, NULL, NULL, &found_chksubmit,
             &chksubmit, &found_make, &make, &found_rm, &rm);
 
     /*
@@ -1046,7 +1075,6 @@ main(int argc, char *argv[])
      * print debug debug information if -v level is high enough
      */
     dbg(DBG_MED, "tar: %s", tar);
-    dbg(DBG_MED, "ls: %s", ls);
     dbg(DBG_MED, "rm: %s", rm);
     if (answers != NULL) {
         dbg(DBG_MED, "answers file: %s", answers);
@@ -1145,7 +1173,7 @@ main(int argc, char *argv[])
     if (!quiet) {
 	para("", "Performing sanity checks on your environment ...", NULL);
     }
-    mkiocccentry_sanity_chks(&info, workdir, tar, ls, txzchk, fnamchk, chksubmit, make, rm);
+    mkiocccentry_sanity_chks(&info, workdir, tar, txzchk, chksubmit, make, rm);
     if (!quiet) {
 	para("... environment looks OK", "", NULL);
     }
@@ -1391,7 +1419,7 @@ main(int argc, char *argv[])
     if (!quiet) {
 	para("", "Forming the .auth.json file and .info json file ...", NULL);
     }
-    write_json_files(&wstat2, &auth, &info, submission_dir, chksubmit);
+    write_json_files(&wstat2, &auth, &info, submission_dir, chksubmit, &wstat3);
     if (!quiet) {
 	para("... completed .auth.json and .info.json files.", "", NULL);
     }
@@ -1501,16 +1529,24 @@ main(int argc, char *argv[])
     /*
      * form the .txz file
      *
-     * NOTE: this function will, if it successfully creates the tarball, run
-     * txzchk on it, which will run fnamchk on it.
+     * NOTE: this function checks the tarball filename (as fnamchk does) and, if
+     * it successfully creates the tarball, runs txzchk on it (or with -p,
+     * writes the tarball from the walk of the submission directory itself).
      */
-    form_tarball(workdir, submission_dir, tarball_path, tar, ls, txzchk, fnamchk, info.test_mode);
+    form_tarball(workdir, submission_dir, tarball_path, tar, txzchk, info.test_mode, &wstat3);
 
     /*
      * remind user various things e.g., to upload (unless in test mode)
      */
     remind_user(workdir, submission_dir, tar, tarball_path, info.test_mode, info.submit_slot);
 
+    /*
+     * if -p, report the time taken by each stage
+     */
+    if (in_process) {
+	show_stage_times();
+    }
+
     /*
      * close answers FD if -i answers used
      */
@@ -1566,6 +1602,9 @@ main(int argc, char *argv[])
         workdir_real = NULL;
     }
     free_walk_stat(&wstat);
+    if (in_process) {
+	free_walk_stat(&wstat3);
+    }
 
     if (manifest != NULL) {
         errno = 0; /* pre-clear errno for warnp() */
@@ -1581,18 +1620,10 @@ main(int argc, char *argv[])
         free(tar);
         tar = NULL;
     }
-    if (ls != NULL && found_ls) {
-        free(ls);
-        ls = NULL;
-    }
     if (txzchk != NULL && found_txzchk) {
         free(txzchk);
         txzchk = NULL;
     }
-    if (fnamchk != NULL && found_fnamchk) {
-        free(fnamchk);
-        fnamchk = NULL;
-    }
     if (chksubmit != NULL && found_chksubmit) {
         free(chksubmit);
         chksubmit = NULL;
@@ -1939,14 +1970,14 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
     /*
      * we need to show the user the list of ignored paths, if any
      */
-    if (wstat->prune != NULL) {
-        len = dyn_array_tell(wstat->prune);
+    if (walk_view(wstat, WALK_PRUNE) != NULL) {
+        len = dyn_array_tell(walk_view(wstat, WALK_PRUNE));
         if (len > 0) {
             para("The following is a list of paths that will be ignored:",
                  "",
                  NULL);
             for (i = 0; i < len; ++i) {
-                p = dyn_array_value(wstat->prune, struct item *, i);
+                p = dyn_array_value(walk_view(wstat, WALK_PRUNE), struct item *, i);
                 if (p == NULL) {
                     err(60, __func__, "found NULL pointer in ignored paths list, element: %jd", i);
                     not_reached();
@@ -1978,8 +2009,8 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
      * we need to show the user the list of symlinks (ignored as they are not
      * allowed), if any
      */
-    if (wstat->symlink != NULL) {
-        len = dyn_array_tell(wstat->symlink);
+    if (walk_view(wstat, WALK_SYMLINK) != NULL) {
+        len = dyn_array_tell(walk_view(wstat, WALK_SYMLINK));
         if (len > 0) {
             if (need_hints) {
                 para("",
@@ -1992,7 +2023,7 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
                     NULL);
 
             for (i = 0; i < len; ++i) {
-                p = dyn_array_value(wstat->symlink, struct item *, i);
+                p = dyn_array_value(walk_view(wstat, WALK_SYMLINK), struct item *, i);
                 if (p == NULL) {
                     err(62, __func__, "found NULL pointer in ignored symlinks list, element: %jd", i);
                     not_reached();
@@ -2021,8 +2052,8 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
     /*
      * we need to show the user the list of directories we will create, if any
      */
-    if (wstat->counted_dir != NULL) {
-        len = dyn_array_tell(wstat->counted_dir);
+    if (walk_view(wstat, WALK_COUNTED_DIR) != NULL) {
+        len = dyn_array_tell(walk_view(wstat, WALK_COUNTED_DIR));
         if (len > 0) {
             para("",
                     "The following is a list of directories that will be created:",
@@ -2033,14 +2064,14 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
              * show directories list
              */
             for (i = 0; i < len; ++i) {
-                p = dyn_array_value(wstat->counted_dir, struct item *, i);
+                p = dyn_array_value(walk_view(wstat, WALK_COUNTED_DIR), struct item *, i);
                 if (p == NULL) {
                     err(64, __func__, "found NULL pointer in directories list, element: %jd", i);
                     not_reached();
                 } else if (p->fts_path == NULL) {
                     err(65, __func__, "found NULL path in directories list, element: %jd", i);
                     not_reached();
-                } else if (path_in_item_array(wstat->prune, p->fts_path) != NULL) {
+                } else if (path_in_walk_cat(wstat, WALK_PRUNE, p->fts_path) != NULL) {
                     continue;
                 }
                 print("%s\n", p->fts_path);
@@ -2064,11 +2095,11 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
     /*
      * we need to show the user the list of all files
      */
-    if (wstat->file == NULL) {
+    if (walk_view(wstat, WALK_FILE) == NULL) {
         err(4, __func__, "files list is NULL"); /*ooo*/
         not_reached();
     } else {
-        len = dyn_array_tell(wstat->file);
+        len = dyn_array_tell(walk_view(wstat, WALK_FILE));
         if (len <= 0) {
             err(4, __func__, "list of files is empty"); /*ooo*/
             not_reached();
@@ -2084,14 +2115,14 @@ show_copy_list(struct walk_stat *wstat, char const *context, struct info *infop,
              * show required files list
              */
             for (i = 0; i < len; ++i) {
-                p = dyn_array_value(wstat->file, struct item *, i);
+                p = dyn_array_value(walk_view(wstat, WALK_FILE), struct item *, i);
                 if (p == NULL) {
                     err(66, __func__, "found NULL pointer in files list, element: %jd", i);
                     not_reached();
                 } else if (p->fts_path == NULL) {
                     err(67, __func__, "found NULL path in files list, element: %jd", i);
                     not_reached();
-                } else if (path_in_item_array(wstat->prune, p->fts_path) != NULL) {
+                } else if (path_in_walk_cat(wstat, WALK_PRUNE, p->fts_path) != NULL) {
                     continue;
                 }
                 print("%s\n", p->fts_path);
@@ -2144,6 +2175,8 @@ copy_topdir(struct walk_stat *wstat, char const *context, struct info *infop, ch
     intmax_t len = 0;               /* length of arrays */
     int ret;			    /* libc function return */
     intmax_t i = 0;                 /* index into arrays */
+    size_t bytes = 0;		    /* bytes copied by copyfile_method() */
+    enum copy_method method = COPY_METHOD_NONE;	/* how copyfile_method() copied a file */
 
     /*
      * firewall
@@ -2157,8 +2190,8 @@ copy_topdir(struct walk_stat *wstat, char const *context, struct info *infop, ch
     /*
      * make the necessary subdirectories, if any
      */
-    if (wstat->counted_dir != NULL) {
-        len = dyn_array_tell(wstat->counted_dir);
+    if (walk_view(wstat, WALK_COUNTED_DIR) != NULL) {
+        len = dyn_array_tell(walk_view(wstat, WALK_COUNTED_DIR));
         if (len > 0) {
             /*
              * we have to get to the submission dir before we can make
@@ -2174,14 +2207,14 @@ copy_topdir(struct walk_stat *wstat, char const *context, struct info *infop, ch
                 /*
                  * make the directories under the submission directory
                  */
-                p = dyn_array_value(wstat->counted_dir, struct item *, i);
+                p = dyn_array_value(walk_view(wstat, WALK_COUNTED_DIR), struct item *, i);
                 if (p == NULL) {
                     err(68, __func__, "found NULL pointer in directories list, element: %jd", i);
                     not_reached();
                 } else if (p->fts_path == NULL) {
                     err(69, __func__, "found NULL path in directories list, element: %jd", i);
                     not_reached();
-                } else if (path_in_item_array(wstat->prune, p->fts_path) != NULL) {
+                } else if (path_in_walk_cat(wstat, WALK_PRUNE, p->fts_path) != NULL) {
                     continue;
                 }
 
@@ -2206,24 +2239,24 @@ copy_topdir(struct walk_stat *wstat, char const *context, struct info *infop, ch
     /*
      * copy every file to correct location
      */
-    if (wstat->file == NULL) {
+    if (walk_view(wstat, WALK_FILE) == NULL) {
         err(71, __func__, "file set is NULL");
         not_reached();
     }
-    len = dyn_array_tell(wstat->file);
+    len = dyn_array_tell(walk_view(wstat, WALK_FILE));
     if (len <= 0) {
         err(72, __func__, "list of files is empty");
         not_reached();
     }
     for (i = 0; i < len; ++i) {
-        p = dyn_array_value(wstat->file, struct item *, i);
+        p = dyn_array_value(walk_view(wstat, WALK_FILE), struct item *, i);
         if (p == NULL) {
             err(73, __func__, "found NULL pointer in files list, element: %jd", i);
             not_reached();
         } else if (p->fts_path == NULL) {
             err(74, __func__, "found NULL path in files list, element: %jd", i);
             not_reached();
-        } else if (path_in_item_array(wstat->prune, p->fts_path) != NULL) {
+        } else if (path_in_walk_cat(wstat, WALK_PRUNE, p->fts_path) != NULL) {
             continue;
         }
 
@@ -2273,10 +2306,11 @@ copy_topdir(struct walk_stat *wstat, char const *context, struct info *infop, ch
          * NOTE: executable files must be 0555; all others must be 0444.
          */
         if (is_executable_filename(fname)) {
-            copyfile(fname, target_path, false, ITEM_PERM_0555);
+            bytes = copyfile_method(fname, target_path, false, ITEM_PERM_0555, &method);
         } else {
-            copyfile(fname, target_path, false, ITEM_PERM_0444);
+            bytes = copyfile_method(fname, target_path, false, ITEM_PERM_0444, &method);
         }
+        dbg(DBG_MED, "copied %zu bytes of %s via %s", bytes, p->fts_path, copy_method_name(method));
 
         /*
          * paranoia
@@ -2457,17 +2491,17 @@ check_submission_dir(struct walk_stat *wstat, char const *context, struct info *
     /*
      * check we have the same files
      */
-    if (wstat2->file == NULL) {
+    if (walk_view(wstat2, WALK_FILE) == NULL) {
         err(82, __func__, "submission directory has empty file set");
         not_reached();
     } else {
-        if (wstat->file == NULL) {
+        if (walk_view(wstat, WALK_FILE) == NULL) {
             err(83, __func__, "topdir was empty but submission directory not");
             not_reached();
         }
-        len = dyn_array_tell(wstat2->file);
+        len = dyn_array_tell(walk_view(wstat2, WALK_FILE));
         for (i = 0; i < len; ++i) {
-            p2 = dyn_array_value(wstat2->file, struct item *, i);
+            p2 = dyn_array_value(walk_view(wstat2, WALK_FILE), struct item *, i);
             if (p2 == NULL) {
                 err(4, __func__, "found NULL element in file list, element: %jd", i);/*ooo*/
                 not_reached();
@@ -2519,8 +2553,8 @@ check_submission_dir(struct walk_stat *wstat, char const *context, struct info *
      * show list of directories in the directory list of the submission
      * directory and ask user to verify all is OK
      */
-    if (wstat2->counted_dir != NULL) {
-        len = dyn_array_tell(wstat2->counted_dir);
+    if (walk_view(wstat2, WALK_COUNTED_DIR) != NULL) {
+        len = dyn_array_tell(walk_view(wstat2, WALK_COUNTED_DIR));
         if (len > 0) {
             para("",
                     "The following is a list of directories in your submission:",
@@ -2531,7 +2565,7 @@ check_submission_dir(struct walk_stat *wstat, char const *context, struct info *
              * show directories list
              */
             for (i = 0; i < len; ++i) {
-                p = dyn_array_value(wstat2->counted_dir, struct item *, i);
+                p = dyn_array_value(walk_view(wstat2, WALK_COUNTED_DIR), struct item *, i);
                 if (p == NULL) {
                     err(85, __func__, "found NULL pointer in directories list, element: %jd", i);
                     not_reached();
@@ -2561,11 +2595,11 @@ check_submission_dir(struct walk_stat *wstat, char const *context, struct info *
     /*
      * show user final submission directory listing and verify it is OK
      */
-    if (wstat2->file == NULL) {
+    if (walk_view(wstat2, WALK_FILE) == NULL) {
         err(87, __func__, "files list in submission directory is NULL");
         not_reached();
     }
-    len = dyn_array_tell(wstat2->file);
+    len = dyn_array_tell(walk_view(wstat2, WALK_FILE));
     if (len <= 0) {
         err(4, __func__, "list files in submission directory is empty"); /*ooo*/
         not_reached();
@@ -2580,7 +2614,7 @@ check_submission_dir(struct walk_stat *wstat, char const *context, struct info *
          * show required files list
          */
         for (i = 0; i < len; ++i) {
-            p = dyn_array_value(wstat2->file, struct item *, i);
+            p = dyn_array_value(walk_view(wstat2, WALK_FILE), struct item *, i);
             if (p == NULL) {
                 err(88, __func__, "found NULL pointer in files list, element: %jd", i);
                 not_reached();
@@ -2681,7 +2715,7 @@ usage(int exitcode, char const *prog, char const *str)
     }
 
     fprintf_usage(DO_NOT_EXIT, stderr, usage_msg0, prog, DBG_DEFAULT, JSON_DBG_DEFAULT);
-    fprintf_usage(DO_NOT_EXIT, stderr, usage_msg1, TAR_PATH_0, LS_PATH_0, TXZCHK_PATH_0, FNAMCHK_PATH_0);
+    fprintf_usage(DO_NOT_EXIT, stderr, usage_msg1, TAR_PATH_0, TXZCHK_PATH_0);
     fprintf_usage(DO_NOT_EXIT, stderr, usage_msg2, CHKSUBMIT_PATH_0, MAKE_PATH_0);
     fprintf_usage(DO_NOT_EXIT, stderr, usage_msg3, (unsigned)SEED_MASK, (unsigned)(DEFAULT_SEED & SEED_MASK));
     fprintf_usage(DO_NOT_EXIT, stderr, usage_msg4);
@@ -2703,9 +2737,7 @@ usage(int exitcode, char const *prog, char const *str)
  *      infop           - pointer to info structure
  *      workdir         - where the submission directory and tarball are formed
  *      tar             - path to tar that supports the -J (xz) option
- *	ls		- path to the ls utility
  *	txzchk		- path to txzchk tool
- *	fnamchk		- path to fnamchk tool
  *	chksubmit	- path to chksubmit tool
  *	make            - path to make
  *	rm              - path to rm
@@ -2717,7 +2749,7 @@ usage(int exitcode, char const *prog, char const *str)
  * only checks infop and workdir, not the others.
  */
 static void
-mkiocccentry_sanity_chks(struct info *infop, char const *workdir, char *tar, char *ls, char *txzchk, char *fnamchk,
+mkiocccentry_sanity_chks(struct info *infop, char const *workdir, char *tar, char *txzchk,
 			 char *chksubmit, char *make, char *rm)
 {
     /*
@@ -2788,66 +2820,6 @@ mkiocccentry_sanity_chks(struct info *infop, char const *workdir, char *tar, cha
 	not_reached();
     }
 
-    /*
-     * ls must be executable
-     */
-    if (ls == NULL || !exists(ls)) {
-	fpara(stderr,
-	      "",
-	      "We cannot find the ls program.",
-	      "",
-	      "The ls program is required to help you verify the correct files are included.",
-	      "Perhaps you need to use:",
-	      "",
-	      "    mkiocccentry -l /path/to/ls ...",
-	      "",
-	      "and/or install a ls program?  You can find the source for ls in core utilities:",
-	      "",
-	      "    https://www.gnu.org/software/coreutils/",
-	      "",
-	      NULL);
-        if (ls != NULL) {
-            err(97, __func__, "ls does not exist: %s", ls);
-        } else {
-            err(98, __func__, "ls does not exist");
-        }
-	not_reached();
-    }
-    if (!is_file(ls)) {
-	fpara(stderr,
-	      "",
-	      "The ls path, while it exists, is not a regular file.",
-	      "",
-	      "Perhaps you need to use another path:",
-	      "",
-	      "    mkiocccentry -l /path/to/ls ...",
-	      "",
-	      "and/or install a ls program?  You can find the source for ls in core utilities:",
-	      "",
-	      "    https://www.gnu.org/software/coreutils/",
-	      "",
-	      NULL);
-	err(99, __func__, "ls is not a regular file: %s", ls);
-	not_reached();
-    }
-    if (!is_exec(ls)) {
-	fpara(stderr,
-	      "",
-	      "The ls path, while it is a file, is not executable.",
-	      "",
-	      "We suggest you check the permissions on the ls program, or use another path:",
-	      "",
-	      "    mkiocccentry -l /path/to/ls ...",
-	      "",
-	      "and/or install a ls program?  You can find the source for ls in core utilities:",
-	      "",
-	      "    https://www.gnu.org/software/coreutils/",
-	      "",
-	      NULL);
-	err(100, __func__, "ls is not an executable program: %s", ls);
-	not_reached();
-    }
-
     /*
      * txzchk must be executable
      */
@@ -2908,66 +2880,6 @@ mkiocccentry_sanity_chks(struct info *infop, char const *workdir, char *tar, cha
 	not_reached();
     }
 
-    /*
-     * fnamchk must be executable
-     */
-    if (fnamchk == NULL || !exists(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "We cannot find the fnamchk tool.",
-	      "",
-	      "The fnamchk program performs sanity checks on the compressed tarball filename.",
-	      "Perhaps you need to use:",
-	      "",
-	      "    mkiocccentry -F /path/to/fnamchk ...",
-	      "",
-	      "and/or install the fnamchk tool?  You can find the source for fnamchk in the mkiocccentry GitHub repo:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-	      "",
-	      NULL);
-        if (fnamchk != NULL) {
-	    err(105, __func__, "fnamchk does not exist: %s", fnamchk);
-        } else {
-	    err(106, __func__, "fnamchk does not exist");
-        }
-	not_reached();
-    }
-    if (!is_file(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "The fnamchk path, while it exists, is not a regular file.",
-	      "",
-	      "Perhaps you need to use another path:",
-	      "",
-	      "    mkiocccentry -F /path/to/fnamchk ...",
-	      "",
-	      "and/or install the fnamchk tool?  You can find the source for fnamchk in the mkiocccentry GitHub repo:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-	      "",
-	      NULL);
-	err(107, __func__, "fnamchk is not a regular file: %s", fnamchk);
-	not_reached();
-    }
-    if (!is_exec(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "The fnamchk path, while it is a file, is not executable.",
-	      "",
-	      "We suggest you check the permissions on the fnamchk program, or use another path:",
-	      "",
-	      "    mkiocccentry -F /path/to/fnamchk ...",
-	      "",
-	      "and/or install the fnamchk tool?  You can find the source for fnamchk in the mkiocccentry GitHub repo:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-	      "",
-	      NULL);
-	err(108, __func__, "fnamchk is not an executable program: %s", fnamchk);
-	not_reached();
-    }
-
     /*
      * chksubmit must be executable
      */
@@ -6532,32 +6444,49 @@ get_author_info(struct author **author_set_p)
  *
  * given:
  *      submission_dir      - path to submission directory
- *      ls                  - path to ls utility
+ *      swstat              - with -p, the walk of the submission directory by the chkentry -S checks
+ *
+ * The submission directory is listed from a walk of it, as the chkentry -S
+ * checks walk it, rather than by running ls -lakR: with -p that walk is
+ * swstat, otherwise we walk the submission directory here.  If -L listing was
+ * used, a JSON listing of the submission directory is also written to listing.
  *
  * This function does not return on error.
  */
 static void
-verify_submission_dir(char const *submission_dir, char const *ls)
+verify_submission_dir(char const *submission_dir, struct walk_stat *swstat)
 {
-    int exit_code;		/* exit code from shell_cmd() */
+    struct walk_stat lwstat;	/* walk of the submission directory if not -p */
+    struct walk_stat *wstat_p;	/* walk of the submission directory to list */
+    struct submit_totals totals;	/* counts of the listing */
+    FILE *listing_stream;	/* -L listing stream */
+    char *basename_submission_dir;	/* basename of the submission directory */
     bool yorn = false;		/* response to a question */
-    FILE *ls_stream;		/* pipe from iocccsize -V */
-    char *linep = NULL;		/* allocated line read from iocccsize */
-    ssize_t readline_len;	/* readline return length */
-    int kdirsize = 0;		/* number of kibibyte (2^10) blocks in submission directory */
-    int size = 0;               /* incremental kibibyte per directory */
-    char guard;			/* scanf guard to catch excess amount of input */
     int ret;			/* libc function return */
-    size_t i = 0;               /* number of lines read by ls */
 
     /*
      * firewall
      */
-    if (submission_dir == NULL || ls == NULL) {
+    if (submission_dir == NULL || swstat == NULL) {
 	err(232, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
+    /*
+     * walk the submission directory unless -p already did
+     */
+    memset(&lwstat, 0, sizeof(lwstat));
+    if (in_process) {
+	wstat_p = swstat;
+    } else {
+	dbg(DBG_HIGH, "about to walk: %s", submission_dir);
+	if (!walk_submit_dir(&lwstat, submission_dir)) {
+	    err(234, __func__, "failed to walk submission directory: %s", submission_dir);
+	    not_reached();
+	}
+	wstat_p = &lwstat;
+    }
+
     /*
      * list the contents of the submission_dir
      */
@@ -6574,78 +6503,46 @@ verify_submission_dir(char const *submission_dir, char const *ls)
 	 "from which the xz tarball will be formed:",
 	 "",
 	 NULL);
-    dbg(DBG_HIGH, "about to perform: cd -- %s && %s -lakR .", submission_dir, ls);
-    exit_code = shell_cmd(__func__, false, true, "cd -- % && % -lakR .", submission_dir, ls);
-    if (exit_code != 0) {
-	err(234, __func__, "cd -- %s && %s -lakR . failed with exit code: %d",
-			   submission_dir, ls, WEXITSTATUS(exit_code));
+    if (!list_submit_dir(stdout, wstat_p, &totals)) {
+	err(235, __func__, "failed to list submission directory: %s", submission_dir);
 	not_reached();
     }
-
-    /*
-     * open pipe to the ls command
-     */
-    dbg(DBG_HIGH, "about to popen: cd -- %s && %s -lakR .", submission_dir, ls);
-    ls_stream = pipe_open(__func__, false, true, "cd -- % && % -lakR .", submission_dir, ls);
-    if (ls_stream == NULL) {
-	err(235, __func__, "popen filed for: cd -- %s && %s -lakR .", submission_dir, ls);
+    if (totals.files <= 0) {
+	err(236, __func__, "found no files in submission directory: %s", submission_dir);
 	not_reached();
     }
+    dbg(DBG_MED, "submission directory %s has %jd director%s and %jd file%s totalling %jd bytes in %jd kibibyte blocks",
+		 submission_dir, totals.dirs, totals.dirs == 1 ? "y" : "ies", totals.files,
+		 SINGULAR_OR_PLURAL(totals.files), totals.file_bytes, totals.kibibytes);
 
     /*
-     * read successive lines, looking for total kibibytes (2^10) block lines
+     * if -L listing, write the JSON listing
      */
-    kdirsize = 0;
-    i = 0;
-    while ((readline_len = readline(&linep, ls_stream)) >= 0) {
-	dbg(DBG_HIGH, "ls line read length: %zd buffer: %s", readline_len, linep);
-        /*
-         * parse k-block lines from ls
-         */
-        ret = sscanf(linep, "total %d%c", &size, &guard);
-        if (ret == 1) {
-            ++i;
-            kdirsize += size;
-        }
-        /*
-         * free storage
-         */
-        if (linep != NULL) {
-            free(linep);
-            linep = NULL;
-        }
-    }
-
-    /*
-     * no line was read at all
-     */
-    if (readline_len < 0 && i == 0) {
-	err(236, __func__, "EOF while reading output of ls: %s", ls);
-	not_reached();
-    }
-
-    /*
-     * lines were read from ls but nothing correct was found
-     */
-    if (i == 0) {
-        err(237, __func__, "found no k-block line in ls output");
-        not_reached();
-    }
-    if (kdirsize <= 0) {
-	err(238, __func__, "ls k-block value: %d <= 0", kdirsize);
-	not_reached();
+    if (listing != NULL) {
+	dbg(DBG_HIGH, "about to write JSON listing: %s", listing);
+	errno = 0;		/* pre-clear errno for errp() */
+	listing_stream = fopen(listing, "w");
+	if (listing_stream == NULL) {
+	    errp(237, __func__, "cannot open JSON listing: %s", listing);
+	    not_reached();
+	}
+	basename_submission_dir = base_name(submission_dir);
+	if (!json_list_submit_dir(listing_stream, wstat_p, basename_submission_dir)) {
+	    err(238, __func__, "failed to write JSON listing: %s", listing);
+	    not_reached();
+	}
+	free(basename_submission_dir);
+	basename_submission_dir = NULL;
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = fclose(listing_stream);
+	if (ret != 0) {
+	    errp(254, __func__, "fclose error on JSON listing: %s", listing);
+	    not_reached();
+	}
     }
-    dbg(DBG_MED, "Directory %s size in kibibyte (1024 byte blocks): %d", submission_dir, kdirsize);
-
-    /*
-     * close down pipe
-     */
-    errno = 0;		/* pre-clear errno for warnp() */
-    ret = pclose(ls_stream);
-    if (ret < 0) {
-	warnp(__func__, "pclose error on ls stream");
+    if (!in_process) {
+	free_walk_stat(&lwstat);
     }
-    ls_stream = NULL;
 
     /*
      * we make sure that unless -Y is used the user always has a chance to look
@@ -6681,14 +6578,6 @@ verify_submission_dir(char const *submission_dir, char const *ls)
 
     silence_prompt = saved_silence_prompt;
     answer_yes = saved_answer_yes;
-
-    /*
-     * free storage
-     */
-    if (linep != NULL) {
-	free(linep);
-	linep = NULL;
-    }
     return;
 }
 
@@ -6777,19 +6666,24 @@ form_info(struct info *infop)
  * Create the .auth.json and .info.json files and then verify them by running
  * chksubmit(1) on the submission directory.
  *
+ * With -p we do not run chksubmit(1): we perform the chkentry -S checks
+ * in-process and keep the walk of the submission directory in swstat so that
+ * verify_submission_dir() and form_tarball() need not walk it again.
+ *
  * given:
  *      wstat           -   pointer to struct walk_stat
  *      authp           -   pointer to auth structure
  *      infop           -   pointer to info structure
  *      submission_dir  -   submission directory
  *      chksubmit        -   path to chksubmit(1) tool
+ *      swstat          -   with -p, pointer to struct walk_stat to record the submission directory walk
  *
  * This function does not return if a NULL pointer is encountered, if certain
  * variables are not in the right range or if chksubmit(1) fails.
  */
 static void
 write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop, char const *submission_dir,
-		 char const *chksubmit)
+		 char const *chksubmit, struct walk_stat *swstat)
 {
     char *info_path;		/* path to .info.json file */
     size_t info_path_len;	/* length of path to .info.json */
@@ -6803,18 +6697,20 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
     int exit_code;		/* exit code from shell_cmd() */
     size_t file_count = 0;	/* number of files */
     size_t extra_count = 0;	/* number of 'extra' files (see comments below) */
+    double start;		/* when the current stage started */
     int i;
     size_t j;
 
     /*
      * firewall
      */
-    if (wstat == NULL || infop == NULL || authp == NULL || submission_dir == NULL || chksubmit == NULL) {
+    if (wstat == NULL || infop == NULL || authp == NULL || submission_dir == NULL || chksubmit == NULL ||
+	swstat == NULL) {
         err(244, __func__, "called with NULL arg(s)");
         not_reached();
     }
 
-    if (wstat->file == NULL) {
+    if (walk_view(wstat, WALK_FILE) == NULL) {
         err(245, __func__, "called with NULL file list");
         not_reached();
     }
@@ -6833,6 +6729,7 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
     /*
      * open .auth.json for writing
      */
+    start = stage_start();
     auth_path_len = strlen(submission_dir) + 1 + LITLEN(AUTH_JSON_FILENAME) + 1;
     errno = 0;			/* pre-clear errno for errp() */
     auth_path = (char *)calloc(auth_path_len + 1, sizeof(*auth_path));
@@ -7035,12 +6932,12 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
      * if we subtract by three it means that we'll skip some (and can result in
      * invalid JSON).
      */
-    file_count = dyn_array_tell(wstat->file);
+    file_count = dyn_array_tell(walk_view(wstat, WALK_FILE));
 
     /*
      * Set mark values
      *
-     * NOTE: This has the side effect of validating that all items in wstat->file are non-NULL
+     * NOTE: This has the side effect of validating that all items in the WALK_FILE view of wstat are non-NULL
      *	     and have non-NULL fts_name pointers.
      */
     for (j = 0; j < file_count; ++j) {
@@ -7048,7 +6945,7 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
 	/*
 	 * obtain the next item
 	 */
-	p = dyn_array_value(wstat->file, struct item *, j);
+	p = dyn_array_value(walk_view(wstat, WALK_FILE), struct item *, j);
 
 	/*
 	 * firewall
@@ -7124,7 +7021,7 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
 	/*
 	 * obtain the next item
 	 */
-	p = dyn_array_value(wstat->file, struct item *, j);
+	p = dyn_array_value(walk_view(wstat, WALK_FILE), struct item *, j);
 
 	ret =                   fprintf(info_stream, "        {\n") > 0 &&
 	      json_fprintf_value_string(info_stream, "            ", (char *)p->mark_ptr, " : ", p->orig_path, "\n") &&
@@ -7170,6 +7067,17 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
         not_reached();
     }
 
+    /*
+     * close descriptor
+     */
+    errno = 0; /* pre-clear for errp() */
+    ret = close(fd);
+    if (ret < 0) {
+        errp(252, __func__, "close(fd) failed");
+        not_reached();
+    }
+    stage_end("write JSON files", start);
+
     /*
      * now we have to run chksubmit(1) on the directory
      */
@@ -7177,13 +7085,27 @@ write_json_files(struct walk_stat *wstat, struct auth *authp, struct info *infop
 	para("",
 	    "Checking your submission directory for various issues ...", NULL);
     }
-    dbg(DBG_HIGH, "about to perform: %s -- %s", chksubmit, submission_dir);
-    exit_code = shell_cmd(__func__, false, true, "% -- %", chksubmit, submission_dir);
-    if (exit_code != 0) {
-	err(4, __func__, "%s -- %s failed with exit code: %d", /*ooo*/
-			   chksubmit, submission_dir, WEXITSTATUS(exit_code));
-	not_reached();
+    start = stage_start();
+    if (in_process) {
+
+	/*
+	 * case: -p - perform the chkentry -S checks ourselves
+	 */
+	dbg(DBG_HIGH, "about to perform the chkentry -S checks on: %s", submission_dir);
+	if (!chk_submit_dir(swstat, submission_dir)) {
+	    err(4, __func__, "chkentry -S checks failed for: %s", submission_dir); /*ooo*/
+	    not_reached();
+	}
+    } else {
+	dbg(DBG_HIGH, "about to perform: %s -- %s", chksubmit, submission_dir);
+	exit_code = shell_cmd(__func__, false, true, "% -- %", chksubmit, submission_dir);
+	if (exit_code != 0) {
+	    err(4, __func__, "%s -- %s failed with exit code: %d", /*ooo*/
+			       chksubmit, submission_dir, WEXITSTATUS(exit_code));
+	    not_reached();
+	}
     }
+    stage_end("check submission directory", start);
     if (!quiet) {
 	para("... all appears well with your submission directory.", NULL);
     }
@@ -7296,44 +7218,72 @@ form_auth(struct auth *authp, struct info *infop, int author_count, struct autho
  *
  * Given the completed submission directory, form a compressed tarball for the user to submit.
  * Remind the user where to submit their compressed tarball file. The function
- * shows the listing of the tarball contents via the txzchk tool and the fnamchk tool.
+ * checks the tarball filename (with the fnamchk checks) and shows the listing of
+ * the tarball contents via the txzchk tool.
  *
  * given:
  *      workdir         - working directory under which the submission directory is formed
  *      submission_dir  - path to submission directory
  *      tarball_path    - path of the compressed tarball to form
  *      tar             - path to the tar utility
- *      ls              - path to ls utility
  *      txzchk		- path to txzchk tool
- *      fnamchk		- path to fnamchk tool
- *      test_mode       - true ==> use -x in txzchk (force -t in fnamchk)
+ *      test_mode       - true ==> tarball must have a test submit filename (use -x in txzchk)
+ *      swstat          - with -p, the walk of the submission directory by the chkentry -S checks
+ *
+ * With -p we run neither tar nor txzchk: we write the tarball ourselves from
+ * swstat with tar_write_walk(), listing it as we go.  As the chkentry -S checks
+ * already vetted the names, counts and permissions of what we write, only the
+ * totals that txzchk checks for are left to check, and tar_write_walk() gives
+ * us those: the tarball need not be read back.
  *
  * This function does not return on error.
  */
 static void
 form_tarball(char const *workdir, char const *submission_dir, char const *tarball_path, char const *tar,
-	     char const *ls, char const *txzchk, char const *fnamchk, bool test_mode)
+	     char const *txzchk, bool test_mode, struct walk_stat *swstat)
 {
+    struct submit_filename sub;	/* what the fnamchk checks found in the tarball filename */
     char *basename_submission_dir;	/* basename of the submission directory */
     char *basename_tarball_path;/* basename of tarball_path */
     int exit_code;		/* exit code from shell_cmd() */
     struct stat buf;		/* stat of the tarball */
     int cwd = -1;		/* current working directory */
+    struct tar_totals totals;	/* -p what was written to the tarball */
+    long cpus;			/* -p number of CPUs online */
+    double start;		/* when the current stage started */
     int ret;			/* libc function return */
 
     /*
      * firewall
      */
-    if (workdir == NULL || submission_dir == NULL || tarball_path == NULL || tar == NULL || ls == NULL ||
-        txzchk == NULL || fnamchk == NULL) {
+    if (workdir == NULL || submission_dir == NULL || tarball_path == NULL || tar == NULL ||
+        txzchk == NULL || swstat == NULL) {
 	err(38, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
+    /*
+     * the tarball filename must pass the fnamchk checks and name the submission directory
+     */
+    if (!chk_submit_filename(tarball_path, "txz", test_mode, false, &sub)) {
+	err(250, __func__, "tarball filename check failed with fnamchk exit code: %d: %s", sub.code, sub.msg);
+	not_reached();
+    }
+    basename_submission_dir = base_name(submission_dir);
+    if (strcmp(sub.dirname, basename_submission_dir) != 0) {
+	err(251, __func__, "tarball filename submit directory: %s != submission directory: %s",
+			   sub.dirname, basename_submission_dir);
+	not_reached();
+    }
+    dbg(DBG_MED, "tarball filename passed the fnamchk checks: %s", sub.filename);
+    free_submit_filename(&sub);
+
     /*
      * verify submission directory contents
      */
-    verify_submission_dir(submission_dir, ls);
+    start = stage_start();
+    verify_submission_dir(submission_dir, swstat);
+    stage_end("list submission directory", start);
     dbg(DBG_MED, "verified submission directory: %s", submission_dir);
 
     /*
@@ -7357,32 +7307,61 @@ form_tarball(char const *workdir, char const *submission_dir, char const *tarbal
     }
 
     /*
-     * perform the tar create command
+     * form the v7 compressed tarball
      *
      * IMPORTANT NOTE: The reason why we form a v7 tarball is that we do NOT want to
      *		       preserve user and group names (to help keep authors anonymous),
      *		       (modern flags to force a username/groupname are not very portable),
      *		       and we don't want special files, symlinks, etc.
      */
-    if (!quiet) {
-	para("",
-	     "About to run the tar command to form the compressed tarball ...",
-	     "",
-	     NULL);
-    } else {
-	para("", NULL);
-    }
-    /**/
-    basename_submission_dir = base_name(submission_dir);
     basename_tarball_path = base_name(tarball_path);
-    dbg(DBG_HIGH, "about to perform: %s --format=v7 -cJf %s -- %s",
-		   tar, basename_tarball_path, basename_submission_dir);
-    exit_code = shell_cmd(__func__, false, true, "tar --format=v7 -cJf % -- %",
-				    basename_tarball_path, basename_submission_dir);
-    if (exit_code != 0) {
-	err(41, __func__, "%s --format=v7 -cJf %s -- %s failed with exit code: %d",
-			   tar, basename_tarball_path, basename_submission_dir, WEXITSTATUS(exit_code));
-	not_reached();
+    if (in_process) {
+
+	/*
+	 * case: -p - write the tarball from the walk of the submission directory
+	 */
+	if (xz_jobs == 0) {
+	    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	    xz_jobs = cpus < 1 ? 1 : (cpus > XZ_ENC_MAX_THREADS ? XZ_ENC_MAX_THREADS : (unsigned int)cpus);
+	}
+	if (!quiet) {
+	    para("",
+		 "About to form the compressed tarball ...",
+		 "",
+		 NULL);
+	} else {
+	    para("", NULL);
+	}
+	start = stage_start();
+	dbg(DBG_HIGH, "about to write %s from %s with %u thread%s",
+		       basename_tarball_path, basename_submission_dir, xz_jobs, SINGULAR_OR_PLURAL(xz_jobs));
+	if (!tar_write_walk(basename_tarball_path, basename_submission_dir, swstat, xz_jobs, stdout, &totals)) {
+	    err(253, __func__, "failed to form the compressed tarball: %s/%s", workdir, basename_tarball_path);
+	    not_reached();
+	}
+    } else {
+
+	/*
+	 * case: perform the tar create command
+	 */
+	if (!quiet) {
+	    para("",
+		 "About to run the tar command to form the compressed tarball ...",
+		 "",
+		 NULL);
+	} else {
+	    para("", NULL);
+	}
+	start = stage_start();
+	dbg(DBG_HIGH, "about to perform: %s --format=v7 -cJf %s -- %s",
+		       tar, basename_tarball_path, basename_submission_dir);
+	exit_code = shell_cmd(__func__, false, true, "tar --format=v7 -cJf % -- %",
+					basename_tarball_path, basename_submission_dir);
+	if (exit_code != 0) {
+	    err(41, __func__, "%s --format=v7 -cJf %s -- %s failed with exit code: %d",
+			       tar, basename_tarball_path, basename_submission_dir, WEXITSTATUS(exit_code));
+	    not_reached();
+	}
     }
 
     /*
@@ -7404,6 +7383,25 @@ form_tarball(char const *workdir, char const *submission_dir, char const *tarbal
 		 basename_tarball_path, (long long)buf.st_size, MAX_TARBALL_LEN);
 	not_reached();
     }
+    stage_end("form tarball", start);
+
+    /*
+     * if -p, check what was written as txzchk would check the tarball
+     */
+    if (in_process) {
+	if (totals.files <= 0) {
+	    err(97, __func__, "%s/%s: files count <= 0: %jd", workdir, basename_tarball_path, totals.files);
+	    not_reached();
+	}
+	if (totals.file_bytes > MAX_SUM_FILELEN) {
+	    err(98, __func__, "%s/%s: total file size too big: %jd > %jd",
+			       workdir, basename_tarball_path, totals.file_bytes, (intmax_t)MAX_SUM_FILELEN);
+	    not_reached();
+	}
+	dbg(DBG_MED, "tarball %s has %jd file%s totalling %jd bytes in %jd director%s: %ju bytes compressed to %ju",
+		     basename_tarball_path, totals.files, SINGULAR_OR_PLURAL(totals.files), totals.file_bytes,
+		     totals.dirs, totals.dirs == 1 ? "y" : "ies", totals.tar_bytes, totals.xz_bytes);
+    }
 
     /*
      * switch back to the previous current directory
@@ -7424,48 +7422,50 @@ form_tarball(char const *workdir, char const *submission_dir, char const *tarbal
     /*
      * perform the txzchk which will indirectly show the user the tarball contents
      */
-    if (entertain) {
+    if (in_process) {
+	dbg(DBG_MED, "formed and checked tarball in-process: %s", basename_tarball_path);
+    } else if (entertain) {
         if (test_mode) {
-            dbg(DBG_HIGH, "about to perform: %s -x -e -f %ju -w -v 1 -F %s -- %s/../%s",
-                          txzchk, feathery, fnamchk, submission_dir, basename_tarball_path);
-            exit_code = shell_cmd(__func__, false, true, "% -x -e -w -v 1 -F % -- %/../%",
-                                                  txzchk, fnamchk, submission_dir, basename_tarball_path);
+            dbg(DBG_HIGH, "about to perform: %s -x -e -f %ju -w -v 1 -- %s/../%s",
+                          txzchk, feathery, submission_dir, basename_tarball_path);
+            exit_code = shell_cmd(__func__, false, true, "% -x -e -w -v 1 -- %/../%",
+                                                  txzchk, submission_dir, basename_tarball_path);
         } else {
-            dbg(DBG_HIGH, "about to perform: %s -e -f %ju -w -v 1 -F %s -- %s/../%s",
-                          txzchk, feathery, fnamchk, submission_dir, basename_tarball_path);
-            exit_code = shell_cmd(__func__, false, true, "% -e -w -v 1 -F % -- %/../%",
-                                                  txzchk, fnamchk, submission_dir, basename_tarball_path);
+            dbg(DBG_HIGH, "about to perform: %s -e -f %ju -w -v 1 -- %s/../%s",
+                          txzchk, feathery, submission_dir, basename_tarball_path);
+            exit_code = shell_cmd(__func__, false, true, "% -e -w -v 1 -- %/../%",
+                                                  txzchk, submission_dir, basename_tarball_path);
         }
         if (exit_code != 0) {
             if (test_mode) {
-                err(46, __func__, "%s -x -e -f %ju -w -v 1 -F %s -- %s/../%s failed with exit code: %d",
-                               txzchk, feathery, fnamchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
+                err(46, __func__, "%s -x -e -f %ju -w -v 1 -- %s/../%s failed with exit code: %d",
+                               txzchk, feathery, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
             } else {
-                err(47, __func__, "%s -e -f %ju -w -v 1 -F %s -- %s/../%s failed with exit code: %d",
-                               txzchk, feathery, fnamchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
+                err(47, __func__, "%s -e -f %ju -w -v 1 -- %s/../%s failed with exit code: %d",
+                               txzchk, feathery, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
             }
             not_reached();
         }
 
     } else {
         if (test_mode) {
-            dbg(DBG_HIGH, "about to perform: %s -x -w -v 1 -F %s -- %s/../%s",
-                          txzchk, fnamchk, submission_dir, basename_tarball_path);
-            exit_code = shell_cmd(__func__, false, true, "% -x -w -v 1 -F % -- %/../%",
-                                  txzchk, fnamchk, submission_dir, basename_tarball_path);
+            dbg(DBG_HIGH, "about to perform: %s -x -w -v 1 -- %s/../%s",
+                          txzchk, submission_dir, basename_tarball_path);
+            exit_code = shell_cmd(__func__, false, true, "% -x -w -v 1 -- %/../%",
+                                  txzchk, submission_dir, basename_tarball_path);
         } else {
-            dbg(DBG_HIGH, "about to perform: %s -w -v 1 -F %s -- %s/../%s",
-                          txzchk, fnamchk, submission_dir, basename_tarball_path);
-            exit_code = shell_cmd(__func__, false, true, "% -w -v 1 -F % -- %/../%",
-                                  txzchk, fnamchk, submission_dir, basename_tarball_path);
+            dbg(DBG_HIGH, "about to perform: %s -w -v 1 -- %s/../%s",
+                          txzchk, submission_dir, basename_tarball_path);
+            exit_code = shell_cmd(__func__, false, true, "% -w -v 1 -- %/../%",
+                                  txzchk, submission_dir, basename_tarball_path);
         }
         if (exit_code != 0) {
             if (test_mode) {
-                err(48, __func__, "%s -x -w -v 1 -F %s -- %s/../%s failed with exit code: %d",
-                   txzchk, fnamchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
+                err(48, __func__, "%s -x -w -v 1 -- %s/../%s failed with exit code: %d",
+                   txzchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
             } else {
-                err(49, __func__, "%s -w -v 1 -F %s -- %s/../%s failed with exit code: %d",
-                   txzchk, fnamchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
+                err(49, __func__, "%s -w -v 1 -- %s/../%s failed with exit code: %d",
+                   txzchk, submission_dir, basename_tarball_path, WEXITSTATUS(exit_code));
             }
             not_reached();
         }
@@ -7490,6 +7490,93 @@ form_tarball(char const *workdir, char const *submission_dir, char const *tarbal
 }
 
 
+/*
+ * stage_start - note when a stage of forming the tarball starts
+ *
+ * returns:
+ *      seconds of the monotonic clock
+ */
+static double
+stage_start(void)
+{
+    struct timespec now;	/* monotonic clock */
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+
+/*
+ * stage_end - record the time taken by a stage of forming the tarball
+ *
+ * given:
+ *      name            - what the stage does
+ *      start           - stage_start() when the stage started
+ *
+ * The times are reported by show_stage_times() if -p was used.
+ *
+ * This function does not return on error.
+ */
+static void
+stage_end(char const *name, double start)
+{
+    /*
+     * firewall
+     */
+    if (name == NULL) {
+	err(105, __func__, "called with NULL name");
+	not_reached();
+    }
+    if (stage_count >= MAX_STAGES) {
+	dbg(DBG_MED, "no room to record the time of stage: %s", name);
+	return;
+    }
+
+    stage_time[stage_count].name = name;
+    stage_time[stage_count].seconds = stage_start() - start;
+    dbg(DBG_MED, "stage: %s took: %.6f seconds", name, stage_time[stage_count].seconds);
+    ++stage_count;
+    return;
+}
+
+
+/*
+ * show_stage_times - report the time taken by each stage of forming the tarball
+ *
+ * This function does not return on error.
+ */
+static void
+show_stage_times(void)
+{
+    double total = 0.0;		/* total seconds of all stages */
+    int ret;			/* libc function return */
+    int i;
+
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = printf("\nTime taken by each stage%s:\n\n", in_process ? " (in-process)" : "");
+    if (ret <= 0) {
+	errp(106, __func__, "printf error reporting stage times");
+	not_reached();
+    }
+    for (i = 0; i < stage_count; ++i) {
+	total += stage_time[i].seconds;
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = printf("    %-28s %10.6f s\n", stage_time[i].name, stage_time[i].seconds);
+	if (ret <= 0) {
+	    errp(107, __func__, "printf error reporting stage: %s", stage_time[i].name);
+	    not_reached();
+	}
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = printf("    %-28s %10.6f s\n", "total", total);
+    if (ret <= 0) {
+	errp(108, __func__, "printf error reporting total stage time");
+	not_reached();
+    }
+    return;
+}
+
+
 /*
  * remind_user - remind the user to upload (if not in test mode)
  *
@@ -146,6 +146,16 @@
  */
 #include "soup/walk.h"
 
+/*
+ * fnamchk_util - check an IOCCC compressed tarball filename
+ */
+#include "soup/fnamchk_util.h"
+
+/*
+ * tar_util - for reading the tarball without tar
+ */
+#include "soup/tar_util.h"
+
 
 /*
  * definitions
@@ -172,5 +182,20 @@
 #define RULE_2A_BIG_FILE_WARNING (0)	/* warn that prog.c appears to be too big under Rule 2a */
 #define RULE_2A_IOCCCSIZE_MISMATCH (1)	/* warn that prog.c iocccsize size differs from the file size */
 
+#define MAX_STAGES (8)			/* most stages whose time -p reports */
+
+
+/*
+ * struct stage_time - the time taken by a stage of forming the tarball
+ *
+ * With -p we report how long each stage took so that forming many test
+ * submissions can be timed.
+ */
+struct stage_time
+{
+    char const *name;			/* what the stage does */
+    double seconds;			/* seconds the stage took */
+};
+
 
 #endif /* INCLUDE_MKIOCCCENTRY_H */
@@ -80,3 +80,80 @@ struct json_sem sem_auth[SEM_AUTH_LEN+1] = {
   { 0,	JTYPE_OBJECT,	1,	1,	1,	38,	0,	NULL,	NULL,	NULL },
   { 0,	JTYPE_UNSET,	0,	0,	0,	-1,	0,	NULL,	NULL,	NULL }
 };
+
+static unsigned int sem_auth_disp[21] = {
+  0, 2, 0, 3, 9, 1, 0, 7, 0, 1, 1, 0, 6, 3, 0, 0,
+  1, 0, 4, 0, 5,
+};
+
+static struct json_sem_slot sem_auth_slot[64] = {
+/* depth    type        name_len  name    first  unnamed */
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 5,	JTYPE_BOOL,	0,	NULL,	2,	2 },
+  { 1,	JTYPE_MEMBER,	12,	"author_count",	25,	-1 },
+  { 5,	JTYPE_NUMBER,	0,	NULL,	0,	0 },
+  { 1,	JTYPE_MEMBER,	7,	"authors",	26,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 2,	JTYPE_BOOL,	0,	NULL,	19,	19 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"formed_timestamp",	29,	-1 },
+  { 2,	JTYPE_NUMBER,	0,	NULL,	17,	17 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	20,	"mkiocccentry_version",	32,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"IOCCC_contest_id",	23,	-1 },
+  { 1,	JTYPE_MEMBER,	9,	"test_mode",	36,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	8,	"mastodon",	12,	-1 },
+  { 4,	JTYPE_MEMBER,	19,	"past_winning_author",	14,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	3,	"url",	15,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	15,	"timestamp_epoch",	37,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	14,	"default_handle",	8,	-1 },
+  { 1,	JTYPE_MEMBER,	7,	"tarball",	35,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	7,	"alt_url",	5,	-1 },
+  { 1,	JTYPE_MEMBER,	15,	"fnamchk_version",	28,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	13,	"IOCCC_contest",	22,	-1 },
+  { 4,	JTYPE_MEMBER,	4,	"name",	13,	-1 },
+  { 4,	JTYPE_MEMBER,	13,	"author_number",	7,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 5,	JTYPE_NULL,	0,	NULL,	3,	3 },
+  { 4,	JTYPE_MEMBER,	6,	"github",	10,	-1 },
+  { 5,	JTYPE_STRING,	0,	NULL,	1,	1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	13,	"author_handle",	6,	-1 },
+  { 1,	JTYPE_MEMBER,	10,	"no_comment",	33,	-1 },
+  { 1,	JTYPE_MEMBER,	0,	NULL,	21,	-1 },
+  { 2,	JTYPE_STRING,	0,	NULL,	18,	18 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	5,	"email",	9,	-1 },
+  { 1,	JTYPE_MEMBER,	11,	"submit_slot",	34,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	18,	"IOCCC_auth_version",	21,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	10,	"IOCCC_year",	24,	-1 },
+  { 3,	JTYPE_OBJECT,	0,	NULL,	16,	16 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_OBJECT,	0,	NULL,	38,	38 },
+  { 1,	JTYPE_MEMBER,	13,	"min_timestamp",	31,	-1 },
+  { 1,	JTYPE_MEMBER,	17,	"chksubmit_version",	27,	-1 },
+  { 4,	JTYPE_MEMBER,	0,	NULL,	4,	-1 },
+  { 2,	JTYPE_ARRAY,	0,	NULL,	20,	20 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	21,	"formed_timestamp_usec",	30,	-1 },
+  { 4,	JTYPE_MEMBER,	13,	"location_code",	11,	-1 },
+  { 4,	JTYPE_MEMBER,	11,	"affiliation",	4,	-1 },
+};
+
+struct json_sem_hash sem_auth_hash = {
+  39, 21, 64, sem_auth_disp, sem_auth_slot, false
+};
@@ -101,6 +101,8 @@ extern bool chk_test_mode(struct json const *node,
 extern bool chk_timestamp_epoch(struct json const *node,
 	unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err);
 
+extern struct json_sem_hash sem_auth_hash;
+
 #endif /* SEM_AUTH_LEN */
 
 
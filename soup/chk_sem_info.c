@@ -90,3 +90,80 @@ struct json_sem sem_info[SEM_INFO_LEN+1] = {
   { 0,	JTYPE_OBJECT,	1,	1,	1,	48,	0,	NULL,	NULL,	NULL },
   { 0,	JTYPE_UNSET,	0,	0,	0,	-1,	0,	NULL,	NULL,	NULL }
 };
+
+static unsigned int sem_info_disp[26] = {
+  5, 1, 0, 2, 1, 0, 2, 0, 3, 7, 0, 0, 0, 0, 0, 0,
+  0, 0, 2, 5, 2, 0, 9, 0, 11, 4,
+};
+
+static struct json_sem_slot sem_info_slot[64] = {
+/* depth    type        name_len  name    first  unnamed */
+  { 1,	JTYPE_MEMBER,	21,	"formed_timestamp_usec",	26,	-1 },
+  { 1,	JTYPE_MEMBER,	17,	"chksubmit_version",	22,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	12,	"rule_2a_size",	37,	-1 },
+  { 2,	JTYPE_BOOL,	0,	NULL,	14,	14 },
+  { 4,	JTYPE_MEMBER,	10,	"try_alt_sh",	9,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"formed_timestamp",	25,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	17,	"iocccsize_version",	30,	-1 },
+  { 1,	JTYPE_MEMBER,	20,	"mkiocccentry_version",	33,	-1 },
+  { 1,	JTYPE_MEMBER,	14,	"found_all_rule",	27,	-1 },
+  { 4,	JTYPE_MEMBER,	12,	"shell_script",	8,	-1 },
+  { 1,	JTYPE_MEMBER,	9,	"test_mode",	42,	-1 },
+  { 1,	JTYPE_MEMBER,	10,	"no_comment",	34,	-1 },
+  { 1,	JTYPE_MEMBER,	18,	"IOCCC_info_version",	18,	-1 },
+  { 0,	JTYPE_OBJECT,	0,	NULL,	48,	48 },
+  { 1,	JTYPE_MEMBER,	18,	"found_clobber_rule",	29,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	14,	"ungetc_warning",	47,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	15,	"timestamp_epoch",	43,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	9,	"c_alt_src",	3,	-1 },
+  { 1,	JTYPE_MEMBER,	7,	"tarball",	41,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	14,	"empty_override",	23,	-1 },
+  { 1,	JTYPE_MEMBER,	13,	"min_timestamp",	32,	-1 },
+  { 4,	JTYPE_MEMBER,	9,	"info_JSON",	6,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"found_clean_rule",	28,	-1 },
+  { 1,	JTYPE_MEMBER,	13,	"IOCCC_contest",	16,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"rule_2a_mismatch",	35,	-1 },
+  { 4,	JTYPE_MEMBER,	10,	"extra_file",	5,	-1 },
+  { 1,	JTYPE_MEMBER,	0,	NULL,	16,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"IOCCC_contest_id",	17,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 2,	JTYPE_NUMBER,	0,	NULL,	12,	12 },
+  { 4,	JTYPE_MEMBER,	5,	"c_src",	4,	-1 },
+  { 4,	JTYPE_MEMBER,	8,	"Makefile",	1,	-1 },
+  { 4,	JTYPE_MEMBER,	6,	"try_sh",	10,	-1 },
+  { 5,	JTYPE_STRING,	0,	NULL,	0,	0 },
+  { 1,	JTYPE_MEMBER,	8,	"abstract",	21,	-1 },
+  { 3,	JTYPE_OBJECT,	0,	NULL,	11,	11 },
+  { 4,	JTYPE_MEMBER,	7,	"remarks",	7,	-1 },
+  { 1,	JTYPE_MEMBER,	12,	"rule_2b_size",	39,	-1 },
+  { 1,	JTYPE_MEMBER,	14,	"txzchk_version",	46,	-1 },
+  { 1,	JTYPE_MEMBER,	15,	"fnamchk_version",	24,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"trigraph_warning",	45,	-1 },
+  { 1,	JTYPE_MEMBER,	5,	"title",	44,	-1 },
+  { 1,	JTYPE_MEMBER,	10,	"IOCCC_year",	19,	-1 },
+  { 1,	JTYPE_MEMBER,	8,	"manifest",	31,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"rule_2a_override",	36,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 4,	JTYPE_MEMBER,	9,	"auth_JSON",	2,	-1 },
+  { 1,	JTYPE_MEMBER,	11,	"submit_slot",	40,	-1 },
+  { 4,	JTYPE_MEMBER,	0,	NULL,	1,	-1 },
+  { 2,	JTYPE_ARRAY,	0,	NULL,	15,	15 },
+  { 1,	JTYPE_MEMBER,	17,	"Makefile_override",	20,	-1 },
+  { 1,	JTYPE_MEMBER,	16,	"rule_2b_override",	38,	-1 },
+  { 0,	JTYPE_UNSET,	0,	NULL,	-1,	-1 },
+  { 2,	JTYPE_STRING,	0,	NULL,	13,	13 },
+};
+
+struct json_sem_hash sem_info_hash = {
+  49, 26, 64, sem_info_disp, sem_info_slot, false
+};
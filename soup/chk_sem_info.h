@@ -127,6 +127,8 @@ extern bool chk_txzchk_version(struct json const *node,
 extern bool chk_ungetc_warning(struct json const *node,
 	unsigned int depth, struct json_sem *sem, struct json_sem_val_err **val_err);
 
+extern struct json_sem_hash sem_info_hash;
+
 #endif /* SEM_INFO_LEN */
 
 
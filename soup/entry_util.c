@@ -110,6 +110,12 @@
  */
 #include "location.h"
 
+/*
+ * chk_sem_auth and chk_sem_info - JSON semantic tables for .auth.json and .info.json
+ */
+#include "chk_sem_auth.h"
+#include "chk_sem_info.h"
+
 /*
  * globals
  */
@@ -5853,3 +5859,701 @@ count_char(char const *str, int ch)
     }
     return count;
 }
+
+
+/*
+ * chk_json_file - check a JSON file
+ *
+ * given:
+ *	err		    stream on which to report errors
+ *	submission_dir	    directory from which files are to be checked
+ *	filename	    name of JSON file in submission_dir
+ *	sem		    != NULL ==> pointer to a JSON semantic table
+ *			    NULL => do not perform any semantic table checks
+ *	hash		    perfect hash of sem printed by jsemtblgen, or NULL
+ *
+ * returns:
+ *	true ==> all is OK
+ *	false ==> something failed
+ *
+ * The file under the submission_dir will opened, checked for proper JSON
+ * syntax, and finally JSON semantic analysis will be performed.
+ *
+ * NOTE: The semantic checks of the .info.json manifest walk the current
+ *	 directory, so when checking .info.json the current directory should
+ *	 be the submission directory.
+ */
+bool
+chk_json_file(FILE *err, char const *submission_dir, char const *filename, struct json_sem *sem,
+	      struct json_sem_hash const *hash)
+{
+    FILE *stream = NULL;				/* file stream for the JSON file or NULL */
+    struct json *tree = NULL;				/* JSON parse tree or NULL ==> not parsed or invalid JSON */
+    bool json_valid = false;				/* true ==> JSON is valid, false ==> JSON is invalid */
+    struct dyn_array *count_err = NULL;			/* JSON semantic count errors */
+    struct dyn_array *val_err = NULL;			/* JSON semantic validation errors */
+    intmax_t all_err_count = 0;				/* number of errors (count+validation+internal) from semantic check */
+    intmax_t count_err_count = 0;			/* semantic count error count */
+    intmax_t int_err_count = 0;				/* internal error count */
+    intmax_t val_err_count = 0;				/* semantic validation count */
+    struct json_sem_count_err *sem_count_err = NULL;    /* semantic count error to print */
+    struct json_sem_val_err *sem_val_err = NULL;        /* semantic validation error to print */
+    intmax_t c;						/* dynamic array index and ignored lists iterator */
+
+    /*
+     * firewall
+     */
+    if (err == NULL) {
+	fwarn(stderr, __func__, "err is NULL");
+	return false;
+    }
+    if (submission_dir == NULL) {
+	fwarn(err, __func__, "submission_dir is NULL");
+	return false;
+    }
+    if (filename == NULL) {
+	fwarn(err, __func__, "filename is NULL");
+	return false;
+    }
+
+    /*
+     * open the JSON file under submission_dir
+     */
+    stream = open_dir_file(submission_dir, filename);
+    if (stream == NULL) {
+	fwarn(err, __func__, "failed to open: %s", filename);
+	return false;
+    }
+
+    /*
+     * parse the JSON file and check for valid JSON syntax
+     *
+     * NOTE: As stream is a regular file, parse_json_stream() maps it into
+     *	     memory and scans it in place rather than reading and copying it.
+     */
+    tree = parse_json_stream(stream, filename, &json_valid);
+    if (json_valid == false || tree == NULL) {
+	fwarn(err, __func__, "file contains invalid JSON: %s", filename);
+	return false;
+    }
+
+    /*
+     * perform JSON semantic checks if requested
+     */
+    if (sem != NULL) {
+
+	/*
+	 * perform JSON semantic analysis on the JSON parse tree
+	 */
+	all_err_count = json_sem_check_hash(tree, JSON_DEFAULT_MAX_DEPTH, sem, hash, &count_err, &val_err, NULL);
+
+	/*
+	 * firewall for semantic analysis
+	 */
+	if (count_err == NULL) {
+
+	    /* report failure */
+	    fwarn(err, __func__, "left count_err as NULL for JSON file: %s", filename);
+
+	    /* free storage */
+	    if (val_err != NULL) {
+		free_count_err(val_err);
+		val_err = NULL;
+	    }
+	    if (tree != NULL) {
+		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
+		tree = NULL;
+	    }
+	    return false;
+	}
+	if (val_err == NULL) {
+
+	    /* report failure */
+	    fwarn(err, __func__, "left val_err as NULL for JSON file: %s", filename);
+
+	    /* free storage */
+	    if (count_err != NULL) {
+		free_count_err(count_err);
+		count_err = NULL;
+	    }
+	    if (tree != NULL) {
+		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
+		tree = NULL;
+	    }
+	    return false;
+	}
+
+	/*
+	 * determine semantic error count
+	 */
+	count_err_count = dyn_array_tell(count_err);
+	val_err_count = dyn_array_tell(val_err);
+	if (all_err_count < count_err_count + val_err_count) {
+
+	    /* report failure */
+	    fwarn(err, __func__, "all_err_count: %jd < count_err_count: %jd + val_err_count: %jd for JSON file: %s",
+		       all_err_count, count_err_count, val_err_count, filename);
+
+	    /* free storage */
+	    if (count_err != NULL) {
+		free_count_err(count_err);
+		count_err = NULL;
+	    }
+	    if (val_err != NULL) {
+		free_count_err(val_err);
+		val_err = NULL;
+	    }
+	    if (tree != NULL) {
+		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
+		tree = NULL;
+	    }
+	    return false;
+	}
+	int_err_count = all_err_count - (count_err_count + val_err_count);
+
+	/*
+	 * report in details of the semantic analysis
+	 */
+	if (all_err_count > 0) {
+
+	    /* report errors */
+	    fpr(err, __func__, "follows are errors for JSON file: %s\n", filename);
+	    for (c=0; c < count_err_count; ++c) {
+		sem_count_err = dyn_array_addr(count_err, struct json_sem_count_err, c);
+		fprint_count_err(err, "JSON semantic count error ", sem_count_err, "\n");
+	    }
+	    for (c=0; c < val_err_count; ++c) {
+		sem_val_err = dyn_array_addr(val_err, struct json_sem_val_err, c);
+		fprint_val_err(err, "JSON semantic validation error ", sem_val_err, "\n");
+	    }
+	    if (int_err_count > 0) {
+		fpr(err, __func__, "%s internal JSON semantic error(s) found: %ju\n", filename, int_err_count);
+	    }
+	    fpr(err, __func__, "%s total JSON semantic error(s) found: %ju\n", filename, all_err_count);
+
+	    /* free storage */
+	    if (count_err != NULL) {
+		free_count_err(count_err);
+		count_err = NULL;
+	    }
+	    if (val_err != NULL) {
+		free_count_err(val_err);
+		val_err = NULL;
+	    }
+	    if (tree != NULL) {
+		json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
+		tree = NULL;
+	    }
+	    return false;
+	}
+
+	/*
+	 * free storage
+	 */
+	if (count_err != NULL) {
+	    free_count_err(count_err);
+	    count_err = NULL;
+	}
+	if (val_err != NULL) {
+	    free_count_err(val_err);
+	    val_err = NULL;
+	}
+    }
+    if (tree != NULL) {
+	json_tree_free(tree, JSON_DEFAULT_MAX_DEPTH);
+	tree = NULL;
+    }
+    dbg(DBG_LOW, "JSON file is OK: %s", filename);
+    return true;
+}
+
+
+/*
+ * chk_submit_perm - check the permissions of a walked submission directory
+ *
+ * Files ending in .sh (in any case) must be mode 0555, all other files
+ * must be mode 0444 and directories must be mode 0755.
+ *
+ * given:
+ *	wstat_p	    pointer to the struct walk_stat of the submission directory
+ *
+ * returns:
+ *	true ==> all permissions are OK
+ *	false ==> some file or directory has the wrong permissions
+ *
+ * NOTE: This function does not return on NULL pointer.
+ */
+bool
+chk_submit_perm(struct walk_stat *wstat_p)
+{
+    struct item *i_p;			/* pointer to an element in the dynamic array */
+    intmax_t len;			/* number of elements in the dynamic array */
+    bool perm_ok = true;		/* false ==> some wrong permission found */
+    intmax_t j;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL) {
+	err(171, __func__, "wstat_p is NULL");
+	not_reached();
+    }
+
+    /*
+     * scan files for permissions
+     */
+    len = dyn_array_tell(walk_view(wstat_p, WALK_FILE));
+    for (j=0; j < len; ++j) {
+
+	/*
+	 * obtain file permission
+	 */
+	i_p = dyn_array_value(walk_view(wstat_p, WALK_FILE), struct item *, j);
+	if (i_p == NULL) {
+	    err(172, __func__, "wstat.file[%jd] is NULL", j);
+	    not_reached();
+	} else if (i_p->fts_path == NULL) {
+	    err(173, __func__, "wstat.file[%jd].fts_path is NULL", j);
+	    not_reached();
+	} else if (i_p->fts_name == NULL) {
+	    err(174, __func__, "wstat.file[%jd].fts_name is NULL", j);
+	    not_reached();
+	}
+
+	/*
+	 * case: file ends in .sh in any case
+	 */
+	if (i_p->fts_namelen >= LITLEN(".sh") &&
+	    strcasecmp(i_p->fts_name + i_p->fts_namelen - LITLEN(".sh"), ".sh") == 0) {
+
+	    /*
+	     * verify mode 0555
+	     */
+	    if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0555) {
+		dbg(DBG_LOW, "shell file: %s permission: %03o != %03o",
+			      i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0555);
+		perm_ok = false;
+	    }
+
+	/*
+	 * case: file does NOT end in .sh
+	 */
+	} else {
+
+	    /*
+	     * verify mode 0444
+	     */
+	    if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0444) {
+		dbg(DBG_LOW, "non-shell file: %s permission: %03o != %03o",
+			      i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0444);
+		perm_ok = false;
+	    }
+	}
+    }
+
+    /*
+     * scan directories for permissions
+     */
+    len = dyn_array_tell(walk_view(wstat_p, WALK_DIR));
+    for (j=0; j < len; ++j) {
+
+	/*
+	 * obtain directory permission
+	 */
+	i_p = dyn_array_value(walk_view(wstat_p, WALK_DIR), struct item *, j);
+	if (i_p == NULL) {
+	    err(175, __func__, "wstat.dir[%jd] is NULL", j);
+	    not_reached();
+	} else if (i_p->fts_path == NULL) {
+	    err(176, __func__, "wstat.dir[%jd].fts_path is NULL", j);
+	    not_reached();
+	}
+
+	/*
+	 * verify mode 0755
+	 */
+	if (ITEM_PERM(i_p->st_mode) != ITEM_PERM_0755) {
+	    dbg(DBG_LOW, "directory: %s permission: %03o != %03o",
+			  i_p->fts_path, ITEM_PERM(i_p->st_mode), ITEM_PERM_0755);
+	    perm_ok = false;
+	}
+    }
+    return perm_ok;
+}
+
+
+/*
+ * walk_submit_dir - walk a submission directory as the chkentry -S checks do
+ *
+ * The items of the walk are sorted by path in a case independent way.
+ *
+ * given:
+ *	wstat_p		    pointer to a struct walk_stat to initialize and record the walk
+ *	submission_dir	    path of the submission directory
+ *
+ * returns:
+ *	true ==> the submission directory was walked
+ *	false ==> the walk failed
+ *
+ * NOTE: When finished with the walk_stat, the caller must call free_walk_stat(wstat_p).
+ *
+ * NOTE: This function does not return on NULL pointer.
+ */
+bool
+walk_submit_dir(struct walk_stat *wstat_p, char const *submission_dir)
+{
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || submission_dir == NULL) {
+	err(181, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    init_walk_stat(wstat_p,
+		   submission_dir, &walk_chkentry_S, "chkentry -S",
+		   MAX_PATH_LEN, MAX_FILENAME_LEN, MAX_PATH_DEPTH,
+		   false);
+    if (!fts_walk(wstat_p)) {
+	warn(__func__, "failed to scan: %s", submission_dir);
+	return false;
+    }
+    sort_walk_istat(wstat_p);
+    return true;
+}
+
+
+/*
+ * chk_submit_dir - perform the chkentry -S checks on a submission directory
+ *
+ * This is what chksubmit(1), by way of chkentry -S, checks: the submission
+ * directory is walked with the chkentry -S walk_set, the walk and the
+ * permissions are checked and then the .auth.json and .info.json files are
+ * checked.  Unlike running chksubmit(1), the walk_stat is left for the caller
+ * to use, e.g. to list the submission directory or to compare with a tarball
+ * formed from it.
+ *
+ * given:
+ *	wstat_p		    pointer to a struct walk_stat to initialize and record the walk
+ *	submission_dir	    path of the submission directory
+ *
+ * returns:
+ *	true ==> all is OK
+ *	false ==> some check failed
+ *
+ * NOTE: When finished with the walk_stat, the caller must call free_walk_stat(wstat_p).
+ *
+ * NOTE: This function does not return on NULL pointer or if the current
+ *	 directory cannot be restored.
+ */
+bool
+chk_submit_dir(struct walk_stat *wstat_p, char const *submission_dir)
+{
+    bool walk_ok = true;		/* true ==> no walk errors found, false ==> some walk errors found */
+    int cwd = -1;			/* current directory */
+    int ret;				/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || submission_dir == NULL) {
+	err(177, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * walk the submission directory as chkentry -S does
+     */
+    if (!walk_submit_dir(wstat_p, submission_dir)) {
+	return false;
+    }
+    walk_ok = chk_walk(wstat_p, stderr, MAX_EXTRA_FILE_COUNT, MAX_EXTRA_DIR_COUNT, NO_COUNT, NO_COUNT, true);
+    if (!walk_ok) {
+	dbg(DBG_LOW, "chkentry -S some walk errors were detected for: %s", submission_dir);
+    }
+
+    /*
+     * check permissions
+     */
+    if (!chk_submit_perm(wstat_p)) {
+	walk_ok = false;
+    }
+
+    /*
+     * cd to the submission directory as the .info.json manifest check walks .
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    cwd = open(".", O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if (cwd < 0) {
+	errp(178, __func__, "cannot open .");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for warnp() */
+    ret = chdir(submission_dir);
+    if (ret < 0) {
+	warnp(__func__, "cannot cd: %s", submission_dir);
+	walk_ok = false;
+    } else {
+
+	/*
+	 * check .auth.json and .info.json
+	 */
+	if (!chk_json_file(stderr, ".", AUTH_JSON_FILENAME, sem_auth, &sem_auth_hash)) {
+	    dbg(DBG_LOW, "invalid JSON file: %s/%s", submission_dir, AUTH_JSON_FILENAME);
+	    walk_ok = false;
+	}
+	if (!chk_json_file(stderr, ".", INFO_JSON_FILENAME, sem_info, &sem_info_hash)) {
+	    dbg(DBG_LOW, "invalid JSON file: %s/%s", submission_dir, INFO_JSON_FILENAME);
+	    walk_ok = false;
+	}
+    }
+
+    /*
+     * switch back to the previous current directory
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = fchdir(cwd);
+    if (ret < 0) {
+	errp(179, __func__, "cannot fchdir to the previous current directory");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = close(cwd);
+    if (ret < 0) {
+	errp(180, __func__, "close of previous current directory failed");
+	not_reached();
+    }
+    return walk_ok;
+}
+
+
+/*
+ * submit_mode_str - form the ls -l style mode string of a walk item
+ *
+ * given:
+ *	mode	st_mode of the item
+ *	buf	where to store SUBMIT_MODE_STR_LEN+1 bytes, e.g. "-r--r--r--"
+ */
+static void
+submit_mode_str(mode_t mode, char *buf)
+{
+    buf[0] = S_ISDIR(mode) ? 'd' : (S_ISREG(mode) ? '-' : '?');
+    buf[1] = (mode & S_IRUSR) ? 'r' : '-';
+    buf[2] = (mode & S_IWUSR) ? 'w' : '-';
+    buf[3] = (mode & S_IXUSR) ? 'x' : '-';
+    buf[4] = (mode & S_IRGRP) ? 'r' : '-';
+    buf[5] = (mode & S_IWGRP) ? 'w' : '-';
+    buf[6] = (mode & S_IXGRP) ? 'x' : '-';
+    buf[7] = (mode & S_IROTH) ? 'r' : '-';
+    buf[8] = (mode & S_IWOTH) ? 'w' : '-';
+    buf[9] = (mode & S_IXOTH) ? 'x' : '-';
+    buf[SUBMIT_MODE_STR_LEN] = '\0';
+}
+
+
+/*
+ * count_submit_dir - count the items of a submission directory walk
+ *
+ * given:
+ *	wstat_p		    walk of the submission directory, e.g. by walk_submit_dir()
+ *	totals		    where to store the counts
+ *
+ * NOTE: This function does not return on NULL pointer or a NULL item.
+ */
+void
+count_submit_dir(struct walk_stat *wstat_p, struct submit_totals *totals)
+{
+    struct item *i_p;		/* pointer to an element in the dynamic array */
+    intmax_t len;		/* number of elements in the dynamic array */
+    intmax_t j;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || wstat_p->all == NULL || totals == NULL) {
+	err(182, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    memset(totals, 0, sizeof(*totals));
+    len = dyn_array_tell(wstat_p->all);
+    for (j = 0; j < len; ++j) {
+	i_p = dyn_array_value(wstat_p->all, struct item *, j);
+	if (i_p == NULL || i_p->fts_path == NULL) {
+	    err(183, __func__, "wstat_p->all[%jd] is NULL or has a NULL fts_path", j);
+	    not_reached();
+	}
+	if (S_ISDIR(i_p->st_mode)) {
+	    ++totals->dirs;
+	} else if (S_ISREG(i_p->st_mode)) {
+	    ++totals->files;
+	    totals->file_bytes += (intmax_t)i_p->st_size;
+	    totals->kibibytes += ((intmax_t)i_p->st_size + 1023) / 1024;
+	} else {
+	    ++totals->other;
+	}
+    }
+    return;
+}
+
+
+/*
+ * list_submit_dir - list a submission directory from its walk
+ *
+ * Each file and directory is listed, in the (case independent) order of the
+ * walk, with its permissions and size, followed by a line of totals.
+ * This is what mkiocccentry shows instead of running ls -lakR.
+ *
+ * NOTE: The listing is not in the format of ls -lakR: there are no link
+ *	 counts, owners, groups or modification times, nor a total line for
+ *	 each directory.  See mkiocccentry(1) for the format.
+ *
+ * given:
+ *	stream		    where to print the listing
+ *	wstat_p		    walk of the submission directory, e.g. by walk_submit_dir()
+ *	totals		    where to store the counts of the listing
+ *
+ * returns:
+ *	true ==> listing printed
+ *	false ==> print error
+ *
+ * NOTE: This function does not return on NULL pointer or a NULL item.
+ */
+bool
+list_submit_dir(FILE *stream, struct walk_stat *wstat_p, struct submit_totals *totals)
+{
+    struct item *i_p;		/* pointer to an element in the dynamic array */
+    char mode[SUBMIT_MODE_STR_LEN + 1];	/* permission string */
+    intmax_t len;		/* number of elements in the dynamic array */
+    intmax_t j;
+    int ret;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL || wstat_p == NULL || wstat_p->all == NULL || totals == NULL) {
+	err(184, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    count_submit_dir(wstat_p, totals);
+    len = dyn_array_tell(wstat_p->all);
+    for (j = 0; j < len; ++j) {
+	i_p = dyn_array_value(wstat_p->all, struct item *, j);
+	submit_mode_str(i_p->st_mode, mode);
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = fprintf(stream, "%s %10jd %s%s\n", mode, (intmax_t)i_p->st_size, i_p->fts_path,
+					      S_ISDIR(i_p->st_mode) ? "/" : "");
+	if (ret <= 0) {
+	    warnp(__func__, "fprintf error listing: %s", i_p->fts_path);
+	    return false;
+	}
+    }
+    errno = 0;			/* pre-clear errno for warnp() */
+    ret = fprintf(stream, "\n%jd director%s, %jd file%s, %jd byte%s (%jd kibibyte block%s)\n",
+			  totals->dirs, totals->dirs == 1 ? "y" : "ies",
+			  totals->files, SINGULAR_OR_PLURAL(totals->files),
+			  totals->file_bytes, SINGULAR_OR_PLURAL(totals->file_bytes),
+			  totals->kibibytes, SINGULAR_OR_PLURAL(totals->kibibytes));
+    if (ret <= 0) {
+	warnp(__func__, "fprintf error listing totals");
+	return false;
+    }
+    return true;
+}
+
+
+/*
+ * json_list_submit_dir - write a JSON listing of a submission directory from its walk
+ *
+ * The listing is a JSON object with the name of the submission directory,
+ * the counts of count_submit_dir() and an array of each file and directory,
+ * in the (case independent) order of the walk, e.g.:
+ *
+ *	{
+ *	    "submission_dir" : "12345678-1234-4321-abcd-1234567890ab-0",
+ *	    "dirs" : 0,
+ *	    "files" : 5,
+ *	    "other" : 0,
+ *	    "file_bytes" : 8856,
+ *	    "kibibytes" : 12,
+ *	    "items" : [
+ *		{ "path" : "Makefile", "type" : "file", "mode" : "0444", "size" : 1854 },
+ *		...
+ *	    ]
+ *	}
+ *
+ * given:
+ *	stream		    where to write the JSON listing
+ *	wstat_p		    walk of the submission directory, e.g. by walk_submit_dir()
+ *	submission_dir	    name of the submission directory to record
+ *
+ * returns:
+ *	true ==> JSON listing written
+ *	false ==> write error
+ *
+ * NOTE: This function does not return on NULL pointer or a NULL item.
+ */
+bool
+json_list_submit_dir(FILE *stream, struct walk_stat *wstat_p, char const *submission_dir)
+{
+    struct submit_totals totals;	/* counts of the walk */
+    struct item *i_p;		/* pointer to an element in the dynamic array */
+    intmax_t len;		/* number of elements in the dynamic array */
+    intmax_t j;
+    bool ok;			/* true ==> all written */
+    int ret;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (stream == NULL || wstat_p == NULL || wstat_p->all == NULL || submission_dir == NULL) {
+	err(185, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    count_submit_dir(wstat_p, &totals);
+    errno = 0;			/* pre-clear errno for warnp() */
+    ret = fprintf(stream, "{\n    \"submission_dir\" : ");
+    ok = ret > 0 && json_fprintf_str(stream, submission_dir);
+    if (ok) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = fprintf(stream, ",\n"
+			      "    \"dirs\" : %jd,\n"
+			      "    \"files\" : %jd,\n"
+			      "    \"other\" : %jd,\n"
+			      "    \"file_bytes\" : %jd,\n"
+			      "    \"kibibytes\" : %jd,\n"
+			      "    \"items\" : [",
+			      totals.dirs, totals.files, totals.other, totals.file_bytes, totals.kibibytes);
+	ok = ret > 0;
+    }
+
+    /*
+     * write each item
+     */
+    len = dyn_array_tell(wstat_p->all);
+    for (j = 0; ok && j < len; ++j) {
+	i_p = dyn_array_value(wstat_p->all, struct item *, j);
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = fprintf(stream, "%s\n        { \"path\" : ", j == 0 ? "" : ",");
+	ok = ret > 0 && json_fprintf_str(stream, i_p->fts_path);
+	if (ok) {
+	    errno = 0;		/* pre-clear errno for warnp() */
+	    ret = fprintf(stream, ", \"type\" : \"%s\", \"mode\" : \"%04o\", \"size\" : %jd }",
+				  S_ISDIR(i_p->st_mode) ? "dir" : (S_ISREG(i_p->st_mode) ? "file" : "other"),
+				  (unsigned int)(i_p->st_mode & 07777), (intmax_t)i_p->st_size);
+	    ok = ret > 0;
+	}
+    }
+    if (ok) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = fprintf(stream, "%s]\n}\n", len > 0 ? "\n    " : "");
+	ok = ret > 0;
+    }
+    if (!ok) {
+	warnp(__func__, "error writing JSON listing of: %s", submission_dir);
+	return false;
+    }
+    return true;
+}
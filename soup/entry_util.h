@@ -274,6 +274,20 @@ struct manifest
     struct dyn_array *shell;    /* dynamic array of shell script filenames (char *) */
 };
 
+/*
+ * submission directory listing - see list_submit_dir() and json_list_submit_dir()
+ */
+#define SUBMIT_MODE_STR_LEN (10)	/* length of a listed mode string, e.g. -r--r--r-- */
+
+struct submit_totals
+{
+    intmax_t dirs;		/* number of directories under the submission directory */
+    intmax_t files;		/* number of regular files */
+    intmax_t other;		/* number of other items, which the chkentry -S checks reject */
+    intmax_t file_bytes;	/* total size of the regular files */
+    intmax_t kibibytes;		/* total of the file sizes, each rounded up to kibibyte (2^10) blocks */
+};
+
 
 /*
  * external function declarations
@@ -357,6 +371,14 @@ extern bool is_mandatory_filename(char const *str);
 extern bool is_executable_filename(char const *str);
 extern bool has_ignored_dirname(char const *path);
 extern size_t count_char(char const *str, int ch);
+extern bool chk_json_file(FILE *err, char const *submission_dir, char const *filename, struct json_sem *sem,
+			  struct json_sem_hash const *hash);
+extern bool chk_submit_perm(struct walk_stat *wstat_p);
+extern bool walk_submit_dir(struct walk_stat *wstat_p, char const *submission_dir);
+extern bool chk_submit_dir(struct walk_stat *wstat_p, char const *submission_dir);
+extern void count_submit_dir(struct walk_stat *wstat_p, struct submit_totals *totals);
+extern bool list_submit_dir(FILE *stream, struct walk_stat *wstat_p, struct submit_totals *totals);
+extern bool json_list_submit_dir(FILE *stream, struct walk_stat *wstat_p, char const *submission_dir);
 
 
 #endif /* INCLUDE_ENTRY_UTIL_H */
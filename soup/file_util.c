@@ -46,6 +46,13 @@
 /* exit code change of order - use new value in sequencing - coo */
 
 
+/*
+ * needed for copy_file_range(2)
+ */
+#if !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
@@ -57,6 +64,11 @@
 #include <stdarg.h>
 #include <fcntl.h>		/* for open(2) */
 #include <libgen.h>		/* for basename(3) */
+#if defined(__linux__)
+#include <sys/ioctl.h>		/* for ioctl(2) */
+#include <sys/sendfile.h>	/* for sendfile(2) */
+#include <linux/fs.h>		/* for FICLONE */
+#endif /* __linux__ */
 
 /*
  * dbg - info, debug, warning, error, and usage message facility
@@ -91,6 +103,13 @@
 
 #define PATH_INITIAL_SIZE (16)	/* initially allocate this many pointers */
 #define PATH_CHUNK_SIZE (8)	/* grow dynamic array by this many pointers at a time */
+#define COPYFILE_CHUNK (1024*1024*1024)	/* most bytes to copy per copy_file_range(2) or sendfile(2) call */
+
+
+/*
+ * static functions
+ */
+static size_t copy_fd(int infd, int outfd, off_t in_size, char const *src, char const *dest, enum copy_method *method_p);
 
 
 /*
@@ -1422,6 +1441,176 @@ resolve_path(char const *cmd)
 }
 
 
+/*
+ * copy_method_name - name of an enum copy_method
+ *
+ * given:
+ *	method	    - how copyfile_method() copied a file
+ *
+ * returns:
+ *	name of the method, for debugging and reporting purposes
+ */
+char const *
+copy_method_name(enum copy_method method)
+{
+    switch (method) {
+    case COPY_METHOD_NONE:
+	return "none";
+    case COPY_METHOD_CLONE:
+	return "FICLONE";
+    case COPY_METHOD_RANGE:
+	return "copy_file_range";
+    case COPY_METHOD_SENDFILE:
+	return "sendfile";
+    case COPY_METHOD_BUFFER:
+	return "read/write";
+    default:
+	break;
+    }
+    return "((unknown copy method))";
+}
+
+
+/*
+ * copy_fd - copy the rest of an open file to another open file
+ *
+ * Try, in order, to reflink the file with FICLONE, to copy it in the kernel
+ * with copy_file_range(2), then with sendfile(2), and finally to copy it with
+ * read(2) and write(2) of a buffer of COPYFILE_BUF_SIZE bytes.  A method that
+ * the file systems or the kernel do not support falls back to the next method,
+ * continuing where the previous one stopped.
+ *
+ * given:
+ *      infd        - open descriptor of src file, at offset 0
+ *      outfd       - open descriptor of an empty dest file, at offset 0
+ *      in_size     - st_size of the src file
+ *      src         - src file path, for error messages
+ *      dest        - dest file path, for error messages
+ *      method_p    - set to the method that copied the last of the file
+ *
+ * returns:
+ *      the number of bytes written to dest file
+ *
+ * NOTE: The FICLONE, copy_file_range(2) and sendfile(2) methods are only tried on Linux.
+ *
+ * This function does not return on error.
+ */
+static size_t
+copy_fd(int infd, int outfd, off_t in_size, char const *src, char const *dest, enum copy_method *method_p)
+{
+    size_t outbytes = 0;        /* bytes written to dest file */
+    ssize_t inbytes = 0;        /* bytes read from src file or copied by the kernel */
+    ssize_t wbytes = 0;         /* bytes written by write(2) */
+    char *buf = NULL;           /* buffer of the read(2) and write(2) method */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (src == NULL || dest == NULL || method_p == NULL) {
+        err(97, __func__, "called with NULL arg(s)");
+        not_reached();
+    }
+    *method_p = COPY_METHOD_NONE;
+
+#if defined(__linux__)
+    /*
+     * try to share the data blocks of src file with FICLONE
+     */
+    if (in_size > 0 && ioctl(outfd, FICLONE, infd) == 0) {
+        *method_p = COPY_METHOD_CLONE;
+        return (size_t)in_size;
+    }
+
+    /*
+     * try to copy in the kernel with copy_file_range(2)
+     *
+     * NOTE: Some file systems, such as procfs, report a size of 0 for files
+     *       with contents, and copy_file_range(2) copies nothing from them.
+     *       So if nothing is copied, we fall back as well.
+     */
+    for (;;) {
+        errno = 0;      /* pre-clear errno for errp() */
+        inbytes = copy_file_range(infd, NULL, outfd, NULL, COPYFILE_CHUNK, 0);
+        if (inbytes > 0) {
+            outbytes += (size_t)inbytes;
+            *method_p = COPY_METHOD_RANGE;
+            continue;
+        } else if (inbytes == 0 && outbytes > 0) {
+            return outbytes;
+        } else if (inbytes == 0 || errno == EXDEV || errno == EINVAL || errno == ENOSYS ||
+                   errno == EOPNOTSUPP || errno == ENOTSUP || errno == EPERM || errno == EBADF) {
+            dbg(DBG_VHIGH, "copy_file_range of %s to %s not possible after %zu bytes, falling back", src, dest, outbytes);
+            break;
+        }
+        errp(98, __func__, "copy_file_range of %s to %s failed after %zu bytes", src, dest, outbytes);
+        not_reached();
+    }
+
+    /*
+     * try to copy in the kernel with sendfile(2)
+     */
+    for (;;) {
+        errno = 0;      /* pre-clear errno for errp() */
+        inbytes = sendfile(outfd, infd, NULL, COPYFILE_CHUNK);
+        if (inbytes > 0) {
+            outbytes += (size_t)inbytes;
+            *method_p = COPY_METHOD_SENDFILE;
+            continue;
+        } else if (inbytes == 0 && outbytes > 0) {
+            return outbytes;
+        } else if (inbytes == 0 || errno == EINVAL || errno == ENOSYS) {
+            dbg(DBG_VHIGH, "sendfile of %s to %s not possible after %zu bytes, falling back", src, dest, outbytes);
+            break;
+        }
+        errp(99, __func__, "sendfile of %s to %s failed after %zu bytes", src, dest, outbytes);
+        not_reached();
+    }
+#else
+    UNUSED_ARG(in_size);
+#endif /* __linux__ */
+
+    /*
+     * copy the rest with read(2) and write(2) of a fixed size buffer
+     */
+    errno = 0;      /* pre-clear errno for errp() */
+    buf = malloc(COPYFILE_BUF_SIZE);
+    if (buf == NULL) {
+        errp(100, __func__, "malloc of %d byte copy buffer failed", COPYFILE_BUF_SIZE); /*ooo*/
+        not_reached();
+    }
+    *method_p = COPY_METHOD_BUFFER;
+    for (;;) {
+        errno = 0;      /* pre-clear errno for errp() */
+        inbytes = read(infd, buf, COPYFILE_BUF_SIZE);
+        if (inbytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            errp(45, __func__, "couldn't read in src file: %s after %zu bytes", src, outbytes);
+            not_reached();
+        } else if (inbytes == 0) {
+            break;
+        }
+        for (i = 0; i < (size_t)inbytes; i += (size_t)wbytes) {
+            errno = 0;      /* pre-clear errno for errp() */
+            wbytes = write(outfd, buf + i, (size_t)inbytes - i);
+            if (wbytes < 0 && errno == EINTR) {
+                wbytes = 0;
+            } else if (wbytes <= 0) {
+                errp(49, __func__, "error: wrote %zu bytes out of expected %zu bytes",
+                     outbytes + i, outbytes + (size_t)inbytes);
+                not_reached();
+            }
+        }
+        outbytes += (size_t)inbytes;
+    }
+    free(buf);
+    buf = NULL;
+    return outbytes;
+}
+
+
 /*
  * copyfile - copy src file (path) to dest file (path)
  *
@@ -1431,6 +1620,28 @@ resolve_path(char const *cmd)
  *      copy_mode   - true ==> copy st_mode from source file, false ==> set mode in mode
  *      mode        - mode for chmod(2) if copy_mode == false
  *
+ * This function is copyfile_method() without reporting how the file was copied.
+ *
+ * returns:
+ *      the number of bytes written to dest file
+ */
+size_t
+copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode)
+{
+    return copyfile_method(src, dest, copy_mode, mode, NULL);
+}
+
+
+/*
+ * copyfile_method - copy src file (path) to dest file (path) and report how
+ *
+ * given:
+ *      src         - src file path
+ *      dest        - dest file path
+ *      copy_mode   - true ==> copy st_mode from source file, false ==> set mode in mode
+ *      mode        - mode for chmod(2) if copy_mode == false
+ *      method_p    - if non-NULL, set to how the file was copied (see copy_fd())
+ *
  * This function does not return on NULL pointers.
  *
  * This function will not return on an allocation error.
@@ -1441,23 +1652,29 @@ resolve_path(char const *cmd)
  * is an error. If the copied contents is not the same (in the written file) as
  * the source file it is an error.
  *
+ * NOTE: Neither the file nor the copy is read into memory: the file is copied
+ *	 by copy_fd(), and the copy is compared with the file COPYFILE_BUF_SIZE
+ *	 bytes at a time.
+ *
  * returns:
  *      the number of bytes written to dest file
  */
 size_t
-copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode)
+copyfile_method(char const *src, char const *dest, bool copy_mode, mode_t mode, enum copy_method *method_p)
 {
-    size_t inbytes = 0;         /* bytes read in from src file */
+    size_t inbytes = 0;         /* bytes read back from the src and dest files */
     size_t outbytes = 0;        /* bytes written to dest file */
-    FILE *in_file = NULL;       /* source file stream */
-    FILE *out_file = NULL;      /* output file stream */
-    void *buf = NULL;           /* src file contents */
-    void *copy = NULL;          /* to verify copied buffer is the same */
+    ssize_t in_len = 0;         /* bytes of src file read into buf */
+    ssize_t out_len = 0;        /* bytes of dest file read into copy */
+    char *buf = NULL;           /* src file contents */
+    char *copy = NULL;          /* to verify copied buffer is the same */
     int infd = -1;              /* input file file descriptor */
     int outfd = -1;             /* output file file descriptor */
+    int copyfd = -1;            /* dest file descriptor to verify the copy */
     int ret = -1;               /* libc return value */
     struct stat in_st;          /* to get the permissions of source file */
     struct stat out_st;
+    enum copy_method method = COPY_METHOD_NONE;	/* how the file was copied */
 
     /*
      * firewall
@@ -1504,19 +1721,9 @@ copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode)
      * open src file for reading
      */
     errno = 0;      /* pre-clear errno for errp() */
-    in_file = fopen(src, "rb");
-    if (in_file == NULL) {
-        errp(42, __func__, "couldn't open src file %s for reading: %s", src, strerror(errno));
-        not_reached();
-    }
-
-    /*
-     * obtain file descriptor of src file
-     */
-    errno = 0; /* pre-clear errno for errp() */
-    infd = open(src, O_RDONLY|O_CLOEXEC, S_IRWXU);
+    infd = open(src, O_RDONLY|O_CLOEXEC);
     if (infd < 0) {
-        errp(43, __func__, "failed to obtain file descriptor for %s: %s", src, strerror(errno));
+        errp(42, __func__, "couldn't open src file %s for reading: %s", src, strerror(errno));
         not_reached();
     }
 
@@ -1530,148 +1737,103 @@ copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode)
         not_reached();
     }
 
-
-    /*
-     * ensure inbytes is 0 before we read anything in
-     */
-    inbytes = 0;
-    /*
-     * read in entire source file
-     */
-    buf = read_all(in_file, &inbytes);
-    if (buf == NULL) {
-        err(45, __func__, "couldn't read in src file: %s", src);
-        not_reached();
-    }
-
-    dbg(DBG_HIGH, "read %zu bytes from src file %s", inbytes, src);
-
-    /*
-     * close the src file
-     */
-    errno = 0;			/* pre-clear errno for errp() */
-    ret = fclose(in_file);
-    if (ret < 0) {
-	errp(46, __func__, "fclose error for %s: %s", src, strerror(errno));
-	not_reached();
-    }
-
     /*
      * open dest file for writing
+     *
+     * NOTE: O_EXCL ensures we do not overwrite a dest file that was formed after the above check.
      */
     errno = 0;          /* pre-clear errno for errp() */
-    out_file = fopen(dest, "wb");
-    if (out_file == NULL) {
-        if (buf != NULL) {
-            free(buf);
-            buf = NULL;
-        }
-        errp(47, __func__, "couldn't open dest file %s for writing: %s", dest, strerror(errno));
-        not_reached();
-    }
-
-    /*
-     * obtain file descriptor of dest file
-     */
-    errno = 0; /* pre-clear errno for errp() */
-    outfd = open(dest, O_WRONLY|O_CLOEXEC, S_IRWXU);
+    outfd = open(dest, O_WRONLY|O_CREAT|O_EXCL|O_CLOEXEC, S_IRUSR|S_IWUSR);
     if (outfd < 0) {
-        errp(48, __func__, "failed to obtain file descriptor for %s: %s", dest, strerror(errno));
+        errp(47, __func__, "couldn't open dest file %s for writing: %s", dest, strerror(errno));
         not_reached();
     }
 
-
     /*
-     * write buffer into the dest file
+     * copy src file into the dest file
      */
-    errno = 0;		/* pre-clear errno for warnp() */
-    outbytes = fwrite(buf, 1, inbytes, out_file);
-    if (outbytes != inbytes) {
-        errp(49, __func__, "error: wrote %zu bytes out of expected %zu bytes", outbytes, inbytes);
-        not_reached();
-    } else {
-        dbg(DBG_HIGH, "wrote %zu bytes to dest file %s == %zu read bytes", outbytes, src, inbytes);
-    }
-
-    /*
-     * close the dest file
-     */
-    errno = 0;			/* pre-clear errno for errp() */
-    ret = fclose(out_file);
-    if (ret < 0) {
-	errp(50, __func__, "fclose error for %s: %s", dest, strerror(errno));
-	not_reached();
-    }
+    outbytes = copy_fd(infd, outfd, in_st.st_size, src, dest, &method);
+    dbg(DBG_HIGH, "copied %zu bytes from src file %s to dest file %s via %s",
+		  outbytes, src, dest, copy_method_name(method));
 
     /*
      * we need to open the file for reading, to verify that it's the same as the
-     * src file buffer
+     * src file
      */
     errno = 0;          /* pre-clear errno for errp() */
-    out_file = fopen(dest, "rb");
-    if (out_file == NULL) {
-        if (buf != NULL) {
-            free(buf);
-            buf = NULL;
-        }
-        err(51, __func__, "couldn't open dest file for reading: %s: %s", dest, strerror(errno));
+    copyfd = open(dest, O_RDONLY|O_CLOEXEC);
+    if (copyfd < 0) {
+        errp(51, __func__, "couldn't open dest file for reading: %s: %s", dest, strerror(errno));
         not_reached();
     }
 
     /*
-     * now that we have the copied file open for reading, we need to read in the
-     * contents, to compare it to the source file's contents
-     */
-
-    /*
-     * ensure inbytes is 0 before we read anything in
-     */
-    inbytes = 0;
-    /*
-     * read in entire source file
+     * now that we have the copied file open for reading, we need to compare its
+     * contents to the source file's contents, a buffer at a time
      */
-    copy = read_all(out_file, &inbytes);
-    if (copy == NULL) {
-        err(52, __func__, "couldn't read in dest file: %s", dest);
+    errno = 0;      /* pre-clear errno for errp() */
+    buf = malloc(COPYFILE_BUF_SIZE);
+    copy = malloc(COPYFILE_BUF_SIZE);
+    if (buf == NULL || copy == NULL) {
+        errp(101, __func__, "malloc of %d byte compare buffers failed", COPYFILE_BUF_SIZE); /*ooo*/
         not_reached();
     }
+    inbytes = 0;
+    do {
+        errno = 0;          /* pre-clear errno for errp() */
+        in_len = pread(infd, buf, COPYFILE_BUF_SIZE, (off_t)inbytes);
+        if (in_len < 0) {
+            errp(102, __func__, "couldn't read in src file: %s", src); /*ooo*/
+            not_reached();
+        }
+        errno = 0;          /* pre-clear errno for errp() */
+        out_len = pread(copyfd, copy, COPYFILE_BUF_SIZE, (off_t)inbytes);
+        if (out_len < 0) {
+            errp(52, __func__, "couldn't read in dest file: %s", dest);
+            not_reached();
+        }
 
-    dbg(DBG_HIGH, "read %zu bytes from dest file %s", inbytes, src);
-
-    /*
-     * close the dest file
-     */
-    errno = 0;			/* pre-clear errno for errp() */
-    ret = fclose(out_file);
-    if (ret < 0) {
-	errp(53, __func__, "fclose error for %s: %s", dest, strerror(errno));
-	not_reached();
-    }
+        /*
+         * first check that the bytes read in is the same as the bytes written
+         */
+        if (out_len != in_len || inbytes + (size_t)out_len > outbytes) {
+            err(103, __func__, "error: read %zu bytes out of expected %zu bytes", /*ooo*/
+                    inbytes + (size_t)out_len, outbytes);
+            not_reached();
+        }
 
-    /*
-     * first check that the bytes read in is the same as the bytes written
-     */
-    if (outbytes != inbytes) {
+        /*
+         * we need to check that the buffer read from src file is the same as the
+         * buffer from the dest file (copy of src file)
+         */
+        if (memcmp(copy, buf, (size_t)in_len) != 0) {
+            err(55, __func__, "copy of src file %s is not the same as the contents of the dest file %s", src, dest);
+            not_reached();
+        }
+        inbytes += (size_t)in_len;
+    } while (in_len > 0);
+    if (inbytes != outbytes) {
         err(54, __func__, "error: read %zu bytes out of expected %zu bytes", inbytes, outbytes);
         not_reached();
-    } else {
-        dbg(DBG_HIGH, "read in %zu bytes from dest file %s out of expected %zu bytes from src file %s",
-                inbytes, dest, outbytes, src);
     }
+    dbg(DBG_HIGH, "copy of src file %s is identical to dest file %s", src, dest);
 
     /*
-     * we need to check that the buffer read from src file is the same as the
-     * buffer from the dest file (copy of src file)
+     * close the dest file we read back and the src file
      */
-    if (memcmp(copy, buf, inbytes) != 0) {
-        err(55, __func__, "copy of src file %s is not the same as the contents of the dest file %s", src, dest);
-        not_reached();
-    } else {
-        dbg(DBG_HIGH, "copy of src file %s is identical to dest file %s", src, dest);
+    errno = 0;			/* pre-clear errno for errp() */
+    if (close(copyfd) < 0) {
+	errp(53, __func__, "close error for %s: %s", dest, strerror(errno));
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    if (close(infd) < 0) {
+	errp(46, __func__, "close error for %s: %s", src, strerror(errno)); /*ooo*/
+	not_reached();
     }
 
     /*
-     * now we need to free the read in data (buf and copy)
+     * now we need to free the compare buffers (buf and copy)
      */
     if (buf != NULL) {
         free(buf);
@@ -1753,6 +1915,13 @@ copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode)
         errp(60, __func__, "close(outfd) failed: %s", strerror(errno));
         not_reached();
     }
+
+    /*
+     * report how the file was copied
+     */
+    if (method_p != NULL) {
+        *method_p = method;
+    }
     return outbytes;
 }
 
@@ -129,6 +129,22 @@
 #define ITEM_IS_NOT_DIRSYM(st_mode) (! ITEM_IS_DIRSYM(st_mode))
 #define ITEM_IS_NOT_FILEDIRSYM(st_mode) (! ITEM_IS_FILEDIRSYM(st_mode))
 
+/*
+ * copyfile_method() buffer size
+ */
+#define COPYFILE_BUF_SIZE (65536)	/* bytes read at a time to copy, or to verify a copy */
+
+/*
+ * enum copy_method - how copyfile_method() copied a file
+ */
+enum copy_method {
+    COPY_METHOD_NONE = 0,	/* nothing was copied */
+    COPY_METHOD_CLONE,		/* data blocks shared with FICLONE (reflink) */
+    COPY_METHOD_RANGE,		/* copied in the kernel with copy_file_range(2) */
+    COPY_METHOD_SENDFILE,	/* copied in the kernel with sendfile(2) */
+    COPY_METHOD_BUFFER,		/* copied with read(2) and write(2) of a buffer */
+};
+
 
 /*
  * external function declarations
@@ -156,6 +172,9 @@ extern off_t size_if_file(char const *path);
 extern bool is_empty(char const *path);
 extern char *resolve_path(char const *cmd);
 extern size_t copyfile(char const *src, char const *dest, bool copy_mode, mode_t mode);
+extern size_t copyfile_method(char const *src, char const *dest, bool copy_mode, mode_t mode,
+			      enum copy_method *method_p);
+extern char const *copy_method_name(enum copy_method method);
 extern void touch(char const *path, mode_t mode);
 extern void touchat(char const *path, mode_t mode, char const *dir, int dirfd);
 extern int mkdirs(int dirfd, const char *str, mode_t mode);
@@ -0,0 +1,394 @@
+/*
+ * fnamchk_util - check an IOCCC compressed tarball filename
+ *
+ * "Because most people become disappointed when someone gets their name wrong." :-)
+ *
+ * Copyright (c) 2022-2026 by Landon Curt Noll and Cody Boone Ferguson.
+ * All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+/*
+ * system includes
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+
+/*
+ * canon_path - canonicalize paths
+ */
+#include "../cpath/cpath.h"
+
+/*
+ * file_util - common utility functions for file operations
+ */
+#include "file_util.h"
+
+/*
+ * fnamchk_util - check an IOCCC compressed tarball filename
+ */
+#include "fnamchk_util.h"
+
+
+/*
+ * static declarations
+ */
+static bool submit_filename_fail(struct submit_filename *sub, int code, char const *fmt, ...)
+	__attribute__((format(printf, 3, 4)));
+
+
+/*
+ * submit_filename_fail - record why a filename is not valid
+ *
+ * given:
+ *	sub	- the result of chk_submit_filename()
+ *	code	- fnamchk(1) exit code of the failed check
+ *	fmt	- printf format of why the check failed
+ *	...	- args for fmt
+ *
+ * returns:
+ *	false
+ */
+static bool
+submit_filename_fail(struct submit_filename *sub, int code, char const *fmt, ...)
+{
+    va_list ap;		/* variable argument list */
+
+    /*
+     * firewall
+     */
+    if (sub == NULL || fmt == NULL) {
+	err(95, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    sub->code = code;
+    va_start(ap, fmt);
+    (void) vsnprintf(sub->msg, sizeof(sub->msg), fmt, ap);
+    va_end(ap);
+    dbg(DBG_MED, "filename check failed with code %d: %s", code, sub->msg);
+    return false;
+}
+
+
+/*
+ * chk_submit_filename - check that a path is a valid IOCCC compressed tarball filename
+ *
+ * A valid filename is of the form:
+ *
+ *	submit.test-slot.timestamp.ext
+ *	submit.UUID-slot.timestamp.ext
+ *
+ * where test-slot or UUID-slot is the name of the submit directory in the
+ * tarball.
+ *
+ * given:
+ *	path		- path to check
+ *	ext		- the extension that the filename must have (NULL ==> "txz")
+ *	test_mode	- true ==> filename must be a test submit filename,
+ *			  false ==> filename must be a UUID submit filename
+ *	ignore_timestamp - true ==> do not check the timestamp
+ *	sub		- where to put what was found in the filename
+ *
+ * returns:
+ *	true ==> filename is valid, sub->dirname is the submit directory
+ *	false ==> filename is not valid, sub->code and sub->msg say why
+ *
+ * NOTE: the checks and sub->code values are those of fnamchk(1), which is a
+ *	 thin wrapper of this function.
+ * NOTE: call free_submit_filename(sub) when done with sub, even if this
+ *	 function returns false.
+ *
+ * This function does not return on NULL args or when out of memory.
+ */
+bool
+chk_submit_filename(char const *path, char const *ext, bool test_mode, bool ignore_timestamp,
+		    struct submit_filename *sub)
+{
+    enum path_sanity sanity = PATH_ERR_UNSET;	/* canon_path error or PATH_OK */
+    char *saveptr = NULL;	/* for strtok_r() */
+    char *submit;		/* first '.' separated token - submit */
+    char *uuid;			/* second '.' separated token - test-slot or UUID-slot */
+    char *timestamp_str;	/* third '.' separated token - timestamp */
+    char *extension;		/* fourth '.' separated token - filename extension */
+    size_t len;			/* length of uuid */
+    unsigned int a, b, c, d, e, f;	/* parts of the UUID string */
+    unsigned int version = 0;	/* UUID version hex character */
+    unsigned int variant = 0;	/* UUID variant hex character */
+    char guard;			/* scanf guard to catch excess amount of input */
+    int submit_slot;		/* submit slot number */
+    intmax_t timestamp;		/* timestamp */
+    int ret;			/* libc return code */
+
+    /*
+     * firewall
+     */
+    if (path == NULL || sub == NULL) {
+	err(96, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    if (ext == NULL) {
+	ext = "txz";
+    }
+    memset(sub, 0, sizeof(*sub));
+
+    /*
+     * canonicalize the path
+     *
+     * IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function.
+     */
+    sub->filepath = canon_path(path, 0, 0, 0, &sanity, NULL, NULL, false, false, true, true, NULL);
+    if (sub->filepath == NULL) {
+	return submit_filename_fail(sub, 3, "bogus filepath: %s error: %s", path, path_sanity_error(sanity));
+    }
+    dbg(DBG_LOW, "filepath: %s", sub->filepath);
+
+    /*
+     * obtain the basename of the path to examine
+     */
+    sub->filename = base_name(sub->filepath);
+    if (sub->filename == NULL) {
+	return submit_filename_fail(sub, 55, "base_name(\"%s\") returned NULL", sub->filepath);
+    }
+    dbg(DBG_LOW, "filename: %s", sub->filename);
+    errno = 0;		/* pre-clear errno for errp() */
+    sub->tokens = strdup(sub->filename);
+    if (sub->tokens == NULL) {
+	errp(97, __func__, "strdup(\"%s\") failed", sub->filename);
+	not_reached();
+    }
+
+    /*
+     * first '.' separated token must be submit
+     */
+    submit = strtok_r(sub->tokens, ".", &saveptr);
+    if (submit == NULL) {
+	return submit_filename_fail(sub, 56, "first strtok_r() returned NULL");
+    }
+    if (strcmp(submit, "submit") != 0) {
+	return submit_filename_fail(sub, 57, "filename does not start with \"submit.\": %s", sub->filepath);
+    }
+    dbg(DBG_LOW, "filename starts with \"submit.\": %s", sub->filename);
+
+    /*
+     * second '.' separated token must be test or a UUID
+     */
+    uuid = strtok_r(NULL, ".", &saveptr);
+    if (uuid == NULL) {
+	return submit_filename_fail(sub, 58, "nothing found after \"submit.\"");
+    }
+    len = strlen(uuid);
+
+    /*
+     * parse a test-submit_slot IOCCC contest ID
+     */
+    if (strncmp(uuid, "test-", LITLEN("test-")) == 0) {
+	/* if it starts as "test-" and test mode was not requested it's an error */
+	if (!test_mode) {
+	    return submit_filename_fail(sub, 59, "-t not specified with filename that starts as a test mode filename: %s",
+					sub->filepath);
+	}
+
+	/*
+	 * NOTE: the txzchk_test.sh script has a test file where it expects this code.
+	 */
+	if (len != LITLEN("test-")+MAX_SUBMIT_SLOT_CHARS) {
+	    return submit_filename_fail(sub, 4, "\"submit.test-\" separated token length: %zu != %zu: %s",
+					len, (LITLEN("test-")+MAX_SUBMIT_SLOT_CHARS), sub->filepath);
+	}
+	ret = sscanf(uuid, "test-%d%c", &submit_slot, &guard);
+	if (ret != 1) {
+	    return submit_filename_fail(sub, 60, "submit_slot not found after \"test-\": %s", sub->filepath);
+	}
+	dbg(DBG_LOW, "submit ID is test: %s", uuid);
+	if (submit_slot < 0) {
+	    return submit_filename_fail(sub, 61, "submit_slot %d is < 0: %s", submit_slot, sub->filepath);
+	}
+	if (submit_slot > MAX_SUBMIT_SLOT) {
+	    return submit_filename_fail(sub, 62, "submit_slot %d is > %d: %s", submit_slot, MAX_SUBMIT_SLOT,
+					sub->filepath);
+	}
+	dbg(DBG_LOW, "submit_slot %d is valid: %s", submit_slot, sub->filepath);
+	strcpy(sub->contest_id, "test");
+	sub->test_mode = true;
+
+    /*
+     * parse a UUID-submit_slot IOCCC contest ID
+     */
+    } else {
+	/*
+	 * if test mode was requested and we get here (filename does not start
+	 * with "submit.test-") then it's an error.
+	 */
+	if (test_mode) {
+	    return submit_filename_fail(sub, 63, "-t specified and filename does not start with \"submit.test-\": %s",
+					sub->filepath);
+	}
+
+	/*
+	 * NOTE: the txzchk_test.sh script has a test file where it expects this code.
+	 */
+	if (len != UUID_LEN+1+MAX_SUBMIT_SLOT_CHARS) {
+	    return submit_filename_fail(sub, 5, "\"submit.UUID-\" separated token length: %zu != %d: %s",
+					len, (UUID_LEN+1+MAX_SUBMIT_SLOT_CHARS), sub->filepath);
+	}
+	ret = sscanf(uuid, "%8x-%4x-%1x%3x-%1x%3x-%8x%4x-%d%c", &a, &b, &version, &c, &variant,
+	    &d, &e, &f, &submit_slot, &guard);
+	if (ret != 9) {
+	    return submit_filename_fail(sub, 64, "UUID-submit_slot not found after \"submit-\": %s", sub->filepath);
+	}
+	if (version != UUID_VERSION) {
+	    return submit_filename_fail(sub, 65, "UUID token version %x != %x: %s", version, UUID_VERSION,
+					sub->filepath);
+	}
+	if (variant != UUID_VARIANT_0 && variant != UUID_VARIANT_1 && variant != UUID_VARIANT_2 &&
+	variant != UUID_VARIANT_3) {
+	    return submit_filename_fail(sub, 66, "UUID token variant %x not one of %x, %x, %x, %x: %s", variant,
+					UUID_VARIANT_0, UUID_VARIANT_1, UUID_VARIANT_2, UUID_VARIANT_3, sub->filepath);
+	}
+	dbg(DBG_LOW, "submit ID is a valid UUID: %s", uuid);
+	if (submit_slot < 0) {
+	    return submit_filename_fail(sub, 67, "submit_slot %d is < 0: %s", submit_slot, sub->filepath);
+	}
+	if (submit_slot > MAX_SUBMIT_SLOT) {
+	    return submit_filename_fail(sub, 68, "submit_slot %d is > %d: %s", submit_slot, MAX_SUBMIT_SLOT,
+					sub->filepath);
+	}
+	dbg(DBG_LOW, "submit number is valid: %d", submit_slot);
+	memcpy(sub->contest_id, uuid, UUID_LEN);
+	sub->contest_id[UUID_LEN] = '\0';
+    }
+    sub->submit_slot = submit_slot;
+    strcpy(sub->dirname, uuid); /* len was checked above */
+
+    /*
+     * third '.' separated token must be a valid timestamp, unless
+     * ignore_timestamp is true
+     */
+    timestamp_str = strtok_r(NULL, ".", &saveptr);
+    if (timestamp_str == NULL) {
+	return submit_filename_fail(sub, 69, "nothing found after second '.' separated token of submit number: %s",
+				    sub->filepath);
+    }
+    ret = sscanf(timestamp_str, "%jd%c", &timestamp, &guard);
+    if (!ignore_timestamp) {
+	if (ret != 1) {
+	    return submit_filename_fail(sub, 70, "timestamp not found after \"submit_slot.\": %s is not a timestamp: %s",
+					timestamp_str, sub->filepath);
+	}
+	if (timestamp < MIN_TIMESTAMP) {
+	    return submit_filename_fail(sub, 71, "timestamp: %jd is < %jd: %s", timestamp, (intmax_t)MIN_TIMESTAMP,
+					sub->filepath);
+	}
+	dbg(DBG_LOW, "timestamp is valid: %jd", timestamp);
+    }
+    if (ret == 1) {
+	sub->timestamp = timestamp;
+    }
+
+    /*
+     * fourth '.' separated token must be the filename extension
+     */
+    extension = strtok_r(NULL, ".", &saveptr);
+    if (extension == NULL) {
+	return submit_filename_fail(sub, 72, "nothing found after third '.' separated token of timestamp: %s",
+				    sub->filepath);
+    }
+    if (strcmp(extension, ext) != 0) {
+	return submit_filename_fail(sub, 73, "extension %s != %s: %s", extension, ext, sub->filepath);
+    }
+    sub->extension = extension;
+    dbg(DBG_LOW, "filename extension is valid: %s", extension);
+
+    /*
+     * filepath must use only POSIX portable filename and + chars
+     */
+    if (!safe_str(sub->filepath, true, true)) { /* ^[/0-9A-Za-z._+-]+$ */
+	return submit_filename_fail(sub, 74, "filepath: safe_str(%s, true, true) is false", sub->filepath);
+    }
+
+    /*
+     * first '.' separated token of the filename must use only lower case POSIX portable filename and + chars
+     *
+     * NOTE: fnamchk(1) has always made this check on what strtok_r() left of
+     *	     the filename, which is the first '.' separated token, so it is made
+     *	     on that token here too: the case of the UUID is not checked.
+     */
+    if (!safe_path_str(submit, false, false)) { /* ^[0-9a-z._][0-9a-z._+-]*$ */
+	return submit_filename_fail(sub, 75, "basename: safe_path_str(%s, false, false) is false", submit);
+    }
+
+    /*
+     * All is OK with the filepath
+     */
+    dbg(DBG_LOW, "filepath passes all checks: %s", sub->filepath);
+    return true;
+}
+
+
+/*
+ * free_submit_filename - free storage of a struct submit_filename
+ *
+ * given:
+ *	sub	- what chk_submit_filename() found in a filename
+ *
+ * NOTE: it is OK to call this function with a NULL sub.
+ */
+void
+free_submit_filename(struct submit_filename *sub)
+{
+    /*
+     * firewall
+     */
+    if (sub == NULL) {
+	return;
+    }
+
+    if (sub->filepath != NULL) {
+	free(sub->filepath);
+	sub->filepath = NULL;
+    }
+    if (sub->filename != NULL) {
+	free(sub->filename);
+	sub->filename = NULL;
+    }
+    if (sub->tokens != NULL) {
+	free(sub->tokens);
+	sub->tokens = NULL;
+    }
+    sub->extension = NULL;
+    return;
+}
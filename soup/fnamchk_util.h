@@ -0,0 +1,97 @@
+/*
+ * fnamchk_util - check an IOCCC compressed tarball filename
+ *
+ * "Because most people become disappointed when someone gets their name wrong." :-)
+ *
+ * Copyright (c) 2022-2026 by Landon Curt Noll and Cody Boone Ferguson.
+ * All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_FNAMCHK_UTIL_H)
+#    define  INCLUDE_FNAMCHK_UTIL_H
+
+
+/*
+ * system includes
+ */
+#include <stdbool.h>	    /* for bool, true, false */
+#include <stdint.h>	    /* for intmax_t */
+
+/*
+ * library related includes
+ */
+#include "../dbg/dbg.h"			/* dbg - info, debug, warning, error, and usage message facility */
+
+/*
+ * limit_ioccc - IOCCC size and rule related limitations
+ */
+#include "limit_ioccc.h"
+
+
+/*
+ * fnamchk_util limits
+ */
+#define FNAMCHK_MSG_MAX (1024)		/* longest message of why a filename is not valid */
+#define FNAMCHK_DIRNAME_LEN (UUID_LEN+1+MAX_SUBMIT_SLOT_CHARS)	/* length of a UUID-slot directory name */
+
+
+/*
+ * struct submit_filename - what chk_submit_filename() found in a filename
+ *
+ * Use chk_submit_filename() to fill in and free_submit_filename() to free.
+ *
+ * When the filename is not valid, code is the exit code that fnamchk(1) uses
+ * for the failed check and msg says why. Fields of checks that were not
+ * reached are left empty.
+ */
+struct submit_filename
+{
+    char *filepath;				/* canonicalized filepath (allocated) */
+    char *filename;				/* basename of filepath (allocated) */
+    char contest_id[UUID_LEN+1];		/* "test" or the UUID */
+    bool test_mode;				/* true ==> contest_id is "test" */
+    int submit_slot;				/* submit slot number */
+    char dirname[FNAMCHK_DIRNAME_LEN+1];	/* submit directory: test-slot or UUID-slot */
+    intmax_t timestamp;				/* timestamp or 0 if it was not parsed */
+    char *tokens;				/* filename split into '.' separated tokens (allocated) */
+    char *extension;				/* filename extension (points into tokens) */
+    int code;					/* 0 ==> filename is valid, else fnamchk exit code */
+    char msg[FNAMCHK_MSG_MAX+1];		/* why the filename is not valid, else empty */
+};
+
+
+/*
+ * external function declarations
+ */
+extern bool chk_submit_filename(char const *path, char const *ext, bool test_mode, bool ignore_timestamp,
+				struct submit_filename *sub);
+extern void free_submit_filename(struct submit_filename *sub);
+
+
+#endif /* INCLUDE_FNAMCHK_UTIL_H */
@@ -42,13 +42,17 @@
 #include "iocccsize.h"
 #endif /* MKIOCCCENTRY_USE */
 
-#define STRLEN(s)		(sizeof (s)-1)
-
 #define NO_STRING		0
 #define NO_COMMENT		0
 #define COMMENT_EOL		1
 #define COMMENT_BLOCK		2
 
+#define NO_TRIGRAPH		0
+#define TRIGRAPH_THIRD		1	/* have "??", waiting for the third character */
+#define TRIGRAPH_NEXT		2	/* have a trigraph, waiting for the character after it */
+
+#define RULE_COUNT_READ_SIZE	(64*1024)	/* size of the rule_count() read buffer */
+
 /*
  * globals
  */
@@ -84,6 +88,13 @@ char const * const iocccsize_version = IOCCCSIZE_VERSION;
 /*
  * C reserved words, plus a few #preprocessor tokens, that count as 1
  *
+ * The words are grouped by length: cwords[length] is the NULL terminated
+ * list of words of that length, so that find_keyword() compares a word
+ * only with those of the same length, and of those, only with the ones
+ * that start with the same character.
+ *
+ * Yes Virginia, we left #define off the list on purpose!  K&R
+ *
  * NOTE: For a good list of reserved words in C, see:
  *
  *	http://www.bezem.de/pdf/ReservedWordsInC.pdf
@@ -92,127 +103,177 @@ char const * const iocccsize_version = IOCCCSIZE_VERSION;
  *
  *	See http://www.bezem.de/en/
  */
-typedef struct {
-	size_t length;
-	const char *word;
-} Word;
-
-static Word cwords[] = {
-	/* Yes Virginia, we left #define off the list on purpose!  K&R */
-	{ STRLEN("#elif"), "#elif" } ,				/* K&R */
-	{ STRLEN("#elifdef"), "#elifdef" } ,			/* +C23 */
-	{ STRLEN("#elifndef"), "#elifndef" } ,			/* +C23 */
-	{ STRLEN("#else"), "#else" } ,				/* K&R */
-	{ STRLEN("#embed"), "#embed" } ,			/* +C23 */
-	{ STRLEN("#endif"), "#endif" } ,			/* K&R */
-	{ STRLEN("#error"), "#error" } ,			/* +C89 */
-	{ STRLEN("#ident"), "#ident" } ,			/* gcc */
-	{ STRLEN("#if"), "#if" } ,				/* K&R */
-	{ STRLEN("#ifdef"), "#ifdef" } ,			/* K&R */
-	{ STRLEN("#ifndef"), "#ifndef" } ,			/* K&R */
-	{ STRLEN("#include"), "#include" } ,			/* K&R */
-	{ STRLEN("#line"), "#line" } ,				/* K*R */
-	{ STRLEN("#pragma"), "#pragma" } ,			/* +C89 */
-	{ STRLEN("#sccs"), "#sccs" } ,				/* gcc */
-	{ STRLEN("#warning"), "#warning" } ,			/* +C23 */
-	{ STRLEN("#undef"), "#undef" } ,			/* K&R */
-
-	{ STRLEN("_Alignas"), "_Alignas" } ,			/* +C11 */
-	{ STRLEN("_Alignof"), "_Alignof" } ,			/* +C11 */
-	{ STRLEN("_Atomic"), "_Atomic" } ,			/* +C11 */
-	{ STRLEN("_BitInt"), "_BitInt" } ,			/* +C23 */
-	{ STRLEN("_Bool"), "_Bool" } ,				/* +C99 */
-	{ STRLEN("_Complex"), "_Complex" } ,			/* +C99 */
-	{ STRLEN("_Decimal128"), "_Decimal128" } ,		/* +C23 */
-	{ STRLEN("_Decimal64"), "_Decimal64" } ,		/* +C23 */
-	{ STRLEN("_Decimal32"), "_Decimal32" } ,		/* +C23 */
-	{ STRLEN("_Generic"), "_Generic" } ,			/* +C11 */
-	{ STRLEN("_Imaginary"), "_Imaginary" } ,		/* +C99 */
-	{ STRLEN("_Noreturn"), "_Noreturn" } ,			/* +C11 */
-	{ STRLEN("_Pragma"), "_Pragma" } ,			/* +C99 */
-	{ STRLEN("_Static_assert"), "_Static_assert" } ,	/* +C11 */
-	{ STRLEN("_Thread_local"), "_Thread_local" } ,		/* +C11 */
-
-	{ STRLEN("alignas"), "alignas" } ,			/* +C23 */
-	{ STRLEN("alignof"), "alignof" } ,			/* +C23 */
-	{ STRLEN("and"), "and" } ,				/* +C89 iso646.h */
-	{ STRLEN("and_eq"), "and_eq" } ,			/* +C89 iso646.h */
-	{ STRLEN("auto"), "auto" } ,				/* K&R */
-	{ STRLEN("bitand"), "bitand" } ,			/* +C89 iso646.h */
-	{ STRLEN("bitor"), "bitor" } ,				/* +C89 iso646.h */
-	{ STRLEN("bool"), "bool" } ,				/* +C23 */
-	{ STRLEN("break"), "break" } ,				/* K&R */
-	{ STRLEN("case"), "case" } ,				/* K&R */
-	{ STRLEN("char"), "char" } ,				/* K&R */
-	{ STRLEN("compl"), "compl" } ,				/* +C89 iso646.h */
-	{ STRLEN("const"), "const" } ,				/* +C89 */
-	{ STRLEN("constexpr"), "constexpr" } ,			/* +C23 */
-	{ STRLEN("continue"), "continue" } ,			/* K&R */
-	{ STRLEN("default"), "default" } ,			/* K&R */
-	{ STRLEN("do"), "do" } ,				/* K&R */
-	{ STRLEN("double"), "double" } ,			/* K&R */
-	{ STRLEN("else"), "else" } ,				/* K&R */
-	{ STRLEN("enum"), "enum" } ,				/* +C89 */
-	{ STRLEN("extern"), "extern" } ,			/* K&R */
-	{ STRLEN("false"), "false" } ,				/* +C23 */
-	{ STRLEN("float"), "float" } ,				/* K&R */
-	{ STRLEN("for"), "for" } ,				/* K&R */
-	{ STRLEN("goto"), "goto" } ,				/* K&R */
-	{ STRLEN("if"), "if" } ,				/* K&R */
-	{ STRLEN("inline"), "inline" } ,			/* +C99 */
-	{ STRLEN("int"), "int" } ,				/* K&R */
-	{ STRLEN("long"), "long" } ,				/* K&R */
-	{ STRLEN("noreturn"), "noreturn" } ,			/* +C23 */
-	{ STRLEN("not"), "not" } ,				/* +C89 iso646.h */
-	{ STRLEN("not_eq"), "not_eq" } ,			/* +C89 iso646.h */
-	{ STRLEN("nullptr"), "nullptr" } ,			/* +C23 */
-	{ STRLEN("or"), "or" } ,				/* +C89 iso646.h */
-	{ STRLEN("or_eq"), "or_eq" } ,				/* +C89 iso646.h */
-	{ STRLEN("register"), "register" } ,			/* K&R */
-	{ STRLEN("restrict"), "restrict" } ,			/* +C99 */
-	{ STRLEN("return"), "return" } ,			/* K&R */
-	{ STRLEN("short"), "short" } ,				/* K&R */
-	{ STRLEN("signed"), "signed" } ,			/* K&R */
-	{ STRLEN("sizeof"), "sizeof" } ,			/* K&R */
-	{ STRLEN("static"), "static" } ,			/* K&R */
-	{ STRLEN("static_assert"), "static_assert" } ,		/* +C23 */
-	{ STRLEN("struct"), "struct" } ,			/* K&R */
-	{ STRLEN("switch"), "switch" } ,			/* K&R */
-	{ STRLEN("thread_local"), "thread_local" } ,		/* +C23 */
-	{ STRLEN("true"), "true" } ,				/* +C23 */
-	{ STRLEN("typedef"), "typedef" } ,			/* K&R */
-	{ STRLEN("typeof"), "typeof" } ,			/* +C23 */
-	{ STRLEN("typeof_unequal"), "typeof_unequal" } ,	/* +C23 */
-	{ STRLEN("union"), "union" } ,				/* K&R */
-	{ STRLEN("unsigned"), "unsigned" } ,			/* K&R */
-	{ STRLEN("void"), "void" } ,				/* +C89 */
-	{ STRLEN("volatile"), "volatile" } ,			/* +C89 */
-	{ STRLEN("while"), "while" } ,				/* K&R */
-	{ STRLEN("xor"), "xor" } ,				/* +C89 iso646.h */
-	{ STRLEN("xor_eq"), "xor_eq" } ,			/* +C89 iso646.h */
-
-	{ 0, NULL }
+static const char * const cwords2[] = {
+	"do",			/* K&R */
+	"if",			/* K&R */
+	"or",			/* +C89 iso646.h */
+	NULL
+};
+
+static const char * const cwords3[] = {
+	"#if",			/* K&R */
+	"and",			/* +C89 iso646.h */
+	"for",			/* K&R */
+	"int",			/* K&R */
+	"not",			/* +C89 iso646.h */
+	"xor",			/* +C89 iso646.h */
+	NULL
+};
+
+static const char * const cwords4[] = {
+	"auto",			/* K&R */
+	"bool",			/* +C23 */
+	"case",			/* K&R */
+	"char",			/* K&R */
+	"else",			/* K&R */
+	"enum",			/* +C89 */
+	"goto",			/* K&R */
+	"long",			/* K&R */
+	"true",			/* +C23 */
+	"void",			/* +C89 */
+	NULL
+};
+
+static const char * const cwords5[] = {
+	"#elif",		/* K&R */
+	"#else",		/* K&R */
+	"#line",		/* K*R */
+	"#sccs",		/* gcc */
+	"_Bool",		/* +C99 */
+	"bitor",		/* +C89 iso646.h */
+	"break",		/* K&R */
+	"compl",		/* +C89 iso646.h */
+	"const",		/* +C89 */
+	"false",		/* +C23 */
+	"float",		/* K&R */
+	"or_eq",		/* +C89 iso646.h */
+	"short",		/* K&R */
+	"union",		/* K&R */
+	"while",		/* K&R */
+	NULL
+};
+
+static const char * const cwords6[] = {
+	"#embed",		/* +C23 */
+	"#endif",		/* K&R */
+	"#error",		/* +C89 */
+	"#ident",		/* gcc */
+	"#ifdef",		/* K&R */
+	"#undef",		/* K&R */
+	"and_eq",		/* +C89 iso646.h */
+	"bitand",		/* +C89 iso646.h */
+	"double",		/* K&R */
+	"extern",		/* K&R */
+	"inline",		/* +C99 */
+	"not_eq",		/* +C89 iso646.h */
+	"return",		/* K&R */
+	"signed",		/* K&R */
+	"sizeof",		/* K&R */
+	"static",		/* K&R */
+	"struct",		/* K&R */
+	"switch",		/* K&R */
+	"typeof",		/* +C23 */
+	"xor_eq",		/* +C89 iso646.h */
+	NULL
+};
+
+static const char * const cwords7[] = {
+	"#ifndef",		/* K&R */
+	"#pragma",		/* +C89 */
+	"_Atomic",		/* +C11 */
+	"_BitInt",		/* +C23 */
+	"_Pragma",		/* +C99 */
+	"alignas",		/* +C23 */
+	"alignof",		/* +C23 */
+	"default",		/* K&R */
+	"nullptr",		/* +C23 */
+	"typedef",		/* K&R */
+	NULL
+};
+
+static const char * const cwords8[] = {
+	"#elifdef",		/* +C23 */
+	"#include",		/* K&R */
+	"#warning",		/* +C23 */
+	"_Alignas",		/* +C11 */
+	"_Alignof",		/* +C11 */
+	"_Complex",		/* +C99 */
+	"_Generic",		/* +C11 */
+	"continue",		/* K&R */
+	"noreturn",		/* +C23 */
+	"register",		/* K&R */
+	"restrict",		/* +C99 */
+	"unsigned",		/* K&R */
+	"volatile",		/* +C89 */
+	NULL
+};
+
+static const char * const cwords9[] = {
+	"#elifndef",		/* +C23 */
+	"_Noreturn",		/* +C11 */
+	"constexpr",		/* +C23 */
+	NULL
+};
+
+static const char * const cwords10[] = {
+	"_Decimal64",		/* +C23 */
+	"_Decimal32",		/* +C23 */
+	"_Imaginary",		/* +C99 */
+	NULL
+};
+
+static const char * const cwords11[] = {
+	"_Decimal128",		/* +C23 */
+	NULL
+};
+
+static const char * const cwords12[] = {
+	"thread_local",		/* +C23 */
+	NULL
+};
+
+static const char * const cwords13[] = {
+	"_Thread_local",	/* +C11 */
+	"static_assert",	/* +C23 */
+	NULL
+};
+
+static const char * const cwords14[] = {
+	"_Static_assert",	/* +C11 */
+	"typeof_unequal",	/* +C23 */
+	NULL
+};
+
+static const char * const * const cwords[] = {
+	NULL, NULL, cwords2, cwords3, cwords4, cwords5, cwords6, cwords7, cwords8,
+	cwords9, cwords10, cwords11, cwords12, cwords13, cwords14
 };
 
+#define CWORDS_MAX_LENGTH	(sizeof (cwords) / sizeof (cwords[0]) - 1)
+
 
 /*
- * find_member - find an entry in a word table
+ * find_keyword - find a word in the C reserved word table
  *
  * given:
- *	table		table of words to scan
- *	string		word to find in the table
+ *	word		word to find in the table, need not be NUL terminated
+ *	length		length of word
  *
  * returns:
- *	NULL ==> string is not in the table,
- *	!= NULL ==> table entry that matches string
+ *	NULL ==> word is not in the table,
+ *	!= NULL ==> table entry that matches word
  */
-static Word *
-find_member(Word *table, const char *string)
+static const char *
+find_keyword(const char *word, size_t length)
 {
-	Word *w;
-	for (w = table; w->length != 0; w++) {
-		if (strcmp(string, w->word) == 0) {
-			return w;
+	const char * const *w;
+
+	if (word == NULL || length > CWORDS_MAX_LENGTH || cwords[length] == NULL) {
+		return NULL;
+	}
+	for (w = cwords[length]; *w != NULL; w++) {
+		if ((*w)[0] == word[0] && memcmp(*w, word, length) == 0) {
+			return *w;
 		}
 	}
 	return NULL;
@@ -220,225 +281,388 @@ find_member(Word *table, const char *string)
 
 
 /*
- * rule_count - count data on file stream, according to Rule 2a and Rule 2b
+ * count_step - count one character, given the character after it
  *
- * In addition to the Rule 2a and Rule 2b counting, count keywords.
- * We also warn about various situations such found high-bit or non-ASCII character,
- * found NUL byte, found an unknown Tri-Graph, word buffer overflow,
- * or ungetc called too many times.
+ * This is the heart of the Rule 2a and Rule 2b counting: everything but
+ * CR, NUL and trigraph handling, which rule_count_buf() does as it
+ * finds the character after ch.
  *
  * given:
- *	fp_in		open file stream to count data on
+ *	state		counting state
+ *	ch		character to count
+ *	next_ch		next character that is not a CR, or EOF
  *
  * returns:
- *	RuleCount information
+ *	true ==> next_ch was counted as part of ch,
+ *	false ==> next_ch is yet to be counted
  */
-RuleCount
-rule_count(FILE *fp_in)
+static inline bool
+count_step(struct rule_count_state *state, int ch, int next_ch)
 {
-	size_t wordi = 0;
-	char word[WORD_BUFFER_SIZE];
-	RuleCount counts = { 0, 0, 0, false, false, false, false };
-	int ch, next_ch, quote = NO_STRING, escape = 0, is_comment = NO_COMMENT;
+	RuleCount *counts = &state->counts;
+	bool consumed = false;
 
 /* If quote == NO_STRING (0) and is_comment == NO_COMMENT (0) then its code. */
-#define IS_CODE	(quote == is_comment)
+#define IS_CODE	(state->quote == state->is_comment)
 
-	/* Paranoia and to keep valgrind happy. */
-	(void) memset(word, 0, sizeof (word));
+	if (ch == '\\' && next_ch == '\n') {
+		/*
+		 * ISO C11 section 5.1.1.2 Translation Phases
+		 * point 2 discards backslash newlines.
+		 */
+		counts->rule_2a_size += 2;
+		return true;
+	}
 
-	while ((ch = fgetc(fp_in)) != EOF) {
-		if (ch == '\r') {
-			/* Discard bare CR and those part of CRLF. */
-			counts.rule_2a_size++;
-			continue;
+	/* Within quoted string? */
+	if (state->quote != NO_STRING) {
+		/* Escape _this_ character. */
+		if (state->escape) {
+			state->escape = 0;
 		}
-		if (ch == '\0') {
-			counts.nul_warning = true;
-			counts.rule_2a_size++;
-			continue;
+
+		/* Escape next character. */
+		else if (ch == '\\') {
+			state->escape = 1;
 		}
 
-		/* Future gazing. */
-		while ((next_ch = fgetc(fp_in)) != EOF && next_ch == '\r') {
-			/* Discard bare CR and those part of CRLF. */
-			counts.rule_2a_size++;
+		/* Close matching quote? */
+		else if (ch == state->quote) {
+			state->quote = NO_STRING;
 		}
-#ifdef TRIGRAPHS
-		if (ch == '?' && next_ch == '?') {
-			/* ISO C11 section 5.2.1.1 Trigraph Sequences */
-			const char *t;
-			static const char trigraphs[] = "=#([)]'^<{!|>}-~/\\";
+	}
 
-			ch = fgetc(fp_in);
-			for (t = trigraphs; *t != '\0'; t += 2) {
-				if (ch == t[0]) {
-					/* Mapped trigraphs count as 1 byte. */
-					next_ch = fgetc(fp_in);
-					counts.rule_2a_size += 2;
-					ch = t[1];
-					break;
-				}
-			}
+	/* Within comment to end of line? */
+	else if (state->is_comment == COMMENT_EOL && ch == '\n') {
+		iocccsize_dbg(1, "~~NO_COMMENT");
+		state->is_comment = NO_COMMENT;
+	}
 
-			/* Unknown trigraph, push back the third character. */
-			if (*t == '\0') {
-				if (ch != EOF && ungetc(ch, fp_in) == EOF) {
-					counts.ungetc_warning = true;
-					counts.trigraph_warning = true;
-					counts.rule_2a_size++;
-					continue;
-				}
-				ch = '?';
+	/* Within comment block? */
+	else if (state->is_comment == COMMENT_BLOCK && ch == '*' && next_ch == '/') {
+		iocccsize_dbg(1, "~~NO_COMMENT");
+		state->is_comment = NO_COMMENT;
+	}
+
+	/* Start of comment to end of line? */
+	else if (state->is_comment == NO_COMMENT && ch == '/' && next_ch == '/') {
+		iocccsize_dbg(1, "~~COMMENT_EOL");
+		state->is_comment = COMMENT_EOL;
+
+		/* Consume next_ch. */
+		ch = next_ch;
+		consumed = true;
+		counts->rule_2a_size++;
+		counts->rule_2b_size++;
+	}
+
+	/* Start of comment block? */
+	else if (state->is_comment == NO_COMMENT && ch == '/' && next_ch == '*') {
+		iocccsize_dbg(1, "~~COMMENT_BLOCK");
+		state->is_comment = COMMENT_BLOCK;
+
+		/* Consume next_ch. */
+		ch = next_ch;
+		consumed = true;
+		counts->rule_2a_size++;
+		counts->rule_2b_size++;
+	}
+
+	/* Open single or double quote? */
+	else if (state->is_comment == NO_COMMENT && (ch == '\'' || ch == '"')) {
+		state->quote = ch;
+	}
+
+#ifdef DIGRAPHS
+	/*
+	 * ISO C11 section 6.4.6 Punctuators, digraphs handled during
+	 * tokenization, but map here and count as 1 byte, like their
+	 * ASCII counter parts.
+	 */
+	if (IS_CODE) {
+		const char *d;
+		static const char digraphs[] = "[<:]:>{<%}%>#%:";
+		for (d = digraphs; *d != '\0'; d += 3) {
+			if (ch == d[1] && next_ch == d[2]) {
+				/* Consume next_ch. */
+				consumed = true;
+				counts->rule_2a_size++;
+				ch = d[0];
+				break;
 			}
 		}
+	}
 #endif
-		if (ch == '\\' && next_ch == '\n') {
-			/*
-			 * ISO C11 section 5.1.1.2 Translation Phases
-			 * point 2 discards backslash newlines.
-			 */
-			counts.rule_2a_size += 2;
-			continue;
-		}
-
-		if (next_ch != EOF && ungetc(next_ch, fp_in) == EOF) {
-			/*
-			 * ISO C ungetc() guarantees one character (byte) pushback.
-			 * How does that relate to UTF8 and wide-character library
-			 * handling?  An invalid trigraph results in 2x ungetc().
-			 */
-			counts.ungetc_warning = true;
-			counts.rule_2a_size++;
-			continue;
+	/* Sanity check against file size and wc(1) byte count. */
+	counts->rule_2a_size++;
+
+	/*
+	 * End of possible keyword?  Care with #word as there can
+	 * be whitespace or comments between # and word.
+	 */
+	if ((state->word[0] != '#' || 1 < state->wordi) && !isalnum(ch) && ch != '_' && ch != '#') {
+		if (0 < state->wordi && find_keyword(state->word, state->wordi) != NULL) {
+			/* Count keyword as 1. */
+			counts->rule_2b_size = counts->rule_2b_size - state->wordi + 1;
+			counts->keywords++;
+			iocccsize_dbg(1, "~~keyword %zu \"%s\"", counts->keywords, state->word);
 		}
+		state->word[state->wordi = 0] = '\0';
+	}
 
-		/* Within quoted string? */
-		if (quote != NO_STRING) {
-			/* Escape _this_ character. */
-			if (escape) {
-				escape = 0;
-			}
+	/* Ignore all whitespace. */
+	if (isspace(ch)) {
+		iocccsize_dbg(2, "~~ignore whitespace %#02x", ch);
+		return consumed;
+	}
 
-			/* Escape next character. */
-			else if (ch == '\\') {
-				escape = 1;
-			}
+	/* Ignore begin/end block and end of statement. */
+	if ((ch == '{' || ch == ';' || ch == '}') && (isspace(next_ch) || next_ch == EOF)) {
+		iocccsize_dbg(2, "~~ignore %c", ch);
+		return consumed;
+	}
 
-			/* Close matching quote? */
-			else if (ch == quote) {
-				quote = NO_STRING;
-			}
+	/* Collect next word not in a string or comment. */
+	if (IS_CODE && (isalnum(ch) || ch == '_' || ch == '#')) {
+		state->word[state->wordi++] = (char) ch;
+		if (sizeof (state->word) <= state->wordi) {
+			/* ISO C11 section 5.2.4.1 Translation limits, identifiers
+			 * can have 63 significant initial characters, which can be
+			 * multibyte.  The C keywords are all ASCII, longest is 14
+			 * bytes.
+			 *
+			 * We only care about the C keywords and not the identifiers,
+			 * so the buffer can overflow regularly as long words or
+			 * identifiers are ignored.
+			 */
+			state->wordi = 0;
 		}
+		state->word[state->wordi] = '\0';
+	}
 
-		/* Within comment to end of line? */
-		else if (is_comment == COMMENT_EOL && ch == '\n') {
-			iocccsize_dbg(1, "~~NO_COMMENT");
-			is_comment = NO_COMMENT;
-		}
+	counts->rule_2b_size++;
+	return consumed;
+#undef IS_CODE
+}
 
-		/* Within comment block? */
-		else if (is_comment == COMMENT_BLOCK && ch == '*' && next_ch == '/') {
-			iocccsize_dbg(1, "~~NO_COMMENT");
-			is_comment = NO_COMMENT;
-		}
 
-		/* Start of comment to end of line? */
-		else if (is_comment == NO_COMMENT && ch == '/' && next_ch == '/') {
-			iocccsize_dbg(1, "~~COMMENT_EOL");
-			is_comment = COMMENT_EOL;
+/*
+ * rule_count_init - initialize the state of an incremental count
+ *
+ * given:
+ *	state		counting state to initialize
+ */
+void
+rule_count_init(struct rule_count_state *state)
+{
+	if (state == NULL) {
+		return;
+	}
 
-			/* Consume next_ch. */
-			ch = fgetc(fp_in);
-			counts.rule_2a_size++;
-			counts.rule_2b_size++;
-		}
+	/* Paranoia and to keep valgrind happy. */
+	(void) memset(state, 0, sizeof (*state));
+	state->pending = EOF;
+	state->quote = NO_STRING;
+	state->is_comment = NO_COMMENT;
+	state->trigraph = NO_TRIGRAPH;
+}
 
-		/* Start of comment block? */
-		else if (is_comment == NO_COMMENT && ch == '/' && next_ch == '*') {
-			iocccsize_dbg(1, "~~COMMENT_BLOCK");
-			is_comment = COMMENT_BLOCK;
 
-			/* Consume next_ch. */
-			ch = fgetc(fp_in);
-			counts.rule_2a_size++;
-			counts.rule_2b_size++;
-		}
+/*
+ * rule_count_buf - count the next chunk of data, according to Rule 2a and Rule 2b
+ *
+ * In addition to the Rule 2a and Rule 2b counting, count keywords.
+ * We also warn about various situations such found high-bit or non-ASCII character,
+ * found NUL byte, found an unknown Tri-Graph or word buffer overflow.
+ *
+ * The data may be given in chunks of any size, by one call per chunk, in
+ * order: the counts are the same however the data is split.  A character
+ * is only counted once the next character that is not a CR is known, so
+ * the last character of a chunk is held in state->pending until the next
+ * chunk, or until the end.  As the state holds no pointers, a copy of it
+ * is a checkpoint: counting can be resumed from the copy with the data
+ * that followed the chunks counted so far, e.g. after that data changes.
+ *
+ * given:
+ *	buf		next chunk of data to count
+ *	len		length of buf in bytes
+ *	state		counting state, from rule_count_init() and the
+ *			rule_count_buf() calls of the chunks before buf
+ *
+ * returns:
+ *	RuleCount information of all the data counted so far, as if
+ *	the data ended at the end of buf
+ *
+ * NOTE: unlike the ungetc(3) of the stream based code this replaced, there
+ *	 is nothing to push back, and so ungetc_warning is never set.
+ */
+RuleCount
+rule_count_buf(const char *buf, size_t len, struct rule_count_state *state)
+{
+	const unsigned char *p = (const unsigned char *) buf;
+	struct rule_count_state end;	/* state as if the data ended here */
+	size_t i;
+	int ch, next_ch;
+
+	if (state == NULL) {
+		rule_count_init(&end);
+		return end.counts;
+	}
+	if (p == NULL) {
+		len = 0;
+	}
 
-		/* Open single or double quote? */
-		else if (is_comment == NO_COMMENT && (ch == '\'' || ch == '"')) {
-			quote = ch;
-		}
+	ch = state->pending;
+	for (i = 0; i < len; i++) {
+		next_ch = p[i];
+#ifdef TRIGRAPHS
+		if (state->trigraph == TRIGRAPH_THIRD) {
+			/* ISO C11 section 5.2.1.1 Trigraph Sequences */
+			const char *t;
+			static const char trigraphs[] = "=#([)]'^<{!|>}-~/\\";
 
-#ifdef DIGRAPHS
-		/*
-		 * ISO C11 section 6.4.6 Punctuators, digraphs handled during
-		 * tokenization, but map here and count as 1 byte, like their
-		 * ASCII counter parts.
-		 */
-		if (IS_CODE) {
-			const char *d;
-			static const char digraphs[] = "[<:]:>{<%}%>#%:";
-			for (d = digraphs; *d != '\0'; d += 3) {
-				if (ch == d[1] && next_ch == d[2]) {
-					(void) fgetc(fp_in);
-					counts.rule_2a_size++;
-					ch = d[0];
+			state->trigraph = NO_TRIGRAPH;
+			for (t = trigraphs; *t != '\0'; t += 2) {
+				if (next_ch == (unsigned char) t[0]) {
+					/* Mapped trigraphs count as 1 byte. */
+					state->counts.rule_2a_size += 2;
+					ch = t[1];
+					state->trigraph = TRIGRAPH_NEXT;
 					break;
 				}
 			}
+			if (state->trigraph == TRIGRAPH_NEXT) {
+				continue;
+			}
+
+			/*
+			 * Unknown trigraph: the first '?' is just a '?', and
+			 * next_ch follows the second '?'.
+			 */
+			ch = count_step(state, '?', '?') ? EOF : '?';
+		} else if (state->trigraph == TRIGRAPH_NEXT) {
+			/* The character after a trigraph is taken as is, even a CR. */
+			state->trigraph = NO_TRIGRAPH;
+			if (count_step(state, ch, next_ch)) {
+				ch = EOF;
+				continue;
+			}
+			ch = EOF;
 		}
 #endif
-		/* Sanity check against file size and wc(1) byte count. */
-		counts.rule_2a_size++;
-
-		/*
-		 * End of possible keyword?  Care with #word as there can
-		 * be whitespace or comments between # and word.
-		 */
-		if ((word[0] != '#' || 1 < wordi) && !isalnum(ch) && ch != '_' && ch != '#') {
-			if (find_member(cwords, word) != NULL) {
-				/* Count keyword as 1. */
-				counts.rule_2b_size = counts.rule_2b_size - wordi + 1;
-				counts.keywords++;
-				iocccsize_dbg(1, "~~keyword %zu \"%s\"", counts.keywords, word);
+		if (next_ch == '\r') {
+			/* Discard bare CR and those part of CRLF. */
+			state->counts.rule_2a_size++;
+			continue;
+		}
+		if (ch == EOF) {
+			if (next_ch == '\0') {
+				state->counts.nul_warning = true;
+				state->counts.rule_2a_size++;
+				continue;
 			}
-			word[wordi = 0] = '\0';
+			ch = next_ch;
+			continue;
 		}
-
-		/* Ignore all whitespace. */
-		if (isspace(ch)) {
-			iocccsize_dbg(2, "~~ignore whitespace %#02x", ch);
+#ifdef TRIGRAPHS
+		if (ch == '?' && next_ch == '?') {
+			/* Wait for the third character of a possible trigraph. */
+			state->trigraph = TRIGRAPH_THIRD;
 			continue;
 		}
-
-		/* Ignore begin/end block and end of statement. */
-		if (strchr("{;}", ch) != NULL && (isspace(next_ch) || next_ch == EOF)) {
-			iocccsize_dbg(2, "~~ignore %c", ch);
+#endif
+		if (count_step(state, ch, next_ch)) {
+			ch = EOF;
 			continue;
 		}
-
-		/* Collect next word not in a string or comment. */
-		if (IS_CODE && (isalnum(ch) || ch == '_' || ch == '#')) {
-			word[wordi++] = (char) ch;
-			if (sizeof (word) <= wordi) {
-				/* ISO C11 section 5.2.4.1 Translation limits, identifiers
-				 * can have 63 significant initial characters, which can be
-				 * multibyte.  The C keywords are all ASCII, longest is 14
-				 * bytes.
-				 *
-				 * We only care about the C keywords and not the identifiers,
-				 * so the buffer can overflow regularly as long words or
-				 * identifiers are ignored.
-				 */
-				wordi = 0;
-			}
-			word[wordi] = '\0';
+		if (next_ch == '\0') {
+			state->counts.nul_warning = true;
+			state->counts.rule_2a_size++;
+			ch = EOF;
+			continue;
 		}
+		ch = next_ch;
+	}
+	state->pending = ch;
+
+	/*
+	 * count what is pending as if there were no more data
+	 */
+	end = *state;
+#ifdef TRIGRAPHS
+	if (end.trigraph == TRIGRAPH_THIRD && count_step(&end, '?', '?')) {
+		end.pending = EOF;
+	}
+#endif
+	if (end.pending != EOF) {
+		(void) count_step(&end, end.pending, EOF);
+	}
+	state->offset += len;
+
+	return end.counts;
+}
+
+
+/*
+ * rule_count_mem - count data in a memory buffer, according to Rule 2a and Rule 2b
+ *
+ * given:
+ *	buf		data to count
+ *	len		length of buf in bytes
+ *
+ * returns:
+ *	RuleCount information
+ */
+RuleCount
+rule_count_mem(const char *buf, size_t len)
+{
+	struct rule_count_state state;
+
+	rule_count_init(&state);
+	return rule_count_buf(buf, len, &state);
+}
+
+
+/*
+ * rule_count - count data on file stream, according to Rule 2a and Rule 2b
+ *
+ * The rest of the stream is read in large chunks that are counted by
+ * rule_count_buf().
+ *
+ * given:
+ *	fp_in		open file stream to count data on
+ *
+ * returns:
+ *	RuleCount information
+ *
+ * NOTE: a read error is treated as the end of the stream.
+ */
+RuleCount
+rule_count(FILE *fp_in)
+{
+	struct rule_count_state state;
+	RuleCount counts;
+	char *buf;
+	size_t nread;
+
+	rule_count_init(&state);
+	counts = state.counts;
+	if (fp_in == NULL) {
+		return counts;
+	}
 
-		counts.rule_2b_size++;
+	buf = malloc(RULE_COUNT_READ_SIZE);
+	if (buf == NULL) {
+		iocccsize_errx(10, "malloc(%d) failed", RULE_COUNT_READ_SIZE);
+		not_reached();
 	}
 
+	counts = rule_count_buf(NULL, 0, &state);
+	while ((nread = fread(buf, 1, RULE_COUNT_READ_SIZE, fp_in)) > 0) {
+		counts = rule_count_buf(buf, nread, &state);
+	}
+	free(buf);
+
 	return counts;
 }
 
@@ -456,8 +680,6 @@ rule_count(FILE *fp_in)
 bool
 is_reserved(const char *string)
 {
-    static Word *found = NULL;
-
     /*
      * firewall
      */
@@ -469,8 +691,7 @@ is_reserved(const char *string)
     /*
      * search the reserved word table
      */
-    found = find_member(cwords, string);
-    if (found == NULL) {
+    if (find_keyword(string, strlen(string)) == NULL) {
 	/* case: string is not a reserved word */
 	return false;
     }
@@ -0,0 +1,824 @@
+/*
+ * tar_util - read and write tar archives without the tar(1) tool
+ *
+ * "Not all those who wander are lost."
+ *
+ *	-- J.R.R. Tolkien
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+/*
+ * system includes
+ */
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*
+ * tar_util - read and write tar archives without the tar(1) tool
+ */
+#include "tar_util.h"
+
+
+/*
+ * tar header field offsets and lengths
+ */
+#define TAR_OFF_NAME (0)
+#define TAR_OFF_MODE (100)
+#define TAR_OFF_UID (108)
+#define TAR_OFF_GID (116)
+#define TAR_OFF_SIZE (124)
+#define TAR_OFF_MTIME (136)
+#define TAR_OFF_CHKSUM (148)
+#define TAR_OFF_TYPEFLAG (156)
+#define TAR_OFF_LINKNAME (157)
+#define TAR_OFF_MAGIC (257)
+#define TAR_OFF_UNAME (265)
+#define TAR_OFF_GNAME (297)
+#define TAR_OFF_DEVMAJOR (329)
+#define TAR_OFF_DEVMINOR (337)
+#define TAR_OFF_PREFIX (345)
+#define TAR_LEN_ID (8)		/* length of the mode, uid, gid and chksum fields */
+#define TAR_LEN_NUM (12)	/* length of the size and mtime fields */
+
+
+/*
+ * static declarations
+ */
+static bool read_block(struct xz_reader *xz, unsigned char *block, char const **errmsg);
+static bool tar_number(unsigned char const *field, size_t len, uintmax_t *val);
+static void tar_string(char *dest, unsigned char const *field, size_t len);
+static bool tar_octal(unsigned char *field, size_t len, uintmax_t val);
+static bool write_entry(struct xz_writer *xz, char const *path, struct item const *i_p,
+			FILE *listing, struct tar_totals *totals);
+static void tar_write_abort(struct xz_writer *xz, char const *tarball_path);
+
+
+/*
+ * read_block - read a full tar block
+ *
+ * given:
+ *	xz	xz reader of the tarball
+ *	block	where to read TAR_BLOCK_SIZE bytes into
+ *	errmsg	where to store what is wrong on error
+ *
+ * returns:
+ *	true ==> block read, false ==> EOF or error
+ *
+ * NOTE: *errmsg is set to NULL on a clean EOF before the block.
+ */
+static bool
+read_block(struct xz_reader *xz, unsigned char *block, char const **errmsg)
+{
+    ssize_t len;		/* bytes read */
+
+    len = xz_read(xz, block, TAR_BLOCK_SIZE);
+    if (len < 0) {
+	*errmsg = xz_error(xz);
+	return false;
+    } else if (len == 0) {
+	*errmsg = NULL;
+	return false;
+    } else if (len != TAR_BLOCK_SIZE) {
+	*errmsg = "unexpected end of tarball";
+	return false;
+    }
+    return true;
+}
+
+
+/*
+ * tar_number - convert a tar numeric field
+ *
+ * given:
+ *	field	numeric field of a tar header
+ *	len	length of field
+ *	val	where to store the value
+ *
+ * returns:
+ *	true ==> valid field, false ==> invalid or negative value
+ *
+ * NOTE: fields are octal, with leading spaces and a trailing NUL or
+ *	 space, or else GNU base-256 if the high bit of the first byte is set.
+ */
+static bool
+tar_number(unsigned char const *field, size_t len, uintmax_t *val)
+{
+    size_t i;
+
+    *val = 0;
+
+    /*
+     * GNU base-256
+     */
+    if ((field[0] & 0x80) != 0) {
+	if ((field[0] & 0x40) != 0) {
+	    return false;	/* negative */
+	}
+	*val = field[0] & 0x3F;
+	for (i = 1; i < len; ++i) {
+	    if (*val > (UINTMAX_MAX >> 8)) {
+		return false;
+	    }
+	    *val = (*val << 8) | field[i];
+	}
+	return true;
+    }
+
+    /*
+     * octal
+     */
+    for (i = 0; i < len && field[i] == ' '; ++i) {
+	/* skip leading spaces */
+    }
+    for (; i < len && field[i] >= '0' && field[i] <= '7'; ++i) {
+	if (*val > (UINTMAX_MAX >> 3)) {
+	    return false;
+	}
+	*val = (*val << 3) | (uintmax_t)(field[i] - '0');
+    }
+    for (; i < len; ++i) {
+	if (field[i] != ' ' && field[i] != '\0') {
+	    return false;
+	}
+    }
+    return true;
+}
+
+
+/*
+ * tar_string - copy a possibly not NUL terminated tar header string
+ */
+static void
+tar_string(char *dest, unsigned char const *field, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len && field[i] != '\0'; ++i) {
+	dest[i] = (char)field[i];
+    }
+    dest[i] = '\0';
+}
+
+
+/*
+ * tar_next - read the next tar header from a compressed tarball
+ *
+ * given:
+ *	xz	xz reader of the tarball
+ *	entry	where to store the header
+ *	errmsg	where to store what is wrong on error
+ *
+ * returns:
+ *	1 ==> entry was read, 0 ==> end of the tarball, -1 ==> error
+ *
+ * NOTE: the file data of the entry is skipped: nothing is extracted.
+ *
+ * NOTE: the tarball ends at the first all zero block, or at EOF after a
+ *	 whole entry, as tar(1) accepts both.
+ *
+ * NOTE: other header types, such as pax extended headers or GNU long
+ *	 names, are returned as entries of their own: tar_mode_str()
+ *	 shows them as a '?' type.
+ */
+int
+tar_next(struct xz_reader *xz, struct tar_entry *entry, char const **errmsg)
+{
+    unsigned char block[TAR_BLOCK_SIZE * 16];	/* header or data blocks */
+    uintmax_t chksum;		/* header checksum */
+    uintmax_t usum;		/* unsigned sum of the header */
+    intmax_t ssum;		/* signed sum of the header, as old tars computed it */
+    uintmax_t val;		/* numeric field value */
+    uintmax_t skip;		/* data bytes to skip */
+    size_t len;			/* bytes to read */
+    char prefix[TAR_PREFIX_LEN + 1];	/* ustar prefix */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (xz == NULL || entry == NULL || errmsg == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    *errmsg = NULL;
+
+    /*
+     * read the header
+     */
+    if (!read_block(xz, block, errmsg)) {
+	return *errmsg == NULL ? 0 : -1;
+    }
+    for (i = 0; i < TAR_BLOCK_SIZE && block[i] == 0; ++i) {
+	/* look for an all zero block */
+    }
+    if (i == TAR_BLOCK_SIZE) {
+	return 0;
+    }
+
+    /*
+     * verify the header checksum
+     */
+    if (!tar_number(block + TAR_OFF_CHKSUM, TAR_LEN_ID, &chksum)) {
+	*errmsg = "invalid tar header checksum";
+	return -1;
+    }
+    usum = 0;
+    ssum = 0;
+    for (i = 0; i < TAR_BLOCK_SIZE; ++i) {
+	if (i >= TAR_OFF_CHKSUM && i < TAR_OFF_CHKSUM + TAR_LEN_ID) {
+	    usum += ' ';
+	    ssum += ' ';
+	} else {
+	    usum += block[i];
+	    ssum += (signed char)block[i];
+	}
+    }
+    if (chksum != usum && (intmax_t)chksum != ssum) {
+	*errmsg = "tar header checksum mismatch";
+	return -1;
+    }
+
+    /*
+     * parse the header
+     */
+    memset(entry, 0, sizeof(*entry));
+    entry->typeflag = (char)block[TAR_OFF_TYPEFLAG];
+    entry->ustar = memcmp(block + TAR_OFF_MAGIC, "ustar", 5) == 0;
+    tar_string(entry->path, block + TAR_OFF_NAME, TAR_NAME_LEN);
+    if (entry->ustar && block[TAR_OFF_MAGIC + 5] == '\0' && block[TAR_OFF_PREFIX] != '\0') {
+	/* POSIX ustar: prepend the prefix (old GNU headers use that space for other things) */
+	tar_string(prefix, block + TAR_OFF_PREFIX, TAR_PREFIX_LEN);
+	len = strlen(prefix);
+	memmove(entry->path + len + 1, entry->path, strlen(entry->path) + 1);
+	memcpy(entry->path, prefix, len);
+	entry->path[len] = '/';
+    }
+    tar_string(entry->linkname, block + TAR_OFF_LINKNAME, TAR_NAME_LEN);
+    if (entry->ustar) {
+	tar_string(entry->uname, block + TAR_OFF_UNAME, TAR_ID_NAME_LEN);
+	tar_string(entry->gname, block + TAR_OFF_GNAME, TAR_ID_NAME_LEN);
+    }
+    if (!tar_number(block + TAR_OFF_MODE, TAR_LEN_ID, &val)) {
+	*errmsg = "invalid tar header mode";
+	return -1;
+    }
+    entry->mode = (mode_t)(val & 07777);
+    if (!tar_number(block + TAR_OFF_UID, TAR_LEN_ID, &entry->uid) ||
+	!tar_number(block + TAR_OFF_GID, TAR_LEN_ID, &entry->gid)) {
+	*errmsg = "invalid tar header UID or GID";
+	return -1;
+    }
+    if (!tar_number(block + TAR_OFF_SIZE, TAR_LEN_NUM, &val) || val > INTMAX_MAX) {
+	*errmsg = "invalid tar header size";
+	return -1;
+    }
+    entry->size = (intmax_t)val;
+    if (!tar_number(block + TAR_OFF_MTIME, TAR_LEN_NUM, &val) || val > INTMAX_MAX) {
+	*errmsg = "invalid tar header mtime";
+	return -1;
+    }
+    entry->mtime = (intmax_t)val;
+
+    /*
+     * skip the file data, if any
+     */
+    switch (entry->typeflag) {
+    case TAR_LNKTYPE:
+    case TAR_SYMTYPE:
+    case TAR_CHRTYPE:
+    case TAR_BLKTYPE:
+    case TAR_DIRTYPE:
+    case TAR_FIFOTYPE:
+	skip = 0;
+	break;
+    default:
+	skip = ((uintmax_t)entry->size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE;
+	break;
+    }
+    while (skip > 0) {
+	len = skip < sizeof(block) ? (size_t)skip : sizeof(block);
+	if (xz_read(xz, block, len) != (ssize_t)len) {
+	    *errmsg = xz_error(xz) != NULL ? xz_error(xz) : "unexpected end of tarball";
+	    return -1;
+	}
+	skip -= len;
+    }
+    return 1;
+}
+
+
+/*
+ * tar_is_dir - determine if a tar entry is a directory
+ *
+ * given:
+ *	entry	tar entry
+ *
+ * returns:
+ *	true ==> directory, false ==> not a directory
+ *
+ * NOTE: like tar(1), we take a v7 regular file whose name ends in a /
+ *	 to be a directory.
+ */
+bool
+tar_is_dir(struct tar_entry const *entry)
+{
+    size_t len;
+
+    /*
+     * firewall
+     */
+    if (entry == NULL) {
+	err(11, __func__, "called with NULL entry");
+	not_reached();
+    }
+
+    if (entry->typeflag == TAR_DIRTYPE) {
+	return true;
+    }
+    if (entry->typeflag == TAR_REGTYPE || entry->typeflag == TAR_AREGTYPE) {
+	len = strlen(entry->path);
+	return len > 0 && entry->path[len - 1] == '/';
+    }
+    return false;
+}
+
+
+/*
+ * tar_is_file - determine if a tar entry is a regular file
+ *
+ * given:
+ *	entry	tar entry
+ *
+ * returns:
+ *	true ==> regular file, false ==> not a regular file
+ */
+bool
+tar_is_file(struct tar_entry const *entry)
+{
+    /*
+     * firewall
+     */
+    if (entry == NULL) {
+	err(12, __func__, "called with NULL entry");
+	not_reached();
+    }
+
+    switch (entry->typeflag) {
+    case TAR_REGTYPE:
+    case TAR_AREGTYPE:
+    case TAR_CONTTYPE:
+	return !tar_is_dir(entry);
+    default:
+	return false;
+    }
+}
+
+
+/*
+ * tar_mode_str - form the mode string that tar -tv lists for an entry
+ *
+ * given:
+ *	entry	tar entry
+ *	buf	where to store TAR_MODE_STR_LEN+1 bytes, e.g. "-r--r--r--"
+ */
+void
+tar_mode_str(struct tar_entry const *entry, char *buf)
+{
+    mode_t mode;
+
+    /*
+     * firewall
+     */
+    if (entry == NULL || buf == NULL) {
+	err(13, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    if (tar_is_dir(entry)) {
+	buf[0] = 'd';
+    } else if (tar_is_file(entry)) {
+	buf[0] = '-';
+    } else {
+	switch (entry->typeflag) {
+	case TAR_LNKTYPE:
+	    buf[0] = 'h';
+	    break;
+	case TAR_SYMTYPE:
+	    buf[0] = 'l';
+	    break;
+	case TAR_CHRTYPE:
+	    buf[0] = 'c';
+	    break;
+	case TAR_BLKTYPE:
+	    buf[0] = 'b';
+	    break;
+	case TAR_FIFOTYPE:
+	    buf[0] = 'p';
+	    break;
+	default:
+	    buf[0] = '?';
+	    break;
+	}
+    }
+    mode = entry->mode;
+    buf[1] = (mode & 0400) ? 'r' : '-';
+    buf[2] = (mode & 0200) ? 'w' : '-';
+    buf[3] = (mode & 04000) ? ((mode & 0100) ? 's' : 'S') : ((mode & 0100) ? 'x' : '-');
+    buf[4] = (mode & 040) ? 'r' : '-';
+    buf[5] = (mode & 020) ? 'w' : '-';
+    buf[6] = (mode & 02000) ? ((mode & 010) ? 's' : 'S') : ((mode & 010) ? 'x' : '-');
+    buf[7] = (mode & 04) ? 'r' : '-';
+    buf[8] = (mode & 02) ? 'w' : '-';
+    buf[9] = (mode & 01000) ? ((mode & 01) ? 't' : 'T') : ((mode & 01) ? 'x' : '-');
+    buf[TAR_MODE_STR_LEN] = '\0';
+}
+
+
+/*
+ * tar_octal - store a number in a tar header field as GNU tar does
+ *
+ * given:
+ *	field	tar header field
+ *	len	length of the field
+ *	val	value to store
+ *
+ * returns:
+ *	true ==> stored, false ==> val does not fit in the field
+ *
+ * NOTE: the number is len-1 zero padded octal digits and a NUL.
+ */
+static bool
+tar_octal(unsigned char *field, size_t len, uintmax_t val)
+{
+    size_t i;
+
+    field[len - 1] = '\0';
+    for (i = len - 1; i > 0; --i) {
+	field[i - 1] = (unsigned char)('0' + (val & 07));
+	val >>= 3;
+    }
+    return val == 0;
+}
+
+
+/*
+ * write_entry - write a directory or regular file into a tarball
+ *
+ * given:
+ *	xz	xz writer of the tarball
+ *	path	path of the directory or file, relative to the current directory
+ *	i_p	what the walk found at path, NULL ==> path is the top directory
+ *	listing	where to list the entry as tar -tv would, NULL ==> do not list
+ *	totals	totals to add the entry to
+ *
+ * returns:
+ *	true ==> entry written, false ==> error (warned about)
+ *
+ * The header is a v7 header as GNU tar --format=v7 writes it: a directory
+ * name ends in a / and has a directory type, and only the permission bits,
+ * numerical IDs, size and modification time are kept.
+ *
+ * NOTE: a file must still have the type and size that the walk found.
+ */
+static bool
+write_entry(struct xz_writer *xz, char const *path, struct item const *i_p,
+	    FILE *listing, struct tar_totals *totals)
+{
+    unsigned char block[TAR_BLOCK_SIZE * 128];	/* header or file data */
+    struct tar_entry entry;	/* the entry, as tar_next() would read it */
+    char mode[TAR_MODE_STR_LEN + 1];	/* permission string */
+    struct stat buf;		/* status of path */
+    bool isdir;			/* true ==> path is a directory */
+    uintmax_t sum;		/* header checksum */
+    intmax_t done;		/* file bytes written */
+    ssize_t n;			/* bytes read */
+    size_t len;			/* length of the name, then of the data to write */
+    int fd = -1;		/* open file */
+    size_t i;
+    int ret;
+
+    /*
+     * status of the directory or file
+     */
+    isdir = i_p == NULL || S_ISDIR(i_p->st_mode);
+    if (isdir) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = lstat(path, &buf);
+	if (ret != 0) {
+	    warnp(__func__, "cannot lstat: %s", path);
+	    return false;
+	}
+	if (!S_ISDIR(buf.st_mode)) {
+	    warn(__func__, "no longer a directory: %s", path);
+	    return false;
+	}
+    } else {
+	if (!S_ISREG(i_p->st_mode)) {
+	    warn(__func__, "not a directory or regular file: %s", path);
+	    return false;
+	}
+	errno = 0;		/* pre-clear errno for warnp() */
+	fd = open(path, O_RDONLY|O_NOFOLLOW|O_CLOEXEC);
+	if (fd < 0) {
+	    warnp(__func__, "cannot open: %s", path);
+	    return false;
+	}
+	errno = 0;		/* pre-clear errno for warnp() */
+	ret = fstat(fd, &buf);
+	if (ret != 0) {
+	    warnp(__func__, "cannot fstat: %s", path);
+	    (void) close(fd);
+	    return false;
+	}
+	if (!S_ISREG(buf.st_mode) || buf.st_size != i_p->st_size) {
+	    warn(__func__, "changed since the walk: %s", path);
+	    (void) close(fd);
+	    return false;
+	}
+    }
+
+    /*
+     * form the entry
+     */
+    memset(&entry, 0, sizeof(entry));
+    len = strlen(path);
+    if (len + (isdir ? 1 : 0) >= TAR_NAME_LEN) {
+	warn(__func__, "name is too long for a v7 tarball (max %d): %s", TAR_NAME_LEN - 1, path);
+	if (fd >= 0) {
+	    (void) close(fd);
+	}
+	return false;
+    }
+    memcpy(entry.path, path, len);
+    if (isdir) {
+	entry.path[len++] = '/';
+    }
+    entry.path[len] = '\0';
+    entry.typeflag = isdir ? TAR_DIRTYPE : TAR_AREGTYPE;
+    entry.mode = buf.st_mode & 07777;
+    entry.uid = (uintmax_t)buf.st_uid;
+    entry.gid = (uintmax_t)buf.st_gid;
+    entry.size = isdir ? 0 : (intmax_t)buf.st_size;
+    entry.mtime = buf.st_mtime > 0 ? (intmax_t)buf.st_mtime : 0;
+
+    /*
+     * form the header
+     */
+    memset(block, 0, TAR_BLOCK_SIZE);
+    memcpy(block + TAR_OFF_NAME, entry.path, len);
+    if (!tar_octal(block + TAR_OFF_MODE, TAR_LEN_ID, (uintmax_t)entry.mode) ||
+	!tar_octal(block + TAR_OFF_UID, TAR_LEN_ID, entry.uid) ||
+	!tar_octal(block + TAR_OFF_GID, TAR_LEN_ID, entry.gid) ||
+	!tar_octal(block + TAR_OFF_SIZE, TAR_LEN_NUM, (uintmax_t)entry.size) ||
+	!tar_octal(block + TAR_OFF_MTIME, TAR_LEN_NUM, (uintmax_t)entry.mtime)) {
+	warn(__func__, "UID, GID, size or modification time too large for a v7 tarball: %s", path);
+	if (fd >= 0) {
+	    (void) close(fd);
+	}
+	return false;
+    }
+    block[TAR_OFF_TYPEFLAG] = (unsigned char)entry.typeflag;
+    (void) tar_octal(block + TAR_OFF_DEVMAJOR, TAR_LEN_ID, 0);
+    (void) tar_octal(block + TAR_OFF_DEVMINOR, TAR_LEN_ID, 0);
+    memset(block + TAR_OFF_CHKSUM, ' ', TAR_LEN_ID);
+    sum = 0;
+    for (i = 0; i < TAR_BLOCK_SIZE; ++i) {
+	sum += block[i];
+    }
+    (void) tar_octal(block + TAR_OFF_CHKSUM, TAR_LEN_ID - 1, sum);
+    if (!xz_write(xz, block, TAR_BLOCK_SIZE)) {
+	warn(__func__, "cannot write header of: %s: %s", path, xz_writer_error(xz));
+	if (fd >= 0) {
+	    (void) close(fd);
+	}
+	return false;
+    }
+    totals->tar_bytes += TAR_BLOCK_SIZE;
+    if (listing != NULL) {
+	tar_mode_str(&entry, mode);
+	errno = 0;		/* pre-clear errno for warnp() */
+	if (fprintf(listing, "%s %10jd %s\n", mode, entry.size, entry.path) <= 0) {
+	    warnp(__func__, "unable to list: %s", entry.path);
+	}
+    }
+    if (isdir) {
+	++totals->dirs;
+	return true;
+    }
+
+    /*
+     * copy the file data, padded to a whole block
+     */
+    done = 0;
+    for (;;) {
+	errno = 0;		/* pre-clear errno for warnp() */
+	n = read(fd, block, sizeof(block));
+	if (n < 0) {
+	    if (errno == EINTR) {
+		continue;
+	    }
+	    warnp(__func__, "read error: %s", path);
+	    (void) close(fd);
+	    return false;
+	} else if (n == 0) {
+	    break;
+	}
+	if (done + n > entry.size) {
+	    break;
+	}
+	done += n;
+	len = (size_t)n;
+	if (done == entry.size && len % TAR_BLOCK_SIZE != 0) {
+	    memset(block + len, 0, TAR_BLOCK_SIZE - len % TAR_BLOCK_SIZE);
+	    len += TAR_BLOCK_SIZE - len % TAR_BLOCK_SIZE;
+	}
+	if (!xz_write(xz, block, len)) {
+	    warn(__func__, "cannot write data of: %s: %s", path, xz_writer_error(xz));
+	    (void) close(fd);
+	    return false;
+	}
+	totals->tar_bytes += len;
+    }
+    (void) close(fd);
+    if (done != entry.size) {
+	warn(__func__, "changed while being written: %s", path);
+	return false;
+    }
+    ++totals->files;
+    totals->file_bytes += entry.size;
+    return true;
+}
+
+
+/*
+ * tar_write_abort - give up on writing a compressed tarball
+ *
+ * Free the xz writer, which closes the tarball, and remove what was written
+ * of the tarball so that no truncated tarball is left behind.
+ *
+ * given:
+ *	xz		xz writer of the tarball
+ *	tarball_path	path of the compressed tarball
+ *
+ * NOTE: This function only warns if the tarball cannot be removed.
+ */
+static void
+tar_write_abort(struct xz_writer *xz, char const *tarball_path)
+{
+    /*
+     * firewall
+     */
+    if (xz == NULL || tarball_path == NULL) {
+	err(16, __func__, "called with NULL arg(s)"); /*ooo*/
+	not_reached();
+    }
+
+    xz_writer_free(xz);
+    errno = 0;			/* pre-clear errno for warnp() */
+    if (unlink(tarball_path) != 0 && errno != ENOENT) {
+	warnp(__func__, "cannot remove: %s", tarball_path);
+    }
+    return;
+}
+
+
+/*
+ * tar_write_walk - write a compressed v7 tarball of a walked directory
+ *
+ * given:
+ *	tarball_path	path of the compressed tarball to write
+ *	dirname		directory that was walked, relative to the current directory
+ *	wstat		the walk of dirname, with paths relative to dirname
+ *	threads		number of threads to compress with, 0 ==> 1
+ *	listing		where to list each entry as tar -tv would, NULL ==> do not list
+ *	totals		where to store the totals of what was written
+ *
+ * returns:
+ *	true ==> tarball written, false ==> error (warned about), and the
+ *		 partly written tarball removed
+ *
+ * The tarball holds dirname and then each directory and regular file of
+ * the walk, in the order of the walk, as tar --format=v7 -cJf would write
+ * them: the uncompressed tarball is the same as the one GNU tar writes for
+ * the same order of entries.  Nothing else of the walk may be in the
+ * tarball: the caller must have checked the walk for anything else.
+ *
+ * The same directory, files and modification times give the same tarball,
+ * byte for byte, whatever the number of threads: see xz_create().
+ */
+bool
+tar_write_walk(char const *tarball_path, char const *dirname, struct walk_stat *wstat,
+	       unsigned int threads, FILE *listing, struct tar_totals *totals)
+{
+    struct xz_writer *xz = NULL;	/* xz writer of the tarball */
+    unsigned char block[TAR_BLOCK_SIZE];	/* zero block */
+    char path[TAR_NAME_LEN + 1];	/* path of an item relative to the current directory */
+    struct item *i_p;		/* pointer to an element in the dynamic array */
+    intmax_t len;		/* number of elements in the dynamic array */
+    intmax_t j;
+    int ret;
+
+    /*
+     * firewall
+     */
+    if (tarball_path == NULL || dirname == NULL || wstat == NULL || wstat->all == NULL || totals == NULL) {
+	err(14, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    memset(totals, 0, sizeof(*totals));
+
+    errno = 0;			/* pre-clear errno for warnp() */
+    xz = xz_create(tarball_path, threads);
+    if (xz == NULL) {
+	warnp(__func__, "cannot create: %s", tarball_path);
+	return false;
+    }
+
+    /*
+     * the top directory, then each item of the walk
+     */
+    if (!write_entry(xz, dirname, NULL, listing, totals)) {
+	tar_write_abort(xz, tarball_path);
+	return false;
+    }
+    len = dyn_array_tell(wstat->all);
+    for (j = 0; j < len; ++j) {
+	i_p = dyn_array_value(wstat->all, struct item *, j);
+	if (i_p == NULL || i_p->fts_path == NULL) {
+	    err(15, __func__, "wstat.all[%jd] is NULL or has a NULL fts_path", j);
+	    not_reached();
+	}
+	ret = snprintf(path, sizeof(path), "%s/%s", dirname, i_p->fts_path);
+	if (ret < 0 || (size_t)ret >= sizeof(path)) {
+	    warn(__func__, "name is too long for a v7 tarball (max %d): %s/%s",
+			   TAR_NAME_LEN - 1, dirname, i_p->fts_path);
+	    tar_write_abort(xz, tarball_path);
+	    return false;
+	}
+	if (!write_entry(xz, path, i_p, listing, totals)) {
+	    tar_write_abort(xz, tarball_path);
+	    return false;
+	}
+    }
+
+    /*
+     * two zero blocks end the tarball, which is then padded to a whole record
+     */
+    memset(block, 0, sizeof(block));
+    for (j = 0; j < 2 || totals->tar_bytes % TAR_RECORD_SIZE != 0; ++j) {
+	if (!xz_write(xz, block, sizeof(block))) {
+	    warn(__func__, "cannot write: %s: %s", tarball_path, xz_writer_error(xz));
+	    tar_write_abort(xz, tarball_path);
+	    return false;
+	}
+	totals->tar_bytes += TAR_BLOCK_SIZE;
+    }
+    if (!xz_finish(xz)) {
+	warn(__func__, "cannot write: %s: %s", tarball_path, xz_writer_error(xz));
+	tar_write_abort(xz, tarball_path);
+	return false;
+    }
+    totals->xz_bytes = (uintmax_t)xz->out_total;
+    xz_writer_free(xz);
+    xz = NULL;
+    dbg(DBG_MED, "%s: %jd file%s of %jd bytes, %jd director%s, tarball %ju bytes compressed to %ju bytes",
+		 tarball_path, totals->files, totals->files == 1 ? "" : "s", totals->file_bytes,
+		 totals->dirs, totals->dirs == 1 ? "y" : "ies", totals->tar_bytes, totals->xz_bytes);
+    return true;
+}
@@ -0,0 +1,145 @@
+/*
+ * tar_util - read and write tar archives without the tar(1) tool
+ *
+ * "Not all those who wander are lost."
+ *
+ *	-- J.R.R. Tolkien
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_TAR_UTIL_H)
+#    define  INCLUDE_TAR_UTIL_H
+
+
+/*
+ * system includes
+ */
+#include <stdio.h>	    /* for FILE */
+#include <stdbool.h>	    /* for bool, true, false */
+#include <stdint.h>	    /* for intmax_t and uintmax_t */
+#include <sys/types.h>	    /* for mode_t */
+
+/*
+ * library related includes
+ */
+#include "../dbg/dbg.h"			/* dbg - info, debug, warning, error, and usage message facility */
+
+/*
+ * xz_util - read xz compressed files without the xz(1) tool
+ */
+#include "xz_util.h"
+
+/*
+ * xz_enc - write xz compressed files without the xz(1) tool
+ */
+#include "xz_enc.h"
+
+/*
+ * walk - walk directory trees and tar listings
+ */
+#include "walk.h"
+
+
+/*
+ * tar header layout
+ *
+ * We read the v7 header that mkiocccentry writes (tar --format=v7) as well
+ * as the ustar header, of which we also use the magic, the user and group
+ * names and the path prefix.
+ */
+#define TAR_BLOCK_SIZE (512)		/* tar header and data block size */
+#define TAR_NAME_LEN (100)		/* length of the name and linkname fields */
+#define TAR_PREFIX_LEN (155)		/* length of the ustar prefix field */
+#define TAR_ID_NAME_LEN (32)		/* length of the ustar uname and gname fields */
+#define TAR_PATH_MAX (TAR_PREFIX_LEN + 1 + TAR_NAME_LEN)	/* longest prefix/name path */
+#define TAR_MODE_STR_LEN (10)		/* length of a tar_mode_str() string, e.g. -r--r--r-- */
+#define TAR_RECORD_SIZE (20 * TAR_BLOCK_SIZE)	/* GNU tar pads a tarball to a multiple of this */
+
+/*
+ * tar header type flags
+ */
+#define TAR_REGTYPE ('0')		/* regular file */
+#define TAR_AREGTYPE ('\0')		/* regular file (v7) */
+#define TAR_LNKTYPE ('1')		/* hard link */
+#define TAR_SYMTYPE ('2')		/* symbolic link */
+#define TAR_CHRTYPE ('3')		/* character device */
+#define TAR_BLKTYPE ('4')		/* block device */
+#define TAR_DIRTYPE ('5')		/* directory */
+#define TAR_FIFOTYPE ('6')		/* FIFO */
+#define TAR_CONTTYPE ('7')		/* contiguous file */
+
+
+/*
+ * struct tar_entry - a tar header as tar -tv would list it
+ */
+struct tar_entry
+{
+    char path[TAR_PATH_MAX + 1];		/* path, with any ustar prefix */
+    char linkname[TAR_NAME_LEN + 1];		/* target of a link */
+    char uname[TAR_ID_NAME_LEN + 1];		/* ustar user name, or empty */
+    char gname[TAR_ID_NAME_LEN + 1];		/* ustar group name, or empty */
+    char typeflag;				/* header type flag */
+    mode_t mode;				/* permission bits */
+    uintmax_t uid;				/* numerical user ID */
+    uintmax_t gid;				/* numerical group ID */
+    intmax_t size;				/* size of the file data */
+    intmax_t mtime;				/* modification time */
+    bool ustar;					/* true ==> ustar (not v7) header */
+};
+
+
+/*
+ * struct tar_totals - what tar_write_walk() wrote
+ *
+ * These are the totals that txzchk checks a tarball for, so the tarball
+ * need not be read back to check them.
+ */
+struct tar_totals
+{
+    intmax_t files;				/* number of regular files */
+    intmax_t dirs;				/* number of directories, with the top directory */
+    intmax_t file_bytes;			/* sum of the sizes of the regular files */
+    uintmax_t tar_bytes;			/* length of the tarball before compression */
+    uintmax_t xz_bytes;				/* length of the compressed tarball */
+};
+
+
+/*
+ * external function declarations
+ */
+extern int tar_next(struct xz_reader *xz, struct tar_entry *entry, char const **errmsg);
+extern bool tar_is_dir(struct tar_entry const *entry);
+extern bool tar_is_file(struct tar_entry const *entry);
+extern void tar_mode_str(struct tar_entry const *entry, char *buf);
+extern bool tar_write_walk(char const *tarball_path, char const *dirname, struct walk_stat *wstat,
+			   unsigned int threads, FILE *listing, struct tar_totals *totals);
+
+
+#endif /* INCLUDE_TAR_UTIL_H */
@@ -84,23 +84,23 @@
  *
  * NOTE: This should match the latest Release string in CHANGES.md
  */
-#define MKIOCCCENTRY_REPO_VERSION "2.11.9 2026-07-04"	/* special release format: major.minor[.patch] YYYY-MM-DD */
+#define MKIOCCCENTRY_REPO_VERSION "2.11.32 2026-10-18"	/* special release format: major.minor[.patch] YYYY-MM-DD */
 
 /*
  * official soup version (aka recipe :-) )
  */
-#define SOUP_VERSION "2.4.3 2026-07-01"		/* format: major.minor[.patch] YYYY-MM-DD */
+#define SOUP_VERSION "2.9.2 2026-10-18"		/* format: major.minor[.patch] YYYY-MM-DD */
 
 /*
  * official iocccsize version
  */
-#define IOCCCSIZE_VERSION "29.1.0 2025-11-18"	/* format: major.minor[.patch] YYYY-MM-DD */
+#define IOCCCSIZE_VERSION "29.4.0 2026-10-18"	/* format: major.minor[.patch] YYYY-MM-DD */
 #define MIN_IOCCCSIZE_VERSION IOCCCSIZE_VERSION
 
 /*
  * official mkiocccentry versions (mkiocccentry itself and answers)
  */
-#define MKIOCCCENTRY_VERSION "2.3.5 2026-06-17"	/* format: major.minor[.patch] YYYY-MM-DD */
+#define MKIOCCCENTRY_VERSION "2.3.12 2026-10-18"	/* format: major.minor[.patch] YYYY-MM-DD */
 #define MIN_MKIOCCCENTRY_VERSION MKIOCCCENTRY_VERSION
 #define MKIOCCCENTRY_ANSWERS_VERSION "MKIOCCCENTRY_ANSWERS_IOCCC29-1.0" /* answers file version */
 #define MKIOCCCENTRY_ANSWERS_EOF "ANSWERS_EOF" /* answers file EOF marker */
@@ -125,19 +125,19 @@
 /*
  * official fnamchk version
  */
-#define FNAMCHK_VERSION "2.2.0 2025-11-18"	/* format: major.minor[.patch] YYYY-MM-DD */
+#define FNAMCHK_VERSION "2.3.0 2026-10-18"	/* format: major.minor[.patch] YYYY-MM-DD */
 #define MIN_FNAMCHK_VERSION FNAMCHK_VERSION
 
 /*
  * official txzchk version
  */
-#define TXZCHK_VERSION "2.1.2 2026-06-13"	/* format: major.minor[.patch] YYYY-MM-DD */
+#define TXZCHK_VERSION "2.3.4 2026-10-18"	/* format: major.minor[.patch] YYYY-MM-DD */
 #define MIN_TXZCHK_VERSION TXZCHK_VERSION
 
 /*
  * official chkentry version
  */
-#define CHKENTRY_VERSION "2.3.0 2025-11-30"	/* format: major.minor[.patch] YYYY-MM-DD */
+#define CHKENTRY_VERSION "2.4.1 2026-10-18"	/* format: major.minor[.patch] YYYY-MM-DD */
 #define MIN_CHKENTRY_VERSION CHKENTRY_VERSION
 
 /*
@@ -161,12 +161,22 @@
 /*
  * test_file_util - test common utility functions for file operations
  */
-#define FILE_UTIL_TEST_VERSION "2.2.0 2025-11-18" /* version format: major.minor[.patch] YYYY-MM-DD */
+#define FILE_UTIL_TEST_VERSION "2.3.0 2026-10-18" /* version format: major.minor[.patch] YYYY-MM-DD */
+
+/*
+ * test_rule_count - test rule_count() against the reference stream based rule_count()
+ */
+#define RULE_COUNT_TEST_VERSION "1.1.0 2026-10-18" /* version format: major.minor[.patch] YYYY-MM-DD */
+
+/*
+ * test_glob_match - test compile_glob() and glob_match() against fnmatch(3)
+ */
+#define GLOB_MATCH_TEST_VERSION "1.0.0 2026-10-18" /* version format: major.minor[.patch] YYYY-MM-DD */
 
  /*
   * try_fts_walk - walk a directory tree using one of the static walk_rule sets
   */
-#define TRY_FTS_WALK_VERSION "2.0.0 2025-11-18"	/* version format: major.minor[.patch] YYYY-MM-DD */
+#define TRY_FTS_WALK_VERSION "2.1.0 2026-10-18"	/* version format: major.minor[.patch] YYYY-MM-DD */
 
  /*
   * try_walk_set - try using one of the static walk_rule sets
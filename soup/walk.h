@@ -54,6 +54,8 @@
 #include <regex.h>	    /* needed for regex(3) related functions */
 #include <sys/stat.h>	    /* for st_mode and st_size types from stat(2) */
 #include <fts.h>	    /* for fts – traverse a file hierarchy */
+#include <stdint.h>	    /* for uint64_t and UINT64_C */
+#include <pthread.h>	    /* for the par_walk() thread pool */
 
 /*
  * needed for fnmatch(3) related functions and for the FNM_CASEFOLD symbol
@@ -74,6 +76,7 @@
 #include "../cpath/cpath.h"		/* canon_path - canonicalize paths */
 #include "file_util.h"			/* for fprint() and fprstr() and friends */
 #include "../jparse/util.h"		/* for fpr() and friends */
+#include "../jparse/json_arena.h"	/* for the arena from which items are allocated */
 
 /*
  * util - common utility functions
@@ -82,11 +85,11 @@
 
 
 /*
- * item_count - count the number of items in a given dyn_array pointer in the struct walk_stat
+ * item_count - count the number of items of a given category of a struct walk_stat
  *
- * We pay attention to the ready element is true in the struct walk_stat as well as to of the
- * dyn_array pointer in struct walk_stat is non-NULL.  If any of those are false, a count of 0
- * is returned.  I.e., if the struct walk_stat is not setup, or if the dyn_array is not setup, 0 is returned.
+ * We pay attention to the ready element is true in the struct walk_stat.  If it is false,
+ * a count of 0 is returned.  I.e., if the struct walk_stat is not setup, 0 is returned.
+ * The count does not need walk_view() to form the dynamic array of the category.
  *
  * Example, the following will determine the number of file and directory items recorded in struct walk_stat wstat:
  *
@@ -94,11 +97,17 @@
  *	intmax_t file_count;
  *	intmax_t dir_count;
  *
- *	file_count = item_count(&wstat, file);
- *	dir_count = item_count(&wstat, dir);
+ *	file_count = item_count(&wstat, WALK_FILE);
+ *	dir_count = item_count(&wstat, WALK_DIR);
  */
-#define item_count(wptr, dptr) \
-    ((((wptr) == NULL || (wptr)->ready == false || (wptr)->(dptr) == NULL)) ? 0 : dyn_array_tell((wptr)->(dptr)))
+#define item_count(wptr, cat) \
+    ((((wptr) == NULL || (wptr)->ready == false)) ? 0 : (wptr)->cat_count[(cat)])
+
+/*
+ * item_in_cat - true if an item is in a given category of the struct walk_stat that recorded it
+ */
+#define WALK_BIT(cat) (UINT64_C(1) << (cat))
+#define item_in_cat(i_p, cat) (((i_p)->walk_cats & WALK_BIT(cat)) != 0)
 
 /*
  * For functions such as chk_walk(), these COUNTED defines may be used
@@ -184,24 +193,105 @@ enum allowed_level {
 };
 
 
+/*
+ * walk_cat - categories of the items recorded in a struct walk_stat
+ *
+ * Each item records the categories it is in as WALK_BIT(cat) bits of its walk_cats.
+ * The dynamic array of the items of a category is only formed when walk_view() is called.
+ *
+ * NOTE: There must be no more than 64 categories: see struct item walk_cats.
+ */
+enum walk_cat {
+    /* items by type - See enum allowed_type */
+    WALK_FILE = 0,		/* file items */
+    WALK_DIR,			/* directory items */
+    WALK_SYMLINK,		/* symlink items */
+    /**/
+    WALK_NOT_FILE,		/* NOT file items */
+    WALK_NOT_DIR,		/* NOT directory items */
+    WALK_NOT_SYMLINK,		/* NOT symlink items */
+    /**/
+    WALK_FILEDIR,		/* file, or directory items */
+    WALK_FILESYM,		/* file, or symlink items */
+    WALK_DIRSYM,		/* directory, or symlink items */
+    WALK_FILEDIRSYM,		/* file, or directory, or symlink items */
+    /**/
+    WALK_NOT_FILEDIR,		/* an item that is neither a file, nor a directory */
+    WALK_NOT_FILESYM,		/* an item that is neither a file, nor a symlink */
+    WALK_NOT_DIRSYM,		/* an item that is neither a directory, nor a symlink */
+    WALK_NOT_FILEDIRSYM,	/* an item that is neither a file, nor a directory, nor a symlink */
+
+    /* items by level - See enum level */
+    WALK_TOP,			/* items directly found in the topdir directory */
+    WALK_SHALLOW,		/* items at or below the topdir directory but NOT deeper than the depth limit */
+    WALK_TOO_DEEP,		/* items deeper than the depth limit */
+    WALK_BELOW,			/* items below but NOT in topdir (i.e., not directly found in the topdir directory) */
+    /**/
+    WALK_ANY_LEVEL,		/* items at or below topdir at any level (i.e., at or below topdir) */
+    WALK_UNKNOWN_LEVEL,		/* items of an unknown level or above the topdir directory */
+
+    /* items by walk_rule - see booleans in struct walk_rule */
+    WALK_REQUIRED,		/* item matching a walk_rule that is required */
+    WALK_OPTIONAL,		/* item matching a walk_rule that is NOT required (i.e., optional) */
+    /**/
+    WALK_NON_EMPTY,		/* item matching a walk_rule must have st_size > 0 */
+    WALK_EMPTY,			/* item matching a walk_rule and st_size is 0 */
+    /**/
+    WALK_FREE,			/* item matching a walk_rule that is free (i.e., not counted) */
+    WALK_COUNTED,		/* item matching a walk_rule that is NOT free (i.e., counted) */
+    /**/
+    WALK_COUNTED_FILE,		/* file item matching a walk_rule that is NOT free (counted) */
+    WALK_COUNTED_DIR,		/* directory item matching a walk_rule that is NOT free (counted) */
+    WALK_COUNTED_SYM,		/* symlink item matching a walk_rule that is NOT free (counted) */
+    WALK_COUNTED_OTHER,		/* non-file/dir/symlink item matching a walk_rule that is NOT free (counted) */
+    /**/
+    WALK_IGNORE,		/* item matching a walk_rule that is ignore */
+    WALK_NOT_IGNORE,		/* item matching a walk_rule that is NOT ignore (i.e., processed) */
+    /**/
+    WALK_PROHIBIT,		/* item matching a walk_rule that is prohibit */
+    WALK_NOT_PROHIBIT,		/* item matching a walk_rule that is NOT prohibit (i.e., allowed) */
+    /**/
+    WALK_UNMATCHED,		/* item that did not match any walk_rule */
+
+    /* items by path problem */
+    WALK_UNSAFE,		/* path contains unsafe path elements, or .. (dot-dot) over topdir error */
+    WALK_ABS,			/* path is absolute, not a relative path */
+    WALK_TOO_LONG_PATH,		/* path is too long */
+    WALK_TOO_LONG_NAME,		/* element in path is too long */
+    /**/
+    WALK_FTS_ERR,		/* caused an fts(3) error e.g., cannot read dir, cannot stat(2), etc. */
+    WALK_SAFE,			/* all path elements are safe */
+
+    /* item descendant state */
+    WALK_VISIT,			/* OK to visit descendants */
+    WALK_PRUNE,			/* don't visit descendants, prune any walk at item */
+
+    WALK_CAT_COUNT		/* number of categories, must be last */
+};
+
+
 /*
  * item - describe a file, directory or other file system member
+ *
+ * An item and its strings are a single allocation from the arena of the struct walk_stat
+ * that recorded it, and are freed by free_walk_stat().
  */
 struct item {
-    char *fts_path;             /* malloced copy of the "root path" from topdir - typicality canonicalized */
+    char *fts_path;             /* copy of the "root path" from topdir - typicality canonicalized */
     size_t fts_pathlen;         /* strlen(fts_path) */
-    char *fts_name;             /* malloced copy of the "file name", i.e., basename of fts_path */
+    char *fts_name;             /* copy of the "file name", i.e., basename of fts_path */
     size_t fts_namelen;         /* strlen(fts_name) */
     int_least32_t fts_level;	/* fts_path depth, 0 ==> topdir, 1 ==> directly under topdir, 2 ==> in sub-dir under topdir */
     off_t st_size;              /* file size, in bytes in struct stat st_size form */
     mode_t st_mode;             /* inode protection mode in struct stat st_mode form */
+    uint64_t walk_cats;		/* WALK_BIT(cat) set ==> item is in category cat, see enum walk_cat */
 
     /*
      * pre-canonicalization information
      */
-    char *orig_path;        /* malloced copy of the "root path" from topdir before canonicalization */
+    char *orig_path;        /* copy of the "root path" from topdir before canonicalization */
     size_t orig_pathlen;    /* strlen(orig_path) */
-    char *orig_name;        /* malloced copy of the "original file name", i.e., basename of orig_path */
+    char *orig_name;        /* copy of the "original file name", i.e., basename of orig_path */
     size_t orig_namelen;    /* strlen(orig_name) */
 
     /*
@@ -360,6 +450,56 @@ struct walk_rule {
 };
 
 
+/*
+ * walk_trie - node of a trie of walk_rule prefix (or reversed suffix) patterns
+ *
+ * The nodes are in a dynamic array where node 0 is the root (the empty string).
+ */
+struct walk_trie {
+    unsigned char c;		    /* lower case pattern character that leads to this node */
+    int child;			    /* index of the first child node, -1 ==> none */
+    int sibling;		    /* index of the next sibling node, -1 ==> none */
+    int rule;			    /* first walk_rule whose pattern ends at this node, -1 ==> none */
+};
+
+/*
+ * walk_glob - element of a fnmatch(3) pattern compiled by init_walk_set()
+ */
+enum walk_glob_op {
+    GLOB_END = 0,		    /* end of the pattern */
+    GLOB_CHAR,			    /* match the character c */
+    GLOB_ANY,			    /* ? - match any one character */
+    GLOB_STAR,			    /* * - match any number of characters */
+    GLOB_SET,			    /* [...] - match one character in set */
+};
+struct walk_glob {
+    enum walk_glob_op op;	    /* what this element matches */
+    unsigned char c;		    /* character for GLOB_CHAR (lower case if the pattern is ANYCASE) */
+    unsigned char set[32];	    /* GLOB_SET bit map of the 256 characters that match */
+};
+
+/*
+ * walk_match - walk_rule set compiled by init_walk_set() for match_walk_set()
+ *
+ * Instead of trying each walk_rule in turn on each item, match_walk_set() finds the
+ * walk_rules whose pattern matches an item name all at once: MATCH_STR and MATCH_STR_ANYCASE
+ * patterns with a case independent hash, MATCH_PREFIX and MATCH_SUFFIX (and ANYCASE) patterns
+ * with a trie, and MATCH_FNMATCH and MATCH_FNMATCH_ANYCASE patterns that fnmatch(3) would
+ * match without flags other than FNM_CASEFOLD compiled into walk_glob elements.  The other
+ * ("lazy") walk_rules are tried, as before, only when reached.
+ */
+struct walk_match {
+    int count;			    /* number of walk_rules */
+    size_t words;		    /* number of uint64_t in a bit map of walk_rules */
+    uint64_t *lazy;		    /* bit map of walk_rules whose pattern is tried when reached */
+    int *next;			    /* next walk_rule with the same folded name, prefix or suffix, -1 ==> none */
+    int *name;			    /* hash of the first walk_rule of each folded MATCH_STR* pattern, -1 ==> unused */
+    size_t name_size;		    /* number of name slots, a power of 2 */
+    struct dyn_array *prefix;	    /* struct walk_trie of MATCH_PREFIX* patterns */
+    struct dyn_array *suffix;	    /* struct walk_trie of reversed MATCH_SUFFIX* patterns */
+    struct walk_glob **glob;	    /* compiled MATCH_FNMATCH* pattern of each walk_rule, NULL ==> not compiled */
+};
+
 /*
  * walk_set - set of 1 or more walk_rule for a given application and if needed application option set
  */
@@ -369,6 +509,77 @@ struct walk_set {
     char *context;		    /* malloced string describing context (tool + options) for debugging purposes */
     int count;			    /* length of set NOT counting the final NULL walk_rule.pattern */
     struct walk_rule * const rule;  /* array of walk rules, ending with a NULL walk_rule.pattern */
+    struct walk_match *match;	    /* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    bool keep;			    /* true ==> keep_walk_set() was called: keep the set compiled between walks */
+};
+
+
+/*
+ * item_index - case independent hash table of items
+ *
+ * An open addressed (linear probing) hash table of items keyed by the fold_hash() of
+ * their fts_path.  Items with paths that differ only in case are found in the order added.
+ */
+struct item_index {
+    struct item **slot;			/* hash table of items, NULL ==> unused slot */
+    size_t size;			/* number of slots, 0 or a power of 2 */
+    size_t count;			/* number of items in the table */
+};
+
+
+/*
+ * par_walk() limits
+ */
+#define PAR_WALK_MAX_JOBS (64)		/* most threads par_walk() will use to read directories */
+
+/*
+ * walk_ent - a directory entry read by a par_walk() thread
+ */
+struct walk_ent {
+    char *path;				/* malloced path below topdir */
+    char const *name;			/* name of the entry: last component of path */
+    off_t st_size;			/* size from fstatat(2), 0 ==> stat failed */
+    mode_t st_mode;			/* mode from fstatat(2), 0 ==> stat failed */
+    bool stat_ok;			/* true ==> fstatat(2) succeeded, false ==> as if fts(3) FTS_NS */
+    bool cycle;				/* true ==> directory is also one of its ancestors, as if fts(3) FTS_DC */
+    struct walk_dir *dir;		/* directory to read if entry is a directory, else NULL */
+};
+
+/*
+ * walk_dir - a directory read by a par_walk() thread
+ *
+ * The entries are sorted by name in the order that fts_cmp() has fts(3) return them.
+ */
+struct walk_dir {
+    char const *path;			/* path below topdir (owned by the walk_ent), "" ==> topdir */
+    int_least32_t level;		/* depth, 0 ==> topdir, 1 ==> directly under topdir */
+    off_t st_size;			/* size of the directory */
+    mode_t st_mode;			/* mode of the directory */
+    dev_t st_dev;			/* device of the directory, for finding cycles */
+    ino_t st_ino;			/* inode of the directory, for finding cycles */
+    struct walk_dir *parent;		/* directory this directory is in, NULL ==> topdir */
+    struct walk_dir *next;		/* next directory in the walk_pool queue */
+    bool pruned;			/* true ==> record_step() pruned the directory, do not read it */
+    bool done;				/* true ==> read (or skipped because it was pruned) */
+    bool read_ok;			/* true ==> directory was read, false ==> as if fts(3) FTS_DNR */
+    struct walk_ent *ent;		/* entries of the directory */
+    size_t count;			/* number of entries */
+};
+
+/*
+ * walk_pool - threads of par_walk() that read directories
+ *
+ * The threads read directories from the queue, and queue the directories found.
+ * The thread of par_walk() replays the directories that were read in fts(3) order.
+ */
+struct walk_pool {
+    pthread_mutex_t lock;		/* lock on queue, busy, stop and the walk_dir flags */
+    pthread_cond_t work;		/* signaled when a directory is queued or the walk is over */
+    pthread_cond_t done;		/* signaled when a directory has been read */
+    struct walk_dir *queue;		/* stack of directories to read, NULL ==> none */
+    int busy;				/* number of threads reading a directory */
+    bool stop;				/* true ==> replay is over, threads must return */
+    int rootfd;				/* open descriptor of topdir */
 };
 
 
@@ -381,11 +592,13 @@ struct walk_set {
  * The topdir may be am empty string when there is no identifiable topdir, such as what
  * might happen when "walking" a tarball listing.
  *
- * The many struct dyn_array pointers are intended to record walk information for a given item category.
- * These are in the form of paths relative topdir.  The "tell" macros may be used to determine the count,
- * i.e., the number of items that belonging to that given category.  In some cases the application may
- * wish to use a non-zero category as an indication of an error (such as prohibited items found) and
- * throw a fatal error if/as needed.
+ * Each item is recorded once, in the all dynamic array, and the categories (see enum walk_cat)
+ * it is in are bits of its walk_cats.  The walk_view() function returns a dynamic array of the
+ * items of a given category, in the order of the all dynamic array, forming it only when it is
+ * first needed after the all dynamic array has changed.  The item_count() macro may be used to
+ * determine the count, i.e., the number of items that belonging to that given category, without
+ * forming the dynamic array.  In some cases the application may wish to use a non-zero category as
+ * an indication of an error (such as prohibited items found) and throw a fatal error if/as needed.
  *
  * The main "walk" functions record items in order that they were found.  No attempt is made
  * to prevent an item from being recorded multiple times.  The fts(3) traverse a file hierarchy,
@@ -398,8 +611,8 @@ struct walk_set {
  * letting not to worry about the very rare possibility of duplicate items and letting such cases be.
  *
  * The "qsort" functions may be used fast the walk to "order" the category paths.  The "walk" functions
- * do NOT sort items during the walk.  All application is free to provide a sort comparison function
- * to the walk_qsort() function if sorted order is desired.
+ * do NOT sort items during the walk.  The sort_walk_stat() and sort_walk_istat() functions sort
+ * the all dynamic array, and so every category formed by walk_view() after them.
  *
  * For services such as the "fts(3) traverse a file hierarchy", tree pruning may be performed.
  * In such cases where parts of the file hierarchy are skipped due to tree pruning, no stats about
@@ -419,7 +632,8 @@ struct walk_set {
  * and in turn may move the very data that was pointed to before the step.  Therefore an application should
  * always re-access/re-acquire referenced data between each step, or make independent duplicate copies of
  * such data (that won't be subject to realloc(3) facility moving data), or wait until the walk is complete.
- * For this reason, the walking boolean was added.
+ * For this reason, the walking boolean was added.  The same is true of the dynamic arrays that
+ * walk_view() returns.  The items themselves, however, do not move until free_walk_stat().
  */
 struct walk_stat {
 
@@ -444,76 +658,24 @@ struct walk_stat {
     /* skip certain canonicalized paths */
     struct dyn_array *skip_set;		/* skip processing any canonicalized path that matches a skip_set item */
 
-    /* items by type - See enum allowed_type */
-    struct dyn_array *file;		/* file items */
-    struct dyn_array *dir;		/* directory items */
-    struct dyn_array *symlink;		/* symlink items */
-    /**/
-    struct dyn_array *not_file;		/* NOT file items */
-    struct dyn_array *not_dir;		/* NOT directory items */
-    struct dyn_array *not_symlink;	/* NOT symlink items */
-    /**/
-    struct dyn_array *filedir;		/* file, or directory items */
-    struct dyn_array *filesym;		/* file, or symlink items */
-    struct dyn_array *dirsym;		/* directory, or symlink items */
-    struct dyn_array *filedirsym;	/* file, or directory, or symlink items */
-    /**/
-    struct dyn_array *not_filedir;	/* an item that is neither a file, nor a directory */
-    struct dyn_array *not_filesym;	/* an item that is neither a file, nor a symlink */
-    struct dyn_array *not_dirsym;	/* an item that is neither a directory, nor a symlink */
-    struct dyn_array *not_filedirsym;	/* an item that is neither a file, nor a directory, nor a symlink */
-
-    /* items by level - See enum level */
-    struct dyn_array *top;		/* items directly found in the topdir directory */
-    struct dyn_array *shallow;		/* items at or below the topdir directory but NOT deeper than the depth limit */
-    struct dyn_array *too_deep;		/* items deeper than the depth limit */
-    struct dyn_array *below;		/* items below but NOT in topdir (i.e., not directly found in the topdir directory) */
-    /**/
-    struct dyn_array *any_level;	/* items at or below topdir at any level (i.e., at or below topdir) */
-    struct dyn_array *unknown_level;	/* items of an unknown level or above the topdir directory */
-
-    /* items by walk_rule - see booleans in struct walk_rule */
-    struct dyn_array *required;	        /* item matching a walk_rule that is required */
-    struct dyn_array *optional;		/* item matching a walk_rule that is NOT required (i.e., optional) */
-    /**/
-    struct dyn_array *non_empty;	/* item matching a walk_rule must have st_size > 0 */
-    struct dyn_array *empty;		/* item matching a walk_rule and st_size is 0 */
-    /**/
-    struct dyn_array *free;		/* item matching a walk_rule that is free (i.e., not counted) */
-    struct dyn_array *counted;		/* item matching a walk_rule that is NOT free (i.e., counted) */
-    /**/
-    struct dyn_array *counted_file;	/* file item matching a walk_rule that is free (not-counted) */
-    struct dyn_array *counted_dir;	/* directory item matching a walk_rule that is free (not-counted) */
-    struct dyn_array *counted_sym;	/* symlink item matching a walk_rule that is free (not-counted) */
-    struct dyn_array *counted_other;	/* non-file/dir/symlink item matching a walk_rule that is free (not-counted) */
-    /**/
-    struct dyn_array *ignore;		/* item matching a walk_rule that is ignore */
-    struct dyn_array *not_ignore;	/* item matching a walk_rule that is NOT ignore (i.e., processed) */
-    /**/
-    struct dyn_array *prohibit;		/* item matching a walk_rule that is prohibit */
-    struct dyn_array *not_prohibit;	/* item matching a walk_rule that is NOT prohibit (i.e., allowed) */
-    /**/
-    struct dyn_array *unmatched;	/* item that did not match any walk_rule */
+    /* items by category - See enum walk_cat */
+    intmax_t cat_count[WALK_CAT_COUNT];	/* number of items in each category */
+    struct dyn_array *view[WALK_CAT_COUNT];	/* items in each category as formed by walk_view(), NULL ==> not formed */
+    uintmax_t view_gen[WALK_CAT_COUNT];	/* all_gen when view[cat] was formed */
 
-    /* items by path problem */
-    struct dyn_array *unsafe;		/* path contains unsafe path elements, or .. (dot-dot) over topdir error */
-    struct dyn_array *abs;		/* path is absolute, not a relative path */
-    struct dyn_array *too_long_path;	/* path is too long */
-    struct dyn_array *too_long_name;	/* element in path is too long */
-    /**/
+    /* case independent duplicates */
     /* NOTE: We don't sort dup, nor dup_of, so they remain in pairs, in the order added */
     struct dyn_array *dup;		/* canonicalized path was found to be a case independent duplicate of another path */
     struct dyn_array *dup_of;		/* the "another path" that is a case independent duplicate of a canonicalized path */
-    /**/
-    struct dyn_array *fts_err;		/* caused an fts(3) error e.g., cannot read dir, cannot stat(2), etc. */
-    struct dyn_array *safe;		/* all path elements are safe */
-
-    /* item descendant state */
-    struct dyn_array *visit;		/* OK to visit descendants */
-    struct dyn_array *prune;		/* don't visit descendants, prune any walk at item */
 
     /* all items recorded */
-    struct dyn_array *all;		/* all items - to allow them to be freed by free_walk_stat() */
+    struct dyn_array *all;		/* all items, in the order recorded unless sorted */
+    uintmax_t all_gen;			/* changed each time the all dynamic array changes */
+    struct json_arena *arena;		/* arena from which the items of all and skip_set are allocated */
+
+    /* case independent indexes of items - see path_in_walk_stat() and path_in_walk_cat() */
+    struct item_index all_index;	/* index of all items */
+    struct item_index skip_index;	/* index of skip_set items */
 };
 
 
@@ -533,6 +695,7 @@ extern struct walk_set walk_anything;		/* anything goes walk_set */
  * walk_util.c external functions
  */
 extern void free_walk_stat(struct walk_stat *wstat_p);
+extern void keep_walk_set(struct walk_set *wset_p, char const *context, bool keep);
 extern void init_walk_stat(struct walk_stat *wstat_p, char const *topdir, struct walk_set *set, char const *context,
 			   size_t max_path_len, size_t max_filename_len, int_least32_t max_depth,
 			   bool tar_listing_used);
@@ -551,12 +714,18 @@ extern bool chk_walk(struct walk_stat *wstat_p, FILE *stream,
 extern int fts_cmp(const FTSENT **a, const FTSENT **b);
 extern int fts_icmp(const FTSENT **a, const FTSENT **b);
 extern bool fts_walk(struct walk_stat *wstat_p);
+extern bool par_walk(struct walk_stat *wstat_p, int jobs);
 extern char const *canonicalize_path(struct walk_stat *wstat_p, char const *fts_path,
                                      enum path_sanity *sanity_p, size_t *len_p, int_least32_t *depth_p);
 extern bool skip_add(struct walk_stat *wstat_p, char const *fts_path);
 extern struct item *path_in_item_array(struct dyn_array *item_array, char const *c_path);
 extern struct item *path_in_walk_stat(struct walk_stat *wstat_p, char const *c_path);
+extern struct item *path_in_walk_cat(struct walk_stat *wstat_p, enum walk_cat cat, char const *c_path);
+extern struct dyn_array *walk_view(struct walk_stat *wstat_p, enum walk_cat cat);
+extern char const *walk_cat_name(enum walk_cat cat);
 extern char const *allowed_type_str(enum allowed_type type);
+extern struct walk_glob *compile_glob(char const *pattern, bool anycase);
+extern bool glob_match(struct walk_glob const *glob, char const *name, bool anycase);
 
 
 #endif /* INCLUDE_WALK_H */
@@ -483,7 +483,9 @@ struct walk_set walk_mkiocccentry = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_mkiocccentry		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_mkiocccentry,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
 
 
@@ -1017,7 +1019,9 @@ struct walk_set walk_txzchk = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_txzchk		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_txzchk,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
 
 
@@ -1038,7 +1042,9 @@ struct walk_set walk_chkentry_S = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_txzchk		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_txzchk,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
 
 
@@ -1556,7 +1562,9 @@ struct walk_set walk_chkentry_s = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_chkentry_s		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_chkentry_s,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
 
 
@@ -2092,7 +2100,9 @@ struct walk_set walk_chkentry_w = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_chkentry_w		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_chkentry_w,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
 
 
@@ -2147,5 +2157,7 @@ struct walk_set walk_anything = {
     false,				/* true ==> walk_set initialized and setup */
     NULL,				/* NUL terminated string describing context (tool + options) for debugging purposes */
     0,					/* length of set NOT counting the final NULL walk_rule.pattern */
-    walk_rule_set_anything		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    walk_rule_set_anything,		/* array of walk rules, ending with a NULL walk_rule.pattern */
+    NULL,				/* walk rules compiled by init_walk_set(), NULL ==> not compiled */
+    false				/* true ==> keep_walk_set() was called: keep the set compiled between walks */
 };
@@ -42,6 +42,15 @@
  */
 
 
+/*
+ * system includes
+ */
+#include <ctype.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+
 /*
  * walk - walk directory trees and tar listings
  */
@@ -52,6 +61,10 @@
  * defines
  */
 #define DEF_CHUNK (16)	    /* number of elements to allocate at a time and initial allocation */
+#define ITEM_INDEX_MIN (64) /* initial number of slots in an item_index hash table */
+#define WALK_ARENA_BLOCK_SIZE (64*1024)	/* size of the first block of the arena of items */
+#define WALK_NAME_MIN (16)  /* minimum number of slots in the walk_match name hash table */
+#define WALK_MATCH_WORDS (8) /* match_walk_set() walk_rule bit map words that need no calloc */
 
 
 /*
@@ -61,14 +74,52 @@ static void free_walk_rule(struct walk_rule *wrule_p);
 static void init_walk_rule(struct walk_rule *wrule_p);
 static void free_walk_set(struct walk_set *wset_p);
 static void init_walk_set(struct walk_set *wset_p, char const *context);
-static void free_item(struct item *i_p);
-static struct item *alloc_item(char const *orig_path, char const *fts_path,
+static size_t name_span(char const *path, size_t len, char const **name_p);
+static struct item *alloc_item(struct walk_stat *wstat_p, char const *orig_path, char const *fts_path,
 			       off_t st_size, mode_t st_mode, int_least32_t fts_level);
-static void free_items_in_dyn_array(struct dyn_array *dyn_array_p);
 static bool chk_walk_stat(struct walk_stat *wstat_p);
-static bool match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx);
+static bool match_rule_item(struct walk_rule *rule_p, struct item *i_p, int indx);
+static bool match_rule_pattern(struct walk_rule *rule_p, struct item *i_p, int indx);
+static struct walk_match *compile_walk_set(struct walk_set *wset_p);
+static void free_walk_match(struct walk_match *match_p);
+static void add_trie(struct dyn_array *trie, int *next, char const *pattern, bool reverse, int rule);
+static void match_trie(struct walk_set *wset_p, struct dyn_array *trie, struct item *i_p, bool reverse, uint64_t *cand);
+static int match_walk_set(struct walk_set *wset_p, struct item *i_p);
 static void fprintf_dyn_array_item(FILE *stream, char const *element_name, struct dyn_array *dyn_array_p);
 static void record_fts_err(struct walk_stat *wstat_p, char const *path, off_t st_size, mode_t st_mode, int_least32_t fts_level);
+static int walk_ent_cmp(void const *pa, void const *pb);
+static void read_walk_dir(struct walk_pool *pool, struct walk_dir *dir_p);
+static void *par_walk_thread(void *arg);
+static bool replay_walk_dir(struct walk_stat *wstat_p, struct walk_pool *pool, struct walk_dir *dir_p);
+static void free_walk_dir(struct walk_dir *dir_p);
+static uint64_t fold_hash(char const *path, size_t len);
+static void index_item(struct item_index *index_p, struct item *i_p);
+static struct item *find_in_index(struct item_index const *index_p, char const *c_path, uint64_t cats);
+static void free_index(struct item_index *index_p);
+static void record_cats(struct walk_stat *wstat_p, struct item *i_p, uint64_t cats);
+
+
+/*
+ * walk_cat_names - names of the enum walk_cat categories, as printed by fprintf_walk_stat()
+ */
+static char const * const walk_cat_names[WALK_CAT_COUNT] = {
+    "file", "dir", "symlink",
+    "not_file", "not_dir", "not_symlink",
+    "filedir", "filesym", "dirsym", "filedirsym",
+    "not_filedir", "not_filesym", "not_dirsym", "not_filedirsym",
+    "top", "shallow", "too_deep", "below",
+    "any_level", "unknown_level",
+    "required", "optional",
+    "non_empty", "empty",
+    "free", "counted",
+    "counted_file", "counted_dir", "counted_sym", "counted_other",
+    "ignore", "not_ignore",
+    "prohibit", "not_prohibit",
+    "unmatched",
+    "unsafe", "absolute", "too_long_path", "too_long_name",
+    "fts_err", "safe",
+    "visit", "prune",
+};
 
 
 /*
@@ -257,6 +308,14 @@ free_walk_set(struct walk_set *wset_p)
 	free_walk_rule(rule_p);
     }
 
+    /*
+     * free the compiled walk_rule set
+     */
+    if (wset_p->match != NULL) {
+	free_walk_match(wset_p->match);
+	wset_p->match = NULL;
+    }
+
     /*
      * declare walk_set not ready
      */
@@ -298,6 +357,17 @@ init_walk_set(struct walk_set *wset_p, char const *context)
 	not_reached();
     }
 
+    /*
+     * a kept walk_set stays compiled: only clear the match_count of each walk_rule
+     */
+    if (wset_p->ready && wset_p->keep) {
+	for (rule_p = wset_p->rule; rule_p->pattern != NULL; ++rule_p) {
+	    rule_p->match_count = 0;
+	}
+	dbg(DBG_V2_HIGH, "walk_set kept with a context: %s", wset_p->context);
+	return;
+    }
+
     /*
      * free existing walk_set if walk_set is ready
      */
@@ -326,6 +396,11 @@ init_walk_set(struct walk_set *wset_p, char const *context)
     */
     wset_p->count = count;
 
+    /*
+     * compile the walk_rule set for match_walk_set()
+     */
+    wset_p->match = compile_walk_set(wset_p);
+
     /*
      * declare walk_set ready
      */
@@ -336,78 +411,90 @@ init_walk_set(struct walk_set *wset_p, char const *context)
 
 
 /*
- * free_item - free and clear an item
+ * keep_walk_set - keep a walk_set compiled between walks, or stop keeping it
+ *
+ * A tool that walks many trees with the same walk_set, such as chkentry -l,
+ * calls this function once so that init_walk_stat() need not compile the
+ * walk_set again for each walk, nor free_walk_stat() free it.
  *
  * given:
- *	i_p	    pointer to a calloced struct item
+ *	wset_p	    pointer to a struct walk_set
+ *	context	    string describing the context (tool and options) for debugging purposes
+ *	keep	    true ==> compile the walk_set now and keep it compiled,
+ *		    false ==> free the walk_set and compile it for each walk again
  *
  * NOTE: This function does not return on an internal error.
  */
-static void
-free_item(struct item *i_p)
+void
+keep_walk_set(struct walk_set *wset_p, char const *context, bool keep)
 {
     /*
      * firewall - catch NULL ptrs
      */
-    if (i_p == NULL) {
-	err(36, __func__, "called with NULL i_p");
+    if (wset_p == NULL || context == NULL) {
+	err(143, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
-    /*
-     * free orig_path
-     */
-    if (i_p->orig_path != NULL) {
-	free(i_p->orig_path);
-	i_p->orig_path = NULL;
+    wset_p->keep = false;
+    if (keep) {
+	init_walk_set(wset_p, context);
+	wset_p->keep = true;
+    } else if (wset_p->ready) {
+	free_walk_set(wset_p);
     }
+    return;
+}
 
-    /*
-     * free orig_name
-     */
-    if (i_p->orig_name != NULL) {
-	free(i_p->orig_name);
-	i_p->orig_name = NULL;
-    }
 
-    /*
-     * free fts_path
-     */
-    if (i_p->fts_path != NULL) {
-	free(i_p->fts_path);
-	i_p->fts_path = NULL;
-    }
+/*
+ * name_span - find the basename of a path as basename(3) would form it
+ *
+ * Trailing "/" (slash) characters are not part of the basename.  A path
+ * that consists entirely of "/" (slash) characters has a basename of "/"
+ * (slash), and an empty path has a basename of "." (dot).
+ *
+ * given:
+ *	path	    path to find the basename of
+ *	len	    length of path
+ *	name_p	    where to put a pointer to the start of the basename
+ *
+ * returns:
+ *	length of the basename that starts at *name_p
+ */
+static size_t
+name_span(char const *path, size_t len, char const **name_p)
+{
+    size_t end;			/* length of path without trailing slashes */
+    size_t start;		/* start of the basename in path */
 
-    /*
-     * free fts_name
-     */
-    if (i_p->fts_name != NULL) {
-	free(i_p->fts_name);
-	i_p->fts_name = NULL;
+    if (len == 0) {
+	*name_p = ".";
+	return 1;
     }
-
-    /*
-     * zero the item
-     */
-    memset(i_p, 0, sizeof(struct item));
-
-    /*
-     * free the calloced struct item
-     */
-    free(i_p);
-    return;
+    for (end = len; end > 0 && path[end-1] == '/'; --end) {
+    }
+    if (end == 0) {
+	*name_p = "/";
+	return 1;
+    }
+    for (start = end; start > 0 && path[start-1] != '/'; --start) {
+    }
+    *name_p = path + start;
+    return end - start;
 }
 
 
 /*
- * alloc_item - calloc a struct item
+ * alloc_item - allocate a struct item from the arena of a walk_stat
  *
- * One of the important side effects of this function is to use basename(3)
- * to obtain an allocated the basename of the original fts_path.
- *
- * All of the struct item are calloced, including the struct item itself, are calloced.
+ * The struct item and copies of orig_path, fts_path and their basenames
+ * (as basename(3) would form them) are one allocation from the arena of the
+ * walk_stat.  The item is freed, with all of the other items, when
+ * free_walk_stat() frees the arena.
  *
  * given:
+ *	wstat_p	    pointer to a struct walk_stat
  *	orig_path   original pre-canonicalization path
  *	fts_path    "root path" from topdir of the item
  *	st_size	    size, in bytes in the form used by stat(2)
@@ -415,21 +502,32 @@ free_item(struct item *i_p)
  *	fts_level   fts_path depth, 0 ==> topdir, 1 ==> directly under topdir, 2 ==> in sub-dir under topdir
  *
  * returns:
- *	pointer to an calloced and filled out struct item with independently calloced strings.
+ *	pointer to a zeroized and filled out struct item, in no categories
  *
  * NOTE: This function will NOT return NULL.
  *
  * NOTE: This function does not return on an internal error.
  */
 static struct item *
-alloc_item(char const *orig_path, char const *fts_path,
+alloc_item(struct walk_stat *wstat_p, char const *orig_path, char const *fts_path,
 	   off_t st_size, mode_t st_mode, int_least32_t fts_level)
 {
-    struct item *i_p;		/* struct item pointer that has been calloced */
+    struct item *i_p;		/* struct item pointer that has been allocated */
+    char const *orig_name;	/* basename of orig_path */
+    char const *fts_name;	/* basename of fts_path */
+    size_t orig_pathlen;	/* length of orig_path */
+    size_t orig_namelen;	/* length of orig_name */
+    size_t fts_pathlen;		/* length of fts_path */
+    size_t fts_namelen;		/* length of fts_name */
+    char *str;			/* where the next string is copied */
 
     /*
      * firewall - catch NULL ptrs
      */
+    if (wstat_p == NULL || wstat_p->arena == NULL) {
+	err(36, __func__, "called with NULL wstat_p or NULL wstat_p->arena");
+	not_reached();
+    }
     if (orig_path == NULL) {
 	err(37, __func__, "called with NULL orig_path");
 	not_reached();
@@ -440,59 +538,51 @@ alloc_item(char const *orig_path, char const *fts_path,
     }
 
     /*
-     * allocate and zeroize a struct item
+     * allocate the struct item and its strings, all at once
      */
-    i_p = calloc(1, sizeof(struct item));
+    orig_pathlen = strlen(orig_path);
+    orig_namelen = name_span(orig_path, orig_pathlen, &orig_name);
+    fts_pathlen = strlen(fts_path);
+    fts_namelen = name_span(fts_path, fts_pathlen, &fts_name);
+    i_p = json_arena_alloc(wstat_p->arena, sizeof(struct item) +
+			   orig_pathlen + 1 + orig_namelen + 1 + fts_pathlen + 1 + fts_namelen + 1);
     if (i_p == NULL) {
-	errp(39, __func__, "failed to calloc 1 struct item");
+	err(39, __func__, "failed to allocate 1 struct item from the walk_stat arena");
 	not_reached();
     }
+    memset(i_p, 0, sizeof(struct item));
+    str = (char *)(i_p + 1);
 
     /*
      * save orig_path information
      */
-    i_p->orig_path = strdup(orig_path);
-    if (i_p->orig_path == NULL) {
-	errp(40, __func__, "failed strdup of orig_path");
-	not_reached();
-    }
-    i_p->orig_pathlen = strlen(i_p->orig_path);
-
-    /*
-     * obtain the basename of the original path
-     */
-    i_p->orig_name = base_name(i_p->orig_path);
-    i_p->orig_namelen = strlen(i_p->orig_name);
-
-    /*
-     * duplicate the fts_name
-     */
-    i_p->fts_path = strdup(fts_path);
-    if (i_p->fts_path == NULL) {
-	errp(41, __func__, "failed strdup of fts_path");
-	not_reached();
-    }
-    i_p->fts_pathlen = strlen(i_p->fts_path);
+    i_p->orig_path = str;
+    memcpy(str, orig_path, orig_pathlen + 1);
+    i_p->orig_pathlen = orig_pathlen;
+    str += orig_pathlen + 1;
+    i_p->orig_name = str;
+    memcpy(str, orig_name, orig_namelen);
+    str[orig_namelen] = '\0';
+    i_p->orig_namelen = orig_namelen;
+    str += orig_namelen + 1;
 
     /*
-     * obtain the basename of the path
+     * save fts_path information
      */
-    i_p->fts_name = base_name(i_p->fts_path);
-    i_p->fts_namelen = strlen(i_p->fts_name);
+    i_p->fts_path = str;
+    memcpy(str, fts_path, fts_pathlen + 1);
+    i_p->fts_pathlen = fts_pathlen;
+    str += fts_pathlen + 1;
+    i_p->fts_name = str;
+    memcpy(str, fts_name, fts_namelen);
+    str[fts_namelen] = '\0';
+    i_p->fts_namelen = fts_namelen;
 
     /*
-     * save fts_level
+     * save fts_level, st_size and st_mode
      */
     i_p->fts_level = fts_level;
-
-    /*
-     * save st_size
-     */
     i_p->st_size = st_size;
-
-    /*
-     * save st_mode
-     */
     i_p->st_mode = st_mode;
 
     /*
@@ -509,61 +599,12 @@ alloc_item(char const *orig_path, char const *fts_path,
     i_p->mark_ptr = NULL;
 
     /*
-     * return calloced struct item
+     * return allocated struct item
      */
     return i_p;
 }
 
 
-/*
- * free_items_in_dyn_array - free the array of allocated items in an dyn_array
- *
- * given:
- *	dyn_array_p pointer to a dynamic array of item pointers
- *
- * NOTE: This function does not return on error due to invalid pointers.
- */
-static void
-free_items_in_dyn_array(struct dyn_array *dyn_array_p)
-{
-    struct item *i_p;	    /* pointer to an element in the dynamic array */
-    intmax_t len;	    /* number of elements in the dynamic array */
-    intmax_t i;
-
-    /*
-     * firewall - catch NULL ptrs
-     */
-    if (dyn_array_p == NULL) {
-	err(42, __func__, "called with NULL dyn_array_p");
-	not_reached();
-    }
-    if (dyn_array_p->data == NULL) {
-	err(43, __func__, "dyn_array_p->data is NULL");
-	not_reached();
-    }
-
-    /*
-     * free each item
-     */
-    len = dyn_array_tell(dyn_array_p);
-    for (i=0; i < len; ++i) {
-
-	/*
-	 * obtain the current item
-	 */
-	i_p = dyn_array_value(dyn_array_p, struct item *, i);
-
-	/*
-	 * free the current item
-	 */
-	if (i_p != NULL) {
-	    free_item(i_p);
-	}
-    }
-    return;
-}
-
-
 /*
  * free_walk_stat - free and clear a walk_stat
  *
@@ -575,6 +616,8 @@ free_items_in_dyn_array(struct dyn_array *dyn_array_p)
 void
 free_walk_stat(struct walk_stat *wstat_p)
 {
+    int cat;
+
     /*
      * firewall - catch NULL ptrs
      */
@@ -584,10 +627,12 @@ free_walk_stat(struct walk_stat *wstat_p)
     }
 
     /*
-     * free walk_set
+     * free walk_set unless it is kept
      */
     if (wstat_p->set != NULL) {
-	free_walk_set(wstat_p->set);
+	if (!wstat_p->set->keep) {
+	    free_walk_set(wstat_p->set);
+	}
 	wstat_p->set = NULL;
     }
 
@@ -625,16 +670,19 @@ free_walk_stat(struct walk_stat *wstat_p)
     wstat_p->steps = 0;
 
     /*
-     * free the all items and the all dynamic array
+     * free the all dynamic array
      */
     if (wstat_p->all != NULL) {
-
-	/* free all items pointed at by the dynamic array */
-	free_items_in_dyn_array(wstat_p->all);
-
-	/* free the all dynamic array */
 	dyn_array_free(wstat_p->all);
+	wstat_p->all = NULL;
     }
+    wstat_p->all_gen = 0;
+
+    /*
+     * free the case independent indexes of items
+     */
+    free_index(&wstat_p->all_index);
+    free_index(&wstat_p->skip_index);
 
     /*
      * free skip_set dynamic array
@@ -645,185 +693,20 @@ free_walk_stat(struct walk_stat *wstat_p)
     }
 
     /*
-     * free dyn_array for items by type
-     */
-    if (wstat_p->file != NULL) {
-	dyn_array_free(wstat_p->file);
-	wstat_p->file = NULL;
-    }
-    if (wstat_p->dir != NULL) {
-	dyn_array_free(wstat_p->dir);
-	wstat_p->dir = NULL;
-    }
-    if (wstat_p->symlink != NULL) {
-	dyn_array_free(wstat_p->symlink);
-	wstat_p->symlink = NULL;
-    }
-    if (wstat_p->not_file != NULL) {
-	dyn_array_free(wstat_p->not_file);
-	wstat_p->not_file = NULL;
-    }
-    if (wstat_p->not_dir != NULL) {
-	dyn_array_free(wstat_p->not_dir);
-	wstat_p->not_dir = NULL;
-    }
-    if (wstat_p->not_symlink != NULL) {
-	dyn_array_free(wstat_p->not_symlink);
-	wstat_p->not_symlink = NULL;
-    }
-    if (wstat_p->filedir != NULL) {
-	dyn_array_free(wstat_p->filedir);
-	wstat_p->filedir = NULL;
-    }
-    if (wstat_p->filesym != NULL) {
-	dyn_array_free(wstat_p->filesym);
-	wstat_p->filesym = NULL;
-    }
-    if (wstat_p->dirsym != NULL) {
-	dyn_array_free(wstat_p->dirsym);
-	wstat_p->dirsym = NULL;
-    }
-    if (wstat_p->filedirsym != NULL) {
-	dyn_array_free(wstat_p->filedirsym);
-	wstat_p->filedirsym = NULL;
-    }
-    if (wstat_p->not_filedir != NULL) {
-	dyn_array_free(wstat_p->not_filedir);
-	wstat_p->not_filedir = NULL;
-    }
-    if (wstat_p->not_filesym != NULL) {
-	dyn_array_free(wstat_p->not_filesym);
-	wstat_p->not_filesym = NULL;
-    }
-    if (wstat_p->not_dirsym != NULL) {
-	dyn_array_free(wstat_p->not_dirsym);
-	wstat_p->not_dirsym = NULL;
-    }
-    if (wstat_p->not_filedirsym != NULL) {
-	dyn_array_free(wstat_p->not_filedirsym);
-	wstat_p->not_filedirsym = NULL;
-    }
-
-    /*
-     * free dyn_array for items by level
+     * free the dynamic arrays formed by walk_view() and clear the category counts
      */
-    if (wstat_p->top != NULL) {
-	dyn_array_free(wstat_p->top);
-	wstat_p->top = NULL;
-    }
-    if (wstat_p->shallow != NULL) {
-	dyn_array_free(wstat_p->shallow);
-	wstat_p->shallow = NULL;
-    }
-    if (wstat_p->too_deep != NULL) {
-	dyn_array_free(wstat_p->too_deep);
-	wstat_p->too_deep = NULL;
-    }
-    if (wstat_p->below != NULL) {
-	dyn_array_free(wstat_p->below);
-	wstat_p->below = NULL;
-    }
-    /**/
-    if (wstat_p->any_level != NULL) {
-	dyn_array_free(wstat_p->any_level);
-	wstat_p->any_level = NULL;
-    }
-    if (wstat_p->unknown_level != NULL) {
-	dyn_array_free(wstat_p->unknown_level);
-	wstat_p->unknown_level = NULL;
-    }
-
-    /*
-     * free dyn_array for items by walk_rule
-     */
-    if (wstat_p->required != NULL) {
-	dyn_array_free(wstat_p->required);
-	wstat_p->required = NULL;
-    }
-    if (wstat_p->optional != NULL) {
-	dyn_array_free(wstat_p->optional);
-	wstat_p->optional = NULL;
-    }
-    /**/
-    if (wstat_p->non_empty != NULL) {
-	dyn_array_free(wstat_p->non_empty);
-	wstat_p->non_empty = NULL;
-    }
-    if (wstat_p->empty != NULL) {
-	dyn_array_free(wstat_p->empty);
-	wstat_p->empty = NULL;
-    }
-    /**/
-    if (wstat_p->free != NULL) {
-	dyn_array_free(wstat_p->free);
-	wstat_p->free = NULL;
-    }
-    if (wstat_p->counted != NULL) {
-	dyn_array_free(wstat_p->counted);
-	wstat_p->counted = NULL;
-    }
-    /**/
-    if (wstat_p->counted_file != NULL) {
-	dyn_array_free(wstat_p->counted_file);
-	wstat_p->counted_file = NULL;
-    }
-    if (wstat_p->counted_dir != NULL) {
-	dyn_array_free(wstat_p->counted_dir);
-	wstat_p->counted_dir = NULL;
-    }
-    if (wstat_p->counted_sym != NULL) {
-	dyn_array_free(wstat_p->counted_sym);
-	wstat_p->counted_sym = NULL;
-    }
-    if (wstat_p->counted_other != NULL) {
-	dyn_array_free(wstat_p->counted_other);
-	wstat_p->counted_other = NULL;
-    }
-    /**/
-    if (wstat_p->ignore != NULL) {
-	dyn_array_free(wstat_p->ignore);
-	wstat_p->ignore = NULL;
-    }
-    if (wstat_p->not_ignore != NULL) {
-	dyn_array_free(wstat_p->not_ignore);
-	wstat_p->not_ignore = NULL;
-    }
-    /**/
-    if (wstat_p->prohibit != NULL) {
-	dyn_array_free(wstat_p->prohibit);
-	wstat_p->prohibit = NULL;
-    }
-    if (wstat_p->not_prohibit != NULL) {
-	dyn_array_free(wstat_p->not_prohibit);
-	wstat_p->not_prohibit = NULL;
-    }
-    /**/
-    if (wstat_p->unmatched != NULL) {
-	/* free the dynamic array */
-	dyn_array_free(wstat_p->unmatched);
-	wstat_p->unmatched = NULL;
+    for (cat = 0; cat < WALK_CAT_COUNT; ++cat) {
+	if (wstat_p->view[cat] != NULL) {
+	    dyn_array_free(wstat_p->view[cat]);
+	    wstat_p->view[cat] = NULL;
+	}
+	wstat_p->view_gen[cat] = 0;
+	wstat_p->cat_count[cat] = 0;
     }
 
     /*
-     * free dyn_array by path problem
+     * free dyn_array of case independent duplicates
      */
-    if (wstat_p->unsafe != NULL) {
-	dyn_array_free(wstat_p->unsafe);
-	wstat_p->unsafe = NULL;
-    }
-    if (wstat_p->abs != NULL) {
-	dyn_array_free(wstat_p->abs);
-	wstat_p->abs = NULL;
-    }
-    if (wstat_p->too_long_path != NULL) {
-	dyn_array_free(wstat_p->too_long_path);
-	wstat_p->too_long_path = NULL;
-    }
-    if (wstat_p->too_long_name != NULL) {
-	dyn_array_free(wstat_p->too_long_name);
-	wstat_p->too_long_name = NULL;
-    }
-    /**/
     if (wstat_p->dup != NULL) {
 	dyn_array_free(wstat_p->dup);
 	wstat_p->dup = NULL;
@@ -832,26 +715,13 @@ free_walk_stat(struct walk_stat *wstat_p)
 	dyn_array_free(wstat_p->dup_of);
 	wstat_p->dup_of = NULL;
     }
-    /**/
-    if (wstat_p->fts_err != NULL) {
-	dyn_array_free(wstat_p->fts_err);
-	wstat_p->fts_err = NULL;
-    }
-    if (wstat_p->safe != NULL) {
-	dyn_array_free(wstat_p->safe);
-	wstat_p->safe = NULL;
-    }
 
     /*
-     * free dyn_array for item descendant state
+     * free all items, all at once, by freeing the arena they were allocated from
      */
-    if (wstat_p->visit != NULL) {
-	dyn_array_free(wstat_p->visit);
-	wstat_p->visit = NULL;
-    }
-    if (wstat_p->prune != NULL) {
-	dyn_array_free(wstat_p->prune);
-	wstat_p->prune = NULL;
+    if (wstat_p->arena != NULL) {
+	json_arena_free(wstat_p->arena);
+	wstat_p->arena = NULL;
     }
 
     /*
@@ -971,91 +841,32 @@ init_walk_stat(struct walk_stat *wstat_p, char const *topdir, struct walk_set *s
     wstat_p->steps = 0;
 
     /*
-     * allocate the skip_set dynamic array
-     */
-    wstat_p->skip_set = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-
-    /*
-     * allocate dyn_array for items by type
-     */
-    wstat_p->file = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->dir = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->symlink = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->not_file = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_dir = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_symlink = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->filedir = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->filesym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->dirsym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->filedirsym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->not_filedir = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_filesym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_dirsym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_filedirsym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-
-    /*
-     * allocate dyn_array for items by level
+     * create the arena from which items are allocated
      */
-    wstat_p->top = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->shallow = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->too_deep = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->below = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->any_level = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->unknown_level = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
+    wstat_p->arena = json_arena_create(WALK_ARENA_BLOCK_SIZE);
+    if (wstat_p->arena == NULL) {
+	err(40, __func__, "failed to create the arena of items");
+	not_reached();
+    }
 
     /*
-     * allocate dyn_array for items by walk_rule
+     * allocate the skip_set dynamic array
      */
-    wstat_p->required = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->optional = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->non_empty = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->empty = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->free = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->counted = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->counted_file = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->counted_dir = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->counted_sym = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->counted_other = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->ignore = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_ignore = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->prohibit = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->not_prohibit = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->unmatched = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
+    wstat_p->skip_set = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
 
     /*
-     * allocate dyn_array path problem
+     * allocate dyn_array of case independent duplicates
+     *
+     * NOTE: The dynamic arrays of the other categories are formed by walk_view().
      */
-    wstat_p->unsafe = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->abs = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->too_long_path = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->too_long_name = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
     wstat_p->dup = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
     wstat_p->dup_of = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    /**/
-    wstat_p->fts_err = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->safe = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-
-    /*
-     * allocate dyn_array for item descendant state
-     */
-    wstat_p->visit = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
-    wstat_p->prune = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
 
     /*
      * allocate dyn_array for all items
      */
     wstat_p->all = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
+    wstat_p->all_gen = 0;
 
     /*
      * declare walk_stat ready
@@ -1144,243 +955,54 @@ chk_walk_stat(struct walk_stat *wstat_p)
     }
 
     /*
-     * items by type dyn_array must be non-NULL
+     * dup and dup_of dyn_array must be non-NULL
      */
-    if (wstat_p->file == NULL) {
-	warn(__func__, "wstat_p file is NULL");
-	return false;
-    }
-    if (wstat_p->dir == NULL) {
-	warn(__func__, "wstat_p dir is NULL");
-	return false;
-    }
-    if (wstat_p->symlink == NULL) {
-	warn(__func__, "wstat_p symlink is NULL");
-	return false;
-    }
-    if (wstat_p->not_file == NULL) {
-	warn(__func__, "wstat_p not_file is NULL");
-	return false;
-    }
-    if (wstat_p->not_dir == NULL) {
-	warn(__func__, "wstat_p not_dir is NULL");
-	return false;
-    }
-    if (wstat_p->not_symlink == NULL) {
-	warn(__func__, "wstat_p not_symlink is NULL");
-	return false;
-    }
-    if (wstat_p->filedir == NULL) {
-	warn(__func__, "wstat_p filedir is NULL");
-	return false;
-    }
-    if (wstat_p->filesym == NULL) {
-	warn(__func__, "wstat_p filesym is NULL");
-	return false;
-    }
-    if (wstat_p->dirsym == NULL) {
-	warn(__func__, "wstat_p dirsym is NULL");
+    if (wstat_p->dup == NULL) {
+	warn(__func__, "wstat_p dup is NULL");
 	return false;
     }
-    if (wstat_p->filedirsym == NULL) {
-	warn(__func__, "wstat_p filedirsym is NULL");
+    if (wstat_p->dup_of == NULL) {
+	warn(__func__, "wstat_p dup_of is NULL");
 	return false;
     }
-    if (wstat_p->not_filedir == NULL) {
-	warn(__func__, "wstat_p not_filedir is NULL");
+
+    /*
+     * arena of items must be non-NULL
+     */
+    if (wstat_p->arena == NULL) {
+	warn(__func__, "wstat_p arena is NULL");
 	return false;
     }
-    if (wstat_p->not_filesym == NULL) {
-	warn(__func__, "wstat_p not_filesym is NULL");
+
+    /*
+     * all dyn_array must be non-NULL
+     */
+    if (wstat_p->all == NULL) {
+	warn(__func__, "wstat_p all is NULL");
 	return false;
     }
-    if (wstat_p->not_dirsym == NULL) {
-	warn(__func__, "wstat_p not_dirsym is NULL");
+
+    /*
+     * topdir must be non-NULL
+     */
+    if (wstat_p->topdir == NULL) {
+	warn(__func__, "wstat_p->topdir is NULL");
 	return false;
     }
-    if (wstat_p->not_filedirsym == NULL) {
-	warn(__func__, "wstat_p not_filedirsym is NULL");
+
+    /*
+     * topdir must be non-empty string
+     */
+    if (wstat_p->topdir[0] == '\0') {
+	warn(__func__, "wstat_p->topdir is am empty string");
 	return false;
     }
 
     /*
-     * items by level dyn_array must be non-NULL
+     * topdir string length must match topdir_len
      */
-    if (wstat_p->top == NULL) {
-	warn(__func__, "wstat_p top is NULL");
-	return false;
-    }
-    if (wstat_p->shallow == NULL) {
-	warn(__func__, "wstat_p shallow is NULL");
-	return false;
-    }
-    if (wstat_p->too_deep == NULL) {
-	warn(__func__, "wstat_p too_deep is NULL");
-	return false;
-    }
-    if (wstat_p->below == NULL) {
-	warn(__func__, "wstat_p below is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->any_level == NULL) {
-	warn(__func__, "wstat_p any_level is NULL");
-	return false;
-    }
-    if (wstat_p->unknown_level == NULL) {
-	warn(__func__, "wstat_p unknown_level is NULL");
-	return false;
-    }
-
-    /*
-     * items by walk_rule dyn_array must be non-NULL
-     */
-    if (wstat_p->required == NULL) {
-	warn(__func__, "wstat_p required is NULL");
-	return false;
-    }
-    if (wstat_p->optional == NULL) {
-	warn(__func__, "wstat_p optional is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->non_empty == NULL) {
-	warn(__func__, "wstat_p non_empty is NULL");
-	return false;
-    }
-    if (wstat_p->empty == NULL) {
-	warn(__func__, "wstat_p empty is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->free == NULL) {
-	warn(__func__, "wstat_p free is NULL");
-	return false;
-    }
-    if (wstat_p->counted == NULL) {
-	warn(__func__, "wstat_p counted is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->counted_file == NULL) {
-	warn(__func__, "wstat_p counted_file is NULL");
-	return false;
-    }
-    if (wstat_p->counted_dir == NULL) {
-	warn(__func__, "wstat_p counted_dir is NULL");
-	return false;
-    }
-    if (wstat_p->counted_sym == NULL) {
-	warn(__func__, "wstat_p counted_sym is NULL");
-	return false;
-    }
-    if (wstat_p->counted_other == NULL) {
-	warn(__func__, "wstat_p counted_other is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->ignore == NULL) {
-	warn(__func__, "wstat_p ignore is NULL");
-	return false;
-    }
-    if (wstat_p->not_ignore == NULL) {
-	warn(__func__, "wstat_p not_ignore is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->prohibit == NULL) {
-	warn(__func__, "wstat_p prohibit is NULL");
-	return false;
-    }
-    if (wstat_p->not_prohibit == NULL) {
-	warn(__func__, "wstat_p not_prohibit is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->unmatched == NULL) {
-	warn(__func__, "wstat_p unmatched is NULL");
-	return false;
-    }
-
-    /*
-     * items by path problem
-     */
-    if (wstat_p->unsafe == NULL) {
-	warn(__func__, "wstat_p unsafe is NULL");
-	return false;
-    }
-    if (wstat_p->abs == NULL) {
-	warn(__func__, "wstat_p abs is NULL");
-	return false;
-    }
-    if (wstat_p->too_long_path == NULL) {
-	warn(__func__, "wstat_p too_long_path is NULL");
-	return false;
-    }
-    if (wstat_p->too_long_name == NULL) {
-	warn(__func__, "wstat_p too_long_name is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->dup == NULL) {
-	warn(__func__, "wstat_p dup is NULL");
-	return false;
-    }
-    if (wstat_p->dup_of == NULL) {
-	warn(__func__, "wstat_p dup_of is NULL");
-	return false;
-    }
-    /**/
-    if (wstat_p->fts_err == NULL) {
-	warn(__func__, "wstat_p fts_err is NULL");
-	return false;
-    }
-    if (wstat_p->safe == NULL) {
-	warn(__func__, "wstat_p safe is NULL");
-	return false;
-    }
-
-    /*
-     * item descendant state problem
-     */
-    if (wstat_p->visit == NULL) {
-	warn(__func__, "wstat_p visit is NULL");
-	return false;
-    }
-    if (wstat_p->prune == NULL) {
-	warn(__func__, "wstat_p prune is NULL");
-	return false;
-    }
-
-    /*
-     * all dyn_array must be non-NULL
-     */
-    if (wstat_p->all == NULL) {
-	warn(__func__, "wstat_p all is NULL");
-	return false;
-    }
-
-    /*
-     * topdir must be non-NULL
-     */
-    if (wstat_p->topdir == NULL) {
-	warn(__func__, "wstat_p->topdir is NULL");
-	return false;
-    }
-
-    /*
-     * topdir must be non-empty string
-     */
-    if (wstat_p->topdir[0] == '\0') {
-	warn(__func__, "wstat_p->topdir is am empty string");
-	return false;
-    }
-
-    /*
-     * topdir string length must match topdir_len
-     */
-    if (strlen(wstat_p->topdir) != wstat_p->topdir_len) {
-	warn(__func__, "wstat_p->topdir length: %zu != topdir_len: %zu", strlen(wstat_p->topdir), wstat_p->topdir_len);
+    if (strlen(wstat_p->topdir) != wstat_p->topdir_len) {
+	warn(__func__, "wstat_p->topdir length: %zu != topdir_len: %zu", strlen(wstat_p->topdir), wstat_p->topdir_len);
 	return false;
     }
 
@@ -1392,7 +1014,7 @@ chk_walk_stat(struct walk_stat *wstat_p)
 
 
 /*
- * match_walk_rule - attempt to match an item with a walk rule
+ * match_rule_item - attempt to match the size, level and type of an item with a walk rule
  *
  * given:
  *	rule_p	    pointer to a walk rule
@@ -1400,14 +1022,15 @@ chk_walk_stat(struct walk_stat *wstat_p)
  *	indx	    walk rule index number (for debugging purposes)
  *
  * returns:
- *	true ==> item matches walk rule
+ *	true ==> item size, level and type match the walk rule
  *	false ==> item does NOT match the walk rule
+ *
+ * NOTE: An item matches a walk rule when both match_rule_item() and
+ *	 match_rule_pattern() return true.
  */
 static bool
-match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx)
+match_rule_item(struct walk_rule *rule_p, struct item *i_p, int indx)
 {
-    size_t patternlen;		/* length of pattern */
-
     /*
      * firewall - NULL ptr catch
      */
@@ -1603,6 +1226,42 @@ match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx)
 	break;
     }
 
+    /*
+     * no size, level or type match failures found
+     */
+    return true;
+}
+
+
+/*
+ * match_rule_pattern - attempt to match the name of an item with the pattern of a walk rule
+ *
+ * given:
+ *	rule_p	    pointer to a walk rule
+ *	i_p	    item to match
+ *	indx	    walk rule index number (for debugging purposes)
+ *
+ * returns:
+ *	true ==> item name matches walk rule pattern
+ *	false ==> item name does NOT match the walk rule pattern
+ */
+static bool
+match_rule_pattern(struct walk_rule *rule_p, struct item *i_p, int indx)
+{
+    size_t patternlen;		/* length of pattern */
+
+    /*
+     * firewall - NULL ptr catch
+     */
+    if (rule_p == NULL) {
+	warn(__func__, "rule_p is NULL");
+	return false;
+    }
+    if (i_p == NULL) {
+	warn(__func__, "i_p is NULL");
+	return false;
+    }
+
     /*
      * check for pattern match
      */
@@ -1650,6 +1309,7 @@ match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx)
 	    strncmp(rule_p->pattern, i_p->fts_name + i_p->fts_namelen - patternlen, patternlen) != 0) {
 	    dbg(DBG_V3_HIGH, "%s: rule[%d]: match MATCH_SUFFIX: pattern: %s doesn't match fts_name: %s",
 			     __func__, indx, rule_p->pattern, i_p->fts_name);
+	    return false;
 	}
 	break;
 
@@ -1659,6 +1319,7 @@ match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx)
 	    strncasecmp(rule_p->pattern, i_p->fts_name + i_p->fts_namelen - patternlen, patternlen) != 0) {
 	    dbg(DBG_V3_HIGH, "%s: rule[%d]: match MATCH_SUFFIX_ANYCASE: pattern: %s doesn't match fts_name: %s",
 			     __func__, indx, rule_p->pattern, i_p->fts_name);
+	    return false;
 	}
 	break;
 
@@ -1733,456 +1394,753 @@ match_walk_rule(struct walk_rule *rule_p, struct item *i_p, int indx)
 
 
 /*
- * canonicalize_path - canonicalize a path using limits from a struct walk_stat
- *
- * We canonicalize a path using the path length (wstat_p->max_path_len and wstat_p->max_filename_len) limits
- * and the depth (wstat_p->max_depth) limits from the a struct walk_stat.
- *
- * The *sanity_p, *len_p, and *depth_p pointers, if non-NULL, are updated with the
- * enum path_sanity error code (or PATH_OK), path length, and path depth as determined by
- * the canon_path() function.
- *
- * We use this canonicalize_path() function instead of just hard coding calls to the
- * the canon_path() function, in order to be sure that paths are canonicalized in the
- * same way throughout this walk code.
- *
- * In the case of these canonicalization problems:
- *
- *	PATH_ERR_PATH_TOO_LONG
- *	PATH_ERR_NOT_RELATIVE
- *	PATH_ERR_NAME_TOO_LONG
- *	PATH_ERR_PATH_TOO_DEEP
- *	PATH_ERR_NOT_SAFE
- *	PATH_ERR_DOTDOT_OVER_TOPDIR
- *
- * A malloced but unmodified copy of fts_path is returned.  Like other canon_path() function
- * detected problems, *sanity_p will be set if non-NULL.
- *
- * It is the responsibility of the calling function to free any non-NULL return by this function,
- * after the calling function no longer needs the canonicalized path.
+ * compile_glob - compile a fnmatch(3) pattern into walk_glob elements
  *
- * IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function.
+ * Only patterns of characters, "?" (question mark), "*" (star) and [...] sets of
+ * characters and ranges of characters are compiled.  A pattern with a "\" (backslash),
+ * a [:class:], [=equivalence=] or [.symbol.] in a set, a set that starts with "^" (caret)
+ * (that only fnmatch(3) knows if it negates), a descending range or a "[" (open bracket)
+ * without a "]" (close bracket) is left to fnmatch(3).
  *
  * given:
- *	wstat_p	    pointer to a struct walk_stat
- *	fts_path    "root path" from topdir of the item
- *
- *      sanity_p    NULL ==> don't save canon_path path_sanity error, or PATH_OK
- *                  != NULL ==> save enum path_sanity in *sanity_p
- *      len_p       NULL ==> don't save canonical path length,
- *                  != NULL ==> save canonical path length in *len_p
- *      depth_p     NULL ==> don't save canonical depth,
- *		    != NULL ==> record canonical depth in *depth_p
+ *	pattern	    fnmatch(3) pattern
+ *	anycase	    true ==> match as fnmatch(3) with FNM_CASEFOLD would
  *
  * returns:
- *      NULL ==> invalid path, internal error, critical canon_path() function error, or NULL pointer used
- *      != NULL ==> malloced canonicalized path
- *
- * NOTE: When NULL is returned:
- *
- *	    if sanity_p is non-NULL, then
- *		*sanity_p will be set some value that is != PATH_OK
- *
- * NOTE: When a non-NULL malloced path is returned:
+ *	calloced array of walk_glob elements ending with GLOB_END, or
+ *	NULL ==> pattern must be matched with fnmatch(3)
  *
- *          if sanity_p is non-NULL, then
- *
- *		if all was OK, then
- *		    *sanity_p will be set to PATH_OK
- *		else
- *		    *sanity_p will be set to non-critical canon_path() function error code that is != PATH_OK
+ * NOTE: This function does not return on an internal error.
  *
- * NOTE: This function will call warn(3) on internal errors and critical canon_path() function errors.
- *	 In doing do, it will set values (*sanity_p, *len_p, *depth_p) as needed, and then return NULL.
+ * NOTE: test_ioccc/test_glob_match compares what compile_glob() and glob_match()
+ *	 match with what fnmatch(3) matches.
  */
-char const *
-canonicalize_path(struct walk_stat *wstat_p, char const *fts_path,
-		  enum path_sanity *sanity_p, size_t *len_p, int_least32_t *depth_p)
+struct walk_glob *
+compile_glob(char const *pattern, bool anycase)
 {
-    char const *cpath = NULL;	    /* canonicalized path arg as a string */
-    enum path_sanity sanity = PATH_ERR_UNSET;	    /* canon_path() error code, or PATH_ERR_UNSET, or PATH_OK */
-    size_t path_len = 0;	    /* canonicalized path length */
-    int_least32_t deep = -1;	    /* canonicalized stack depth */
+    struct walk_glob *glob;	/* compiled pattern */
+    bool in_set[256];		/* characters (lower case if anycase) in a [...] set */
+    bool negate;		/* true ==> [!...] set */
+    bool first;			/* true ==> at the first character of a [...] set */
+    unsigned char lo;		/* first character of a range */
+    unsigned char hi;		/* last character of a range */
+    size_t len;			/* length of pattern */
+    size_t n = 0;		/* number of elements compiled */
+    size_t i;			/* pattern index */
+    size_t j;			/* [...] set index */
+    int c;
 
     /*
-     * firewall - catch NULL ptrs
+     * firewall
      */
-    if (wstat_p == NULL) {
-
-	/* warn about internal error, update non-NULL values and return NULL */
-	warn(__func__, "called with NULL wstat_p");
-	if (sanity_p != NULL) {
-	    *sanity_p = PATH_ERR_UNSET;
-	}
-	if (len_p != NULL) {
-	    *len_p = path_len;
-	}
-	if (depth_p != NULL) {
-	    *depth_p = deep;
-	}
-	return NULL;
+    if (pattern == NULL) {
+	err(117, __func__, "called with NULL pattern");
+	not_reached();
     }
-    if (fts_path == NULL) {
 
-	/* warn about internal error, update non-NULL values and return NULL */
-	warn(__func__, "called with NULL fts_path");
-	if (sanity_p != NULL) {
-	    *sanity_p = PATH_ERR_PATH_IS_NULL;
-	}
-	if (len_p != NULL) {
-	    *len_p = path_len;
-	}
-	if (depth_p != NULL) {
-	    *depth_p = deep;
-	}
-	return NULL;
+    /*
+     * allocate an element for each pattern character and GLOB_END
+     */
+    len = strlen(pattern);
+    errno = 0;		/* pre-clear errno for errp() */
+    glob = calloc(len + 1, sizeof(struct walk_glob));
+    if (glob == NULL) {
+	errp(118, __func__, "calloc of %zu walk_glob elements failed", len + 1);
+	not_reached();
     }
 
     /*
-     * if walk_stat check fails, abort
-     *
-     * NOTE: Passing this check means that we do not have to do as much checking elsewhere
-     *       in this function.
+     * compile each element
      */
-    if (chk_walk_stat(wstat_p) == false) {
+    for (i = 0; pattern[i] != '\0'; ++n) {
+	switch (pattern[i]) {
+	case '*':
+	    /* a run of stars matches what one star matches */
+	    glob[n].op = GLOB_STAR;
+	    while (pattern[i] == '*') {
+		++i;
+	    }
+	    break;
 
-	/* warn about internal error, update non-NULL values and return NULL */
-	warn(__func__, "wstat_p failed the chk_walk_stat function test suite");
-	if (sanity_p != NULL) {
-	    *sanity_p = PATH_ERR_UNSET;
-	}
-	if (len_p != NULL) {
-	    *len_p = path_len;
-	}
-	if (depth_p != NULL) {
-	    *depth_p = deep;
-	}
-	return NULL;
-    }
-
-    /*
-     * canonicalize path
-     */
-    dbg(DBG_HIGH, "%s: fts_path: %s", __func__, fts_path);
-    /* IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function. */
-    cpath = canon_path(fts_path, wstat_p->max_path_len, wstat_p->max_filename_len, wstat_p->max_depth,
-		       &sanity, &path_len, &deep, true, false, true, true, NULL);
-    if (cpath == NULL || sanity != PATH_OK) {
-
-	/*
-	 * process the error we encountered while trying to canonicalize the path
-	 *
-	 * In for some internal errors from the canon_path() function, we have to abort.
-	 *
-	 * In other cases we can process the original path as a "path problem".
-	 * We form a fake calloced canonicalized path so that we can later file
-	 * a "path problem".
-	 */
-	switch (sanity) {
-	case PATH_OK:
-
-	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
-	    warn(__func__, "invalid PATH_OK error: %s: %s", path_sanity_name(sanity), path_sanity_error(sanity));
-	    if (sanity_p != NULL) {
-		*sanity_p = PATH_ERR_UNSET;
-	    }
-	    if (len_p != NULL) {
-		*len_p = path_len;
-	    }
-	    if (depth_p != NULL) {
-		*depth_p = deep;
-	    }
-	    return NULL;
-
-	case PATH_ERR_PATH_EMPTY:
-
-	    /* empty paths canonicalize to . (dot) */
-	    cpath = strdup(".");
-	    if (cpath == NULL) {
+	case '?':
+	    glob[n].op = GLOB_ANY;
+	    ++i;
+	    break;
 
-		/* warn about internal error, update non-NULL values and return NULL */
-		warn(__func__, "strdup of . (dot) failed");
-		if (sanity_p != NULL) {
-		    *sanity_p = PATH_ERR_MALLOC;
-		}
-		if (len_p != NULL) {
-		    *len_p = path_len;
-		}
-		if (depth_p != NULL) {
-		    *depth_p = deep;
-		}
+	case '[':
+	    memset(in_set, 0, sizeof(in_set));
+	    j = i + 1;
+	    negate = (pattern[j] == '!');
+	    if (negate) {
+		++j;
+	    } else if (pattern[j] == '^') {
+		free(glob);
 		return NULL;
 	    }
-	    break;
-
-	case PATH_ERR_PATH_TOO_LONG:
-	case PATH_ERR_NOT_RELATIVE:
-	case PATH_ERR_NAME_TOO_LONG:
-	case PATH_ERR_PATH_TOO_DEEP:
-	case PATH_ERR_NOT_SAFE:
-	case PATH_ERR_DOTDOT_OVER_TOPDIR:
-
-	    /* just duplicate fts_path unmodified due to path problems found by canon_path() */
-	    cpath = strdup(fts_path);
-	    if (cpath == NULL) {
-
-		/* warn about internal error, update non-NULL values and return NULL */
-		warn(__func__, "strdup of fts_path failed: %s", fts_path);
-		if (sanity_p != NULL) {
-		    *sanity_p = PATH_ERR_MALLOC;
+	    for (first = true; pattern[j] != ']' || first; first = false) {
+		if (pattern[j] == '\0' || pattern[j] == '\\' ||
+		    (pattern[j] == '[' && (pattern[j+1] == ':' || pattern[j+1] == '=' || pattern[j+1] == '.'))) {
+		    free(glob);
+		    return NULL;
 		}
-		if (len_p != NULL) {
-		    *len_p = path_len;
+		lo = (unsigned char)pattern[j];
+		if (pattern[j+1] == '-' && pattern[j+2] != ']' && pattern[j+2] != '\0') {
+		    hi = (unsigned char)pattern[j+2];
+		    if (hi == '\\' || hi == '[') {
+			free(glob);
+			return NULL;
+		    }
+		    if (anycase) {
+			lo = (unsigned char)tolower(lo);
+			hi = (unsigned char)tolower(hi);
+		    }
+		    if (hi < lo) {
+			free(glob);
+			return NULL;
+		    }
+		    for (c = lo; c <= hi; ++c) {
+			in_set[c] = true;
+		    }
+		    j += 3;
+		} else {
+		    in_set[anycase ? tolower(lo) : lo] = true;
+		    ++j;
 		}
-		if (depth_p != NULL) {
-		    *depth_p = deep;
+	    }
+	    glob[n].op = GLOB_SET;
+	    for (c = 1; c < 256; ++c) {
+		if (in_set[anycase ? tolower(c) : c] != negate) {
+		    glob[n].set[c >> 3] |= (unsigned char)(1 << (c & 7));
 		}
-		return NULL;
 	    }
+	    i = j + 1;
 	    break;
 
-	case PATH_ERR_UNSET:
-	case PATH_ERR_PATH_IS_NULL:
-	case PATH_ERR_MALLOC:
-	case PATH_ERR_NULL_COMPONENT:
-	case PATH_ERR_WRONG_LEN:
-
-	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
-	    warn(__func__, "canon_path function reported critical error %s (%s) for: %s",
-			   path_sanity_name(sanity), path_sanity_error(sanity), fts_path);
-	    if (sanity_p != NULL) {
-		*sanity_p = sanity;
-	    }
-	    if (len_p != NULL) {
-		*len_p = path_len;
-	    }
-	    if (depth_p != NULL) {
-		*depth_p = deep;
-	    }
+	case '\\':
+	    free(glob);
 	    return NULL;
 
 	default:
-
-	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
-	    warn(__func__, "canon_path function set an unknown sanity value: %d for: %s", sanity, fts_path);
-	    if (sanity_p != NULL) {
-		*sanity_p = PATH_ERR_UNSET;
-	    }
-	    if (len_p != NULL) {
-		*len_p = path_len;
-	    }
-	    if (depth_p != NULL) {
-		*depth_p = deep;
-	    }
-	    return NULL;
+	    glob[n].op = GLOB_CHAR;
+	    glob[n].c = (unsigned char)(anycase ? tolower((unsigned char)pattern[i]) : pattern[i]);
+	    ++i;
+	    break;
 	}
     }
+    glob[n].op = GLOB_END;
+    return glob;
+}
+
+
+/*
+ * glob_match - match a name against walk_glob elements
+ *
+ * Each "*" (star) is first tried on no characters, and on one more each time
+ * what follows it fails to match, so that we never go back more than to the
+ * last star.
+ *
+ * given:
+ *	glob	    walk_glob elements as compiled by compile_glob()
+ *	name	    name to match
+ *	anycase	    true ==> glob was compiled for FNM_CASEFOLD
+ *
+ * returns:
+ *	true ==> name matches, as fnmatch(3) would match the pattern
+ *	false ==> name does not match, or NULL arg
+ */
+bool
+glob_match(struct walk_glob const *glob, char const *name, bool anycase)
+{
+    struct walk_glob const *star = NULL;    /* element after the last "*" (star) */
+    char const *mark = NULL;		    /* name where the last "*" (star) match ends */
+    unsigned char c;			    /* name character */
 
     /*
-     * paranoia - cpath CANNOT be NULL at this point
+     * firewall
      */
-    if (cpath == NULL) {
+    if (glob == NULL || name == NULL) {
+	return false;
+    }
 
-	/* report critical canon_path() function error */
-	warn(__func__, "cpath was NULL after the canon_path function processed: %s", fts_path);
-	if (sanity_p != NULL) {
-	    *sanity_p = PATH_ERR_PATH_IS_NULL;
+    while (*name != '\0') {
+	c = (unsigned char)*name;
+	if (glob->op == GLOB_STAR) {
+	    star = ++glob;
+	    mark = name;
+	    continue;
 	}
-	if (len_p != NULL) {
-	    *len_p = path_len;
+	if ((glob->op == GLOB_CHAR && glob->c == (anycase ? (unsigned char)tolower(c) : c)) ||
+	    glob->op == GLOB_ANY ||
+	    (glob->op == GLOB_SET && (glob->set[c >> 3] & (1 << (c & 7))) != 0)) {
+	    ++glob;
+	    ++name;
+	    continue;
 	}
-	if (depth_p != NULL) {
-	    *depth_p = deep;
+	if (star == NULL) {
+	    return false;
 	}
-	return NULL;
+	glob = star;
+	name = ++mark;
     }
+    while (glob->op == GLOB_STAR) {
+	++glob;
+    }
+    return glob->op == GLOB_END;
+}
+
+
+/*
+ * add_trie - add a walk_rule pattern to a trie
+ *
+ * given:
+ *	trie	    dynamic array of struct walk_trie, node 0 being the root
+ *	next	    next walk_rule array of the struct walk_match
+ *	pattern	    walk_rule pattern
+ *	reverse	    true ==> add the pattern from the last character to the first
+ *	rule	    walk_rule index
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static void
+add_trie(struct dyn_array *trie, int *next, char const *pattern, bool reverse, int rule)
+{
+    struct walk_trie new_node;	/* node to add */
+    struct walk_trie *node_p;	/* current node */
+    int node = 0;		/* index of the current node */
+    int child;			/* index of a child node */
+    unsigned char c;		/* lower case pattern character */
+    size_t len;			/* length of pattern */
+    size_t i;
+    int r;
 
     /*
-     * fill in return stats as required
+     * firewall
      */
-    if (sanity_p != NULL) {
-        *sanity_p = sanity;
-    }
-    if (len_p != NULL) {
-        *len_p = path_len;
+    if (trie == NULL || next == NULL || pattern == NULL) {
+	err(119, __func__, "called with NULL arg(s)");
+	not_reached();
     }
-    if (depth_p != NULL) {
-        *depth_p = deep;
+
+    /*
+     * follow, or add, the node of each character
+     */
+    len = strlen(pattern);
+    for (i = 0; i < len; ++i) {
+	c = (unsigned char)tolower((unsigned char)pattern[reverse ? len - 1 - i : i]);
+	for (child = dyn_array_addr(trie, struct walk_trie, node)->child; child >= 0;
+	     child = dyn_array_addr(trie, struct walk_trie, child)->sibling) {
+	    if (dyn_array_addr(trie, struct walk_trie, child)->c == c) {
+		break;
+	    }
+	}
+	if (child < 0) {
+	    new_node.c = c;
+	    new_node.child = -1;
+	    new_node.sibling = dyn_array_addr(trie, struct walk_trie, node)->child;
+	    new_node.rule = -1;
+	    (void) dyn_array_append_value(trie, &new_node);
+	    child = (int)dyn_array_tell(trie) - 1;
+	    dyn_array_addr(trie, struct walk_trie, node)->child = child;
+	}
+	node = child;
     }
 
     /*
-     * return canonicalized path
+     * add the rule after the other rules whose pattern ends at this node
      */
-    return cpath;
+    node_p = dyn_array_addr(trie, struct walk_trie, node);
+    if (node_p->rule < 0) {
+	node_p->rule = rule;
+    } else {
+	for (r = node_p->rule; next[r] >= 0; r = next[r]) {
+	}
+	next[r] = rule;
+    }
+    return;
 }
 
 
 /*
- * skip_add - add a canonicalized path to skip_set dynamic array
- *
- * For a given struct walk_stat, add canonicalized fts_path as an pointer to as
- * "fake" struct item to wstat_p->skip_set.  By "fake", the st_size and st_mode
- * will be set to 0.
+ * match_trie - note the walk_rules whose prefix (or suffix) pattern matches an item
  *
- * The skip_set dynamic array is used to skip record_step() processing for certain selected paths.
- * For more information about how the skip_set dynamic array is used,
- * see the comments in the record_step() function below.
+ * given:
+ *	wset_p	    pointer to a walk_set compiled by compile_walk_set()
+ *	trie	    prefix or suffix trie of wset_p->match
+ *	i_p	    item to match
+ *	reverse	    true ==> trie is of reversed suffix patterns
+ *	cand	    bit map of walk_rules whose pattern matches
+ */
+static void
+match_trie(struct walk_set *wset_p, struct dyn_array *trie, struct item *i_p, bool reverse, uint64_t *cand)
+{
+    struct walk_rule *rule_p;	/* walk_rule ending at the current node */
+    char const *name;		/* item name */
+    size_t len;			/* length of name */
+    size_t depth;		/* number of name characters matched */
+    int node = 0;		/* index of the current node */
+    unsigned char c;		/* lower case name character */
+    int r;
+
+    name = i_p->fts_name;
+    len = i_p->fts_namelen;
+    for (depth = 0; ; ++depth) {
+
+	/*
+	 * note the rules whose depth long pattern ends here
+	 */
+	for (r = dyn_array_addr(trie, struct walk_trie, node)->rule; r >= 0; r = wset_p->match->next[r]) {
+	    rule_p = &wset_p->rule[r];
+	    if (rule_p->match == MATCH_PREFIX_ANYCASE || rule_p->match == MATCH_SUFFIX_ANYCASE ||
+		strncmp(rule_p->pattern, reverse ? name + len - depth : name, depth) == 0) {
+		cand[r / 64] |= UINT64_C(1) << (r % 64);
+	    }
+	}
+
+	/*
+	 * follow the next name character
+	 */
+	if (depth == len) {
+	    break;
+	}
+	c = (unsigned char)tolower((unsigned char)name[reverse ? len - 1 - depth : depth]);
+	for (node = dyn_array_addr(trie, struct walk_trie, node)->child; node >= 0;
+	     node = dyn_array_addr(trie, struct walk_trie, node)->sibling) {
+	    if (dyn_array_addr(trie, struct walk_trie, node)->c == c) {
+		break;
+	    }
+	}
+	if (node < 0) {
+	    break;
+	}
+    }
+    return;
+}
+
+
+/*
+ * compile_walk_set - compile the walk_rules of a walk_set for match_walk_set()
  *
  * given:
- *	wstat_p	    pointer to a struct walk_stat
- *	fts_path    "root path" from topdir of the item
+ *	wset_p	    pointer to a walk_set whose count has been set
  *
  * returns:
- *	true ==> canonicalized fts_path was added to the skip_set dynamic array
- *	false ==> canonicalized fts_path was already in the skip_set dynamic array
+ *	calloced struct walk_match, free with free_walk_match()
  *
  * NOTE: This function does not return on an internal error.
  */
-bool
-skip_add(struct walk_stat *wstat_p, char const *fts_path)
+static struct walk_match *
+compile_walk_set(struct walk_set *wset_p)
 {
-    char const *cpath = NULL;	    /* canonicalized path arg as a string */
-    int_least32_t deep = -1;	    /* canonicalized stack depth */
-    struct item *i_p = NULL;	    /* allocated item */
+    struct walk_match *match_p;	    /* compiled walk_set */
+    struct walk_trie root;	    /* root node of a trie */
+    struct walk_rule *rule_p;	    /* pointer to a walk rule */
+    size_t name_count = 0;	    /* number of MATCH_STR* walk_rules */
+    size_t mask;		    /* name_size - 1 */
+    size_t slot;		    /* name slot being probed */
+    size_t alloc;		    /* number of walk_rules to allocate for, at least 1 */
+    int r;
+    int t;
 
     /*
-     * firewall - catch NULL ptrs
+     * firewall
      */
-    if (wstat_p == NULL) {
-	err(50, __func__, "called with NULL wstat_p");
-	not_reached();
-    }
-    if (fts_path == NULL) {
-	err(51, __func__, "called with NULL fts_path");
+    if (wset_p == NULL || wset_p->rule == NULL || wset_p->count < 0) {
+	err(120, __func__, "called with NULL wset_p, or NULL wset_p->rule, or wset_p->count < 0");
 	not_reached();
     }
 
     /*
-     * if walk_stat check fails, abort
-     *
-     * NOTE: Passing this check means that we do not have to do as much checking elsewhere
-     *       in this function.
+     * allocate the walk_match
      */
-    if (! chk_walk_stat(wstat_p)) {
-	err(52, __func__, "wstat_p failed the chk_walk_stat function test suite");
+    errno = 0;		/* pre-clear errno for errp() */
+    match_p = calloc(1, sizeof(struct walk_match));
+    if (match_p == NULL) {
+	errp(121, __func__, "calloc of a struct walk_match failed");
+	not_reached();
+    }
+    match_p->count = wset_p->count;
+    alloc = (wset_p->count > 0) ? (size_t)wset_p->count : 1;
+    match_p->words = (alloc + 63) / 64;
+    errno = 0;		/* pre-clear errno for errp() */
+    match_p->lazy = calloc(match_p->words, sizeof(uint64_t));
+    match_p->next = calloc(alloc, sizeof(int));
+    match_p->glob = calloc(alloc, sizeof(struct walk_glob *));
+    if (match_p->lazy == NULL || match_p->next == NULL || match_p->glob == NULL) {
+	errp(122, __func__, "calloc of walk_match arrays for %zu walk_rules failed", alloc);
 	not_reached();
     }
+    for (r = 0; r < match_p->count; ++r) {
+	match_p->next[r] = -1;
+	if (wset_p->rule[r].match == MATCH_STR || wset_p->rule[r].match == MATCH_STR_ANYCASE) {
+	    ++name_count;
+	}
+    }
 
     /*
-     * canonicalize path
+     * allocate the name hash table, at most half full
      */
-    dbg(DBG_MED, "%s: fts_path: %s", __func__, fts_path);
-    cpath = canonicalize_path(wstat_p, fts_path, NULL, NULL, &deep);
-    /* paranoia */
-    if (cpath == NULL) {
-	err(53, __func__, "canonicalize_path had an internal failure and returned NULL");
+    for (match_p->name_size = WALK_NAME_MIN; match_p->name_size < name_count * 2; match_p->name_size *= 2) {
+    }
+    errno = 0;		/* pre-clear errno for errp() */
+    match_p->name = calloc(match_p->name_size, sizeof(int));
+    if (match_p->name == NULL) {
+	errp(123, __func__, "calloc of %zu name slots failed", match_p->name_size);
 	not_reached();
     }
+    for (slot = 0; slot < match_p->name_size; ++slot) {
+	match_p->name[slot] = -1;
+    }
+    mask = match_p->name_size - 1;
 
     /*
-     * see if canonicalized path is already in the skip_set dynamic array
+     * create the prefix and suffix tries with their root node
      */
-    i_p = path_in_item_array(wstat_p->skip_set, cpath);
-    if (i_p != NULL) {
-	dbg(DBG_MED, "%s: fts_path already in skip_set: %s", __func__, fts_path);
-	return false;
-    }
+    root.c = '\0';
+    root.child = -1;
+    root.sibling = -1;
+    root.rule = -1;
+    match_p->prefix = dyn_array_create(sizeof(struct walk_trie), DEF_CHUNK, DEF_CHUNK, true);
+    (void) dyn_array_append_value(match_p->prefix, &root);
+    match_p->suffix = dyn_array_create(sizeof(struct walk_trie), DEF_CHUNK, DEF_CHUNK, true);
+    (void) dyn_array_append_value(match_p->suffix, &root);
 
     /*
-     * form an allocated item
+     * compile each walk_rule
      */
-    i_p = alloc_item(fts_path, cpath, 0, 0, deep);
-    (void) dyn_array_append_value(wstat_p->skip_set, &i_p);
+    for (r = 0; r < match_p->count; ++r) {
+	rule_p = &wset_p->rule[r];
+	switch (rule_p->match) {
 
-    /*
-     * canonicalized fts_path added to skip_set
-     */
-    dbg(DBG_LOW, "%s: fts_path added to skip_set: %s", __func__, fts_path);
-    return true;
+	case MATCH_STR:
+	case MATCH_STR_ANYCASE:
+	    /* add after the other rules with the same case independent pattern, if any */
+	    for (slot = (size_t)fold_hash(rule_p->pattern, strlen(rule_p->pattern)) & mask;
+		 match_p->name[slot] >= 0; slot = (slot + 1) & mask) {
+		if (strcasecmp(wset_p->rule[match_p->name[slot]].pattern, rule_p->pattern) == 0) {
+		    break;
+		}
+	    }
+	    if (match_p->name[slot] < 0) {
+		match_p->name[slot] = r;
+	    } else {
+		for (t = match_p->name[slot]; match_p->next[t] >= 0; t = match_p->next[t]) {
+		}
+		match_p->next[t] = r;
+	    }
+	    break;
+
+	case MATCH_PREFIX:
+	case MATCH_PREFIX_ANYCASE:
+	    add_trie(match_p->prefix, match_p->next, rule_p->pattern, false, r);
+	    break;
+
+	case MATCH_SUFFIX:
+	case MATCH_SUFFIX_ANYCASE:
+	    add_trie(match_p->suffix, match_p->next, rule_p->pattern, true, r);
+	    break;
+
+	case MATCH_FNMATCH:
+	case MATCH_FNMATCH_ANYCASE:
+	    match_p->glob[r] = compile_glob(rule_p->pattern, rule_p->match == MATCH_FNMATCH_ANYCASE);
+	    dbg(DBG_V2_HIGH, "%s: rule[%d]: fnmatch pattern: %s %s", __func__, r, rule_p->pattern,
+			     (match_p->glob[r] == NULL) ? "left to fnmatch(3)" : "compiled");
+	    match_p->lazy[r / 64] |= UINT64_C(1) << (r % 64);
+	    break;
+
+	default:
+	    /* regex, any and other patterns are tried when reached */
+	    match_p->lazy[r / 64] |= UINT64_C(1) << (r % 64);
+	    break;
+	}
+    }
+    dbg(DBG_V2_HIGH, "%s: compiled %d walk_rules: %zu names, %jd prefix and %jd suffix trie nodes",
+		     __func__, match_p->count, name_count,
+		     dyn_array_tell(match_p->prefix), dyn_array_tell(match_p->suffix));
+    return match_p;
 }
 
 
 /*
- * record_step - record an item in a struct walk_stat
+ * free_walk_match - free a struct walk_match
  *
- * Record the step of a walk, given the original path.  We attempt to canonicalize the path.
- * If the path was successfully canonicalized, process the result.  If the path could
- * not be canonicalized, record the problem accordingly.
+ * given:
+ *	match_p	    pointer to a struct walk_match from compile_walk_set(), or NULL
+ */
+static void
+free_walk_match(struct walk_match *match_p)
+{
+    int r;
+
+    if (match_p == NULL) {
+	return;
+    }
+    if (match_p->glob != NULL) {
+	for (r = 0; r < match_p->count; ++r) {
+	    if (match_p->glob[r] != NULL) {
+		free(match_p->glob[r]);
+		match_p->glob[r] = NULL;
+	    }
+	}
+	free(match_p->glob);
+	match_p->glob = NULL;
+    }
+    if (match_p->prefix != NULL) {
+	dyn_array_free(match_p->prefix);
+	match_p->prefix = NULL;
+    }
+    if (match_p->suffix != NULL) {
+	dyn_array_free(match_p->suffix);
+	match_p->suffix = NULL;
+    }
+    if (match_p->name != NULL) {
+	free(match_p->name);
+	match_p->name = NULL;
+    }
+    if (match_p->next != NULL) {
+	free(match_p->next);
+	match_p->next = NULL;
+    }
+    if (match_p->lazy != NULL) {
+	free(match_p->lazy);
+	match_p->lazy = NULL;
+    }
+    free(match_p);
+    return;
+}
+
+
+/*
+ * match_walk_set - find the first walk rule of a walk set that matches an item
  *
- * This function WILL always:
+ * The walk_rules whose pattern matches the item name are found with the
+ * walk_match of the walk_set.  Then, in walk_rule order, each such walk_rule,
+ * and each walk_rule whose pattern must be tried when reached, is checked
+ * until one matches, just as trying each walk_rule in turn would find.
  *
- *	- err(3) WILL be called if wstat_p is NULL
- *	- err(3) WILL be called if fts_path is NULL
- *	- err(3) WILL be called if chk_walk_stat(wstat_p) returns false
- *	- canonicalize_path() WILL be called to canonicalized the fts_path
+ * given:
+ *	wset_p	    pointer to a walk set
+ *	i_p	    item to match
  *
- *	  NOTE: using length and depth restrictions that were set when init_walk_stat() was called
+ * returns:
+ *	>= 0 ==> index of the first walk rule that matches the item
+ *	-1 ==> no walk rule matches the item
  *
- *	- fts_path will be checked if it is a duplicate under wstat_p->all
- *	- If is_dup_p is non-NULL, *is_dup_p will be set
+ * NOTE: This function does not return on an internal error.
+ */
+static int
+match_walk_set(struct walk_set *wset_p, struct item *i_p)
+{
+    struct walk_match *match_p;		    /* compiled walk_set */
+    struct walk_rule *rule_p;		    /* pointer to a walk rule */
+    uint64_t cand_buf[WALK_MATCH_WORDS];    /* bit map of walk_rules whose pattern matches */
+    uint64_t *cand = cand_buf;		    /* cand_buf, or calloced if too small */
+    uint64_t bits;			    /* bit map word of walk_rules to check */
+    bool found = false;			    /* true ==> a walk_rule matched */
+    size_t mask;			    /* name_size - 1 */
+    size_t slot;			    /* name slot being probed */
+    size_t w;
+    int b;
+    int r = -1;
+
+    /*
+     * firewall
+     */
+    if (wset_p == NULL || wset_p->rule == NULL || i_p == NULL || i_p->fts_name == NULL) {
+	err(124, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * if not compiled, try each walk_rule in turn
+     */
+    match_p = wset_p->match;
+    if (match_p == NULL) {
+	for (r = 0; wset_p->rule[r].pattern != NULL; ++r) {
+	    if (match_rule_item(&wset_p->rule[r], i_p, r) && match_rule_pattern(&wset_p->rule[r], i_p, r)) {
+		return r;
+	    }
+	}
+	return -1;
+    }
+
+    /*
+     * clear the bit map of walk_rules whose pattern matches
+     */
+    if (match_p->words > WALK_MATCH_WORDS) {
+	errno = 0;		/* pre-clear errno for errp() */
+	cand = calloc(match_p->words, sizeof(uint64_t));
+	if (cand == NULL) {
+	    errp(125, __func__, "calloc of %zu bit map words failed", match_p->words);
+	    not_reached();
+	}
+    } else {
+	memset(cand_buf, 0, sizeof(cand_buf));
+    }
+
+    /*
+     * note the MATCH_STR and MATCH_STR_ANYCASE walk_rules that match
+     */
+    mask = match_p->name_size - 1;
+    for (slot = (size_t)fold_hash(i_p->fts_name, i_p->fts_namelen) & mask; match_p->name[slot] >= 0;
+	 slot = (slot + 1) & mask) {
+	if (strcasecmp(wset_p->rule[match_p->name[slot]].pattern, i_p->fts_name) == 0) {
+	    for (r = match_p->name[slot]; r >= 0; r = match_p->next[r]) {
+		if (wset_p->rule[r].match == MATCH_STR_ANYCASE || strcmp(wset_p->rule[r].pattern, i_p->fts_name) == 0) {
+		    cand[r / 64] |= UINT64_C(1) << (r % 64);
+		}
+	    }
+	    break;
+	}
+    }
+
+    /*
+     * note the prefix and suffix walk_rules that match
+     */
+    match_trie(wset_p, match_p->prefix, i_p, false, cand);
+    match_trie(wset_p, match_p->suffix, i_p, true, cand);
+
+    /*
+     * check, in walk_rule order, the walk_rules whose pattern matches or must be tried
+     */
+    for (w = 0; w < match_p->words && !found; ++w) {
+	bits = cand[w] | match_p->lazy[w];
+	for (b = 0; bits != 0 && b < 64; ++b, bits >>= 1) {
+	    if ((bits & 1) == 0) {
+		continue;
+	    }
+	    r = (int)(w * 64) + b;
+	    rule_p = &wset_p->rule[r];
+	    if (! match_rule_item(rule_p, i_p, r)) {
+		continue;
+	    }
+	    if ((cand[w] & (UINT64_C(1) << b)) != 0) {
+		found = true;
+	    } else if (match_p->glob[r] != NULL) {
+		found = glob_match(match_p->glob[r], i_p->fts_name, rule_p->match == MATCH_FNMATCH_ANYCASE);
+	    } else {
+		found = match_rule_pattern(rule_p, i_p, r);
+	    }
+	    if (found) {
+		break;
+	    }
+	}
+    }
+
+    /*
+     * free the bit map if it was calloced
+     */
+    if (cand != cand_buf) {
+	free(cand);
+	cand = NULL;
+    }
+    return found ? r : -1;
+}
+
+
+/*
+ * canonicalize_path - canonicalize a path using limits from a struct walk_stat
  *
- *	  NOTE: *is_dup_p set according to if canonicalized was already recorded in struct walk_stat or not
+ * We canonicalize a path using the path length (wstat_p->max_path_len and wstat_p->max_filename_len) limits
+ * and the depth (wstat_p->max_depth) limits from the a struct walk_stat.
  *
- *	- if cpath_ret is non-NULL, *cpath_ret WILL be set to canonicalized path of fts_path
+ * The *sanity_p, *len_p, and *depth_p pointers, if non-NULL, are updated with the
+ * enum path_sanity error code (or PATH_OK), path length, and path depth as determined by
+ * the canon_path() function.
  *
- * If a path in the skip_set dynamic array of canonicalized paths matches the canonicalized path of fts_path:
+ * We use this canonicalize_path() function instead of just hard coding calls to the
+ * the canon_path() function, in order to be sure that paths are canonicalized in the
+ * same way throughout this walk code.
  *
- *	- ALL of the "This function WILL always" actions WILL be performed
+ * In the case of these canonicalization problems:
  *
- *	- path will NOT be added to ANY struct walk_stat dynamic array
- *	- path will NOT be added to the all dynamic array
- *	- path will NOT be added to the prune dynamic array
+ *	PATH_ERR_PATH_TOO_LONG
+ *	PATH_ERR_NOT_RELATIVE
+ *	PATH_ERR_NAME_TOO_LONG
+ *	PATH_ERR_PATH_TOO_DEEP
+ *	PATH_ERR_NOT_SAFE
+ *	PATH_ERR_DOTDOT_OVER_TOPDIR
  *
- *	- wstat_p->walking will NOT be modified
- *	- wstat_p->steps will NOT be modified
+ * A malloced but unmodified copy of fts_path is returned.  Like other canon_path() function
+ * detected problems, *sanity_p will be set if non-NULL.
  *
- *	- return false
+ * It is the responsibility of the calling function to free any non-NULL return by this function,
+ * after the calling function no longer needs the canonicalized path.
+ *
+ * IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function.
  *
  * given:
  *	wstat_p	    pointer to a struct walk_stat
  *	fts_path    "root path" from topdir of the item
- *	st_size	    size, in bytes in the form used by stat(2)
- *	st_mode	    inode protection mode in the form used by stat(2)
  *
- *	is_dup_p    != NULL ==> set *is_dup_p according to if canonicalized was already recorded in struct walk_stat
- *		    NULL ==> do not check for duplicates
- *	cpath_ret   != NULL ==> update with pointer to the canonical path
- *		    NULL ==> ignore
- *	skip_set   != NULL ==> dynamic_array of canonicalized paths from topdir to ignore
- *		    NULL ==> ignore
+ *      sanity_p    NULL ==> don't save canon_path path_sanity error, or PATH_OK
+ *                  != NULL ==> save enum path_sanity in *sanity_p
+ *      len_p       NULL ==> don't save canonical path length,
+ *                  != NULL ==> save canonical path length in *len_p
+ *      depth_p     NULL ==> don't save canonical depth,
+ *		    != NULL ==> record canonical depth in *depth_p
  *
  * returns:
- *	true ==> fts_path is to be processed: if walking a hierarchy, any descendants should be visited
- *	false ==> if walking a hierarchy prune walk below fts_path: do NOT visit descendants of fts_path
+ *      NULL ==> invalid path, internal error, critical canon_path() function error, or NULL pointer used
+ *      != NULL ==> malloced canonicalized path
  *
- * NOTE: This function does not return on an internal error.
+ * NOTE: When NULL is returned:
+ *
+ *	    if sanity_p is non-NULL, then
+ *		*sanity_p will be set some value that is != PATH_OK
+ *
+ * NOTE: When a non-NULL malloced path is returned:
+ *
+ *          if sanity_p is non-NULL, then
+ *
+ *		if all was OK, then
+ *		    *sanity_p will be set to PATH_OK
+ *		else
+ *		    *sanity_p will be set to non-critical canon_path() function error code that is != PATH_OK
+ *
+ * NOTE: This function will call warn(3) on internal errors and critical canon_path() function errors.
+ *	 In doing do, it will set values (*sanity_p, *len_p, *depth_p) as needed, and then return NULL.
  */
-bool
-record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode_t st_mode,
-	    bool *is_dup_p, char const **cpath_ret)
+char const *
+canonicalize_path(struct walk_stat *wstat_p, char const *fts_path,
+		  enum path_sanity *sanity_p, size_t *len_p, int_least32_t *depth_p)
 {
-    struct walk_rule *rule_p;	    /* pointer to a walk rule */
-    struct walk_set *wset_p;	    /* pointer to a walk set */
-    struct item *i_p = NULL;	    /* allocated item */
-    struct item *dup_p = NULL;	    /* item found to be a case independent duplicate of the allocated item */
     char const *cpath = NULL;	    /* canonicalized path arg as a string */
-    enum path_sanity sanity = PATH_ERR_UNSET;	    /* canonicalize_path() error code, or PATH_OK */
+    enum path_sanity sanity = PATH_ERR_UNSET;	    /* canon_path() error code, or PATH_ERR_UNSET, or PATH_OK */
     size_t path_len = 0;	    /* canonicalized path length */
     int_least32_t deep = -1;	    /* canonicalized stack depth */
-    bool matched = false;	    /* true ==> walk rule matched */
-    bool visit_descendants = true;  /* true ==> OK to visit descendants, false ==> do NOT visit descendants */
-    int count;
 
     /*
      * firewall - catch NULL ptrs
      */
     if (wstat_p == NULL) {
-	err(54, __func__, "called with NULL wstat_p");
-	not_reached();
+
+	/* warn about internal error, update non-NULL values and return NULL */
+	warn(__func__, "called with NULL wstat_p");
+	if (sanity_p != NULL) {
+	    *sanity_p = PATH_ERR_UNSET;
+	}
+	if (len_p != NULL) {
+	    *len_p = path_len;
+	}
+	if (depth_p != NULL) {
+	    *depth_p = deep;
+	}
+	return NULL;
     }
     if (fts_path == NULL) {
-	err(55, __func__, "called with NULL fts_path");
-	not_reached();
+
+	/* warn about internal error, update non-NULL values and return NULL */
+	warn(__func__, "called with NULL fts_path");
+	if (sanity_p != NULL) {
+	    *sanity_p = PATH_ERR_PATH_IS_NULL;
+	}
+	if (len_p != NULL) {
+	    *len_p = path_len;
+	}
+	if (depth_p != NULL) {
+	    *depth_p = deep;
+	}
+	return NULL;
     }
 
     /*
@@ -2191,173 +2149,486 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      * NOTE: Passing this check means that we do not have to do as much checking elsewhere
      *       in this function.
      */
-    if (! chk_walk_stat(wstat_p)) {
-	err(56, __func__, "wstat_p failed the chk_walk_stat function test suite");
-	not_reached();
+    if (chk_walk_stat(wstat_p) == false) {
+
+	/* warn about internal error, update non-NULL values and return NULL */
+	warn(__func__, "wstat_p failed the chk_walk_stat function test suite");
+	if (sanity_p != NULL) {
+	    *sanity_p = PATH_ERR_UNSET;
+	}
+	if (len_p != NULL) {
+	    *len_p = path_len;
+	}
+	if (depth_p != NULL) {
+	    *depth_p = deep;
+	}
+	return NULL;
     }
 
     /*
      * canonicalize path
      */
     dbg(DBG_HIGH, "%s: fts_path: %s", __func__, fts_path);
-    cpath = canonicalize_path(wstat_p, fts_path, &sanity, &path_len, &deep);
-    /* paranoia */
-    if (cpath == NULL) {
-	err(57, __func__, "canonicalize_path had an internal failure and returned NULL");
-	not_reached();
-    }
-
-    /*
-     * update *cpath_ret with the canonicalized path if cpath_ret is non-NULL
-     */
-    if (cpath_ret != NULL) {
-	*cpath_ret = cpath;
-    }
+    /* IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function. */
+    cpath = canon_path(fts_path, wstat_p->max_path_len, wstat_p->max_filename_len, wstat_p->max_depth,
+		       &sanity, &path_len, &deep, true, false, true, true, NULL);
+    if (cpath == NULL || sanity != PATH_OK) {
 
-    /*
-     * check for a match with the skip_set
-     */
-    i_p = path_in_item_array(wstat_p->skip_set, cpath);
-    if (i_p != NULL) {
+	/*
+	 * process the error we encountered while trying to canonicalize the path
+	 *
+	 * In for some internal errors from the canon_path() function, we have to abort.
+	 *
+	 * In other cases we can process the original path as a "path problem".
+	 * We form a fake calloced canonicalized path so that we can later file
+	 * a "path problem".
+	 */
+	switch (sanity) {
+	case PATH_OK:
 
-	/* canonicalized path is in the skip_set, skip any further processing and just return false */
-	dbg(DBG_MED, "%s: skipping path: %s", __func__, fts_path);
-	if (cpath != NULL) {
-	    free((void *)cpath);
-	    cpath = NULL;
-	}
-	return false;
-    }
+	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
+	    warn(__func__, "invalid PATH_OK error: %s: %s", path_sanity_name(sanity), path_sanity_error(sanity));
+	    if (sanity_p != NULL) {
+		*sanity_p = PATH_ERR_UNSET;
+	    }
+	    if (len_p != NULL) {
+		*len_p = path_len;
+	    }
+	    if (depth_p != NULL) {
+		*depth_p = deep;
+	    }
+	    return NULL;
 
-    /*
-     * form an allocated item
-     */
-    i_p = alloc_item(fts_path, cpath, st_size, st_mode, deep);
+	case PATH_ERR_PATH_EMPTY:
 
-    /*
-     * check for canonicalized path duplicates
-     */
-    dup_p = path_in_walk_stat(wstat_p, cpath);
-    if (dup_p != NULL) {
+	    /* empty paths canonicalize to . (dot) */
+	    cpath = strdup(".");
+	    if (cpath == NULL) {
 
-	/*
-	 * cpath canonicalized path was found to be a case independent duplicate of another path
-	 */
-	(void) dyn_array_append_value(wstat_p->dup, &i_p);
-	(void) dyn_array_append_value(wstat_p->dup_of, &dup_p);
-	if (is_dup_p != NULL) {
-	    dbg(DBG_MED, "%s: duplicate path of: %s found: %s", __func__, dup_p->fts_path, fts_path);
-	    *is_dup_p = true;
-	}
+		/* warn about internal error, update non-NULL values and return NULL */
+		warn(__func__, "strdup of . (dot) failed");
+		if (sanity_p != NULL) {
+		    *sanity_p = PATH_ERR_MALLOC;
+		}
+		if (len_p != NULL) {
+		    *len_p = path_len;
+		}
+		if (depth_p != NULL) {
+		    *depth_p = deep;
+		}
+		return NULL;
+	    }
+	    break;
 
-    } else if (is_dup_p != NULL) {
-	dbg(DBG_V2_HIGH, "%s: not a duplicate path: %s", __func__, fts_path);
-	*is_dup_p = false;
-    }
+	case PATH_ERR_PATH_TOO_LONG:
+	case PATH_ERR_NOT_RELATIVE:
+	case PATH_ERR_NAME_TOO_LONG:
+	case PATH_ERR_PATH_TOO_DEEP:
+	case PATH_ERR_NOT_SAFE:
+	case PATH_ERR_DOTDOT_OVER_TOPDIR:
 
-    /*
-     * first, record every item in the all dynamic array
-     *
-     * NOTE: This is how free_walk_stat() will free the above allocated item.
-     */
-    (void) dyn_array_append_value(wstat_p->all, &i_p);
+	    /* just duplicate fts_path unmodified due to path problems found by canon_path() */
+	    cpath = strdup(fts_path);
+	    if (cpath == NULL) {
 
-    /*
-     * record regular files
-     */
-    if (ITEM_IS_FILE(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->file, &i_p);
-    }
+		/* warn about internal error, update non-NULL values and return NULL */
+		warn(__func__, "strdup of fts_path failed: %s", fts_path);
+		if (sanity_p != NULL) {
+		    *sanity_p = PATH_ERR_MALLOC;
+		}
+		if (len_p != NULL) {
+		    *len_p = path_len;
+		}
+		if (depth_p != NULL) {
+		    *depth_p = deep;
+		}
+		return NULL;
+	    }
+	    break;
 
-    /*
-     * record directories
-     */
-    if (ITEM_IS_DIR(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->dir, &i_p);
-    }
+	case PATH_ERR_UNSET:
+	case PATH_ERR_PATH_IS_NULL:
+	case PATH_ERR_MALLOC:
+	case PATH_ERR_NULL_COMPONENT:
+	case PATH_ERR_WRONG_LEN:
 
-    /*
-     * record symlinks
-     */
-    if (ITEM_IS_SYMLINK(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->symlink, &i_p);
-    }
+	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
+	    warn(__func__, "canon_path function reported critical error %s (%s) for: %s",
+			   path_sanity_name(sanity), path_sanity_error(sanity), fts_path);
+	    if (sanity_p != NULL) {
+		*sanity_p = sanity;
+	    }
+	    if (len_p != NULL) {
+		*len_p = path_len;
+	    }
+	    if (depth_p != NULL) {
+		*depth_p = deep;
+	    }
+	    return NULL;
 
-    /*
-     * record NOT regular files
-     */
-    if (ITEM_IS_NOT_FILE(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_file, &i_p);
+	default:
+
+	    /* warn about critical canon_path() function error, update non-NULL values and return NULL */
+	    warn(__func__, "canon_path function set an unknown sanity value: %d for: %s", sanity, fts_path);
+	    if (sanity_p != NULL) {
+		*sanity_p = PATH_ERR_UNSET;
+	    }
+	    if (len_p != NULL) {
+		*len_p = path_len;
+	    }
+	    if (depth_p != NULL) {
+		*depth_p = deep;
+	    }
+	    return NULL;
+	}
     }
 
     /*
-     * record NOT directories
+     * paranoia - cpath CANNOT be NULL at this point
      */
-    if (ITEM_IS_NOT_DIR(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_dir, &i_p);
+    if (cpath == NULL) {
+
+	/* report critical canon_path() function error */
+	warn(__func__, "cpath was NULL after the canon_path function processed: %s", fts_path);
+	if (sanity_p != NULL) {
+	    *sanity_p = PATH_ERR_PATH_IS_NULL;
+	}
+	if (len_p != NULL) {
+	    *len_p = path_len;
+	}
+	if (depth_p != NULL) {
+	    *depth_p = deep;
+	}
+	return NULL;
     }
 
     /*
-     * record NOT symlinks
+     * fill in return stats as required
      */
-    if (ITEM_IS_NOT_SYMLINK(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_symlink, &i_p);
+    if (sanity_p != NULL) {
+        *sanity_p = sanity;
+    }
+    if (len_p != NULL) {
+        *len_p = path_len;
+    }
+    if (depth_p != NULL) {
+        *depth_p = deep;
     }
 
     /*
-     * record file and directory
+     * return canonicalized path
      */
-    if (ITEM_IS_FILEDIR(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->filedir, &i_p);
-    }
+    return cpath;
+}
+
+
+/*
+ * skip_add - add a canonicalized path to skip_set dynamic array
+ *
+ * For a given struct walk_stat, add canonicalized fts_path as an pointer to as
+ * "fake" struct item to wstat_p->skip_set.  By "fake", the st_size and st_mode
+ * will be set to 0.
+ *
+ * The skip_set dynamic array is used to skip record_step() processing for certain selected paths.
+ * For more information about how the skip_set dynamic array is used,
+ * see the comments in the record_step() function below.
+ *
+ * given:
+ *	wstat_p	    pointer to a struct walk_stat
+ *	fts_path    "root path" from topdir of the item
+ *
+ * returns:
+ *	true ==> canonicalized fts_path was added to the skip_set dynamic array
+ *	false ==> canonicalized fts_path was already in the skip_set dynamic array
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+bool
+skip_add(struct walk_stat *wstat_p, char const *fts_path)
+{
+    char const *cpath = NULL;	    /* canonicalized path arg as a string */
+    int_least32_t deep = -1;	    /* canonicalized stack depth */
+    struct item *i_p = NULL;	    /* allocated item */
 
     /*
-     * record file and symlink
+     * firewall - catch NULL ptrs
      */
-    if (ITEM_IS_FILESYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->filesym, &i_p);
+    if (wstat_p == NULL) {
+	err(50, __func__, "called with NULL wstat_p");
+	not_reached();
+    }
+    if (fts_path == NULL) {
+	err(51, __func__, "called with NULL fts_path");
+	not_reached();
     }
 
     /*
-     * record directory and symlink
+     * if walk_stat check fails, abort
+     *
+     * NOTE: Passing this check means that we do not have to do as much checking elsewhere
+     *       in this function.
      */
-    if (ITEM_IS_DIRSYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->dirsym, &i_p);
+    if (! chk_walk_stat(wstat_p)) {
+	err(52, __func__, "wstat_p failed the chk_walk_stat function test suite");
+	not_reached();
     }
 
     /*
-     * record file, directory and symlink
+     * canonicalize path
      */
-    if (ITEM_IS_FILEDIRSYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->filedirsym, &i_p);
+    dbg(DBG_MED, "%s: fts_path: %s", __func__, fts_path);
+    cpath = canonicalize_path(wstat_p, fts_path, NULL, NULL, &deep);
+    /* paranoia */
+    if (cpath == NULL) {
+	err(53, __func__, "canonicalize_path had an internal failure and returned NULL");
+	not_reached();
     }
 
     /*
-     * record file and directory
+     * see if canonicalized path is already in the skip_set dynamic array
      */
-    if (ITEM_IS_NOT_FILEDIR(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_filedir, &i_p);
+    i_p = find_in_index(&wstat_p->skip_index, cpath, 0);
+    if (i_p != NULL) {
+	dbg(DBG_MED, "%s: fts_path already in skip_set: %s", __func__, fts_path);
+	free((void *)cpath);
+	cpath = NULL;
+	return false;
     }
 
     /*
-     * record file and symlink
+     * form an allocated item
+     *
+     * NOTE: alloc_item() copies cpath into the walk_stat arena.
      */
-    if (ITEM_IS_NOT_FILESYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_filesym, &i_p);
-    }
+    i_p = alloc_item(wstat_p, fts_path, cpath, 0, 0, deep);
+    (void) dyn_array_append_value(wstat_p->skip_set, &i_p);
+    index_item(&wstat_p->skip_index, i_p);
+    free((void *)cpath);
+    cpath = NULL;
 
     /*
-     * record directory and symlink
+     * canonicalized fts_path added to skip_set
      */
-    if (ITEM_IS_NOT_DIRSYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_dirsym, &i_p);
+    dbg(DBG_LOW, "%s: fts_path added to skip_set: %s", __func__, fts_path);
+    return true;
+}
+
+
+/*
+ * record_step - record an item in a struct walk_stat
+ *
+ * Record the step of a walk, given the original path.  We attempt to canonicalize the path.
+ * If the path was successfully canonicalized, process the result.  If the path could
+ * not be canonicalized, record the problem accordingly.
+ *
+ * This function WILL always:
+ *
+ *	- err(3) WILL be called if wstat_p is NULL
+ *	- err(3) WILL be called if fts_path is NULL
+ *	- err(3) WILL be called if chk_walk_stat(wstat_p) returns false
+ *	- canonicalize_path() WILL be called to canonicalized the fts_path
+ *
+ *	  NOTE: using length and depth restrictions that were set when init_walk_stat() was called
+ *
+ *	- fts_path will be checked if it is a duplicate under wstat_p->all
+ *	- If is_dup_p is non-NULL, *is_dup_p will be set
+ *
+ *	  NOTE: *is_dup_p set according to if canonicalized was already recorded in struct walk_stat or not
+ *
+ *	- if cpath_ret is non-NULL, *cpath_ret WILL be set to canonicalized path of fts_path
+ *
+ * If a path in the skip_set dynamic array of canonicalized paths matches the canonicalized path of fts_path:
+ *
+ *	- ALL of the "This function WILL always" actions WILL be performed
+ *
+ *	- path will NOT be added to ANY struct walk_stat dynamic array
+ *	- path will NOT be added to the all dynamic array
+ *	- path will NOT be added to the prune dynamic array
+ *
+ *	- wstat_p->walking will NOT be modified
+ *	- wstat_p->steps will NOT be modified
+ *
+ *	- return false
+ *
+ * given:
+ *	wstat_p	    pointer to a struct walk_stat
+ *	fts_path    "root path" from topdir of the item
+ *	st_size	    size, in bytes in the form used by stat(2)
+ *	st_mode	    inode protection mode in the form used by stat(2)
+ *
+ *	is_dup_p    != NULL ==> set *is_dup_p according to if canonicalized was already recorded in struct walk_stat
+ *		    NULL ==> do not check for duplicates
+ *	cpath_ret   != NULL ==> update with pointer to the canonical path (the caller must free it)
+ *		    NULL ==> ignore (the canonical path is freed)
+ *	skip_set   != NULL ==> dynamic_array of canonicalized paths from topdir to ignore
+ *		    NULL ==> ignore
+ *
+ * returns:
+ *	true ==> fts_path is to be processed: if walking a hierarchy, any descendants should be visited
+ *	false ==> if walking a hierarchy prune walk below fts_path: do NOT visit descendants of fts_path
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+bool
+record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode_t st_mode,
+	    bool *is_dup_p, char const **cpath_ret)
+{
+    struct walk_rule *rule_p;	    /* pointer to a walk rule */
+    struct walk_set *wset_p;	    /* pointer to a walk set */
+    struct item *i_p = NULL;	    /* allocated item */
+    struct item *dup_p = NULL;	    /* item found to be a case independent duplicate of the allocated item */
+    char const *cpath = NULL;	    /* canonicalized path arg as a string */
+    enum path_sanity sanity = PATH_ERR_UNSET;	    /* canonicalize_path() error code, or PATH_OK */
+    size_t path_len = 0;	    /* canonicalized path length */
+    int_least32_t deep = -1;	    /* canonicalized stack depth */
+    bool visit_descendants = true;  /* true ==> OK to visit descendants, false ==> do NOT visit descendants */
+    uint64_t cats = 0;		    /* WALK_BIT() of each category of the item */
+    int count;
+
+    /*
+     * firewall - catch NULL ptrs
+     */
+    if (wstat_p == NULL) {
+	err(54, __func__, "called with NULL wstat_p");
+	not_reached();
+    }
+    if (fts_path == NULL) {
+	err(55, __func__, "called with NULL fts_path");
+	not_reached();
+    }
+
+    /*
+     * if walk_stat check fails, abort
+     *
+     * NOTE: Passing this check means that we do not have to do as much checking elsewhere
+     *       in this function.
+     */
+    if (! chk_walk_stat(wstat_p)) {
+	err(56, __func__, "wstat_p failed the chk_walk_stat function test suite");
+	not_reached();
+    }
+
+    /*
+     * canonicalize path
+     */
+    dbg(DBG_HIGH, "%s: fts_path: %s", __func__, fts_path);
+    cpath = canonicalize_path(wstat_p, fts_path, &sanity, &path_len, &deep);
+    /* paranoia */
+    if (cpath == NULL) {
+	err(57, __func__, "canonicalize_path had an internal failure and returned NULL");
+	not_reached();
+    }
+
+    /*
+     * update *cpath_ret with the canonicalized path if cpath_ret is non-NULL
+     */
+    if (cpath_ret != NULL) {
+	*cpath_ret = cpath;
+    }
+
+    /*
+     * check for a match with the skip_set
+     */
+    i_p = find_in_index(&wstat_p->skip_index, cpath, 0);
+    if (i_p != NULL) {
+
+	/* canonicalized path is in the skip_set, skip any further processing and just return false */
+	dbg(DBG_MED, "%s: skipping path: %s", __func__, fts_path);
+	if (cpath != NULL) {
+	    free((void *)cpath);
+	    cpath = NULL;
+	}
+	return false;
+    }
+
+    /*
+     * form an allocated item
+     */
+    i_p = alloc_item(wstat_p, fts_path, cpath, st_size, st_mode, deep);
+
+    /*
+     * check for canonicalized path duplicates
+     */
+    dup_p = path_in_walk_stat(wstat_p, cpath);
+    if (dup_p != NULL) {
+
+	/*
+	 * cpath canonicalized path was found to be a case independent duplicate of another path
+	 */
+	(void) dyn_array_append_value(wstat_p->dup, &i_p);
+	(void) dyn_array_append_value(wstat_p->dup_of, &dup_p);
+	if (is_dup_p != NULL) {
+	    dbg(DBG_MED, "%s: duplicate path of: %s found: %s", __func__, dup_p->fts_path, fts_path);
+	    *is_dup_p = true;
+	}
+
+    } else if (is_dup_p != NULL) {
+	dbg(DBG_V2_HIGH, "%s: not a duplicate path: %s", __func__, fts_path);
+	*is_dup_p = false;
     }
 
     /*
-     * record file, directory and symlink
+     * the item has its own copy of cpath: free cpath unless it was returned via cpath_ret
+     */
+    if (cpath_ret == NULL) {
+	free((void *)cpath);
+	cpath = NULL;
+    }
+
+    /*
+     * first, record every item in the all dynamic array
+     *
+     * NOTE: Every category of the item is a bit in i_p->walk_cats: the dynamic array
+     *	     of a category is formed from the all dynamic array by walk_view().
+     */
+    (void) dyn_array_append_value(wstat_p->all, &i_p);
+    ++wstat_p->all_gen;
+    index_item(&wstat_p->all_index, i_p);
+
+    /*
+     * record regular files, directories and symlinks and their combinations
      */
+    if (ITEM_IS_FILE(st_mode)) {
+	cats |= WALK_BIT(WALK_FILE);
+    }
+    if (ITEM_IS_DIR(st_mode)) {
+	cats |= WALK_BIT(WALK_DIR);
+    }
+    if (ITEM_IS_SYMLINK(st_mode)) {
+	cats |= WALK_BIT(WALK_SYMLINK);
+    }
+    if (ITEM_IS_NOT_FILE(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_FILE);
+    }
+    if (ITEM_IS_NOT_DIR(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_DIR);
+    }
+    if (ITEM_IS_NOT_SYMLINK(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_SYMLINK);
+    }
+    if (ITEM_IS_FILEDIR(st_mode)) {
+	cats |= WALK_BIT(WALK_FILEDIR);
+    }
+    if (ITEM_IS_FILESYM(st_mode)) {
+	cats |= WALK_BIT(WALK_FILESYM);
+    }
+    if (ITEM_IS_DIRSYM(st_mode)) {
+	cats |= WALK_BIT(WALK_DIRSYM);
+    }
+    if (ITEM_IS_FILEDIRSYM(st_mode)) {
+	cats |= WALK_BIT(WALK_FILEDIRSYM);
+    }
+    if (ITEM_IS_NOT_FILEDIR(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_FILEDIR);
+    }
+    if (ITEM_IS_NOT_FILESYM(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_FILESYM);
+    }
+    if (ITEM_IS_NOT_DIRSYM(st_mode)) {
+	cats |= WALK_BIT(WALK_NOT_DIRSYM);
+    }
     if (ITEM_IS_NOT_FILEDIRSYM(st_mode)) {
-	(void) dyn_array_append_value(wstat_p->not_filedirsym, &i_p);
+	cats |= WALK_BIT(WALK_NOT_FILEDIRSYM);
     }
 
     /*
@@ -2366,34 +2637,34 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
     if (deep == 0) {
         /* We include the shallow vs too_deep check in case max_depth < 0 */
 	if (sanity == PATH_ERR_PATH_TOO_DEEP || (wstat_p->max_depth > 0 && deep > wstat_p->max_depth)) {
-	    (void) dyn_array_append_value(wstat_p->too_deep, &i_p);
+	    cats |= WALK_BIT(WALK_TOO_DEEP);
 	    dbg(DBG_HIGH, "too deep #0: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
 	    visit_descendants = false;
 	} else {
-	    (void) dyn_array_append_value(wstat_p->shallow, &i_p);
+	    cats |= WALK_BIT(WALK_SHALLOW);
 	}
-	(void) dyn_array_append_value(wstat_p->top, &i_p);
+	cats |= WALK_BIT(WALK_TOP);
 
     /*
      * record below top level
      */
     } else if (deep > 0) {
 	if (sanity == PATH_ERR_PATH_TOO_DEEP || (wstat_p->max_depth > 0 && deep > wstat_p->max_depth)) {
-	    (void) dyn_array_append_value(wstat_p->too_deep, &i_p);
+	    cats |= WALK_BIT(WALK_TOO_DEEP);
 	    dbg(DBG_HIGH, "too deep #1: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
 	    visit_descendants = false;
 	} else {
-	    (void) dyn_array_append_value(wstat_p->shallow, &i_p);
+	    cats |= WALK_BIT(WALK_SHALLOW);
 	}
-	(void) dyn_array_append_value(wstat_p->below, &i_p);
+	cats |= WALK_BIT(WALK_BELOW);
 
     /*
      * record unknown level or above topdir
      */
     } else {
-	(void) dyn_array_append_value(wstat_p->unknown_level, &i_p);
+	cats |= WALK_BIT(WALK_UNKNOWN_LEVEL);
     }
-    (void) dyn_array_append_value(wstat_p->any_level, &i_p);
+    cats |= WALK_BIT(WALK_ANY_LEVEL);
 
     /*
      * record that we have stepped
@@ -2402,33 +2673,28 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
     wstat_p->walking = true;	/* note that we are walking */
 
     /*
-     * scan each rule until we find a match
+     * find the first rule that matches
      */
     wset_p = wstat_p->set;
-    rule_p = wset_p->rule;
-    for (count = 0; rule_p->pattern != NULL; ++rule_p, ++count) {
+    count = match_walk_set(wset_p, i_p);
+    if (count >= 0) {
 
 	/*
-	 * try to match
+	 * record that this rule has been matched
+	 *
+	 * This is especially important for rules that are required
+	 * because any required rule that was NOT matched by at
+	 * least 1 item is an error.
 	 */
-	matched = match_walk_rule(rule_p, i_p, count);
-	if (matched) {
-
-	    /*
-	     * record that this rule has been matched
-	     *
-	     * This is especially important for rules that are required
-	     * because any required rule that was NOT matched by at
-	     * least 1 item is an error.
-	     */
-	    ++rule_p->match_count;
-	    dbg(DBG_V1_HIGH, "%s: rule[%d]: %s matched item fts_path: %s fts_name: %s",
-			    __func__, count, rule_p->pattern, i_p->fts_path, i_p->fts_name);
-	    dbg(DBG_V1_HIGH, "%s: item fts_level: %d st_size: %lld st_mode: %07o (%s)",
-			    __func__, i_p->fts_level, (long long)i_p->st_size,
-			    (int)i_p->st_mode, file_type_name(i_p->st_mode));
-	    break;
-	}
+	rule_p = &wset_p->rule[count];
+	++rule_p->match_count;
+	dbg(DBG_V1_HIGH, "%s: rule[%d]: %s matched item fts_path: %s fts_name: %s",
+			__func__, count, rule_p->pattern, i_p->fts_path, i_p->fts_name);
+	dbg(DBG_V1_HIGH, "%s: item fts_level: %d st_size: %lld st_mode: %07o (%s)",
+			__func__, i_p->fts_level, (long long)i_p->st_size,
+			(int)i_p->st_mode, file_type_name(i_p->st_mode));
+    } else {
+	rule_p = &wset_p->rule[wset_p->count];
     }
 
     /*
@@ -2446,7 +2712,7 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
     if (rule_p->pattern == NULL) {
 
 	/*
-	 * append to unmatched
+	 * record as unmatched
 	 *
 	 * Normally we should not get here because the 2nd to last pattern
          * should be something of the form:
@@ -2456,7 +2722,8 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
 	 *	    MATCH_ANY, TYPE_ANY, LEVEL_ANY,
 	 *	    0, NULL },
 	 */
-	(void) dyn_array_append_value(wstat_p->unmatched, &i_p);
+	cats |= WALK_BIT(WALK_UNMATCHED);
+	record_cats(wstat_p, i_p, cats);
 
 	/*
 	 * report not pruning
@@ -2478,18 +2745,18 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      * record according to walk_rule required boolean
      */
     if (rule_p->required) {
-	(void) dyn_array_append_value(wstat_p->required, &i_p);
+	cats |= WALK_BIT(WALK_REQUIRED);
     } else {
-	(void) dyn_array_append_value(wstat_p->optional, &i_p);
+	cats |= WALK_BIT(WALK_OPTIONAL);
     }
 
     /*
      * record according to walk_rule non_empty boolean
      */
     if (rule_p->non_empty) {
-	(void) dyn_array_append_value(wstat_p->non_empty, &i_p);
+	cats |= WALK_BIT(WALK_NON_EMPTY);
     } else {
-	(void) dyn_array_append_value(wstat_p->empty, &i_p);
+	cats |= WALK_BIT(WALK_EMPTY);
     }
 
     /*
@@ -2499,20 +2766,20 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      * also count according to if the item is a file or a directory or otherwise.
      */
     if (rule_p->free) {
-	(void) dyn_array_append_value(wstat_p->free, &i_p);
+	cats |= WALK_BIT(WALK_FREE);
     } else {
-	(void) dyn_array_append_value(wstat_p->counted, &i_p);
+	cats |= WALK_BIT(WALK_COUNTED);
 	if (ITEM_IS_FILE(st_mode)) {
-	    (void) dyn_array_append_value(wstat_p->counted_file, &i_p);
+	    cats |= WALK_BIT(WALK_COUNTED_FILE);
 	}
 	if (ITEM_IS_DIR(st_mode)) {
-	    (void) dyn_array_append_value(wstat_p->counted_dir, &i_p);
+	    cats |= WALK_BIT(WALK_COUNTED_DIR);
 	}
 	if (ITEM_IS_SYMLINK(st_mode)) {
-	    (void) dyn_array_append_value(wstat_p->counted_sym, &i_p);
+	    cats |= WALK_BIT(WALK_COUNTED_SYM);
 	}
 	if (ITEM_IS_NOT_FILEDIRSYM(st_mode)) {
-	    (void) dyn_array_append_value(wstat_p->counted_other, &i_p);
+	    cats |= WALK_BIT(WALK_COUNTED_OTHER);
 	}
     }
 
@@ -2520,22 +2787,22 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      * record according to walk_rule prohibit boolean
      */
     if (rule_p->prohibit) {
-	(void) dyn_array_append_value(wstat_p->prohibit, &i_p);
+	cats |= WALK_BIT(WALK_PROHIBIT);
 	dbg(DBG_HIGH, "prohibit: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
 	visit_descendants = false;
     } else {
-	(void) dyn_array_append_value(wstat_p->not_prohibit, &i_p);
+	cats |= WALK_BIT(WALK_NOT_PROHIBIT);
     }
 
     /*
      * record according to walk_rule ignore boolean
      */
     if (rule_p->ignore) {
-	(void) dyn_array_append_value(wstat_p->ignore, &i_p);
+	cats |= WALK_BIT(WALK_IGNORE);
 	dbg(DBG_HIGH, "ignore: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
 	visit_descendants = false;
     } else {
-	(void) dyn_array_append_value(wstat_p->not_ignore, &i_p);
+	cats |= WALK_BIT(WALK_NOT_IGNORE);
     }
 
     /*
@@ -2543,31 +2810,31 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      */
     switch (sanity) {
     case PATH_OK:
-	(void) dyn_array_append_value(wstat_p->safe, &i_p);
+	cats |= WALK_BIT(WALK_SAFE);
 	break;
 
     case PATH_ERR_DOTDOT_OVER_TOPDIR:
     case PATH_ERR_NOT_SAFE:
 	dbg(DBG_HIGH, "not safe: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
-	(void) dyn_array_append_value(wstat_p->unsafe, &i_p);
+	cats |= WALK_BIT(WALK_UNSAFE);
 	visit_descendants = false;
 	break;
 
     case PATH_ERR_NOT_RELATIVE:
 	dbg(DBG_HIGH, "absolute path: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
-	(void) dyn_array_append_value(wstat_p->abs, &i_p);
+	cats |= WALK_BIT(WALK_ABS);
 	visit_descendants = false;
 	break;
 
     case PATH_ERR_PATH_TOO_LONG:
 	dbg(DBG_HIGH, "path too long: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
-	(void) dyn_array_append_value(wstat_p->too_long_path, &i_p);
+	cats |= WALK_BIT(WALK_TOO_LONG_PATH);
 	visit_descendants = false;
 	break;
 
     case PATH_ERR_NAME_TOO_LONG:
 	dbg(DBG_HIGH, "path with a too long element: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
-	(void) dyn_array_append_value(wstat_p->too_long_name, &i_p);
+	cats |= WALK_BIT(WALK_TOO_LONG_NAME);
 	visit_descendants = false;
 	break;
 
@@ -2579,13 +2846,14 @@ record_step(struct walk_stat *wstat_p, char const *fts_path, off_t st_size, mode
      * informing the calling application if it should ignore this item or not
      */
     if (visit_descendants) {
-	(void) dyn_array_append_value(wstat_p->visit, &i_p);
+	cats |= WALK_BIT(WALK_VISIT);
 	dbg(DBG_MED, "process: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
     } else {
-	(void) dyn_array_append_value(wstat_p->prune, &i_p);
+	cats |= WALK_BIT(WALK_PRUNE);
 	wstat_p->skip = true;	/* note that we skipped something */
 	dbg(DBG_MED, "prune and process: fts_path: %s fts_name: %s", i_p->fts_path, i_p->fts_name);
     }
+    record_cats(wstat_p, i_p, cats);
     return visit_descendants;
 }
 
@@ -2672,6 +2940,7 @@ void
 fprintf_walk_stat(FILE *stream, struct walk_stat *wstat_p)
 {
     struct walk_set *wset_p;	    /* pointer to a walk set */
+    enum walk_cat cat;		    /* category of items to print */
 
     /*
      * firewall - catch NULL ptrs
@@ -2740,81 +3009,21 @@ fprintf_walk_stat(FILE *stream, struct walk_stat *wstat_p)
     fprintf_dyn_array_item(stream, "skip_set", wstat_p->skip_set);
 
     /*
-     * items by type
-     */
-    fprintf_dyn_array_item(stream, "file", wstat_p->file);
-    fprintf_dyn_array_item(stream, "dir", wstat_p->dir);
-    fprintf_dyn_array_item(stream, "symlink", wstat_p->symlink);
-    /**/
-    fprintf_dyn_array_item(stream, "not_file", wstat_p->not_file);
-    fprintf_dyn_array_item(stream, "not_dir", wstat_p->not_dir);
-    fprintf_dyn_array_item(stream, "not_symlink", wstat_p->not_symlink);
-    /**/
-    fprintf_dyn_array_item(stream, "filedir", wstat_p->filedir);
-    fprintf_dyn_array_item(stream, "filesym", wstat_p->filesym);
-    fprintf_dyn_array_item(stream, "dirsym", wstat_p->dirsym);
-    fprintf_dyn_array_item(stream, "filedirsym", wstat_p->filedirsym);
-    /**/
-    fprintf_dyn_array_item(stream, "not_filedir", wstat_p->not_filedir);
-    fprintf_dyn_array_item(stream, "not_filesym", wstat_p->not_filesym);
-    fprintf_dyn_array_item(stream, "not_dirsym", wstat_p->not_dirsym);
-    fprintf_dyn_array_item(stream, "not_filedirsym", wstat_p->not_filedirsym);
-
-    /*
-     * items by level
-     */
-    fprintf_dyn_array_item(stream, "top", wstat_p->top);
-    fprintf_dyn_array_item(stream, "shallow", wstat_p->shallow);
-    fprintf_dyn_array_item(stream, "too_deep", wstat_p->too_deep);
-    fprintf_dyn_array_item(stream, "below", wstat_p->below);
-    /**/
-    fprintf_dyn_array_item(stream, "any_level", wstat_p->any_level);
-    fprintf_dyn_array_item(stream, "unknown_level", wstat_p->unknown_level);
-
-    /*
-     * items by walk_rule
-     */
-    fprintf_dyn_array_item(stream, "required", wstat_p->required);
-    fprintf_dyn_array_item(stream, "optional", wstat_p->optional);
-    /**/
-    fprintf_dyn_array_item(stream, "non_empty", wstat_p->non_empty);
-    fprintf_dyn_array_item(stream, "empty", wstat_p->empty);
-    /**/
-    fprintf_dyn_array_item(stream, "free", wstat_p->free);
-    fprintf_dyn_array_item(stream, "counted", wstat_p->counted);
-    /**/
-    fprintf_dyn_array_item(stream, "counted_file", wstat_p->counted_file);
-    fprintf_dyn_array_item(stream, "counted_dir", wstat_p->counted_dir);
-    fprintf_dyn_array_item(stream, "counted_sym", wstat_p->counted_sym);
-    fprintf_dyn_array_item(stream, "counted_other", wstat_p->counted_other);
-    /**/
-    fprintf_dyn_array_item(stream, "ignore", wstat_p->ignore);
-    fprintf_dyn_array_item(stream, "not_ignore", wstat_p->not_ignore);
-    /**/
-    fprintf_dyn_array_item(stream, "prohibit", wstat_p->prohibit);
-    fprintf_dyn_array_item(stream, "not_prohibit", wstat_p->not_prohibit);
-    /**/
-    fprintf_dyn_array_item(stream, "unmatched", wstat_p->unmatched);
-
-    /*
-     * items by level
+     * items by type, by level, by walk_rule and by path problem
      */
-    fprintf_dyn_array_item(stream, "unsafe", wstat_p->unsafe);
-    fprintf_dyn_array_item(stream, "absolute", wstat_p->abs);
-    fprintf_dyn_array_item(stream, "too_long_path", wstat_p->too_long_path);
-    fprintf_dyn_array_item(stream, "too_long_name", wstat_p->too_long_name);
+    for (cat = 0; cat <= WALK_TOO_LONG_NAME; ++cat) {
+	fprintf_dyn_array_item(stream, walk_cat_names[cat], walk_view(wstat_p, cat));
+    }
     /**/
     fprintf_dyn_array_item(stream, "dup", wstat_p->dup);
     fprintf_dyn_array_item(stream, "dup_of", wstat_p->dup_of);
-    /**/
-    fprintf_dyn_array_item(stream, "fts_err", wstat_p->fts_err);
-    fprintf_dyn_array_item(stream, "safe", wstat_p->safe);
 
     /*
-     * items by descendant state
+     * items by fts(3) error and by descendant state
      */
-    fprintf_dyn_array_item(stream, "visit", wstat_p->visit);
-    fprintf_dyn_array_item(stream, "prune", wstat_p->prune);
+    for (cat = WALK_FTS_ERR; cat < WALK_CAT_COUNT; ++cat) {
+	fprintf_dyn_array_item(stream, walk_cat_names[cat], walk_view(wstat_p, cat));
+    }
 
     /*
      * all items
@@ -3287,87 +3496,15 @@ sort_walk_stat(struct walk_stat *wstat_p)
 	not_reached();
     }
 
-    /*
-     * sort by canonicalized paths, items by type - See enum allowed_type
-     */
-    dyn_array_qsort(wstat_p->file, item_cmp);
-    dyn_array_qsort(wstat_p->dir, item_cmp);
-    dyn_array_qsort(wstat_p->symlink, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->not_file, item_cmp);
-    dyn_array_qsort(wstat_p->not_dir, item_cmp);
-    dyn_array_qsort(wstat_p->not_symlink, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->filedir, item_cmp);
-    dyn_array_qsort(wstat_p->filesym, item_cmp);
-    dyn_array_qsort(wstat_p->dirsym, item_cmp);
-    dyn_array_qsort(wstat_p->filedirsym, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->not_filedir, item_cmp);
-    dyn_array_qsort(wstat_p->not_filesym, item_cmp);
-    dyn_array_qsort(wstat_p->not_dirsym, item_cmp);
-    dyn_array_qsort(wstat_p->not_filedirsym, item_cmp);
-
-    /*
-     * sort by canonicalized paths, items by level - See enum level
-     */
-    dyn_array_qsort(wstat_p->top, item_cmp);
-    dyn_array_qsort(wstat_p->shallow, item_cmp);
-    dyn_array_qsort(wstat_p->too_deep, item_cmp);
-    dyn_array_qsort(wstat_p->below, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->any_level, item_cmp);
-    dyn_array_qsort(wstat_p->unknown_level, item_cmp);
-
-    /*
-     * sort by canonicalized paths, items by walk_rule - see booleans in struct walk_rule
-     */
-    dyn_array_qsort(wstat_p->required, item_cmp);
-    dyn_array_qsort(wstat_p->optional, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->non_empty, item_cmp);
-    dyn_array_qsort(wstat_p->empty, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->free, item_cmp);
-    dyn_array_qsort(wstat_p->counted, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->counted_file, item_cmp);
-    dyn_array_qsort(wstat_p->counted_dir, item_cmp);
-    dyn_array_qsort(wstat_p->counted_sym, item_cmp);
-    dyn_array_qsort(wstat_p->counted_other, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->ignore, item_cmp);
-    dyn_array_qsort(wstat_p->not_ignore, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->prohibit, item_cmp);
-    dyn_array_qsort(wstat_p->not_prohibit, item_cmp);
-    /**/
-    dyn_array_qsort(wstat_p->unmatched, item_cmp);
-
-    /*
-     * sort by path problem
-     */
-    dyn_array_qsort(wstat_p->unsafe, item_cmp);
-    dyn_array_qsort(wstat_p->abs, item_cmp);
-    dyn_array_qsort(wstat_p->too_long_path, item_cmp);
-    dyn_array_qsort(wstat_p->too_long_path, item_cmp);
-    /**/
-    /* NOTE: We do NOT sort dup: dyn_array_qsort(wstat_p->dup, item_cmp); */
-    /* NOTE: We do NOT sort dup_of: dyn_array_qsort(wstat_p->dup_of, item_cmp); */
-    /**/
-    dyn_array_qsort(wstat_p->fts_err, item_cmp);
-    dyn_array_qsort(wstat_p->safe, item_cmp);
-
-    /*
-     * sort by descendant state
-     */
-    dyn_array_qsort(wstat_p->visit, item_cmp);
-    dyn_array_qsort(wstat_p->prune, item_cmp);
-
     /*
      * sort by canonicalized paths, all items
+     *
+     * NOTE: The dynamic array of each category is formed by walk_view() in the
+     *	     order of the all dynamic array, so sorting all sorts every category.
+     *	     We do NOT sort dup nor dup_of.
      */
     dyn_array_qsort(wstat_p->all, item_cmp);
+    ++wstat_p->all_gen;
     return;
 }
 
@@ -3405,88 +3542,16 @@ sort_walk_istat(struct walk_stat *wstat_p)
     }
 
     /*
-     * sort by canonicalized paths, items by type - See enum allowed_type
+     * sort by canonicalized paths, all items
+     *
+     * NOTE: The dynamic array of each category is formed by walk_view() in the
+     *	     order of the all dynamic array, so sorting all sorts every category.
+     *	     We do NOT sort dup nor dup_of.
      */
-    dyn_array_qsort(wstat_p->file, item_icmp);
-    dyn_array_qsort(wstat_p->dir, item_icmp);
-    dyn_array_qsort(wstat_p->symlink, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->not_file, item_icmp);
-    dyn_array_qsort(wstat_p->not_dir, item_icmp);
-    dyn_array_qsort(wstat_p->not_symlink, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->filedir, item_icmp);
-    dyn_array_qsort(wstat_p->filesym, item_icmp);
-    dyn_array_qsort(wstat_p->dirsym, item_icmp);
-    dyn_array_qsort(wstat_p->filedirsym, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->not_filedir, item_icmp);
-    dyn_array_qsort(wstat_p->not_filesym, item_icmp);
-    dyn_array_qsort(wstat_p->not_dirsym, item_icmp);
-    dyn_array_qsort(wstat_p->not_filedirsym, item_icmp);
-
-    /*
-     * sort by canonicalized paths, items by level - See enum level
-     */
-    dyn_array_qsort(wstat_p->top, item_icmp);
-    dyn_array_qsort(wstat_p->shallow, item_icmp);
-    dyn_array_qsort(wstat_p->too_deep, item_icmp);
-    dyn_array_qsort(wstat_p->below, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->any_level, item_icmp);
-    dyn_array_qsort(wstat_p->unknown_level, item_icmp);
-
-    /*
-     * sort by canonicalized paths, items by walk_rule - see booleans in struct walk_rule
-     */
-    dyn_array_qsort(wstat_p->required, item_icmp);
-    dyn_array_qsort(wstat_p->optional, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->non_empty, item_icmp);
-    dyn_array_qsort(wstat_p->empty, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->free, item_icmp);
-    dyn_array_qsort(wstat_p->counted, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->counted_file, item_icmp);
-    dyn_array_qsort(wstat_p->counted_dir, item_icmp);
-    dyn_array_qsort(wstat_p->counted_sym, item_icmp);
-    dyn_array_qsort(wstat_p->counted_other, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->ignore, item_icmp);
-    dyn_array_qsort(wstat_p->not_ignore, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->prohibit, item_icmp);
-    dyn_array_qsort(wstat_p->not_prohibit, item_icmp);
-    /**/
-    dyn_array_qsort(wstat_p->unmatched, item_icmp);
-
-    /*
-     * sort by path problem
-     */
-    dyn_array_qsort(wstat_p->unsafe, item_icmp);
-    dyn_array_qsort(wstat_p->abs, item_icmp);
-    dyn_array_qsort(wstat_p->too_long_path, item_icmp);
-    dyn_array_qsort(wstat_p->too_long_path, item_icmp);
-    /**/
-    /* NOTE: We do NOT sort dup: dyn_array_qsort(wstat_p->dup, item_icmp); */
-    /* NOTE: We do NOT sort dup_of: dyn_array_qsort(wstat_p->dup_of, item_icmp); */
-    /**/
-    dyn_array_qsort(wstat_p->fts_err, item_icmp);
-    dyn_array_qsort(wstat_p->safe, item_icmp);
-
-    /*
-     * sort by descendant state
-     */
-    dyn_array_qsort(wstat_p->visit, item_icmp);
-    dyn_array_qsort(wstat_p->prune, item_icmp);
-
-    /*
-     * sort, by canonicalized paths, all items
-     */
-    dyn_array_qsort(wstat_p->all, item_icmp);
-    return;
-}
+    dyn_array_qsort(wstat_p->all, item_icmp);
+    ++wstat_p->all_gen;
+    return;
+}
 
 
 /*
@@ -3584,7 +3649,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for prohibited items
      */
-    prohibit_count = dyn_array_tell(wstat_p->prohibit);
+    prohibit_count = item_count(wstat_p, WALK_PROHIBIT);
     if (prohibit_count > 0) {
 
 	/* NOTE: 1 or more prohibited items found */
@@ -3600,7 +3665,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->prohibit, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_PROHIBIT), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   prohibited %s%s: %s",
 				 empty_or_not(i_p->st_size), file_type_name(i_p->st_mode), i_p->fts_path);
@@ -3616,7 +3681,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for items too deep
      */
-    too_deep_count = dyn_array_tell(wstat_p->too_deep);
+    too_deep_count = item_count(wstat_p, WALK_TOO_DEEP);
     if (too_deep_count > 0) {
 
 	/* NOTE: 1 or more items that are too deep was found */
@@ -3632,7 +3697,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->too_deep, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_TOO_DEEP), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s is too deep: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3647,7 +3712,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for unsafe paths
      */
-    unsafe_count = dyn_array_tell(wstat_p->unsafe);
+    unsafe_count = item_count(wstat_p, WALK_UNSAFE);
     if (unsafe_count > 0) {
 
 	/* NOTE: 1 or more paths that are unsafe */
@@ -3663,7 +3728,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->unsafe, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_UNSAFE), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s has an unsafe path: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3678,7 +3743,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for absolute paths
      */
-    abs_count = dyn_array_tell(wstat_p->abs);
+    abs_count = item_count(wstat_p, WALK_ABS);
     if (abs_count > 0) {
 
 	/* NOTE: 1 or more paths that are absolute (not relative) */
@@ -3694,7 +3759,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->abs, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_ABS), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s has an absolute path: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3709,7 +3774,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for paths too long
      */
-    too_long_path_count = dyn_array_tell(wstat_p->too_long_path);
+    too_long_path_count = item_count(wstat_p, WALK_TOO_LONG_PATH);
     if (too_long_path_count > 0) {
 
 	/* NOTE: 1 or more paths that are too long */
@@ -3726,7 +3791,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->too_long_path, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_TOO_LONG_PATH), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s path is too long: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3741,7 +3806,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for path with a path element too long
      */
-    too_long_name_count = dyn_array_tell(wstat_p->too_long_name);
+    too_long_name_count = item_count(wstat_p, WALK_TOO_LONG_NAME);
     if (too_long_name_count > 0) {
 
 	/* NOTE: 1 or more paths with path elements too long */
@@ -3757,7 +3822,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->too_long_name, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_TOO_LONG_NAME), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s has path element that is too long: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3772,7 +3837,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * scan for path with a item that caused an fts(3) error, e.g., cannot read dir, cannot stat(2), etc.
      */
-    fts_err_count = dyn_array_tell(wstat_p->fts_err);
+    fts_err_count = item_count(wstat_p, WALK_FTS_ERR);
     if (fts_err_count > 0) {
 
 	/* NOTE: 1 or more paths with path elements too long */
@@ -3788,7 +3853,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
 		/*
 		 * print the fts_path of the current item
 		 */
-		i_p = dyn_array_value(wstat_p->fts_err, struct item *, i);
+		i_p = dyn_array_value(walk_view(wstat_p, WALK_FTS_ERR), struct item *, i);
 		if (i_p != NULL) {
 		    fmsg(stream, "   %s causing a hierarchy traverse error: %s", file_type_name(i_p->st_mode), i_p->fts_path);
 		} else {
@@ -3803,7 +3868,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * verify we do not have too many counted (non-free) files
      */
-    counted_file_count = dyn_array_tell(wstat_p->counted_file);
+    counted_file_count = item_count(wstat_p, WALK_COUNTED_FILE);
     if (max_file > 0 && counted_file_count > max_file) {
 	if (stream != NULL) {
 	    fmsg(stream, "files: number of counted (non-free): %jd > maximum allowed counted: %d",
@@ -3820,7 +3885,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * verify we do not have too many counted (non-free) dirs
      */
-    counted_dir_count = dyn_array_tell(wstat_p->counted_dir);
+    counted_dir_count = item_count(wstat_p, WALK_COUNTED_DIR);
     if (max_dir > 0 && counted_dir_count > max_dir) {
 	if (stream != NULL) {
 	    fmsg(stream, "directories: number of counted (non-free): %jd > maximum allowed counted: %d",
@@ -3837,7 +3902,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * verify we do not have too many counted (non-free) syms
      */
-    counted_sym_count = dyn_array_tell(wstat_p->counted_sym);
+    counted_sym_count = item_count(wstat_p, WALK_COUNTED_SYM);
     if (max_sym > 0 && counted_sym_count > max_sym) {
 	if (stream != NULL) {
 	    fmsg(stream, "symlinks: number of counted (non-free): %jd > maximum allowed counted: %d",
@@ -3854,7 +3919,7 @@ chk_walk(struct walk_stat *wstat_p, FILE *stream,
     /*
      * verify we do not have too many counted (non-free) others
      */
-    counted_other_count = dyn_array_tell(wstat_p->counted_other);
+    counted_other_count = item_count(wstat_p, WALK_COUNTED_OTHER);
     if (max_other > 0 && counted_other_count > max_other) {
 	if (stream != NULL) {
 	    fmsg(stream, "non-files/dirs/symlinks: number of counted (non-free): %jd > maximum allowed counted: %d",
@@ -4118,12 +4183,8 @@ record_fts_err(struct walk_stat *wstat_p, char const *path, off_t st_size, mode_
 	err(93, __func__, "called with NULL wstat_p");
 	not_reached();
     }
-    if (wstat_p->fts_err == NULL) {
-        err(94, __func__, "called with NULL wstat_p->fts_err");
-        not_reached();
-    }
-    if (wstat_p->prune == NULL) {
-        err(95, __func__, "called with NULL wstat_p->prune");
+    if (wstat_p->arena == NULL) {
+        err(94, __func__, "called with NULL wstat_p->arena");
         not_reached();
     }
     if (wstat_p->all == NULL) {
@@ -4138,22 +4199,19 @@ record_fts_err(struct walk_stat *wstat_p, char const *path, off_t st_size, mode_
     /*
      * form an allocated item
      */
-    i_p = alloc_item(path, path, st_size, st_mode, fts_level);
+    i_p = alloc_item(wstat_p, path, path, st_size, st_mode, fts_level);
 
     /*
-     * add path to fts_err
-     */
-    (void) dyn_array_append_value(wstat_p->fts_err, &i_p);
-
-    /*
-     * add path to fts_err
+     * add path to all
      */
-    (void) dyn_array_append_value(wstat_p->prune, &i_p);
+    (void) dyn_array_append_value(wstat_p->all, &i_p);
+    ++wstat_p->all_gen;
+    index_item(&wstat_p->all_index, i_p);
 
     /*
-     * add path to all
+     * add path to fts_err and prune
      */
-    (void) dyn_array_append_value(wstat_p->all, &i_p);
+    record_cats(wstat_p, i_p, WALK_BIT(WALK_FTS_ERR) | WALK_BIT(WALK_PRUNE));
 
     /*
      * record that we have stepped
@@ -4874,45 +4932,664 @@ fts_walk(struct walk_stat *wstat_p)
 		    warnp(__func__, "fts_close() #8: failed: %d", fts_close_ret);
 		}
 
-		/* free storage and return indicating walk error */
-		if (path_set != NULL) {
-		    free(path_set);
-		    path_set = NULL;
-		}
-		return false;
-	    }
-	    break;
+		/* free storage and return indicating walk error */
+		if (path_set != NULL) {
+		    free(path_set);
+		    path_set = NULL;
+		}
+		return false;
+	    }
+	    break;
+	}
+    }
+
+    /*
+     * close the file hierarchy structure
+     */
+    errno = 0;	/* pre-clear for warnp() */
+    fts_close_ret = fts_close(ftsp);
+    if (fts_close_ret != 0) {
+
+	/* report problem on stderr, free storage and return indicating an traversing error */
+	warnp(__func__, "fts_close() failed: %d", fts_close_ret);
+	if (path_set != NULL) {
+	    free(path_set);
+	    path_set = NULL;
+	}
+	return false;
+    }
+
+    /*
+     * free storage
+     */
+    if (path_set != NULL) {
+	free(path_set);
+	path_set = NULL;
+    }
+
+    /*
+     * walk successful
+     */
+    return true;
+}
+
+
+/*
+ * walk_ent_cmp - compare walk_ent names case dependently via strcmp(3)
+ *
+ * This is the order in which fts_cmp() has fts(3) return the entries of a directory.
+ *
+ * given:
+ *	pa	pointer to 1st struct walk_ent to compare
+ *	pb	pointer to 2nd struct walk_ent to compare
+ *
+ * returns:
+ *	-1 if  a < b
+ *	0  if  a == b
+ *	1  if  a > b
+ */
+static int
+walk_ent_cmp(void const *pa, void const *pb)
+{
+    struct walk_ent const *a = (struct walk_ent const *)pa;	/* 1st entry */
+    struct walk_ent const *b = (struct walk_ent const *)pb;	/* 2nd entry */
+    int cmp = 0;						/* name comparison */
+
+    /*
+     * firewall
+     */
+    if (a == NULL || a->name == NULL) {
+	err(126, __func__, "a is NULL or a->name is NULL");
+	not_reached();
+    }
+    if (b == NULL || b->name == NULL) {
+	err(127, __func__, "b is NULL or b->name is NULL");
+	not_reached();
+    }
+
+    /*
+     * string compare names
+     *
+     * NOTE: readdir(3) never returns an empty name, so unlike fts_cmp() we need
+     *	     not sort empty names last.
+     */
+    cmp = strcmp(a->name, b->name);
+    /* convert strcmp(3) return into -1, 0, or 1 to simplify debugging */
+    cmp = ((cmp <= -1) ? -1 : ((cmp == 0) ? 0 : 1));
+
+    /* return comparison result */
+    return cmp;
+}
+
+
+/*
+ * read_walk_dir - read and stat the entries of a directory for par_walk()
+ *
+ * Each entry is stat-ed with fstatat(2) without following symlinks, just as
+ * fts(3) with FTS_PHYSICAL would do.  A struct walk_dir is allocated for each
+ * directory found that is not also one of its own ancestors.  The entries are
+ * then sorted by name.
+ *
+ * given:
+ *	pool	    - pointer to the struct walk_pool
+ *	dir_p	    - pointer to the struct walk_dir to read
+ *
+ * NOTE: This function is called by the walk_pool threads without holding the lock:
+ *	 it only modifies the struct walk_dir it is given.
+ *
+ * NOTE: A directory that cannot be opened or read is noted by dir_p->read_ok
+ *	 being false.  This function does not return on an internal error.
+ */
+static void
+read_walk_dir(struct walk_pool *pool, struct walk_dir *dir_p)
+{
+    int fd = -1;		    /* open descriptor of the directory */
+    DIR *dirp = NULL;		    /* directory stream */
+    struct dirent *dp = NULL;	    /* directory entry */
+    struct stat st;		    /* fstatat(2) of an entry */
+    struct walk_ent *e_p = NULL;    /* entry being formed */
+    struct walk_dir *anc = NULL;    /* an ancestor directory */
+    struct walk_dir *sub = NULL;    /* directory found in dir_p */
+    size_t alloced = 0;		    /* number of entries allocated */
+    size_t path_len = 0;	    /* length of dir_p->path */
+    size_t name_len = 0;	    /* length of an entry name */
+
+    /*
+     * firewall
+     */
+    if (pool == NULL) {
+	err(128, __func__, "called with NULL pool");
+	not_reached();
+    }
+    if (dir_p == NULL || dir_p->path == NULL) {
+	err(129, __func__, "called with NULL dir_p or NULL dir_p->path");
+	not_reached();
+    }
+    dir_p->read_ok = false;
+
+    /*
+     * open the directory below topdir
+     *
+     * NOTE: We do not follow a symlink that has replaced the directory since it was stat-ed.
+     */
+    errno = 0;	/* pre-clear errno for dbg() */
+    fd = openat(pool->rootfd, dir_p->path[0] == '\0' ? "." : dir_p->path, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+	dbg(DBG_V1_HIGH, "%s: cannot open directory: %s: %s", __func__, dir_p->path, strerror(errno));
+	return;
+    }
+    errno = 0;	/* pre-clear errno for dbg() */
+    dirp = fdopendir(fd);
+    if (dirp == NULL) {
+	dbg(DBG_V1_HIGH, "%s: fdopendir of directory: %s failed: %s", __func__, dir_p->path, strerror(errno));
+	(void) close(fd);
+	return;
+    }
+    path_len = strlen(dir_p->path);
+
+    /*
+     * read and stat each entry
+     */
+    for (;;) {
+
+	/*
+	 * read the next entry, skipping . (dot) and .. (dot-dot)
+	 */
+	errno = 0;	/* pre-clear errno for warnp() */
+	dp = readdir(dirp);
+	if (dp == NULL) {
+	    if (errno != 0) {
+		warnp(__func__, "readdir of directory: %s failed", dir_p->path);
+	    }
+	    break;
+	}
+	if (strcmp(dp->d_name, ".") == 0 || strcmp(dp->d_name, "..") == 0) {
+	    continue;
+	}
+
+	/*
+	 * make room for another entry
+	 */
+	if (dir_p->count >= alloced) {
+	    alloced = (alloced == 0) ? DEF_CHUNK : alloced * 2;
+	    errno = 0;	/* pre-clear errno for errp() */
+	    e_p = realloc(dir_p->ent, alloced * sizeof(struct walk_ent));
+	    if (e_p == NULL) {
+		errp(130, __func__, "realloc of %zu walk_ent failed", alloced);
+		not_reached();
+	    }
+	    dir_p->ent = e_p;
+	}
+	e_p = &dir_p->ent[dir_p->count];
+	memset(e_p, 0, sizeof(*e_p));
+
+	/*
+	 * form the path of the entry below topdir
+	 */
+	name_len = strlen(dp->d_name);
+	errno = 0;	/* pre-clear errno for errp() */
+	e_p->path = malloc(path_len + 1 + name_len + 1);
+	if (e_p->path == NULL) {
+	    errp(131, __func__, "malloc of path of length %zu failed", path_len + 1 + name_len);
+	    not_reached();
+	}
+	if (path_len > 0) {
+	    memcpy(e_p->path, dir_p->path, path_len);
+	    e_p->path[path_len] = '/';
+	    memcpy(e_p->path + path_len + 1, dp->d_name, name_len + 1);
+	    e_p->name = e_p->path + path_len + 1;
+	} else {
+	    memcpy(e_p->path, dp->d_name, name_len + 1);
+	    e_p->name = e_p->path;
+	}
+	++dir_p->count;
+
+	/*
+	 * stat the entry without following a symlink
+	 */
+	if (fstatat(dirfd(dirp), dp->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+	    dbg(DBG_V1_HIGH, "%s: cannot stat: %s", __func__, e_p->path);
+	    continue;
+	}
+	e_p->stat_ok = true;
+	e_p->st_size = st.st_size;
+	e_p->st_mode = st.st_mode;
+	if (!S_ISDIR(st.st_mode)) {
+	    continue;
+	}
+
+	/*
+	 * do not read a directory that is also one of its ancestors
+	 */
+	for (anc = dir_p; anc != NULL; anc = anc->parent) {
+	    if (anc->st_dev == st.st_dev && anc->st_ino == st.st_ino) {
+		e_p->cycle = true;
+		break;
+	    }
+	}
+	if (e_p->cycle) {
+	    continue;
+	}
+
+	/*
+	 * note the directory to read
+	 */
+	errno = 0;	/* pre-clear errno for errp() */
+	sub = calloc(1, sizeof(*sub));
+	if (sub == NULL) {
+	    errp(132, __func__, "calloc of walk_dir failed");
+	    not_reached();
+	}
+	sub->path = e_p->path;
+	sub->level = dir_p->level + 1;
+	sub->st_size = st.st_size;
+	sub->st_mode = st.st_mode;
+	sub->st_dev = st.st_dev;
+	sub->st_ino = st.st_ino;
+	sub->parent = dir_p;
+	e_p->dir = sub;
+    }
+    (void) closedir(dirp);
+    dir_p->read_ok = true;
+
+    /*
+     * sort the entries as fts(3) would return them
+     */
+    if (dir_p->count > 1) {
+	qsort(dir_p->ent, dir_p->count, sizeof(struct walk_ent), walk_ent_cmp);
+    }
+    return;
+}
+
+
+/*
+ * par_walk_thread - read queued directories until the walk is over
+ *
+ * The directories found are queued so that the first one, in sorted order,
+ * is read next: that way directories tend to be read in the order that
+ * par_walk() replays them.
+ *
+ * given:
+ *	arg	    - pointer to the struct walk_pool
+ *
+ * returns:
+ *	NULL
+ */
+static void *
+par_walk_thread(void *arg)
+{
+    struct walk_pool *pool = (struct walk_pool *)arg;	/* thread pool */
+    struct walk_dir *dir_p = NULL;			/* directory to read */
+    struct walk_dir *anc = NULL;			/* an ancestor directory */
+    bool pruned = false;				/* true ==> directory or an ancestor was pruned */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (pool == NULL) {
+	err(133, __func__, "called with NULL pool");
+	not_reached();
+    }
+
+    (void) pthread_mutex_lock(&pool->lock);
+    for (;;) {
+
+	/*
+	 * wait for a directory to read, unless the walk is over
+	 *
+	 * NOTE: When the queue is empty and no thread is reading a directory,
+	 *	 no more directories will be found.
+	 */
+	while (pool->queue == NULL && pool->busy > 0 && !pool->stop) {
+	    (void) pthread_cond_wait(&pool->work, &pool->lock);
+	}
+	if (pool->queue == NULL || pool->stop) {
+	    break;
+	}
+	dir_p = pool->queue;
+	pool->queue = dir_p->next;
+	dir_p->next = NULL;
+	++pool->busy;
+
+	/*
+	 * do not read a directory below a pruned directory
+	 */
+	pruned = false;
+	for (anc = dir_p; anc != NULL; anc = anc->parent) {
+	    if (anc->pruned) {
+		pruned = true;
+		break;
+	    }
+	}
+	(void) pthread_mutex_unlock(&pool->lock);
+
+	/*
+	 * read the directory
+	 */
+	if (!pruned) {
+	    read_walk_dir(pool, dir_p);
+	}
+
+	/*
+	 * queue the directories found, first one on top
+	 */
+	(void) pthread_mutex_lock(&pool->lock);
+	for (i = dir_p->count; i > 0; --i) {
+	    if (dir_p->ent[i-1].dir != NULL) {
+		dir_p->ent[i-1].dir->next = pool->queue;
+		pool->queue = dir_p->ent[i-1].dir;
+	    }
+	}
+	dir_p->done = true;
+	--pool->busy;
+	(void) pthread_cond_broadcast(&pool->done);
+	(void) pthread_cond_broadcast(&pool->work);
+    }
+    (void) pthread_cond_broadcast(&pool->work);
+    (void) pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+
+/*
+ * replay_walk_dir - record the entries of a directory read by par_walk() threads
+ *
+ * Wait for the directory to be read, then record each entry, and the directories
+ * below it, in the order fts_walk() would have: the results of record_step() are
+ * the same as those of an fts_walk() of the same tree.
+ *
+ * given:
+ *	wstat_p	    - pointer to a struct walk_stat
+ *	pool	    - pointer to the struct walk_pool
+ *	dir_p	    - pointer to the struct walk_dir to replay
+ *
+ * return:
+ *	true ==> no errors found
+ *	false ==> topdir could not be read
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static bool
+replay_walk_dir(struct walk_stat *wstat_p, struct walk_pool *pool, struct walk_dir *dir_p)
+{
+    struct walk_ent *e_p = NULL;    /* entry being recorded */
+    bool process = false;	    /* false ==> prune walk below the path, true ==> continue to walk path */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || pool == NULL || dir_p == NULL) {
+	err(134, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * wait for the directory to be read
+     */
+    (void) pthread_mutex_lock(&pool->lock);
+    while (!dir_p->done) {
+	(void) pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    (void) pthread_mutex_unlock(&pool->lock);
+
+    /*
+     * case: directory could not be read
+     */
+    if (!dir_p->read_ok) {
+
+	/* fts_walk() ignores an unreadable topdir, however we warn about it */
+	if (dir_p->parent == NULL) {
+	    warn(__func__, "unreadable topdir: %s", wstat_p->topdir);
+	    return false;
+	}
+
+	/* record error as fts_walk() does for FTS_DNR */
+	warn(__func__, "unreadable directory for: %s/%s", wstat_p->topdir, dir_p->path);
+	record_fts_err(wstat_p, dir_p->path, dir_p->st_size, dir_p->st_mode, dir_p->level);
+	return true;
+    }
+
+    /*
+     * record each entry in sorted order
+     */
+    for (i = 0; i < dir_p->count; ++i) {
+	e_p = &dir_p->ent[i];
+
+	/* record error as fts_walk() does for FTS_NS */
+	if (!e_p->stat_ok) {
+	    warn(__func__, "stat failed for: %s/%s", wstat_p->topdir, e_p->path);
+	    record_fts_err(wstat_p, e_p->path, 0, 0, dir_p->level + 1);
+	    continue;
+	}
+
+	/* record error as fts_walk() does for FTS_DC */
+	if (e_p->cycle) {
+	    warn(__func__, "cycle causing directory for: %s/%s", wstat_p->topdir, e_p->path);
+	    record_fts_err(wstat_p, e_p->path, e_p->st_size, e_p->st_mode, dir_p->level + 1);
+	    continue;
+	}
+
+	/* record walk step with sub-path below canonicalized wstat_p->topdir */
+	dbg(DBG_V1_HIGH, "%s: path: %s size: %lld depth: %d", __func__,
+			 e_p->path, (long long)e_p->st_size, dir_p->level + 1);
+	process = record_step(wstat_p, e_p->path, e_p->st_size, e_p->st_mode, NULL, NULL);
+	if (e_p->dir == NULL) {
+	    continue;
+	}
+
+	/*
+	 * case: prune walk below the directory
+	 */
+	if (process == false) {
+	    (void) pthread_mutex_lock(&pool->lock);
+	    e_p->dir->pruned = true;
+	    (void) pthread_mutex_unlock(&pool->lock);
+
+	/*
+	 * case: walk below the directory
+	 */
+	} else {
+	    (void) replay_walk_dir(wstat_p, pool, e_p->dir);
+	}
+    }
+    return true;
+}
+
+
+/*
+ * free_walk_dir - free a struct walk_dir, the directories below it and their entries
+ *
+ * given:
+ *	dir_p	    - pointer to the struct walk_dir to free
+ */
+static void
+free_walk_dir(struct walk_dir *dir_p)
+{
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (dir_p == NULL) {
+	return;
+    }
+
+    /*
+     * free the entries and the directories below
+     */
+    for (i = 0; i < dir_p->count; ++i) {
+	free_walk_dir(dir_p->ent[i].dir);
+	dir_p->ent[i].dir = NULL;
+	if (dir_p->ent[i].path != NULL) {
+	    free(dir_p->ent[i].path);
+	    dir_p->ent[i].path = NULL;
+	}
+    }
+    if (dir_p->ent != NULL) {
+	free(dir_p->ent);
+	dir_p->ent = NULL;
+    }
+    dir_p->count = 0;
+    free(dir_p);
+    return;
+}
+
+
+/*
+ * par_walk - walk a file system tree with threads that read directories in parallel
+ *
+ * Given an initialized struct walk_stat, traverse a file system tree recording
+ * matches against the struct walk_rule array of the struct walk_set, just as
+ * fts_walk() does.  Up to jobs threads open, read and stat directories with
+ * openat(2), readdir(3) and fstatat(2), while the calling thread replays what
+ * they read in fts(3) order, so that the steps recorded are the same as those
+ * fts_walk() would record.  When record_step() prunes a directory, the threads
+ * do not read below it.
+ *
+ * NOTE: You need to call init_walk_stat() first in order to setup the struct walk_stat first.
+ *
+ * given:
+ *	wstat_p		    - pointer to a struct walk_stat to create
+ *	jobs		    - number of threads to read directories, 1 to PAR_WALK_MAX_JOBS
+ *
+ * return:
+ *	true ==> no errors found
+ *	false ==> some errors found
+ *
+ * NOTE: Unlike fts_walk(), par_walk() returns false if topdir cannot be read.
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+bool
+par_walk(struct walk_stat *wstat_p, int jobs)
+{
+    struct walk_pool pool;	    /* threads that read directories */
+    struct walk_dir *root = NULL;   /* topdir */
+    pthread_t *thread = NULL;	    /* threads of the pool */
+    struct stat st;		    /* fstat(2) of topdir */
+    bool ret = true;		    /* par_walk() return */
+    int pret = 0;		    /* pthread function return */
+    int i;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL) {
+	err(135, __func__, "wstat_p is NULL");
+	not_reached();
+    }
+    if (jobs < 1 || jobs > PAR_WALK_MAX_JOBS) {
+	err(136, __func__, "jobs: %d must be from 1 to %d", jobs, PAR_WALK_MAX_JOBS);
+	not_reached();
+    }
+
+    /*
+     * if walk_stat check fails, abort
+     */
+    if (! chk_walk_stat(wstat_p)) {
+	err(137, __func__, "wstat_p failed the chk_walk_stat function test suite");
+	not_reached();
+    }
+
+    /*
+     * open topdir
+     *
+     * NOTE: As with fts_walk(), if wstat_p->topdir is a symlink we will reference where it points,
+     *	     however for any symlink we find lower down, we will see the symbolic links themselves.
+     */
+    memset(&pool, 0, sizeof(pool));
+    errno = 0;	/* pre-clear for warnp() */
+    pool.rootfd = open(wstat_p->topdir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (pool.rootfd < 0) {
+	warnp(__func__, "failed to open topdir: %s", wstat_p->topdir);
+	return false;
+    }
+    errno = 0;	/* pre-clear for warnp() */
+    if (fstat(pool.rootfd, &st) != 0) {
+	warnp(__func__, "failed to fstat topdir: %s", wstat_p->topdir);
+	(void) close(pool.rootfd);
+	return false;
+    }
+
+    /*
+     * queue topdir
+     */
+    errno = 0;	/* pre-clear errno for errp() */
+    root = calloc(1, sizeof(*root));
+    if (root == NULL) {
+	errp(138, __func__, "calloc of topdir walk_dir failed");
+	not_reached();
+    }
+    root->path = "";
+    root->level = 0;
+    root->st_size = st.st_size;
+    root->st_mode = st.st_mode;
+    root->st_dev = st.st_dev;
+    root->st_ino = st.st_ino;
+    pool.queue = root;
+
+    /*
+     * start the threads
+     */
+    if (pthread_mutex_init(&pool.lock, NULL) != 0 ||
+	pthread_cond_init(&pool.work, NULL) != 0 || pthread_cond_init(&pool.done, NULL) != 0) {
+	err(139, __func__, "cannot initialize the walk_pool lock and condition variables");
+	not_reached();
+    }
+    errno = 0;	/* pre-clear errno for errp() */
+    thread = calloc((size_t)jobs, sizeof(pthread_t));
+    if (thread == NULL) {
+	errp(140, __func__, "calloc of %d pthread_t failed", jobs);
+	not_reached();
+    }
+    for (i = 0; i < jobs; ++i) {
+	pret = pthread_create(&thread[i], NULL, par_walk_thread, &pool);
+	if (pret != 0) {
+	    err(141, __func__, "pthread_create of thread %d failed: %s", i, strerror(pret));
+	    not_reached();
 	}
     }
 
     /*
-     * close the file hierarchy structure
+     * record the steps in fts(3) order as the threads read the directories
      */
-    errno = 0;	/* pre-clear for warnp() */
-    fts_close_ret = fts_close(ftsp);
-    if (fts_close_ret != 0) {
+    ret = replay_walk_dir(wstat_p, &pool, root);
 
-	/* report problem on stderr, free storage and return indicating an traversing error */
-	warnp(__func__, "fts_close() failed: %d", fts_close_ret);
-	if (path_set != NULL) {
-	    free(path_set);
-	    path_set = NULL;
+    /*
+     * stop the threads
+     *
+     * NOTE: Directories below pruned directories may still be queued.
+     */
+    (void) pthread_mutex_lock(&pool.lock);
+    pool.stop = true;
+    (void) pthread_cond_broadcast(&pool.work);
+    (void) pthread_mutex_unlock(&pool.lock);
+    for (i = 0; i < jobs; ++i) {
+	pret = pthread_join(thread[i], NULL);
+	if (pret != 0) {
+	    err(142, __func__, "pthread_join of thread %d failed: %s", i, strerror(pret));
+	    not_reached();
 	}
-	return false;
     }
 
     /*
      * free storage
      */
-    if (path_set != NULL) {
-	free(path_set);
-	path_set = NULL;
-    }
+    (void) pthread_cond_destroy(&pool.done);
+    (void) pthread_cond_destroy(&pool.work);
+    (void) pthread_mutex_destroy(&pool.lock);
+    (void) close(pool.rootfd);
+    free(thread);
+    thread = NULL;
+    free_walk_dir(root);
+    root = NULL;
 
     /*
-     * walk successful
+     * report walk results
      */
-    return true;
+    return ret;
 }
 
 
@@ -5042,9 +5719,12 @@ path_in_item_array(struct dyn_array *item_array, char const *c_path)
  * path_in_walk_stat - determine if a path is in a all array of a walk_stat
  *
  * Given a struct walk_stat *wstat_p, search the wstat_p->all dynamic array of struct items
- * for a struct item with an fts_path that is identical to c_path.  We use the wstat_p->all
- * dynamic array because functions such as record_step() stores all valid items on this
- * dynamic array, regardless of the type of path.
+ * for a struct item with an fts_path that is the same as c_path in a CASE INDEPENDENT way
+ * (see path_in_item_array()).  We use the wstat_p->all dynamic array because functions such
+ * as record_step() stores all valid items on this dynamic array, regardless of the type of path.
+ *
+ * NOTE: The search uses the wstat_p->all_index hash table of the wstat_p->all items (see
+ *	 index_item()), so it takes about the same time no matter how many items were recorded.
  *
  * NOTE: Because the functions such as record_step() work on canonicalized paths,
  *	 the c_path should be called with a canonicalized path using canonicalize_path():
@@ -5126,9 +5806,9 @@ path_in_walk_stat(struct walk_stat *wstat_p, char const *c_path)
     }
 
     /*
-     * scan the all array
+     * probe the case independent index of the all array
      */
-    i_p = path_in_item_array(wstat_p->all, c_path);
+    i_p = find_in_index(&wstat_p->all_index, c_path, 0);
     if (i_p != NULL) {
 
 	/* report match found */
@@ -5144,6 +5824,395 @@ path_in_walk_stat(struct walk_stat *wstat_p, char const *c_path)
 }
 
 
+/*
+ * path_in_walk_cat - determine if a path is in a category of a walk_stat
+ *
+ * Like path_in_walk_stat(), only the struct item found must also be in the
+ * given category, as if the path were searched for with path_in_item_array()
+ * on walk_view(wstat_p, cat), only without forming nor scanning the view.
+ *
+ * For example, mkiocccentry asks if a directory was pruned with:
+ *
+ *	if (path_in_walk_cat(wstat_p, WALK_PRUNE, c_path) != NULL) {
+ *	    ... c_path was pruned ...
+ *	}
+ *
+ * given:
+ *	wstat_p		    - pointer to a struct walk_stat
+ *	cat		    - category the struct item must be in
+ *	c_path		    - canonicalized path to search for
+ *
+ * returns:
+ *	!= NULL ==> first struct item in category cat where fts_path matches c_path
+ *	NULL ==> no such struct item
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+struct item *
+path_in_walk_cat(struct walk_stat *wstat_p, enum walk_cat cat, char const *c_path)
+{
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL) {
+	err(108, __func__, "wstat_p is NULL");
+	not_reached();
+    }
+    if (c_path == NULL) {
+	err(109, __func__, "c_path is NULL");
+	not_reached();
+    }
+    if (cat < 0 || cat >= WALK_CAT_COUNT) {
+	err(110, __func__, "invalid walk_cat: %d", (int)cat);
+	not_reached();
+    }
+
+    /*
+     * if walk_stat check fails, abort
+     */
+    if (! chk_walk_stat(wstat_p)) {
+	err(111, __func__, "wstat_p failed the chk_walk_stat function test suite");
+	not_reached();
+    }
+
+    /*
+     * probe the case independent index of the all array for an item in cat
+     */
+    return find_in_index(&wstat_p->all_index, c_path, WALK_BIT(cat));
+}
+
+
+/*
+ * walk_view - dynamic array of the items in a category of a walk_stat
+ *
+ * The items of a category are only recorded as a bit in the walk_cats of each
+ * struct item.  The dynamic array of a category is formed, when first asked
+ * for, from the all dynamic array, and formed again only when the all dynamic
+ * array has changed (an item was recorded, or it was sorted) since.
+ *
+ * Thus the items of the dynamic array are in the order of the all dynamic
+ * array: in the order they were recorded, or sorted if sort_walk_stat() or
+ * sort_walk_istat() was called.
+ *
+ * given:
+ *	wstat_p	    - pointer to a struct walk_stat
+ *	cat	    - category of items
+ *
+ * returns:
+ *	dynamic array of struct item pointers in category cat
+ *
+ * NOTE: The returned dynamic array belongs to the walk_stat: do not change
+ *	 nor free it.  It is freed by free_walk_stat().
+ *
+ * NOTE: This function will NOT return NULL.
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+struct dyn_array *
+walk_view(struct walk_stat *wstat_p, enum walk_cat cat)
+{
+    struct item *i_p;	    /* pointer to an element in the all dynamic array */
+    struct dyn_array *view; /* dynamic array of items in cat */
+    intmax_t len;	    /* number of elements in the all dynamic array */
+    intmax_t i;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || wstat_p->all == NULL) {
+	err(112, __func__, "called with NULL wstat_p or NULL wstat_p->all");
+	not_reached();
+    }
+    if (cat < 0 || cat >= WALK_CAT_COUNT) {
+	err(113, __func__, "invalid walk_cat: %d", (int)cat);
+	not_reached();
+    }
+
+    /*
+     * create the view when first asked for
+     */
+    view = wstat_p->view[cat];
+    if (view == NULL) {
+	view = dyn_array_create(sizeof(struct item *), DEF_CHUNK, DEF_CHUNK, true);
+	wstat_p->view[cat] = view;
+	wstat_p->view_gen[cat] = 0;
+    }
+
+    /*
+     * form the view again if the all array has changed since it was formed
+     */
+    if (wstat_p->view_gen[cat] != wstat_p->all_gen) {
+	dyn_array_clear(view);
+	if (wstat_p->cat_count[cat] > 0) {
+	    len = dyn_array_tell(wstat_p->all);
+	    for (i=0; i < len; ++i) {
+		i_p = dyn_array_value(wstat_p->all, struct item *, i);
+		if (i_p != NULL && item_in_cat(i_p, cat)) {
+		    (void) dyn_array_append_value(view, &i_p);
+		}
+	    }
+	}
+	wstat_p->view_gen[cat] = wstat_p->all_gen;
+    }
+    return view;
+}
+
+
+/*
+ * walk_cat_name - name of a category of a walk_stat
+ *
+ * given:
+ *	cat	    - category of items
+ *
+ * returns:
+ *	name of the category as printed by fprintf_walk_stat(), or
+ *	"((invalid walk_cat))" if cat is not a category
+ */
+char const *
+walk_cat_name(enum walk_cat cat)
+{
+    if (cat < 0 || cat >= WALK_CAT_COUNT) {
+	return "((invalid walk_cat))";
+    }
+    return walk_cat_names[cat];
+}
+
+
+/*
+ * record_cats - record the categories of an item
+ *
+ * given:
+ *	wstat_p	    - pointer to a struct walk_stat
+ *	i_p	    - item of the all array
+ *	cats	    - WALK_BIT() of each category of the item
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static void
+record_cats(struct walk_stat *wstat_p, struct item *i_p, uint64_t cats)
+{
+    int cat;
+
+    /*
+     * firewall
+     */
+    if (wstat_p == NULL || i_p == NULL) {
+	err(114, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * note each category and count the items in it
+     */
+    i_p->walk_cats |= cats;
+    for (cat = 0; cat < WALK_CAT_COUNT; ++cat) {
+	if ((cats & WALK_BIT(cat)) != 0) {
+	    ++wstat_p->cat_count[cat];
+	}
+    }
+    return;
+}
+
+
+/*
+ * fold_hash - case independent hash of a path
+ *
+ * Paths that differ only in case have the same hash, as path_in_item_array()
+ * and find_in_index() compare paths without regard to case.
+ *
+ * given:
+ *	path	    - path to hash
+ *	len	    - length of path
+ *
+ * returns:
+ *	64-bit FNV-1a hash of the lower case form of path
+ */
+static uint64_t
+fold_hash(char const *path, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;	/* FNV-1a offset basis */
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+	hash ^= (uint64_t)(unsigned char)tolower((unsigned char)path[i]);
+	hash *= 0x100000001b3ULL;		/* FNV-1a prime */
+    }
+    return hash;
+}
+
+
+/*
+ * index_item - add an item to a case independent index
+ *
+ * An item_index is an open addressed (linear probing) hash table of items,
+ * keyed by fold_hash() of their fts_path, so that path_in_walk_stat() does
+ * not have to scan the all array, nor record_step() the skip_set, for every
+ * step.  The table is doubled before it becomes half full.
+ *
+ * given:
+ *	index	    - pointer to the item_index
+ *	i_p	    - item to add, after those already added
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static void
+index_item(struct item_index *index, struct item *i_p)
+{
+    struct item **old_slot;	/* slot before the table is doubled */
+    size_t old_size;		/* size before the table is doubled */
+    size_t start;		/* an unused slot of old_slot */
+    struct item *old;		/* item of old_slot being re-indexed */
+    size_t mask;		/* size - 1 */
+    size_t slot;		/* slot being probed */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (index == NULL || i_p == NULL || i_p->fts_path == NULL) {
+	err(106, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * double the table (and re-index the items) before it becomes half full
+     */
+    if ((index->count + 1) * 2 > index->size) {
+	old_slot = index->slot;
+	old_size = index->size;
+	index->size = (old_size == 0) ? ITEM_INDEX_MIN : old_size * 2;
+	errno = 0;		/* pre-clear errno for errp() */
+	index->slot = calloc(index->size, sizeof(struct item *));
+	if (index->slot == NULL) {
+	    errp(107, __func__, "calloc of %zu item_index slots failed", index->size);
+	    not_reached();
+	}
+	mask = index->size - 1;
+
+	/*
+	 * re-index starting just after an unused slot so that each run of used
+	 * slots is re-indexed in probe order: thus case independent duplicates
+	 * stay in the order they were added
+	 */
+	for (start = 0; start < old_size && old_slot[start] != NULL; ++start) {
+	}
+	for (i = 0; i < old_size; ++i) {
+	    old = old_slot[(start + i) & (old_size - 1)];
+	    if (old != NULL) {
+		for (slot = (size_t)fold_hash(old->fts_path, old->fts_pathlen) & mask;
+		     index->slot[slot] != NULL; slot = (slot + 1) & mask) {
+		}
+		index->slot[slot] = old;
+	    }
+	}
+	if (old_slot != NULL) {
+	    free(old_slot);
+	    old_slot = NULL;
+	}
+    }
+
+    /*
+     * add the item to the first unused slot of its probe sequence
+     */
+    mask = index->size - 1;
+    for (slot = (size_t)fold_hash(i_p->fts_path, i_p->fts_pathlen) & mask; index->slot[slot] != NULL;
+	 slot = (slot + 1) & mask) {
+    }
+    index->slot[slot] = i_p;
+    ++index->count;
+    return;
+}
+
+
+/*
+ * find_in_index - find a path in a case independent index
+ *
+ * Items are probed in the order they were added with index_item(), so the
+ * item found is the first added, just as path_in_item_array() would find on
+ * a dynamic array of the same items, only without scanning every item.
+ *
+ * given:
+ *	index	    - pointer to the item_index
+ *	c_path	    - canonicalized path to search for
+ *	cats	    - 0 ==> any item, else WALK_BIT() of categories the item must be in one of
+ *
+ * returns:
+ *	!= NULL ==> struct item pointer where fts_path matches c_path in a case independent way
+ *	NULL ==> no such struct item
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static struct item *
+find_in_index(struct item_index const *index, char const *c_path, uint64_t cats)
+{
+    struct item *i_p;	    /* item being probed */
+    size_t c_path_len;	    /* length of c_path */
+    size_t mask;	    /* size - 1 */
+    size_t slot;	    /* slot being probed */
+
+    /*
+     * firewall
+     */
+    if (index == NULL || c_path == NULL) {
+	err(115, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * nothing is in an empty index
+     */
+    if (index->slot == NULL) {
+	return NULL;
+    }
+
+    /*
+     * probe the index
+     */
+    c_path_len = strlen(c_path);
+    mask = index->size - 1;
+    for (slot = (size_t)fold_hash(c_path, c_path_len) & mask; index->slot[slot] != NULL;
+	 slot = (slot + 1) & mask) {
+	i_p = index->slot[slot];
+	if (c_path_len == i_p->fts_pathlen && strcasecmp(c_path, i_p->fts_path) == 0 &&
+	    (cats == 0 || (i_p->walk_cats & cats) != 0)) {
+	    return i_p;
+	}
+    }
+    return NULL;
+}
+
+
+/*
+ * free_index - free and clear an item_index
+ *
+ * The items themselves are not freed.
+ *
+ * given:
+ *	index	    - pointer to the item_index
+ *
+ * NOTE: This function does not return on an internal error.
+ */
+static void
+free_index(struct item_index *index)
+{
+    /*
+     * firewall
+     */
+    if (index == NULL) {
+	err(116, __func__, "called with NULL index");
+	not_reached();
+    }
+
+    if (index->slot != NULL) {
+	free(index->slot);
+	index->slot = NULL;
+    }
+    index->size = 0;
+    index->count = 0;
+    return;
+}
+
+
 /*
  * allowed_type_str - static string describing allowed type
  *
@@ -0,0 +1,1271 @@
+/*
+ * xz_enc - write xz compressed files without the xz(1) tool
+ *
+ * "Home is behind, the world ahead,
+ *  And there are many paths to tread."
+ *
+ *	-- J.R.R. Tolkien
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+/*
+ * system includes
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * xz_enc - write xz compressed files without the xz(1) tool
+ */
+#include "xz_enc.h"
+
+
+/*
+ * xz block header that we write
+ *
+ * One LZMA2 filter with the dictionary size property and neither the
+ * compressed nor the uncompressed size, padded to XZ_ENC_BLOCK_HDR_LEN.
+ */
+#define XZ_ENC_BLOCK_HDR_LEN (12)	/* length of the block header, with its CRC32 */
+
+/*
+ * room in the xz block buffer beyond the uncompressed block size
+ *
+ * An LZMA chunk is only kept if it is shorter than the data it holds,
+ * otherwise the data is stored in uncompressed chunks of 3 header bytes
+ * each, so an xz block is only a little longer than the data.  As a chunk
+ * is compressed in place before we know whether it will be kept, there
+ * must also be room for a full LZMA chunk.
+ */
+#define XZ_ENC_OUT_SLACK (XZ_ENC_CHUNK_COMP_MAX + 4096)
+
+/*
+ * xz stream header magic
+ */
+static unsigned char const xz_magic[6] = { 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+
+
+/*
+ * static declarations
+ */
+static bool enc_fail(struct xz_writer *xz, char const *msg);
+static bool out_bytes(struct xz_writer *xz, unsigned char const *buf, size_t len);
+static uint32_t crc32_update(uint32_t const *tbl, uint32_t crc, unsigned char const *buf, size_t len);
+static uint64_t crc64_update(uint64_t const *tbl, uint64_t crc, unsigned char const *buf, size_t len);
+static void put_le32(unsigned char *buf, uint32_t val);
+static size_t put_varint(unsigned char *buf, uint64_t val);
+static void enc_reset(struct xz_enc_block *blk);
+static size_t chunk_lzma(struct xz_enc_block *blk, size_t pos, size_t end);
+static void *compress_block(void *arg);
+static bool write_blocks(struct xz_writer *xz);
+
+
+/*
+ * enc_fail - record why an xz file cannot be written
+ *
+ * given:
+ *	xz	xz writer
+ *	msg	what went wrong
+ *
+ * returns:
+ *	false
+ *
+ * NOTE: only the first failure is recorded.
+ */
+static bool
+enc_fail(struct xz_writer *xz, char const *msg)
+{
+    if (xz->error == NULL) {
+	xz->error = msg;
+	dbg(DBG_MED, "%s: %s at compressed offset %ju", __func__, msg, (uintmax_t)xz->out_total);
+    }
+    return false;
+}
+
+
+/*
+ * out_bytes - write compressed bytes
+ *
+ * given:
+ *	xz	xz writer
+ *	buf	bytes to write
+ *	len	number of bytes to write
+ *
+ * returns:
+ *	true ==> bytes written, false ==> error (recorded with enc_fail())
+ */
+static bool
+out_bytes(struct xz_writer *xz, unsigned char const *buf, size_t len)
+{
+    if (len > 0 && fwrite(buf, 1, len, xz->stream) != len) {
+	return enc_fail(xz, "write error");
+    }
+    xz->out_total += len;
+    return true;
+}
+
+
+/*
+ * crc32_update - update a CRC32 with bytes
+ */
+static uint32_t
+crc32_update(uint32_t const *tbl, uint32_t crc, unsigned char const *buf, size_t len)
+{
+    crc = ~crc;
+    while (len-- > 0) {
+	crc = tbl[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+/*
+ * crc64_update - update a CRC64 with bytes
+ */
+static uint64_t
+crc64_update(uint64_t const *tbl, uint64_t crc, unsigned char const *buf, size_t len)
+{
+    crc = ~crc;
+    while (len-- > 0) {
+	crc = tbl[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+/*
+ * put_le32 - store a little endian 32 bit value
+ */
+static void
+put_le32(unsigned char *buf, uint32_t val)
+{
+    buf[0] = (unsigned char)val;
+    buf[1] = (unsigned char)(val >> 8);
+    buf[2] = (unsigned char)(val >> 16);
+    buf[3] = (unsigned char)(val >> 24);
+}
+
+
+/*
+ * put_varint - store an xz variable length integer
+ *
+ * returns:
+ *	number of bytes stored, at most 10
+ */
+static size_t
+put_varint(unsigned char *buf, uint64_t val)
+{
+    size_t i = 0;
+
+    while (val >= 0x80) {
+	buf[i++] = (unsigned char)(val | 0x80);
+	val >>= 7;
+    }
+    buf[i++] = (unsigned char)val;
+    return i;
+}
+
+
+/*
+ * rc_shift_low - write the top byte of the range encoder low
+ *
+ * A carry can still change the byte before it and any 0xFF bytes that
+ * followed that byte, so those are held back in cache and cache_size.
+ */
+static inline void
+rc_shift_low(struct xz_enc_block *blk)
+{
+    unsigned char c;
+
+    if ((uint32_t)blk->low < 0xFF000000U || (blk->low >> 32) != 0) {
+	c = blk->cache;
+	do {
+	    blk->rc_out[blk->rc_pos++] = (unsigned char)(c + (unsigned char)(blk->low >> 32));
+	    c = 0xFF;
+	} while (--blk->cache_size != 0);
+	blk->cache = (unsigned char)((uint32_t)blk->low >> 24);
+    }
+    ++blk->cache_size;
+    blk->low = (uint32_t)blk->low << 8;
+}
+
+
+/*
+ * rc_bit - encode a bit with a probability
+ */
+static inline void
+rc_bit(struct xz_enc_block *blk, uint16_t *prob, unsigned int bit)
+{
+    uint32_t bound;
+
+    bound = (blk->range >> RC_MODEL_BITS) * *prob;
+    if (bit == 0) {
+	blk->range = bound;
+	*prob = (uint16_t)(*prob + (((1U << RC_MODEL_BITS) - *prob) >> RC_MOVE_BITS));
+    } else {
+	blk->low += bound;
+	blk->range -= bound;
+	*prob = (uint16_t)(*prob - (*prob >> RC_MOVE_BITS));
+    }
+    while (blk->range < RC_TOP) {
+	blk->range <<= 8;
+	rc_shift_low(blk);
+    }
+}
+
+
+/*
+ * rc_direct - encode the low bits of val with a fixed probability of 0.5
+ */
+static inline void
+rc_direct(struct xz_enc_block *blk, uint32_t val, unsigned int bits)
+{
+    do {
+	blk->range >>= 1;
+	if ((val >> --bits) & 1) {
+	    blk->low += blk->range;
+	}
+	while (blk->range < RC_TOP) {
+	    blk->range <<= 8;
+	    rc_shift_low(blk);
+	}
+    } while (bits > 0);
+}
+
+
+/*
+ * rc_tree - encode a bits long symbol, most significant bit first
+ */
+static inline void
+rc_tree(struct xz_enc_block *blk, uint16_t *probs, unsigned int bits, uint32_t sym)
+{
+    uint32_t m = 1;
+    unsigned int bit;
+
+    do {
+	bit = (sym >> --bits) & 1;
+	rc_bit(blk, &probs[m], bit);
+	m = (m << 1) + bit;
+    } while (bits > 0);
+}
+
+
+/*
+ * rc_tree_rev - encode a bits long symbol, least significant bit first
+ */
+static inline void
+rc_tree_rev(struct xz_enc_block *blk, uint16_t *probs, unsigned int bits, uint32_t sym)
+{
+    uint32_t m = 1;
+    unsigned int bit;
+
+    while (bits-- > 0) {
+	bit = sym & 1;
+	sym >>= 1;
+	rc_bit(blk, &probs[m], bit);
+	m = (m << 1) + bit;
+    }
+}
+
+
+/*
+ * rc_flush - write what is left of the range encoder
+ */
+static void
+rc_flush(struct xz_enc_block *blk)
+{
+    int i;
+
+    for (i = 0; i < 5; ++i) {
+	rc_shift_low(blk);
+    }
+}
+
+
+/*
+ * enc_reset - reset the LZMA state and probabilities
+ */
+static void
+enc_reset(struct xz_enc_block *blk)
+{
+    uint16_t *prob;
+    size_t i;
+
+    blk->state = 0;
+    blk->rep[0] = blk->rep[1] = blk->rep[2] = blk->rep[3] = 0;
+    prob = (uint16_t *)&blk->probs;
+    for (i = 0; i < sizeof(blk->probs) / sizeof(uint16_t); ++i) {
+	prob[i] = RC_MODEL_INIT;
+    }
+}
+
+
+/*
+ * lzma_len - encode an LZMA match length - 2
+ */
+static inline void
+lzma_len(struct xz_enc_block *blk, struct xz_lzma_len *len, uint32_t val, uint32_t pos_state)
+{
+    if (val < 8) {
+	rc_bit(blk, &len->choice, 0);
+	rc_tree(blk, len->low[pos_state], 3, val);
+    } else if (val < 16) {
+	rc_bit(blk, &len->choice, 1);
+	rc_bit(blk, &len->choice2, 0);
+	rc_tree(blk, len->mid[pos_state], 3, val - 8);
+    } else {
+	rc_bit(blk, &len->choice, 1);
+	rc_bit(blk, &len->choice2, 1);
+	rc_tree(blk, len->high, 8, val - 16);
+    }
+}
+
+
+/*
+ * lzma_literal - encode the byte at pos as a literal
+ */
+static inline void
+lzma_literal(struct xz_enc_block *blk, size_t pos)
+{
+    struct xz_lzma_probs *p = &blk->probs;
+    uint16_t *probs;		/* literal coder probabilities */
+    unsigned int prev;		/* previous byte */
+    unsigned int c;		/* byte to encode */
+    unsigned int sym;		/* bits of c encoded so far, after a leading 1 */
+    unsigned int match_byte;	/* byte at rep[0] for a literal after a match */
+    unsigned int match_bit;	/* top bit of match_byte */
+    unsigned int bit;
+    int shift;			/* shift of the next bit of c */
+
+    rc_bit(blk, &p->is_match[blk->state][pos & ((1U << XZ_ENC_PB) - 1)], 0);
+    prev = pos > 0 ? blk->in[pos - 1] : 0;
+    probs = p->literal + XZ_LZMA_LITERAL_CODER *
+	    ((((uint32_t)pos & ((1U << XZ_ENC_LP) - 1)) << XZ_ENC_LC) + (prev >> (8 - XZ_ENC_LC)));
+    c = blk->in[pos];
+    sym = 1;
+    shift = 7;
+    if (blk->state >= 7) {
+	match_byte = blk->in[pos - blk->rep[0] - 1];
+	do {
+	    match_bit = (match_byte >> 7) & 1;
+	    match_byte <<= 1;
+	    bit = (c >> shift--) & 1;
+	    rc_bit(blk, &probs[((1 + match_bit) << 8) + sym], bit);
+	    sym = (sym << 1) | bit;
+	    if (match_bit != bit) {
+		break;
+	    }
+	} while (sym < 0x100);
+    }
+    while (sym < 0x100) {
+	bit = (c >> shift--) & 1;
+	rc_bit(blk, &probs[sym], bit);
+	sym = (sym << 1) | bit;
+    }
+    blk->state = blk->state < 4 ? 0 : (blk->state < 10 ? blk->state - 3 : blk->state - 6);
+}
+
+
+/*
+ * lzma_match - encode a match of len bytes dist bytes back
+ */
+static inline void
+lzma_match(struct xz_enc_block *blk, size_t pos, uint32_t dist, uint32_t len)
+{
+    struct xz_lzma_probs *p = &blk->probs;
+    uint32_t pos_state;		/* position state */
+    uint32_t slot;		/* distance slot */
+    unsigned int bits;		/* number of bits below the top two */
+    uint32_t base;		/* smallest distance - 1 of the slot */
+    unsigned int top;		/* index of the top bit of dist */
+
+    pos_state = (uint32_t)pos & ((1U << XZ_ENC_PB) - 1);
+    rc_bit(blk, &p->is_match[blk->state][pos_state], 1);
+    rc_bit(blk, &p->is_rep[blk->state], 0);
+    lzma_len(blk, &p->match_len, len - 2, pos_state);
+    blk->state = blk->state < 7 ? 7 : 10;
+
+    /*
+     * encode the distance - 1 as the decoder's lzma_dist() decodes it
+     */
+    --dist;
+    if (dist < 4) {
+	slot = dist;
+    } else {
+	for (top = 2; (dist >> (top + 1)) != 0; ++top) {
+	    /* find the top bit */
+	}
+	slot = (top << 1) | ((dist >> (top - 1)) & 1);
+    }
+    rc_tree(blk, p->pos_slot[len - 2 < XZ_LZMA_LEN_TO_POS_STATES - 1 ? len - 2 : XZ_LZMA_LEN_TO_POS_STATES - 1],
+	    6, slot);
+    if (slot >= 4) {
+	bits = (slot >> 1) - 1;
+	base = (2 | (slot & 1)) << bits;
+	if (slot < XZ_LZMA_END_POS_MODEL) {
+	    rc_tree_rev(blk, p->pos_special + base - slot, bits, dist - base);
+	} else {
+	    rc_direct(blk, (dist - base) >> XZ_LZMA_ALIGN_BITS, bits - XZ_LZMA_ALIGN_BITS);
+	    rc_tree_rev(blk, p->align, XZ_LZMA_ALIGN_BITS, dist - base);
+	}
+    }
+    blk->rep[3] = blk->rep[2];
+    blk->rep[2] = blk->rep[1];
+    blk->rep[1] = blk->rep[0];
+    blk->rep[0] = dist;
+}
+
+
+/*
+ * lzma_rep - encode a match of len bytes at the distance of rep[r]
+ */
+static inline void
+lzma_rep(struct xz_enc_block *blk, size_t pos, unsigned int r, uint32_t len)
+{
+    struct xz_lzma_probs *p = &blk->probs;
+    uint32_t pos_state;		/* position state */
+    uint32_t dist;		/* distance - 1 of rep[r] */
+
+    pos_state = (uint32_t)pos & ((1U << XZ_ENC_PB) - 1);
+    rc_bit(blk, &p->is_match[blk->state][pos_state], 1);
+    rc_bit(blk, &p->is_rep[blk->state], 1);
+    if (r == 0) {
+	rc_bit(blk, &p->is_rep_g0[blk->state], 0);
+	rc_bit(blk, &p->is_rep0_long[blk->state][pos_state], 1);
+    } else {
+	rc_bit(blk, &p->is_rep_g0[blk->state], 1);
+	if (r == 1) {
+	    rc_bit(blk, &p->is_rep_g1[blk->state], 0);
+	} else {
+	    rc_bit(blk, &p->is_rep_g1[blk->state], 1);
+	    rc_bit(blk, &p->is_rep_g2[blk->state], r - 2);
+	}
+	dist = blk->rep[r];
+	for (; r > 0; --r) {
+	    blk->rep[r] = blk->rep[r - 1];
+	}
+	blk->rep[0] = dist;
+    }
+    lzma_len(blk, &p->rep_len, len - 2, pos_state);
+    blk->state = blk->state < 7 ? 8 : 11;
+}
+
+
+/*
+ * match_len - return how many bytes (up to max) of a and b are the same
+ */
+static inline uint32_t
+match_len(unsigned char const *a, unsigned char const *b, uint32_t max)
+{
+    uint32_t len = 0;
+
+    while (len < max && a[len] == b[len]) {
+	++len;
+    }
+    return len;
+}
+
+
+/*
+ * hash3 - return the match finder hash of the 3 bytes at buf
+ */
+static inline uint32_t
+hash3(unsigned char const *buf)
+{
+    return ((((uint32_t)buf[0] << 16) | ((uint32_t)buf[1] << 8) | buf[2]) * 2654435761U) >> (32 - XZ_ENC_HASH_BITS);
+}
+
+
+/*
+ * hash_insert - add pos to the match finder
+ */
+static inline void
+hash_insert(struct xz_enc_block *blk, size_t pos)
+{
+    uint32_t h;
+
+    if (pos + 3 <= blk->in_len) {
+	h = hash3(blk->in + pos);
+	blk->chain[pos] = blk->head[h];
+	blk->head[h] = (int32_t)pos;
+    }
+}
+
+
+/*
+ * find_match - find the longest earlier match of the bytes at pos
+ *
+ * given:
+ *	blk	block being compressed
+ *	pos	position in the block, already in the match finder or not
+ *	max	longest match length to look for
+ *	dist	where to store the distance of the match found
+ *
+ * returns:
+ *	length of the match found, 0 ==> none found
+ *
+ * NOTE: only positions before pos that were given to hash_insert() are tried.
+ */
+static uint32_t
+find_match(struct xz_enc_block *blk, size_t pos, uint32_t max, uint32_t *dist)
+{
+    unsigned char const *cur;	/* bytes at pos */
+    int32_t cand;		/* earlier position with the same hash */
+    uint32_t best = 0;		/* longest match length found */
+    uint32_t len;		/* match length at cand */
+    int depth;			/* candidates left to try */
+
+    if (pos + 3 > blk->in_len || max < 3) {
+	return 0;
+    }
+    cur = blk->in + pos;
+    cand = blk->head[hash3(cur)];
+    if (cand >= 0 && (size_t)cand == pos) {
+	cand = blk->chain[cand];
+    }
+    for (depth = XZ_ENC_DEPTH; cand >= 0 && depth > 0; --depth, cand = blk->chain[cand]) {
+	if (blk->in[cand + best] != cur[best]) {
+	    continue;
+	}
+	len = match_len(blk->in + cand, cur, max);
+	if (len > best) {
+	    best = len;
+	    *dist = (uint32_t)(pos - (size_t)cand);
+	    if (len >= XZ_ENC_NICE_LEN || len == max) {
+		break;
+	    }
+	}
+    }
+    return best >= 3 ? best : 0;
+}
+
+
+/*
+ * chunk_lzma - LZMA encode the bytes of a block from pos until a chunk is full
+ *
+ * given:
+ *	blk	block being compressed, with rc_out set to where the chunk data goes
+ *	pos	position of the first byte of the chunk
+ *	end	position just beyond the last byte that the chunk may hold
+ *
+ * returns:
+ *	position just beyond the last byte encoded
+ *
+ * We stop before end if another symbol might not fit in XZ_ENC_CHUNK_COMP_MAX
+ * compressed bytes.  The caller must still call rc_flush().
+ *
+ * The match finder is greedy with one step of lazy evaluation: a match is
+ * put off if the next byte starts a longer one.  Repeated distances are
+ * preferred when they are about as long, as they are far cheaper to encode.
+ */
+static size_t
+chunk_lzma(struct xz_enc_block *blk, size_t pos, size_t end)
+{
+    uint32_t max;		/* longest match at pos */
+    uint32_t len;		/* length of the match to encode */
+    uint32_t dist = 0;		/* distance of the match found */
+    uint32_t rep_len;		/* length of the longest repeated distance match */
+    unsigned int rep = 0;	/* which repeated distance rep_len is of */
+    uint32_t next_len;		/* length of the match at pos + 1 */
+    uint32_t next_dist = 0;	/* distance of the match at pos + 1 */
+    uint32_t l;
+    uint32_t d;
+    unsigned int r;
+
+    while (pos < end && blk->rc_pos + blk->cache_size + 5 + XZ_ENC_SYMBOL_MAX <= XZ_ENC_CHUNK_COMP_MAX) {
+	max = end - pos < XZ_LZMA_MATCH_LEN_MAX ? (uint32_t)(end - pos) : XZ_LZMA_MATCH_LEN_MAX;
+
+	/*
+	 * look for a match at a repeated distance and at any distance
+	 */
+	rep_len = 0;
+	if (max >= 2) {
+	    for (r = 0; r < 4; ++r) {
+		d = blk->rep[r] + 1;
+		if (d <= pos) {
+		    l = match_len(blk->in + pos - d, blk->in + pos, max);
+		    if (l > rep_len) {
+			rep_len = l;
+			rep = r;
+		    }
+		}
+	    }
+	}
+	len = find_match(blk, pos, max, &dist);
+	if (len == 3 && dist > (1U << 14)) {
+	    /* a short far match costs more than its literals */
+	    len = 0;
+	}
+
+	/*
+	 * encode a repeated distance match if it is about as long
+	 */
+	if (rep_len >= 2 && (rep_len + 1 >= len || (rep_len + 2 >= len && dist >= (1U << 9)))) {
+	    lzma_rep(blk, pos, rep, rep_len);
+	    for (l = 0; l < rep_len; ++l) {
+		hash_insert(blk, pos + l);
+	    }
+	    pos += rep_len;
+	    continue;
+	}
+
+	/*
+	 * encode a literal unless there is a match not bettered by one at the next byte
+	 */
+	if (len >= 3 && len < XZ_ENC_NICE_LEN && pos + 1 < end) {
+	    hash_insert(blk, pos);
+	    next_len = find_match(blk, pos + 1, end - pos - 1 < XZ_LZMA_MATCH_LEN_MAX ?
+				  (uint32_t)(end - pos - 1) : XZ_LZMA_MATCH_LEN_MAX, &next_dist);
+	    if (next_len > len) {
+		lzma_literal(blk, pos);
+		++pos;
+		continue;
+	    }
+	} else {
+	    hash_insert(blk, pos);
+	}
+	if (len < 3) {
+	    lzma_literal(blk, pos);
+	    ++pos;
+	    continue;
+	}
+	lzma_match(blk, pos, dist, len);
+	for (l = 1; l < len; ++l) {
+	    hash_insert(blk, pos + l);
+	}
+	pos += len;
+    }
+    return pos;
+}
+
+
+/*
+ * compress_block - compress a block of input into an xz block
+ *
+ * given:
+ *	arg	struct xz_enc_block with in and in_len set
+ *
+ * returns:
+ *	NULL
+ *
+ * The xz block is formed in out, out_len and unpadded.  This function may
+ * be run by a thread: it only uses the block it is given.
+ *
+ * This function does not return on error.
+ */
+static void *
+compress_block(void *arg)
+{
+    struct xz_enc_block *blk = arg;	/* block to compress */
+    unsigned char *out;		/* xz block being formed */
+    size_t o;			/* length of the xz block so far */
+    size_t pos;			/* next byte of in to compress */
+    size_t start;		/* first byte of in in the current chunk */
+    size_t end;			/* most that the current chunk may hold */
+    size_t hdr_len;		/* length of the LZMA chunk header */
+    size_t comp;		/* compressed length of the LZMA chunk */
+    size_t unc;			/* uncompressed length of the chunk */
+    size_t n;
+    bool need_dict_reset = true;	/* true ==> next chunk must reset the dictionary */
+    bool need_props = true;		/* true ==> next LZMA chunk must set lc, lp and pb */
+    bool need_state_reset = true;	/* true ==> next LZMA chunk must reset the state */
+    unsigned int control;	/* LZMA2 chunk control byte */
+    uint64_t check;		/* CRC64 of the block input */
+
+    /*
+     * firewall
+     */
+    if (blk == NULL || blk->in == NULL || blk->in_len == 0 || blk->in_len > XZ_ENC_BLOCK_SIZE) {
+	err(10, __func__, "called with NULL or empty block");
+	not_reached();
+    }
+
+    /*
+     * allocate the match finder and the xz block, the first time only
+     */
+    if (blk->out == NULL) {
+	errno = 0;		/* pre-clear errno for errp() */
+	blk->out = malloc(XZ_ENC_BLOCK_SIZE + XZ_ENC_OUT_SLACK);
+	if (blk->out == NULL) {
+	    errp(11, __func__, "malloc of %d byte xz block failed", XZ_ENC_BLOCK_SIZE + XZ_ENC_OUT_SLACK);
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	blk->head = malloc(sizeof(int32_t) << XZ_ENC_HASH_BITS);
+	if (blk->head == NULL) {
+	    errp(12, __func__, "malloc of match finder hash failed");
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	blk->chain = malloc(sizeof(int32_t) * XZ_ENC_BLOCK_SIZE);
+	if (blk->chain == NULL) {
+	    errp(13, __func__, "malloc of match finder chain failed");
+	    not_reached();
+	}
+    }
+    out = blk->out;
+    memset(blk->head, 0xFF, sizeof(int32_t) << XZ_ENC_HASH_BITS);
+
+    /*
+     * block header
+     */
+    memset(out, 0, XZ_ENC_BLOCK_HDR_LEN);
+    out[0] = XZ_ENC_BLOCK_HDR_LEN / 4 - 1;
+    out[1] = 0x00;			/* one filter, no compressed or uncompressed size */
+    out[2] = XZ_FILTER_LZMA2;
+    out[3] = 1;				/* length of the filter properties */
+    out[4] = XZ_ENC_DICT_PROP;
+    put_le32(out + XZ_ENC_BLOCK_HDR_LEN - 4,
+	     crc32_update(blk->crc32_tbl, 0, out, XZ_ENC_BLOCK_HDR_LEN - 4));
+    o = XZ_ENC_BLOCK_HDR_LEN;
+
+    /*
+     * LZMA2 chunks
+     */
+    pos = 0;
+    while (pos < blk->in_len) {
+	start = pos;
+	end = blk->in_len - pos < XZ_ENC_CHUNK_MAX ? blk->in_len : pos + XZ_ENC_CHUNK_MAX;
+	hdr_len = need_props ? 6 : 5;
+
+	/*
+	 * LZMA encode as much as fits in a chunk
+	 */
+	if (need_state_reset) {
+	    enc_reset(blk);
+	}
+	blk->low = 0;
+	blk->range = UINT32_MAX;
+	blk->cache = 0;
+	blk->cache_size = 1;
+	blk->rc_out = out + o + hdr_len;
+	blk->rc_pos = 0;
+	pos = chunk_lzma(blk, pos, end);
+	rc_flush(blk);
+	comp = blk->rc_pos;
+	unc = pos - start;
+
+	/*
+	 * keep the LZMA chunk if it is smaller, else store the data
+	 */
+	if (comp < unc) {
+	    control = 0x80 | (unsigned int)((unc - 1) >> 16);
+	    if (need_dict_reset) {
+		control |= 0x60;
+	    } else if (need_props) {
+		control |= 0x40;
+	    } else if (need_state_reset) {
+		control |= 0x20;
+	    }
+	    out[o] = (unsigned char)control;
+	    out[o + 1] = (unsigned char)((unc - 1) >> 8);
+	    out[o + 2] = (unsigned char)(unc - 1);
+	    out[o + 3] = (unsigned char)((comp - 1) >> 8);
+	    out[o + 4] = (unsigned char)(comp - 1);
+	    if (need_props) {
+		out[o + 5] = (XZ_ENC_PB * 5 + XZ_ENC_LP) * 9 + XZ_ENC_LC;
+	    }
+	    o += hdr_len + comp;
+	    need_dict_reset = false;
+	    need_props = false;
+	    need_state_reset = false;
+	} else {
+	    while (start < pos) {
+		n = pos - start < XZ_ENC_COPY_MAX ? pos - start : XZ_ENC_COPY_MAX;
+		out[o] = need_dict_reset ? 0x01 : 0x02;
+		out[o + 1] = (unsigned char)((n - 1) >> 8);
+		out[o + 2] = (unsigned char)(n - 1);
+		memcpy(out + o + 3, blk->in + start, n);
+		o += 3 + n;
+		start += n;
+		if (need_dict_reset) {
+		    /* the decoder wants lc, lp and pb again after a dictionary reset */
+		    need_dict_reset = false;
+		    need_props = true;
+		}
+	    }
+	    /* the encoder state has moved on, but the decoder state has not */
+	    need_state_reset = true;
+	}
+    }
+    out[o++] = 0x00;			/* end of LZMA2 data */
+
+    /*
+     * block padding and check
+     */
+    blk->unpadded = o + 8;
+    while (o % 4 != 0) {
+	out[o++] = 0x00;
+    }
+    check = crc64_update(blk->crc64_tbl, 0, blk->in, blk->in_len);
+    put_le32(out + o, (uint32_t)check);
+    put_le32(out + o + 4, (uint32_t)(check >> 32));
+    blk->out_len = o + 8;
+    return NULL;
+}
+
+
+/*
+ * write_blocks - compress the full blocks, at the same time, and write them in order
+ *
+ * given:
+ *	xz	xz writer
+ *
+ * returns:
+ *	true ==> blocks written, false ==> error (recorded with enc_fail())
+ *
+ * NOTE: if a thread cannot be started, we compress its block ourselves.
+ */
+static bool
+write_blocks(struct xz_writer *xz)
+{
+    struct xz_enc_block *blk;	/* block to compress */
+    struct xz_record rec;	/* index record of a block */
+    bool threaded[XZ_ENC_MAX_THREADS];	/* threaded[i] true ==> a thread compresses block i */
+    unsigned int i;
+    int ret;
+
+    threaded[0] = false;
+    for (i = 1; i < xz->blocks; ++i) {
+	ret = pthread_create(&xz->block[i].thread, NULL, compress_block, &xz->block[i]);
+	threaded[i] = ret == 0;
+	if (ret != 0) {
+	    dbg(DBG_MED, "%s: pthread_create failed, compressing block %u without a thread", __func__, i);
+	}
+    }
+    for (i = 0; i < xz->blocks; ++i) {
+	blk = &xz->block[i];
+	if (i == 0 || !threaded[i]) {
+	    (void) compress_block(blk);
+	} else {
+	    ret = pthread_join(blk->thread, NULL);
+	    if (ret != 0) {
+		errno = ret;
+		errp(14, __func__, "pthread_join of block %u failed", i);
+		not_reached();
+	    }
+	}
+    }
+
+    /*
+     * write the blocks in order
+     */
+    for (i = 0; i < xz->blocks; ++i) {
+	blk = &xz->block[i];
+	if (!out_bytes(xz, blk->out, blk->out_len)) {
+	    return false;
+	}
+	rec.unpadded = blk->unpadded;
+	rec.uncompressed = blk->in_len;
+	(void) dyn_array_append_value(xz->records, &rec);
+	dbg(DBG_VVHIGH, "%s: block of %zu bytes compressed to %zu bytes", __func__, blk->in_len, blk->out_len);
+	blk->in_len = 0;
+    }
+    xz->blocks = 0;
+    return true;
+}
+
+
+/*
+ * xz_create - create an xz file for writing
+ *
+ * given:
+ *	path	path of the xz file
+ *	threads	number of blocks to compress at the same time, 0 ==> 1
+ *
+ * returns:
+ *	allocated xz writer, or NULL with errno set if path cannot be created
+ *
+ * NOTE: end the xz file with xz_finish() and free the xz writer with
+ *	 xz_writer_free().
+ */
+struct xz_writer *
+xz_create(char const *path, unsigned int threads)
+{
+    struct xz_writer *xz;	/* xz writer to return */
+    FILE *stream;		/* created xz file */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	err(15, __func__, "called with NULL path");
+	not_reached();
+    }
+
+    errno = 0;			/* pre-clear errno for caller */
+    stream = fopen(path, "wb");
+    if (stream == NULL) {
+	return NULL;
+    }
+    xz = xz_create_stream(stream, threads);
+    xz->close_stream = true;
+    return xz;
+}
+
+
+/*
+ * xz_create_stream - write xz data to an open stream
+ *
+ * given:
+ *	stream	open stream to write xz data to
+ *	threads	number of blocks to compress at the same time, 0 ==> 1
+ *
+ * returns:
+ *	allocated xz writer
+ *
+ * NOTE: the stream header is written by the first xz_write() or by
+ *	 xz_finish(), so that a write error is reported by them.
+ *
+ * NOTE: free the xz writer with xz_writer_free(), which does not close stream.
+ */
+struct xz_writer *
+xz_create_stream(FILE *stream, unsigned int threads)
+{
+    struct xz_writer *xz;	/* xz writer to return */
+    uint32_t c32;		/* CRC32 table value */
+    uint64_t c64;		/* CRC64 table value */
+    unsigned int i;
+    unsigned int j;
+
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(16, __func__, "called with NULL stream");
+	not_reached();
+    }
+    if (threads < 1) {
+	threads = 1;
+    } else if (threads > XZ_ENC_MAX_THREADS) {
+	threads = XZ_ENC_MAX_THREADS;
+    }
+
+    errno = 0;			/* pre-clear errno for errp() */
+    xz = calloc(1, sizeof(*xz));
+    if (xz == NULL) {
+	errp(17, __func__, "calloc of struct xz_writer failed");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    xz->block = calloc(threads, sizeof(xz->block[0]));
+    if (xz->block == NULL) {
+	errp(18, __func__, "calloc of %u blocks failed", threads);
+	not_reached();
+    }
+    xz->records = dyn_array_create(sizeof(struct xz_record), 64, 64, false);
+    xz->stream = stream;
+    xz->close_stream = false;
+    xz->error = NULL;
+    xz->threads = threads;
+
+    /*
+     * form the CRC tables
+     */
+    for (i = 0; i < 256; ++i) {
+	c32 = i;
+	c64 = i;
+	for (j = 0; j < 8; ++j) {
+	    c32 = (c32 & 1) ? (c32 >> 1) ^ XZ_CRC32_POLY : c32 >> 1;
+	    c64 = (c64 & 1) ? (c64 >> 1) ^ XZ_CRC64_POLY : c64 >> 1;
+	}
+	xz->crc32_tbl[i] = c32;
+	xz->crc64_tbl[i] = c64;
+    }
+    for (i = 0; i < threads; ++i) {
+	xz->block[i].crc32_tbl = xz->crc32_tbl;
+	xz->block[i].crc64_tbl = xz->crc64_tbl;
+    }
+    return xz;
+}
+
+
+/*
+ * stream_header - write the xz stream header, if not yet written
+ *
+ * returns:
+ *	true ==> header written, false ==> error (recorded with enc_fail())
+ */
+static bool
+stream_header(struct xz_writer *xz)
+{
+    unsigned char hdr[XZ_HEADER_LEN];	/* stream header */
+
+    if (xz->out_total > 0) {
+	return true;
+    }
+    memcpy(hdr, xz_magic, sizeof(xz_magic));
+    hdr[6] = 0x00;
+    hdr[7] = XZ_CHECK_CRC64;
+    put_le32(hdr + 8, crc32_update(xz->crc32_tbl, 0, hdr + 6, 2));
+    return out_bytes(xz, hdr, sizeof(hdr));
+}
+
+
+/*
+ * xz_write - write uncompressed data to an xz file
+ *
+ * given:
+ *	xz	xz writer
+ *	buf	data to compress
+ *	len	number of bytes of data
+ *
+ * returns:
+ *	true ==> data compressed (or held for compression), false ==> error
+ *
+ * NOTE: on error, xz_writer_error() says what went wrong.
+ */
+bool
+xz_write(struct xz_writer *xz, void const *buf, size_t len)
+{
+    unsigned char const *in;	/* data left to write */
+    struct xz_enc_block *blk;	/* block being filled */
+    size_t n;
+
+    /*
+     * firewall
+     */
+    if (xz == NULL || (buf == NULL && len > 0)) {
+	err(19, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    if (xz->error != NULL || !stream_header(xz)) {
+	return false;
+    }
+
+    in = buf;
+    xz->in_total += len;
+    while (len > 0) {
+	blk = &xz->block[xz->blocks];
+	if (blk->in == NULL) {
+	    errno = 0;		/* pre-clear errno for errp() */
+	    blk->in = malloc(XZ_ENC_BLOCK_SIZE);
+	    if (blk->in == NULL) {
+		errp(20, __func__, "malloc of %d byte block failed", XZ_ENC_BLOCK_SIZE);
+		not_reached();
+	    }
+	}
+	n = XZ_ENC_BLOCK_SIZE - blk->in_len;
+	if (n > len) {
+	    n = len;
+	}
+	memcpy(blk->in + blk->in_len, in, n);
+	blk->in_len += n;
+	in += n;
+	len -= n;
+
+	/*
+	 * compress the blocks once each thread has a full one
+	 */
+	if (blk->in_len == XZ_ENC_BLOCK_SIZE && ++xz->blocks == xz->threads) {
+	    if (!write_blocks(xz)) {
+		return false;
+	    }
+	}
+    }
+    return true;
+}
+
+
+/*
+ * xz_finish - compress what is left and end the xz file
+ *
+ * given:
+ *	xz	xz writer
+ *
+ * returns:
+ *	true ==> xz file written, false ==> error
+ *
+ * The index and stream footer are written and the stream is flushed, and
+ * closed if xz_create() opened it.
+ *
+ * NOTE: on error, xz_writer_error() says what went wrong.
+ */
+bool
+xz_finish(struct xz_writer *xz)
+{
+    struct xz_record *rec;	/* index record of a block */
+    unsigned char *idx;		/* index */
+    size_t idx_len;		/* length of the index */
+    unsigned char footer[XZ_HEADER_LEN];	/* stream footer */
+    intmax_t count;		/* number of blocks */
+    intmax_t i;
+    bool ok;
+
+    /*
+     * firewall
+     */
+    if (xz == NULL) {
+	err(21, __func__, "called with NULL xz");
+	not_reached();
+    }
+    if (xz->error != NULL || !stream_header(xz)) {
+	return false;
+    }
+
+    /*
+     * compress any last partial block
+     */
+    if (xz->block[xz->blocks].in_len > 0) {
+	++xz->blocks;
+    }
+    if (xz->blocks > 0 && !write_blocks(xz)) {
+	return false;
+    }
+
+    /*
+     * index: indicator, number of records, records, padding and CRC32
+     */
+    count = dyn_array_tell(xz->records);
+    errno = 0;			/* pre-clear errno for errp() */
+    idx = malloc(16 + (size_t)count * 20);
+    if (idx == NULL) {
+	errp(22, __func__, "malloc of index of %jd records failed", count);
+	not_reached();
+    }
+    idx_len = 0;
+    idx[idx_len++] = 0x00;
+    idx_len += put_varint(idx + idx_len, (uint64_t)count);
+    for (i = 0; i < count; ++i) {
+	rec = dyn_array_addr(xz->records, struct xz_record, i);
+	idx_len += put_varint(idx + idx_len, rec->unpadded);
+	idx_len += put_varint(idx + idx_len, rec->uncompressed);
+    }
+    while (idx_len % 4 != 0) {
+	idx[idx_len++] = 0x00;
+    }
+    put_le32(idx + idx_len, crc32_update(xz->crc32_tbl, 0, idx, idx_len));
+    idx_len += 4;
+    ok = out_bytes(xz, idx, idx_len);
+    free(idx);
+    idx = NULL;
+    if (!ok) {
+	return false;
+    }
+
+    /*
+     * stream footer: CRC32, backward size, stream flags and magic
+     */
+    put_le32(footer + 4, (uint32_t)(idx_len / 4 - 1));
+    footer[8] = 0x00;
+    footer[9] = XZ_CHECK_CRC64;
+    put_le32(footer, crc32_update(xz->crc32_tbl, 0, footer + 4, 6));
+    footer[10] = 'Y';
+    footer[11] = 'Z';
+    if (!out_bytes(xz, footer, sizeof(footer))) {
+	return false;
+    }
+    dbg(DBG_HIGH, "%s: compressed %ju bytes to %ju bytes in %jd block%s", __func__,
+		  (uintmax_t)xz->in_total, (uintmax_t)xz->out_total, count, count == 1 ? "" : "s");
+
+    /*
+     * flush, and close if we opened it
+     */
+    if (fflush(xz->stream) != 0) {
+	return enc_fail(xz, "write error");
+    }
+    if (xz->close_stream) {
+	xz->close_stream = false;
+	if (fclose(xz->stream) != 0) {
+	    xz->stream = NULL;
+	    return enc_fail(xz, "close error");
+	}
+	xz->stream = NULL;
+    }
+    return true;
+}
+
+
+/*
+ * xz_writer_error - return what went wrong writing an xz file
+ *
+ * given:
+ *	xz	xz writer
+ *
+ * returns:
+ *	description of the error, or NULL if nothing went wrong
+ */
+char const *
+xz_writer_error(struct xz_writer const *xz)
+{
+    /*
+     * firewall
+     */
+    if (xz == NULL) {
+	err(23, __func__, "called with NULL xz");
+	not_reached();
+    }
+
+    return xz->error;
+}
+
+
+/*
+ * xz_writer_free - free an xz writer
+ *
+ * given:
+ *	xz	xz writer, may be NULL
+ *
+ * NOTE: the stream is closed only if xz_create() opened it and xz_finish()
+ *	 did not close it.
+ */
+void
+xz_writer_free(struct xz_writer *xz)
+{
+    unsigned int i;
+
+    if (xz == NULL) {
+	return;
+    }
+    if (xz->close_stream && xz->stream != NULL) {
+	(void) fclose(xz->stream);
+    }
+    if (xz->block != NULL) {
+	for (i = 0; i < xz->threads; ++i) {
+	    free(xz->block[i].in);
+	    free(xz->block[i].out);
+	    free(xz->block[i].head);
+	    free(xz->block[i].chain);
+	}
+	free(xz->block);
+	xz->block = NULL;
+    }
+    if (xz->records != NULL) {
+	dyn_array_free(xz->records);
+	xz->records = NULL;
+    }
+    free(xz);
+}
@@ -0,0 +1,161 @@
+/*
+ * xz_enc - write xz compressed files without the xz(1) tool
+ *
+ * "Home is behind, the world ahead,
+ *  And there are many paths to tread."
+ *
+ *	-- J.R.R. Tolkien
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_XZ_ENC_H)
+#    define  INCLUDE_XZ_ENC_H
+
+
+/*
+ * system includes
+ */
+#include <stdio.h>	    /* for FILE */
+#include <stdbool.h>	    /* for bool, true, false */
+#include <stdint.h>	    /* for int32_t, uint32_t and uint64_t */
+#include <pthread.h>	    /* for pthread_t */
+
+/*
+ * library related includes
+ */
+#include "../dbg/dbg.h"			/* dbg - info, debug, warning, error, and usage message facility */
+#include "../dyn_array/dyn_array.h"	/* dyn_array - dynamic array facility */
+
+/*
+ * xz_util - read xz compressed files without the xz(1) tool
+ */
+#include "xz_util.h"
+
+
+/*
+ * xz writer limits
+ *
+ * The input is cut into blocks of XZ_ENC_BLOCK_SIZE bytes that are each
+ * compressed on their own, so that threads can compress several blocks at
+ * the same time.  As where the blocks start does not depend on the number of
+ * threads, neither does the xz file: the same input always gives the same
+ * xz file, byte for byte.
+ */
+#define XZ_ENC_BLOCK_SIZE (2*1024*1024)	/* uncompressed size of each block but the last */
+#define XZ_ENC_DICT_PROP (18)		/* LZMA2 dictionary size property: 2 MiB, the block size */
+#define XZ_ENC_MAX_THREADS (16)		/* most threads an xz writer uses */
+
+/*
+ * LZMA2 chunk limits
+ */
+#define XZ_ENC_CHUNK_MAX (1 << 21)	/* most uncompressed bytes of an LZMA chunk */
+#define XZ_ENC_CHUNK_COMP_MAX (1 << 16)	/* most compressed bytes of an LZMA chunk */
+#define XZ_ENC_COPY_MAX (1 << 16)	/* most bytes of an uncompressed chunk */
+#define XZ_ENC_SYMBOL_MAX (64)		/* more than the compressed bytes of any LZMA symbol */
+
+/*
+ * LZMA encoder settings
+ *
+ * NOTE: lc=3, lp=0 and pb=2 are what xz(1) uses by default.
+ */
+#define XZ_ENC_LC (3)			/* number of literal context bits */
+#define XZ_ENC_LP (0)			/* number of literal position bits */
+#define XZ_ENC_PB (2)			/* number of position bits */
+#define XZ_ENC_HASH_BITS (16)		/* bits of the match finder hash of 3 bytes */
+#define XZ_ENC_DEPTH (48)		/* most earlier positions the match finder tries */
+#define XZ_ENC_NICE_LEN (64)		/* match length long enough to stop looking */
+
+
+/*
+ * struct xz_enc_block - a block of input and the xz block it compresses to
+ *
+ * The LZMA encoder state is here too, so that each thread has its own.
+ */
+struct xz_enc_block
+{
+    unsigned char *in;		/* uncompressed data of up to XZ_ENC_BLOCK_SIZE bytes */
+    size_t in_len;		/* number of bytes in in */
+    unsigned char *out;		/* xz block: header, LZMA2 data, padding and check */
+    size_t out_len;		/* length of the xz block */
+    uint64_t unpadded;		/* xz block length without the padding, for the index */
+    int32_t *head;		/* last position of each match finder hash, -1 ==> none */
+    int32_t *chain;		/* previous position with the same hash, for each position of in */
+    uint32_t const *crc32_tbl;	/* CRC32 table of the xz writer */
+    uint64_t const *crc64_tbl;	/* CRC64 table of the xz writer */
+    pthread_t thread;		/* thread compressing the block */
+
+    uint64_t low;		/* range encoder low */
+    uint32_t range;		/* range encoder range */
+    unsigned char cache;	/* range encoder byte not yet written */
+    uint64_t cache_size;	/* number of bytes to write for cache */
+    unsigned char *rc_out;	/* where the range encoder writes the current chunk */
+    size_t rc_pos;		/* number of bytes of the current chunk written */
+
+    unsigned int state;		/* LZMA state: 0 to XZ_LZMA_STATES-1 */
+    uint32_t rep[4];		/* most recent match distances - 1 */
+    struct xz_lzma_probs probs;	/* probabilities */
+};
+
+/*
+ * struct xz_writer - write an xz file
+ *
+ * Use xz_create() to form, xz_write() to write, xz_finish() to end
+ * the xz file and xz_writer_free() to free.
+ */
+struct xz_writer
+{
+    FILE *stream;		/* open stream of the xz file */
+    bool close_stream;		/* true ==> xz_finish() closes stream */
+    char const *error;		/* what went wrong, or NULL */
+
+    unsigned int threads;	/* number of blocks compressed at the same time */
+    struct xz_enc_block *block;	/* threads blocks */
+    unsigned int blocks;	/* number of full blocks waiting to be compressed */
+    struct dyn_array *records;	/* struct xz_record of each block written */
+    uint64_t in_total;		/* uncompressed bytes given to xz_write() */
+    uint64_t out_total;		/* compressed bytes written */
+
+    uint32_t crc32_tbl[256];	/* CRC32 table */
+    uint64_t crc64_tbl[256];	/* CRC64 table */
+};
+
+
+/*
+ * external function declarations
+ */
+extern struct xz_writer *xz_create(char const *path, unsigned int threads);
+extern struct xz_writer *xz_create_stream(FILE *stream, unsigned int threads);
+extern bool xz_write(struct xz_writer *xz, void const *buf, size_t len);
+extern bool xz_finish(struct xz_writer *xz);
+extern char const *xz_writer_error(struct xz_writer const *xz);
+extern void xz_writer_free(struct xz_writer *xz);
+
+
+#endif /* INCLUDE_XZ_ENC_H */
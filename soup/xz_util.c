@@ -0,0 +1,1605 @@
+/*
+ * xz_util - read xz compressed files without the xz(1) tool
+ *
+ * "It's a dangerous business, Frodo, going out your door. You step onto the
+ *  road, and if you don't keep your feet, there's no knowing where you might
+ *  be swept off to."
+ *
+ *	-- Bilbo Baggins, the Fellowship of the Ring.
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+/*
+ * system includes
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*
+ * xz_util - read xz compressed files without the xz(1) tool
+ */
+#include "xz_util.h"
+
+
+/*
+ * check_len - length of each of the 16 xz check types
+ */
+static uint32_t const check_len[16] = {
+    0, 4, 4, 4, 8, 8, 8, 16, 16, 16, 32, 32, 32, 64, 64, 64
+};
+
+/*
+ * sha256_k - SHA-256 round constants
+ */
+static uint32_t const sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/*
+ * xz stream header magic
+ */
+static unsigned char const xz_magic[6] = { 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+
+
+/*
+ * static declarations
+ */
+static bool xz_fail(struct xz_reader *xz, char const *msg);
+static int in_byte(struct xz_reader *xz);
+static bool in_bytes(struct xz_reader *xz, unsigned char *buf, size_t len);
+static bool in_varint(struct xz_reader *xz, uint64_t *val, uint32_t *crc);
+static uint32_t crc32_update(struct xz_reader const *xz, uint32_t crc, unsigned char const *buf, size_t len);
+static uint64_t crc64_update(struct xz_reader const *xz, uint64_t crc, unsigned char const *buf, size_t len);
+static uint32_t get_le32(unsigned char const *buf);
+static void sha256_init(struct xz_sha256 *sha);
+static void sha256_block(struct xz_sha256 *sha, unsigned char const *block);
+static void sha256_update(struct xz_sha256 *sha, unsigned char const *buf, size_t len);
+static void sha256_final(struct xz_sha256 *sha, unsigned char *digest);
+static bool stream_header(struct xz_reader *xz);
+static bool block_header(struct xz_reader *xz, unsigned int size_byte);
+static bool block_end(struct xz_reader *xz);
+static bool stream_index(struct xz_reader *xz);
+static bool stream_padding(struct xz_reader *xz);
+static bool chunk_header(struct xz_reader *xz);
+static bool chunk_lzma(struct xz_reader *xz);
+static bool chunk_copy(struct xz_reader *xz);
+static void check_update(struct xz_reader *xz, size_t start, size_t len);
+static void lzma_reset(struct xz_lzma *lz);
+static bool decode(struct xz_reader *xz);
+
+
+/*
+ * xz_fail - record why an xz file cannot be read
+ *
+ * given:
+ *	xz	xz reader
+ *	msg	what is wrong
+ *
+ * returns:
+ *	false
+ *
+ * NOTE: only the first failure is recorded.
+ */
+static bool
+xz_fail(struct xz_reader *xz, char const *msg)
+{
+    if (xz->state != XZ_STATE_ERROR) {
+	xz->state = XZ_STATE_ERROR;
+	xz->error = msg;
+	dbg(DBG_MED, "%s: %s at compressed offset %ju", __func__, msg, (uintmax_t)xz->in_total);
+    }
+    return false;
+}
+
+
+/*
+ * in_byte - return the next compressed byte
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	next byte, or -1 on EOF or read error
+ *
+ * NOTE: a read error is recorded with xz_fail(), a clean EOF is not.
+ */
+static int
+in_byte(struct xz_reader *xz)
+{
+    if (xz->in_pos >= xz->in_len) {
+	xz->in_pos = 0;
+	errno = 0;		/* pre-clear errno for errp() */
+	xz->in_len = fread(xz->in, 1, XZ_BUF_SIZE, xz->stream);
+	if (xz->in_len == 0) {
+	    if (ferror(xz->stream)) {
+		(void) xz_fail(xz, "read error");
+	    }
+	    return -1;
+	}
+    }
+    ++xz->in_total;
+    return xz->in[xz->in_pos++];
+}
+
+
+/*
+ * in_bytes - read compressed bytes
+ *
+ * given:
+ *	xz	xz reader
+ *	buf	where to read into
+ *	len	number of bytes to read
+ *
+ * returns:
+ *	true ==> len bytes were read, false ==> EOF or error (recorded with xz_fail())
+ */
+static bool
+in_bytes(struct xz_reader *xz, unsigned char *buf, size_t len)
+{
+    size_t i;
+    int c;
+
+    for (i = 0; i < len; ++i) {
+	c = in_byte(xz);
+	if (c < 0) {
+	    return xz_fail(xz, "unexpected end of file");
+	}
+	buf[i] = (unsigned char)c;
+    }
+    return true;
+}
+
+
+/*
+ * in_varint - read an xz variable length integer
+ *
+ * given:
+ *	xz	xz reader
+ *	val	where to store the integer
+ *	crc	if non-NULL, CRC32 to update with the bytes read
+ *
+ * returns:
+ *	true ==> integer read, false ==> error (recorded with xz_fail())
+ */
+static bool
+in_varint(struct xz_reader *xz, uint64_t *val, uint32_t *crc)
+{
+    unsigned char c;
+    unsigned int i;
+
+    *val = 0;
+    for (i = 0; i < 9; ++i) {
+	if (!in_bytes(xz, &c, 1)) {
+	    return false;
+	}
+	if (crc != NULL) {
+	    *crc = crc32_update(xz, *crc, &c, 1);
+	}
+	*val |= (uint64_t)(c & 0x7F) << (i * 7);
+	if ((c & 0x80) == 0) {
+	    /* a multibyte integer may not end with a zero byte */
+	    if (c == 0 && i > 0) {
+		return xz_fail(xz, "invalid variable length integer");
+	    }
+	    return true;
+	}
+    }
+    return xz_fail(xz, "variable length integer too long");
+}
+
+
+/*
+ * crc32_update - update a CRC32 with bytes
+ */
+static uint32_t
+crc32_update(struct xz_reader const *xz, uint32_t crc, unsigned char const *buf, size_t len)
+{
+    crc = ~crc;
+    while (len-- > 0) {
+	crc = xz->crc32_tbl[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+/*
+ * crc64_update - update a CRC64 with bytes
+ */
+static uint64_t
+crc64_update(struct xz_reader const *xz, uint64_t crc, unsigned char const *buf, size_t len)
+{
+    crc = ~crc;
+    while (len-- > 0) {
+	crc = xz->crc64_tbl[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+
+/*
+ * get_le32 - return a little endian 32 bit value
+ */
+static uint32_t
+get_le32(unsigned char const *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+
+/*
+ * sha256_init - start a SHA-256
+ */
+static void
+sha256_init(struct xz_sha256 *sha)
+{
+    sha->hash[0] = 0x6a09e667;
+    sha->hash[1] = 0xbb67ae85;
+    sha->hash[2] = 0x3c6ef372;
+    sha->hash[3] = 0xa54ff53a;
+    sha->hash[4] = 0x510e527f;
+    sha->hash[5] = 0x9b05688c;
+    sha->hash[6] = 0x1f83d9ab;
+    sha->hash[7] = 0x5be0cd19;
+    sha->buf_len = 0;
+    sha->total = 0;
+}
+
+
+/*
+ * SHA-256 bit operations
+ */
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_S0(x) (SHA256_ROTR(x, 2) ^ SHA256_ROTR(x, 13) ^ SHA256_ROTR(x, 22))
+#define SHA256_S1(x) (SHA256_ROTR(x, 6) ^ SHA256_ROTR(x, 11) ^ SHA256_ROTR(x, 25))
+#define SHA256_G0(x) (SHA256_ROTR(x, 7) ^ SHA256_ROTR(x, 18) ^ ((x) >> 3))
+#define SHA256_G1(x) (SHA256_ROTR(x, 17) ^ SHA256_ROTR(x, 19) ^ ((x) >> 10))
+
+
+/*
+ * sha256_block - hash one 64 byte message block
+ */
+static void
+sha256_block(struct xz_sha256 *sha, unsigned char const *block)
+{
+    uint32_t w[64];		/* message schedule */
+    uint32_t v[8];		/* working variables a to h */
+    uint32_t t1;
+    uint32_t t2;
+    unsigned int i;
+
+    for (i = 0; i < 16; ++i) {
+	w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+	       ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+    }
+    for (i = 16; i < 64; ++i) {
+	w[i] = SHA256_G1(w[i - 2]) + w[i - 7] + SHA256_G0(w[i - 15]) + w[i - 16];
+    }
+    memcpy(v, sha->hash, sizeof(v));
+    for (i = 0; i < 64; ++i) {
+	t1 = v[7] + SHA256_S1(v[4]) + ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256_k[i] + w[i];
+	t2 = SHA256_S0(v[0]) + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+	memmove(v + 1, v, 7 * sizeof(v[0]));
+	v[4] += t1;
+	v[0] = t1 + t2;
+    }
+    for (i = 0; i < 8; ++i) {
+	sha->hash[i] += v[i];
+    }
+}
+
+
+/*
+ * sha256_update - add bytes to a SHA-256
+ */
+static void
+sha256_update(struct xz_sha256 *sha, unsigned char const *buf, size_t len)
+{
+    size_t n;
+
+    sha->total += len;
+    while (len > 0) {
+	n = sizeof(sha->buf) - sha->buf_len;
+	if (n > len) {
+	    n = len;
+	}
+	memcpy(sha->buf + sha->buf_len, buf, n);
+	sha->buf_len += n;
+	buf += n;
+	len -= n;
+	if (sha->buf_len == sizeof(sha->buf)) {
+	    sha256_block(sha, sha->buf);
+	    sha->buf_len = 0;
+	}
+    }
+}
+
+
+/*
+ * sha256_final - finish a SHA-256
+ *
+ * given:
+ *	sha	SHA-256 to finish
+ *	digest	where to write the XZ_SHA256_LEN byte hash
+ */
+static void
+sha256_final(struct xz_sha256 *sha, unsigned char *digest)
+{
+    uint64_t bits;		/* message length in bits */
+    unsigned int i;
+
+    bits = sha->total * 8;
+    sha->buf[sha->buf_len++] = 0x80;
+    if (sha->buf_len > sizeof(sha->buf) - 8) {
+	memset(sha->buf + sha->buf_len, 0, sizeof(sha->buf) - sha->buf_len);
+	sha256_block(sha, sha->buf);
+	sha->buf_len = 0;
+    }
+    memset(sha->buf + sha->buf_len, 0, sizeof(sha->buf) - 8 - sha->buf_len);
+    for (i = 0; i < 8; ++i) {
+	sha->buf[sizeof(sha->buf) - 1 - i] = (unsigned char)(bits >> (i * 8));
+    }
+    sha256_block(sha, sha->buf);
+    for (i = 0; i < 8; ++i) {
+	digest[i * 4] = (unsigned char)(sha->hash[i] >> 24);
+	digest[i * 4 + 1] = (unsigned char)(sha->hash[i] >> 16);
+	digest[i * 4 + 2] = (unsigned char)(sha->hash[i] >> 8);
+	digest[i * 4 + 3] = (unsigned char)sha->hash[i];
+    }
+}
+
+
+/*
+ * stream_header - read an xz stream header
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> header read and valid, false ==> error (recorded with xz_fail())
+ */
+static bool
+stream_header(struct xz_reader *xz)
+{
+    unsigned char hdr[XZ_HEADER_LEN];
+
+    if (!in_bytes(xz, hdr, sizeof(hdr))) {
+	return false;
+    }
+    if (memcmp(hdr, xz_magic, sizeof(xz_magic)) != 0) {
+	return xz_fail(xz, "not an xz file");
+    }
+    if (hdr[6] != 0 || (hdr[7] & 0xF0) != 0) {
+	return xz_fail(xz, "unsupported stream flags");
+    }
+    if (crc32_update(xz, 0, hdr + 6, 2) != get_le32(hdr + 8)) {
+	return xz_fail(xz, "stream header CRC32 mismatch");
+    }
+    xz->check_type = hdr[7];
+    switch (xz->check_type) {
+    case XZ_CHECK_NONE:
+    case XZ_CHECK_CRC32:
+    case XZ_CHECK_CRC64:
+    case XZ_CHECK_SHA256:
+	break;
+    default:
+	/* xz(1) only writes the above check types: we cannot verify others */
+	return xz_fail(xz, "unsupported check type");
+    }
+    dyn_array_clear(xz->records);
+    xz->state = XZ_STATE_BLOCK;
+    return true;
+}
+
+
+/*
+ * block_header - read an xz block header
+ *
+ * given:
+ *	xz		xz reader
+ *	size_byte	first (already read) byte of the block header
+ *
+ * returns:
+ *	true ==> header read and valid, false ==> error (recorded with xz_fail())
+ *
+ * NOTE: only blocks whose sole filter is LZMA2 are supported: that is
+ *	 what xz(1) and tar -J write unless told to use other filters.
+ */
+static bool
+block_header(struct xz_reader *xz, unsigned int size_byte)
+{
+    unsigned char hdr[XZ_BLOCK_HEADER_MAX];
+    uint32_t len;		/* block header length */
+    uint32_t pos;		/* position in hdr */
+    uint64_t val;		/* parsed variable length integer */
+    unsigned int shift;		/* variable length integer shift */
+    unsigned int i;
+    unsigned int props;		/* LZMA2 dictionary size property */
+    uint32_t dict_size;		/* dictionary size */
+    size_t alloc;		/* dictionary ring size */
+
+    len = (size_byte + 1) * 4;
+    hdr[0] = (unsigned char)size_byte;
+    if (!in_bytes(xz, hdr + 1, len - 1)) {
+	return false;
+    }
+    if (crc32_update(xz, 0, hdr, len - 4) != get_le32(hdr + len - 4)) {
+	return xz_fail(xz, "block header CRC32 mismatch");
+    }
+    if ((hdr[1] & 0x3C) != 0) {
+	return xz_fail(xz, "unsupported block flags");
+    }
+    if ((hdr[1] & 0x03) != 0) {
+	return xz_fail(xz, "unsupported filter chain");
+    }
+
+    /*
+     * parse the optional sizes and the filter from the header
+     */
+    xz->has_comp_size = (hdr[1] & 0x40) != 0;
+    xz->has_uncomp_size = (hdr[1] & 0x80) != 0;
+    pos = 2;
+    for (i = 0; i < 4; ++i) {
+	if (i == 0 && !xz->has_comp_size) {
+	    continue;
+	}
+	if (i == 1 && !xz->has_uncomp_size) {
+	    continue;
+	}
+	val = 0;
+	shift = 0;
+	do {
+	    if (pos >= len - 4 || shift > 56) {
+		return xz_fail(xz, "invalid block header");
+	    }
+	    val |= (uint64_t)(hdr[pos] & 0x7F) << shift;
+	    shift += 7;
+	} while ((hdr[pos++] & 0x80) != 0);
+	switch (i) {
+	case 0:
+	    xz->comp_size = val;
+	    break;
+	case 1:
+	    xz->uncomp_size = val;
+	    break;
+	case 2:
+	    if (val != XZ_FILTER_LZMA2) {
+		return xz_fail(xz, "unsupported filter");
+	    }
+	    break;
+	case 3:
+	    if (val != 1) {
+		return xz_fail(xz, "invalid LZMA2 filter properties");
+	    }
+	    break;
+	}
+    }
+    if (pos >= len - 4) {
+	return xz_fail(xz, "invalid block header");
+    }
+    props = hdr[pos++];
+    for (; pos < len - 4; ++pos) {
+	if (hdr[pos] != 0) {
+	    return xz_fail(xz, "invalid block header padding");
+	}
+    }
+
+    /*
+     * size the dictionary
+     */
+    if (props > 40) {
+	return xz_fail(xz, "invalid LZMA2 dictionary size");
+    } else if (props == 40) {
+	dict_size = UINT32_MAX;
+    } else {
+	dict_size = (uint32_t)(2 | (props & 1)) << (props / 2 + 11);
+    }
+    if (xz->has_uncomp_size && xz->uncomp_size < dict_size) {
+	dict_size = (uint32_t)xz->uncomp_size;
+    }
+    if (dict_size > XZ_DICT_MAX) {
+	return xz_fail(xz, "LZMA2 dictionary too large");
+    }
+    if (dict_size < 4096) {
+	dict_size = 4096;
+    }
+    alloc = (size_t)dict_size + XZ_DICT_SLACK;
+    if (alloc > xz->dict_alloc) {
+	free(xz->dict);
+	errno = 0;		/* pre-clear errno for errp() */
+	xz->dict = malloc(alloc);
+	if (xz->dict == NULL) {
+	    errp(10, __func__, "malloc of %zu byte dictionary failed", alloc);
+	    not_reached();
+	}
+	xz->dict_alloc = alloc;
+    }
+    xz->dict_size = dict_size;
+    xz->dict_pos = 0;
+    xz->dict_pending = 0;
+    xz->dict_full = 0;
+
+    xz->header_len = len;
+    xz->block_in = xz->in_total;
+    xz->block_out = 0;
+    xz->crc32 = 0;
+    xz->crc64 = 0;
+    sha256_init(&xz->sha256);
+    xz->need_dict_reset = true;
+    xz->need_props = true;
+    xz->state = XZ_STATE_CHUNK;
+    return true;
+}
+
+
+/*
+ * block_end - read the padding and check of an xz block
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> block valid, false ==> error (recorded with xz_fail())
+ */
+static bool
+block_end(struct xz_reader *xz)
+{
+    unsigned char check[XZ_CHECK_MAX];
+    unsigned char digest[XZ_SHA256_LEN];	/* computed SHA-256 */
+    struct xz_record rec;	/* sizes of this block */
+    uint64_t data;		/* compressed data size */
+    uint64_t comp;		/* compressed data size with padding */
+    uint32_t len;		/* check length */
+    uint64_t crc64;		/* stored CRC64 */
+    unsigned int i;
+
+    data = xz->in_total - xz->block_in;
+    if (xz->has_comp_size && data != xz->comp_size) {
+	return xz_fail(xz, "block compressed size mismatch");
+    }
+    if (xz->has_uncomp_size && xz->block_out != xz->uncomp_size) {
+	return xz_fail(xz, "block uncompressed size mismatch");
+    }
+    for (comp = data; (comp & 3) != 0; ++comp) {
+	if (!in_bytes(xz, check, 1)) {
+	    return false;
+	}
+	if (check[0] != 0) {
+	    return xz_fail(xz, "invalid block padding");
+	}
+    }
+
+    len = check_len[xz->check_type];
+    if (!in_bytes(xz, check, len)) {
+	return false;
+    }
+    if (xz->check_type == XZ_CHECK_CRC32) {
+	if (get_le32(check) != xz->crc32) {
+	    return xz_fail(xz, "CRC32 mismatch of uncompressed data");
+	}
+    } else if (xz->check_type == XZ_CHECK_CRC64) {
+	crc64 = 0;
+	for (i = 0; i < 8; ++i) {
+	    crc64 |= (uint64_t)check[i] << (i * 8);
+	}
+	if (crc64 != xz->crc64) {
+	    return xz_fail(xz, "CRC64 mismatch of uncompressed data");
+	}
+    } else if (xz->check_type == XZ_CHECK_SHA256) {
+	sha256_final(&xz->sha256, digest);
+	if (memcmp(check, digest, sizeof(digest)) != 0) {
+	    return xz_fail(xz, "SHA-256 mismatch of uncompressed data");
+	}
+    }
+
+    /*
+     * record the block for the check against the index
+     */
+    rec.unpadded = xz->header_len + data + len;
+    rec.uncompressed = xz->block_out;
+    (void) dyn_array_append_value(xz->records, &rec);
+    xz->state = XZ_STATE_BLOCK;
+    return true;
+}
+
+
+/*
+ * stream_index - read and verify an xz index and stream footer
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> index and footer valid, false ==> error (recorded with xz_fail())
+ *
+ * NOTE: the index indicator (a zero byte where a block header would be)
+ *	 has already been read.
+ */
+static bool
+stream_index(struct xz_reader *xz)
+{
+    unsigned char buf[XZ_HEADER_LEN];	/* index CRC32 and stream footer */
+    unsigned char c;			/* index byte */
+    struct xz_record *rec;		/* recorded block sizes */
+    uint64_t start;			/* in_total at the index indicator */
+    uint64_t count;			/* number of index records */
+    uint64_t unpadded;			/* unpadded size of an index record */
+    uint64_t uncompressed;		/* uncompressed size of an index record */
+    uint64_t len;			/* index length */
+    uint32_t crc;			/* index CRC32 */
+    uint64_t i;
+
+    start = xz->in_total - 1;
+    c = 0;
+    crc = crc32_update(xz, 0, &c, 1);
+    if (!in_varint(xz, &count, &crc)) {
+	return false;
+    }
+    if (count != (uint64_t)dyn_array_tell(xz->records)) {
+	return xz_fail(xz, "index block count mismatch");
+    }
+    for (i = 0; i < count; ++i) {
+	if (!in_varint(xz, &unpadded, &crc) || !in_varint(xz, &uncompressed, &crc)) {
+	    return false;
+	}
+	rec = dyn_array_addr(xz->records, struct xz_record, i);
+	if (unpadded != rec->unpadded || uncompressed != rec->uncompressed) {
+	    return xz_fail(xz, "index does not match blocks");
+	}
+    }
+    while (((xz->in_total - start) & 3) != 0) {
+	if (!in_bytes(xz, &c, 1)) {
+	    return false;
+	}
+	if (c != 0) {
+	    return xz_fail(xz, "invalid index padding");
+	}
+	crc = crc32_update(xz, crc, &c, 1);
+    }
+    len = xz->in_total - start + 4;
+    if (!in_bytes(xz, buf, 4)) {
+	return false;
+    }
+    if (get_le32(buf) != crc) {
+	return xz_fail(xz, "index CRC32 mismatch");
+    }
+
+    /*
+     * stream footer
+     */
+    if (!in_bytes(xz, buf, XZ_HEADER_LEN)) {
+	return false;
+    }
+    if (buf[10] != 'Y' || buf[11] != 'Z') {
+	return xz_fail(xz, "invalid stream footer");
+    }
+    if (crc32_update(xz, 0, buf + 4, 6) != get_le32(buf)) {
+	return xz_fail(xz, "stream footer CRC32 mismatch");
+    }
+    if (((uint64_t)get_le32(buf + 4) + 1) * 4 != len) {
+	return xz_fail(xz, "stream footer index size mismatch");
+    }
+    if (buf[8] != 0 || buf[9] != xz->check_type) {
+	return xz_fail(xz, "stream footer flags mismatch");
+    }
+    xz->state = XZ_STATE_PADDING;
+    return true;
+}
+
+
+/*
+ * stream_padding - read stream padding, up to another stream or EOF
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> padding valid, false ==> error (recorded with xz_fail())
+ */
+static bool
+stream_padding(struct xz_reader *xz)
+{
+    uint64_t pad;		/* stream padding length */
+    int c;
+
+    for (pad = 0; ; ++pad) {
+	c = in_byte(xz);
+	if (c < 0) {
+	    if (xz->state == XZ_STATE_ERROR) {
+		return false;
+	    }
+	    if ((pad & 3) != 0) {
+		return xz_fail(xz, "invalid stream padding");
+	    }
+	    xz->state = XZ_STATE_DONE;
+	    return true;
+	}
+	if (c != 0) {
+	    break;
+	}
+    }
+    if ((pad & 3) != 0) {
+	return xz_fail(xz, "invalid stream padding");
+    }
+
+    /*
+     * push back the first byte of the next stream
+     */
+    --xz->in_pos;
+    --xz->in_total;
+    xz->state = XZ_STATE_STREAM;
+    return true;
+}
+
+
+/*
+ * chunk_header - read an LZMA2 chunk header
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> header valid, false ==> error (recorded with xz_fail())
+ */
+static bool
+chunk_header(struct xz_reader *xz)
+{
+    unsigned char hdr[5];	/* chunk header bytes */
+    unsigned int control;	/* chunk control byte */
+    unsigned int props;		/* lc, lp and pb properties */
+
+    if (!in_bytes(xz, hdr, 1)) {
+	return false;
+    }
+    control = hdr[0];
+    if (control == 0x00) {
+	return block_end(xz);
+    }
+
+    /*
+     * dictionary reset
+     */
+    if (control >= 0xE0 || control == 0x01) {
+	xz->need_props = true;
+	xz->need_dict_reset = false;
+	xz->dict_full = 0;
+    } else if (xz->need_dict_reset) {
+	return xz_fail(xz, "missing LZMA2 dictionary reset");
+    }
+
+    /*
+     * uncompressed chunk
+     */
+    if (control < 0x80) {
+	if (control > 0x02) {
+	    return xz_fail(xz, "invalid LZMA2 chunk");
+	}
+	if (!in_bytes(xz, hdr, 2)) {
+	    return false;
+	}
+	xz->chunk_left = (((uint32_t)hdr[0] << 8) | hdr[1]) + 1;
+	xz->state = XZ_STATE_COPY;
+	return true;
+    }
+
+    /*
+     * LZMA chunk
+     */
+    if (!in_bytes(xz, hdr, 4)) {
+	return false;
+    }
+    xz->chunk_left = ((uint32_t)(control & 0x1F) << 16) + ((uint32_t)hdr[0] << 8) + hdr[1] + 1;
+    xz->chunk_comp = (((uint32_t)hdr[2] << 8) | hdr[3]) + 1;
+    if (control >= 0xC0) {
+	if (!in_bytes(xz, hdr, 1)) {
+	    return false;
+	}
+	props = hdr[0];
+	if (props >= 9 * 5 * 5) {
+	    return xz_fail(xz, "invalid LZMA properties");
+	}
+	xz->lzma.lc = props % 9;
+	props /= 9;
+	xz->lzma.lp = props % 5;
+	xz->lzma.pb = props / 5;
+	if (xz->lzma.lc + xz->lzma.lp > XZ_LZMA_LCLP_MAX) {
+	    return xz_fail(xz, "invalid LZMA properties");
+	}
+	xz->need_props = false;
+    } else if (xz->need_props) {
+	return xz_fail(xz, "missing LZMA properties");
+    }
+    if (control >= 0xA0) {
+	lzma_reset(&xz->lzma);
+    }
+
+    /*
+     * start the range decoder
+     */
+    xz->chunk_in = xz->in_total;
+    if (!in_bytes(xz, hdr, 5)) {
+	return false;
+    }
+    xz->lzma.range = UINT32_MAX;
+    xz->lzma.code = ((uint32_t)hdr[1] << 24) | ((uint32_t)hdr[2] << 16) | ((uint32_t)hdr[3] << 8) | hdr[4];
+    if (hdr[0] != 0 || xz->lzma.code == xz->lzma.range) {
+	return xz_fail(xz, "invalid LZMA chunk");
+    }
+    xz->state = XZ_STATE_LZMA;
+    return true;
+}
+
+
+/*
+ * dict_put - add a decoded byte to the dictionary
+ */
+static inline void
+dict_put(struct xz_reader *xz, unsigned char c)
+{
+    xz->dict[xz->dict_pos] = c;
+    if (++xz->dict_pos == xz->dict_alloc) {
+	xz->dict_pos = 0;
+    }
+    ++xz->dict_full;
+    ++xz->dict_pending;
+}
+
+
+/*
+ * dict_get - return the decoded byte dist bytes back (dist >= 1)
+ */
+static inline unsigned char
+dict_get(struct xz_reader const *xz, uint32_t dist)
+{
+    return xz->dict[xz->dict_pos >= dist ? xz->dict_pos - dist : xz->dict_pos + xz->dict_alloc - dist];
+}
+
+
+/*
+ * check_update - update the block check with newly decoded bytes
+ *
+ * given:
+ *	xz	xz reader
+ *	start	index in dict of the first new byte
+ *	len	number of new bytes
+ */
+static void
+check_update(struct xz_reader *xz, size_t start, size_t len)
+{
+    size_t first;		/* bytes before the end of the dictionary ring */
+
+    xz->block_out += len;
+    first = xz->dict_alloc - start;
+    if (first > len) {
+	first = len;
+    }
+    switch (xz->check_type) {
+    case XZ_CHECK_CRC32:
+	xz->crc32 = crc32_update(xz, xz->crc32, xz->dict + start, first);
+	xz->crc32 = crc32_update(xz, xz->crc32, xz->dict, len - first);
+	break;
+    case XZ_CHECK_CRC64:
+	xz->crc64 = crc64_update(xz, xz->crc64, xz->dict + start, first);
+	xz->crc64 = crc64_update(xz, xz->crc64, xz->dict, len - first);
+	break;
+    case XZ_CHECK_SHA256:
+	sha256_update(&xz->sha256, xz->dict + start, first);
+	sha256_update(&xz->sha256, xz->dict, len - first);
+	break;
+    default:
+	break;
+    }
+}
+
+
+/*
+ * chunk_copy - copy uncompressed chunk data into the dictionary
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> data copied, false ==> error (recorded with xz_fail())
+ */
+static bool
+chunk_copy(struct xz_reader *xz)
+{
+    size_t start;		/* index in dict of the first copied byte */
+    size_t len;			/* bytes to copy */
+    size_t i;
+    int c;
+
+    start = xz->dict_pos;
+    len = XZ_DICT_SLACK - xz->dict_pending;
+    if (len > xz->chunk_left) {
+	len = xz->chunk_left;
+    }
+    for (i = 0; i < len; ++i) {
+	c = in_byte(xz);
+	if (c < 0) {
+	    return xz_fail(xz, "unexpected end of file");
+	}
+	dict_put(xz, (unsigned char)c);
+    }
+    check_update(xz, start, len);
+    xz->chunk_left -= (uint32_t)len;
+    if (xz->chunk_left == 0) {
+	xz->state = XZ_STATE_CHUNK;
+    }
+    return true;
+}
+
+
+/*
+ * rc_in - return the next compressed byte for the range decoder
+ */
+static inline uint32_t
+rc_in(struct xz_reader *xz)
+{
+    int c;
+
+    c = in_byte(xz);
+    if (c < 0) {
+	(void) xz_fail(xz, "unexpected end of file");
+	return 0;
+    }
+    return (uint32_t)c;
+}
+
+
+/*
+ * rc_bit - decode a bit with a probability
+ */
+static inline unsigned int
+rc_bit(struct xz_reader *xz, uint16_t *prob)
+{
+    struct xz_lzma *lz = &xz->lzma;
+    uint32_t bound;
+    unsigned int bit;
+
+    bound = (lz->range >> RC_MODEL_BITS) * *prob;
+    if (lz->code < bound) {
+	*prob = (uint16_t)(*prob + (((1U << RC_MODEL_BITS) - *prob) >> RC_MOVE_BITS));
+	lz->range = bound;
+	bit = 0;
+    } else {
+	*prob = (uint16_t)(*prob - (*prob >> RC_MOVE_BITS));
+	lz->code -= bound;
+	lz->range -= bound;
+	bit = 1;
+    }
+    if (lz->range < RC_TOP) {
+	lz->range <<= 8;
+	lz->code = (lz->code << 8) | rc_in(xz);
+    }
+    return bit;
+}
+
+
+/*
+ * rc_direct - decode bits with a fixed probability of 0.5
+ */
+static inline uint32_t
+rc_direct(struct xz_reader *xz, unsigned int bits)
+{
+    struct xz_lzma *lz = &xz->lzma;
+    uint32_t res = 0;
+    uint32_t t;
+
+    do {
+	lz->range >>= 1;
+	lz->code -= lz->range;
+	t = 0U - (lz->code >> 31);
+	lz->code += lz->range & t;
+	if (lz->code == lz->range) {
+	    (void) xz_fail(xz, "LZMA data error");
+	}
+	if (lz->range < RC_TOP) {
+	    lz->range <<= 8;
+	    lz->code = (lz->code << 8) | rc_in(xz);
+	}
+	res = (res << 1) + (t + 1);
+    } while (--bits > 0);
+    return res;
+}
+
+
+/*
+ * rc_tree - decode a bits long symbol, most significant bit first
+ */
+static inline uint32_t
+rc_tree(struct xz_reader *xz, uint16_t *probs, unsigned int bits)
+{
+    uint32_t m = 1;
+    unsigned int i;
+
+    for (i = 0; i < bits; ++i) {
+	m = (m << 1) + rc_bit(xz, &probs[m]);
+    }
+    return m - (1U << bits);
+}
+
+
+/*
+ * rc_tree_rev - decode a bits long symbol, least significant bit first
+ */
+static inline uint32_t
+rc_tree_rev(struct xz_reader *xz, uint16_t *probs, unsigned int bits)
+{
+    uint32_t m = 1;
+    uint32_t sym = 0;
+    unsigned int bit;
+    unsigned int i;
+
+    for (i = 0; i < bits; ++i) {
+	bit = rc_bit(xz, &probs[m]);
+	m = (m << 1) + bit;
+	sym |= bit << i;
+    }
+    return sym;
+}
+
+
+/*
+ * lzma_len - decode an LZMA match length - 2
+ */
+static inline uint32_t
+lzma_len(struct xz_reader *xz, struct xz_lzma_len *len, uint32_t pos_state)
+{
+    if (rc_bit(xz, &len->choice) == 0) {
+	return rc_tree(xz, len->low[pos_state], 3);
+    }
+    if (rc_bit(xz, &len->choice2) == 0) {
+	return 8 + rc_tree(xz, len->mid[pos_state], 3);
+    }
+    return 16 + rc_tree(xz, len->high, 8);
+}
+
+
+/*
+ * lzma_dist - decode an LZMA match distance - 1
+ */
+static inline uint32_t
+lzma_dist(struct xz_reader *xz, uint32_t len)
+{
+    struct xz_lzma_probs *p = &xz->lzma.probs;
+    uint32_t slot;		/* distance slot */
+    unsigned int bits;		/* number of bits below the top two */
+    uint32_t dist;
+
+    slot = rc_tree(xz, p->pos_slot[len < XZ_LZMA_LEN_TO_POS_STATES - 1 ? len : XZ_LZMA_LEN_TO_POS_STATES - 1], 6);
+    if (slot < 4) {
+	return slot;
+    }
+    bits = (slot >> 1) - 1;
+    dist = (2 | (slot & 1)) << bits;
+    if (slot < XZ_LZMA_END_POS_MODEL) {
+	dist += rc_tree_rev(xz, p->pos_special + dist - slot, bits);
+    } else {
+	dist += rc_direct(xz, bits - XZ_LZMA_ALIGN_BITS) << XZ_LZMA_ALIGN_BITS;
+	dist += rc_tree_rev(xz, p->align, XZ_LZMA_ALIGN_BITS);
+    }
+    return dist;
+}
+
+
+/*
+ * lzma_reset - reset the LZMA state and probabilities
+ */
+static void
+lzma_reset(struct xz_lzma *lz)
+{
+    uint16_t *prob;
+    size_t i;
+
+    lz->state = 0;
+    lz->rep[0] = lz->rep[1] = lz->rep[2] = lz->rep[3] = 0;
+    prob = (uint16_t *)&lz->probs;
+    for (i = 0; i < sizeof(lz->probs) / sizeof(uint16_t); ++i) {
+	prob[i] = RC_MODEL_INIT;
+    }
+}
+
+
+/*
+ * chunk_lzma - decode LZMA chunk data into the dictionary
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> data decoded, false ==> error (recorded with xz_fail())
+ *
+ * NOTE: we decode until the chunk ends or the dictionary slack might not
+ *	 hold another match: xz_read() then copies out what we decoded.
+ */
+static bool
+chunk_lzma(struct xz_reader *xz)
+{
+    struct xz_lzma *lz = &xz->lzma;
+    struct xz_lzma_probs *p = &lz->probs;
+    size_t start;		/* index in dict of the first decoded byte */
+    size_t pending;		/* dict_pending at start */
+    uint32_t pos_state;		/* position state */
+    uint16_t *probs;		/* literal coder probabilities */
+    unsigned int prev;		/* previous byte */
+    unsigned int sym;		/* literal symbol */
+    unsigned int match_byte;	/* byte at rep[0] for a literal after a match */
+    unsigned int match_bit;	/* top bit of match_byte */
+    unsigned int bit;
+    uint32_t len;		/* match length */
+    uint32_t dist;		/* match distance - 1 */
+
+    start = xz->dict_pos;
+    pending = xz->dict_pending;
+    while (xz->chunk_left > 0 && xz->dict_pending + XZ_LZMA_MATCH_LEN_MAX <= XZ_DICT_SLACK &&
+	   xz->state == XZ_STATE_LZMA) {
+
+	pos_state = (uint32_t)xz->dict_full & ((1U << lz->pb) - 1);
+
+	/*
+	 * literal
+	 */
+	if (rc_bit(xz, &p->is_match[lz->state][pos_state]) == 0) {
+	    prev = xz->dict_full > 0 ? dict_get(xz, 1) : 0;
+	    probs = p->literal + XZ_LZMA_LITERAL_CODER *
+		    ((((uint32_t)xz->dict_full & ((1U << lz->lp) - 1)) << lz->lc) + (prev >> (8 - lz->lc)));
+	    sym = 1;
+	    if (lz->state >= 7) {
+		if (lz->rep[0] >= xz->dict_full) {
+		    return xz_fail(xz, "LZMA distance beyond dictionary");
+		}
+		match_byte = dict_get(xz, lz->rep[0] + 1);
+		do {
+		    match_bit = (match_byte >> 7) & 1;
+		    match_byte <<= 1;
+		    bit = rc_bit(xz, &probs[((1 + match_bit) << 8) + sym]);
+		    sym = (sym << 1) | bit;
+		    if (match_bit != bit) {
+			break;
+		    }
+		} while (sym < 0x100);
+	    }
+	    while (sym < 0x100) {
+		sym = (sym << 1) | rc_bit(xz, &probs[sym]);
+	    }
+	    dict_put(xz, (unsigned char)sym);
+	    --xz->chunk_left;
+	    lz->state = lz->state < 4 ? 0 : (lz->state < 10 ? lz->state - 3 : lz->state - 6);
+	    continue;
+	}
+
+	/*
+	 * match
+	 */
+	if (rc_bit(xz, &p->is_rep[lz->state]) == 0) {
+	    len = lzma_len(xz, &p->match_len, pos_state);
+	    lz->state = lz->state < 7 ? 7 : 10;
+	    dist = lzma_dist(xz, len);
+	    if (dist == UINT32_MAX) {
+		return xz_fail(xz, "unexpected LZMA end marker");
+	    }
+	    lz->rep[3] = lz->rep[2];
+	    lz->rep[2] = lz->rep[1];
+	    lz->rep[1] = lz->rep[0];
+	    lz->rep[0] = dist;
+
+	/*
+	 * repeated match
+	 */
+	} else {
+	    if (xz->dict_full == 0) {
+		return xz_fail(xz, "LZMA data error");
+	    }
+	    if (rc_bit(xz, &p->is_rep_g0[lz->state]) == 0) {
+		if (rc_bit(xz, &p->is_rep0_long[lz->state][pos_state]) == 0) {
+		    /* short repeat: a single byte */
+		    if (lz->rep[0] >= xz->dict_full) {
+			return xz_fail(xz, "LZMA distance beyond dictionary");
+		    }
+		    lz->state = lz->state < 7 ? 9 : 11;
+		    dict_put(xz, dict_get(xz, lz->rep[0] + 1));
+		    --xz->chunk_left;
+		    continue;
+		}
+	    } else {
+		if (rc_bit(xz, &p->is_rep_g1[lz->state]) == 0) {
+		    dist = lz->rep[1];
+		} else {
+		    if (rc_bit(xz, &p->is_rep_g2[lz->state]) == 0) {
+			dist = lz->rep[2];
+		    } else {
+			dist = lz->rep[3];
+			lz->rep[3] = lz->rep[2];
+		    }
+		    lz->rep[2] = lz->rep[1];
+		}
+		lz->rep[1] = lz->rep[0];
+		lz->rep[0] = dist;
+	    }
+	    len = lzma_len(xz, &p->rep_len, pos_state);
+	    lz->state = lz->state < 7 ? 8 : 11;
+	}
+
+	/*
+	 * copy the match
+	 */
+	len += 2;
+	if (lz->rep[0] >= xz->dict_full || lz->rep[0] >= xz->dict_size) {
+	    return xz_fail(xz, "LZMA distance beyond dictionary");
+	}
+	if (len > xz->chunk_left) {
+	    return xz_fail(xz, "LZMA match beyond chunk");
+	}
+	xz->chunk_left -= len;
+	dist = lz->rep[0] + 1;
+	while (len-- > 0) {
+	    dict_put(xz, dict_get(xz, dist));
+	}
+    }
+    if (xz->state != XZ_STATE_LZMA) {
+	return false;
+    }
+    check_update(xz, start, xz->dict_pending - pending);
+
+    /*
+     * the compressed size must match the chunk header when the chunk ends
+     */
+    if (xz->in_total - xz->chunk_in > xz->chunk_comp) {
+	return xz_fail(xz, "LZMA chunk compressed size mismatch");
+    }
+    if (xz->chunk_left == 0) {
+	if (xz->in_total - xz->chunk_in != xz->chunk_comp || lz->code != 0) {
+	    return xz_fail(xz, "LZMA chunk compressed size mismatch");
+	}
+	xz->state = XZ_STATE_CHUNK;
+    }
+    return true;
+}
+
+
+/*
+ * decode - decode the next part of an xz file
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> part decoded, false ==> error (recorded with xz_fail())
+ *
+ * NOTE: this function must only be called when no decoded bytes are
+ *	 pending, as a new block header resets the dictionary.
+ */
+static bool
+decode(struct xz_reader *xz)
+{
+    int c;
+
+    switch (xz->state) {
+    case XZ_STATE_STREAM:
+	return stream_header(xz);
+    case XZ_STATE_BLOCK:
+	c = in_byte(xz);
+	if (c < 0) {
+	    return xz_fail(xz, "unexpected end of file");
+	} else if (c == 0) {
+	    return stream_index(xz);
+	}
+	return block_header(xz, (unsigned int)c);
+    case XZ_STATE_CHUNK:
+	return chunk_header(xz);
+    case XZ_STATE_LZMA:
+	return chunk_lzma(xz);
+    case XZ_STATE_COPY:
+	return chunk_copy(xz);
+    case XZ_STATE_PADDING:
+	return stream_padding(xz);
+    case XZ_STATE_DONE:
+	return true;
+    case XZ_STATE_ERROR:
+    default:
+	return false;
+    }
+}
+
+
+/*
+ * xz_open - open an xz file for reading
+ *
+ * given:
+ *	path	path of the xz file
+ *
+ * returns:
+ *	allocated xz reader, or NULL with errno set if path cannot be opened
+ *
+ * NOTE: free the xz reader with xz_close().
+ */
+struct xz_reader *
+xz_open(char const *path)
+{
+    struct xz_reader *xz;	/* xz reader to return */
+    FILE *stream;		/* open xz file */
+
+    /*
+     * firewall
+     */
+    if (path == NULL) {
+	err(11, __func__, "called with NULL path");
+	not_reached();
+    }
+
+    errno = 0;			/* pre-clear errno for caller */
+    stream = fopen(path, "rb");
+    if (stream == NULL) {
+	return NULL;
+    }
+    xz = xz_open_stream(stream);
+    xz->close_stream = true;
+    return xz;
+}
+
+
+/*
+ * xz_open_stream - read xz data from an open stream
+ *
+ * given:
+ *	stream	open stream to read xz data from
+ *
+ * returns:
+ *	allocated xz reader
+ *
+ * NOTE: free the xz reader with xz_close(), which does not close stream.
+ */
+struct xz_reader *
+xz_open_stream(FILE *stream)
+{
+    struct xz_reader *xz;	/* xz reader to return */
+    uint32_t c32;		/* CRC32 table value */
+    uint64_t c64;		/* CRC64 table value */
+    unsigned int i;
+    unsigned int j;
+
+    /*
+     * firewall
+     */
+    if (stream == NULL) {
+	err(12, __func__, "called with NULL stream");
+	not_reached();
+    }
+
+    errno = 0;			/* pre-clear errno for errp() */
+    xz = calloc(1, sizeof(*xz));
+    if (xz == NULL) {
+	errp(13, __func__, "calloc of struct xz_reader failed");
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    xz->in = malloc(XZ_BUF_SIZE);
+    if (xz->in == NULL) {
+	errp(14, __func__, "malloc of %d byte input buffer failed", XZ_BUF_SIZE);
+	not_reached();
+    }
+    xz->records = dyn_array_create(sizeof(struct xz_record), 64, 64, false);
+    xz->stream = stream;
+    xz->close_stream = false;
+    xz->state = XZ_STATE_STREAM;
+    xz->error = NULL;
+
+    /*
+     * form the CRC tables
+     */
+    for (i = 0; i < 256; ++i) {
+	c32 = i;
+	c64 = i;
+	for (j = 0; j < 8; ++j) {
+	    c32 = (c32 & 1) ? (c32 >> 1) ^ XZ_CRC32_POLY : c32 >> 1;
+	    c64 = (c64 & 1) ? (c64 >> 1) ^ XZ_CRC64_POLY : c64 >> 1;
+	}
+	xz->crc32_tbl[i] = c32;
+	xz->crc64_tbl[i] = c64;
+    }
+    return xz;
+}
+
+
+/*
+ * xz_read - read uncompressed data from an xz file
+ *
+ * given:
+ *	xz	xz reader
+ *	buf	where to read into
+ *	len	maximum number of bytes to read
+ *
+ * returns:
+ *	number of bytes read, 0 ==> end of the xz file, -1 ==> error
+ *
+ * NOTE: on error, xz_error() says what is wrong with the xz file.
+ */
+ssize_t
+xz_read(struct xz_reader *xz, void *buf, size_t len)
+{
+    unsigned char *out;		/* where to read into */
+    size_t done;		/* bytes read so far */
+    size_t pos;			/* index in dict of the first pending byte */
+    size_t n;
+
+    /*
+     * firewall
+     */
+    if (xz == NULL || buf == NULL) {
+	err(15, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    out = buf;
+    done = 0;
+    while (done < len) {
+
+	/*
+	 * copy out decoded bytes
+	 */
+	if (xz->dict_pending > 0) {
+	    pos = xz->dict_pos >= xz->dict_pending ? xz->dict_pos - xz->dict_pending :
+						     xz->dict_pos + xz->dict_alloc - xz->dict_pending;
+	    n = xz->dict_alloc - pos;
+	    if (n > xz->dict_pending) {
+		n = xz->dict_pending;
+	    }
+	    if (n > len - done) {
+		n = len - done;
+	    }
+	    memcpy(out + done, xz->dict + pos, n);
+	    xz->dict_pending -= n;
+	    done += n;
+	    continue;
+	}
+
+	/*
+	 * decode more
+	 */
+	if (xz->state == XZ_STATE_DONE) {
+	    break;
+	}
+	if (!decode(xz)) {
+	    return -1;
+	}
+    }
+    xz->out_total += done;
+    return (ssize_t)done;
+}
+
+
+/*
+ * xz_read_to_end - read and verify the rest of an xz file
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	true ==> the rest of the xz file is valid, false ==> error
+ *
+ * The uncompressed data not yet read is discarded.  As the check of each
+ * block, the index and the stream footer are only read after the data
+ * before them, a caller that stops reading early, say at the end of a
+ * tarball, must call this function to know that the whole xz file is valid.
+ *
+ * NOTE: on error, xz_error() says what is wrong with the xz file.
+ */
+bool
+xz_read_to_end(struct xz_reader *xz)
+{
+    /*
+     * firewall
+     */
+    if (xz == NULL) {
+	err(16, __func__, "called with NULL xz");
+	not_reached();
+    }
+
+    xz->out_total += xz->dict_pending;
+    xz->dict_pending = 0;
+    while (xz->state != XZ_STATE_DONE) {
+	if (!decode(xz)) {
+	    return false;
+	}
+	xz->out_total += xz->dict_pending;
+	xz->dict_pending = 0;
+    }
+    return true;
+}
+
+
+/*
+ * xz_error - return what is wrong with an xz file
+ *
+ * given:
+ *	xz	xz reader
+ *
+ * returns:
+ *	description of the error, or NULL if xz_read() has not failed
+ */
+char const *
+xz_error(struct xz_reader const *xz)
+{
+    /*
+     * firewall
+     */
+    if (xz == NULL) {
+	err(17, __func__, "called with NULL xz");
+	not_reached();
+    }
+
+    return xz->error;
+}
+
+
+/*
+ * xz_close - free an xz reader
+ *
+ * given:
+ *	xz	xz reader, may be NULL
+ *
+ * NOTE: the stream is closed only if xz_open() opened it.
+ */
+void
+xz_close(struct xz_reader *xz)
+{
+    if (xz == NULL) {
+	return;
+    }
+    if (xz->close_stream && xz->stream != NULL) {
+	(void) fclose(xz->stream);
+    }
+    if (xz->in != NULL) {
+	free(xz->in);
+	xz->in = NULL;
+    }
+    if (xz->dict != NULL) {
+	free(xz->dict);
+	xz->dict = NULL;
+    }
+    if (xz->records != NULL) {
+	dyn_array_free(xz->records);
+	xz->records = NULL;
+    }
+    free(xz);
+}
@@ -0,0 +1,261 @@
+/*
+ * xz_util - read xz compressed files without the xz(1) tool
+ *
+ * "It's a dangerous business, Frodo, going out your door. You step onto the
+ *  road, and if you don't keep your feet, there's no knowing where you might
+ *  be swept off to."
+ *
+ *	-- Bilbo Baggins, the Fellowship of the Ring.
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson. All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The IOCCC soup is a joke between Landon and Cody after Cody misread, being
+ * very tired at the time, one word as 'soup', when discussing decreasing the
+ * number of files in the top level directory (thus the name of this directory).
+ * We might have even left you all some delicious soup somewhere here. :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+#if !defined(INCLUDE_XZ_UTIL_H)
+#    define  INCLUDE_XZ_UTIL_H
+
+
+/*
+ * system includes
+ */
+#include <stdio.h>	    /* for FILE */
+#include <stdbool.h>	    /* for bool, true, false */
+#include <stdint.h>	    /* for uint16_t, uint32_t and uint64_t */
+#include <sys/types.h>	    /* for ssize_t */
+
+/*
+ * library related includes
+ */
+#include "../dbg/dbg.h"			/* dbg - info, debug, warning, error, and usage message facility */
+#include "../dyn_array/dyn_array.h"	/* dyn_array - dynamic array facility */
+
+
+/*
+ * xz format constants
+ *
+ * See https://tukaani.org/xz/xz-file-format.txt for the .xz file format,
+ * of which we decode the parts that xz(1) and tar -J write: any number of
+ * streams of blocks whose only filter is LZMA2.
+ */
+#define XZ_HEADER_LEN (12)		/* length of a stream header and of a stream footer */
+#define XZ_BLOCK_HEADER_MAX (1024)	/* maximum length of a block header */
+#define XZ_CHECK_MAX (64)		/* maximum length of a block check */
+#define XZ_FILTER_LZMA2 (0x21)		/* filter ID of LZMA2 */
+
+/*
+ * xz check types
+ */
+#define XZ_CHECK_NONE (0x00)
+#define XZ_CHECK_CRC32 (0x01)
+#define XZ_CHECK_CRC64 (0x04)
+#define XZ_CHECK_SHA256 (0x0A)
+
+/*
+ * CRC polynomials (reversed) of the xz check types we compute
+ */
+#define XZ_CRC32_POLY (0xEDB88320U)
+#define XZ_CRC64_POLY (0xC96C5795D7870F42ULL)
+#define XZ_SHA256_LEN (32)		/* length of a SHA-256 check */
+
+/*
+ * range coder constants
+ */
+#define RC_TOP (1U << 24)		/* normalize when the range falls below this */
+#define RC_MODEL_BITS (11)		/* bits of a probability */
+#define RC_MODEL_INIT (1U << (RC_MODEL_BITS - 1))	/* initial probability: 0.5 */
+#define RC_MOVE_BITS (5)		/* probability adaptation shift */
+
+/*
+ * xz reader limits
+ */
+#define XZ_BUF_SIZE (65536)		/* size of the compressed input buffer */
+#define XZ_DICT_MAX (64*1024*1024)	/* largest LZMA2 dictionary (that of xz -9) we will allocate */
+#define XZ_DICT_SLACK (65536)		/* dictionary room for decoded bytes not yet read */
+
+/*
+ * LZMA constants
+ */
+#define XZ_LZMA_STATES (12)		/* number of LZMA states */
+#define XZ_LZMA_POS_STATES_MAX (16)	/* maximum number of position states (1 << pb) */
+#define XZ_LZMA_LEN_TO_POS_STATES (4)	/* number of distance slot probability tables */
+#define XZ_LZMA_FULL_DISTANCES (128)	/* distances below this are coded with probabilities */
+#define XZ_LZMA_END_POS_MODEL (14)	/* first distance slot with direct (not modelled) bits */
+#define XZ_LZMA_ALIGN_BITS (4)		/* number of aligned low bits of large distances */
+#define XZ_LZMA_LITERAL_CODER (0x300)	/* probabilities per literal coder */
+#define XZ_LZMA_LCLP_MAX (4)		/* LZMA2 maximum of lc + lp */
+#define XZ_LZMA_MATCH_LEN_MAX (273)	/* longest LZMA match */
+
+
+/*
+ * struct xz_lzma_len - LZMA match length probabilities
+ */
+struct xz_lzma_len
+{
+    uint16_t choice;					/* length >= 8 */
+    uint16_t choice2;					/* length >= 16 */
+    uint16_t low[XZ_LZMA_POS_STATES_MAX][1 << 3];	/* lengths 0 to 7 */
+    uint16_t mid[XZ_LZMA_POS_STATES_MAX][1 << 3];	/* lengths 8 to 15 */
+    uint16_t high[1 << 8];				/* lengths 16 to 271 */
+};
+
+/*
+ * struct xz_lzma_probs - all LZMA probabilities
+ *
+ * NOTE: this struct must only hold uint16_t members: a state reset sets
+ *	 every probability of it at once.
+ */
+struct xz_lzma_probs
+{
+    uint16_t is_match[XZ_LZMA_STATES][XZ_LZMA_POS_STATES_MAX];
+    uint16_t is_rep[XZ_LZMA_STATES];
+    uint16_t is_rep_g0[XZ_LZMA_STATES];
+    uint16_t is_rep_g1[XZ_LZMA_STATES];
+    uint16_t is_rep_g2[XZ_LZMA_STATES];
+    uint16_t is_rep0_long[XZ_LZMA_STATES][XZ_LZMA_POS_STATES_MAX];
+    uint16_t pos_slot[XZ_LZMA_LEN_TO_POS_STATES][1 << 6];
+    uint16_t pos_special[1 + XZ_LZMA_FULL_DISTANCES - XZ_LZMA_END_POS_MODEL];
+    uint16_t align[1 << XZ_LZMA_ALIGN_BITS];
+    struct xz_lzma_len match_len;
+    struct xz_lzma_len rep_len;
+    uint16_t literal[XZ_LZMA_LITERAL_CODER << XZ_LZMA_LCLP_MAX];
+};
+
+/*
+ * struct xz_lzma - LZMA decoder state
+ */
+struct xz_lzma
+{
+    uint32_t range;		/* range decoder range */
+    uint32_t code;		/* range decoder code */
+    unsigned int lc;		/* number of literal context bits */
+    unsigned int lp;		/* number of literal position bits */
+    unsigned int pb;		/* number of position bits */
+    unsigned int state;		/* LZMA state: 0 to XZ_LZMA_STATES-1 */
+    uint32_t rep[4];		/* most recent match distances - 1 */
+    struct xz_lzma_probs probs;	/* probabilities */
+};
+
+/*
+ * enum xz_state - where an xz reader is in the xz file
+ */
+enum xz_state
+{
+    XZ_STATE_STREAM = 0,	/* expecting a stream header */
+    XZ_STATE_BLOCK,		/* expecting a block header or an index */
+    XZ_STATE_CHUNK,		/* expecting an LZMA2 chunk control byte */
+    XZ_STATE_LZMA,		/* decoding an LZMA chunk */
+    XZ_STATE_COPY,		/* copying an uncompressed chunk */
+    XZ_STATE_PADDING,		/* expecting stream padding, another stream or EOF */
+    XZ_STATE_DONE,		/* all streams have been read */
+    XZ_STATE_ERROR,		/* the file is not a valid xz file, or cannot be read */
+};
+
+/*
+ * struct xz_record - sizes of a block for the check against the index
+ */
+struct xz_record
+{
+    uint64_t unpadded;		/* block header + compressed data + check lengths */
+    uint64_t uncompressed;	/* uncompressed length */
+};
+
+/*
+ * struct xz_sha256 - SHA-256 of the uncompressed data of a block
+ */
+struct xz_sha256
+{
+    uint32_t hash[8];		/* hash state */
+    unsigned char buf[64];	/* partial message block */
+    size_t buf_len;		/* bytes in buf */
+    uint64_t total;		/* total bytes hashed */
+};
+
+/*
+ * struct xz_reader - read the uncompressed contents of an xz file
+ *
+ * Use xz_open() to form, xz_read() to read and xz_close() to free.
+ */
+struct xz_reader
+{
+    FILE *stream;		/* open stream of the xz file */
+    bool close_stream;		/* true ==> xz_close() closes stream */
+    enum xz_state state;	/* where we are in the xz file */
+    char const *error;		/* what is wrong if state == XZ_STATE_ERROR, else NULL */
+
+    unsigned char *in;		/* compressed input buffer of XZ_BUF_SIZE bytes */
+    size_t in_pos;		/* next byte of in to use */
+    size_t in_len;		/* number of bytes in in */
+    uint64_t in_total;		/* total compressed bytes used */
+    uint64_t out_total;		/* total uncompressed bytes read with xz_read() */
+
+    uint32_t crc32_tbl[256];	/* CRC32 table */
+    uint64_t crc64_tbl[256];	/* CRC64 table */
+
+    unsigned int check_type;	/* check type of the current stream */
+    uint32_t crc32;		/* CRC32 of the uncompressed data of the current block */
+    uint64_t crc64;		/* CRC64 of the uncompressed data of the current block */
+    struct xz_sha256 sha256;	/* SHA-256 of the uncompressed data of the current block */
+    struct dyn_array *records;	/* struct xz_record of each block of the current stream */
+
+    uint32_t header_len;	/* length of the current block header */
+    bool has_comp_size;		/* true ==> block header gave comp_size */
+    bool has_uncomp_size;	/* true ==> block header gave uncomp_size */
+    uint64_t comp_size;		/* compressed size from the block header */
+    uint64_t uncomp_size;	/* uncompressed size from the block header */
+    uint64_t block_in;		/* in_total at the start of the block data */
+    uint64_t block_out;		/* uncompressed bytes decoded in the current block */
+
+    uint32_t chunk_left;	/* uncompressed bytes left in the current chunk */
+    uint32_t chunk_comp;	/* compressed size of the current LZMA chunk */
+    uint64_t chunk_in;		/* in_total at the start of the current LZMA chunk */
+    bool need_dict_reset;	/* true ==> next chunk must reset the dictionary */
+    bool need_props;		/* true ==> next LZMA chunk must set lc, lp and pb */
+
+    unsigned char *dict;	/* dictionary ring of dict_alloc bytes */
+    size_t dict_alloc;		/* allocated size of dict */
+    uint32_t dict_size;		/* dictionary size of the current block */
+    size_t dict_pos;		/* next byte of dict to decode into */
+    size_t dict_pending;	/* decoded bytes before dict_pos not yet read */
+    uint64_t dict_full;		/* bytes decoded since the last dictionary reset */
+
+    struct xz_lzma lzma;	/* LZMA decoder */
+};
+
+
+/*
+ * external function declarations
+ */
+extern struct xz_reader *xz_open(char const *path);
+extern struct xz_reader *xz_open_stream(FILE *stream);
+extern ssize_t xz_read(struct xz_reader *xz, void *buf, size_t len);
+extern bool xz_read_to_end(struct xz_reader *xz);
+extern char const *xz_error(struct xz_reader const *xz);
+extern void xz_close(struct xz_reader *xz);
+
+
+#endif /* INCLUDE_XZ_UTIL_H */
@@ -54,7 +54,7 @@ export EXIT_CODE=0
 export INVALID_DIRECTORY_FOUND=""
 export WORKDIR="./test_ioccc/workdir"
 
-export CHKSUBMIT_TEST_VERSION="2.1.3 2025-11-08"
+export CHKSUBMIT_TEST_VERSION="2.1.5 2026-10-18"
 
 export USAGE="usage: $0 [-h] [-V] [-v level] [-D dbg_level] [-q] [-c chksubmit] [-C chkentry] [-d workdir]
 
@@ -445,6 +445,53 @@ while read -r dir; do
     run_bad_test "$CHKSUBMIT" "$CHKENTRY" "$DBG_LEVEL" "$Q_FLAG" "$dir"
 done < <(find "$BAD_TREE" -mindepth 1 -maxdepth 1 -type d -print)
 
+# run the chkentry -l line mode tests: good/ must all pass and bad/ must all fail
+#
+if [[ $V_FLAG -ge 3 ]]; then
+    echo "$0: debug[3]: about to run chkentry -l tests on good/ and bad/ files" | tee -a -- "${LOGFILE}"
+fi
+echo "$0: about to run test that must pass: find $GOOD_TREE -mindepth 1 -maxdepth 1 -type d -print | $CHKENTRY -q -l -n 2 >> ${LOGFILE}" 1>&2
+find "$GOOD_TREE" -mindepth 1 -maxdepth 1 -type d -print | "$CHKENTRY" -q -l -n 2 >> "${LOGFILE}" 2>&1
+status="${PIPESTATUS[1]}"
+if [[ $status -eq 0 ]]; then
+    echo "$0: test chkentry -l on $GOOD_TREE should PASS: chkentry PASS with exit code 0" | tee -a -- "${LOGFILE}"
+else
+    echo "$0: test chkentry -l on $GOOD_TREE should PASS: chkentry FAILED with exit code: $status" | tee -a -- "${LOGFILE}"
+    EXIT_CODE=1
+fi
+echo "$0: about to run test that must fail: find $BAD_TREE -mindepth 1 -maxdepth 1 -type d -print | $CHKENTRY -q -l -n 2" 1>&2
+RESULTS=$(find "$BAD_TREE" -mindepth 1 -maxdepth 1 -type d -print | "$CHKENTRY" -q -l -n 2 2>> "${LOGFILE}"; echo "status: ${PIPESTATUS[1]}")
+status="${RESULTS##*status: }"
+echo "$RESULTS" >> "${LOGFILE}"
+if [[ $status -eq 1 ]] && ! grep -q '^{ "ok" : true' <<< "$RESULTS"; then
+    echo "$0: test chkentry -l on $BAD_TREE should FAIL: chkentry FAILED every directory with exit code 1" | tee -a -- "${LOGFILE}"
+else
+    echo "$0: test chkentry -l on $BAD_TREE should FAIL: chkentry exit code: $status and not every directory FAILED" | tee -a -- "${LOGFILE}"
+    EXIT_CODE=1
+fi
+
+# chkentry -l on a directory without .auth.json: the worker must report why the
+# directory failed, not exit, and go on to check the next directory
+#
+GOOD_DIR=$(find "$GOOD_TREE" -mindepth 1 -maxdepth 1 -type d -print | LC_ALL=C sort | head -n 1)
+NO_AUTH_TREE=$(mktemp -d .chksubmit_test.no_auth.XXXXXXXXXX)
+cp -R -p "$GOOD_DIR" "$NO_AUTH_TREE/no_auth"
+rm -f "$NO_AUTH_TREE/no_auth/.auth.json"
+echo "$0: about to run test that must fail then pass: printf '%s\\n' $NO_AUTH_TREE/no_auth $GOOD_DIR | $CHKENTRY -l -n 1" 1>&2
+RESULTS=$(printf '%s\n' "$NO_AUTH_TREE/no_auth" "$GOOD_DIR" | "$CHKENTRY" -l -n 1 2>> "${LOGFILE}")
+echo "$RESULTS" >> "${LOGFILE}"
+NO_AUTH_RESULT=$(sed -n 1p <<< "$RESULTS")
+GOOD_RESULT=$(sed -n 2p <<< "$RESULTS")
+if [[ $NO_AUTH_RESULT =~ ^'{ "ok" : false, '.*'"error" : null, '.*'"report" : '.*'.auth.json' ]] &&
+   [[ $GOOD_RESULT =~ ^'{ "ok" : true, ' ]]; then
+    echo "$0: test chkentry -l on a directory without .auth.json should FAIL with a report: chkentry FAILED it and went on" | tee -a -- "${LOGFILE}"
+else
+    echo "$0: test chkentry -l on a directory without .auth.json should FAIL with a report: chkentry results: $RESULTS" | tee -a -- "${LOGFILE}"
+    EXIT_CODE=1
+fi
+rm -rf "$NO_AUTH_TREE"
+echo >> "${LOGFILE}"
+
 # determine exit code
 #
 if [[ $EXIT_CODE -ne 0 ]]; then
@@ -112,27 +112,12 @@ main(int argc, char *argv[])
     char const *program = NULL;	/* our name */
     extern char *optarg;	/* option argument */
     extern int optind;		/* argv index of the next arg */
-    char *filepath;		/* filepath argument to check */
-    char *filename;		/* basename of filepath to check */
+    struct submit_filename sub;	/* what was found in the filepath */
     int ret;			/* libc return code */
-    char *submit;		/* first '.' separated token - submit */
-    char *uuid;			/* first '-' separated token - test or UUID */
-    size_t len;			/* UUID length */
-    unsigned int a, b, c, d, e, f;	/* parts of the UUID string */
-    unsigned int version = 0;	/* UUID version hex character */
-    unsigned int variant = 0;	/* UUID variant hex character */
-    char guard;			/* scanf guard to catch excess amount of input */
-    int submit_slot;		/* third .-separated token as a number */
-    char *timestamp_str;	/* fourth .-separated token - timestamp */
-    intmax_t timestamp;		/* fifth .-separated token as a timestamp */
-    char *extension;		/* sixth .-separated token as a filename extension */
     char *ext = "txz";		/* user supplied extension (def: txz): used for testing purposes only */
     bool test_mode = false;	/* true ==> force check to test if it's a test submit filename */
-    char *saveptr = NULL;	/* for strtok_r() */
     bool ignore_timestamp = false; /* true ==> ignore timestamp check result (for testing purposes) */
     bool opt_error = false;	/* fchk_inval_opt() return */
-    bool safe = true;		/* assume path is sane */
-    enum path_sanity sanity = PATH_ERR_UNSET;	/* canon_path error or PATH_OK */
     int i;
 
     /* IOCCC requires use of C locale */
@@ -198,205 +183,31 @@ main(int argc, char *argv[])
 	not_reached();
     }
 
-    /* collect arg */
-    /* IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function. */
-    filepath = canon_path(argv[optind], 0, 0, 0, &sanity, NULL, NULL, false, false, true, true, NULL);
-    if (filepath == NULL) {
-	err(3, program, "bogus filepath: %s error: %s", argv[optind], path_sanity_error(sanity)); /*ooo*/
-	not_reached();
-    }
-    dbg(DBG_LOW, "filepath: %s", filepath);
-
-    /*
-     * obtain the basename of the path to examine
-     */
-    filename = base_name(filepath);
-    if (filename == NULL) {
-        err(55, __func__, "base_name(\"%s\") returned NULL", filepath);
-        not_reached();
-    }
-    dbg(DBG_LOW, "filename: %s", filename);
-
-    /*
-     * first '.' separated token must be submit
-     */
-    submit = strtok_r(filename, ".", &saveptr);
-    if (submit == NULL) {
-	err(56, __func__, "first strtok_r() returned NULL");
-	not_reached();
-    }
-    if (strcmp(submit, "submit") != 0) {
-	err(57, __func__, "filename does not start with \"submit.\": %s", filepath);
-	not_reached();
-    }
-    dbg(DBG_LOW, "filename starts with \"submit.\": %s", filename);
-
     /*
-     * second '.' separated token must be test or a UUID
-     */
-    uuid = strtok_r(NULL, ".", &saveptr);
-    if (uuid == NULL) {
-	err(58, __func__, "nothing found after \"submit.\"");
-	not_reached();
-    }
-    len = strlen(uuid);
-
-    /*
-     * parse a test-submit_slot IOCCC contest ID
-     */
-    if (strncmp(uuid, "test-", LITLEN("test-")) == 0) {
-	/* if it starts as "test-" and -u was specified it's an error */
-	if (!test_mode) {
-	    err(59, __func__, "-t not specified with filename that starts as a test mode filename: %s", filepath);
-            not_reached();
-        }
-
-	/*
-	 * NOTE: we prevent seqcexit from modifying the exit code because the
-	 * txzchk_test.sh script has a test file where it expects this error.
-	 */
-	if (len != LITLEN("test-")+MAX_SUBMIT_SLOT_CHARS) {
-	    err(4, __func__, "\"submit.test-\" separated token length: %zu != %zu: %s", /*ooo*/
-			     len, (LITLEN("test-")+MAX_SUBMIT_SLOT_CHARS), filepath);
-	    not_reached();
-	}
-	ret = sscanf(uuid, "test-%d%c", &submit_slot, &guard);
-	if (ret != 1) {
-	    err(60, __func__, "submit_slot not found after \"test-\": %s", filepath);
-	    not_reached();
-	}
-	dbg(DBG_LOW, "submit ID is test: %s", uuid);
-	if (submit_slot < 0) {
-	    err(61, __func__, "submit_slot %d is < 0: %s", submit_slot, filepath);
-	    not_reached();
-	}
-	if (submit_slot > MAX_SUBMIT_SLOT) {
-	    err(62, __func__, "submit_slot %d is > %d: %s", submit_slot, MAX_SUBMIT_SLOT, filepath);
-	    not_reached();
-	}
-	dbg(DBG_LOW, "submit_slot %d is valid: %s", submit_slot, filepath);
-
-    /*
-     * parse a UUID-submit_slot IOCCC contest ID
-     */
-    } else {
-	/*
-	 * if -t is specified and we get here (filename does not start with
-	 * "submit.test-") then it's an error.
-	 */
-	if (test_mode) {
-	    err(63, __func__, "-t specified and filename does not start with \"submit.test-\": %s", filepath);
-	    not_reached();
-        }
-
-	/*
-	 * NOTE: we prevent seqcexit from modifying the exit code because the
-	 * txzchk_test.sh script has a test file where it expects this error.
-	 */
-	if (len != UUID_LEN+1+MAX_SUBMIT_SLOT_CHARS) {
-	    err(5, __func__, "\"submit.UUID-\" separated token length: %zu != %d: %s", /*ooo*/
-			     len, (UUID_LEN+1+MAX_SUBMIT_SLOT_CHARS), filepath); /*ooo*/
-	    not_reached();
-	}
-	ret = sscanf(uuid, "%8x-%4x-%1x%3x-%1x%3x-%8x%4x-%d%c", &a, &b, &version, &c, &variant,
-		&d, &e, &f, &submit_slot, &guard);
-	if (ret != 9) {
-	    err(64, __func__, "UUID-submit_slot not found after \"submit-\": %s", filepath);
-	    not_reached();
-	}
-	if (version != UUID_VERSION) {
-	    err(65, __func__, "UUID token version %x != %x: %s", version, UUID_VERSION, filepath);
-	    not_reached();
-	}
-	if (variant != UUID_VARIANT_0 && variant != UUID_VARIANT_1 && variant != UUID_VARIANT_2 && variant != UUID_VARIANT_3) {
-	    err(66, __func__, "UUID token variant %x not one of %x, %x, %x, %x: %s", variant, UUID_VARIANT_0,
-                    UUID_VARIANT_1, UUID_VARIANT_2, UUID_VARIANT_3, filepath);
-	    not_reached();
-	}
-	dbg(DBG_LOW, "submit ID is a valid UUID: %s", uuid);
-	if (submit_slot < 0) {
-	    err(67, __func__, "submit_slot %d is < 0: %s", submit_slot, filepath);
-	    not_reached();
-	}
-	if (submit_slot > MAX_SUBMIT_SLOT) {
-	    err(68, __func__, "submit_slot %d is > %d: %s", submit_slot, MAX_SUBMIT_SLOT, filepath);
-	    not_reached();
-	}
-	dbg(DBG_LOW, "submit number is valid: %d", submit_slot);
-    }
-
-    /*
-     * third '.' separated token must be a valid timestamp, unless
-     * ignore_timestamp is true
-     */
-    timestamp_str = strtok_r(NULL, ".", &saveptr);
-    if (timestamp_str == NULL) {
-	err(69, __func__, "nothing found after second '.' separated token of submit number: %s", filepath);
-	not_reached();
-    }
-    if (!ignore_timestamp) {
-        ret = sscanf(timestamp_str, "%jd%c", &timestamp, &guard);
-        if (ret != 1) {
-            err(70, __func__, "timestamp not found after \"submit_slot.\": %s is not a timestamp: %s", timestamp_str, filepath);
-            not_reached();
-        }
-        if (timestamp < MIN_TIMESTAMP) {
-            err(71, __func__, "timestamp: %jd is < %jd: %s", timestamp, (intmax_t)MIN_TIMESTAMP, filepath);
-            not_reached();
-        }
-        dbg(DBG_LOW, "timestamp is valid: %jd", timestamp);
-    }
-
-    /*
-     * fourth .-separated token must be the filename extension
-     */
-    extension = strtok_r(NULL, ".", &saveptr);
-    if (extension == NULL) {
-	err(72, __func__, "nothing found after third '.' separated token of timestamp: %s", filepath);
-	not_reached();
-    }
-    if (strcmp(extension, ext) != 0) {
-	err(73, __func__, "extension %s != %s: %s", extension, ext, filepath);
-	not_reached();
-    }
-    dbg(DBG_LOW, "filename extension is valid: %s", extension);
-
-    /*
-     * filepath must use only POSIX portable filename and + chars
-     */
-    safe = safe_str(filepath, true, true); /* ^[/0-9A-Za-z._+-]+$ */
-    if (safe == false) {
-	err(74, __func__, "filepath: safe_str(%s, true, true) is false", filepath);
-	not_reached();
-    }
-
-    /*
-     * filename must use only lower case POSIX portable filename and + chars
+     * check the filepath
+     *
+     * NOTE: the exit code is that of the failed check: the txzchk_test.sh
+     * script has test files where it expects some of these codes.
      */
-    safe = safe_path_str(filename, false, false); /* ^[0-9a-z._][0-9a-z._+-]*$ */
-    if (safe == false) {
-	err(75, __func__, "basename: safe_path_str(%s, false, false) is false", filename);
+    if (!chk_submit_filename(argv[optind], ext, test_mode, ignore_timestamp, &sub)) {
+	err(sub.code, sub.code == 3 ? program : __func__, "%s", sub.msg); /*ooo*/
 	not_reached();
     }
 
     /*
      * All is OK with the filepath - print submit directory basename
      */
-    dbg(DBG_LOW, "filepath passes all checks: %s", filepath);
     errno = 0;		/* pre-clear errno for errp() */
-    ret = printf("%s\n", uuid);
+    ret = printf("%s\n", sub.dirname);
     if (ret <= 0) {
 	errp(76, __func__, "printf of submit directory basename failed");
 	not_reached();
     }
 
     /*
-     * free filename allocated from base_name()
+     * free storage of the check
      */
-    if (filename != NULL) {
-	free(filename);
-	filename = NULL;
-    }
+    free_submit_filename(&sub);
 
     /*
      * All Done!!! All Done!!! -- Jessica Noll, Age 2
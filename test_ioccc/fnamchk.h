@@ -71,6 +71,11 @@
  */
 #include "../soup/default_handle.h"
 
+/*
+ * fnamchk_util - check an IOCCC compressed tarball filename
+ */
+#include "../soup/fnamchk_util.h"
+
 /*
  * fnamchk tool basename
  */
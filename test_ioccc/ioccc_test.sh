@@ -39,7 +39,7 @@
 
 # setup
 #
-export IOCCC_TEST_VERSION="2.1.2 2025-09-01"
+export IOCCC_TEST_VERSION="2.1.4 2026-10-18"
 
 
 # IOCCC requires use of C locale
@@ -658,6 +658,52 @@ else
     echo | tee -a -- "$LOGFILE"
 fi
 
+# test_rule_count
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: test_ioccc/test_rule_count" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "test_ioccc/test_rule_count -- test_ioccc/slot/*/topdir/*/prog.c test_ioccc/test_iocccsize/*.c ./*.c" | tee -a -- "$LOGFILE"
+test_ioccc/test_rule_count -- test_ioccc/slot/*/topdir/*/prog.c test_ioccc/test_iocccsize/*.c ./*.c | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: test_ioccc/test_rule_count non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    test_ioccc/test_rule_count non-zero exit code: $status"
+    EXIT_CODE="30"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: test_ioccc/test_rule_count" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: test_ioccc/test_rule_count" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+fi
+
+# test_glob_match
+#
+echo | tee -a -- "$LOGFILE"
+echo "RUNNING: test_ioccc/test_glob_match" | tee -a -- "$LOGFILE"
+echo | tee -a -- "$LOGFILE"
+echo "test_ioccc/test_glob_match" | tee -a -- "$LOGFILE"
+test_ioccc/test_glob_match | tee -a -- "$LOGFILE"
+status="${PIPESTATUS[0]}"
+if [[ $status -ne 0 ]]; then
+    echo "$0: ERROR: test_ioccc/test_glob_match non-zero exit code: $status" 1>&2 | tee -a -- "$LOGFILE"
+    FAILURE_SUMMARY="$FAILURE_SUMMARY
+    test_ioccc/test_glob_match non-zero exit code: $status"
+    EXIT_CODE="31"
+    echo | tee -a -- "$LOGFILE"
+    echo "EXIT_CODE set to: $EXIT_CODE" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+    echo "FAILED: test_ioccc/test_glob_match" | tee -a -- "$LOGFILE"
+else
+    echo | tee -a -- "$LOGFILE"
+    echo "PASSED: test_ioccc/test_glob_match" | tee -a -- "$LOGFILE"
+    echo | tee -a -- "$LOGFILE"
+fi
+
 # report overall status
 #
 if [[ $EXIT_CODE -ne 0 ]]; then
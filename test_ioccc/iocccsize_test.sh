@@ -23,7 +23,7 @@ export EXIT_CODE=0
 export IOCCCSIZE_ARGS="-v 1 --"
 export V_FLAG=0
 export TOPDIR=
-export TEST_IOCCCSIZE_VERSION="1.4.1 2025-03-14"
+export TEST_IOCCCSIZE_VERSION="1.5.0 2026-10-18"
 
 
 # IOCCC requires use of C locale
@@ -722,6 +722,32 @@ main(int argc, char **argv)
 EOF
 test_size hello-jp3.c "313 398 7"
 
+#######################################################################
+
+# Count all of the above files as a list: each row must agree with the
+# counts of the file on its own, and the rows must not depend on -j jobs.
+#
+LIST_1="$WORKDIR/list.1.tsv"
+LIST_4="$WORKDIR/list.4.tsv"
+find "$WORKDIR" -name '*.c' -print0 | LC_ALL=C sort -z | "$IOCCCSIZE" -0 -j 1 > "$LIST_1" 2>/dev/null
+find "$WORKDIR" -name '*.c' -print0 | LC_ALL=C sort -z | "$IOCCCSIZE" -0 -j 4 > "$LIST_4" 2>/dev/null
+if ! cmp -s "$LIST_1" "$LIST_4"; then
+    echo "$0: ERROR: $IOCCCSIZE -0 -j 1 and -j 4 rows differ" 1>&2
+    EXIT_CODE=1
+fi
+while IFS=$'\t' read -r file rule_2b rule_2a keywords warnings; do
+    if [[ $file == path ]]; then
+	continue
+    fi
+    expect=$("$IOCCCSIZE" -v 1 -- "$file" 2>/dev/null)
+    if [[ "$rule_2b $rule_2a $keywords" != "$expect" ]]; then
+	echo "$0: ERROR: $IOCCCSIZE -0 row of $file: $rule_2b $rule_2a $keywords != $IOCCCSIZE -v 1 value: $expect" 1>&2
+	EXIT_CODE=1
+    elif [[ $V_FLAG -ge 3 ]]; then
+	echo "$0: debug[3]: $IOCCCSIZE -0 row of $file: $rule_2b $rule_2a $keywords $warnings" 1>&2
+    fi
+done < "$LIST_1"
+
 
 # All Done!!! All Done!!! -- Jessica Noll, Age 2
 #
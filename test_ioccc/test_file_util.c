@@ -299,6 +299,7 @@ main(int argc, char **argv)
     char *expect = NULL;		/* expected process result */
     /**/
     size_t bytes = 0;
+    enum copy_method method = COPY_METHOD_NONE;	/* how copyfile_method() copied a file */
     struct stat in_st;                  /* verify copyfile() sets correct modes */
     struct stat out_st;                 /* output file stat(2) */
     bool dir_exists = false;            /* true ==> directory already exists (for testing modes) */
@@ -840,8 +841,9 @@ main(int argc, char **argv)
      * try one more time but this time make it a binary file
      */
     path = calloc_path("test_ioccc", "test_file_util.o");
-    bytes = copyfile(path, "test_file_util.copy.o", true, 0);
-    fdbg(stderr, DBG_MED, "copyfile(\"%s\", \"test_file_util.copy.c\", true, 0): %zu bytes", path, bytes);
+    bytes = copyfile_method(path, "test_file_util.copy.o", true, 0, &method);
+    fdbg(stderr, DBG_MED, "copyfile_method(\"%s\", \"test_file_util.copy.o\", true, 0, &method): %zu bytes via %s",
+	 path, bytes, copy_method_name(method));
 
     /*
      * make sure test_file_util.o st_mode is the same as test_file_util.copy.o
@@ -892,6 +894,15 @@ main(int argc, char **argv)
 			      "> 0 and both match stat(2) st_size");
     }
 
+    /*
+     * copyfile_method() must report the bytes it copied and how
+     */
+    if ((off_t)bytes != size1 || method == COPY_METHOD_NONE) {
+        err(45, __func__, "copyfile_method() reported %zu bytes via %s for a %jd byte file", /*ooo*/
+		bytes, copy_method_name(method), (intmax_t)size1);
+        not_reached();
+    }
+
     /*
      * delete copied file
      */
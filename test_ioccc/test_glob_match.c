@@ -0,0 +1,501 @@
+/*
+ * test_glob_match - test compile_glob() and glob_match() against fnmatch(3)
+ *
+ * "You are not expected to understand this" :-)
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson.
+ * All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * pr - stdio helper library
+ */
+#include "../pr/pr.h"
+
+/*
+ * jparse/util - common utility functions for the JSON parser and tools
+ */
+#include "../jparse/util.h"
+
+/*
+ * version - official IOCCC toolkit versions
+ */
+#include "../soup/version.h"
+
+/*
+ * location - location/country codes and set the IOCCC locale
+ */
+#include "../soup/location.h"
+
+/*
+ * walk - walk directory trees and tar listings
+ */
+#include "../soup/walk.h"
+
+
+/*
+ * definitions
+ */
+#define DEF_RANDOM_COUNT (100000)	/* default number of random pattern and name pairs */
+#define DEF_SEED (1)			/* default random seed */
+#define RANDOM_MAXLEN (8)		/* maximum length of a random pattern or name */
+
+
+/*
+ * usage message
+ */
+static char const * const usage =
+"usage: %s [-h] [-v level] [-V] [-q] [-r count] [-s seed]\n"
+"\n"
+"\t-h\t\tprint help message and exit\n"
+"\t-v level\tset verbosity level: (def level: 0)\n"
+"\t-V\t\tprint version string and exit\n"
+"\t-q\t\tquiet mode: silence msg(), warn(), warnp() if -v 0 (def: loud :-) )\n"
+"\t-r count\tnumber of random pattern and name pairs to test (def: %d)\n"
+"\t-s seed\t\tseed of the random patterns and names (def: %d)\n"
+"\n"
+"Each pattern of a table, and each random pattern, is compiled by compile_glob()\n"
+"without and with anycase.  Each name of a table, and each random name, must then\n"
+"match with glob_match() when, and only when, it matches with fnmatch(3) (with\n"
+"FNM_CASEFOLD if anycase).  The table patterns must also be compiled, or left\n"
+"to fnmatch(3), as the table says.\n"
+"\n"
+"Exit codes:\n"
+"     0   all matches are the same\n"
+"     1   some match is different\n"
+"     2   -h and help string printed or -V and version string printed\n"
+"     3   invalid command line, invalid option or option missing an argument\n"
+" >= 10   internal error\n"
+"\n"
+"%s version: %s\n";
+
+
+/*
+ * patterns to test
+ */
+static struct glob_case {
+    char const *pattern;	/* fnmatch(3) pattern */
+    bool compiled;		/* true ==> compile_glob() compiles it, false ==> left to fnmatch(3) */
+    bool anycase_compiled;	/* as compiled, but for compile_glob() with anycase */
+} const patterns[] = {
+    /* plain characters */
+    { "", true, true },
+    { "a", true, true },
+    { "abc", true, true },
+    { "Makefile", true, true },
+    { "prog.c", true, true },
+
+    /* "*" (star) and runs of stars */
+    { "*", true, true },
+    { "**", true, true },
+    { "***", true, true },
+    { "*.c", true, true },
+    { "**.c", true, true },
+    { "a*", true, true },
+    { "a*b", true, true },
+    { "a**b", true, true },
+    { "*a*", true, true },
+    { "*a*b*c*", true, true },
+    { "a*a*a*b", true, true },
+
+    /* "?" (question mark) and runs of question marks */
+    { "?", true, true },
+    { "??", true, true },
+    { "???", true, true },
+    { "a?c", true, true },
+    { "??.c", true, true },
+    { "*?", true, true },
+    { "?*", true, true },
+    { "*?*", true, true },
+    { "*??*", true, true },
+    { "?*?", true, true },
+
+    /* [...] sets, ranges and negation */
+    { "[abc]", true, true },
+    { "[a-c]", true, true },
+    { "[a-cx-z]", true, true },
+    { "[0-9][0-9]", true, true },
+    { "[!a-c]", true, true },
+    { "[!abc]*", true, true },
+    { "*[!.]", true, true },
+    { "[]]", true, true },
+    { "[]a]", true, true },
+    { "[!]]", true, true },
+    { "[!]a]", true, true },
+    { "[a-]", true, true },
+    { "[-a]", true, true },
+    { "[!-]", true, true },
+    { "[]-a]", true, true },
+    { "[*?]", true, true },
+    { "[[]", true, true },
+    { "[!]", false, false },
+    { "[a-c", false, false },
+    { "[", false, false },
+    { "a[", false, false },
+    { "[]", false, false },
+    { "[c-a]", false, false },
+    { "[^a]", false, false },
+    { "[[:alpha:]]", false, false },
+    { "[[=a=]]", false, false },
+    { "[[.a.]]", false, false },
+
+    /* "\" (backslash) escapes */
+    { "\\*", false, false },
+    { "a\\?b", false, false },
+    { "\\[a]", false, false },
+    { "[\\]]", false, false },
+    { "[a\\-c]", false, false },
+    { "\\", false, false },
+
+    /* letters for anycase */
+    { "A", true, true },
+    { "aBc", true, true },
+    { "*.C", true, true },
+    { "README*", true, true },
+    { "[A-Z]", true, true },
+    { "[a-z]", true, true },
+    { "[A-z]", true, true },
+    { "[!A-Z]", true, true },
+    { "[Aa]", true, true },
+    { "[!B]", true, true },
+    { "[Z-a]", true, false },	    /* [z-a] is descending if anycase */
+    { "[_-a]", true, true },
+    { "[Z-_]", true, false },	    /* [z-_] is descending if anycase */
+    { "[B-a]", true, false },	    /* [b-a] is descending if anycase */
+
+    /* leading "." (dot) - without FNM_PERIOD, as walk_rule patterns are matched */
+    { ".*", true, true },
+    { ".?*", true, true },
+    { "[.]*", true, true },
+    { "[!.]*", true, true },
+    { "?git*", true, true },
+    { "*git*", true, true },
+    { ".git", true, true },
+    { ".[!.]*", true, true },
+
+    { NULL, false, false }
+};
+
+
+/*
+ * names to match each pattern against
+ */
+static char const * const names[] = {
+    "", "a", "b", "c", "d", "z", "A", "B", "C", "Z",
+    "abc", "ABC", "aBc", "ab", "ac", "abbc", "aXc", "aaab", "aab", "ba", "aaaab", "axbxc",
+    "prog.c", "prog.C", "prog.h", "x.c", "xy.c", "xyz.c", ".c", "c.", "Makefile", "makefile",
+    "README", "README.md", "readme.md",
+    "0", "00", "09", "9", "-", "]", "[", "*", "?", "\\", "^", "_", "`", "!", "[a]", "a?b", "a*b",
+    ".", "..", ".git", ".GIT", ".gitignore", "..git", "x.git", "git", ".hidden", ".a", "a.",
+    NULL
+};
+
+
+/*
+ * characters random patterns and names are made of
+ */
+static char const pattern_chars[] = "aAbBzZ_09.-*?[]!^\\";
+static char const name_chars[] = "aAbBzZ_09.-*?[]!^\\";
+
+
+/*
+ * forward declarations
+ */
+static bool chk_glob(char const *pattern, char const *name, bool anycase, struct walk_glob const *glob);
+static void random_string(char *buf, char const *chars);
+static void usage_err(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+/*
+ * chk_glob - check that glob_match() matches a name as fnmatch(3) does
+ *
+ * given:
+ *	pattern	    fnmatch(3) pattern
+ *	name	    name to match
+ *	anycase	    true ==> match with FNM_CASEFOLD
+ *	glob	    pattern as compiled by compile_glob()
+ *
+ * returns:
+ *	true ==> glob_match() and fnmatch(3) agree,
+ *	false ==> they do not
+ *
+ * NOTE: This function does not return on NULL pointers.
+ */
+static bool
+chk_glob(char const *pattern, char const *name, bool anycase, struct walk_glob const *glob)
+{
+    bool ref;	    /* true ==> fnmatch(3) matches */
+    bool got;	    /* true ==> glob_match() matches */
+
+    /*
+     * firewall
+     */
+    if (pattern == NULL || name == NULL || glob == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    ref = (fnmatch(pattern, name, anycase ? FNM_CASEFOLD : 0) == 0);
+    got = glob_match(glob, name, anycase);
+    if (ref != got) {
+	dbg(DBG_NONE, "pattern: \"%s\" name: \"%s\" anycase: %s: fnmatch: %s glob_match: %s",
+		      pattern, name, booltostr(anycase), booltostr(ref), booltostr(got));
+	return false;
+    }
+    dbg(DBG_VHIGH, "pattern: \"%s\" name: \"%s\" anycase: %s: %s",
+		   pattern, name, booltostr(anycase), booltostr(got));
+    return true;
+}
+
+
+/*
+ * random_string - form a random string of at most RANDOM_MAXLEN characters
+ *
+ * given:
+ *	buf	    buffer of at least RANDOM_MAXLEN+1 bytes
+ *	chars	    characters the string is made of
+ *
+ * NOTE: This function does not return on NULL pointers.
+ */
+static void
+random_string(char *buf, char const *chars)
+{
+    size_t len;		/* length of the string */
+    size_t count;	/* number of chars */
+    size_t i;
+
+    /*
+     * firewall
+     */
+    if (buf == NULL || chars == NULL) {
+	err(11, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    count = strlen(chars);
+    len = (size_t)random() % (RANDOM_MAXLEN + 1);
+    for (i = 0; i < len; ++i) {
+	buf[i] = chars[(size_t)random() % count];
+    }
+    buf[len] = '\0';
+}
+
+
+int
+main(int argc, char **argv)
+{
+    char const *program = NULL;		/* our name */
+    extern char *optarg;		/* option argument */
+    extern int optind;			/* argv index of the next arg */
+    intmax_t random_count = DEF_RANDOM_COUNT; /* number of random pattern and name pairs */
+    intmax_t seed = DEF_SEED;		/* random seed */
+    struct walk_glob *glob;		/* compiled pattern */
+    char pattern[RANDOM_MAXLEN+1];	/* random pattern */
+    char name[RANDOM_MAXLEN+1];		/* random name */
+    size_t checks = 0;			/* matches compared */
+    size_t compiled = 0;		/* random patterns compile_glob() compiled */
+    size_t mismatches = 0;		/* compiles and matches that were not the same */
+    bool anycase;			/* true ==> FNM_CASEFOLD */
+    bool expect;			/* true ==> compile_glob() should compile the table pattern */
+    intmax_t r;
+    size_t p;
+    size_t n;
+    int i;
+
+    /* IOCCC requires use of C locale */
+    set_ioccc_locale();
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:Vqr:s:")) != -1) {
+	switch (i) {
+	case 'h':	/* -h - write help, to stderr and exit 2 */
+	    usage_err(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':	/* -v verbosity */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage_err(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':	/* -V - write version and exit 2 */
+	    print("%s version: %s\n", program, GLOB_MATCH_TEST_VERSION);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'q':
+	    msg_warn_silent = true;
+	    break;
+	case 'r':	/* -r count - number of random pattern and name pairs */
+	    if (!string_to_intmax(optarg, &random_count) || random_count < 0) {
+		usage_err(3, program, "invalid -r count"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 's':	/* -s seed - random seed */
+	    if (!string_to_intmax(optarg, &seed)) {
+		usage_err(3, program, "invalid -s seed"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':
+	    (void) fprintf(stderr, "%s: requires an argument -- %c\n\n", program, optopt);
+	    usage_err(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case '?':
+	    (void) fprintf(stderr, "%s: illegal option -- %c\n\n", program, optopt);
+	    usage_err(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	default:
+	    usage_err(3, program, "invalid -flag"); /*ooo*/
+	    not_reached();
+	}
+    }
+    if (optind != argc) {
+	usage_err(3, program, "expected no args"); /*ooo*/
+	not_reached();
+    }
+    dbg(DBG_LOW, "random pattern and name pairs: %jd, seed: %jd", random_count, seed);
+
+    /*
+     * match each table pattern against each table name
+     */
+    for (p = 0; patterns[p].pattern != NULL; ++p) {
+	for (i = 0; i < 2; ++i) {
+	    anycase = (i != 0);
+	    expect = anycase ? patterns[p].anycase_compiled : patterns[p].compiled;
+	    glob = compile_glob(patterns[p].pattern, anycase);
+	    if ((glob != NULL) != expect) {
+		dbg(DBG_NONE, "pattern: \"%s\" anycase: %s: compile_glob() %s but it should %s",
+			      patterns[p].pattern, booltostr(anycase),
+			      glob != NULL ? "compiled it" : "left it to fnmatch(3)",
+			      expect ? "compile it" : "leave it to fnmatch(3)");
+		++mismatches;
+	    }
+	    if (glob == NULL) {
+		continue;
+	    }
+	    for (n = 0; names[n] != NULL; ++n) {
+		++checks;
+		if (!chk_glob(patterns[p].pattern, names[n], anycase, glob)) {
+		    ++mismatches;
+		}
+	    }
+	    free(glob);
+	    glob = NULL;
+	}
+    }
+
+    /*
+     * match each random pattern against a random name
+     */
+    srandom((unsigned int)seed);
+    for (r = 0; r < random_count; ++r) {
+	random_string(pattern, pattern_chars);
+	random_string(name, name_chars);
+	anycase = (random() % 2 == 0);
+	glob = compile_glob(pattern, anycase);
+	if (glob == NULL) {
+	    continue;
+	}
+	++compiled;
+	++checks;
+	if (!chk_glob(pattern, name, anycase, glob)) {
+	    ++mismatches;
+	}
+	free(glob);
+	glob = NULL;
+    }
+    print("%s: %zu match(es) compared, %zu of %jd random pattern(s) compiled, %zu mismatch(es)\n",
+	  program, checks, compiled, random_count, mismatches);
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(mismatches > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * usage_err - print usage to stderr
+ *
+ * Example:
+ *      usage_err(3, program, "invalid -r count");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * This function does not return.
+ */
+static void
+usage_err(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage_err(): str was NULL, forcing it to be: %s\n", str);
+    }
+    if (prog == NULL) {
+	prog = "test_glob_match";
+	warn(__func__, "\nin usage_err(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage, prog, DEF_RANDOM_COUNT, DEF_SEED,
+		  "test_glob_match", GLOB_MATCH_TEST_VERSION);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
@@ -0,0 +1,1005 @@
+/*
+ * test_rule_count - test rule_count() against the reference stream based rule_count()
+ *
+ * "You are not expected to understand this" :-)
+ *
+ * Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson.
+ * All Rights Reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and
+ * its documentation for any purpose and without fee is hereby granted,
+ * provided that the above copyright, this permission notice and text
+ * this comment, and the disclaimer below appear in all of the following:
+ *
+ *       supporting documentation
+ *       source copies
+ *       source works derived from this source
+ *       binaries derived from this source or from derived source
+ *
+ * THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+ * ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+ * DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * The reference ref_rule_count() below is the fgetc(3) and ungetc(3) based
+ * rule_count() of iocccsize by Anthony Howe, as it was before soup/rule_count.c
+ * was changed to count a memory buffer.  Public Domain 1992, 2015, 2018, 2019,
+ * 2021 by Anthony Howe.  All rights released.
+ *
+ * "Because sometimes even the IOCCC Judges need some help." :-)
+ *
+ * Share and enjoy! :-)
+ *     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+ */
+
+
+/* special comments for the seqcexit tool */
+/* exit code out of numerical order - ignore in sequencing - ooo */
+/* exit code change of order - use new value in sequencing - coo */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <getopt.h>
+#include <time.h>
+#include <limits.h>
+
+/*
+ * dbg - info, debug, warning, error, and usage message facility
+ */
+#include "../dbg/dbg.h"
+
+/*
+ * pr - stdio helper library
+ */
+#include "../pr/pr.h"
+
+/*
+ * jparse/util - common utility functions for the JSON parser and tools
+ */
+#include "../jparse/util.h"
+
+/*
+ * version - official IOCCC toolkit versions
+ */
+#include "../soup/version.h"
+
+/*
+ * location - location/country codes and set the IOCCC locale
+ */
+#include "../soup/location.h"
+
+/*
+ * iocccsize - IOCCC Source Size Tool
+ */
+#include "../iocccsize.h"
+
+
+/*
+ * definitions
+ */
+#define DEF_RANDOM_COUNT (1000)		/* default number of random inputs */
+#define DEF_RANDOM_MAXLEN (4096)	/* default maximum length of a random input */
+#define DEF_SEED (1)			/* default random seed */
+#define DEF_REPEAT (100)		/* default number of times to count each input with -b */
+
+#define NO_STRING		0
+#define NO_COMMENT		0
+#define COMMENT_EOL		1
+#define COMMENT_BLOCK		2
+
+#define STRLEN(s)		(sizeof (s)-1)
+
+
+/*
+ * usage message
+ */
+static char const * const usage =
+"usage: %s [-h] [-v level] [-V] [-q] [-r count] [-l maxlen] [-s seed] [-b] [-n repeat] [file ...]\n"
+"\n"
+"\t-h\t\tprint help message and exit\n"
+"\t-v level\tset verbosity level: (def level: 0)\n"
+"\t-V\t\tprint version string and exit\n"
+"\t-q\t\tquiet mode: silence msg(), warn(), warnp() if -v 0 (def: loud :-) )\n"
+"\t-r count\tnumber of random inputs to test (def: %d)\n"
+"\t-l maxlen\tmaximum length of a random input (def: %d)\n"
+"\t-s seed\t\tseed of the random inputs (def: %d)\n"
+"\t-b\t\talso report the throughput of both rule_count engines in MB/s\n"
+"\t-n repeat\tcount each input repeat times for -b (def: %d)\n"
+"\n"
+"\tfile\t\tfile to count with both rule_count engines\n"
+"\n"
+"Each file, and each random input, is counted by the reference fgetc(3) based\n"
+"rule_count() and by the rule_count(), rule_count_mem() and rule_count_buf() of\n"
+"soup/rule_count.c, the latter given the input in random chunks and resumed\n"
+"from a checkpoint: all of their RuleCount results must be the same.\n"
+"\n"
+"Exit codes:\n"
+"     0   all counts are the same\n"
+"     1   some count is different\n"
+"     2   -h and help string printed or -V and version string printed\n"
+"     3   invalid command line, invalid option or option missing an argument\n"
+" >= 10   internal error\n"
+"\n"
+"%s version: %s\n"
+"iocccsize version: %s";
+
+
+/*
+ * bits of C, and not so C, that random inputs are made of
+ */
+static char const * const fragments[] = {
+    "/*", "*/", "//", "/", "*", "\\\n", "\\", "\r", "\r\n", "\n", " ", "\t", "\f",
+    "\"", "'", "\\\"", "{", "}", ";", "{ ", "; ", "}\n", ";\n",
+    "#", "# ", "#include", "# /* */ if", "#define", "#elifdef",
+    "int", "char", "while", "do", "or_eq", "_Static_assert", "typeof_unequal", "constexpr",
+    "x", "_", "0", "ints", "xxxxxxxxxxxxxxxint", "xxxxxxxxxxxxxxxxint", "xxxxxxxxxxxxxxxxxint",
+    "?", "?\?", "?\?=", "?\?/", "?\?<", "?\?>", "<%", "%>", "<:", ":>", "%:", "%:%:",
+    NULL
+};
+
+
+/*
+ * forward declarations
+ */
+static RuleCount ref_rule_count(FILE *fp_in);
+static bool chk_counts(char const *name, char const *buf, size_t len, FILE *stream);
+static char *random_input(size_t maxlen, size_t *plen);
+static double bench(char const *name, char **bufs, size_t *lens, size_t count, int repeat, bool ref);
+static void usage_err(int exitcode, char const *prog, char const *str) __attribute__((noreturn));
+
+
+/*
+ * reference C reserved words table
+ */
+typedef struct {
+	size_t length;
+	const char *word;
+} Word;
+
+static Word ref_cwords[] = {
+	/* Yes Virginia, we left #define off the list on purpose!  K&R */
+	{ STRLEN("#elif"), "#elif" } ,				/* K&R */
+	{ STRLEN("#elifdef"), "#elifdef" } ,			/* +C23 */
+	{ STRLEN("#elifndef"), "#elifndef" } ,			/* +C23 */
+	{ STRLEN("#else"), "#else" } ,				/* K&R */
+	{ STRLEN("#embed"), "#embed" } ,			/* +C23 */
+	{ STRLEN("#endif"), "#endif" } ,			/* K&R */
+	{ STRLEN("#error"), "#error" } ,			/* +C89 */
+	{ STRLEN("#ident"), "#ident" } ,			/* gcc */
+	{ STRLEN("#if"), "#if" } ,				/* K&R */
+	{ STRLEN("#ifdef"), "#ifdef" } ,			/* K&R */
+	{ STRLEN("#ifndef"), "#ifndef" } ,			/* K&R */
+	{ STRLEN("#include"), "#include" } ,			/* K&R */
+	{ STRLEN("#line"), "#line" } ,				/* K*R */
+	{ STRLEN("#pragma"), "#pragma" } ,			/* +C89 */
+	{ STRLEN("#sccs"), "#sccs" } ,				/* gcc */
+	{ STRLEN("#warning"), "#warning" } ,			/* +C23 */
+	{ STRLEN("#undef"), "#undef" } ,			/* K&R */
+
+	{ STRLEN("_Alignas"), "_Alignas" } ,			/* +C11 */
+	{ STRLEN("_Alignof"), "_Alignof" } ,			/* +C11 */
+	{ STRLEN("_Atomic"), "_Atomic" } ,			/* +C11 */
+	{ STRLEN("_BitInt"), "_BitInt" } ,			/* +C23 */
+	{ STRLEN("_Bool"), "_Bool" } ,				/* +C99 */
+	{ STRLEN("_Complex"), "_Complex" } ,			/* +C99 */
+	{ STRLEN("_Decimal128"), "_Decimal128" } ,		/* +C23 */
+	{ STRLEN("_Decimal64"), "_Decimal64" } ,		/* +C23 */
+	{ STRLEN("_Decimal32"), "_Decimal32" } ,		/* +C23 */
+	{ STRLEN("_Generic"), "_Generic" } ,			/* +C11 */
+	{ STRLEN("_Imaginary"), "_Imaginary" } ,		/* +C99 */
+	{ STRLEN("_Noreturn"), "_Noreturn" } ,			/* +C11 */
+	{ STRLEN("_Pragma"), "_Pragma" } ,			/* +C99 */
+	{ STRLEN("_Static_assert"), "_Static_assert" } ,	/* +C11 */
+	{ STRLEN("_Thread_local"), "_Thread_local" } ,		/* +C11 */
+
+	{ STRLEN("alignas"), "alignas" } ,			/* +C23 */
+	{ STRLEN("alignof"), "alignof" } ,			/* +C23 */
+	{ STRLEN("and"), "and" } ,				/* +C89 iso646.h */
+	{ STRLEN("and_eq"), "and_eq" } ,			/* +C89 iso646.h */
+	{ STRLEN("auto"), "auto" } ,				/* K&R */
+	{ STRLEN("bitand"), "bitand" } ,			/* +C89 iso646.h */
+	{ STRLEN("bitor"), "bitor" } ,				/* +C89 iso646.h */
+	{ STRLEN("bool"), "bool" } ,				/* +C23 */
+	{ STRLEN("break"), "break" } ,				/* K&R */
+	{ STRLEN("case"), "case" } ,				/* K&R */
+	{ STRLEN("char"), "char" } ,				/* K&R */
+	{ STRLEN("compl"), "compl" } ,				/* +C89 iso646.h */
+	{ STRLEN("const"), "const" } ,				/* +C89 */
+	{ STRLEN("constexpr"), "constexpr" } ,			/* +C23 */
+	{ STRLEN("continue"), "continue" } ,			/* K&R */
+	{ STRLEN("default"), "default" } ,			/* K&R */
+	{ STRLEN("do"), "do" } ,				/* K&R */
+	{ STRLEN("double"), "double" } ,			/* K&R */
+	{ STRLEN("else"), "else" } ,				/* K&R */
+	{ STRLEN("enum"), "enum" } ,				/* +C89 */
+	{ STRLEN("extern"), "extern" } ,			/* K&R */
+	{ STRLEN("false"), "false" } ,				/* +C23 */
+	{ STRLEN("float"), "float" } ,				/* K&R */
+	{ STRLEN("for"), "for" } ,				/* K&R */
+	{ STRLEN("goto"), "goto" } ,				/* K&R */
+	{ STRLEN("if"), "if" } ,				/* K&R */
+	{ STRLEN("inline"), "inline" } ,			/* +C99 */
+	{ STRLEN("int"), "int" } ,				/* K&R */
+	{ STRLEN("long"), "long" } ,				/* K&R */
+	{ STRLEN("noreturn"), "noreturn" } ,			/* +C23 */
+	{ STRLEN("not"), "not" } ,				/* +C89 iso646.h */
+	{ STRLEN("not_eq"), "not_eq" } ,			/* +C89 iso646.h */
+	{ STRLEN("nullptr"), "nullptr" } ,			/* +C23 */
+	{ STRLEN("or"), "or" } ,				/* +C89 iso646.h */
+	{ STRLEN("or_eq"), "or_eq" } ,				/* +C89 iso646.h */
+	{ STRLEN("register"), "register" } ,			/* K&R */
+	{ STRLEN("restrict"), "restrict" } ,			/* +C99 */
+	{ STRLEN("return"), "return" } ,			/* K&R */
+	{ STRLEN("short"), "short" } ,				/* K&R */
+	{ STRLEN("signed"), "signed" } ,			/* K&R */
+	{ STRLEN("sizeof"), "sizeof" } ,			/* K&R */
+	{ STRLEN("static"), "static" } ,			/* K&R */
+	{ STRLEN("static_assert"), "static_assert" } ,		/* +C23 */
+	{ STRLEN("struct"), "struct" } ,			/* K&R */
+	{ STRLEN("switch"), "switch" } ,			/* K&R */
+	{ STRLEN("thread_local"), "thread_local" } ,		/* +C23 */
+	{ STRLEN("true"), "true" } ,				/* +C23 */
+	{ STRLEN("typedef"), "typedef" } ,			/* K&R */
+	{ STRLEN("typeof"), "typeof" } ,			/* +C23 */
+	{ STRLEN("typeof_unequal"), "typeof_unequal" } ,	/* +C23 */
+	{ STRLEN("union"), "union" } ,				/* K&R */
+	{ STRLEN("unsigned"), "unsigned" } ,			/* K&R */
+	{ STRLEN("void"), "void" } ,				/* +C89 */
+	{ STRLEN("volatile"), "volatile" } ,			/* +C89 */
+	{ STRLEN("while"), "while" } ,				/* K&R */
+	{ STRLEN("xor"), "xor" } ,				/* +C89 iso646.h */
+	{ STRLEN("xor_eq"), "xor_eq" } ,			/* +C89 iso646.h */
+
+	{ 0, NULL }
+};
+
+
+/*
+ * ref_find_member - find an entry in the reference word table
+ *
+ * given:
+ *	table		table of words to scan
+ *	string		word to find in the table
+ *
+ * returns:
+ *	NULL ==> string is not in the table,
+ *	!= NULL ==> table entry that matches string
+ */
+static Word *
+ref_find_member(Word *table, const char *string)
+{
+	Word *w;
+	for (w = table; w->length != 0; w++) {
+		if (strcmp(string, w->word) == 0) {
+			return w;
+		}
+	}
+	return NULL;
+}
+
+
+/*
+ * ref_rule_count - the reference fgetc(3) and ungetc(3) based rule_count()
+ *
+ * NOTE: do NOT change this to keep up with soup/rule_count.c: it is what
+ *	 rule_count() is checked against, so it should only change if the
+ *	 Rule 2a or Rule 2b counting rules change.
+ *
+ * given:
+ *	fp_in		open file stream to count data on
+ *
+ * returns:
+ *	RuleCount information
+ */
+static RuleCount
+ref_rule_count(FILE *fp_in)
+{
+	size_t wordi = 0;
+	char word[WORD_BUFFER_SIZE];
+	RuleCount counts = { 0, 0, 0, false, false, false, false };
+	int ch, next_ch, quote = NO_STRING, escape = 0, is_comment = NO_COMMENT;
+
+/* If quote == NO_STRING (0) and is_comment == NO_COMMENT (0) then its code. */
+#define IS_CODE	(quote == is_comment)
+
+	/* Paranoia and to keep valgrind happy. */
+	(void) memset(word, 0, sizeof (word));
+
+	while ((ch = fgetc(fp_in)) != EOF) {
+		if (ch == '\r') {
+			/* Discard bare CR and those part of CRLF. */
+			counts.rule_2a_size++;
+			continue;
+		}
+		if (ch == '\0') {
+			counts.nul_warning = true;
+			counts.rule_2a_size++;
+			continue;
+		}
+
+		/* Future gazing. */
+		while ((next_ch = fgetc(fp_in)) != EOF && next_ch == '\r') {
+			/* Discard bare CR and those part of CRLF. */
+			counts.rule_2a_size++;
+		}
+#ifdef TRIGRAPHS
+		if (ch == '?' && next_ch == '?') {
+			/* ISO C11 section 5.2.1.1 Trigraph Sequences */
+			const char *t;
+			static const char trigraphs[] = "=#([)]'^<{!|>}-~/\\";
+
+			ch = fgetc(fp_in);
+			for (t = trigraphs; *t != '\0'; t += 2) {
+				if (ch == t[0]) {
+					/* Mapped trigraphs count as 1 byte. */
+					next_ch = fgetc(fp_in);
+					counts.rule_2a_size += 2;
+					ch = t[1];
+					break;
+				}
+			}
+
+			/* Unknown trigraph, push back the third character. */
+			if (*t == '\0') {
+				if (ch != EOF && ungetc(ch, fp_in) == EOF) {
+					counts.ungetc_warning = true;
+					counts.trigraph_warning = true;
+					counts.rule_2a_size++;
+					continue;
+				}
+				ch = '?';
+			}
+		}
+#endif
+		if (ch == '\\' && next_ch == '\n') {
+			/*
+			 * ISO C11 section 5.1.1.2 Translation Phases
+			 * point 2 discards backslash newlines.
+			 */
+			counts.rule_2a_size += 2;
+			continue;
+		}
+
+		if (next_ch != EOF && ungetc(next_ch, fp_in) == EOF) {
+			/*
+			 * ISO C ungetc() guarantees one character (byte) pushback.
+			 * How does that relate to UTF8 and wide-character library
+			 * handling?  An invalid trigraph results in 2x ungetc().
+			 */
+			counts.ungetc_warning = true;
+			counts.rule_2a_size++;
+			continue;
+		}
+
+		/* Within quoted string? */
+		if (quote != NO_STRING) {
+			/* Escape _this_ character. */
+			if (escape) {
+				escape = 0;
+			}
+
+			/* Escape next character. */
+			else if (ch == '\\') {
+				escape = 1;
+			}
+
+			/* Close matching quote? */
+			else if (ch == quote) {
+				quote = NO_STRING;
+			}
+		}
+
+		/* Within comment to end of line? */
+		else if (is_comment == COMMENT_EOL && ch == '\n') {
+			is_comment = NO_COMMENT;
+		}
+
+		/* Within comment block? */
+		else if (is_comment == COMMENT_BLOCK && ch == '*' && next_ch == '/') {
+			is_comment = NO_COMMENT;
+		}
+
+		/* Start of comment to end of line? */
+		else if (is_comment == NO_COMMENT && ch == '/' && next_ch == '/') {
+			is_comment = COMMENT_EOL;
+
+			/* Consume next_ch. */
+			ch = fgetc(fp_in);
+			counts.rule_2a_size++;
+			counts.rule_2b_size++;
+		}
+
+		/* Start of comment block? */
+		else if (is_comment == NO_COMMENT && ch == '/' && next_ch == '*') {
+			is_comment = COMMENT_BLOCK;
+
+			/* Consume next_ch. */
+			ch = fgetc(fp_in);
+			counts.rule_2a_size++;
+			counts.rule_2b_size++;
+		}
+
+		/* Open single or double quote? */
+		else if (is_comment == NO_COMMENT && (ch == '\'' || ch == '"')) {
+			quote = ch;
+		}
+
+#ifdef DIGRAPHS
+		/*
+		 * ISO C11 section 6.4.6 Punctuators, digraphs handled during
+		 * tokenization, but map here and count as 1 byte, like their
+		 * ASCII counter parts.
+		 */
+		if (IS_CODE) {
+			const char *d;
+			static const char digraphs[] = "[<:]:>{<%}%>#%:";
+			for (d = digraphs; *d != '\0'; d += 3) {
+				if (ch == d[1] && next_ch == d[2]) {
+					(void) fgetc(fp_in);
+					counts.rule_2a_size++;
+					ch = d[0];
+					break;
+				}
+			}
+		}
+#endif
+		/* Sanity check against file size and wc(1) byte count. */
+		counts.rule_2a_size++;
+
+		/*
+		 * End of possible keyword?  Care with #word as there can
+		 * be whitespace or comments between # and word.
+		 */
+		if ((word[0] != '#' || 1 < wordi) && !isalnum(ch) && ch != '_' && ch != '#') {
+			if (ref_find_member(ref_cwords, word) != NULL) {
+				/* Count keyword as 1. */
+				counts.rule_2b_size = counts.rule_2b_size - wordi + 1;
+				counts.keywords++;
+			}
+			word[wordi = 0] = '\0';
+		}
+
+		/* Ignore all whitespace. */
+		if (isspace(ch)) {
+			continue;
+		}
+
+		/* Ignore begin/end block and end of statement. */
+		if (strchr("{;}", ch) != NULL && (isspace(next_ch) || next_ch == EOF)) {
+			continue;
+		}
+
+		/* Collect next word not in a string or comment. */
+		if (IS_CODE && (isalnum(ch) || ch == '_' || ch == '#')) {
+			word[wordi++] = (char) ch;
+			if (sizeof (word) <= wordi) {
+				/* ISO C11 section 5.2.4.1 Translation limits, identifiers
+				 * can have 63 significant initial characters, which can be
+				 * multibyte.  The C keywords are all ASCII, longest is 14
+				 * bytes.
+				 *
+				 * We only care about the C keywords and not the identifiers,
+				 * so the buffer can overflow regularly as long words or
+				 * identifiers are ignored.
+				 */
+				wordi = 0;
+			}
+			word[wordi] = '\0';
+		}
+
+		counts.rule_2b_size++;
+	}
+
+	return counts;
+}
+
+
+/*
+ * same_counts - determine if two RuleCount results are the same
+ *
+ * given:
+ *	a		first RuleCount
+ *	b		second RuleCount
+ *
+ * returns:
+ *	true ==> every count and warning is the same
+ *	false ==> some count or warning is different
+ */
+static bool
+same_counts(RuleCount const *a, RuleCount const *b)
+{
+    return a->rule_2a_size == b->rule_2a_size &&
+	   a->rule_2b_size == b->rule_2b_size &&
+	   a->keywords == b->keywords &&
+	   a->nul_warning == b->nul_warning &&
+	   a->trigraph_warning == b->trigraph_warning &&
+	   a->wordbuf_warning == b->wordbuf_warning &&
+	   a->ungetc_warning == b->ungetc_warning;
+}
+
+
+/*
+ * chk_counts - count an input with both rule_count engines and compare
+ *
+ * The input is counted by the reference ref_rule_count(), by rule_count(),
+ * by rule_count_mem(), by rule_count_buf() given it in random chunks, and
+ * by rule_count_buf() resumed from a copy of its state at a random chunk
+ * boundary.
+ *
+ * given:
+ *	name		name of the input for messages
+ *	buf		contents of the input
+ *	len		length of buf
+ *	stream		open stream of the input, or NULL ==> a stream of buf
+ *
+ * returns:
+ *	true ==> all the counts agree
+ *	false ==> some count or warning is different
+ *
+ * NOTE: stream, if not NULL, is read by ref_rule_count() and then rewound
+ *	 and read by rule_count().
+ *
+ * This function does not return on error.
+ */
+static bool
+chk_counts(char const *name, char const *buf, size_t len, FILE *stream)
+{
+    static RuleCount const zero = { 0, 0, 0, false, false, false, false }; /* counts of no data */
+    RuleCount ref;		/* reference rule_count() results */
+    RuleCount strm;		/* rule_count() results */
+    RuleCount mem;		/* rule_count_mem() results */
+    RuleCount chunked;		/* rule_count_buf() results of random chunks */
+    RuleCount resumed;		/* rule_count_buf() results resumed from a checkpoint */
+    struct rule_count_state state;	/* rule_count_buf() state */
+    struct rule_count_state checkpoint;	/* copy of state at a random chunk boundary */
+    size_t checkpoint_at;	/* offset of the checkpoint */
+    size_t off;			/* offset of the next chunk */
+    size_t chunk;		/* length of the next chunk */
+    bool close_stream = false;	/* true ==> we opened stream */
+
+    /*
+     * firewall
+     */
+    if (name == NULL || buf == NULL) {
+	err(10, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    /*
+     * count with the stream engines
+     */
+    if (len == 0) {
+	ref = zero;
+	strm = zero;
+    } else {
+	if (stream == NULL) {
+	    errno = 0;		/* pre-clear errno for errp() */
+	    stream = fmemopen((void *)buf, len, "r");
+	    if (stream == NULL) {
+		errp(11, __func__, "fmemopen of %zu bytes failed for: %s", len, name);
+		not_reached();
+	    }
+	    close_stream = true;
+	}
+	ref = ref_rule_count(stream);
+	rewind(stream);
+	strm = rule_count(stream);
+	if (close_stream) {
+	    (void) fclose(stream);
+	}
+    }
+
+    /*
+     * count the buffer at once, and in random chunks of 0 to 16 bytes
+     */
+    mem = rule_count_mem(buf, len);
+    rule_count_init(&state);
+    checkpoint = state;
+    checkpoint_at = 0;
+    chunked = rule_count_buf(NULL, 0, &state);
+    for (off = 0; off < len; off += chunk) {
+	if (random() % 4 == 0) {
+	    checkpoint = state;
+	    checkpoint_at = off;
+	}
+	chunk = (size_t)random() % 17;
+	if (chunk > len - off) {
+	    chunk = len - off;
+	}
+	chunked = rule_count_buf(buf + off, chunk, &state);
+    }
+
+    /*
+     * resume from the checkpoint with the rest of the buffer at once
+     */
+    if (checkpoint.offset != checkpoint_at) {
+	warn(__func__, "%s: checkpoint offset: %zu != %zu", name, checkpoint.offset, checkpoint_at);
+	return false;
+    }
+    resumed = rule_count_buf(buf + checkpoint_at, len - checkpoint_at, &checkpoint);
+
+    /*
+     * compare counts
+     */
+    if (!same_counts(&ref, &mem) || !same_counts(&ref, &strm) ||
+	!same_counts(&ref, &chunked) || !same_counts(&ref, &resumed)) {
+	warn(__func__, "%s: count mismatch: reference: %zu %zu %zu %d%d%d%d "
+		       "rule_count: %zu %zu %zu %d%d%d%d rule_count_mem: %zu %zu %zu %d%d%d%d "
+		       "chunked: %zu %zu %zu %d%d%d%d resumed at %zu: %zu %zu %zu %d%d%d%d",
+		       name,
+		       ref.rule_2b_size, ref.rule_2a_size, ref.keywords, ref.nul_warning,
+		       ref.trigraph_warning, ref.wordbuf_warning, ref.ungetc_warning,
+		       strm.rule_2b_size, strm.rule_2a_size, strm.keywords, strm.nul_warning,
+		       strm.trigraph_warning, strm.wordbuf_warning, strm.ungetc_warning,
+		       mem.rule_2b_size, mem.rule_2a_size, mem.keywords, mem.nul_warning,
+		       mem.trigraph_warning, mem.wordbuf_warning, mem.ungetc_warning,
+		       chunked.rule_2b_size, chunked.rule_2a_size, chunked.keywords, chunked.nul_warning,
+		       chunked.trigraph_warning, chunked.wordbuf_warning, chunked.ungetc_warning,
+		       checkpoint_at,
+		       resumed.rule_2b_size, resumed.rule_2a_size, resumed.keywords, resumed.nul_warning,
+		       resumed.trigraph_warning, resumed.wordbuf_warning, resumed.ungetc_warning);
+	return false;
+    }
+    dbg(DBG_MED, "%s: %zu %zu %zu", name, mem.rule_2b_size, mem.rule_2a_size, mem.keywords);
+    return true;
+}
+
+
+/*
+ * random_input - form a random input out of bits of C and random bytes
+ *
+ * given:
+ *	maxlen		maximum length of the input
+ *	plen		pointer to the length of the input
+ *
+ * returns:
+ *	malloced random input, not NUL terminated
+ *
+ * This function does not return on error.
+ */
+static char *
+random_input(size_t maxlen, size_t *plen)
+{
+    static size_t fragment_count = 0;	/* number of fragments */
+    char *buf = NULL;			/* random input */
+    size_t want;			/* length of the random input */
+    size_t len = 0;			/* length so far */
+    size_t flen;			/* length of a fragment */
+    char const *f;			/* fragment to add */
+
+    /*
+     * firewall
+     */
+    if (plen == NULL) {
+	err(12, __func__, "plen is NULL");
+	not_reached();
+    }
+    if (fragment_count == 0) {
+	while (fragments[fragment_count] != NULL) {
+	    ++fragment_count;
+	}
+    }
+
+    /*
+     * add fragments, and now and then a random byte, up to the length
+     */
+    want = maxlen > 0 ? (size_t)random() % (maxlen + 1) : 0;
+    errno = 0;			/* pre-clear errno for errp() */
+    buf = malloc(want + 1);
+    if (buf == NULL) {
+	errp(13, __func__, "malloc of %zu bytes failed", want + 1);
+	not_reached();
+    }
+    while (len < want) {
+	if (random() % 8 == 0) {
+	    buf[len++] = (char)(random() % 256);
+	    continue;
+	}
+	f = fragments[(size_t)random() % fragment_count];
+	flen = strlen(f);
+	if (flen > want - len) {
+	    flen = want - len;
+	}
+	memcpy(buf + len, f, flen);
+	len += flen;
+    }
+
+    *plen = len;
+    return buf;
+}
+
+
+/*
+ * bench - time counting inputs with one of the rule_count engines
+ *
+ * given:
+ *	name		name of the engine for messages
+ *	bufs		inputs to count
+ *	lens		length of each input
+ *	count		number of inputs
+ *	repeat		number of times to count each input
+ *	ref		true ==> use the reference ref_rule_count() on a stream,
+ *			false ==> use rule_count_mem()
+ *
+ * returns:
+ *	MB/s the engine counted
+ *
+ * This function does not return on error.
+ */
+static double
+bench(char const *name, char **bufs, size_t *lens, size_t count, int repeat, bool ref)
+{
+    struct timespec start;	/* when we started */
+    struct timespec end;	/* when we ended */
+    double secs;		/* seconds taken */
+    double bytes = 0.0;		/* bytes counted */
+    size_t sum = 0;		/* sum of the counts, so they are not optimized away */
+    FILE *stream;		/* stream of an input for ref */
+    RuleCount counts;		/* rule_count results */
+    size_t i;
+    int r;
+
+    /*
+     * firewall
+     */
+    if (name == NULL || bufs == NULL || lens == NULL) {
+	err(14, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    for (r = 0; r < repeat; ++r) {
+	for (i = 0; i < count; ++i) {
+	    if (lens[i] == 0) {
+		continue;
+	    }
+	    if (ref) {
+		errno = 0;		/* pre-clear errno for errp() */
+		stream = fmemopen(bufs[i], lens[i], "r");
+		if (stream == NULL) {
+		    errp(15, __func__, "fmemopen of %zu bytes failed", lens[i]);
+		    not_reached();
+		}
+		counts = ref_rule_count(stream);
+		(void) fclose(stream);
+	    } else {
+		counts = rule_count_mem(bufs[i], lens[i]);
+	    }
+	    sum += counts.rule_2b_size;
+	    bytes += (double)lens[i];
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    secs = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    if (secs <= 0.0) {
+	secs = 1e-9;
+    }
+    dbg(DBG_LOW, "%s: counted %.0f bytes in %.6f seconds, sum of Rule 2b sizes: %zu", name, bytes, secs, sum);
+    return bytes / (1024.0 * 1024.0) / secs;
+}
+
+
+int
+main(int argc, char **argv)
+{
+    char const *program = NULL;		/* our name */
+    extern char *optarg;		/* option argument */
+    extern int optind;			/* argv index of the next arg */
+    intmax_t random_count = DEF_RANDOM_COUNT; /* number of random inputs */
+    intmax_t random_maxlen = DEF_RANDOM_MAXLEN; /* maximum length of a random input */
+    intmax_t seed = DEF_SEED;		/* random seed */
+    bool benchmark = false;		/* true ==> -b, report MB/s */
+    intmax_t repeat = DEF_REPEAT;	/* -n repeat for -b */
+    char **bufs = NULL;			/* each input */
+    size_t *lens = NULL;		/* length of each input */
+    size_t count;			/* number of inputs */
+    size_t n = 0;			/* number of inputs formed */
+    size_t mismatches = 0;		/* inputs the engines did not agree on */
+    char name[BUFSIZ+1];		/* name of a random input */
+    FILE *stream;			/* open stream of a file */
+    double ref_mbs;			/* reference MB/s */
+    double mem_mbs;			/* rule_count_mem() MB/s */
+    int i;
+
+    /* IOCCC requires use of C locale */
+    set_ioccc_locale();
+
+    /*
+     * parse args
+     */
+    program = argv[0];
+    while ((i = getopt(argc, argv, ":hv:Vqr:l:s:bn:")) != -1) {
+	switch (i) {
+	case 'h':	/* -h - write help, to stderr and exit 2 */
+	    usage_err(2, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case 'v':	/* -v verbosity */
+	    verbosity_level = parse_verbosity(optarg);
+	    if (verbosity_level < 0) {
+		usage_err(3, program, "invalid -v verbosity"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'V':	/* -V - write version and exit 2 */
+	    print("%s version: %s\n", program, RULE_COUNT_TEST_VERSION);
+	    print("iocccsize version: %s\n", iocccsize_version);
+	    exit(2); /*ooo*/
+	    not_reached();
+	    break;
+	case 'q':
+	    msg_warn_silent = true;
+	    break;
+	case 'r':	/* -r count - number of random inputs */
+	    if (!string_to_intmax(optarg, &random_count) || random_count < 0) {
+		usage_err(3, program, "invalid -r count"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'l':	/* -l maxlen - maximum length of a random input */
+	    if (!string_to_intmax(optarg, &random_maxlen) || random_maxlen < 0) {
+		usage_err(3, program, "invalid -l maxlen"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 's':	/* -s seed - random seed */
+	    if (!string_to_intmax(optarg, &seed)) {
+		usage_err(3, program, "invalid -s seed"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case 'b':	/* -b - report MB/s */
+	    benchmark = true;
+	    break;
+	case 'n':	/* -n repeat - times to count each input for -b */
+	    if (!string_to_intmax(optarg, &repeat) || repeat <= 0 || repeat > INT_MAX) {
+		usage_err(3, program, "invalid -n repeat"); /*ooo*/
+		not_reached();
+	    }
+	    break;
+	case ':':
+	    (void) fprintf(stderr, "%s: requires an argument -- %c\n\n", program, optopt);
+	    usage_err(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	case '?':
+	    (void) fprintf(stderr, "%s: illegal option -- %c\n\n", program, optopt);
+	    usage_err(3, program, ""); /*ooo*/
+	    not_reached();
+	    break;
+	default:
+	    usage_err(3, program, "invalid -flag"); /*ooo*/
+	    not_reached();
+	}
+    }
+    count = (size_t)(argc - optind) + (size_t)random_count;
+    dbg(DBG_LOW, "files: %d random inputs: %jd of at most %jd bytes, seed: %jd",
+		 argc - optind, random_count, random_maxlen, seed);
+
+    /*
+     * keep every input for -b
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    bufs = calloc(count + 1, sizeof(*bufs));
+    if (bufs == NULL) {
+	errp(16, __func__, "calloc of %zu input pointers failed", count + 1);
+	not_reached();
+    }
+    errno = 0;			/* pre-clear errno for errp() */
+    lens = calloc(count + 1, sizeof(*lens));
+    if (lens == NULL) {
+	errp(17, __func__, "calloc of %zu input lengths failed", count + 1);
+	not_reached();
+    }
+
+    /*
+     * count each file
+     */
+    for (i = optind; i < argc; ++i, ++n) {
+	errno = 0;			/* pre-clear errno for errp() */
+	stream = fopen(argv[i], "r");
+	if (stream == NULL) {
+	    errp(18, __func__, "cannot open: %s", argv[i]);
+	    not_reached();
+	}
+	bufs[n] = read_all(stream, &lens[n]);
+	if (bufs[n] == NULL) {
+	    err(19, __func__, "cannot read: %s", argv[i]);
+	    not_reached();
+	}
+	rewind(stream);
+	if (!chk_counts(argv[i], bufs[n], lens[n], stream)) {
+	    ++mismatches;
+	}
+	(void) fclose(stream);
+    }
+
+    /*
+     * count each random input
+     */
+    srandom((unsigned int)seed);
+    for (; n < count; ++n) {
+	bufs[n] = random_input((size_t)random_maxlen, &lens[n]);
+	(void) snprintf(name, BUFSIZ, "random input %zu seed %jd", n - (size_t)(argc - optind), seed);
+	if (!chk_counts(name, bufs[n], lens[n], NULL)) {
+	    ++mismatches;
+	}
+    }
+    print("%s: %zu input(s) counted, %zu mismatch(es)\n", program, count, mismatches);
+
+    /*
+     * report throughput if -b
+     */
+    if (benchmark) {
+	ref_mbs = bench("reference rule_count", bufs, lens, count, (int)repeat, true);
+	mem_mbs = bench("rule_count_mem", bufs, lens, count, (int)repeat, false);
+	print("reference rule_count: %.2f MB/s\n", ref_mbs);
+	print("rule_count_mem: %.2f MB/s\n", mem_mbs);
+	print("speedup: %.2fx\n", ref_mbs > 0.0 ? mem_mbs / ref_mbs : 0.0);
+    }
+
+    /*
+     * free storage
+     */
+    for (n = 0; n < count; ++n) {
+	if (bufs[n] != NULL) {
+	    free(bufs[n]);
+	    bufs[n] = NULL;
+	}
+    }
+    free(bufs);
+    bufs = NULL;
+    free(lens);
+    lens = NULL;
+
+    /*
+     * All Done!!! All Done!!! -- Jessica Noll, Age 2
+     */
+    exit(mismatches > 0 ? 1 : 0); /*ooo*/
+}
+
+
+/*
+ * usage_err - print usage to stderr
+ *
+ * Example:
+ *      usage_err(3, program, "invalid -r count");
+ *
+ * given:
+ *	exitcode        value to exit with
+ *	prog		our program name
+ *	str		top level usage message
+ *
+ * This function does not return.
+ */
+static void
+usage_err(int exitcode, char const *prog, char const *str)
+{
+    /*
+     * firewall
+     */
+    if (str == NULL) {
+	str = "((NULL str))";
+	warn(__func__, "\nin usage_err(): str was NULL, forcing it to be: %s\n", str);
+    }
+    if (prog == NULL) {
+	prog = "test_rule_count";
+	warn(__func__, "\nin usage_err(): prog was NULL, forcing it to be: %s\n", prog);
+    }
+
+    /*
+     * print the formatted usage stream
+     */
+    if (*str != '\0') {
+	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
+    }
+    fprintf_usage(exitcode, stderr, usage, prog, DEF_RANDOM_COUNT, DEF_RANDOM_MAXLEN, DEF_SEED, DEF_REPEAT,
+		  "test_rule_count", RULE_COUNT_TEST_VERSION, iocccsize_version);
+    exit(exitcode); /*ooo*/
+    not_reached();
+}
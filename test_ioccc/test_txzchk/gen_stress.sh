@@ -0,0 +1,239 @@
+#!/usr/bin/env bash
+#
+# gen_stress.sh - generate large tar listings and time txzchk on them
+#
+# Each listing is a txzchk -T text file (see README.md) of a test submission
+# with the required files plus a given number of extra files, so that the time
+# txzchk takes as the number of entries doubles shows how it scales.
+#
+# Copyright (c) 2026 by Landon Curt Noll and Cody Boone Ferguson.
+# All Rights Reserved.
+#
+# Permission to use, copy, modify, and distribute this software and
+# its documentation for any purpose and without fee is hereby granted,
+# provided that the above copyright, this permission notice and text
+# this comment, and the disclaimer below appear in all of the following:
+#
+#       supporting documentation
+#       source copies
+#       source works derived from this source
+#       binaries derived from this source or from derived source
+#
+# THE AUTHORS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING
+# ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+# AUTHORS BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY
+# DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+# CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+# Share and enjoy! :-)
+#     --  Sirius Cybernetics Corporation Complaints Division, JSON spec department. :-)
+#
+
+
+# IOCCC requires use of C locale
+#
+export LANG="C"
+export LC_CTYPE="C"
+export LC_NUMERIC="C"
+export LC_TIME="C"
+export LC_COLLATE="C"
+export LC_MONETARY="C"
+export LC_MESSAGES="C"
+export LC_PAPER="C"
+export LC_NAME="C"
+export LC_ADDRESS="C"
+export LC_TELEPHONE="C"
+export LC_MEASUREMENT="C"
+export LC_IDENTIFICATION="C"
+export LC_ALL="C"
+
+
+# setup
+#
+export GEN_STRESS_VERSION="1.0.0 2026-10-18"
+export TXZCHK="./txzchk"
+export WORKDIR=
+export DUPS=
+export KEEP=
+export COUNTS="1000 2000 4000 8000 16000 32000"
+
+# usage message
+#
+export USAGE="usage: $0 [-h] [-V] [-v level] [-T txzchk] [-w workdir] [-d] [-k] [count ...]
+
+    -h			print help and exit
+    -V			print version and exit
+    -v level		set verbosity level for this script: (def level: 0)
+
+    -T txzchk		path to txzchk executable (def: $TXZCHK)
+    -w workdir		write the listings under workdir (def: a temporary directory)
+    -d			make every other extra file a case independent duplicate of the one before it
+    -k			keep the listings (def: remove them unless -w workdir)
+
+    count		number of extra files in a listing (def: $COUNTS)
+
+For each count, a listing is written and the seconds that txzchk -T took to
+check it are printed as: count seconds
+
+NOTE: such listings have far too many extra files, so txzchk reports them
+      as feathery: only the time it takes matters here.
+
+Exit codes:
+     0   all OK
+     2   -h and help string printed or -V and version string printed
+     3   invalid command line
+ >= 10   internal error or missing file or directory
+
+gen_stress.sh version: $GEN_STRESS_VERSION"
+
+
+# parse args
+#
+export V_FLAG="0"
+while getopts :hVv:T:w:dk flag; do
+    case "$flag" in
+    h)	echo "$USAGE" 1>&2
+	exit 2
+	;;
+    V)	echo "$GEN_STRESS_VERSION"
+	exit 2
+	;;
+    v)	V_FLAG="$OPTARG";
+	;;
+    T)	TXZCHK="$OPTARG";
+	;;
+    w)	WORKDIR="$OPTARG";
+	KEEP="true"
+	;;
+    d)	DUPS="true"
+	;;
+    k)	KEEP="true"
+	;;
+    \?) echo "$0: ERROR: invalid option: -$OPTARG" 1>&2
+	echo 1>&2
+	echo "$USAGE" 1>&2
+	exit 3
+	;;
+    :)	echo "$0: ERROR: option -$OPTARG requires an argument" 1>&2
+	echo 1>&2
+	echo "$USAGE" 1>&2
+	exit 3
+	;;
+   *)
+	;;
+    esac
+done
+
+# check args
+#
+shift $(( OPTIND - 1 ));
+if [[ $# -gt 0 ]]; then
+    COUNTS="$*"
+fi
+for count in $COUNTS; do
+    if [[ ! $count =~ ^[0-9]+$ ]]; then
+	echo "$0: ERROR: count is not a number: $count" 1>&2
+	echo 1>&2
+	echo "$USAGE" 1>&2
+	exit 3
+    fi
+done
+
+# check for txzchk
+#
+if [[ ! -e $TXZCHK ]]; then
+    echo "$0: ERROR: txzchk not found: $TXZCHK" 1>&2
+    exit 10
+fi
+if [[ ! -f $TXZCHK ]]; then
+    echo "$0: ERROR: txzchk not a regular file: $TXZCHK" 1>&2
+    exit 11
+fi
+if [[ ! -x $TXZCHK ]]; then
+    echo "$0: ERROR: txzchk not executable: $TXZCHK" 1>&2
+    exit 12
+fi
+
+# setup the work directory
+#
+if [[ -z $WORKDIR ]]; then
+    WORKDIR=$(mktemp -d -t gen_stress.XXXXXXXXXX)
+    status="$?"
+    if [[ $status -ne 0 || ! -d $WORKDIR ]]; then
+	echo "$0: ERROR: mktemp -d -t gen_stress.XXXXXXXXXX exit code: $status" 1>&2
+	exit 13
+    fi
+    if [[ -z $KEEP ]]; then
+	trap 'rm -rf "$WORKDIR"; exit' 0 1 2 3 15
+    fi
+elif [[ ! -d $WORKDIR ]]; then
+    mkdir -p "$WORKDIR"
+    status="$?"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: mkdir -p $WORKDIR exit code: $status" 1>&2
+	exit 14
+    fi
+fi
+if [[ $V_FLAG -ge 1 ]]; then
+    echo "$0: debug[1]: writing listings under: $WORKDIR" 1>&2
+fi
+
+# gen_listing - write a tar listing of a test submission with count extra files
+#
+# usage:
+#	gen_listing count listing
+#
+# The extra files are spread over subdirectories of 100 files each.
+#
+gen_listing()
+{
+    local count="$1"
+    local listing="$2"
+
+    awk -v count="$count" -v dups="$DUPS" 'BEGIN {
+	stamp = "Mar 17 04:09";
+	printf("drwxr-xr-x  0 501    20          0 %s test-0/\n", stamp);
+	printf("-r--r--r--  0 501    20       1854 %s test-0/Makefile\n", stamp);
+	printf("-r--r--r--  0 501    20          0 %s test-0/prog.c\n", stamp);
+	printf("-r--r--r--  0 501    20       2741 %s test-0/.auth.json\n", stamp);
+	printf("-r--r--r--  0 501    20       2883 %s test-0/remarks.md\n", stamp);
+	printf("-r--r--r--  0 501    20       1378 %s test-0/.info.json\n", stamp);
+	for (i = 0; i < count; ++i) {
+	    dir = sprintf("test-0/dir%04d", int(i / 100));
+	    if (i % 100 == 0) {
+		printf("drwxr-xr-x  0 501    20          0 %s %s/\n", stamp, dir);
+	    }
+	    if (dups != "" && i % 2 == 1) {
+		name = sprintf("FILE%06d", i - 1);
+	    } else {
+		name = sprintf("file%06d", i);
+	    }
+	    printf("-r--r--r--  0 501    20          4 %s %s/%s\n", stamp, dir, name);
+	}
+    }' > "$listing"
+}
+
+# generate and time each listing
+#
+for count in $COUNTS; do
+    mkdir -p "$WORKDIR/$count"
+    listing="$WORKDIR/$count/submit.test-0.1922598666.txt"
+    gen_listing "$count" "$listing"
+    status="$?"
+    if [[ $status -ne 0 ]]; then
+	echo "$0: ERROR: gen_listing $count $listing exit code: $status" 1>&2
+	exit 15
+    fi
+    if [[ $V_FLAG -ge 3 ]]; then
+	echo "$0: debug[3]: about to run: $TXZCHK -x -q -v 0 -T -E txt -- $listing" 1>&2
+    fi
+    start="$EPOCHREALTIME"
+    "$TXZCHK" -x -q -v 0 -T -E txt -- "$listing" >/dev/null 2>&1
+    end="$EPOCHREALTIME"
+    awk -v count="$count" -v start="$start" -v end="$end" 'BEGIN { printf("%d %.3f\n", count, end - start); }'
+done
+
+# All Done!!! All Done!!! -- Jessica Noll, Age 2
+#
+exit 0
@@ -99,12 +99,13 @@ enum path_type {
  * globals
  */
 static char *program = "try_walk_set";		    /* our name */
+static int jobs = 0;				    /* par_walk() threads, 0 ==> fts_walk() */
 
 /*
  * usage message
  */
 static char const * const usage_msg =
-    "usage: %s [-h] [-v level] [-V] [-q] [-T] [-o]\n"
+    "usage: %s [-h] [-v level] [-V] [-q] [-T] [-o] [-j jobs]\n"
     "\t\t\t[-m max_path] [-M max_depth] [-d max_depth]\n"
     "\t\t\t[-F max_file] [-D max_dir] [-S max_sym] [-O max_other] [-s set] topdir\n"
     "\n"
@@ -115,6 +116,7 @@ static char const * const usage_msg =
     "\n"
     "\t-o\t\tkeep paths in original order (def: sort dynamic arrays by canonicalized path)\n"
     "\t-T\t\tprocess as a tarball listing\n"
+    "\t-j jobs\t\twalk with par_walk() using jobs threads, 0 ==> walk with fts_walk() (def: 0)\n"
     "\n"
     "\t-m max_path\tmax canonicalized path length, 0 ==> no limit (def: %d)\n"
     "\t-M max_file\tmax length of any canonicalized path component, 0 ==> no limit (def: %d)\n"
@@ -193,7 +195,7 @@ main(int argc, char *argv[])
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:VqoTm:M:d:s:F:D:S:O:")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:VqoTj:m:M:d:s:F:D:S:O:")) != -1) {
 	switch (i) {
 	case 'h':	/* -h - print help to stderr and exit 0 */
 	    usage(2, NULL);
@@ -221,6 +223,14 @@ main(int argc, char *argv[])
 	case 'T':
 	    err(3, program, "-T used, however tarball list processing it NOT yet supported"); /*ooo*/
 	    break;
+	case 'j':
+	    errno = 0;
+	    jobs = (int) strtol(optarg, NULL, 0);
+	    if (errno != 0 || jobs < 0 || jobs > PAR_WALK_MAX_JOBS) {
+		err(3, program, "-j %s must be from 0 to %d", optarg, PAR_WALK_MAX_JOBS); /*ooo*/
+		not_reached();
+	    }
+	    break;
 	case 'm':
 	    errno = 0;
 	    max_path_len = (size_t) strtoumax(optarg, NULL, 0);
@@ -546,9 +556,13 @@ test_walk(FILE *out,
     /*
      * walk a file system tree, recording steps
      */
-    walk_ok = fts_walk(&wstat);
+    if (jobs > 0) {
+	walk_ok = par_walk(&wstat, jobs);
+    } else {
+	walk_ok = fts_walk(&wstat);
+    }
     if (walk_ok == false) {
-	dbg(DBG_MED, "%s: fts_walk() failed", __func__);
+	dbg(DBG_MED, "%s: %s() failed", __func__, (jobs > 0) ? "par_walk" : "fts_walk");
 	return false;
     }
 
@@ -1,6 +1,6 @@
 #!/usr/bin/env bash
 #
-# txzchk_test.sh - test txzchk with good and bad tarballs (as text files)
+# txzchk_test.sh - test txzchk with good and bad tarballs (as text files and as xz compressed tarballs)
 #
 # Copyright (c) 2022-2025 by Cody Boone Ferguson.  All Rights Reserved.
 #
@@ -93,7 +93,7 @@ TAR="$(type -P tar 2>/dev/null)"
 # but due to the reasons cited above we must rely on the more complicated form:
 [[ -z "$TAR" ]] && TAR="/usr/bin/tar"
 
-export TXZCHK_TEST_VERSION="2.0.2 2025-11-15"
+export TXZCHK_TEST_VERSION="2.0.4 2026-10-18"
 export FNAMCHK="./test_ioccc/fnamchk"
 export TXZCHK="./txzchk"
 export TXZCHK_TREE="./test_ioccc/test_txzchk"
@@ -356,6 +356,11 @@ if [[ -n "$B_FLAG" ]]; then
             "$TXZCHK" -v 0 -w -T -E txt -F "$FNAMCHK" "$file" 2>"$file.err"; \
         fi
     done < <(find "$TXZCHK_BAD_TREE" -type f -name '*.txt' -print)
+    while read -r file; do
+        file="${file#./}"
+        echo "$TXZCHK -v 0 -x -w -F $FNAMCHK -- $file 2>$file.err"; \
+        "$TXZCHK" -v 0 -x -w -F "$FNAMCHK" -- "$file" 2>"$file.err"; \
+    done < <(find "$TXZCHK_BAD_TREE" -type f -name 'submit.test-*.txz' -print)
 
     if [[ $V_FLAG -ge 1 ]]; then
 	echo "$0: debug[1]: rebuilt test error files" 1>&2
@@ -369,7 +374,7 @@ if [[ -n "$B_FLAG" ]]; then
     echo "to verify that everything is in order. If it is and there are any file changes," 1>&2
     echo "you will need to then run:" 1>&2
     echo 1>&2
-    echo "    git add test_ioccc/test_txzchk/bad/*.txt test_ioccc/test_txzchk/bad/*.err" 1>&2
+    echo "    git add test_ioccc/test_txzchk/bad/*.txt test_ioccc/test_txzchk/bad/*.txz test_ioccc/test_txzchk/bad/*.err" 1>&2
     echo 1>&2
     echo "and then commit (and if necessary open a pull request)." 1>&2
     echo "Otherwise, if there is a problem you will have to fix any other issues first." 1>&2
@@ -655,10 +660,151 @@ while read -r file; do
     run_test fail "$file"
 done < <(find "$TXZCHK_BAD_TREE" -type f -name '*.txt' -print)
 
+# run_txz_test - run txzchk on an xz compressed tarball
+#
+# usage:
+#	run_txz_test {fail|pass} tarball
+#
+#	run_txz_test	    - our function name
+#	fail		    - test must fail - error if passes
+#	pass		    - test must pass - error if fails
+#	tarball		    - the submit.test-*.txz tarball to give to txzchk -x
+#
+# Unlike run_test, txzchk reads the tarball itself (without -T) so that the
+# xz compressed data, including what comes after the end of the tarball, is
+# checked too.  The stderr of a tarball that must fail must match its .err file.
+#
+run_txz_test()
+{
+    # parse args
+    #
+    if [[ $# -ne 2 ]]; then
+	echo "$0: ERROR: expected 2 args to run_txz_test, found $#" 1>&2
+	exit 44
+    fi
+    declare pass_fail="$1"
+    declare tarball="${2#./}"
+    declare txzchk_err_file="$tarball.err"
+
+    if [[ $pass_fail = fail && ! -r $txzchk_err_file ]]; then
+	echo "$0: in run_txz_test: txzchk_err_file not a readable file for test that must fail: $txzchk_err_file"
+	exit 45
+    fi
+    if [[ $V_FLAG -ge 5 ]]; then
+	echo "$0: debug[5]: in run_txz_test: about to run: $TXZCHK -x -w -v 0 -F $FNAMCHK -- $tarball 2>$TMP_STDERR_FILE" 1>&2
+    fi
+    "$TXZCHK" -x -w -v 0 -F "$FNAMCHK" -- "$tarball" 2>"$TMP_STDERR_FILE"
+    status="$?"
+    if [[ $V_FLAG -ge 7 ]]; then
+	echo "$0: debug[7]: in run_txz_test: txzchk exit code: $status" 1>&2
+    fi
+
+    # examine test result
+    #
+    if [[ $pass_fail = fail ]]; then
+	if [[ $status -eq 0 ]] || ! cmp -s "$txzchk_err_file" "$TMP_STDERR_FILE"; then
+	    echo "$0: Warning: in run_txz_test: FAIL: $TXZCHK -x -w -v 0 -F $FNAMCHK -- $tarball" | tee -a -- "$LOGFILE" 1>&2
+	    echo "$0: Warning: in run_txz_test: exit code: $status, expected errors: $txzchk_err_file" | tee -a -- "$LOGFILE" 1>&2
+	    diff -u "$txzchk_err_file" "$TMP_STDERR_FILE" | tee -a -- "$LOGFILE" 1>&2
+	    echo | tee -a -- "${LOGFILE}" 1>&2
+	    EXIT_CODE=1
+	elif [[ $V_FLAG -ge 5 ]]; then
+	    echo "$0: debug[5]: in run_txz_test: PASS: $TXZCHK -x -w -v 0 -F $FNAMCHK -- $tarball" 1>&2
+	fi
+    elif [[ $status -ne 0 || -s "$TMP_STDERR_FILE" ]]; then
+	echo "$0: Warning: in run_txz_test: FAIL: $TXZCHK -x -w -v 0 -F $FNAMCHK -- $tarball" | tee -a -- "$LOGFILE" 1>&2
+	echo "$0: Warning: in run_txz_test: exit code: $status, unexpected errors found for tarball that should have passed:" | tee -a -- "$LOGFILE" 1>&2
+	< "$TMP_STDERR_FILE" tee -a -- "$LOGFILE" 1>&2
+	echo | tee -a -- "${LOGFILE}" 1>&2
+	EXIT_CODE=1
+    elif [[ $V_FLAG -ge 5 ]]; then
+	echo "$0: debug[5]: in run_txz_test: PASS: $TXZCHK -x -w -v 0 -F $FNAMCHK -- $tarball" 1>&2
+    fi
+    return
+}
+
+# run tests on xz compressed tarballs
+#
+if [[ $V_FLAG -ge 3 ]]; then
+    echo "$0: debug[3]: about to run txzchk tests: xz compressed tarballs" 1>&2
+fi
+while read -r file; do
+    run_txz_test pass "$file"
+done < <(find "$TXZCHK_GOOD_TREE" -type f -name 'submit.test-*.txz' -print)
+while read -r file; do
+    run_txz_test fail "$file"
+done < <(find "$TXZCHK_BAD_TREE" -type f -name 'submit.test-*.txz' -print)
+
+# run_batch_test - check a list of text files at once with txzchk -B
+#
+# usage:
+#	run_batch_test {pass|fail} list [-x]
+#
+#	pass		- every file of the list must pass
+#	fail		- every file of the list must fail
+#	list		- file listing the text files to check, one per line
+#	-x		- pass -x to txzchk (for submit IDs of "test")
+#
+run_batch_test()
+{
+    # parse args
+    #
+    if [[ $# -lt 2 || $# -gt 3 ]]; then
+	echo "$0: ERROR: expected 2 or 3 args to run_batch_test, found $#" 1>&2
+	exit 43
+    fi
+    declare pass_fail="$1"
+    declare batch_list="$2"
+    declare test_mode="$3"
+    declare count
+
+    count=$(wc -l < "$batch_list")
+    count="${count// /}"
+    if [[ $count -eq 0 ]]; then
+	return
+    fi
+    if [[ $V_FLAG -ge 5 ]]; then
+	echo "$0: debug[5]: in run_batch_test: about to run: $TXZCHK $test_mode -q -v 0 -F $FNAMCHK -T -E txt -j 4 -B $batch_list > $BATCH_JSON" 1>&2
+    fi
+    # shellcheck disable=SC2086
+    "$TXZCHK" $test_mode -q -v 0 -F "$FNAMCHK" -T -E txt -j 4 -B "$batch_list" > "$BATCH_JSON" 2>/dev/null
+    status="$?"
+
+    # the summary must list every file, and each must pass (or fail)
+    #
+    if ! grep -q "^    \"tarball_count\" : $count,\$" "$BATCH_JSON"; then
+	echo "$0: Warning: in run_batch_test: FAIL: $TXZCHK -B $batch_list did not report $count tarballs" | tee -a -- "$LOGFILE" 1>&2
+	EXIT_CODE=1
+    elif [[ $pass_fail = pass && $status -ne 0 ]]; then
+	echo "$0: Warning: in run_batch_test: FAIL: $TXZCHK -B $batch_list exit code: $status != 0" | tee -a -- "$LOGFILE" 1>&2
+	EXIT_CODE=1
+    elif [[ $pass_fail = fail ]] && { [[ $status -ne 1 ]] || grep -q '"feathers" : 0,' "$BATCH_JSON"; }; then
+	echo "$0: Warning: in run_batch_test: FAIL: $TXZCHK -B $batch_list did not find feathers in every tarball" | tee -a -- "$LOGFILE" 1>&2
+	EXIT_CODE=1
+    elif [[ $V_FLAG -ge 5 ]]; then
+	echo "$0: debug[5]: in run_batch_test: PASS: $TXZCHK -B $batch_list" 1>&2
+    fi
+    return
+}
+
+# run the same tests with txzchk -B, a list of text files at once
+#
+if [[ $V_FLAG -ge 3 ]]; then
+    echo "$0: debug[3]: about to run txzchk -B tests: text files" 1>&2
+fi
+BATCH_LIST=$(mktemp .txzchk_test.batch_list.XXXXXXXXXX)
+BATCH_JSON=$(mktemp .txzchk_test.batch_json.XXXXXXXXXX)
+find "$TXZCHK_GOOD_TREE" -type f -name '*.txt' -name '*test*' -print > "$BATCH_LIST"
+run_batch_test pass "$BATCH_LIST" -x
+find "$TXZCHK_GOOD_TREE" -type f -name '*.txt' ! -name '*test*' -print > "$BATCH_LIST"
+run_batch_test pass "$BATCH_LIST"
+find "$TXZCHK_BAD_TREE" -type f -name '*.txt' -print > "$BATCH_LIST"
+run_batch_test fail "$BATCH_LIST" -x
+
 # explicitly delete the temporary files
 
 if [[ -z $K_FLAG ]]; then
-    rm -f "$TARBALL" "$TEST_FILE" "$TAR_ERROR" "$TMP_STDERR_FILE"
+    rm -f "$TARBALL" "$TEST_FILE" "$TAR_ERROR" "$TMP_STDERR_FILE" "$BATCH_LIST" "$BATCH_JSON"
 else
     echo
     echo "$0: keeping temporary files due to use of -k"
@@ -678,6 +824,12 @@ else
     if [[ -e $TMP_STDERR_FILE ]]; then
 	echo -n " $TMP_STDERR_FILE"
     fi
+    if [[ -e $BATCH_LIST ]]; then
+	echo -n " $BATCH_LIST"
+    fi
+    if [[ -e $BATCH_JSON ]]; then
+	echo -n " $BATCH_JSON"
+    fi
     echo
 fi
 
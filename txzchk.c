@@ -4,8 +4,8 @@
  * txzchk verifies that IOCCC submission tarballs conform to the IOCCC rules (no
  * feathers stuck in the tarballs :-) ).
  *
- * txzchk is invoked by mkiocccentry; txzchk in turn uses fnamchk to make
- * sure that the tarball was correctly named and formed. In other words txzchk
+ * txzchk is invoked by mkiocccentry; txzchk in turn uses the fnamchk checks to
+ * make sure that the tarball was correctly named and formed. In other words txzchk
  * makes sure that the mkiocccentry tool was used and there was no screwing
  * around with the resultant tarball.
  *
@@ -75,6 +75,8 @@
 #include <stdint.h>
 #include <sys/wait.h>	/* for WEXITSTATUS() */
 #include <locale.h>
+#include <errno.h>
+#include <time.h>	/* for localtime_r() and strftime() */
 
 /*
  * txzchk - IOCCC tarball validation check tool
@@ -90,25 +92,23 @@
 /*
  * static globals
  */
-static intmax_t sum_check;			/* negative of previous sum */
-static intmax_t count_check;			/* negative of previous count */
-static char const *tarball_path = NULL;		/* the tarball (by path) being checked */
 static char const *program = NULL;		/* our name */
 static bool read_from_text_file = false;	/* true ==> assume tarball_path refers to a text file */
-static char const *ext = "txz";			/* force extension in fnamchk to be this value */
+static bool use_tar = false;			/* true ==> -t tar: read the tar -tJvf listing of the tarball */
+static char const *ext = "txz";			/* force tarball filename extension to be this value */
 static char const *tok_sep = " \t";		/* token separators for strtok_r */
 static bool show_warnings = false;	        /* true ==> show warnings even if -q */
 static bool entertain = false;			/* true ==> show entertaining messages */
 static uintmax_t feathery = 3;			/* for entertain option */
-static bool test_mode = false;                  /* true ==> use -t in fnamchk */
-
+static bool test_mode = false;                  /* true ==> tarball must have a test submit filename */
+static bool batch_mode = false;			/* true ==> -B: check many tarballs, JSON summary on stdout */
 
 /*
- * txzchk specific structs
+ * The walk code records match counts in the rules of the walk_set and
+ * init_walk_stat() recompiles them, so only one thread at a time may walk
+ * the walk_txzchk set.
  */
-static struct txz_line *txz_lines;		/* all of the read lines */
-static struct tarball tarball;			/* all the information collected from tarball */
-static struct txz_file *txz_files;		/* linked list of the files in the tarball */
+static pthread_mutex_t walk_lock = PTHREAD_MUTEX_INITIALIZER;	/* lock on walk_txzchk */
 
 /*
  * usage message
@@ -116,7 +116,8 @@ static struct txz_file *txz_files;		/* linked list of the files in the tarball *
  * Use the usage() function to print the usage_msg([0-9]?)+ strings.
  */
 static const char * const usage_msg =
-    "usage: %s [-h] [-v level] [-q] [-e] [-f feathers] [-w] [-V] [-t tar] [-F fnamchk] [-T] [-E ext] [-x] tarball_path\n"
+    "usage: %s [-h] [-v level] [-q] [-e] [-f feathers] [-w] [-V] [-t tar] [-F fnamchk] [-T] [-E ext] [-x]\n"
+    "\t\t[-j jobs] {tarball_path | -B dir_or_list}\n"
     "\n"
     "\t-h\t\tprint help message and exit\n"
     "\t-v level\tset verbosity level: (def level: %d)\n"
@@ -125,19 +126,24 @@ static const char * const usage_msg =
     "\t-f feathers\tdefine how many feathers is feathery (for -e)\n"
     "\t-w\t\talways show warning messages\n"
     "\t-V\t\tprint version string and exit\n"
-    "\t-t tar\t\tpath to tar executable that supports the -J (xz) option (def: %s)\n"
-    "\t-F fnamchk\tpath to tool that checks if tarball_path is a valid compressed tarball\n"
-    "\t\t\t    filename (def: %s)\n"
+    "\t-t tar\t\tread the tarball listing of this tar that supports the -J (xz) option\n"
+    "\t\t\t    (def: read the tarball without tar, e.g. -t %s)\n"
+    "\t-F fnamchk\tignored: the tarball filename is checked without running fnamchk\n"
     "\t-T\t\tassume tarball_path is a text file with tar listing (for testing\n"
     "\t\t\t    different formats)\n"
     "\t-E ext\t\tchange extension to test (def: txz)\n"
-    "\t-x\t\tforce fnamchk -t even if -T is not used\n"
+    "\t-x\t\ttarball must have a test submit filename (as with fnamchk -t) even if -T is not used\n"
+    "\t-B dir_or_list\tcheck each tarball with the extension (see -E) under the directory dir_or_list,\n"
+    "\t\t\t    or listed one per line in the file dir_or_list ('-' ==> read list from stdin),\n"
+    "\t\t\t    and print a JSON summary of the feathers found to stdout\n"
+    "\t-j jobs\t\twith -B, check up to jobs tarballs at the same time (def: number of CPUs, max: %d)\n"
     "\n"
     "\ttarball_path\tpath to an IOCCC compressed tarball\n"
     "\n"
     "Exit codes:\n"
-    "     0   no feathers stuck in tarball :-)\n"
+    "     0   no feathers stuck in tarball (with -B: in any tarball) :-)\n"
     "     1   tarball was successfully parsed :-) but there's at least one feather stuck in it :-(\n"
+    "         (with -B: at least one tarball has a feather stuck in it or could not be read)\n"
     "     2   -h and help string printed or -V and version string printed\n"
     "     3   invalid command line, invalid option or option missing an argument\n"
     " >= 10   internal error has occurred or unknown tar listing format has been encountered\n"
@@ -160,12 +166,15 @@ main(int argc, char **argv)
     extern char *optarg;		    /* option argument */
     extern int optind;			    /* argv index of the next arg */
     char *tar = TAR_PATH_0;		    /* path to tar executable that supports the -J (xz) option */
-    char *fnamchk = FNAMCHK_PATH_0;	    /* path to fnamchk tool */
     int i;
     bool found_tar = false;                     /* for find_utils */
-    bool found_fnamchk = false;                 /* for find_utils */
     bool opt_error = false;			/* fchk_inval_opt() return */
     enum path_sanity sanity = PATH_ERR_UNSET;	/* canon_path error or PATH_OK */
+    char const *batch = NULL;			/* -B dir_or_list of tarballs to check */
+    intmax_t jobs = 0;				/* -j jobs - number of worker threads, 0 ==> number of CPUs */
+    long cpus = 0;				/* number of online CPUs */
+    bool batch_ok = false;			/* true ==> no feathers in any -B tarball */
+    struct txz_ctx ctx;				/* the state of checking the tarball */
 
     /* IOCCC requires use of C locale */
     set_ioccc_locale();
@@ -174,7 +183,7 @@ main(int argc, char **argv)
      * parse args
      */
     program = argv[0];
-    while ((i = getopt(argc, argv, ":hv:qVF:t:TE:wef:x")) != -1) {
+    while ((i = getopt(argc, argv, ":hv:qVF:t:TE:wef:xB:j:")) != -1) {
 	switch (i) {
 	case 'h':		/* -h - print help to stderr and exit 2 */
 	    usage(2, program, ""); /*ooo*/
@@ -202,11 +211,12 @@ main(int argc, char **argv)
 	    exit(2); /*ooo*/
 	    not_reached();
 	    break;
-	case 'F': /* -F fnamchk - specify path to fnamchk tool */
-	    fnamchk = optarg;
+	case 'F': /* -F fnamchk - ignored: we check the tarball filename ourselves */
+	    dbg(DBG_LOW, "ignoring -F %s: the tarball filename is checked without running fnamchk", optarg);
 	    break;
 	case 't': /* -t tar - specify path to tar (perhaps to tar and feather :-) ) */
 	    tar = optarg;
+	    use_tar = true;
 	    break;
 	case 'T': /* -T - text (test) file mode - don't rely on tar: just read file as if it was a text file */
 	    read_from_text_file = true;
@@ -229,6 +239,16 @@ main(int argc, char **argv)
         case 'x':   /* when mkiocccentry UUID is "test" we need this */
             test_mode = true;
             break;
+	case 'B': /* -B dir_or_list - check many tarballs */
+	    batch = optarg;
+	    batch_mode = true;
+	    break;
+	case 'j': /* -j jobs - number of tarballs to check at the same time */
+	    if (!string_to_intmax(optarg, &jobs) || jobs <= 0 || jobs > TXZCHK_MAX_JOBS) {
+		usage(3, program, "invalid -j jobs"); /*ooo*/
+		not_reached();
+	    }
+	    break;
 	case ':': /* option requires an argument */
 	case '?': /* illegal option */
 	default:  /* anything else but should not actually happen */
@@ -243,18 +263,34 @@ main(int argc, char **argv)
 	}
     }
 
-    /* must have the exact required number of args */
-    if (argc - optind != REQUIRED_ARGS) {
-	usage(3, program, "wrong number of arguments"); /*ooo*/
-	not_reached();
-    }
-    /* IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function. */
-    tarball_path = canon_path(argv[optind], 0, 0, 0, &sanity, NULL, NULL, false, false, true, true, NULL);
-    if (tarball_path == NULL) {
-	err(3, program, "bogus tarball path: %s error: %s", argv[optind], path_sanity_error(sanity)); /*ooo*/
-	not_reached();
+    /* must have the exact required number of args, or none with -B */
+    memset(&ctx, 0, sizeof(ctx));
+    if (batch_mode) {
+	if (argc - optind != 0) {
+	    usage(3, program, "no tarball_path may be given with -B"); /*ooo*/
+	    not_reached();
+	}
+	if (jobs == 0) {
+	    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	    jobs = cpus < 1 ? 1 : (cpus > TXZCHK_MAX_JOBS ? TXZCHK_MAX_JOBS : cpus);
+	}
+	dbg(DBG_MED, "batch: %s jobs: %jd", batch, jobs);
+
+	/* the JSON summary is the only thing we write to stdout */
+	entertain = false;
+    } else {
+	if (argc - optind != REQUIRED_ARGS) {
+	    usage(3, program, "wrong number of arguments"); /*ooo*/
+	    not_reached();
+	}
+	/* IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function. */
+	ctx.tarball_path = canon_path(argv[optind], 0, 0, 0, &sanity, NULL, NULL, false, false, true, true, NULL);
+	if (ctx.tarball_path == NULL) {
+	    err(3, program, "bogus tarball path: %s error: %s", argv[optind], path_sanity_error(sanity)); /*ooo*/
+	    not_reached();
+	}
+	dbg(DBG_MED, "tarball path: %s", ctx.tarball_path);
     }
-    dbg(DBG_MED, "tarball path: %s", tarball_path);
     dbg(DBG_MED, "fnamchk test mode: %s", booltostr(test_mode));
     dbg(DBG_MED, "entertainment mode: %s", booltostr(entertain));
 
@@ -289,62 +325,66 @@ main(int argc, char **argv)
      * moving historic critical applications, look to see if the alternate path works instead.
      */
 
-    if (!read_from_text_file) {
-        /*
-         * we need tar
-         */
-        find_utils(&found_tar, &tar, NULL, NULL, NULL, NULL, &found_fnamchk, &fnamchk,
-            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
-    } else {
+    if (!read_from_text_file && use_tar) {
         /*
-         * we do not need tar
+         * we need tar: otherwise we read the tarball ourselves (or -T a text file)
          */
-        find_utils(NULL, NULL, NULL, NULL, NULL, NULL, &found_fnamchk, &fnamchk,
+        find_utils(&found_tar, &tar, NULL, NULL, NULL, NULL, NULL, NULL,
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
     }
 
     /* additional sanity checks */
-    txzchk_sanity_chks(tar, fnamchk);
+    txzchk_sanity_chks(tar, ctx.tarball_path);
     if (entertain) {
 	para("... environment looks tarry.", NULL);
     }
 
     /*
-     * check the tarball
+     * case: -B - check each tarball of the directory or list
      */
-    if (entertain) {
-	para("", "Looking for feathers in tarball ...", NULL);
-    }
+    if (batch_mode) {
+	batch_ok = check_batch(batch, jobs, tar);
 
-    tarball.total_feathers = check_tarball(tar, fnamchk);
-    if (entertain) {
-	if (!tarball.total_feathers) {
-	    para("No feathers stuck in tarball.", NULL);
-	} else {
-	    if (tarball.total_feathers >= feathery) {
-		para("\n... looks like someone has been throwing feathers",
-		     "about, because that is quite a feathery ball of tar!", NULL);
+    /*
+     * case: check the tarball
+     */
+    } else {
+	if (entertain) {
+	    para("", "Looking for feathers in tarball ...", NULL);
+	}
+
+	ctx.tarball.total_feathers = check_tarball(&ctx, tar);
+	if (entertain) {
+	    if (!ctx.tarball.total_feathers) {
+		para("No feathers stuck in tarball.", NULL);
+	    } else {
+		if (ctx.tarball.total_feathers >= feathery) {
+		    para("\n... looks like someone has been throwing feathers",
+			 "about, because that is quite a feathery ball of tar!", NULL);
+		}
 	    }
 	}
+	show_tarball_info(&ctx, ctx.tarball_path);
     }
-    show_tarball_info(tarball_path);
 
     /*
-     * we need to free the paths to the tools
+     * we need to free the path to tar
      */
-    if (tar != NULL && !read_from_text_file && found_tar) {
+    if (tar != NULL && !read_from_text_file && use_tar && found_tar) {
         free(tar);
         tar = NULL;
     }
-    if (fnamchk != NULL && found_fnamchk) {
-        free(fnamchk);
-        fnamchk = NULL;
-    }
 
     /*
      * All Done!!! All Done!!! -- Jessica Noll, Age 2
      */
-    if (tarball.total_feathers > 0) {
+    if (batch_mode) {
+	if (!batch_ok) {
+	    exit(1); /*ooo*/
+	}
+	exit(0); /*ooo*/
+    }
+    if (ctx.tarball.total_feathers > 0) {
 	exit(1); /*ooo*/
     }
     exit(0); /*ooo*/
@@ -356,12 +396,13 @@ main(int argc, char **argv)
  *
  * given:
  *
+ *	ctx		    - the state of checking the tarball
  *	tarball_path	    - path to tarball we checked
  *
  * Returns void. Does not return on error.
  */
 static void
-show_tarball_info(char const *tarball_path)
+show_tarball_info(struct txz_ctx *ctx, char const *tarball_path)
 {
     /*
      * firewall
@@ -377,15 +418,15 @@ show_tarball_info(char const *tarball_path)
     if (verbosity_level >= DBG_MED) {
 	/* show information about tarball */
 	para("", "The following information about the tarball was collected:", NULL);
-        dbg(DBG_MED, "tarball size: %lld", (long long)tarball.size);
-        dbg(DBG_MED, "total file size: %lld", (long long)tarball.total_size);
-        dbg(DBG_MED, "total file size shrunk %lld time%s", (long long)tarball.files_size_shrunk,
-                SINGULAR_OR_PLURAL(tarball.files_size_shrunk));
-        dbg(DBG_MED, "total number of files with invalid permissions: %lld", (long long)tarball.invalid_perms);
-        dbg(DBG_MED, "total number of executable files: %lld\n", (long long)tarball.total_exec_files);
-	if (tarball.total_feathers > 0) {
-	    dbg(DBG_VHIGH, "%s has %ju feather%s stuck in tarball :-(", tarball_path, tarball.total_feathers,
-		    SINGULAR_OR_PLURAL(tarball.total_feathers));
+        dbg(DBG_MED, "tarball size: %lld", (long long)ctx->tarball.size);
+        dbg(DBG_MED, "total file size: %lld", (long long)ctx->tarball.total_size);
+        dbg(DBG_MED, "total file size shrunk %lld time%s", (long long)ctx->tarball.files_size_shrunk,
+                SINGULAR_OR_PLURAL(ctx->tarball.files_size_shrunk));
+        dbg(DBG_MED, "total number of files with invalid permissions: %lld", (long long)ctx->tarball.invalid_perms);
+        dbg(DBG_MED, "total number of executable files: %lld\n", (long long)ctx->tarball.total_exec_files);
+	if (ctx->tarball.total_feathers > 0) {
+	    dbg(DBG_VHIGH, "%s has %ju feather%s stuck in tarball :-(", tarball_path, ctx->tarball.total_feathers,
+		    SINGULAR_OR_PLURAL(ctx->tarball.total_feathers));
 	} else {
 	    dbg(DBG_VHIGH, "%s has 0 feathers stuck in tarball :-)", tarball_path);
 	}
@@ -432,8 +473,8 @@ usage(int exitcode, char const *prog, char const *str)
 	fprintf_usage(DO_NOT_EXIT, stderr, "%s\n", str);
     }
 
-    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, TAR_PATH_0, FNAMCHK_PATH_0,
-	    TXZCHK_BASENAME, MKIOCCCENTRY_REPO_VERSION, TXZCHK_VERSION, JPARSE_UTILS_VERSION,
+    fprintf_usage(exitcode, stderr, usage_msg, prog, DBG_DEFAULT, TAR_PATH_0, TXZCHK_MAX_JOBS,
+	    TXZCHK_BASENAME, TXZCHK_VERSION, MKIOCCCENTRY_REPO_VERSION, JPARSE_UTILS_VERSION,
             JPARSE_UTF8_VERSION, JPARSE_LIBRARY_VERSION);
     exit(exitcode); /*ooo*/
     not_reached();
@@ -447,25 +488,28 @@ usage(int exitcode, char const *prog, char const *str)
  * given:
  *
  *      tar             - path to tar that supports the -J (xz) option
- *	fnamchk		- path to the fnamchk utility
+ *	tarball_path	- path to the tarball, or NULL with -B
+ *
+ * NOTE: with -B the tarballs are checked by check_job(), as they are found,
+ *	 so that one bad tarball does not stop the checking of the others.
  *
  * NOTE: this function does not return on error or if things are not sane.
  */
 static void
-txzchk_sanity_chks(char const *tar, char const *fnamchk)
+txzchk_sanity_chks(char const *tar, char const *tarball_path)
 {
     /*
      * firewall
      */
-    if ((tar == NULL && !read_from_text_file) || fnamchk == NULL || tarball_path == NULL) {
+    if ((tar == NULL && !read_from_text_file && use_tar) || (tarball_path == NULL && !batch_mode)) {
 	err(12, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
     /*
-     * if text file flag not used tar must be executable
+     * if text file flag not used and -t tar was given tar must be executable
      */
-    if (!read_from_text_file)
+    if (!read_from_text_file && use_tar)
     {
 	if (!exists(tar)) {
 	    fpara(stderr,
@@ -523,65 +567,10 @@ txzchk_sanity_chks(char const *tar, char const *fnamchk)
 	}
     }
 
-    /*
-     * fnamchk must be executable
-     */
-    if (!exists(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "We cannot find fnamchk.",
-	      "",
-	      "This tool is required to test the tarball.",
-	      "Perhaps you need to use another path:",
-	      "",
-	      "    txzchk -F /path/to/fnamchk [...]",
-              "",
-              "or install the mkiocccentry toolkit? You can find the mkiocccentry toolkit at:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-              "",
-	      NULL);
-	err(16, __func__, "fnamchk does not exist: %s", fnamchk);
-	not_reached();
-    }
-
-    if (!is_file(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "The fnamchk path, while it exists, is not a regular file.",
-	      "",
-	      "Perhaps you need to use another path:",
-	      "",
-	      "    txzchk -F /path/to/fnamchk [...]",
-              "",
-              "or install the mkiocccentry toolkit? You can find the mkiocccentry toolkit at:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-              "",
-	      NULL);
-	err(17, __func__, "fnamchk is not a regular file: %s", fnamchk);
-	not_reached();
-    }
-
-    if (!is_exec(fnamchk)) {
-	fpara(stderr,
-	      "",
-	      "The fnamchk path, while it is a file, is not executable.",
-	      "",
-	      "We suggest you check the permissions on the fnamchk program, or use another path:",
-	      "",
-	      "    txzchk -F /path/to/fnamchk [...]",
-              "",
-              "or install the mkiocccentry toolkit? You can find the mkiocccentry toolkit at:",
-	      "",
-	      "    https://github.com/ioccc-src/mkiocccentry",
-              "",
-	      NULL);
-	err(18, __func__, "fnamchk is not an executable program: %s", fnamchk);
-	not_reached();
+    if (tarball_path == NULL) {
+	return;
     }
 
-
     /*
      * tarball_path must be readable
      */
@@ -642,9 +631,11 @@ txzchk_sanity_chks(char const *tar, char const *fnamchk)
  * which should ever happen).
  */
 static void
-check_all_txz_files(void)
+check_all_txz_files(struct txz_ctx *ctx)
 {
-    struct txz_file *file;  /* to iterate through files list */
+    struct txz_file *file;  /* to iterate through files array */
+    intmax_t len;	    /* number of files in the files array */
+    intmax_t i;
     struct walk_stat wstat; /* record information and stats about a complete walk */
     bool process = false;   /* true ==> process item, false ==> ignore item */
     bool dup = false;       /* true ==> attempt to record a duplicate canonical path */
@@ -655,18 +646,36 @@ check_all_txz_files(void)
     size_t path_len = 0;            /* canonicalised path length */
     int_least32_t deep = -1;        /* canonicalised stack depth */
 
+    /*
+     * firewall
+     */
+    if (ctx == NULL || ctx->tarball_path == NULL) {
+	err(78, __func__, "called with NULL ctx or tarball path");
+	not_reached();
+    }
+
     /*
      * init walk code
+     *
+     * NOTE: with -B other threads may be checking other tarballs: we hold the
+     *	     walk_lock until we are done with walk_txzchk.
      */
+    (void) pthread_mutex_lock(&walk_lock);
     memset(&wstat, 0, sizeof(wstat));
     init_walk_stat(&wstat, ".", &walk_txzchk, TXZCHK_BASENAME, MAX_PATH_LEN, MAX_FILENAME_LEN, MAX_PATH_DEPTH, true);
 
     /*
-     * Now go through the files list to verify the required files are there and
+     * Now go through the files array to verify the required files are there and
      * also to detect any additional feathers stuck in the tarball (or issues in
      * the text file).
+     *
+     * NOTE: we go from the last file added to the first, the order of the list
+     *	     these files were once kept in, so that the order of the warnings
+     *	     (as recorded in the test_ioccc/test_txzchk .err files) is unchanged.
      */
-    for (file = txz_files; file != NULL; file = file->next) {
+    len = (ctx->txz_files == NULL) ? 0 : dyn_array_tell(ctx->txz_files);
+    for (i = len - 1; i >= 0; --i) {
+	file = dyn_array_value(ctx->txz_files, struct txz_file *, i);
 	if (file->basename == NULL) {
 	    err(22, __func__, "found NULL file->basename in txz_files list");
 	    not_reached();
@@ -680,15 +689,15 @@ check_all_txz_files(void)
          */
         if (*(file->basename) == '\0') {
             warn(TXZCHK_BASENAME, "found empty basename in txz_files list");
-            ++tarball.total_feathers;
+            ++ctx->tarball.total_feathers;
             continue;
         }
         if (*(file->filename) == '\0') {
             warn(TXZCHK_BASENAME, "found empty filename in txz_files list");
-            ++tarball.total_feathers;
+            ++ctx->tarball.total_feathers;
             continue;
         }
-        check_directory(file, file->dirname, tarball_path);
+        check_directory(ctx, file, file->dirname, ctx->tarball_path);
 
         /*
          * first find the first '/'. If NULL warn about it and skip file
@@ -696,7 +705,7 @@ check_all_txz_files(void)
         path = strchr(file->filename, '/');
         if (path == NULL) {
             warn(TXZCHK_BASENAME, "no directory found in filename: %s", file->filename);
-            ++tarball.total_feathers;
+            ++ctx->tarball.total_feathers;
             continue;
         } else {
             /*
@@ -705,7 +714,7 @@ check_all_txz_files(void)
             cpath = canonicalize_path(&wstat, path + 1, &sanity, &path_len, &deep);
             if (cpath == NULL) {
                 warn(TXZCHK_BASENAME, "canonicalize_path had an internal failure and returned NULL");
-                ++tarball.total_feathers;
+                ++ctx->tarball.total_feathers;
                 continue;
             }
         }
@@ -713,7 +722,7 @@ check_all_txz_files(void)
         process = record_step(&wstat, cpath, file->length, file->mode, &dup, NULL);
         if (dup) {
             warn(TXZCHK_BASENAME, "file %s is a duplicate file", cpath != NULL?cpath:file->filename);
-            ++tarball.total_feathers;
+            ++ctx->tarball.total_feathers;
         } else if (process) {
             dbg(DBG_MED, "txzchk: file %s has been successfully processed", cpath!=NULL?cpath:file->filename);
         }
@@ -726,36 +735,37 @@ check_all_txz_files(void)
     walk_ok = chk_walk(&wstat, stderr, MAX_EXTRA_FILE_COUNT, MAX_EXTRA_DIR_COUNT,
                        NO_COUNT, NO_COUNT, true);
     if (walk_ok) {
-        dbg(DBG_MED, "all okay walking tarball: %s", tarball_path);
+        dbg(DBG_MED, "all okay walking tarball: %s", ctx->tarball_path);
     } else {
         if (entertain) {
-            warn(TXZCHK_BASENAME, "encountered one or more feathers in tar pit: %s", tarball_path);
+            warn(TXZCHK_BASENAME, "encountered one or more feathers in tar pit: %s", ctx->tarball_path);
         } else {
-            warn(TXZCHK_BASENAME, "encountered an error walking directory in tarball: %s", tarball_path);
+            warn(TXZCHK_BASENAME, "encountered an error walking directory in tarball: %s", ctx->tarball_path);
         }
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
 
     /*
      * free the walk_stat
      */
     free_walk_stat(&wstat);
+    (void) pthread_mutex_unlock(&walk_lock);
 
-    if (tarball.total_size > MAX_SUM_FILELEN) {
-        warn(TXZCHK_BASENAME, "total length of tarball contents is too long: %lld > limit: %lld", (long long)tarball.total_size,
+    if (ctx->tarball.total_size > MAX_SUM_FILELEN) {
+        warn(TXZCHK_BASENAME, "total length of tarball contents is too long: %lld > limit: %lld", (long long)ctx->tarball.total_size,
             (long long) MAX_SUM_FILELEN);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     } else {
-        dbg(DBG_LOW, "total length of tarball size: %lld <= limit: %lld", (long long)tarball.total_size,
+        dbg(DBG_LOW, "total length of tarball size: %lld <= limit: %lld", (long long)ctx->tarball.total_size,
             (long long) MAX_SUM_FILELEN);
     }
 
     /*
      * report total feathers found
      */
-    if (tarball.total_feathers > 0) {
+    if (ctx->tarball.total_feathers > 0) {
 	warn(TXZCHK_BASENAME, "%s: found %ju feather%s stuck in the tarball",
-	    tarball_path, tarball.total_feathers, tarball.total_feathers==1?"":"s");
+	    ctx->tarball_path, ctx->tarball.total_feathers, ctx->tarball.total_feathers==1?"":"s");
     }
     return;
 }
@@ -765,6 +775,7 @@ check_all_txz_files(void)
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	file		- file structure
  *	dirname	        - the directory expected (or NULL if fnamchk fails)
  *	tarball_path	- the tarball path
@@ -776,7 +787,7 @@ check_all_txz_files(void)
  * Does not return on error.
  */
 static void
-check_directory(struct txz_file *file, char const *dirname, char const *tarball_path)
+check_directory(struct txz_ctx *ctx, struct txz_file *file, char const *dirname, char const *tarball_path)
 {
     /*
      * firewall
@@ -790,14 +801,14 @@ check_directory(struct txz_file *file, char const *dirname, char const *tarball_
     {
 	if (strncmp(file->filename, dirname, strlen(dirname))) {
 	    warn(TXZCHK_BASENAME, "%s: found incorrect top level directory in filename %s", tarball_path, file->filename);
-	    ++tarball.total_feathers;
+	    ++ctx->tarball.total_feathers;
 	} else {
 	    /* This file has the right top level directory */
             dbg(DBG_HIGH, "%s: correct directory %s for file %s", tarball_path, dirname, file->filename);
 	}
     } else if (!test_mode) {
         warn(TXZCHK_BASENAME, "%s: found incorrect top level directory in filename %s", tarball_path, file->filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     return;
 }
@@ -808,13 +819,14 @@ check_directory(struct txz_file *file, char const *dirname, char const *tarball_
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	tarball_path	- path to the tarball being checked for feathers
  *	sum		- corresponds to the sum pointer in sum_and_count()
  *	count		- corresponds to the count pointer in sum_and_count()
  *	length		- corresponds to the length in sum_and_count()
  */
 static void
-count_and_sum(char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t length)
+count_and_sum(struct txz_ctx *ctx, char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t length)
 {
     bool test = false;	    /* status of various tests */
 
@@ -831,45 +843,46 @@ count_and_sum(char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t
 	err(27, __func__, "count is NULL");
 	not_reached();
     }
-    test = sum_and_count(length, sum, count, &sum_check, &count_check);
+    test = sum_and_count(length, sum, count, &ctx->sum_check, &ctx->count_check);
     if (!test) {
 	/*
 	 * sum_and_count() will have reported the issue so we don't report anything
 	 * specially. We do however increase the number of feathers.
 	 */
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
     }
 
-    /* update the tarball files size total */
-    tarball.total_size = *sum;
+    /* update the tarball files size total and files count */
+    ctx->tarball.total_size = *sum;
+    ctx->tarball.file_count = *count;
 
     /* check for negative total file length */
     if (*sum < 0) {
-	++tarball.total_feathers;
-	++tarball.negative_files_size;
+	++ctx->tarball.total_feathers;
+	++ctx->tarball.negative_files_size;
 	warn(TXZCHK_BASENAME, "%s: total file size went below 0: %jd", tarball_path, *sum);
-	if (*sum < tarball.previous_files_size) {
-	    ++tarball.files_size_shrunk;
+	if (*sum < ctx->tarball.previous_files_size) {
+	    ++ctx->tarball.files_size_shrunk;
 	    warn(TXZCHK_BASENAME, "%s: total files size %jd < previous file size %lld", tarball_path, *sum,
-		(long long)tarball.previous_files_size);
+		(long long)ctx->tarball.previous_files_size);
 	}
     }
     /* check for sum of total file lengths being too big */
     if (*sum > MAX_SUM_FILELEN) {
-        if (tarball.previous_files_size <= MAX_SUM_FILELEN) {
-            ++tarball.total_feathers;
-            ++tarball.files_size_too_big;
+        if (ctx->tarball.previous_files_size <= MAX_SUM_FILELEN) {
+            ++ctx->tarball.total_feathers;
+            ++ctx->tarball.files_size_too_big;
         }
 	warn(TXZCHK_BASENAME, "%s: total file size too big: %jd > %jd", tarball_path,
 	    *sum, (intmax_t)MAX_SUM_FILELEN);
     }
     /* update the previous files size */
-    tarball.previous_files_size = *sum;
+    ctx->tarball.previous_files_size = *sum;
 
     /* check for no or negative file count */
     if (*count <= 0) {
-	++tarball.total_feathers;
-	++tarball.invalid_files_count;
+	++ctx->tarball.total_feathers;
+	++ctx->tarball.invalid_files_count;
 	warn(TXZCHK_BASENAME, "%s: files count <= 0: %jd", tarball_path, *count);
     }
     return;
@@ -881,6 +894,7 @@ count_and_sum(char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	p		- pointer to current field in line
  *	linep		- the line we're parsing
  *	line_dup	- duplicated line
@@ -902,7 +916,7 @@ count_and_sum(char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t
  * loosely here.
  */
 static void
-parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname, char const *tarball_path,
+parse_linux_txz_line(struct txz_ctx *ctx, char *p, char *linep, char *line_dup, char const *dirname, char const *tarball_path,
         char **saveptr, bool isfile, intmax_t *sum, intmax_t *count, bool isdir, char *perms, bool isexec)
 {
     intmax_t length = 0; /* file size */
@@ -926,7 +940,7 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
 
     if (*p != '/') {
 	warn(TXZCHK_BASENAME, "found non-numerical UID in line %s", line_dup);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
 	p = strchr(p, '/');
     }
     if (p == NULL) {
@@ -944,7 +958,7 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
 
     if (*p) {
 	warn(TXZCHK_BASENAME, "found non-numerical GID in file in line %s", line_dup);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
     }
     p = strtok_r(NULL, tok_sep, saveptr);
     if (p == NULL) {
@@ -955,25 +969,25 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
     test = string_to_intmax(p, &length);
     if (!test) {
 	warn(TXZCHK_BASENAME, "%s: trying to parse file size in on line: <%s>: token: <%s>", tarball_path, line_dup, p);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
 
 	/*
 	 * we still have to add to the total number of files before we return to
 	 * next line but only if it's a normal file
 	 */
 	if (isfile) {
-	    count_and_sum(tarball_path, sum, count, length);
+	    count_and_sum(ctx, tarball_path, sum, count, length);
 	}
 	if (verbosity_level) {
 	    msg("skipping to next line due to inability to parse file size");
 	}
 	return;
     } else if (length < 0) {
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         warn(TXZCHK_BASENAME, "in tarball: %s: length %lld < 0", tarball_path, (long long)length);
     } else if (isfile) {
         /* add to total number of files and total size if it's a normal file */
-	count_and_sum(tarball_path, sum, count, length);
+	count_and_sum(ctx, tarball_path, sum, count, length);
     }
 
     /*
@@ -989,7 +1003,7 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
     }
 
     /* p should now contain the filename. */
-    file = alloc_txz_file(p, dirname, perms, isdir, isfile, isexec, length);
+    file = alloc_txz_file(ctx, p, dirname, perms, isdir, isfile, isexec, length);
     if (file == NULL) {
 	err(32, __func__, "alloc_txz_file() returned NULL");
 	not_reached();
@@ -999,14 +1013,14 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
 	p = strtok_r(NULL, tok_sep, saveptr);
 	if (p != NULL) {
 	    warn(TXZCHK_BASENAME, "%s: bogus field found after filename: %s", tarball_path, p);
-	    ++tarball.total_feathers;
+	    ++ctx->tarball.total_feathers;
 	}
     } while (p != NULL);
 
     /* checks on this specific file */
-    check_txz_file(tarball_path, dirname, file);
+    check_txz_file(ctx, tarball_path, dirname, file);
 
-    add_txz_file_to_list(file);
+    add_txz_file_to_list(ctx, file);
     return;
 }
 
@@ -1016,6 +1030,7 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	p		- pointer to current field in line
  *	linep		- the line we're parsing
  *	line_dup	- duplicated line
@@ -1037,7 +1052,7 @@ parse_linux_txz_line(char *p, char *linep, char *line_dup, char const *dirname,
  * loosely here.
  */
 static void
-parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, char const *tarball_path,
+parse_bsd_txz_line(struct txz_ctx *ctx, char *p, char *linep, char *line_dup, char const *dirname, char const *tarball_path,
         char **saveptr, bool isfile, intmax_t *sum, intmax_t *count, bool isdir, char *perms, bool isexec)
 {
     intmax_t length = 0; /* file size */
@@ -1070,7 +1085,7 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
 
     if (*p) {
 	warn(TXZCHK_BASENAME, "%s: found non-numerical UID in file in line %s", tarball_path, line_dup);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
     }
 
     /*
@@ -1092,7 +1107,7 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
 
     if (*p) {
 	warn(TXZCHK_BASENAME, "%s: found non-numerical GID in file in line: %s", tarball_path, line_dup);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
     }
 
     p = strtok_r(NULL, tok_sep, saveptr);
@@ -1104,25 +1119,25 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
     test = string_to_intmax(p, &length);
     if (!test) {
 	warn(TXZCHK_BASENAME, "%s: trying to parse file size in on line: <%s>: token: <%s>", tarball_path, line_dup, p);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
 
 	/*
 	 * we still have to add to the total number of files before we return to
 	 * next line but only if it's a normal file
 	 */
 	if (isfile) {
-	    count_and_sum(tarball_path, sum, count, length);
+	    count_and_sum(ctx, tarball_path, sum, count, length);
 	}
 	if (verbosity_level) {
 	    msg("skipping to next line due to inability to parse file size");
 	}
 	return;
     } else if (length < 0) {
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         warn(TXZCHK_BASENAME, "in tarball: %s: length %lld < 0", tarball_path, (long long)length);
     } else if (isfile) {
         /* add to total number of files and total size if it's a normal file */
-	count_and_sum(tarball_path, sum, count, length);
+	count_and_sum(ctx, tarball_path, sum, count, length);
     }
 
     /*
@@ -1137,7 +1152,7 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
 	}
     }
     /* p should now contain the filename. */
-    file = alloc_txz_file(p, dirname, perms, isdir, isfile, isexec, length);
+    file = alloc_txz_file(ctx, p, dirname, perms, isdir, isfile, isexec, length);
     if (file == NULL) {
 	err(38, __func__, "txzchk: alloc_txz_file() returned NULL");
 	not_reached();
@@ -1147,14 +1162,14 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
 	p = strtok_r(NULL, tok_sep, saveptr);
 	if (p != NULL) {
 	    warn(TXZCHK_BASENAME, "%s: bogus field found after filename: %s", tarball_path, p);
-	    ++tarball.total_feathers;
+	    ++ctx->tarball.total_feathers;
 	}
     } while (p != NULL);
 
     /* checks on this specific file */
-    check_txz_file(tarball_path, dirname, file);
+    check_txz_file(ctx, tarball_path, dirname, file);
 
-    add_txz_file_to_list(file);
+    add_txz_file_to_list(ctx, file);
     return;
 }
 
@@ -1164,6 +1179,7 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	tarball_path	- the tarball (or text file) we're processing
  *	dirname	- the directory name (if fnamchk passed - else NULL)
  *	file		- txz_file structure
@@ -1174,7 +1190,7 @@ parse_bsd_txz_line(char *p, char *linep, char *line_dup, char const *dirname, ch
  *
  */
 static void
-check_txz_file(char const *tarball_path, char const *dirname, struct txz_file *file)
+check_txz_file(struct txz_ctx *ctx, char const *tarball_path, char const *dirname, struct txz_file *file)
 {
     /*
      * firewall
@@ -1184,13 +1200,13 @@ check_txz_file(char const *tarball_path, char const *dirname, struct txz_file *f
 	not_reached();
     }
 
-    if (has_special_bits(file) || file->mode == 0) {
+    if (has_special_bits(ctx, file) || file->mode == 0) {
         dbg(DBG_MED, "file %s: has invalid perms: %s", file->filename, file->perms);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
 
     /* check the dirs in the path */
-    check_directory(file, dirname, tarball_path);
+    check_directory(ctx, file, dirname, tarball_path);
     return;
 }
 
@@ -1200,13 +1216,14 @@ check_txz_file(char const *tarball_path, char const *dirname, struct txz_file *f
  *
  * given:
  *
+ *	ctx	    - the state of checking the tarball
  *	file	    - the file (as a struct txz_file) to test
  *
  * This function does not return on NULL pointers (file itself or required
  * pointers in the struct).
  */
 static bool
-has_special_bits(struct txz_file *file)
+has_special_bits(struct txz_ctx *ctx, struct txz_file *file)
 {
     /*
      * firewall
@@ -1227,15 +1244,15 @@ has_special_bits(struct txz_file *file)
     if (file->isdir) {
         if (strcmp(file->perms, "drwxr-xr-x") != 0) {
 	    warn(TXZCHK_BASENAME, "directory with incorrect permissions found: %s: %s != drwxr-xr-x", file->filename, file->perms);
-            ++tarball.invalid_perms;
+            ++ctx->tarball.invalid_perms;
             return true;
         }
     } else if (is_executable_filename(file->basename)) {
-        ++tarball.total_exec_files;
+        ++ctx->tarball.total_exec_files;
         if (strcmp(file->perms, "-r-xr-xr-x") != 0) {
             warn(TXZCHK_BASENAME, "found executable filename %s that does not match mode 0555: %s != -r-xr-xr-x",
                     file->filename, file->perms);
-            /* NOTE: the caller will increment the tarball.total_feathers so do NOT do it here  */
+            /* NOTE: the caller will increment the ctx->tarball.total_feathers so do NOT do it here  */
             return true;
         }
 
@@ -1246,9 +1263,9 @@ has_special_bits(struct txz_file *file)
     } else if (strcmp(file->perms, "-r--r--r--") != 0) {
         warn(TXZCHK_BASENAME, "found non-executable non-directory file %s with wrong permissions: %s != -r--r--r-- (0444)",
                 file->filename, file->perms);
-        ++tarball.invalid_perms;
+        ++ctx->tarball.invalid_perms;
         /*
-         * NOTE: the caller will increment the tarball.total_feathers so do
+         * NOTE: the caller will increment the ctx->tarball.total_feathers so do
          * NOT do it here.
          */
         return true;
@@ -1266,6 +1283,7 @@ has_special_bits(struct txz_file *file)
  *
  * given:
  *
+ *	ctx		- the state of checking the tarball
  *	linep		-   line to parse
  *	line_dup	-   pointer to the duplicated line
  *	dirname	-   the directory name reported by fnamchk or NULL if it failed
@@ -1273,12 +1291,12 @@ has_special_bits(struct txz_file *file)
  *	sum		-   corresponds to sum pointer in sum_and_count()
  *	count		-   corresponds to count pointer in sum_and_count()
  *
- *  Function updates tarball.total_feathers, tarball.files_size and dir_count. Returns void.
+ *  Function updates ctx->tarball.total_feathers, ctx->tarball.files_size and dir_count. Returns void.
  *
  *  This function does not return on error.
  */
 static void
-parse_txz_line(char *linep, char *line_dup, char const *dirname, char const *tarball_path, intmax_t *sum, intmax_t *count)
+parse_txz_line(struct txz_ctx *ctx, char *linep, char *line_dup, char const *dirname, char const *tarball_path, intmax_t *sum, intmax_t *count)
 {
     char *p = NULL; /* each field in the line extracted from strtok_r() */
     char *saveptr = NULL; /* for strtok_r() context */
@@ -1302,7 +1320,7 @@ parse_txz_line(char *linep, char *line_dup, char const *dirname, char const *tar
     if (*linep != '-' && *linep != 'd') {
 	warn(TXZCHK_BASENAME, "%s: found a non-directory non-regular non-hard-linked item: %s",
 	    tarball_path, linep);
-	++tarball.total_feathers;
+	++ctx->tarball.total_feathers;
     } else {
         /*
          * record if it's a directory or not
@@ -1357,10 +1375,10 @@ parse_txz_line(char *linep, char *line_dup, char const *dirname, char const *tar
     }
     if (strchr(p, '/') != NULL) {
 	/* found linux output */
-	parse_linux_txz_line(p, linep, line_dup, dirname, tarball_path, &saveptr, isfile, sum, count, isdir, perms, isexec);
+	parse_linux_txz_line(ctx, p, linep, line_dup, dirname, tarball_path, &saveptr, isfile, sum, count, isdir, perms, isexec);
     } else {
 	/* assume macOS/BSD output */
-	parse_bsd_txz_line(p, linep, line_dup, dirname, tarball_path, &saveptr, isfile, sum, count, isdir, perms, isexec);
+	parse_bsd_txz_line(ctx, p, linep, line_dup, dirname, tarball_path, &saveptr, isfile, sum, count, isdir, perms, isexec);
     }
     return;
 }
@@ -1371,224 +1389,169 @@ parse_txz_line(char *linep, char *line_dup, char const *dirname, char const *tar
  *
  * given:
  *
- *	tar		- path to executable tar program (if -T was not
- *			  specified)
- *	fnamchk		- path to fnamchk tool
+ *	ctx		- the state of checking the tarball
+ *	tar		- path to executable tar program (if -t tar was
+ *			  specified and -T was not)
  *
  *
  * returns:
  *
- *	total number of feathers/issues found (tarball.total_feathers).
+ *	total number of feathers/issues found (ctx->tarball.total_feathers).
  *
  * This function does not return on error.
  */
 static uintmax_t
-check_tarball(char const *tar, char const *fnamchk)
+check_tarball(struct txz_ctx *ctx, char const *tar)
 {
-    uintmax_t line_num = 0; /* line number of tar output */
-    FILE *input_stream = NULL; /* pipe for tar output (or if -T specified read as a text file) */
-    FILE *fnamchk_stream = NULL; /* pipe for fnamchk output */
-    char *linep = NULL;		/* allocated line read from tar (or text file) */
-    char *dirname = NULL;	/* line read from fnamchk (directory name) */
-    ssize_t readline_len;	/* readline return length */
+    struct submit_filename sub;	/* what the fnamchk checks found in the tarball filename */
+    char *dirname = NULL;	/* submit directory name (NULL if the fnamchk checks fail) */
     int ret;			/* libc function return */
-    int exit_code;		/* shell command exit code */
-    bool fnamchk_okay = false;    /* true ==> fnamchk passed */
+    char const *tarball_path = NULL;	/* the tarball (by path) being checked */
 
     /*
      * firewall
      */
-    if ((!read_from_text_file && tar == NULL) || fnamchk == NULL || tarball_path == NULL)
+    if ((!read_from_text_file && use_tar && tar == NULL) || ctx == NULL || ctx->tarball_path == NULL)
     {
 	err(47, __func__, "called with NULL arg(s)");
 	not_reached();
     }
+    tarball_path = ctx->tarball_path;
 
     /*
-     * First of all we have to run fnamchk on the tarball: this is important
-     * because we have to know the actual directory name the files should be in
-     * within the tarball which we use in checks on the directory (and any
-     * additional directories in the tarball).
-     */
-
-    /*
-     * execute the fnamchk command.
-     *
-     * We redirect stdout to /dev/null so that the user doesn't have to see the
-     * output of the command. We require reading it but the user doesn't need to
-     * see it. We could enable it with certain verbosity_level values but this
-     * seems like additional code that's only unnecessary. This especially is so
-     * because if someone wants the directory name required they can just use
-     * fnamchk on it directly with the appropriate options (for example -E txt
-     * would tell it to expect the extension txt instead of txz).
+     * First of all we have to run the fnamchk checks on the tarball filename:
+     * this is important because we have to know the actual directory name the
+     * files should be in within the tarball which we use in checks on the
+     * directory (and any additional directories in the tarball).
      *
-     */
-    if (read_from_text_file) {
-
-        /*
-         * In test mode (-T) we must ignore the timestamp failing. This is
-         * important because otherwise the test script (txzchk_test.sh) would
-         * fail due to the timestamp being updated.
-         *
-         * In test mode (-T) we MUST give fnamchk(1) the -T option (ignore
-         * timestamp failure) and if we were given -x we must use -t.
-         */
-        if (dbg_allowed(DBG_MED)) {
-            if (test_mode) {
-                dbg(DBG_MED, "about to execute: %s -t -T -v 3 -E %s -- %s", fnamchk, ext, tarball_path);
-                exit_code = shell_cmd(__func__, false, true, "% -t -T -v 3 -E % -- %", fnamchk, ext, tarball_path);
-            } else {
-                dbg(DBG_MED, "about to execute: %s -T -v 3 -E %s -- %s", fnamchk, ext, tarball_path);
-                exit_code = shell_cmd(__func__, false, true, "% -T -v 3 -E % -- %", fnamchk, ext, tarball_path);
-            }
-        } else {
-            if (test_mode) {
-                exit_code = shell_cmd(__func__, false, true, "% -t -T -E % -- % >/dev/null", fnamchk, ext, tarball_path);
-            } else {
-                exit_code = shell_cmd(__func__, false, true, "% -T -E % -- % >/dev/null", fnamchk, ext, tarball_path);
-            }
-        }
-    } else {
-        if (dbg_allowed(DBG_MED)) {
-            if (test_mode) {
-                dbg(DBG_MED, "about to execute: %s -t -v 5 -E %s -- %s", fnamchk, ext, tarball_path);
-                exit_code = shell_cmd(__func__, false, true, "% -t -v 3 -E % -- %", fnamchk, ext, tarball_path);
-            } else {
-                dbg(DBG_MED, "about to execute: %s -v 5 -E %s -- %s", fnamchk, ext, tarball_path);
-                exit_code = shell_cmd(__func__, false, true, "% -v 3 -E % -- %", fnamchk, ext, tarball_path);
-            }
-        } else {
-            if (test_mode) {
-                exit_code = shell_cmd(__func__, false, true, "% -t -E % -- % >/dev/null", fnamchk, ext, tarball_path);
-            } else {
-                exit_code = shell_cmd(__func__, false, true, "% -E % -- % >/dev/null", fnamchk, ext, tarball_path);
-            }
-        }
-    }
-    if (exit_code != 0) {
-	warn(TXZCHK_BASENAME, "%s: %s %s failed with exit code: %d", tarball_path, fnamchk, tarball_path, WEXITSTATUS(exit_code));
-	++tarball.total_feathers;
-    } else {
-	fnamchk_okay = true;
-    }
-
-    /*
-     * If fnamchk went okay we have to retrieve the directory name that's
-     * expected and compare it to what's in the filenames of the tarball. Since
-     * it's the only output we shouldn't have to loop at all. If the output
-     * format of the tool changes this must also change!
+     * In text file mode (-T) we must ignore the timestamp failing. This is
+     * important because otherwise the test script (txzchk_test.sh) would fail
+     * due to the timestamp being updated. If we were given -x the filename
+     * must be a test submit filename.
      *
-     * Note that the reason we don't exit if fnamchk reports an error is we
-     * still can detect other feathers/issues; we just won't detect feathers
-     * with the submit slot number and directory.
-     */
-    if (fnamchk_okay) {
-
-	/*
-	 * form pipe to the fnamchk command
-         *
-         * If test mode is enabled we will also pass the -T option to fnamchk: to
-         * ignore the timestamp test failing. This is important because when a new
-         * contest opens the timestamp will be updated and that means that the tests
-         * will fail!
-         */
-        if (read_from_text_file) {
-
-            /*
-             * In text file mode (-T) we must ignore the timestamp failing. This
-             * is important because otherwise the test script (txzchk_test.sh)
-             * would fail due to the timestamp being updated.
-             *
-             * In text file mode (-T) we MUST give fnamchk(1) the -T option (ignore
-             * timestamp failure); if we're given -x we MUST give fnamchk -t.
-             */
-            if (test_mode) {
-                errno = 0; /* pre-clear errno for errp() */
-                fnamchk_stream = pipe_open(__func__, false, true, "% -t -T -E % -- %", fnamchk, ext, tarball_path);
-                if (fnamchk_stream == NULL) {
-                    errp(48, __func__, "popen for reading failed for: %s -- %s", fnamchk, tarball_path);
-                    not_reached();
-                }
-            } else {
-                errno = 0; /* pre-clear errno for errp() */
-                fnamchk_stream = pipe_open(__func__, false, true, "% -T -E % -- %", fnamchk, ext, tarball_path);
-                if (fnamchk_stream == NULL) {
-                    errp(49, __func__, "popen for reading failed for: %s -- %s", fnamchk, tarball_path);
-                    not_reached();
-                }
-            }
-        } else {
-
-            /*
-             * In real mode (not reading from a text file) we MUST check the timestamp so
-             * we must NOT use the -T option to fnamchk. Depending on whether we
-             * were given -x or not we will give fnamchk -t (we were given -x).
-             */
-            errno = 0; /* pre-clear errno for errp() */
-            if (test_mode) {
-                fnamchk_stream = pipe_open(__func__, false, true, "% -t -E % -- %", fnamchk, ext, tarball_path);
-            } else {
-                fnamchk_stream = pipe_open(__func__, false, true, "% -E % -- %", fnamchk, ext, tarball_path);
-            }
-            if (fnamchk_stream == NULL) {
-                errp(50, __func__, "popen for reading failed for: %s -- %s", fnamchk, tarball_path);
-                not_reached();
-            }
-        }
-
-	/*
-	 * read the output from the fnamchk command
-	 */
-	readline_len = readline(&dirname, fnamchk_stream);
-	if (readline_len < 0) {
-	    warn(TXZCHK_BASENAME, "%s: unexpected EOF from fnamchk", tarball_path);
-	}
-
-	/*
-	 * close down pipe
-	 */
-	errno = 0;		/* pre-clear errno for warnp() */
-	ret = pclose(fnamchk_stream);
-	if (ret < 0) {
-	    warnp(TXZCHK_BASENAME, "in %s: %s: pclose error on fnamchk stream", __func__, tarball_path);
-	}
-
-	fnamchk_stream = NULL;
-
-	if (dirname == NULL || *dirname == '\0') {
-	    err(51, __func__, "txzchk: unexpected NULL pointer from fnamchk -- %s", tarball_path);
+     * Note that the reason we don't exit if a check fails is we still can
+     * detect other feathers/issues; we just won't detect feathers with the
+     * submit slot number and directory.
+     */
+    if (chk_submit_filename(tarball_path, ext, test_mode, read_from_text_file, &sub)) {
+	errno = 0;		/* pre-clear errno for errp() */
+	dirname = strdup(sub.dirname);
+	if (dirname == NULL) {
+	    errp(48, __func__, "strdup(\"%s\") failed", sub.dirname);
 	    not_reached();
 	}
+	dbg(DBG_MED, "%s: submit directory: %s", tarball_path, dirname);
+    } else {
+	warn(TXZCHK_BASENAME, "%s: fnamchk check failed with exit code: %d: %s", tarball_path, sub.code, sub.msg);
+	++ctx->tarball.total_feathers;
     }
+    free_submit_filename(&sub);
 
     /*
      * determine size of tarball
      */
-    tarball.size = file_size(tarball_path);
+    ctx->tarball.size = file_size(tarball_path);
 
     /*
      * report size if too big
      */
-    if (tarball.size < 0) {
+    if (ctx->tarball.size < 0) {
 	err(52, __func__, "%s: impossible error: txzchk_sanity_chks() found tarball but file_size() did not", tarball_path);
 	not_reached();
-    } else if (tarball.size > MAX_TARBALL_LEN) {
-	++tarball.total_feathers;
+    } else if (ctx->tarball.size > MAX_TARBALL_LEN) {
+	++ctx->tarball.total_feathers;
         fpara(stderr,
               "",
               "The compressed tarball exceeds the maximum allowed size, sorry.",
               "",
               NULL);
 	    warn(TXZCHK_BASENAME, "%s: the compressed tarball size %lld > %d",
-				  tarball_path, (long long)tarball.size, MAX_TARBALL_LEN);
-    } else if (verbosity_level) {
+				  tarball_path, (long long)ctx->tarball.size, MAX_TARBALL_LEN);
+    } else if (verbosity_level && !batch_mode) {
 	errno = 0;		/* pre-clear errno for warnp() */
-	ret = printf("txzchk: %s size of %lld bytes OK\n", tarball_path, (long long) tarball.size);
+	ret = printf("txzchk: %s size of %lld bytes OK\n", tarball_path, (long long) ctx->tarball.size);
 	if (ret <= 0) {
 	    warnp(TXZCHK_BASENAME, "unable to tell user how big the tarball %s is", tarball_path);
 	}
     }
-    dbg(DBG_MED, "txzchk: %s size in bytes: %lld", tarball_path, (long long)tarball.size);
+    dbg(DBG_MED, "txzchk: %s size in bytes: %lld", tarball_path, (long long)ctx->tarball.size);
+
+    if (read_from_text_file || use_tar) {
+	/*
+	 * read the tar -tJvf listing (or with -T the text file)
+	 */
+	read_txz_lines(ctx, tar);
+
+	/*
+	 * now parse the lines, reporting any feathers stuck in the tarball that
+	 * have to be detected while parsing
+	 */
+	parse_all_txz_lines(ctx, dirname, tarball_path);
+    } else {
+	/*
+	 * read the tarball ourselves, reporting any feathers stuck in the
+	 * tarball that have to be detected while reading
+	 */
+	(void) parse_txz_entries(ctx, dirname, tarball_path);
+    }
+
+    /*
+     * check files list and report any additional feathers stuck in the tarball
+     *
+     * NOTE: with -B a tarball we could not read has nothing more to check.
+     */
+    if (ctx->error == NULL) {
+	check_all_txz_files(ctx);
+    }
+
+    /* free the files list */
+    free_txz_files_list(ctx);
+
+    /* free txz_lines list */
+    free_txz_lines(ctx);
+
+    /* free the allocated memory */
+    if (dirname != NULL) {
+	free(dirname);
+	dirname = NULL;
+    }
+    return ctx->tarball.total_feathers;
+}
+
+
+/*
+ * read_txz_lines - read the tarball listing into the txz_lines list
+ *
+ * given:
+ *
+ *	ctx		- the state of checking the tarball
+ *	tar		- path to executable tar program (if -T was not
+ *			  specified)
+ *
+ * With -T we read tarball_path as a text file with a tar listing, else we read
+ * the listing of tar -tJvf (-t tar given).
+ *
+ * This function does not return on error.
+ */
+static void
+read_txz_lines(struct txz_ctx *ctx, char const *tar)
+{
+    uintmax_t line_num = 0; /* line number of tar output */
+    FILE *input_stream = NULL; /* pipe for tar output (or if -T specified read as a text file) */
+    char *linep = NULL;		/* allocated line read from tar (or text file) */
+    ssize_t readline_len;	/* readline return length */
+    int ret;			/* libc function return */
+    int exit_code;		/* shell command exit code */
+    char const *tarball_path = NULL;	/* the tarball (by path) being read */
+
+    /*
+     * firewall
+     */
+    if ((!read_from_text_file && tar == NULL) || ctx == NULL || ctx->tarball_path == NULL) {
+	err(70, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    tarball_path = ctx->tarball_path;
 
     /*
      * if txzchk -T we need to open it as a text file: for test mode
@@ -1616,7 +1579,7 @@ check_tarball(char const *tar, char const *fnamchk)
 	/*
 	 * first execute the tar command
 	 */
-	if (verbosity_level) {
+	if (verbosity_level && !batch_mode) {
 	    exit_code = shell_cmd(__func__, false, true, "% -tJvf %", tar, tarball_path);
 	} else {
 	    exit_code = shell_cmd(__func__, false, true, "% -tJvf % >/dev/null", tar, tarball_path);
@@ -1667,7 +1630,7 @@ check_tarball(char const *tar, char const *fnamchk)
 	errno = 0;		/* pre-clear errno for warnp() */
 	p = (char *)memchr(linep, 0, (size_t)readline_len);
 	if (p != NULL) {
-	    ++tarball.total_feathers;
+	    ++ctx->tarball.total_feathers;
 	    warnp(TXZCHK_BASENAME, "found NUL before end of line");
 	    if (verbosity_level) {
 		msg("skipping to next line");
@@ -1685,13 +1648,13 @@ check_tarball(char const *tar, char const *fnamchk)
 	 * add line to list (to parse once the list of files has been shown to
 	 * the user).
 	 */
-	add_txz_line(linep, line_num);
+	add_txz_line(ctx, linep, line_num);
 
 	/*
 	 * if we're reading from a text file and verbosity level > 0 then we
 	 * print the line too.
 	 */
-	if (read_from_text_file && verbosity_level > 0) {
+	if (read_from_text_file && verbosity_level > 0 && !batch_mode) {
 	    errno = 0;		/* pre-clear errno for warnp() */
 	    ret = printf("%s\n", linep);
 	    if (ret <= 0)
@@ -1721,122 +1684,407 @@ check_tarball(char const *tar, char const *fnamchk)
     }
     input_stream = NULL;
 
-    /*
-     * now parse the lines, reporting any feathers stuck in the tarball that
-     * have to be detected while parsing
-     */
-    parse_all_txz_lines(dirname, tarball_path);
-
-    /*
-     * check files list and report any additional feathers stuck in the tarball
-     */
-    check_all_txz_files();
-
-    /* free the files list */
-    free_txz_files_list();
-
-    /* free txz_lines list */
-    free_txz_lines();
-
     /* free the allocated memory */
-    if (dirname != NULL) {
-	free(dirname);
-	dirname = NULL;
-    }
     if (linep != NULL) {
 	free(linep);
 	linep = NULL;
     }
-    return tarball.total_feathers;
+    return;
 }
 
 
 /*
- * add_txz_line - add line to txz_lines list
+ * print_tar_entry - print a tarball entry as tar -tv would list it
  *
  * given:
  *
- *	str	    - line to add to the list
- *	line_num    - line number
- *
- * The purpose of this function is that we can show the tarball listing in one
- * go and then after that we can parse this so that any warnings are not
- * interspersed with the tarball list thus keeping the output cleaner.
+ *	entry		- tarball entry
+ *	perms		- permission string of entry (from tar_mode_str())
  *
  * This function returns void.
  */
 static void
-add_txz_line(char const *str, uintmax_t line_num)
+print_tar_entry(struct tar_entry const *entry, char const *perms)
 {
-    struct txz_line *line;
+    char owner[(TAR_ID_NAME_LEN + 1) * 2 + 1];	/* user/group (name or number) */
+    char date[BUFSIZ];		/* modification time */
+    struct tm tm;		/* broken down modification time */
+    time_t mtime;		/* modification time */
+    int width;			/* size field width */
+    char const *p;
+    int ret;			/* libc function return */
 
     /*
      * firewall
      */
-    if (str == NULL) {
-	err(56, __func__, "passed NULL str");
+    if (entry == NULL || perms == NULL) {
+	err(71, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
-    errno = 0;
-    line = calloc(1, sizeof *line);
-    if (line == NULL) {
-	errp(57, __func__, "unable to allocate struct txz_line *");
-	not_reached();
+    /*
+     * like tar, list names if the header has them, else numerical IDs
+     */
+    if (entry->uname[0] != '\0' && entry->gname[0] != '\0') {
+	ret = snprintf(owner, sizeof(owner), "%s/%s", entry->uname, entry->gname);
+    } else {
+	ret = snprintf(owner, sizeof(owner), "%ju/%ju", entry->uid, entry->gid);
+    }
+    if (ret <= 0) {
+	owner[0] = '\0';
+    }
+    mtime = (time_t)entry->mtime;
+    if (localtime_r(&mtime, &tm) == NULL || strftime(date, sizeof(date), "%Y-%m-%d %H:%M", &tm) == 0) {
+	strcpy(date, "0000-00-00 00:00");
+    }
+    width = 18 - (int)strlen(owner);
+    if (width < 1) {
+	width = 1;
     }
 
-    errno = 0;
-    line->line = strdup(str);
-    if (line->line == NULL) {
-	errp(58, __func__, "unable to strdup string '%s' for lines list", str);
-	not_reached();
+    errno = 0;		/* pre-clear errno for warnp() */
+    ret = printf("%s %s %*jd %s ", perms, owner, width, entry->size, date);
+    if (ret <= 0) {
+	warnp(TXZCHK_BASENAME, "in %s: unable to printf tarball entry", __func__);
     }
-    line->line_num = line_num;
 
-    dbg(DBG_VHIGH, "adding line %s to lines list", line->line);
-    line->next = txz_lines;
-    txz_lines = line;
+    /*
+     * print the path, escaping unprintable characters as tar does
+     */
+    for (p = entry->path; *p != '\0'; ++p) {
+	if (*p == '\\') {
+	    (void) fputs("\\\\", stdout);
+	} else if (isprint((unsigned char)*p)) {
+	    (void) putchar(*p);
+	} else {
+	    (void) printf("\\%03o", (unsigned int)(unsigned char)*p);
+	}
+    }
+    if (entry->typeflag == TAR_SYMTYPE) {
+	(void) printf(" -> %s", entry->linkname);
+    } else if (entry->typeflag == TAR_LNKTYPE) {
+	(void) printf(" link to %s", entry->linkname);
+    }
+    (void) putchar('\n');
     return;
 }
 
 
 /*
- * parse_all_txz_lines - parse all tar lines
- *
- * Parse the txz_lines list and report any feathers stuck in the tarball. After
- * all the lines have been parsed additional tests will be performed.
+ * parse_tar_entry - parse an entry of the tarball
  *
  * given:
  *
- *	dirname	- directory name as reported by fnamchk (can be NULL if
- *			  fnamchk failed to validate directory)
- *	tarball_path	- the tarball that is being read
+ *	ctx		- the state of checking the tarball
+ *	entry		- tarball entry
+ *	dirname		- the directory name reported by fnamchk or NULL if it failed
+ *	tarball_path	- the tarball path
+ *	sum		- corresponds to sum pointer in sum_and_count()
+ *	count		- corresponds to count pointer in sum_and_count()
  *
- * This function returns void.
+ * This is what parse_txz_line() does for a tar listing line, only we have the
+ * fields of the tar header rather than the text of a listing.
  *
  * This function does not return on error.
  */
 static void
-parse_all_txz_lines(char const *dirname, char const *tarball_path)
+parse_tar_entry(struct txz_ctx *ctx, struct tar_entry const *entry, char const *dirname, char const *tarball_path,
+	intmax_t *sum, intmax_t *count)
 {
-    struct txz_line *line = NULL;	/* for txz_lines list */
-    char *line_dup = NULL;	/* strdup()d line */
-    intmax_t sum = 0;		/* sum for sum_and_count() checks */
-    intmax_t count = 0;		/* count for sum_and_count() checks */
+    struct txz_file *file = NULL;   /* allocated struct of file info */
+    char mode[TAR_MODE_STR_LEN + 1];	/* permission string */
+    char *perms = NULL;		/* allocated permission string */
+    bool isfile = false;	/* normal file counts against file size and count */
+    bool isdir = false;		/* if it's a directory */
 
     /*
      * firewall
      */
-    if (tarball_path == NULL) {
-	err(59, __func__, "passed NULL tarball_path");
+    if (entry == NULL || tarball_path == NULL || sum == NULL || count == NULL) {
+	err(72, __func__, "called with NULL arg(s)");
 	not_reached();
     }
 
-    for (line = txz_lines; line != NULL; line = line->next) {
-	if (line->line == NULL) {
-	    warn(TXZCHK_BASENAME, "encountered NULL string on line %ju", line->line_num);
-	    ++tarball.total_feathers;
-	    continue;
+    /*
+     * look for non-directory non-regular non-hard-linked items
+     */
+    isdir = tar_is_dir(entry);
+    isfile = tar_is_file(entry);
+    if (!isdir && !isfile) {
+	warn(TXZCHK_BASENAME, "%s: found a non-directory non-regular non-hard-linked item: %s",
+	    tarball_path, entry->path);
+	++ctx->tarball.total_feathers;
+    }
+
+    /*
+     * the tarball must have numerical IDs, not user or group names
+     */
+    if (entry->uname[0] != '\0') {
+	warn(TXZCHK_BASENAME, "%s: found non-numerical UID %s for %s", tarball_path, entry->uname, entry->path);
+	++ctx->tarball.total_feathers;
+    }
+    if (entry->gname[0] != '\0') {
+	warn(TXZCHK_BASENAME, "%s: found non-numerical GID %s for %s", tarball_path, entry->gname, entry->path);
+	++ctx->tarball.total_feathers;
+    }
+
+    /* add to total number of files and total size if it's a normal file */
+    if (isfile) {
+	count_and_sum(ctx, tarball_path, sum, count, entry->size);
+    }
+
+    /*
+     * save permission bits
+     */
+    tar_mode_str(entry, mode);
+    errno = 0;      /* pre-clear errno for errp() */
+    perms = strdup(mode);
+    if (perms == NULL) {
+        errp(73, __func__, "txzchk: failed to strdup permissions string");
+        not_reached();
+    }
+
+    file = alloc_txz_file(ctx, entry->path, dirname, perms, isdir, isfile, strchr(perms, 'x') != NULL, entry->size);
+    if (file == NULL) {
+	err(74, __func__, "alloc_txz_file() returned NULL");
+	not_reached();
+    }
+
+    /* checks on this specific file */
+    check_txz_file(ctx, tarball_path, dirname, file);
+
+    add_txz_file_to_list(ctx, file);
+    return;
+}
+
+
+/*
+ * parse_txz_entries - read the tarball and parse each of its entries
+ *
+ * given:
+ *
+ *	ctx		- the state of checking the tarball
+ *	dirname		- the directory name reported by fnamchk or NULL if it failed
+ *	tarball_path	- the tarball path
+ *
+ * returns:
+ *
+ *	true ==> tarball was read, false ==> (-B only) tarball could not be read
+ *
+ * We decompress and read the tar headers ourselves, without extracting the
+ * tarball or running tar(1). As with the tar -tJvf listing we list all the
+ * entries (if verbosity_level > 0 and not -B) before we parse them so that any
+ * warnings are not interspersed with the listing.
+ *
+ * With -B a tarball that cannot be opened or that is not a valid xz compressed
+ * tarball is a feather: we record why in ctx->error and return false so that
+ * the other tarballs can still be checked.
+ *
+ * This function does not return on error, which without -B includes a tarball
+ * that is not a valid xz compressed tarball.
+ */
+static bool
+parse_txz_entries(struct txz_ctx *ctx, char const *dirname, char const *tarball_path)
+{
+    struct xz_reader *xz = NULL;	/* xz reader of the tarball */
+    struct dyn_array *entries = NULL;	/* struct tar_entry of each tarball entry */
+    struct tar_entry entry;		/* tarball entry read */
+    struct tar_entry *ent = NULL;	/* tarball entry to parse */
+    char mode[TAR_MODE_STR_LEN + 1];	/* permission string */
+    char const *errmsg = NULL;		/* what is wrong with the tarball */
+    intmax_t sum = 0;			/* sum for sum_and_count() checks */
+    intmax_t count = 0;			/* count for sum_and_count() checks */
+    intmax_t i;
+    int ret;
+
+    /*
+     * firewall
+     */
+    if (ctx == NULL || tarball_path == NULL) {
+	err(75, __func__, "passed NULL ctx or tarball_path");
+	not_reached();
+    }
+
+    errno = 0;		/* pre-clear errno for errp() */
+    xz = xz_open(tarball_path);
+    if (xz == NULL) {
+	if (!batch_mode) {
+	    errp(76, __func__, "unable to open tarball: %s", tarball_path);
+	    not_reached();
+	}
+	warnp(TXZCHK_BASENAME, "%s: unable to open tarball", tarball_path);
+	ctx->error = "unable to open tarball";
+	++ctx->tarball.total_feathers;
+	return false;
+    }
+    entries = dyn_array_create(sizeof(struct tar_entry), 64, 64, false);
+
+    /*
+     * read all the entries
+     */
+    while ((ret = tar_next(xz, &entry, &errmsg)) > 0) {
+	dbg(DBG_VHIGH, "entry %jd: %s", dyn_array_tell(entries), entry.path);
+	if (dyn_array_append_value(entries, &entry)) {
+	    dbg(DBG_VVHIGH, "moved entries array in memory");
+	}
+	if (verbosity_level > 0 && !batch_mode) {
+	    tar_mode_str(&entry, mode);
+	    print_tar_entry(&entry, mode);
+	}
+    }
+    if (ret < 0) {
+	if (!batch_mode) {
+	    err(77, __func__, "%s: not a valid xz compressed tarball: %s", tarball_path,
+		    errmsg != NULL ? errmsg : "unknown error");
+	    not_reached();
+	}
+	warn(TXZCHK_BASENAME, "%s: not a valid xz compressed tarball: %s", tarball_path,
+		errmsg != NULL ? errmsg : "unknown error");
+	ctx->error = errmsg != NULL ? errmsg : "not a valid xz compressed tarball";
+	++ctx->tarball.total_feathers;
+	xz_close(xz);
+	xz = NULL;
+	dyn_array_free(entries);
+	entries = NULL;
+	return false;
+    }
+    dbg(DBG_HIGH, "reached end of tarball %s", tarball_path);
+
+    /*
+     * read the rest of the xz file, after the end of the tarball, so that the
+     * check of the last block, the index and the stream footer are verified
+     */
+    if (!xz_read_to_end(xz)) {
+	errmsg = xz_error(xz);
+	if (!batch_mode) {
+	    err(98, __func__, "%s: corrupt xz compressed data after the end of the tarball: %s", tarball_path,
+		    errmsg != NULL ? errmsg : "unknown error");
+	    not_reached();
+	}
+	warn(TXZCHK_BASENAME, "%s: corrupt xz compressed data after the end of the tarball: %s", tarball_path,
+		errmsg != NULL ? errmsg : "unknown error");
+	ctx->error = errmsg != NULL ? errmsg : "corrupt xz compressed data";
+	++ctx->tarball.total_feathers;
+	xz_close(xz);
+	xz = NULL;
+	dyn_array_free(entries);
+	entries = NULL;
+	return false;
+    }
+    dbg(DBG_HIGH, "verified the rest of the xz file %s", tarball_path);
+    xz_close(xz);
+    xz = NULL;
+
+    /*
+     * now parse the entries
+     */
+    for (i = 0; i < dyn_array_tell(entries); ++i) {
+	ent = dyn_array_addr(entries, struct tar_entry, i);
+	parse_tar_entry(ctx, ent, dirname, tarball_path, &sum, &count);
+    }
+    dyn_array_free(entries);
+    entries = NULL;
+    return true;
+}
+
+
+/*
+ * add_txz_line - add line to txz_lines list
+ *
+ * given:
+ *
+ *	ctx	    - the state of checking the tarball
+ *	str	    - line to add to the list
+ *	line_num    - line number
+ *
+ * The purpose of this function is that we can show the tarball listing in one
+ * go and then after that we can parse this so that any warnings are not
+ * interspersed with the tarball list thus keeping the output cleaner.
+ *
+ * This function returns void.
+ */
+static void
+add_txz_line(struct txz_ctx *ctx, char const *str, uintmax_t line_num)
+{
+    struct txz_line line;	/* line to append to the txz_lines array */
+
+    /*
+     * firewall
+     */
+    if (str == NULL) {
+	err(56, __func__, "passed NULL str");
+	not_reached();
+    }
+
+    /*
+     * create the lines array for the first line
+     */
+    if (ctx->txz_lines == NULL) {
+	ctx->txz_lines = dyn_array_create(sizeof(struct txz_line), TXZCHK_ENTRY_CHUNK, TXZCHK_ENTRY_CHUNK, true);
+    }
+
+    errno = 0;
+    line.line = strdup(str);
+    if (line.line == NULL) {
+	errp(58, __func__, "unable to strdup string '%s' for lines list", str);
+	not_reached();
+    }
+    line.line_num = line_num;
+
+    dbg(DBG_VHIGH, "adding line %s to lines list", line.line);
+    (void) dyn_array_append_value(ctx->txz_lines, &line);
+    return;
+}
+
+
+/*
+ * parse_all_txz_lines - parse all tar lines
+ *
+ * Parse the txz_lines list and report any feathers stuck in the tarball. After
+ * all the lines have been parsed additional tests will be performed.
+ *
+ * given:
+ *
+ *	ctx	- the state of checking the tarball
+ *	dirname	- directory name as reported by fnamchk (can be NULL if
+ *			  fnamchk failed to validate directory)
+ *	tarball_path	- the tarball that is being read
+ *
+ * This function returns void.
+ *
+ * This function does not return on error.
+ */
+static void
+parse_all_txz_lines(struct txz_ctx *ctx, char const *dirname, char const *tarball_path)
+{
+    struct txz_line *line = NULL;	/* for txz_lines array */
+    intmax_t len;		/* number of lines in the txz_lines array */
+    intmax_t i;
+    char *line_dup = NULL;	/* strdup()d line */
+    intmax_t sum = 0;		/* sum for sum_and_count() checks */
+    intmax_t count = 0;		/* count for sum_and_count() checks */
+
+    /*
+     * firewall
+     */
+    if (tarball_path == NULL) {
+	err(59, __func__, "passed NULL tarball_path");
+	not_reached();
+    }
+
+    /*
+     * NOTE: we parse from the last line read to the first, the order of the
+     *	     list these lines were once kept in, so that the order of the
+     *	     warnings (as recorded in the test_ioccc/test_txzchk .err files) is
+     *	     unchanged.
+     */
+    len = (ctx->txz_lines == NULL) ? 0 : dyn_array_tell(ctx->txz_lines);
+    for (i = len - 1; i >= 0; --i) {
+	line = dyn_array_addr(ctx->txz_lines, struct txz_line, i);
+	if (line->line == NULL) {
+	    warn(TXZCHK_BASENAME, "encountered NULL string on line %ju", line->line_num);
+	    ++ctx->tarball.total_feathers;
+	    continue;
 	}
 
 	line_dup = strdup(line->line);
@@ -1845,7 +2093,7 @@ parse_all_txz_lines(char const *dirname, char const *tarball_path)
 	    not_reached();
 	}
 
-	parse_txz_line(line->line, line_dup, dirname, tarball_path, &sum, &count);
+	parse_txz_line(ctx, line->line, line_dup, dirname, tarball_path, &sum, &count);
 	free(line_dup);
 	line_dup = NULL;
     }
@@ -1869,22 +2117,26 @@ parse_all_txz_lines(char const *dirname, char const *tarball_path)
  * This function returns void.
  */
 static void
-free_txz_lines(void)
+free_txz_lines(struct txz_ctx *ctx)
 {
-    struct txz_line *line, *next_line;
+    struct txz_line *line;	/* line in the txz_lines array */
+    intmax_t len;		/* number of lines in the txz_lines array */
+    intmax_t i;
 
-    for (line = txz_lines; line != NULL; line = next_line) {
-	next_line = line->next;
+    if (ctx->txz_lines == NULL) {
+	return;
+    }
+    len = dyn_array_tell(ctx->txz_lines);
+    for (i = 0; i < len; ++i) {
+	line = dyn_array_addr(ctx->txz_lines, struct txz_line, i);
 	if (line->line) {
 	    free(line->line);
 	    line->line = NULL;
 	}
-
-	free(line);
-	line = NULL;
     }
 
-    txz_lines = NULL;
+    dyn_array_free(ctx->txz_lines);
+    ctx->txz_lines = NULL;
     return;
 }
 
@@ -1894,6 +2146,7 @@ free_txz_lines(void)
  *
  * given:
  *
+ *	ctx	    - the state of checking the tarball
  *	path	    - file path
  *	dirname     - directory name from fnamchk or NULL if fnamchk failed
  *	perms       - permissions string
@@ -1909,15 +2162,15 @@ free_txz_lines(void)
  * This function does not return on error.
  */
 static struct txz_file *
-alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, bool isfile, bool isexec, intmax_t length)
+alloc_txz_file(struct txz_ctx *ctx, char const *path, char const *dirname, char *perms, bool isdir, bool isfile, bool isexec, intmax_t length)
 {
     struct txz_file *file;  /* the file structure */
 
     /*
      * firewall
      */
-    if (path == NULL) {
-	err(61, __func__, "passed NULL path");
+    if (ctx == NULL || path == NULL) {
+	err(61, __func__, "passed NULL ctx or path");
 	not_reached();
     }
     if (perms == NULL) {
@@ -1928,14 +2181,14 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
     errno = 0; /* pre-clear errno for errp() */
     file = calloc(1, sizeof *file);
     if (file == NULL) {
-	errp(63, __func__, "%s: unable to allocate a struct txz_file *", tarball_path);
+	errp(63, __func__, "%s: unable to allocate a struct txz_file *", ctx->tarball_path);
 	not_reached();
     }
 
     errno = 0; /* pre-clear errno for errp() */
     file->filename = strdup(path);
     if (!file->filename) {
-	errp(64, __func__, "%s: unable to strdup filename %s", tarball_path, path);
+	errp(64, __func__, "%s: unable to strdup filename %s", ctx->tarball_path, path);
 	not_reached();
     }
 
@@ -1944,7 +2197,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
      */
     file->top_dirname = dir_name(path);
     if (file->top_dirname == NULL || *(file->top_dirname) == '\0') {
-	err(65, __func__, "%s: unable to strdup top dirname of filename %s", tarball_path, path);
+	err(65, __func__, "%s: unable to strdup top dirname of filename %s", ctx->tarball_path, path);
 	not_reached();
     }
 
@@ -1955,7 +2208,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
         errno = 0; /* pre-clear errno for errp() */
         file->dirname = strdup(dirname);
         if (file->dirname == NULL) {
-            err(66, __func__, "%s: unable to strdup dirname %s", tarball_path, dirname);
+            err(66, __func__, "%s: unable to strdup dirname %s", ctx->tarball_path, dirname);
             not_reached();
         }
     } else {
@@ -1970,7 +2223,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
      */
     file->basename = base_name(path);
     if (file->basename == NULL || *(file->basename) == '\0') {
-	err(67, __func__, "%s: unable to strdup basename of filename %s", tarball_path, path);
+	err(67, __func__, "%s: unable to strdup basename of filename %s", ctx->tarball_path, path);
 	not_reached();
     }
 
@@ -1981,7 +2234,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
     /*
      * convert perms into a mode_t
      */
-    file->mode = get_mode(file);
+    file->mode = get_mode(ctx, file);
 
     /* record the length */
     file->length = length;
@@ -2009,6 +2262,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
  *
  * given:
  *
+ *      ctx         - the state of checking the tarball
  *      file        - pointer to struct txz_file (from caller)
  *
  * This function does not return on a NULL txz_file or NULL filename or NULL
@@ -2019,7 +2273,7 @@ alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir, b
  * NOTE: yes it is true that below we could use a loop and check the index (or
  * maybe 'index') but we're more explicit and careful there.
  */
-mode_t get_mode(struct txz_file *file)
+mode_t get_mode(struct txz_ctx *ctx, struct txz_file *file)
 {
     mode_t mode = 0;       /* mode_t to return */
     char const *s = NULL;     /* perms string in file */
@@ -2028,17 +2282,17 @@ mode_t get_mode(struct txz_file *file)
 
     if (file == NULL) {
         warn(TXZCHK_BASENAME, "in %s: file is NULL", __func__);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         return 0;
     }
     if (file->filename == NULL) {
         warn(TXZCHK_BASENAME, "in %s: file->filename is NULL", __func__);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         return 0;
     }
     if (file->perms == NULL) {
 	warn(TXZCHK_BASENAME, "in %s: perms for file '%s' is NULL", __func__, file->filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         return 0;
     }
 
@@ -2047,7 +2301,7 @@ mode_t get_mode(struct txz_file *file)
     if (strlen(perms) < 10) {
         warn(TXZCHK_BASENAME, "in %s: file %s too few characters in perm string: %zu != 10", __func__, filename,
              strlen(perms));
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
         return 0;
     }
 
@@ -2079,7 +2333,7 @@ mode_t get_mode(struct txz_file *file)
             break;
         default:
             warn(TXZCHK_BASENAME, "unknown type '%c' in permission: %s: file: %s", *s, s, filename);
-            ++tarball.total_feathers;
+            ++ctx->tarball.total_feathers;
             break;
     }
 
@@ -2090,13 +2344,13 @@ mode_t get_mode(struct txz_file *file)
         mode |= S_IRUSR;
     } else if (s[1] != '-') {
         warn(TXZCHK_BASENAME, "user read permission '%c' in file %s invalid", s[1], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[2] == 'w') {
         mode |= S_IWUSR;
     } else if (s[2] != '-') {
         warn(TXZCHK_BASENAME, "user write permission '%c' in file %s invalid", s[2], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[3] == 'x' || s[3] == 's') {
         mode |= S_IXUSR;
@@ -2106,7 +2360,7 @@ mode_t get_mode(struct txz_file *file)
     }
     if (s[3] != 's' && s[3] != 'S' && s[3] != 'x' && s[3] != '-') {
         warn(TXZCHK_BASENAME, "user exec permission '%c' in file %s invalid", s[3], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
 
     /*
@@ -2116,13 +2370,13 @@ mode_t get_mode(struct txz_file *file)
         mode |= S_IRGRP;
     } else if (s[4] != '-') {
         warn(TXZCHK_BASENAME, "group read permission '%c' in file %s invalid", s[4], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[5] == 'w') {
         mode |= S_IWGRP;
     } else if (s[5] != '-') {
         warn(TXZCHK_BASENAME, "group write permission '%c' in file %s invalid", s[5], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[6] == 'x' || s[6] == 's') {
         mode |= S_IXGRP;
@@ -2132,7 +2386,7 @@ mode_t get_mode(struct txz_file *file)
     }
     if (s[6] != 's' && s[6] != 'S' && s[6] != 'x' && s[6] != '-') {
         warn(TXZCHK_BASENAME, "group exec permission '%c' in file %s invalid", s[6], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
 
     /*
@@ -2142,13 +2396,13 @@ mode_t get_mode(struct txz_file *file)
         mode |= S_IROTH;
     } else if (s[7] != '-') {
         warn(TXZCHK_BASENAME, "other read permission '%c' in file %s invalid", s[7], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[8] == 'w') {
         mode |= S_IWOTH;
     } else if (s[8] != '-') {
         warn(TXZCHK_BASENAME, "other write permission '%c' in file %s invalid", s[8], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     if (s[9] == 'x' || s[9] == 't') {
         mode |= S_IXOTH;
@@ -2158,27 +2412,27 @@ mode_t get_mode(struct txz_file *file)
     }
     if (s[9] != 's' && s[9] != 'S' && s[9] != 'x' && s[9] != '-') {
         warn(TXZCHK_BASENAME, "other exec permission '%c' in file %s invalid", s[9], filename);
-        ++tarball.total_feathers;
+        ++ctx->tarball.total_feathers;
     }
     return mode;
 }
 
 
 /*
- * add_txz_file_to_list - add a filename to the linked list
+ * add_txz_file_to_list - add a filename to the txz_files array
  *
  * given:
  *
+ *	ctx		    - the state of checking the tarball
  *	file		    - pointer to struct txz_file which should already have the name
  *
- * If the function finds this filename already in the list (full path!) it
- * increments the count and does not add it to the list; else it adds it to the
- * list with a count of 1.
+ * Duplicate filenames are not looked for here: check_all_txz_files() finds
+ * them (in a case independent way) when it records each file with the walk code.
  *
  * This function does not return on error.
  */
 static void
-add_txz_file_to_list(struct txz_file *txzfile)
+add_txz_file_to_list(struct txz_ctx *ctx, struct txz_file *txzfile)
 {
     /*
      * firewall
@@ -2188,10 +2442,15 @@ add_txz_file_to_list(struct txz_file *txzfile)
 	not_reached();
     }
 
-    /* lazily add to list */
+    /*
+     * create the files array for the first file
+     */
+    if (ctx->txz_files == NULL) {
+	ctx->txz_files = dyn_array_create(sizeof(struct txz_file *), TXZCHK_ENTRY_CHUNK, TXZCHK_ENTRY_CHUNK, true);
+    }
+
     dbg(DBG_VHIGH, "adding filename %s (basename %s) to list of files", txzfile->filename, txzfile->basename);
-    txzfile->next = txz_files;
-    txz_files = txzfile;
+    (void) dyn_array_append_value(ctx->txz_files, &txzfile);
 }
 
 
@@ -2226,6 +2485,14 @@ free_txz_file(struct txz_file **file)
         free((*file)->basename);
         (*file)->basename = NULL;
     }
+    if ((*file)->top_dirname != NULL) {
+        free((*file)->top_dirname);
+        (*file)->top_dirname = NULL;
+    }
+    if ((*file)->dirname != NULL) {
+        free((*file)->dirname);
+        (*file)->dirname = NULL;
+    }
 
     if ((*file)->perms != NULL) {
         free((*file)->perms);
@@ -2242,20 +2509,537 @@ free_txz_file(struct txz_file **file)
 
 
 /*
- * free_txz_files_list  - free the txz_files linked list
+ * free_txz_files_list  - free the txz_files array and its files
  */
 static void
-free_txz_files_list(void)
+free_txz_files_list(struct txz_ctx *ctx)
 {
-    struct txz_file *file, *next_file;
+    struct txz_file *file;	/* file in the txz_files array */
+    intmax_t len;		/* number of files in the txz_files array */
+    intmax_t i;
 
-    for (file = txz_files; file != NULL; file = next_file)
-    {
-	next_file = file->next;
-        free_txz_file(&file);
-        file = NULL; /* redundant but it's safe */
+    if (ctx->txz_files == NULL) {
+	return;
+    }
+    len = dyn_array_tell(ctx->txz_files);
+    for (i = 0; i < len; ++i) {
+	file = dyn_array_value(ctx->txz_files, struct txz_file *, i);
+	if (file != NULL) {
+	    free_txz_file(&file);
+	}
+    }
+
+    dyn_array_free(ctx->txz_files);
+    ctx->txz_files = NULL;
+    return;
+}
+
+
+/*
+ * find_batch_tarballs - find the tarballs to check with -B
+ *
+ * given:
+ *
+ *	batch	    - directory to search for tarballs, or a file listing
+ *		      tarballs one per line ("-" ==> read the list from stdin)
+ *
+ * returns:
+ *
+ *	dynamic array of malloced tarball paths (char *)
+ *
+ * Under a directory we find every regular file whose name ends in "." ext (see
+ * -E), in fts_cmp() order so that the summary is the same from run to run.  In
+ * a list empty lines are ignored.
+ *
+ * This function does not return on error.
+ */
+static struct dyn_array *
+find_batch_tarballs(char const *batch)
+{
+    struct dyn_array *list = NULL;	/* tarball paths */
+    FILE *stream = NULL;		/* list of tarballs */
+    char *line = NULL;			/* line read from stream */
+    size_t linecap = 0;			/* allocated size of line */
+    ssize_t len = 0;			/* length of line read */
+    char *path = NULL;			/* malloced tarball path */
+    char *path_set[2];			/* the directory for fts_open() */
+    FTS *ftsp = NULL;			/* open fts stream */
+    FTSENT *ent = NULL;			/* file found under the directory */
+    size_t ext_len = 0;			/* length of ext */
+    size_t name_len = 0;		/* length of a filename */
+
+    /*
+     * firewall
+     */
+    if (batch == NULL) {
+	err(79, __func__, "called with NULL batch");
+	not_reached();
+    }
+    list = dyn_array_create(sizeof(char *), TXZCHK_LIST_CHUNK, TXZCHK_LIST_CHUNK, true);
+
+    /*
+     * case: find the tarballs under a directory
+     */
+    if (strcmp(batch, "-") != 0 && is_dir(batch)) {
+	ext_len = strlen(ext);
+	path_set[0] = (char *)batch;
+	path_set[1] = NULL;
+	errno = 0;		/* pre-clear errno for errp() */
+	ftsp = fts_open(path_set, FTS_COMFOLLOW | FTS_NOCHDIR | FTS_PHYSICAL, fts_cmp);
+	if (ftsp == NULL) {
+	    errp(80, __func__, "fts_open failed for directory: %s", batch);
+	    not_reached();
+	}
+	while ((ent = fts_read(ftsp)) != NULL) {
+	    if (ent->fts_info != FTS_F) {
+		continue;
+	    }
+	    name_len = strlen(ent->fts_name);
+	    if (name_len <= ext_len || ent->fts_name[name_len-ext_len-1] != '.' ||
+		strcmp(ent->fts_name + name_len - ext_len, ext) != 0) {
+		continue;
+	    }
+	    errno = 0;		/* pre-clear errno for errp() */
+	    path = strdup(ent->fts_path);
+	    if (path == NULL) {
+		errp(81, __func__, "strdup of tarball path failed");
+		not_reached();
+	    }
+	    (void) dyn_array_append_value(list, &path);
+	}
+	(void) fts_close(ftsp);
+	ftsp = NULL;
+
+    /*
+     * case: read the list of tarballs
+     */
+    } else {
+	if (strcmp(batch, "-") == 0) {
+	    stream = stdin;
+	} else {
+	    errno = 0;		/* pre-clear errno for errp() */
+	    stream = fopen(batch, "r");
+	    if (stream == NULL) {
+		errp(82, __func__, "cannot open -B list of tarballs: %s", batch);
+		not_reached();
+	    }
+	}
+	clearerr(stream);		/* pre-clear ferror() status */
+	errno = 0;			/* pre-clear errno for errp() */
+	while ((len = getline(&line, &linecap, stream)) >= 0) {
+	    if (len > 0 && line[len-1] == '\n') {
+		line[--len] = '\0';
+	    }
+	    if (len == 0) {
+		continue;
+	    }
+	    errno = 0;			/* pre-clear errno for errp() */
+	    path = strdup(line);
+	    if (path == NULL) {
+		errp(83, __func__, "strdup of tarball path failed");
+		not_reached();
+	    }
+	    (void) dyn_array_append_value(list, &path);
+	    errno = 0;			/* pre-clear errno for errp() */
+	}
+	if (ferror(stream)) {
+	    errp(84, __func__, "error reading the -B list of tarballs: %s", batch);
+	    not_reached();
+	}
+	if (stream != stdin) {
+	    (void) fclose(stream);
+	}
+	stream = NULL;
+	if (line != NULL) {
+	    free(line);
+	    line = NULL;
+	}
+    }
+    dbg(DBG_MED, "found %jd tarball%s in: %s", dyn_array_tell(list), SINGULAR_OR_PLURAL(dyn_array_tell(list)), batch);
+    return list;
+}
+
+
+/*
+ * check_job - check the tarball of a -B job and record the result
+ *
+ * given:
+ *
+ *	job		- the job to check
+ *	tar		- path to executable tar program (if -t tar was
+ *			  specified and -T was not)
+ *
+ * A tarball path that is bogus, or that is not a readable regular file, is
+ * not checked: we record why in job->ctx.error so that report_job() can report
+ * it along with the other tarballs.
+ *
+ * NOTE: This function prints nothing on stdout: the result is reported by
+ *	 report_job().  Thus different jobs may be checked by different threads
+ *	 at the same time.
+ *
+ * This function does not return on error.
+ */
+static void
+check_job(struct txz_job *job, char const *tar)
+{
+    struct timespec start;			/* when we started checking the tarball */
+    struct timespec end;			/* when we finished checking the tarball */
+    enum path_sanity sanity = PATH_ERR_UNSET;	/* canon_path error or PATH_OK */
+
+    /*
+     * firewall
+     */
+    if (job == NULL || job->path == NULL) {
+	err(85, __func__, "called with NULL job or job path");
+	not_reached();
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+    memset(&job->ctx, 0, sizeof(job->ctx));
+
+    /*
+     * the tarball must be a readable regular file
+     *
+     * IMPORTANT: canon_path() MUST use a false "lower_case" arg!  See the path_in_item_array() function.
+     */
+    job->cpath = canon_path(job->path, 0, 0, 0, &sanity, NULL, NULL, false, false, true, true, NULL);
+    if (job->cpath == NULL) {
+	warn(TXZCHK_BASENAME, "bogus tarball path: %s error: %s", job->path, path_sanity_error(sanity));
+	job->ctx.error = "bogus tarball path";
+    } else if (!exists(job->cpath)) {
+	warn(TXZCHK_BASENAME, "tarball_path does not exist: %s", job->cpath);
+	job->ctx.error = "tarball does not exist";
+    } else if (!is_file(job->cpath)) {
+	warn(TXZCHK_BASENAME, "tarball_path is not a regular file: %s", job->cpath);
+	job->ctx.error = "tarball is not a regular file";
+    } else if (!is_read(job->cpath)) {
+	warn(TXZCHK_BASENAME, "tarball_path is not readable: %s", job->cpath);
+	job->ctx.error = "tarball is not readable";
+
+    /*
+     * check the tarball
+     */
+    } else {
+	job->ctx.tarball_path = job->cpath;
+	job->ctx.tarball.total_feathers = check_tarball(&job->ctx, tar);
+    }
+    if (job->ctx.error != NULL && job->ctx.tarball.total_feathers == 0) {
+	++job->ctx.tarball.total_feathers;
     }
 
-    txz_files = NULL;
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+    job->seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
     return;
 }
+
+
+/*
+ * report_job - report the result of a checked -B job as a JSON member of the summary
+ *
+ * given:
+ *
+ *	job		- the checked job to report
+ *	first		- true ==> first job of the "tarballs" array
+ *
+ * returns:
+ *
+ *	true ==> no feathers stuck in the tarball, false ==> feathers found
+ *
+ * This function does not return on error.
+ */
+static bool
+report_job(struct txz_job const *job, bool first)
+{
+    bool ok = false;		/* true ==> JSON printed OK */
+    int ret;			/* libc function return */
+
+    /*
+     * firewall
+     */
+    if (job == NULL || job->path == NULL) {
+	err(86, __func__, "called with NULL job or job path");
+	not_reached();
+    }
+
+    errno = 0;			/* pre-clear errno for errp() */
+    ret = printf("%s        {\n", first ? "" : ",\n");
+    ok = ret > 0 &&
+	json_fprintf_value_string(stdout, "            ", "tarball", " : ", job->path, ",\n") &&
+	json_fprintf_value_bool(stdout, "            ", "checked", " : ", job->ctx.error == NULL, ",\n") &&
+	json_fprintf_value_string(stdout, "            ", "error", " : ", job->ctx.error, ",\n") &&
+	json_fprintf_value_long(stdout, "            ", "feathers", " : ", (long)job->ctx.tarball.total_feathers, ",\n") &&
+	json_fprintf_value_long(stdout, "            ", "tarball_size", " : ", (long)job->ctx.tarball.size, ",\n") &&
+	json_fprintf_value_long(stdout, "            ", "file_count", " : ", (long)job->ctx.tarball.file_count, ",\n") &&
+	json_fprintf_value_long(stdout, "            ", "total_file_size", " : ", (long)job->ctx.tarball.total_size, ",\n") &&
+	printf("            \"seconds\" : %.6f\n        }", job->seconds) > 0;
+    if (!ok) {
+	errp(87, __func__, "error printing JSON summary of tarball: %s", job->path);
+	not_reached();
+    }
+    return job->ctx.tarball.total_feathers == 0;
+}
+
+
+/*
+ * txzchk_worker - check tarballs of a -B pool until there are none left
+ *
+ * given:
+ *
+ *	arg	pointer to the struct txz_pool
+ *
+ * returns:
+ *
+ *	NULL
+ *
+ * Each worker takes the next job of the pool that no other worker has
+ * taken, checks it and marks it done, so that check_batch() can report it.
+ *
+ * This function does not return on error.
+ */
+static void *
+txzchk_worker(void *arg)
+{
+    struct txz_pool *pool = arg;	/* jobs and the state shared with check_batch() */
+    size_t j;				/* index of job taken */
+
+    /*
+     * firewall
+     */
+    if (pool == NULL) {
+	err(88, __func__, "NULL pool");
+	not_reached();
+    }
+
+    /*
+     * check jobs until there are none left
+     */
+    for (;;) {
+
+	/*
+	 * take the next job
+	 */
+	(void) pthread_mutex_lock(&pool->lock);
+	if (pool->next >= pool->count) {
+	    (void) pthread_mutex_unlock(&pool->lock);
+	    break;
+	}
+	j = pool->next++;
+	(void) pthread_mutex_unlock(&pool->lock);
+
+	/*
+	 * check the tarball
+	 */
+	check_job(&pool->job[j], pool->tar);
+
+	/*
+	 * tell check_batch() the job is done
+	 */
+	(void) pthread_mutex_lock(&pool->lock);
+	pool->job[j].done = true;
+	(void) pthread_cond_broadcast(&pool->done);
+	(void) pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+
+/*
+ * check_batch - check the tarballs of -B on a pool of worker threads
+ *
+ * given:
+ *
+ *	batch		- directory of tarballs or list of tarballs (see find_batch_tarballs())
+ *	jobs		- number of tarballs to check at the same time
+ *	tar		- path to executable tar program (if -t tar was
+ *			  specified and -T was not)
+ *
+ * returns:
+ *
+ *	true ==> no feathers stuck in any tarball, false ==> feathers found
+ *
+ * We write a JSON summary to stdout: for each tarball, in the order found, the
+ * feathers stuck in it and the time taken to check it, followed by the totals.
+ * Each tarball is reported as soon as it and the tarballs before it have been
+ * checked.  Warnings about the feathers go to stderr as they do without -B.
+ *
+ * This function does not return on error.
+ */
+static bool
+check_batch(char const *batch, intmax_t jobs, char const *tar)
+{
+    struct dyn_array *list = NULL;	/* tarball paths */
+    struct txz_pool pool;		/* jobs and the state shared with the worker threads */
+    pthread_t *worker = NULL;		/* worker threads */
+    size_t workers = 0;			/* number of worker threads started */
+    struct timespec start;		/* when we started checking */
+    struct timespec end;		/* when we finished checking */
+    uintmax_t total_feathers = 0;	/* feathers stuck in all the tarballs */
+    size_t feathery_count = 0;		/* number of tarballs with feathers */
+    size_t unchecked_count = 0;		/* number of tarballs that could not be checked */
+    bool ok = false;			/* true ==> JSON printed OK */
+    size_t j;
+    int ret;
+
+    /*
+     * firewall
+     */
+    if (batch == NULL || (tar == NULL && !read_from_text_file && use_tar)) {
+	err(89, __func__, "called with NULL arg(s)");
+	not_reached();
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /*
+     * form the jobs
+     */
+    list = find_batch_tarballs(batch);
+    memset(&pool, 0, sizeof(pool));
+    pool.count = (size_t)dyn_array_tell(list);
+    pool.tar = tar;
+    if (pool.count > 0) {
+	errno = 0;		/* pre-clear errno for errp() */
+	pool.job = calloc(pool.count, sizeof(pool.job[0]));
+	if (pool.job == NULL) {
+	    errp(90, __func__, "cannot allocate %zu jobs", pool.count);
+	    not_reached();
+	}
+	for (j=0; j < pool.count; ++j) {
+	    pool.job[j].path = dyn_array_value(list, char *, j);
+	}
+    }
+    workers = (size_t)jobs < pool.count ? (size_t)jobs : pool.count;
+
+    /*
+     * start the JSON summary
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ok = printf("{\n") > 0 &&
+	json_fprintf_value_string(stdout, "    ", "txzchk_version", " : ", TXZCHK_VERSION, ",\n") &&
+	json_fprintf_value_long(stdout, "    ", "jobs", " : ", (long)(workers > 0 ? workers : 1), ",\n") &&
+	printf("    \"tarballs\" : [\n") > 0;
+    if (!ok) {
+	errp(91, __func__, "error printing JSON summary");
+	not_reached();
+    }
+
+    /*
+     * case: one worker - check and report each tarball in order
+     */
+    if (workers <= 1) {
+	for (j=0; j < pool.count; ++j) {
+	    check_job(&pool.job[j], tar);
+	    (void) report_job(&pool.job[j], j == 0);
+	}
+
+    /*
+     * case: more than one worker - check tarballs in worker threads, report in order
+     */
+    } else {
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = pthread_mutex_init(&pool.lock, NULL);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(92, __func__, "pthread_mutex_init failed");
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	ret = pthread_cond_init(&pool.done, NULL);
+	if (ret != 0) {
+	    errno = ret;
+	    errp(93, __func__, "pthread_cond_init failed");
+	    not_reached();
+	}
+	errno = 0;		/* pre-clear errno for errp() */
+	worker = calloc(workers, sizeof(worker[0]));
+	if (worker == NULL) {
+	    errp(94, __func__, "cannot allocate %zu worker threads", workers);
+	    not_reached();
+	}
+	dbg(DBG_MED, "starting %zu worker threads for %zu tarballs", workers, pool.count);
+	for (j=0; j < workers; ++j) {
+	    ret = pthread_create(&worker[j], NULL, txzchk_worker, &pool);
+	    if (ret != 0) {
+		errno = ret;
+		errp(95, __func__, "pthread_create of worker %zu failed", j);
+		not_reached();
+	    }
+	}
+
+	/*
+	 * report each tarball, in order, as soon as it has been checked
+	 */
+	for (j=0; j < pool.count; ++j) {
+	    (void) pthread_mutex_lock(&pool.lock);
+	    while (!pool.job[j].done) {
+		(void) pthread_cond_wait(&pool.done, &pool.lock);
+	    }
+	    (void) pthread_mutex_unlock(&pool.lock);
+	    (void) report_job(&pool.job[j], j == 0);
+	}
+
+	/*
+	 * wait for the workers to finish
+	 */
+	for (j=0; j < workers; ++j) {
+	    ret = pthread_join(worker[j], NULL);
+	    if (ret != 0) {
+		errno = ret;
+		errp(96, __func__, "pthread_join of worker %zu failed", j);
+		not_reached();
+	    }
+	}
+	free(worker);
+	worker = NULL;
+	(void) pthread_cond_destroy(&pool.done);
+	(void) pthread_mutex_destroy(&pool.lock);
+    }
+
+    /*
+     * total the results
+     */
+    for (j=0; j < pool.count; ++j) {
+	total_feathers += pool.job[j].ctx.tarball.total_feathers;
+	if (pool.job[j].ctx.tarball.total_feathers > 0) {
+	    ++feathery_count;
+	}
+	if (pool.job[j].ctx.error != NULL) {
+	    ++unchecked_count;
+	}
+    }
+    (void) clock_gettime(CLOCK_MONOTONIC, &end);
+
+    /*
+     * finish the JSON summary
+     */
+    errno = 0;			/* pre-clear errno for errp() */
+    ok = printf("%s    ],\n", pool.count > 0 ? "\n" : "") > 0 &&
+	json_fprintf_value_long(stdout, "    ", "tarball_count", " : ", (long)pool.count, ",\n") &&
+	json_fprintf_value_long(stdout, "    ", "feathery_count", " : ", (long)feathery_count, ",\n") &&
+	json_fprintf_value_long(stdout, "    ", "unchecked_count", " : ", (long)unchecked_count, ",\n") &&
+	json_fprintf_value_long(stdout, "    ", "total_feathers", " : ", (long)total_feathers, ",\n") &&
+	printf("    \"seconds\" : %.6f\n}\n",
+	       (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9) > 0 &&
+	fflush(stdout) == 0;
+    if (!ok) {
+	errp(97, __func__, "error printing JSON summary");
+	not_reached();
+    }
+
+    /*
+     * free storage
+     */
+    for (j=0; j < pool.count; ++j) {
+	if (pool.job[j].cpath != NULL) {
+	    free(pool.job[j].cpath);
+	    pool.job[j].cpath = NULL;
+	}
+	free(pool.job[j].path);
+	pool.job[j].path = NULL;
+    }
+    if (pool.job != NULL) {
+	free(pool.job);
+	pool.job = NULL;
+    }
+    dyn_array_free(list);
+    list = NULL;
+    return total_feathers == 0;
+}
@@ -4,8 +4,8 @@
  * txzchk verifies that IOCCC submission tarballs conform to the IOCCC rules (no
  * feathers stuck in the tarballs :-) ).
  *
- * txzchk is invoked by mkiocccentry; txzchk in turn uses fnamchk to make
- * sure that the tarball was correctly named and formed. In other words txzchk
+ * txzchk is invoked by mkiocccentry; txzchk in turn uses the fnamchk checks to
+ * make sure that the tarball was correctly named and formed. In other words txzchk
  * makes sure that the mkiocccentry tool was used and there was no screwing
  * around with the resultant tarball.
  *
@@ -65,6 +65,8 @@
 #    define  INCLUDE_TXZCHK_H
 
 
+#include <pthread.h>	/* for -B worker threads */
+
 /*
  * jparse/version - JSON parser API and tool version
  */
@@ -106,6 +108,16 @@
  */
 #include "soup/walk.h"
 
+/*
+ * soup/tar_util - for reading the tar pit without tar
+ */
+#include "soup/tar_util.h"
+
+/*
+ * soup/fnamchk_util - for checking the tarball filename without fnamchk
+ */
+#include "soup/fnamchk_util.h"
+
 
 /*
  * macros
@@ -116,6 +128,13 @@
  */
 #define TXZCHK_BASENAME "txzchk"
 
+/*
+ * -B batch mode limits
+ */
+#define TXZCHK_MAX_JOBS (1024)		/* maximum number of -j worker threads */
+#define TXZCHK_LIST_CHUNK (1024)	/* allocation chunk for the -B list of tarballs */
+#define TXZCHK_ENTRY_CHUNK (256)	/* allocation chunk for the txz_lines and txz_files arrays */
+
 
 /*
  * information about the tarball
@@ -132,15 +151,17 @@ struct tarball
     uintmax_t files_size_shrunk;	    /* > 0 ==> total files size shrunk this many times */
     uintmax_t invalid_perms;                /* total number of files with invalid permissions */
     uintmax_t total_exec_files;             /* total number of executable FILES */
+    intmax_t file_count;		    /* number of regular files (as counted by sum_and_count()) */
 };
 
 
 /*
  * txz_file - struct for each file
  *
- * This struct is for the txz_files linked list which is all the files the
- * tarball has (according to tar -tJvf or if -T specified what was read from
- * each line of the text file).
+ * This struct is for the txz_files array which is all the files the
+ * tarball has (according to the tar headers we read, or the tar -tJvf listing
+ * if -t tar specified, or if -T specified what was read from each line of the
+ * text file).
  *
  * Once the tar/text file output has been parsed we go through this list to
  * determine if the appropriate files exist, to check that only one of each file
@@ -160,51 +181,105 @@ struct txz_file
     char *perms;                            /* permission bits */
     bool isexec;                            /* true ==> executable (+x) file */
     mode_t mode;                            /* perms -> mode_t */
-    struct txz_file *next;		    /* the next file in the txz_files list */
 };
 
 /*
  * struct txz_line - a line of output from tar -tJvf or the text file
  *
- * This struct defines a line of output for the txz_lines linked list. After all
+ * This struct defines a line of output for the txz_lines array. After all
  * lines from tar or the text file are added to the list, we parse each line (by
  * calling parse_txz_line() which calls either parse_linux_txz_line() or
  * parse_bsd_txz_line() depending on the line format), doing various checks and
- * adds each file to the txz_files list for further checks after the initial
+ * adds each file to the txz_files array for further checks after the initial
  * tests are complete.
  */
 struct txz_line
 {
     char *line;				/* copy of the line */
     uintmax_t line_num;			/* line number */
-    struct txz_line *next;		/* pointer to the next line or NULL if last line */
+};
+
+/*
+ * struct txz_ctx - the state of checking one tarball
+ *
+ * Everything we learn while checking a tarball is kept here rather than in
+ * globals so that -B can check different tarballs in different threads at the
+ * same time.
+ */
+struct txz_ctx
+{
+    char const *tarball_path;		/* the tarball (by path) being checked */
+    struct tarball tarball;		/* all the information collected from tarball */
+    struct dyn_array *txz_lines;	/* struct txz_line of each read line, or NULL */
+    struct dyn_array *txz_files;	/* struct txz_file * of each file in the tarball, or NULL */
+    intmax_t sum_check;			/* negative of previous sum */
+    intmax_t count_check;		/* negative of previous count */
+    char const *error;			/* (-B only) why the tarball could not be checked, or NULL */
+};
+
+/*
+ * struct txz_job - a tarball to check with -B and the result of checking it
+ *
+ * A job is checked by a worker thread (or by main() when there is only one
+ * worker) and reported by main() in the order the tarballs were found.
+ */
+struct txz_job
+{
+    char *path;				/* tarball path as found in the -B directory or list */
+    char *cpath;			/* canonicalized tarball path or NULL if path is bogus */
+    struct txz_ctx ctx;			/* the state of checking the tarball */
+    bool done;				/* true ==> job has been checked */
+    double seconds;			/* time taken to check the tarball */
+};
+
+/*
+ * struct txz_pool - a set of tarballs checked by a pool of worker threads
+ */
+struct txz_pool
+{
+    struct txz_job *job;		/* jobs in the order found */
+    size_t count;			/* number of jobs */
+    size_t next;			/* index of the next job to be taken by a worker */
+    char const *tar;			/* path to tar (if -t tar) */
+    pthread_mutex_t lock;		/* lock on next and the done flags */
+    pthread_cond_t done;		/* signaled when a job is done */
 };
 
 /*
  * function prototypes
  */
-static void txzchk_sanity_chks(char const *tar, char const *fnamchk);
-static uintmax_t check_tarball(char const *tar, char const *fnamchk);
-static void parse_txz_line(char *linep, char *line_dup, char const *dirname, char const *tarball_path, intmax_t *sum,
+static void txzchk_sanity_chks(char const *tar, char const *tarball_path);
+static uintmax_t check_tarball(struct txz_ctx *ctx, char const *tar);
+static void parse_txz_line(struct txz_ctx *ctx, char *linep, char *line_dup, char const *dirname, char const *tarball_path, intmax_t *sum,
         intmax_t *count);
-static void parse_linux_txz_line(char *p, char *line, char *line_dup, char const *dirname,
+static void parse_linux_txz_line(struct txz_ctx *ctx, char *p, char *line, char *line_dup, char const *dirname,
 	char const *tarball_path, char **saveptr, bool normal_file, intmax_t *sum, intmax_t *count, bool isdir,
         char *perms, bool isexec);
-static void show_tarball_info(char const *tarball_path);
-static void check_all_txz_files(void);
-static mode_t get_mode(struct txz_file *file);
-static void add_txz_line(char const *str, uintmax_t line_num);
-static void parse_all_txz_lines(char const *dirname, char const *tarball_path);
-static void free_txz_lines(void);
-static void check_txz_file(char const *tarball_path, char const *dirname, struct txz_file *file);
-static void check_directory(struct txz_file *file, char const *dirname, char const *tarball_path);
-static struct txz_file *alloc_txz_file(char const *path, char const *dirname, char *perms, bool isdir,
+static void show_tarball_info(struct txz_ctx *ctx, char const *tarball_path);
+static void check_all_txz_files(struct txz_ctx *ctx);
+static mode_t get_mode(struct txz_ctx *ctx, struct txz_file *file);
+static void add_txz_line(struct txz_ctx *ctx, char const *str, uintmax_t line_num);
+static void parse_all_txz_lines(struct txz_ctx *ctx, char const *dirname, char const *tarball_path);
+static void read_txz_lines(struct txz_ctx *ctx, char const *tar);
+static void print_tar_entry(struct tar_entry const *entry, char const *perms);
+static void parse_tar_entry(struct txz_ctx *ctx, struct tar_entry const *entry, char const *dirname, char const *tarball_path,
+	intmax_t *sum, intmax_t *count);
+static bool parse_txz_entries(struct txz_ctx *ctx, char const *dirname, char const *tarball_path);
+static void free_txz_lines(struct txz_ctx *ctx);
+static void check_txz_file(struct txz_ctx *ctx, char const *tarball_path, char const *dirname, struct txz_file *file);
+static void check_directory(struct txz_ctx *ctx, struct txz_file *file, char const *dirname, char const *tarball_path);
+static struct txz_file *alloc_txz_file(struct txz_ctx *ctx, char const *path, char const *dirname, char *perms, bool isdir,
         bool isfile, bool isexec, intmax_t length);
-static void count_and_sum(char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t length);
-static bool has_special_bits(struct txz_file *file);
-static void add_txz_file_to_list(struct txz_file *file);
+static void count_and_sum(struct txz_ctx *ctx, char const *tarball_path, intmax_t *sum, intmax_t *count, intmax_t length);
+static bool has_special_bits(struct txz_ctx *ctx, struct txz_file *file);
+static void add_txz_file_to_list(struct txz_ctx *ctx, struct txz_file *file);
 static void free_txz_file(struct txz_file **file);
-static void free_txz_files_list(void);
+static void free_txz_files_list(struct txz_ctx *ctx);
+static struct dyn_array *find_batch_tarballs(char const *batch);
+static void check_job(struct txz_job *job, char const *tar);
+static bool report_job(struct txz_job const *job, bool first);
+static void *txzchk_worker(void *arg);
+static bool check_batch(char const *batch, intmax_t jobs, char const *tar);
 
 
 #endif /* INCLUDE_TXZCHK_H */